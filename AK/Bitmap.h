@@ -133,11 +133,16 @@ public:
 
     Optional<size_t> find_first_set() const
     {
+        u32* bitmap32 = (u32*)m_data;
         size_t i = 0;
-        while (i < m_size / 8 && m_data[i] == 0x00)
-            i++;
+        for (; i < m_size / 32; ++i) {
+            if (bitmap32[i] == 0x0)
+                continue;
+            return i * 32 + count_trailing_zeroes_32(bitmap32[i]);
+        }
 
-        for (size_t j = i * 8; j < m_size; j++) {
+        // Trailing bits that don't fill a whole 32-bit bucket.
+        for (size_t j = i * 32; j < m_size; j++) {
             if (get(j))
                 return j;
         }
@@ -147,11 +152,16 @@ public:
 
     Optional<size_t> find_first_unset() const
     {
+        u32* bitmap32 = (u32*)m_data;
         size_t i = 0;
-        while (i < m_size / 8 && m_data[i] == 0xff)
-            i++;
+        for (; i < m_size / 32; ++i) {
+            if (bitmap32[i] == 0xffffffff)
+                continue;
+            return i * 32 + count_trailing_zeroes_32(~bitmap32[i]);
+        }
 
-        for (size_t j = i * 8; j < m_size; j++)
+        // Trailing bits that don't fill a whole 32-bit bucket.
+        for (size_t j = i * 32; j < m_size; j++)
             if (!get(j))
                 return j;
 
@@ -44,6 +44,7 @@ public:
     static NonnullRefPtr<ByteBufferImpl> wrap(void*, size_t);
     static NonnullRefPtr<ByteBufferImpl> wrap(const void*, size_t);
     static NonnullRefPtr<ByteBufferImpl> adopt(void*, size_t);
+    static NonnullRefPtr<ByteBufferImpl> create_slice(NonnullRefPtr<ByteBufferImpl>, size_t offset, size_t size);
 
     ~ByteBufferImpl() { clear(); }
 
@@ -54,6 +55,7 @@ public:
         if (m_owned)
             kfree(m_data);
         m_data = nullptr;
+        m_backing = nullptr;
     }
 
     u8& operator[](size_t i)
@@ -87,6 +89,9 @@ public:
 
     void grow(size_t size);
 
+    bool is_owned() const { return m_owned; }
+    bool is_slice() const { return !m_backing.is_null(); }
+
 private:
     enum ConstructionMode {
         Uninitialized,
@@ -97,11 +102,14 @@ private:
     explicit ByteBufferImpl(size_t); // For ConstructionMode=Uninitialized
     ByteBufferImpl(const void*, size_t, ConstructionMode); // For ConstructionMode=Copy
     ByteBufferImpl(void*, size_t, ConstructionMode); // For ConstructionMode=Wrap/Adopt
+    ByteBufferImpl(NonnullRefPtr<ByteBufferImpl> backing, size_t offset, size_t size); // For slices
     ByteBufferImpl() {}
 
     u8* m_data { nullptr };
     size_t m_size { 0 };
     bool m_owned { false };
+    // Slices keep their backing buffer alive instead of owning memory.
+    RefPtr<ByteBufferImpl> m_backing;
 };
 
 class ByteBuffer {
@@ -146,6 +154,7 @@ public:
     u8& operator[](size_t i)
     {
         ASSERT(m_impl);
+        ensure_exclusive();
         return (*m_impl)[i];
     }
     u8 operator[](size_t i) const
@@ -156,13 +165,25 @@ public:
     bool is_empty() const { return !m_impl || m_impl->is_empty(); }
     size_t size() const { return m_impl ? m_impl->size() : 0; }
 
-    u8* data() { return m_impl ? m_impl->data() : nullptr; }
+    u8* data()
+    {
+        ensure_exclusive();
+        return m_impl ? m_impl->data() : nullptr;
+    }
     const u8* data() const { return m_impl ? m_impl->data() : nullptr; }
 
-    u8* offset_pointer(int offset) { return m_impl ? m_impl->offset_pointer(offset) : nullptr; }
+    u8* offset_pointer(int offset)
+    {
+        ensure_exclusive();
+        return m_impl ? m_impl->offset_pointer(offset) : nullptr;
+    }
     const u8* offset_pointer(int offset) const { return m_impl ? m_impl->offset_pointer(offset) : nullptr; }
 
-    void* end_pointer() { return m_impl ? m_impl->end_pointer() : nullptr; }
+    void* end_pointer()
+    {
+        ensure_exclusive();
+        return m_impl ? m_impl->end_pointer() : nullptr;
+    }
     const void* end_pointer() const { return m_impl ? m_impl->end_pointer() : nullptr; }
 
     ByteBuffer isolated_copy() const
@@ -175,19 +196,19 @@ public:
     // NOTE: trim() does not reallocate.
     void trim(size_t size)
     {
-        if (m_impl)
-            m_impl->trim(size);
+        if (!m_impl)
+            return;
+        ensure_exclusive();
+        m_impl->trim(size);
     }
 
+    // Slices share the backing buffer instead of copying it, and keep it
+    // alive for as long as they exist. Writing through a slice (or through
+    // any shared owned buffer) copies first, so existing value semantics
+    // are preserved.
     ByteBuffer slice_view(size_t offset, size_t size) const
     {
-        if (is_null())
-            return {};
-
-        // I cannot hand you a slice I don't have
-        ASSERT(offset + size <= this->size());
-
-        return wrap(offset_pointer(offset), size);
+        return slice(offset, size);
     }
 
     ByteBuffer slice(size_t offset, size_t size) const
@@ -198,15 +219,17 @@ public:
         // I cannot hand you a slice I don't have
         ASSERT(offset + size <= this->size());
 
-        return copy(offset_pointer(offset), size);
+        return ByteBuffer(ByteBufferImpl::create_slice(*m_impl, offset, size));
     }
 
     void grow(size_t size)
     {
-        if (!m_impl)
+        if (!m_impl) {
             m_impl = ByteBufferImpl::create_uninitialized(size);
-        else
-            m_impl->grow(size);
+            return;
+        }
+        ensure_exclusive();
+        m_impl->grow(size);
     }
 
     void append(const void* data, size_t data_size)
@@ -232,6 +255,18 @@ private:
     {
     }
 
+    // Copy-on-write: detach before mutation if this buffer is a slice or
+    // shares an owned impl with someone else. Wrapped buffers are excluded;
+    // wrap() is explicitly an aliasing view over external memory.
+    void ensure_exclusive()
+    {
+        if (!m_impl)
+            return;
+        if (!m_impl->is_slice() && !(m_impl->is_owned() && m_impl->ref_count() > 1))
+            return;
+        m_impl = ByteBufferImpl::copy(m_impl->data(), m_impl->size());
+    }
+
     RefPtr<ByteBufferImpl> m_impl;
 };
 
@@ -262,6 +297,13 @@ inline ByteBufferImpl::ByteBufferImpl(void* data, size_t size, ConstructionMode
     }
 }
 
+inline ByteBufferImpl::ByteBufferImpl(NonnullRefPtr<ByteBufferImpl> backing, size_t offset, size_t size)
+    : m_data(backing->m_data + offset)
+    , m_size(size)
+    , m_backing(move(backing))
+{
+}
+
 inline void ByteBufferImpl::grow(size_t size)
 {
     ASSERT(size > m_size);
@@ -306,6 +348,17 @@ inline NonnullRefPtr<ByteBufferImpl> ByteBufferImpl::adopt(void* data, size_t si
     return ::adopt(*new ByteBufferImpl(data, size, Adopt));
 }
 
+inline NonnullRefPtr<ByteBufferImpl> ByteBufferImpl::create_slice(NonnullRefPtr<ByteBufferImpl> backing, size_t offset, size_t size)
+{
+    // Flatten slice-of-slice so chains don't pile up; m_data is already an
+    // absolute pointer, so only the liveness anchor needs adjusting.
+    if (backing->m_backing) {
+        offset += backing->m_data - backing->m_backing->m_data;
+        backing = *backing->m_backing;
+    }
+    return ::adopt(*new ByteBufferImpl(move(backing), offset, size));
+}
+
 inline const LogStream& operator<<(const LogStream& stream, const ByteBuffer& value)
 {
     stream.write((const char*)value.data(), value.size());
@@ -63,20 +63,38 @@ FlyString::FlyString(const String& string)
 {
     if (string.is_null())
         return;
-    auto it = fly_impls().find(const_cast<StringImpl*>(string.impl()));
-    if (it == fly_impls().end()) {
-        fly_impls().set(const_cast<StringImpl*>(string.impl()));
-        string.impl()->set_fly({}, true);
+    if (string.impl()->is_fly()) {
+        // Already interned; no need to consult the table at all.
         m_impl = string.impl();
-    } else {
-        ASSERT((*it)->is_fly());
-        m_impl = *it;
+        return;
     }
+    bool did_insert = false;
+    auto& impl = fly_impls().find_or_insert(const_cast<StringImpl*>(string.impl()), did_insert);
+    if (did_insert)
+        string.impl()->set_fly({}, true);
+    else
+        ASSERT(impl->is_fly());
+    m_impl = impl;
 }
 
 FlyString::FlyString(const StringView& string)
-    : FlyString(static_cast<String>(string))
 {
+    if (string.is_null())
+        return;
+    // Look up the table by content first, so interning an already-known
+    // string doesn't have to allocate a String just to throw it away.
+    auto it = fly_impls().find(string.hash(), [&](auto& candidate) {
+        return string == StringView(candidate->characters(), candidate->length());
+    });
+    if (it != fly_impls().end()) {
+        ASSERT((*it)->is_fly());
+        m_impl = *it;
+        return;
+    }
+    auto new_string = static_cast<String>(string);
+    fly_impls().set(const_cast<StringImpl*>(new_string.impl()));
+    new_string.impl()->set_fly({}, true);
+    m_impl = new_string.impl();
 }
 
 FlyString::FlyString(const char* string)
@@ -112,12 +112,34 @@ public:
         m_table.remove(it);
     }
 
+    // Single-probe versions of the contains()/get()-then-set() pattern;
+    // see HashTable::find_or_insert().
+    V& find_or_insert(const K& key, V&& value, bool& did_insert)
+    {
+        return m_table.find_or_insert(Entry { key, move(value) }, did_insert).value;
+    }
+
+    V& find_or_insert(const K& key, const V& value, bool& did_insert)
+    {
+        return find_or_insert(key, V(value), did_insert);
+    }
+
     V& ensure(const K& key)
     {
-        auto it = find(key);
-        if (it == end())
-            set(key, V());
-        return find(key)->value;
+        bool did_insert = false;
+        return m_table.find_or_insert(Entry { key, V() }, did_insert).value;
+    }
+
+    // Only pays for producing the initial value if the key wasn't in the
+    // map yet.
+    template<typename Callback>
+    V& ensure(const K& key, Callback callback)
+    {
+        bool did_insert = false;
+        auto& value = m_table.find_or_insert(Entry { key, V() }, did_insert).value;
+        if (did_insert)
+            value = callback();
+        return value;
     }
 
     Vector<K> keys() const
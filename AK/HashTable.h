@@ -27,31 +27,32 @@
 #pragma once
 
 #include <AK/Assertions.h>
-#include <AK/SinglyLinkedList.h>
 #include <AK/StdLibExtras.h>
-#include <AK/TemporaryChange.h>
 #include <AK/Traits.h>
+#include <AK/kmalloc.h>
+
+#ifndef __serenity__
+#    include <new>
+#endif
 
 namespace AK {
 
-template<typename T, typename>
+// An open-addressing hash table with linear probing. Elements live directly
+// in a flat bucket array, so lookups walk contiguous memory instead of
+// chasing per-bucket list nodes, and inserting doesn't allocate (except when
+// the whole table grows.) Removed elements leave a "deleted" marker behind so
+// probe sequences stay intact until the next rehash sweeps them away.
+
+template<typename T, typename TraitsForT>
 class HashTable;
 
-template<typename HashTableType, typename ElementType, typename BucketIteratorType>
+template<typename HashTableType, typename ElementType, typename BucketType>
 class HashTableIterator {
 public:
-    bool operator!=(const HashTableIterator& other) const
-    {
-        if (m_is_end && other.m_is_end)
-            return false;
-        return &m_table != &other.m_table
-            || m_is_end != other.m_is_end
-            || m_bucket_index != other.m_bucket_index
-            || m_bucket_iterator != other.m_bucket_iterator;
-    }
-    bool operator==(const HashTableIterator& other) const { return !(*this != other); }
-    ElementType& operator*() { return *m_bucket_iterator; }
-    ElementType* operator->() { return m_bucket_iterator.operator->(); }
+    bool operator==(const HashTableIterator& other) const { return m_bucket == other.m_bucket; }
+    bool operator!=(const HashTableIterator& other) const { return m_bucket != other.m_bucket; }
+    ElementType& operator*() { return *m_bucket->slot(); }
+    ElementType* operator->() { return m_bucket->slot(); }
     HashTableIterator& operator++()
     {
         skip_to_next();
@@ -60,50 +61,39 @@ public:
 
     void skip_to_next()
     {
-        while (!m_is_end) {
-            if (m_bucket_iterator.is_end()) {
-                ++m_bucket_index;
-                if (m_bucket_index >= m_table.capacity()) {
-                    m_is_end = true;
-                    return;
-                }
-                m_bucket_iterator = m_table.bucket(m_bucket_index).begin();
-            } else {
-                ++m_bucket_iterator;
-            }
-            if (!m_bucket_iterator.is_end())
-                return;
-        }
+        if (m_bucket == m_end_bucket)
+            return;
+        do {
+            ++m_bucket;
+        } while (m_bucket != m_end_bucket && !m_bucket->used);
     }
 
 private:
     friend HashTableType;
 
-    explicit HashTableIterator(HashTableType& table, bool is_end, BucketIteratorType bucket_iterator = {}, size_t bucket_index = 0)
-        : m_table(table)
-        , m_bucket_index(bucket_index)
-        , m_is_end(is_end)
-        , m_bucket_iterator(bucket_iterator)
+    HashTableIterator(BucketType* bucket, BucketType* end_bucket)
+        : m_bucket(bucket)
+        , m_end_bucket(end_bucket)
     {
-        ASSERT(!table.m_clearing);
-        ASSERT(!table.m_rehashing);
-        if (!is_end && !m_table.is_empty() && m_bucket_iterator.is_end()) {
-            m_bucket_iterator = m_table.bucket(0).begin();
-            if (m_bucket_iterator.is_end())
-                skip_to_next();
-        }
+        while (m_bucket != m_end_bucket && !m_bucket->used)
+            ++m_bucket;
     }
 
-    HashTableType& m_table;
-    size_t m_bucket_index { 0 };
-    bool m_is_end { false };
-    BucketIteratorType m_bucket_iterator;
+    BucketType* m_bucket { nullptr };
+    BucketType* m_end_bucket { nullptr };
 };
 
 template<typename T, typename TraitsForT>
 class HashTable {
 private:
-    using Bucket = SinglyLinkedList<T>;
+    struct Bucket {
+        bool used { false };
+        bool deleted { false };
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* slot() { return reinterpret_cast<T*>(storage); }
+        const T* slot() const { return reinterpret_cast<const T*>(storage); }
+    };
 
 public:
     HashTable() {}
@@ -127,9 +117,11 @@ public:
         : m_buckets(other.m_buckets)
         , m_size(other.m_size)
         , m_capacity(other.m_capacity)
+        , m_deleted_count(other.m_deleted_count)
     {
         other.m_size = 0;
         other.m_capacity = 0;
+        other.m_deleted_count = 0;
         other.m_buckets = nullptr;
     }
     HashTable& operator=(HashTable&& other)
@@ -139,8 +131,10 @@ public:
             m_buckets = other.m_buckets;
             m_size = other.m_size;
             m_capacity = other.m_capacity;
+            m_deleted_count = other.m_deleted_count;
             other.m_size = 0;
             other.m_capacity = 0;
+            other.m_deleted_count = 0;
             other.m_buckets = nullptr;
         }
         return *this;
@@ -154,48 +148,108 @@ public:
     void ensure_capacity(size_t capacity)
     {
         ASSERT(capacity >= size());
-        rehash(capacity);
+        rehash(capacity * 2);
+    }
+
+    void set(T&& value)
+    {
+        if (should_grow())
+            rehash(capacity() * 2);
+        auto& bucket = lookup_for_writing(value);
+        if (bucket.used) {
+            (*bucket.slot()) = move(value);
+            return;
+        }
+        new (bucket.slot()) T(move(value));
+        bucket.used = true;
+        if (bucket.deleted) {
+            bucket.deleted = false;
+            --m_deleted_count;
+        }
+        ++m_size;
+    }
+
+    void set(const T& value)
+    {
+        set(T(value));
+    }
+
+    // Single-probe find-or-insert: returns the element equal to `value` if
+    // the table already has one, otherwise inserts `value` and returns that.
+    // `did_insert` tells the caller which happened. Saves hashing the key
+    // and walking the probe sequence twice at contains()-then-set() call
+    // sites.
+    T& find_or_insert(T&& value, bool& did_insert)
+    {
+        if (should_grow())
+            rehash(capacity() * 2);
+        auto& bucket = lookup_for_writing(value);
+        if (bucket.used) {
+            did_insert = false;
+            return *bucket.slot();
+        }
+        new (bucket.slot()) T(move(value));
+        bucket.used = true;
+        if (bucket.deleted) {
+            bucket.deleted = false;
+            --m_deleted_count;
+        }
+        ++m_size;
+        did_insert = true;
+        return *bucket.slot();
+    }
+
+    T& find_or_insert(const T& value, bool& did_insert)
+    {
+        return find_or_insert(T(value), did_insert);
+    }
+
+    bool contains(const T& value) const
+    {
+        return find(value) != end();
     }
 
-    void set(const T&);
-    void set(T&&);
-    bool contains(const T&) const;
-    void clear();
+    void clear()
+    {
+        if (m_buckets) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (m_buckets[i].used)
+                    m_buckets[i].slot()->~T();
+            }
+            delete[] m_buckets;
+            m_buckets = nullptr;
+        }
+        m_capacity = 0;
+        m_size = 0;
+        m_deleted_count = 0;
+    }
 
-    using Iterator = HashTableIterator<HashTable, T, typename Bucket::Iterator>;
+    using Iterator = HashTableIterator<HashTable, T, Bucket>;
     friend Iterator;
-    Iterator begin() { return Iterator(*this, is_empty()); }
-    Iterator end() { return Iterator(*this, true); }
+    Iterator begin() { return Iterator(m_buckets, end_bucket()); }
+    Iterator end() { return Iterator(end_bucket(), end_bucket()); }
 
-    using ConstIterator = HashTableIterator<const HashTable, const T, typename Bucket::ConstIterator>;
+    using ConstIterator = HashTableIterator<const HashTable, const T, const Bucket>;
     friend ConstIterator;
-    ConstIterator begin() const { return ConstIterator(*this, is_empty()); }
-    ConstIterator end() const { return ConstIterator(*this, true); }
+    ConstIterator begin() const { return ConstIterator(m_buckets, end_bucket()); }
+    ConstIterator end() const { return ConstIterator(end_bucket(), end_bucket()); }
 
     template<typename Finder>
     Iterator find(unsigned hash, Finder finder)
     {
-        if (is_empty())
+        auto* bucket = lookup_with_hash(hash, move(finder));
+        if (!bucket)
             return end();
-        size_t bucket_index;
-        auto& bucket = lookup_with_hash(hash, &bucket_index);
-        auto bucket_iterator = bucket.find(finder);
-        if (bucket_iterator != bucket.end())
-            return Iterator(*this, false, bucket_iterator, bucket_index);
-        return end();
+        return Iterator(bucket, end_bucket());
     }
 
     template<typename Finder>
     ConstIterator find(unsigned hash, Finder finder) const
     {
-        if (is_empty())
+        auto* bucket = lookup_with_hash(hash, move(finder));
+        if (!bucket)
             return end();
-        size_t bucket_index;
-        auto& bucket = lookup_with_hash(hash, &bucket_index);
-        auto bucket_iterator = bucket.find(finder);
-        if (bucket_iterator != bucket.end())
-            return ConstIterator(*this, false, bucket_iterator, bucket_index);
-        return end();
+        return ConstIterator(bucket, end_bucket());
     }
 
     Iterator find(const T& value)
@@ -215,167 +269,109 @@ public:
             remove(it);
     }
 
-    void remove(Iterator);
-
-private:
-    Bucket& lookup(const T&, size_t* bucket_index = nullptr);
-    const Bucket& lookup(const T&, size_t* bucket_index = nullptr) const;
-
-    Bucket& lookup_with_hash(unsigned hash, size_t* bucket_index)
+    void remove(Iterator it)
     {
-        if (bucket_index)
-            *bucket_index = hash % m_capacity;
-        return m_buckets[hash % m_capacity];
+        ASSERT(it.m_bucket);
+        auto& bucket = *it.m_bucket;
+        ASSERT(bucket.used);
+        bucket.slot()->~T();
+        bucket.used = false;
+        bucket.deleted = true;
+        --m_size;
+        ++m_deleted_count;
     }
 
-    const Bucket& lookup_with_hash(unsigned hash, size_t* bucket_index) const
+private:
+    bool should_grow() const
     {
-        if (bucket_index)
-            *bucket_index = hash % m_capacity;
-        return m_buckets[hash % m_capacity];
+        if (!m_capacity)
+            return true;
+        // Deleted buckets still lengthen probe sequences, so they count
+        // against the load factor until a rehash reclaims them.
+        return (m_size + m_deleted_count + 1) * 4 >= m_capacity * 3;
     }
 
-    void rehash(size_t capacity);
-    void insert(const T&);
-    void insert(T&&);
+    void rehash(size_t new_capacity)
+    {
+        new_capacity = max(new_capacity, static_cast<size_t>(4));
 
-    Bucket& bucket(size_t index) { return m_buckets[index]; }
-    const Bucket& bucket(size_t index) const { return m_buckets[index]; }
+        auto* old_buckets = m_buckets;
+        auto old_capacity = m_capacity;
 
-    Bucket* m_buckets { nullptr };
-
-    size_t m_size { 0 };
-    size_t m_capacity { 0 };
-    bool m_clearing { false };
-    bool m_rehashing { false };
-};
+        m_buckets = new Bucket[new_capacity];
+        m_capacity = new_capacity;
+        m_deleted_count = 0;
 
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::set(T&& value)
-{
-    if (!m_capacity)
-        rehash(1);
-    auto& bucket = lookup(value);
-    for (auto& e : bucket) {
-        if (TraitsForT::equals(e, value)) {
-            e = move(value);
-            return;
+        for (size_t i = 0; i < old_capacity; ++i) {
+            auto& old_bucket = old_buckets[i];
+            if (!old_bucket.used)
+                continue;
+            insert_during_rehash(move(*old_bucket.slot()));
+            old_bucket.slot()->~T();
         }
-    }
-    if (size() >= capacity()) {
-        rehash(size() + 1);
-        insert(move(value));
-    } else {
-        bucket.append(move(value));
-    }
-    m_size++;
-}
 
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::set(const T& value)
-{
-    if (!m_capacity)
-        rehash(1);
-    auto& bucket = lookup(value);
-    for (auto& e : bucket) {
-        if (TraitsForT::equals(e, value)) {
-            e = value;
-            return;
-        }
-    }
-    if (size() >= capacity()) {
-        rehash(size() + 1);
-        insert(value);
-    } else {
-        bucket.append(value);
+        delete[] old_buckets;
     }
-    m_size++;
-}
 
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::rehash(size_t new_capacity)
-{
-    TemporaryChange<bool> change(m_rehashing, true);
-    new_capacity *= 2;
-    auto* new_buckets = new Bucket[new_capacity];
-    auto* old_buckets = m_buckets;
-    size_t old_capacity = m_capacity;
-    m_buckets = new_buckets;
-    m_capacity = new_capacity;
-
-    for (size_t i = 0; i < old_capacity; ++i) {
-        for (auto& value : old_buckets[i]) {
-            insert(move(value));
+    void insert_during_rehash(T&& value)
+    {
+        auto hash = TraitsForT::hash(value);
+        for (size_t i = 0; i < m_capacity; ++i) {
+            auto& bucket = m_buckets[(hash + i) % m_capacity];
+            if (!bucket.used) {
+                new (bucket.slot()) T(move(value));
+                bucket.used = true;
+                return;
+            }
         }
+        ASSERT_NOT_REACHED();
     }
 
-    delete[] old_buckets;
-}
-
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::clear()
-{
-    TemporaryChange<bool> change(m_clearing, true);
-    if (m_buckets) {
-        delete[] m_buckets;
-        m_buckets = nullptr;
+    template<typename Finder>
+    Bucket* lookup_with_hash(unsigned hash, Finder finder) const
+    {
+        if (is_empty())
+            return nullptr;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            auto& bucket = m_buckets[(hash + i) % m_capacity];
+            if (bucket.used && finder(*bucket.slot()))
+                return &bucket;
+            if (!bucket.used && !bucket.deleted)
+                return nullptr;
+        }
+        return nullptr;
     }
-    m_capacity = 0;
-    m_size = 0;
-}
-
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::insert(T&& value)
-{
-    auto& bucket = lookup(value);
-    bucket.append(move(value));
-}
-
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::insert(const T& value)
-{
-    auto& bucket = lookup(value);
-    bucket.append(value);
-}
 
-template<typename T, typename TraitsForT>
-bool HashTable<T, TraitsForT>::contains(const T& value) const
-{
-    if (is_empty())
-        return false;
-    auto& bucket = lookup(value);
-    for (auto& e : bucket) {
-        if (TraitsForT::equals(e, value))
-            return true;
+    // Finds the bucket an equal value lives in, or failing that, the first
+    // free bucket in the probe sequence (reusing a deleted one if possible.)
+    Bucket& lookup_for_writing(const T& value)
+    {
+        auto hash = TraitsForT::hash(value);
+        Bucket* first_free_bucket = nullptr;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            auto& bucket = m_buckets[(hash + i) % m_capacity];
+            if (bucket.used && TraitsForT::equals(*bucket.slot(), value))
+                return bucket;
+            if (!bucket.used) {
+                if (!first_free_bucket)
+                    first_free_bucket = &bucket;
+                if (!bucket.deleted)
+                    return *first_free_bucket;
+            }
+        }
+        ASSERT(first_free_bucket);
+        return *first_free_bucket;
     }
-    return false;
-}
 
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::remove(Iterator it)
-{
-    ASSERT(!is_empty());
-    m_buckets[it.m_bucket_index].remove(it.m_bucket_iterator);
-    --m_size;
-}
+    Bucket* end_bucket() { return m_buckets + m_capacity; }
+    const Bucket* end_bucket() const { return m_buckets + m_capacity; }
 
-template<typename T, typename TraitsForT>
-auto HashTable<T, TraitsForT>::lookup(const T& value, size_t* bucket_index) -> Bucket&
-{
-    unsigned hash = TraitsForT::hash(value);
-    if (bucket_index)
-        *bucket_index = hash % m_capacity;
-    return m_buckets[hash % m_capacity];
-}
+    Bucket* m_buckets { nullptr };
 
-template<typename T, typename TraitsForT>
-auto HashTable<T, TraitsForT>::lookup(const T& value, size_t* bucket_index) const -> const Bucket&
-{
-    unsigned hash = TraitsForT::hash(value);
-    if (bucket_index)
-        *bucket_index = hash % m_capacity;
-    return m_buckets[hash % m_capacity];
-}
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+    size_t m_deleted_count { 0 };
+};
 
 }
 
@@ -144,6 +144,28 @@ String JsonParser::consume_quoted_string()
     return last_string_starting_with_character;
 }
 
+StringView JsonParser::consume_quoted_string_view()
+{
+    consume_specific('"');
+    size_t start = m_index;
+    while (m_index < m_input.length()) {
+        char ch = m_input[m_index];
+        if (ch == '"') {
+            auto view = m_input.substring_view(start, m_index - start);
+            consume();
+            return view;
+        }
+        if (ch == '\\')
+            break;
+        ++m_index;
+    }
+    // The string has escape sequences (or is unterminated); rewind to the
+    // opening quote and take the slow, materializing path.
+    m_index = start - 1;
+    m_scratch_string = consume_quoted_string();
+    return m_scratch_string.view();
+}
+
 JsonObject JsonParser::parse_object()
 {
     JsonObject object;
@@ -280,6 +302,85 @@ JsonValue JsonParser::parse_undefined()
     return JsonValue(JsonValue::Type::Undefined);
 }
 
+void JsonParser::parse(StreamingClient& client)
+{
+    consume_whitespace();
+    switch (peek()) {
+    case '{':
+        client.on_object_start();
+        consume_specific('{');
+        for (;;) {
+            consume_whitespace();
+            if (peek() == '}')
+                break;
+            consume_whitespace();
+            client.on_object_key(consume_quoted_string_view());
+            consume_whitespace();
+            consume_specific(':');
+            consume_whitespace();
+            parse(client);
+            consume_whitespace();
+            if (peek() == '}')
+                break;
+            consume_specific(',');
+        }
+        consume_specific('}');
+        client.on_object_end();
+        break;
+    case '[':
+        client.on_array_start();
+        consume_specific('[');
+        for (;;) {
+            consume_whitespace();
+            if (peek() == ']')
+                break;
+            parse(client);
+            consume_whitespace();
+            if (peek() == ']')
+                break;
+            consume_specific(',');
+        }
+        consume_whitespace();
+        consume_specific(']');
+        client.on_array_end();
+        break;
+    case '"':
+        client.on_string(consume_quoted_string_view());
+        break;
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        client.on_number(parse_number());
+        break;
+    case 'f':
+        consume_string("false");
+        client.on_bool(false);
+        break;
+    case 't':
+        consume_string("true");
+        client.on_bool(true);
+        break;
+    case 'n':
+        consume_string("null");
+        client.on_null();
+        break;
+    case 'u':
+        consume_string("undefined");
+        client.on_null();
+        break;
+    default:
+        break;
+    }
+}
+
 JsonValue JsonParser::parse()
 {
     consume_whitespace();
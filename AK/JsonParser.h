@@ -42,6 +42,27 @@ public:
 
     JsonValue parse();
 
+    // SAX-style streaming interface: instead of materializing a JsonValue
+    // tree, events are delivered to the client as the document is walked.
+    // Strings point straight into the source buffer whenever they contain
+    // no escape sequences; escaped strings point at scratch storage that's
+    // only valid until the next event, so copy what you keep.
+    class StreamingClient {
+    public:
+        virtual ~StreamingClient() {}
+        virtual void on_object_start() {}
+        virtual void on_object_key(const StringView&) {}
+        virtual void on_object_end() {}
+        virtual void on_array_start() {}
+        virtual void on_array_end() {}
+        virtual void on_string(const StringView&) {}
+        virtual void on_number(const JsonValue&) {}
+        virtual void on_bool(bool) {}
+        virtual void on_null() {}
+    };
+
+    void parse(StreamingClient&);
+
 private:
     char peek() const;
     char consume();
@@ -49,6 +70,7 @@ private:
     void consume_specific(char expected_ch);
     void consume_string(const char*);
     String consume_quoted_string();
+    StringView consume_quoted_string_view();
     JsonArray parse_array();
     JsonObject parse_object();
     JsonValue parse_number();
@@ -65,6 +87,7 @@ private:
     size_t m_index { 0 };
 
     String m_last_string_starting_with_character[256];
+    String m_scratch_string;
 };
 
 }
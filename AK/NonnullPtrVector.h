@@ -71,6 +71,17 @@ public:
     T& last() { return at(size() - 1); }
     const T& last() const { return at(size() - 1); }
 
+    // Moves every pointer out to the callback in order and leaves the
+    // vector empty. This hands each element to a new owner without any
+    // ref-count traffic, unlike iterating and copying the pointers out.
+    template<typename Callback>
+    void take_all(Callback callback)
+    {
+        for (int i = 0; i < (int)size(); ++i)
+            callback(move(ptr_at(i)));
+        Base::clear();
+    }
+
 private:
     // NOTE: You can't use resize() on a NonnullFooPtrVector since making the vector
     //       bigger would require being able to default-construct NonnullFooPtrs.
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/LogStream.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Types.h>
@@ -279,165 +280,285 @@ ALWAYS_INLINE int print_signed_number(PutChFunc putch, char*& bufptr, int number
         putch(bufptr, '-');
         return print_number(putch, bufptr, 0 - number, leftPad, zeroPad, fieldWidth) + 1;
     }
-    if (always_sign)
+    if (always_sign) {
         putch(bufptr, '+');
+        return print_number(putch, bufptr, number, leftPad, zeroPad, fieldWidth) + 1;
+    }
     return print_number(putch, bufptr, number, leftPad, zeroPad, fieldWidth);
 }
 
+struct PrintfSpec {
+    char conversion { 0 };
+    bool left_pad { false };
+    bool zero_pad { false };
+    bool dot { false };
+    bool always_sign { false };
+    bool alternate_form { false };
+    bool size_qualifier { false };
+    bool has_star_width { false };
+    u8 long_qualifiers { 0 };
+    unsigned field_width { 0 };
+    unsigned fraction_length { 0 };
+};
+
+// Lexes one specifier. 'p' points at the '%' and there is at least one more
+// character; returns a pointer to the conversion character. Never touches the
+// argument list, so a parsed spec can be reused across calls.
+ALWAYS_INLINE const char* parse_printf_spec(const char* p, PrintfSpec& spec)
+{
+    for (;;) {
+        ++p;
+        if (*p == '.')
+            spec.dot = true;
+        else if (*p == '-')
+            spec.left_pad = true;
+        else if (*p == '+')
+            spec.always_sign = true;
+        else if (!spec.zero_pad && !spec.field_width && *p == '0')
+            spec.zero_pad = true;
+        else if (*p >= '0' && *p <= '9') {
+            if (!spec.dot) {
+                spec.field_width *= 10;
+                spec.field_width += *p - '0';
+            } else {
+                spec.fraction_length *= 10;
+                spec.fraction_length += *p - '0';
+            }
+        } else if (*p == '*')
+            spec.has_star_width = true;
+        else if (*p == 'l')
+            ++spec.long_qualifiers;
+        else if (*p == 'z')
+            spec.size_qualifier = true;
+        else if (*p == '#')
+            spec.alternate_form = true;
+        else
+            break;
+        if (!*(p + 1))
+            break;
+    }
+    spec.conversion = *p;
+    return p;
+}
+
+// Emits one already-parsed specifier. A '*' width must have been resolved
+// into field_width by the caller (it consumes an argument, and argument order
+// matters). 'ret' is the number of characters emitted so far, for %n.
+// The argument list type is deduced so that consumption propagates to the
+// caller on every ABI, whether va_list is an array or a pointer type.
+template<typename PutChFunc, typename ArgList>
+ALWAYS_INLINE int apply_printf_spec(PutChFunc putch, char*& bufptr, const PrintfSpec& spec, int ret, ArgList& ap)
+{
+    switch (spec.conversion) {
+    case 's': {
+        const char* sp = va_arg(ap, const char*);
+        return print_string(putch, bufptr, sp ? sp : "(null)", spec.left_pad, spec.field_width, spec.dot);
+    }
+
+    case 'd':
+    case 'i':
+        if (spec.long_qualifiers >= 2)
+            return print_i64(putch, bufptr, va_arg(ap, i64), spec.left_pad, spec.zero_pad, spec.field_width);
+        return print_signed_number(putch, bufptr, va_arg(ap, int), spec.left_pad, spec.zero_pad, spec.field_width, spec.always_sign);
+
+    case 'u':
+        if (spec.long_qualifiers >= 2)
+            return print_u64(putch, bufptr, va_arg(ap, u64), spec.left_pad, spec.zero_pad, spec.field_width);
+        return print_number(putch, bufptr, va_arg(ap, u32), spec.left_pad, spec.zero_pad, spec.field_width);
+
+    case 'Q':
+        return print_u64(putch, bufptr, va_arg(ap, u64), spec.left_pad, spec.zero_pad, spec.field_width);
+
+    case 'q':
+        return print_hex(putch, bufptr, va_arg(ap, u64), false, false, spec.left_pad, spec.zero_pad, 16);
+
+#if !defined(BOOTSTRAPPER) && !defined(KERNEL)
+    case 'g':
+    case 'f':
+        return print_double(putch, bufptr, va_arg(ap, double), spec.left_pad, spec.zero_pad, spec.field_width, spec.fraction_length);
+#endif
+
+    case 'o': {
+        int emitted = 0;
+        if (spec.alternate_form) {
+            putch(bufptr, '0');
+            ++emitted;
+        }
+        return emitted + print_octal_number(putch, bufptr, va_arg(ap, u32), spec.left_pad, spec.zero_pad, spec.field_width);
+    }
+
+    case 'X':
+    case 'x':
+        return print_hex(putch, bufptr, va_arg(ap, u32), spec.conversion == 'X', spec.alternate_form, spec.left_pad, spec.zero_pad, spec.field_width);
+
+    case 'w':
+        return print_hex(putch, bufptr, va_arg(ap, int), false, spec.alternate_form, false, true, 4);
+
+    case 'b':
+        return print_hex(putch, bufptr, va_arg(ap, int), false, spec.alternate_form, false, true, 2);
+
+    case 'c': {
+        char s[2] { (char)va_arg(ap, int), 0 };
+        return print_string(putch, bufptr, s, spec.left_pad, spec.field_width, spec.dot);
+    }
+
+    case '%':
+        putch(bufptr, '%');
+        return 1;
+
+    case 'P':
+    case 'p':
+        return print_hex(putch, bufptr, va_arg(ap, u32), spec.conversion == 'P', true, false, true, 8);
+
+    case 'n':
+        *va_arg(ap, int*) = ret;
+        return 0;
+
+    default:
+        dbg() << "printf_internal: Unimplemented format specifier " << spec.conversion;
+        return 0;
+    }
+}
+
+// A format string parsed once into alternating literal runs and specifiers,
+// so hot callers don't re-lex the same format on every call.
+static constexpr size_t max_compiled_printf_segments = 8;
+static constexpr size_t max_cached_printf_format_length = 64;
+
+struct CompiledPrintfSegment {
+    const char* literal { nullptr };
+    unsigned literal_length { 0 };
+    bool has_spec { false };
+    PrintfSpec spec;
+};
+
+struct CompiledPrintfFormat {
+    CompiledPrintfSegment segments[max_compiled_printf_segments];
+    size_t segment_count { 0 };
+};
+
+// Returns false if the format has more segments than we care to cache.
+inline bool compile_printf_format(const char* fmt, CompiledPrintfFormat& out)
+{
+    out.segment_count = 0;
+    const char* p = fmt;
+    while (*p) {
+        if (out.segment_count >= max_compiled_printf_segments)
+            return false;
+        auto& segment = out.segments[out.segment_count++];
+        segment.literal = p;
+        while (*p && !(*p == '%' && *(p + 1)))
+            ++p;
+        segment.literal_length = p - segment.literal;
+        segment.has_spec = false;
+        segment.spec = PrintfSpec {};
+        if (*p) {
+            p = parse_printf_spec(p, segment.spec);
+            segment.has_spec = true;
+            ++p;
+        }
+    }
+    return true;
+}
+
+template<typename PutChFunc>
+ALWAYS_INLINE int printf_internal_compiled(PutChFunc putch, char* buffer, const CompiledPrintfFormat& format, va_list ap)
+{
+    int ret = 0;
+    char* bufptr = buffer;
+    for (size_t i = 0; i < format.segment_count; ++i) {
+        auto& segment = format.segments[i];
+        for (unsigned j = 0; j < segment.literal_length; ++j) {
+            putch(bufptr, segment.literal[j]);
+            ++ret;
+        }
+        if (!segment.has_spec)
+            continue;
+        if (segment.spec.has_star_width) {
+            PrintfSpec spec = segment.spec;
+            spec.field_width = va_arg(ap, int);
+            ret += apply_printf_spec(putch, bufptr, spec, ret, ap);
+        } else {
+            ret += apply_printf_spec(putch, bufptr, segment.spec, ret, ap);
+        }
+    }
+    return ret;
+}
+
+// A small insert-only cache of compiled formats. Entries are published with a
+// release store only after they're fully written, so lookups are lock-free and
+// safe from any context. The format's address is the hash key, but since not
+// every format string is a literal, each entry keeps a copy of the text and a
+// hit is verified against it; a freed-and-reused pointer can never alias a
+// different format. Formats that are too long or too complex (and slots lost
+// to collisions) simply fall back to the one-pass interpreter below.
+struct PrintfFormatCacheEntry {
+    CompiledPrintfFormat format;
+    char text[max_cached_printf_format_length];
+    Atomic<const char*> claimed_fmt;
+    Atomic<const char*> published_fmt;
+};
+
+inline const CompiledPrintfFormat* cached_printf_format(const char* fmt)
+{
+    static const size_t capacity = 64;
+    static const size_t max_probes = 4;
+    static PrintfFormatCacheEntry s_cache[capacity];
+
+    FlatPtr hash = (FlatPtr)fmt;
+    hash ^= hash >> 7;
+    for (size_t probe = 0; probe < max_probes; ++probe) {
+        auto& entry = s_cache[(hash + probe) % capacity];
+        const char* published = entry.published_fmt.load(AK::memory_order_acquire);
+        if (published) {
+            if (published != fmt)
+                continue;
+            const char* a = entry.text;
+            const char* b = fmt;
+            while (*a && *a == *b) {
+                ++a;
+                ++b;
+            }
+            if (*a != *b)
+                return nullptr;
+            return &entry.format;
+        }
+        const char* expected = nullptr;
+        if (!entry.claimed_fmt.compare_exchange_strong(expected, fmt, AK::memory_order_acq_rel))
+            continue;
+        size_t length = 0;
+        while (fmt[length] && length < max_cached_printf_format_length)
+            ++length;
+        if (length >= max_cached_printf_format_length)
+            return nullptr;
+        for (size_t i = 0; i <= length; ++i)
+            entry.text[i] = fmt[i];
+        if (!compile_printf_format(fmt, entry.format))
+            return nullptr;
+        entry.published_fmt.store(fmt, AK::memory_order_release);
+        return &entry.format;
+    }
+    return nullptr;
+}
+
 template<typename PutChFunc>
 ALWAYS_INLINE int printf_internal(PutChFunc putch, char* buffer, const char*& fmt, va_list ap)
 {
+    if (auto* compiled = cached_printf_format(fmt))
+        return printf_internal_compiled(putch, buffer, *compiled, ap);
+
     const char* p;
 
     int ret = 0;
     char* bufptr = buffer;
 
     for (p = fmt; *p; ++p) {
-        bool left_pad = false;
-        bool zeroPad = false;
-        bool dot = false;
-        unsigned fieldWidth = 0;
-        unsigned fraction_length = 0;
-        unsigned long_qualifiers = 0;
-        bool size_qualifier = false;
-        (void)size_qualifier;
-        bool alternate_form = 0;
-        bool always_sign = false;
         if (*p == '%' && *(p + 1)) {
-        one_more:
-            ++p;
-            if (*p == '.') {
-                dot = true;
-                if (*(p + 1))
-                    goto one_more;
-            }
-            if (*p == '-') {
-                left_pad = true;
-                if (*(p + 1))
-                    goto one_more;
-            }
-            if (*p == '+') {
-                always_sign = true;
-                if (*(p + 1))
-                    goto one_more;
-            }
-            if (!zeroPad && !fieldWidth && *p == '0') {
-                zeroPad = true;
-                if (*(p + 1))
-                    goto one_more;
-            }
-            if (*p >= '0' && *p <= '9') {
-                if (!dot) {
-                    fieldWidth *= 10;
-                    fieldWidth += *p - '0';
-                    if (*(p + 1))
-                        goto one_more;
-                } else {
-                    fraction_length *= 10;
-                    fraction_length += *p - '0';
-                    if (*(p + 1))
-                        goto one_more;
-                }
-            }
-            if (*p == '*') {
-                fieldWidth = va_arg(ap, int);
-                if (*(p + 1))
-                    goto one_more;
-            }
-            if (*p == 'l') {
-                ++long_qualifiers;
-                if (*(p + 1))
-                    goto one_more;
-            }
-            if (*p == 'z') {
-                size_qualifier = true;
-                if (*(p + 1))
-                    goto one_more;
-            }
-            if (*p == '#') {
-                alternate_form = true;
-                if (*(p + 1))
-                    goto one_more;
-            }
-            switch (*p) {
-            case 's': {
-                const char* sp = va_arg(ap, const char*);
-                ret += print_string(putch, bufptr, sp ? sp : "(null)", left_pad, fieldWidth, dot);
-            } break;
-
-            case 'd':
-            case 'i':
-                if (long_qualifiers >= 2)
-                    ret += print_i64(putch, bufptr, va_arg(ap, i64), left_pad, zeroPad, fieldWidth);
-                else
-                    ret += print_signed_number(putch, bufptr, va_arg(ap, int), left_pad, zeroPad, fieldWidth, always_sign);
-                break;
-
-            case 'u':
-                if (long_qualifiers >= 2)
-                    ret += print_u64(putch, bufptr, va_arg(ap, u64), left_pad, zeroPad, fieldWidth);
-                else
-                    ret += print_number(putch, bufptr, va_arg(ap, u32), left_pad, zeroPad, fieldWidth);
-                break;
-
-            case 'Q':
-                ret += print_u64(putch, bufptr, va_arg(ap, u64), left_pad, zeroPad, fieldWidth);
-                break;
-
-            case 'q':
-                ret += print_hex(putch, bufptr, va_arg(ap, u64), false, false, left_pad, zeroPad, 16);
-                break;
-
-#if !defined(BOOTSTRAPPER) && !defined(KERNEL)
-            case 'g':
-            case 'f':
-                ret += print_double(putch, bufptr, va_arg(ap, double), left_pad, zeroPad, fieldWidth, fraction_length);
-                break;
-#endif
-
-            case 'o':
-                if (alternate_form) {
-                    putch(bufptr, '0');
-                    ++ret;
-                }
-                ret += print_octal_number(putch, bufptr, va_arg(ap, u32), left_pad, zeroPad, fieldWidth);
-                break;
-
-            case 'X':
-            case 'x':
-                ret += print_hex(putch, bufptr, va_arg(ap, u32), *p == 'X', alternate_form, left_pad, zeroPad, fieldWidth);
-                break;
-
-            case 'w':
-                ret += print_hex(putch, bufptr, va_arg(ap, int), false, alternate_form, false, true, 4);
-                break;
-
-            case 'b':
-                ret += print_hex(putch, bufptr, va_arg(ap, int), false, alternate_form, false, true, 2);
-                break;
-
-            case 'c': {
-                char s[2] { (char)va_arg(ap, int), 0 };
-                ret += print_string(putch, bufptr, s, left_pad, fieldWidth, dot);
-            } break;
-
-            case '%':
-                putch(bufptr, '%');
-                ++ret;
-                break;
-
-            case 'P':
-            case 'p':
-                ret += print_hex(putch, bufptr, va_arg(ap, u32), *p == 'P', true, false, true, 8);
-                break;
-
-            case 'n':
-                *va_arg(ap, int*) = ret;
-                break;
-
-            default:
-                dbg() << "printf_internal: Unimplemented format specifier " << *p << " (fmt: " << fmt << ")";
-            }
+            PrintfSpec spec;
+            p = parse_printf_spec(p, spec);
+            if (spec.has_star_width)
+                spec.field_width = va_arg(ap, int);
+            ret += apply_printf_spec(putch, bufptr, spec, ret, ap);
         } else {
             putch(bufptr, *p);
             ++ret;
@@ -30,85 +30,213 @@
 
 namespace AK {
 
+static constexpr int insertion_sort_threshold = 16;
+
+// Pattern-defeating introsort: quicksort with an insertion-sort small case
+// and a heapsort fallback once recursion exceeds 2*log2(n), so adversarial
+// and already-sorted inputs stay O(n log n).
+static inline int sort_depth_limit(int size)
+{
+    int depth = 0;
+    while (size > 1) {
+        size >>= 1;
+        ++depth;
+    }
+    return 2 * depth;
+}
+
+template<typename Collection, typename LessThan>
+void insertion_sort(Collection& col, int start, int end, LessThan& less_than)
+{
+    for (int i = start + 1; i <= end; ++i) {
+        auto value = move(col[i]);
+        int j = i - 1;
+        for (; j >= start && less_than(value, col[j]); --j)
+            col[j + 1] = move(col[j]);
+        col[j + 1] = move(value);
+    }
+}
+
+template<typename Collection, typename LessThan>
+void heap_sort(Collection& col, int start, int end, LessThan& less_than)
+{
+    int size = end - start + 1;
+    auto sift_down = [&](int root, int count) {
+        for (;;) {
+            int child = 2 * root + 1;
+            if (child >= count)
+                return;
+            if (child + 1 < count && less_than(col[start + child], col[start + child + 1]))
+                ++child;
+            if (!less_than(col[start + root], col[start + child]))
+                return;
+            swap(col[start + root], col[start + child]);
+            root = child;
+        }
+    };
+    for (int i = size / 2 - 1; i >= 0; --i)
+        sift_down(i, size);
+    for (int i = size - 1; i > 0; --i) {
+        swap(col[start], col[start + i]);
+        sift_down(0, i);
+    }
+}
+
 /* This is a dual pivot quick sort. It is quite a bit faster than the single
  * pivot quick_sort below. The other quick_sort below should only be used when
  * you are stuck with simple iterators to a container and you don't have access
  * to the container itself.
  */
 template<typename Collection, typename LessThan>
-void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than)
+void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than, int depth_limit)
 {
-    if (start >= end) {
-        return;
-    }
+    while (end - start + 1 > insertion_sort_threshold) {
+        if (depth_limit-- == 0) {
+            heap_sort(col, start, end, less_than);
+            return;
+        }
 
-    int left_pointer, right_pointer;
-    if (!less_than(col[start], col[end])) {
-        swap(col[start], col[end]);
-    }
+        if (!less_than(col[start], col[end])) {
+            swap(col[start], col[end]);
+        }
 
-    int j = start + 1;
-    int k = start + 1;
-    int g = end - 1;
+        int j = start + 1;
+        int k = start + 1;
+        int g = end - 1;
 
-    auto left_pivot = col[start];
-    auto right_pivot = col[end];
+        auto left_pivot = col[start];
+        auto right_pivot = col[end];
 
-    while (k <= g) {
-        if (less_than(col[k], left_pivot)) {
-            swap(col[k], col[j]);
-            j++;
-        } else if (!less_than(col[k], right_pivot)) {
-            while (!less_than(col[g], right_pivot) && k < g) {
-                g--;
-            }
-            swap(col[k], col[g]);
-            g--;
+        while (k <= g) {
             if (less_than(col[k], left_pivot)) {
                 swap(col[k], col[j]);
                 j++;
+            } else if (!less_than(col[k], right_pivot)) {
+                while (!less_than(col[g], right_pivot) && k < g) {
+                    g--;
+                }
+                swap(col[k], col[g]);
+                g--;
+                if (less_than(col[k], left_pivot)) {
+                    swap(col[k], col[j]);
+                    j++;
+                }
             }
+            k++;
         }
-        k++;
-    }
-    j--;
-    g++;
+        j--;
+        g++;
+
+        swap(col[start], col[j]);
+        swap(col[end], col[g]);
 
-    swap(col[start], col[j]);
-    swap(col[end], col[g]);
+        int left_pointer = j;
+        int right_pointer = g;
 
-    left_pointer = j;
-    right_pointer = g;
+        dual_pivot_quick_sort(col, start, left_pointer - 1, less_than, depth_limit);
+        dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than, depth_limit);
+        // Iterate on the last partition instead of recursing into it.
+        start = right_pointer + 1;
+    }
+    insertion_sort(col, start, end, less_than);
+}
 
-    dual_pivot_quick_sort(col, start, left_pointer - 1, less_than);
-    dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than);
-    dual_pivot_quick_sort(col, right_pointer + 1, end, less_than);
+template<typename Collection, typename LessThan>
+void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than)
+{
+    dual_pivot_quick_sort(col, start, end, move(less_than), sort_depth_limit(end - start + 1));
 }
 
 template<typename Iterator, typename LessThan>
-void quick_sort(Iterator start, Iterator end, LessThan less_than)
+void insertion_sort(Iterator start, Iterator end, LessThan& less_than)
 {
     int size = end - start;
-    if (size <= 1)
-        return;
+    for (int i = 1; i < size; ++i) {
+        auto value = move(*(start + i));
+        int j = i - 1;
+        for (; j >= 0 && less_than(value, *(start + j)); --j)
+            *(start + j + 1) = move(*(start + j));
+        *(start + j + 1) = move(value);
+    }
+}
+
+template<typename Iterator, typename LessThan>
+void heap_sort(Iterator start, Iterator end, LessThan& less_than)
+{
+    int size = end - start;
+    auto sift_down = [&](int root, int count) {
+        for (;;) {
+            int child = 2 * root + 1;
+            if (child >= count)
+                return;
+            if (child + 1 < count && less_than(*(start + child), *(start + child + 1)))
+                ++child;
+            if (!less_than(*(start + root), *(start + child)))
+                return;
+            swap(*(start + root), *(start + child));
+            root = child;
+        }
+    };
+    for (int i = size / 2 - 1; i >= 0; --i)
+        sift_down(i, size);
+    for (int i = size - 1; i > 0; --i) {
+        swap(*start, *(start + i));
+        sift_down(0, i);
+    }
+}
 
-    int pivot_point = size / 2;
-    auto pivot = *(start + pivot_point);
+template<typename Iterator, typename LessThan>
+void quick_sort(Iterator start, Iterator end, LessThan less_than, int depth_limit)
+{
+    for (;;) {
+        int size = end - start;
+        if (size <= insertion_sort_threshold) {
+            insertion_sort(start, end, less_than);
+            return;
+        }
+        if (depth_limit-- == 0) {
+            heap_sort(start, end, less_than);
+            return;
+        }
 
-    if (pivot_point)
-        swap(*(start + pivot_point), *start);
+        // Median-of-three pivot selection defeats sorted and reverse-sorted
+        // inputs cheaply.
+        auto middle = start + size / 2;
+        auto last = end - 1;
+        if (less_than(*middle, *start))
+            swap(*middle, *start);
+        if (less_than(*last, *start))
+            swap(*last, *start);
+        if (less_than(*last, *middle))
+            swap(*last, *middle);
+        swap(*start, *middle);
 
-    int i = 1;
-    for (int j = 1; j < size; ++j) {
-        if (less_than(*(start + j), pivot)) {
-            swap(*(start + j), *(start + i));
-            ++i;
+        auto pivot = *start;
+        int i = 1;
+        for (int j = 1; j < size; ++j) {
+            if (less_than(*(start + j), pivot)) {
+                swap(*(start + j), *(start + i));
+                ++i;
+            }
+        }
+        swap(*start, *(start + i - 1));
+
+        // Recurse into the smaller partition and iterate on the bigger one,
+        // bounding stack depth to O(log n).
+        if (i - 1 < size - i) {
+            quick_sort(start, start + i - 1, less_than, depth_limit);
+            start = start + i;
+        } else {
+            quick_sort(start + i, end, less_than, depth_limit);
+            end = start + i - 1;
         }
     }
+}
 
-    swap(*start, *(start + i - 1));
-    quick_sort(start, start + i - 1, less_than);
-    quick_sort(start + i, end, less_than);
+template<typename Iterator, typename LessThan>
+void quick_sort(Iterator start, Iterator end, LessThan less_than)
+{
+    quick_sort(start, end, move(less_than), sort_depth_limit(end - start));
 }
 
 template<typename Iterator>
@@ -39,6 +39,11 @@ public:
     {
     }
 
+    Result(ValueType&& res)
+        : m_result(move(res))
+    {
+    }
+
     Result(const ErrorType& error)
         : m_error(error)
     {
@@ -100,6 +100,7 @@ void SharedBuffer::seal()
         perror("shbuf_seal");
         ASSERT_NOT_REACHED();
     }
+    m_sealed = true;
 }
 
 void SharedBuffer::set_volatile()
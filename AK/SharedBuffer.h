@@ -43,6 +43,7 @@ public:
     bool share_with(pid_t);
     int shbuf_id() const { return m_shbuf_id; }
     void seal();
+    bool is_sealed() const { return m_sealed; }
     int size() const { return m_size; }
     void* data() { return m_data; }
     const void* data() const { return m_data; }
@@ -54,6 +55,7 @@ private:
 
     int m_shbuf_id { -1 };
     int m_size { 0 };
+    bool m_sealed { false };
     void* m_data;
 };
 
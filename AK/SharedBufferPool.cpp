@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __serenity__
+
+#include <AK/SharedBufferPool.h>
+
+namespace AK {
+
+SharedBufferPool& SharedBufferPool::the()
+{
+    static SharedBufferPool* s_the;
+    if (!s_the)
+        s_the = new SharedBufferPool;
+    return *s_the;
+}
+
+RefPtr<SharedBuffer> SharedBufferPool::acquire(int size)
+{
+    // Prefer the smallest free buffer that is still large enough, so big
+    // buffers stay available for big requests.
+    int best_index = -1;
+    for (size_t i = 0; i < m_free_buffers.size(); ++i) {
+        if (m_free_buffers[i]->size() < size)
+            continue;
+        if (best_index == -1 || m_free_buffers[i]->size() < m_free_buffers[best_index]->size())
+            best_index = i;
+    }
+    if (best_index != -1) {
+        RefPtr<SharedBuffer> buffer = m_free_buffers[best_index];
+        m_free_buffers.remove(best_index);
+        return buffer;
+    }
+    return SharedBuffer::create_with_size(size);
+}
+
+void SharedBufferPool::recycle(SharedBuffer& buffer)
+{
+    // A sealed buffer can never be written again, so it's useless to us.
+    if (buffer.is_sealed())
+        return;
+    if (m_free_buffers.size() >= max_free_buffers)
+        return;
+    m_free_buffers.append(buffer);
+}
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifdef __serenity__
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/SharedBuffer.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A small per-process free list of SharedBuffers, for producers that allocate
+// (and share) buffers at a high rate. Recycling a buffer keeps its mapping,
+// its shbuf id, and any sharing grants it already has, so handing it out
+// again costs no syscalls at all.
+//
+// A buffer may only be recycled once the caller knows no other process will
+// read from it again; the pool cannot check that for you.
+class SharedBufferPool {
+public:
+    static SharedBufferPool& the();
+
+    RefPtr<SharedBuffer> acquire(int size);
+    void recycle(SharedBuffer&);
+
+private:
+    SharedBufferPool() {}
+
+    static const size_t max_free_buffers = 8;
+    Vector<NonnullRefPtr<SharedBuffer>> m_free_buffers;
+};
+
+}
+
+using AK::SharedBufferPool;
+
+#endif
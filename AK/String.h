@@ -227,8 +227,8 @@ struct Traits<String> : public GenericTraits<String> {
 };
 
 struct CaseInsensitiveStringTraits : public AK::Traits<String> {
-    static unsigned hash(const String& s) { return s.impl() ? s.to_lowercase().impl()->hash() : 0; }
-    static bool equals(const String& a, const String& b) { return a.to_lowercase() == b.to_lowercase(); }
+    static unsigned hash(const String& s) { return s.impl() ? s.impl()->case_insensitive_hash() : 0; }
+    static bool equals(const String& a, const String& b) { return a.equals_ignoring_case(b); }
 };
 
 bool operator<(const char*, const String&);
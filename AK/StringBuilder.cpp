@@ -35,8 +35,19 @@ namespace AK {
 
 inline void StringBuilder::will_append(size_t size)
 {
-    if ((m_length + size) > m_buffer.size())
-        m_buffer.grow(max(static_cast<size_t>(16), m_buffer.size() * 2 + size));
+    if ((m_tail_length + size) <= m_buffer.size())
+        return;
+    // Seal the filled tail and start a fresh chunk instead of growing in
+    // place, so what's already built never gets re-copied.
+    auto next_chunk_size = max(max(static_cast<size_t>(16), m_buffer.size() * 2), size);
+    if (m_tail_length) {
+        m_buffer.trim(m_tail_length);
+        m_chunked_length += m_tail_length;
+        m_full_chunks.append(move(m_buffer));
+        m_buffer = {};
+        m_tail_length = 0;
+    }
+    m_buffer.grow(next_chunk_size);
 }
 
 StringBuilder::StringBuilder(size_t initial_capacity)
@@ -44,13 +55,30 @@ StringBuilder::StringBuilder(size_t initial_capacity)
     m_buffer.grow((int)initial_capacity);
 }
 
+void StringBuilder::linearize()
+{
+    if (m_full_chunks.is_empty())
+        return;
+    auto buffer = ByteBuffer::create_uninitialized(length());
+    size_t offset = 0;
+    for (auto& chunk : m_full_chunks) {
+        memcpy(buffer.data() + offset, chunk.data(), chunk.size());
+        offset += chunk.size();
+    }
+    memcpy(buffer.data() + offset, m_buffer.data(), m_tail_length);
+    m_tail_length = buffer.size();
+    m_buffer = move(buffer);
+    m_full_chunks.clear();
+    m_chunked_length = 0;
+}
+
 void StringBuilder::append(const StringView& str)
 {
     if (str.is_empty())
         return;
     will_append(str.length());
-    memcpy(m_buffer.data() + m_length, str.characters_without_null_termination(), str.length());
-    m_length += str.length();
+    memcpy(m_buffer.data() + m_tail_length, str.characters_without_null_termination(), str.length());
+    m_tail_length += str.length();
 }
 
 void StringBuilder::append(const char* characters, size_t length)
@@ -61,8 +89,8 @@ void StringBuilder::append(const char* characters, size_t length)
 void StringBuilder::append(char ch)
 {
     will_append(1);
-    m_buffer.data()[m_length] = ch;
-    m_length += 1;
+    m_buffer.data()[m_tail_length] = ch;
+    m_tail_length += 1;
 }
 
 void StringBuilder::appendvf(const char* fmt, va_list ap)
@@ -82,16 +110,43 @@ void StringBuilder::appendf(const char* fmt, ...)
     va_end(ap);
 }
 
+void StringBuilder::trim(size_t count)
+{
+    while (count > m_tail_length && !m_full_chunks.is_empty()) {
+        count -= m_tail_length;
+        m_buffer = m_full_chunks.take_last();
+        m_tail_length = m_buffer.size();
+        m_chunked_length -= m_tail_length;
+    }
+    ASSERT(count <= m_tail_length);
+    m_tail_length -= count;
+}
+
 ByteBuffer StringBuilder::to_byte_buffer() const
 {
-    ByteBuffer buffer_copy = m_buffer.isolated_copy();
-    buffer_copy.trim(m_length);
-    return buffer_copy;
+    auto buffer = ByteBuffer::create_uninitialized(length());
+    size_t offset = 0;
+    for (auto& chunk : m_full_chunks) {
+        memcpy(buffer.data() + offset, chunk.data(), chunk.size());
+        offset += chunk.size();
+    }
+    memcpy(buffer.data() + offset, m_buffer.data(), m_tail_length);
+    return buffer;
 }
 
 String StringBuilder::to_string() const
 {
-    return String((const char*)m_buffer.data(), m_length);
+    if (is_empty())
+        return String::empty();
+    char* buffer;
+    auto impl = StringImpl::create_uninitialized(length(), buffer);
+    size_t offset = 0;
+    for (auto& chunk : m_full_chunks) {
+        memcpy(buffer + offset, chunk.data(), chunk.size());
+        offset += chunk.size();
+    }
+    memcpy(buffer + offset, m_buffer.data(), m_tail_length);
+    return impl;
 }
 
 String StringBuilder::build() const
@@ -101,13 +156,18 @@ String StringBuilder::build() const
 
 StringView StringBuilder::string_view() const
 {
-    return StringView { (const char*)m_buffer.data(), m_length };
+    // Logically const: the contents don't change, they just become
+    // contiguous so a single view over them is possible.
+    const_cast<StringBuilder*>(this)->linearize();
+    return StringView { (const char*)m_buffer.data(), m_tail_length };
 }
 
 void StringBuilder::clear()
 {
+    m_full_chunks.clear();
+    m_chunked_length = 0;
     m_buffer.clear();
-    m_length = 0;
+    m_tail_length = 0;
 }
 
 }
@@ -28,6 +28,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/Forward.h>
+#include <AK/Vector.h>
 #include <stdarg.h>
 
 namespace AK {
@@ -52,9 +53,9 @@ public:
     StringView string_view() const;
     void clear();
 
-    size_t length() const { return m_length; }
-    bool is_empty() const { return m_length == 0; }
-    void trim(size_t count) { m_length -= count; }
+    size_t length() const { return m_chunked_length + m_tail_length; }
+    bool is_empty() const { return length() == 0; }
+    void trim(size_t count);
 
     template<class SeparatorType, class CollectionType>
     void join(const SeparatorType& separator, const CollectionType& collection)
@@ -71,9 +72,16 @@ public:
 
 private:
     void will_append(size_t);
+    void linearize();
 
+    // Sealed chunks plus a partially filled tail chunk; appending never
+    // re-copies what's already built. Everything gets stitched together
+    // when the final string is produced (or by linearize() for callers
+    // that need a contiguous view of work in progress.)
+    Vector<ByteBuffer> m_full_chunks;
+    size_t m_chunked_length { 0 };
     ByteBuffer m_buffer;
-    size_t m_length { 0 };
+    size_t m_tail_length { 0 };
 };
 
 }
@@ -198,4 +198,13 @@ void StringImpl::compute_hash() const
     m_has_hash = true;
 }
 
+void StringImpl::compute_case_insensitive_hash() const
+{
+    if (!length())
+        m_case_insensitive_hash = 0;
+    else
+        m_case_insensitive_hash = case_insensitive_string_hash(characters(), m_length);
+    m_has_case_insensitive_hash = true;
+}
+
 }
@@ -76,6 +76,16 @@ public:
         return m_hash;
     }
 
+    // Memoized like hash(), for CaseInsensitiveStringTraits users (HTTP
+    // headers and the like) that used to lowercase the whole string just to
+    // hash it.
+    unsigned case_insensitive_hash() const
+    {
+        if (!m_has_case_insensitive_hash)
+            compute_case_insensitive_hash();
+        return m_case_insensitive_hash;
+    }
+
     bool is_fly() const { return m_fly; }
     void set_fly(Badge<FlyString>, bool fly) const { m_fly = fly; }
 
@@ -95,14 +105,34 @@ private:
     StringImpl(ConstructWithInlineBufferTag, size_t length);
 
     void compute_hash() const;
+    void compute_case_insensitive_hash() const;
 
     size_t m_length { 0 };
     mutable unsigned m_hash { 0 };
+    mutable unsigned m_case_insensitive_hash { 0 };
     mutable bool m_has_hash { false };
+    mutable bool m_has_case_insensitive_hash { false };
     mutable bool m_fly { false };
     char m_inline_buffer[0];
 };
 
+inline constexpr u32 case_insensitive_string_hash(const char* characters, size_t length)
+{
+    u32 hash = 0;
+    for (size_t i = 0; i < length; ++i) {
+        u32 character = (u32)characters[i];
+        if (character >= 'A' && character <= 'Z')
+            character |= 0x20;
+        hash += character;
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    hash += hash << 3;
+    hash ^= hash >> 11;
+    hash += hash << 15;
+    return hash;
+}
+
 inline constexpr u32 string_hash(const char* characters, size_t length)
 {
     u32 hash = 0;
@@ -119,6 +149,7 @@ inline constexpr u32 string_hash(const char* characters, size_t length)
 
 }
 
+using AK::case_insensitive_string_hash;
 using AK::Chomp;
 using AK::string_hash;
 using AK::StringImpl;
@@ -31,8 +31,59 @@
 #include <AK/StringView.h>
 #include <AK/Vector.h>
 
+// The byte-scanning kernel below has an SSE2 variant selected at runtime.
+// It's kept out of kernel builds: the kernel doesn't save SIMD state for
+// its own threads, so touching XMM registers there would corrupt userspace.
+#if (defined(__i386__) || defined(__x86_64__)) && !defined(KERNEL) && !defined(BOOTSTRAPPER)
+#    define AK_STRINGVIEW_SSE2_KERNEL
+#    include <cpuid.h>
+#    include <emmintrin.h>
+#endif
+
 namespace AK {
 
+#ifdef AK_STRINGVIEW_SSE2_KERNEL
+static bool has_sse2()
+{
+    static int s_has_sse2 = -1;
+    if (s_has_sse2 == -1) {
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        s_has_sse2 = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (edx & (1 << 26))) ? 1 : 0;
+    }
+    return s_has_sse2 == 1;
+}
+
+__attribute__((target("sse2"))) static const char* find_byte_sse2(const char* data, size_t length, char needle)
+{
+    auto needles = _mm_set1_epi8(needle);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        auto chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needles));
+        if (mask)
+            return data + i + __builtin_ctz(mask);
+    }
+    for (; i < length; ++i) {
+        if (data[i] == needle)
+            return data + i;
+    }
+    return nullptr;
+}
+#endif
+
+static const char* find_byte(const char* data, size_t length, char needle)
+{
+#ifdef AK_STRINGVIEW_SSE2_KERNEL
+    if (length >= 16 && has_sse2())
+        return find_byte_sse2(data, length, needle);
+#endif
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == needle)
+            return data + i;
+    }
+    return nullptr;
+}
+
 StringView::StringView(const String& string)
     : m_impl(string.impl())
     , m_characters(string.characters())
@@ -60,14 +111,15 @@ Vector<StringView> StringView::split_view(const char separator, bool keep_empty)
 
     Vector<StringView> v;
     size_t substart = 0;
-    for (size_t i = 0; i < length(); ++i) {
-        char ch = characters_without_null_termination()[i];
-        if (ch == separator) {
-            size_t sublen = i - substart;
-            if (sublen != 0 || keep_empty)
-                v.append(substring_view(substart, sublen));
-            substart = i + 1;
-        }
+    for (;;) {
+        auto* next = find_byte(m_characters + substart, length() - substart, separator);
+        if (!next)
+            break;
+        size_t i = next - m_characters;
+        size_t sublen = i - substart;
+        if (sublen != 0 || keep_empty)
+            v.append(substring_view(substart, sublen));
+        substart = i + 1;
     }
     size_t taillen = length() - substart;
     if (taillen != 0 || keep_empty)
@@ -159,11 +211,38 @@ bool StringView::matches(const StringView& mask, CaseSensitivity case_sensitivit
 
 bool StringView::contains(char needle) const
 {
-    for (char current : *this) {
-        if (current == needle)
-            return true;
+    return find_byte(m_characters, m_length, needle) != nullptr;
+}
+
+Optional<size_t> StringView::find(char needle) const
+{
+    auto* result = find_byte(m_characters, m_length, needle);
+    if (!result)
+        return {};
+    return result - m_characters;
+}
+
+Optional<size_t> StringView::find(const StringView& needle) const
+{
+    if (needle.is_empty())
+        return 0;
+    if (needle.length() > length())
+        return {};
+    // Scan for the needle's first byte with the fast kernel, and only do a
+    // full comparison at those candidate positions.
+    size_t offset = 0;
+    size_t remaining = length();
+    while (remaining >= needle.length()) {
+        auto* candidate = find_byte(m_characters + offset, remaining - needle.length() + 1, needle[0]);
+        if (!candidate)
+            return {};
+        size_t candidate_index = candidate - m_characters;
+        if (!memcmp(candidate, needle.characters_without_null_termination(), needle.length()))
+            return candidate_index;
+        offset = candidate_index + 1;
+        remaining = length() - offset;
     }
-    return false;
+    return {};
 }
 
 StringView StringView::substring_view(size_t start, size_t length) const
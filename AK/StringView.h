@@ -29,8 +29,10 @@
 #include <AK/Assertions.h>
 #include <AK/Checked.h>
 #include <AK/Forward.h>
+#include <AK/Optional.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringUtils.h>
+#include <AK/Traits.h>
 
 namespace AK {
 
@@ -78,6 +80,8 @@ public:
     bool ends_with(char) const;
     bool matches(const StringView& mask, CaseSensitivity = CaseSensitivity::CaseInsensitive) const;
     bool contains(char) const;
+    Optional<size_t> find(char) const;
+    Optional<size_t> find(const StringView&) const;
 
     StringView substring_view(size_t start, size_t length) const;
     Vector<StringView> split_view(char, bool keep_empty = false) const;
@@ -153,6 +157,11 @@ private:
     size_t m_length { 0 };
 };
 
+template<>
+struct Traits<StringView> : public GenericTraits<StringView> {
+    static unsigned hash(const StringView& s) { return s.hash(); }
+};
+
 }
 
 using AK::StringView;
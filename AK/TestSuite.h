@@ -39,12 +39,26 @@
 #define RELEASE_ASSERT ASSERT
 
 #include <AK/Function.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <chrono>
+#include <stdlib.h>
 
 namespace AK {
 
+// Works on the host as well as in-system; everything we run on is x86.
+static inline uint64_t read_tsc()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
 class TestElapsedTimer {
     typedef std::chrono::high_resolution_clock clock;
 
@@ -133,11 +147,23 @@ public:
     }
 
 private:
+    struct TestResult {
+        String name;
+        bool is_benchmark { false };
+        int64_t time_ms { 0 };
+        uint64_t cycles { 0 };
+    };
+
+    void write_results_json();
+
     static TestSuite* s_global;
     NonnullRefPtrVector<TestCase> m_cases;
     uint64_t m_testtime = 0;
     uint64_t m_benchtime = 0;
     String m_suite_name;
+    String m_json_path;
+    int m_bench_iterations = 1;
+    Vector<TestResult> m_results;
 };
 
 void TestSuite::main(const String& suite_name, int argc, char** argv)
@@ -154,7 +180,17 @@ void TestSuite::main(const String& suite_name, int argc, char** argv)
             find_tests = false;
         } else if (String(argv[i]) == String("--test")) {
             find_benchmarks = false;
+        } else if (String(argv[i]) == String("--json") && i + 1 < argc) {
+            m_json_path = argv[++i];
+        } else if (String(argv[i]) == String("--bench-iterations") && i + 1 < argc) {
+            m_bench_iterations = atoi(argv[++i]);
+            if (m_bench_iterations < 1)
+                m_bench_iterations = 1;
         } else if (String(argv[i]) == String("--help")) {
+            dbg() << "Options:";
+            dbg() << "\t--test / --bench: only run tests or benchmarks";
+            dbg() << "\t--bench-iterations <n>: run each benchmark n times, keep the fastest";
+            dbg() << "\t--json <path>: write results (time and TSC cycles) to a file";
             dbg() << "Available tests for " << suite_name << ":";
             const auto& tests = find_cases("*", true, false);
             for (const auto& t : tests) {
@@ -205,14 +241,27 @@ void TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
     TestElapsedTimer global_timer;
     for (const auto& t : tests) {
         dbg() << "START Running " << (t.is_benchmark() ? "benchmark" : "test") << " " << t.name();
-        TestElapsedTimer timer;
-        try {
-            t.func()();
-        } catch (const TestException& t) {
-            fprintf(stderr, "\033[31;1mFAIL\033[0m: %s\n", t.to_string().characters());
-            exit(1);
+        // Keep the fastest iteration; it carries the least scheduler noise.
+        const int iterations = t.is_benchmark() ? m_bench_iterations : 1;
+        int64_t time = -1;
+        uint64_t cycles = 0;
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            TestElapsedTimer timer;
+            uint64_t start_cycles = read_tsc();
+            try {
+                t.func()();
+            } catch (const TestException& t) {
+                fprintf(stderr, "\033[31;1mFAIL\033[0m: %s\n", t.to_string().characters());
+                exit(1);
+            }
+            uint64_t iteration_cycles = read_tsc() - start_cycles;
+            auto iteration_time = timer.elapsed();
+            if (time < 0 || iteration_time < time) {
+                time = iteration_time;
+                cycles = iteration_cycles;
+            }
         }
-        auto time = timer.elapsed();
+        m_results.append({ t.name(), t.is_benchmark(), time, cycles });
         fprintf(stderr, "\033[32;1mPASS\033[0m: %d ms running %s %s\n", (int)time, (t.is_benchmark() ? "benchmark" : "test"), t.name().characters());
         if (t.is_benchmark()) {
             m_benchtime += time;
@@ -224,6 +273,35 @@ void TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
     }
     dbg() << "Finished " << test_count << " tests and " << benchmark_count << " benchmarks in " << (int)global_timer.elapsed() << " ms ("
           << (int)m_testtime << " tests, " << (int)m_benchtime << " benchmarks, " << int(global_timer.elapsed() - (m_testtime + m_benchtime)) << " other)";
+
+    if (!m_json_path.is_empty())
+        write_results_json();
+}
+
+void TestSuite::write_results_json()
+{
+    JsonObject root;
+    root.set("suite", m_suite_name);
+    JsonArray cases;
+    for (auto& result : m_results) {
+        JsonObject case_object;
+        case_object.set("name", result.name);
+        case_object.set("type", result.is_benchmark ? "benchmark" : "test");
+        case_object.set("time_ms", (i64)result.time_ms);
+        case_object.set("cycles", (u64)result.cycles);
+        cases.append(case_object);
+    }
+    root.set("cases", cases);
+
+    FILE* file = fopen(m_json_path.characters(), "w");
+    if (!file) {
+        perror("fopen");
+        return;
+    }
+    auto serialized = root.to_string();
+    fwrite(serialized.characters(), 1, serialized.length(), file);
+    fputc('\n', file);
+    fclose(file);
 }
 
 }
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares two benchmark result files produced by running a test suite with
+// "--json <path>" and flags benchmarks that got slower than a threshold.
+//
+// Usage: CompareBenchmarkResults <old.json> <new.json> [threshold-percent]
+
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/String.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static Optional<JsonValue> read_results_file(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return {};
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    auto buffer = ByteBuffer::create_uninitialized(size);
+    if (fread(buffer.data(), 1, size, file) != (size_t)size) {
+        fprintf(stderr, "%s: short read\n", path);
+        fclose(file);
+        return {};
+    }
+    fclose(file);
+    auto json = JsonValue::from_string((const char*)buffer.data());
+    if (!json.is_object()) {
+        fprintf(stderr, "%s: not a results file\n", path);
+        return {};
+    }
+    return json;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3 || argc > 4) {
+        printf("Usage: %s <old.json> <new.json> [threshold-percent]\n", argv[0]);
+        return 1;
+    }
+    double threshold_percent = 10.0;
+    if (argc == 4)
+        threshold_percent = atof(argv[3]);
+
+    auto old_json = read_results_file(argv[1]);
+    auto new_json = read_results_file(argv[2]);
+    if (!old_json.has_value() || !new_json.has_value())
+        return 1;
+
+    HashMap<String, double> old_times;
+    old_json.value().as_object().get("cases").as_array().for_each([&](auto& value) {
+        auto& case_object = value.as_object();
+        if (case_object.get("type").to_string() != "benchmark")
+            return;
+        old_times.set(case_object.get("name").to_string(), (double)case_object.get("time_ms").template to_number<i64>());
+    });
+
+    int regression_count = 0;
+    new_json.value().as_object().get("cases").as_array().for_each([&](auto& value) {
+        auto& case_object = value.as_object();
+        if (case_object.get("type").to_string() != "benchmark")
+            return;
+        auto name = case_object.get("name").to_string();
+        double new_time = (double)case_object.get("time_ms").template to_number<i64>();
+        auto old_time = old_times.get(name);
+        if (!old_time.has_value()) {
+            printf("NEW     %-40s          -> %8.0f ms\n", name.characters(), new_time);
+            return;
+        }
+        double delta_percent = 0;
+        if (old_time.value() > 0)
+            delta_percent = (new_time - old_time.value()) / old_time.value() * 100.0;
+        const char* verdict = "OK    ";
+        if (delta_percent >= threshold_percent) {
+            verdict = "SLOWER";
+            ++regression_count;
+        } else if (delta_percent <= -threshold_percent) {
+            verdict = "FASTER";
+        }
+        printf("%s  %-40s %8.0f -> %8.0f ms (%+.1f%%)\n", verdict, name.characters(), old_time.value(), new_time, delta_percent);
+    });
+
+    if (regression_count > 0) {
+        printf("%d benchmark(s) regressed by more than %.1f%%\n", regression_count, threshold_percent);
+        return 1;
+    }
+    return 0;
+}
@@ -131,4 +131,27 @@ TEST_CASE(hashmap_of_nonnullownptr_get)
     EXPECT_EQ(objects.size(), 3u);
 }
 
+BENCHMARK_CASE(hashmap_populate_int_keys)
+{
+    HashMap<int, int> map;
+    for (int i = 0; i < 100000; ++i)
+        map.set(i, i * 2);
+    EXPECT_EQ(map.size(), 100000u);
+}
+
+BENCHMARK_CASE(hashmap_lookup_int_keys)
+{
+    HashMap<int, int> map;
+    for (int i = 0; i < 10000; ++i)
+        map.set(i, i * 2);
+    int hits = 0;
+    for (int pass = 0; pass < 100; ++pass) {
+        for (int i = 0; i < 10000; ++i) {
+            if (map.get(i).has_value())
+                ++hits;
+        }
+    }
+    EXPECT_EQ(hits, 1000000);
+}
+
 TEST_MAIN(HashMap)
@@ -198,4 +198,21 @@ TEST_CASE(split)
     EXPECT_EQ(parts[2].characters()[3], '\0');
 }
 
+BENCHMARK_CASE(string_format)
+{
+    for (int i = 0; i < 100000; ++i) {
+        auto formatted = String::format("hello %d friends", i);
+        EXPECT(!formatted.is_empty());
+    }
+}
+
+BENCHMARK_CASE(string_builder_append)
+{
+    StringBuilder builder;
+    for (int i = 0; i < 100000; ++i)
+        builder.append("well hello friends");
+    auto built = builder.to_string();
+    EXPECT_EQ(built.length(), 100000u * 18);
+}
+
 TEST_MAIN(String)
@@ -27,6 +27,7 @@
 #include <AK/Assertions.h>
 #include <AK/LogStream.h>
 #include <AK/Utf8View.h>
+#include <AK/Vector.h>
 
 namespace AK {
 
@@ -132,6 +133,65 @@ bool Utf8View::validate() const
     return true;
 }
 
+Vector<u32> Utf8View::to_codepoints() const
+{
+    Vector<u32> codepoints;
+    // Every codepoint takes at least one byte, so this can't overshoot.
+    codepoints.ensure_capacity(byte_length());
+
+    auto* ptr = begin_ptr();
+    auto* end = end_ptr();
+    while (ptr < end) {
+        // ASCII fast path: step a word at a time while no byte has the
+        // high bit set.
+        while (end - ptr >= 4 && !(*(const u32*)ptr & 0x80808080)) {
+            codepoints.unchecked_append(ptr[0]);
+            codepoints.unchecked_append(ptr[1]);
+            codepoints.unchecked_append(ptr[2]);
+            codepoints.unchecked_append(ptr[3]);
+            ptr += 4;
+        }
+        if (ptr >= end)
+            break;
+        if (!(*ptr & 0x80)) {
+            codepoints.unchecked_append(*ptr++);
+            continue;
+        }
+
+        int codepoint_length_in_bytes = 0;
+        u32 value = 0;
+        bool first_byte_makes_sense = decode_first_byte(*ptr, codepoint_length_in_bytes, value);
+        ASSERT(first_byte_makes_sense);
+        ASSERT(ptr + codepoint_length_in_bytes <= end);
+        for (int i = 1; i < codepoint_length_in_bytes; ++i) {
+            ASSERT(ptr[i] >> 6 == 2);
+            value <<= 6;
+            value |= ptr[i] & 63;
+        }
+        codepoints.unchecked_append(value);
+        ptr += codepoint_length_in_bytes;
+    }
+    return codepoints;
+}
+
+size_t Utf8View::calculate_length_in_codepoints() const
+{
+    size_t length = 0;
+    auto* ptr = begin_ptr();
+    auto* end = end_ptr();
+    while (ptr < end) {
+        while (end - ptr >= 4 && !(*(const u32*)ptr & 0x80808080)) {
+            length += 4;
+            ptr += 4;
+        }
+        if (ptr >= end)
+            break;
+        // Count every byte that isn't a continuation byte.
+        length += (*ptr++ >> 6) != 2;
+    }
+    return length;
+}
+
 Utf8CodepointIterator::Utf8CodepointIterator(const unsigned char* ptr, int length)
     : m_ptr(ptr)
     , m_length(length)
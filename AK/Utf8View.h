@@ -72,11 +72,29 @@ public:
 
     bool validate() const;
 
+    // Decodes every codepoint into a Vector in one pass, with a
+    // word-at-a-time fast path over ASCII runs. Prefer this over the
+    // iterator when all codepoints are needed anyway, e.g. when a string
+    // gets measured and then drawn.
+    Vector<u32> to_codepoints() const;
+
+    size_t length_in_codepoints() const
+    {
+        if (!m_have_length) {
+            m_length_in_codepoints = calculate_length_in_codepoints();
+            m_have_length = true;
+        }
+        return m_length_in_codepoints;
+    }
+
 private:
     const unsigned char* begin_ptr() const;
     const unsigned char* end_ptr() const;
+    size_t calculate_length_in_codepoints() const;
 
     StringView m_string;
+    mutable size_t m_length_in_codepoints { 0 };
+    mutable bool m_have_length { false };
 };
 
 }
@@ -566,6 +566,27 @@ public:
         m_size = new_size;
     }
 
+    void resize_uninitialized(size_t new_size)
+    {
+        // Skipping element construction is only sound when there is nothing
+        // to construct; callers are expected to fill the elements themselves.
+        static_assert(Traits<T>::is_trivial());
+        if (new_size <= size())
+            return shrink(new_size);
+
+        ensure_capacity(new_size);
+        m_size = new_size;
+    }
+
+    T* append_uninitialized(size_t count)
+    {
+        static_assert(Traits<T>::is_trivial());
+        grow_capacity(size() + count);
+        auto* tail = slot(m_size);
+        m_size += count;
+        return tail;
+    }
+
     using Iterator = VectorIterator<Vector, T>;
     Iterator begin() { return Iterator(*this, 0); }
     Iterator end() { return Iterator(*this, size()); }
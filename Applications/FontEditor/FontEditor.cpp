@@ -120,6 +120,7 @@ FontEditorWidget::FontEditorWidget(const String& path, RefPtr<Gfx::Font>&& edite
 
     m_ui->fixed_width_checkbox->on_checked = [this, update_demo](bool checked) {
         m_edited_font->set_fixed_width(checked);
+        Gfx::Painter::invalidate_glyph_run_cache(*m_edited_font);
         m_ui->width_spinbox->set_value(m_edited_font->glyph_width(m_glyph_map_widget->selected_glyph()));
         m_glyph_editor_widget->update();
         update_demo();
@@ -127,6 +128,7 @@ FontEditorWidget::FontEditorWidget(const String& path, RefPtr<Gfx::Font>&& edite
 
     m_ui->width_spinbox->on_change = [this, update_demo](int value) {
         m_edited_font->set_glyph_width(m_glyph_map_widget->selected_glyph(), value);
+        Gfx::Painter::invalidate_glyph_run_cache(*m_edited_font);
         m_glyph_editor_widget->update();
         m_glyph_map_widget->update_glyph(m_glyph_map_widget->selected_glyph());
         update_demo();
@@ -134,6 +136,7 @@ FontEditorWidget::FontEditorWidget(const String& path, RefPtr<Gfx::Font>&& edite
 
     m_ui->spacing_spinbox->on_change = [this, update_demo](int value) {
         m_edited_font->set_glyph_spacing(value);
+        Gfx::Painter::invalidate_glyph_run_cache(*m_edited_font);
         update_demo();
     };
 
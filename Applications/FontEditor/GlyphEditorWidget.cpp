@@ -106,6 +106,7 @@ void GlyphEditorWidget::draw_at_mouse(const GUI::MouseEvent& event)
     if (bitmap.bit_at(x, y) == set)
         return;
     bitmap.set_bit_at(x, y, set);
+    Gfx::Painter::invalidate_glyph_run_cache(font());
     if (on_glyph_altered)
         on_glyph_altered(m_glyph);
     update();
@@ -170,8 +170,12 @@ void QSWidget::paint_event(GUI::PaintEvent& event)
 
     painter.fill_rect_with_checkerboard(frame_inner_rect(), { 8, 8 }, palette().base().darkened(0.9), palette().base());
 
-    if (!m_bitmap.is_null())
-        painter.draw_scaled_bitmap(m_bitmap_rect, *m_bitmap, m_bitmap->rect());
+    if (!m_bitmap.is_null()) {
+        auto scaling_mode = (m_bitmap_rect.width() < m_bitmap->width() && m_bitmap_rect.height() < m_bitmap->height())
+            ? Gfx::Painter::ScalingMode::BoxSampling
+            : Gfx::Painter::ScalingMode::Bilinear;
+        painter.draw_scaled_bitmap(m_bitmap_rect, *m_bitmap, m_bitmap->rect(), scaling_mode);
+    }
 }
 
 void QSWidget::mousedown_event(GUI::MouseEvent& event)
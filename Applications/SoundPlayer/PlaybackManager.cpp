@@ -120,12 +120,13 @@ void PlaybackManager::remove_dead_buffers()
 
 void PlaybackManager::load_next_buffer()
 {
-    if (m_buffers.size() < 10) {
-        for (int i = 0; i < 20 && m_loader->loaded_samples() < m_loader->total_samples(); i++) {
-            auto buffer = m_loader->get_more_samples(PLAYBACK_MANAGER_BUFFER_SIZE);
-            if (buffer)
-                m_buffers.append(buffer);
-        }
+    // Stay a few buffers ahead of the device, but only decode a couple per
+    // call; decoding a deep backlog in one go stalls the UI thread long
+    // enough to glitch playback.
+    for (int i = 0; i < 2 && m_buffers.size() - m_next_ptr < PLAYBACK_MANAGER_PREBUFFER_COUNT && m_loader->loaded_samples() < m_loader->total_samples(); i++) {
+        auto buffer = m_loader->get_more_samples(PLAYBACK_MANAGER_BUFFER_SIZE);
+        if (buffer)
+            m_buffers.append(buffer);
     }
 
     if (m_next_ptr < m_buffers.size()) {
@@ -163,6 +164,8 @@ void PlaybackManager::next_buffer()
         return;
 
     remove_dead_buffers();
+    if (!m_next_buffer)
+        load_next_buffer();
     if (!m_next_buffer) {
         if (!m_connection->get_remaining_samples() && !m_paused) {
             dbg() << "Exhausted samples :^)";
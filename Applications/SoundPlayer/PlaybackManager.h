@@ -32,6 +32,7 @@
 #include <LibCore/Timer.h>
 
 #define PLAYBACK_MANAGER_BUFFER_SIZE 64 * KB
+#define PLAYBACK_MANAGER_PREBUFFER_COUNT 5
 #define PLAYBACK_MANAGER_RATE 44100
 
 class PlaybackManager final {
@@ -30,6 +30,9 @@
 
 GraphWidget::GraphWidget()
 {
+    // Re-rendering the graph just because something was dragged across it is
+    // wasteful; keep it in a backing layer so those repaints are blits.
+    set_backing_layer_enabled(true);
 }
 
 GraphWidget::~GraphWidget()
@@ -31,6 +31,9 @@
 
 ProcessTableView::ProcessTableView()
 {
+    // The process table is expensive to render; let uncover repaints blit
+    // from a backing layer instead of re-running the whole row painter.
+    set_backing_layer_enabled(true);
     set_size_columns_to_fit_content(true);
     set_model(GUI::SortingProxyModel::create(ProcessModel::create()));
     model()->set_key_column_and_sort_order(ProcessModel::Column::CPU, GUI::SortOrder::Descending);
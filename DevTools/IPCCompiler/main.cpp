@@ -229,6 +229,9 @@ int main(int argc, char** argv)
     out() << "#include <LibGfx/Color.h>";
     out() << "#include <LibGfx/Rect.h>";
     out() << "#include <LibGfx/ShareableBitmap.h>";
+    // NOTE: SharedByteBuffer.h has to come before Decoder.h so that its
+    //       decode() overload is visible to Decoder's dispatch template.
+    out() << "#include <LibIPC/SharedByteBuffer.h>";
     out() << "#include <LibIPC/Decoder.h>";
     out() << "#include <LibIPC/Encoder.h>";
     out() << "#include <LibIPC/Endpoint.h>";
@@ -348,6 +351,51 @@ int main(int argc, char** argv)
             out() << "    virtual IPC::MessageBuffer encode() const override";
             out() << "    {";
             out() << "        IPC::MessageBuffer buffer;";
+
+            // We know the wire size of every field type, so emit a capacity
+            // precomputation and the buffer never has to grow mid-encode.
+            // Unknown types simply don't contribute; the buffer can still
+            // grow for them.
+            {
+                size_t static_size = 8; // endpoint magic + message ID
+                Vector<String> dynamic_terms;
+                for (auto& parameter : parameters) {
+                    if (parameter.type == "bool" || parameter.type == "u8" || parameter.type == "i8") {
+                        static_size += 1;
+                    } else if (parameter.type == "u16" || parameter.type == "i16") {
+                        static_size += 2;
+                    } else if (parameter.type == "int" || parameter.type == "i32" || parameter.type == "u32" || parameter.type == "float" || parameter.type == "Gfx::Color") {
+                        static_size += 4;
+                    } else if (parameter.type == "i64" || parameter.type == "u64") {
+                        static_size += 8;
+                    } else if (parameter.type == "Gfx::Point" || parameter.type == "Gfx::Size") {
+                        static_size += 8;
+                    } else if (parameter.type == "Gfx::Rect") {
+                        static_size += 16;
+                    } else if (parameter.type == "Gfx::ShareableBitmap") {
+                        static_size += 16;
+                    } else if (parameter.type == "IPC::SharedByteBuffer") {
+                        static_size += 8;
+                    } else if (parameter.type == "Vector<Gfx::Rect>") {
+                        static_size += 8;
+                        dynamic_terms.append(String::format("m_%s.size() * 16", parameter.name.characters()));
+                    } else if (parameter.type == "Vector<i32>") {
+                        static_size += 8;
+                        dynamic_terms.append(String::format("m_%s.size() * 4", parameter.name.characters()));
+                    } else if (parameter.type == "String") {
+                        static_size += 4;
+                        dynamic_terms.append(String::format("m_%s.length()", parameter.name.characters()));
+                    }
+                }
+                StringBuilder capacity_builder;
+                capacity_builder.appendf("%zu", static_size);
+                for (auto& term : dynamic_terms) {
+                    capacity_builder.append(" + ");
+                    capacity_builder.append(term);
+                }
+                out() << "        buffer.ensure_capacity(" << capacity_builder.to_string() << ");";
+            }
+
             out() << "        IPC::Encoder stream(buffer);";
             out() << "        stream << endpoint_magic();";
             out() << "        stream << (int)MessageID::" << name << ";";
@@ -382,6 +430,10 @@ int main(int argc, char** argv)
                     out() << "        stream << m_" << parameter.name << ".shbuf_id();";
                     out() << "        stream << m_" << parameter.name << ".width();";
                     out() << "        stream << m_" << parameter.name << ".height();";
+                    out() << "        stream << (i32)(m_" << parameter.name << ".bitmap() ? m_" << parameter.name << ".bitmap()->format() : Gfx::BitmapFormat::Invalid);";
+                } else if (parameter.type == "IPC::SharedByteBuffer") {
+                    out() << "        stream << m_" << parameter.name << ".shbuf_id();";
+                    out() << "        stream << (u32)m_" << parameter.name << ".size();";
                 } else {
                     out() << "        stream << m_" << parameter.name << ";";
                 }
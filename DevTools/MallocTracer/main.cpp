@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Attaches to the sampling allocation tracer in LibC malloc (enabled by
+// running the target with LIBC_TRACE_MALLOC set), aggregates samples per
+// call site and symbolizes them against the target's executable.
+
+#include <AK/HashMap.h>
+#include <AK/MappedFile.h>
+#include <AK/QuickSort.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibELF/Loader.h>
+#include <mallocdefs.h>
+#include <serenity.h>
+#include <stdio.h>
+#include <unistd.h>
+
+struct CallSite {
+    u32 address { 0 };
+    u32 sample_count { 0 };
+    u64 sampled_bytes { 0 };
+};
+
+int main(int argc, char** argv)
+{
+    int pid = 0;
+    int duration = 5;
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(duration, "Sampling duration in seconds (default 5)", "duration", 'd', "seconds");
+    args_parser.add_positional_argument(pid, "Target PID", "pid");
+    args_parser.parse(argc, argv);
+
+    auto id_path = String::format("/tmp/malloc-trace.%d", pid);
+    FILE* id_file = fopen(id_path.characters(), "r");
+    if (!id_file) {
+        fprintf(stderr, "Unable to open %s -- is the target running with LIBC_TRACE_MALLOC set?\n", id_path.characters());
+        return 1;
+    }
+    int shbuf_id = -1;
+    if (fscanf(id_file, "%d", &shbuf_id) != 1 || shbuf_id < 0) {
+        fprintf(stderr, "Malformed %s\n", id_path.characters());
+        fclose(id_file);
+        return 1;
+    }
+    fclose(id_file);
+
+    size_t size = 0;
+    auto* ring = (volatile malloc_trace_ring*)shbuf_get(shbuf_id, &size);
+    if (!ring || size < sizeof(malloc_trace_ring)) {
+        perror("shbuf_get");
+        return 1;
+    }
+    if (ring->magic != MALLOC_TRACE_MAGIC) {
+        fprintf(stderr, "Shared buffer %d doesn't look like a malloc trace ring\n", shbuf_id);
+        return 1;
+    }
+
+    char executable_path[256] = {};
+    auto exe_link = String::format("/proc/%d/exe", pid);
+    readlink(exe_link.characters(), executable_path, sizeof(executable_path) - 1);
+
+    RefPtr<ELF::Loader> elf_loader;
+    MappedFile elf_file(executable_path);
+    if (elf_file.is_valid())
+        elf_loader = ELF::Loader::create(static_cast<const u8*>(elf_file.data()), elf_file.size());
+    else
+        fprintf(stderr, "Unable to map '%s'; call sites will not be symbolized.\n", executable_path);
+
+    printf("Tracing pid %d for %d second(s), sampling every %u allocations...\n", pid, duration, ring->sample_interval);
+
+    HashMap<u32, CallSite> call_sites;
+    unsigned tail = ring->head;
+    u64 total_samples = 0;
+    for (int elapsed_ms = 0; elapsed_ms < duration * 1000; elapsed_ms += 100) {
+        usleep(100 * 1000);
+        unsigned head = ring->head;
+        if (head - tail >= ring->capacity) {
+            fprintf(stderr, "Warning: tracer fell behind; %u samples lost\n", (head - tail) - ring->capacity);
+            tail = head - ring->capacity;
+        }
+        for (; tail != head; ++tail) {
+            auto& entry = const_cast<malloc_trace_ring&>(*ring).entries[tail % ring->capacity];
+            u32 address = (u32)(FlatPtr)entry.return_address;
+            auto& site = call_sites.ensure(address);
+            site.address = address;
+            ++site.sample_count;
+            site.sampled_bytes += entry.size;
+            ++total_samples;
+        }
+    }
+
+    Vector<CallSite> sorted_sites;
+    for (auto& it : call_sites)
+        sorted_sites.append(it.value);
+    quick_sort(sorted_sites.begin(), sorted_sites.end(), [](auto& a, auto& b) {
+        return a.sampled_bytes > b.sampled_bytes;
+    });
+
+    printf("%llu samples at %zu call sites (sampled bytes x%u approximates real volume)\n",
+        total_samples, sorted_sites.size(), ring->sample_interval);
+    printf("%16s %8s  %s\n", "SAMPLED BYTES", "SAMPLES", "CALL SITE");
+    for (auto& site : sorted_sites) {
+        String symbol = "??";
+        u32 offset = 0;
+        if (elf_loader)
+            symbol = elf_loader->symbolicate(site.address, &offset);
+        printf("%16llu %8u  %08x  %s +0x%x\n", site.sampled_bytes, site.sample_count, site.address, symbol.characters(), offset);
+    }
+    return 0;
+}
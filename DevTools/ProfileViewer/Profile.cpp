@@ -180,13 +180,14 @@ OwnPtr<Profile> Profile::load_from_perfcore_file(const StringView& path)
     auto& object = json.as_object();
     auto executable_path = object.get("executable").to_string();
 
+    // Whole-system profiles have no single executable; in that case we can
+    // still symbolicate the kernel frames below.
+    RefPtr<ELF::Loader> elf_loader;
     MappedFile elf_file(executable_path);
-    if (!elf_file.is_valid()) {
+    if (elf_file.is_valid())
+        elf_loader = ELF::Loader::create(static_cast<const u8*>(elf_file.data()), elf_file.size());
+    else if (!executable_path.is_empty())
         fprintf(stderr, "Unable to open executable '%s' for symbolication.\n", executable_path.characters());
-        return nullptr;
-    }
-
-    auto elf_loader = ELF::Loader::create(static_cast<const u8*>(elf_file.data()), elf_file.size());
 
     MappedFile kernel_elf_file("/boot/kernel");
     RefPtr<ELF::Loader> kernel_elf_loader;
@@ -232,7 +233,10 @@ OwnPtr<Profile> Profile::load_from_perfcore_file(const StringView& path)
                     symbol = "??";
                 }
             } else {
-                symbol = elf_loader->symbolicate(ptr, &offset);
+                if (elf_loader)
+                    symbol = elf_loader->symbolicate(ptr, &offset);
+                else
+                    symbol = "??";
             }
 
             event.frames.append({ symbol, ptr, offset });
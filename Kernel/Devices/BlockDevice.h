@@ -45,6 +45,10 @@ public:
     virtual bool read_blocks(unsigned index, u16 count, u8*) = 0;
     virtual bool write_blocks(unsigned index, u16 count, const u8*) = 0;
 
+    // Write barrier: force anything the device has accepted but still holds
+    // in a volatile write cache out to the medium. No-op by default.
+    virtual void flush_write_cache() { }
+
 protected:
     BlockDevice(unsigned major, unsigned minor, size_t block_size = PAGE_SIZE)
         : Device(major, minor)
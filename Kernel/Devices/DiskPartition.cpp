@@ -110,6 +110,11 @@ bool DiskPartition::write_blocks(unsigned index, u16 count, const u8* data)
     return m_device->write_blocks(m_block_offset + index, count, data);
 }
 
+void DiskPartition::flush_write_cache()
+{
+    m_device->flush_write_cache();
+}
+
 const char* DiskPartition::class_name() const
 {
     return "DiskPartition";
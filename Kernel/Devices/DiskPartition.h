@@ -38,6 +38,7 @@ public:
 
     virtual bool read_blocks(unsigned index, u16 count, u8*) override;
     virtual bool write_blocks(unsigned index, u16 count, const u8*) override;
+    virtual void flush_write_cache() override;
 
     // ^BlockDevice
     virtual ssize_t read(FileDescription&, size_t, u8*, ssize_t) override;
@@ -165,11 +165,51 @@ void PATAChannel::initialize(bool force_pio)
     // Let's try to set up DMA transfers.
     PCI::enable_bus_mastering(pci_address());
     m_prdt_page = MM.allocate_supervisor_physical_page();
-    prdt().end_of_table = 0x8000;
-    m_dma_buffer_page = MM.allocate_supervisor_physical_page();
+    for (size_t i = 0; i < dma_buffer_page_count; ++i)
+        m_dma_buffer_pages.append(MM.allocate_supervisor_physical_page());
     klog() << "PATAChannel: Bus master IDE: " << m_bus_master_base;
 }
 
+void PATAChannel::setup_prdt(u16 count)
+{
+    // Build one PRDT entry per DMA buffer page covered by the transfer.
+    // The buffer pages are not physically contiguous; the scatter list is
+    // what lets a single command span all of them.
+    size_t remaining = 512 * count;
+    ASSERT(remaining <= dma_buffer_page_count * PAGE_SIZE);
+    auto* entries = prdt_entries();
+    size_t entry_index = 0;
+    while (remaining > 0) {
+        size_t chunk = min(remaining, (size_t)PAGE_SIZE);
+        entries[entry_index].offset = m_dma_buffer_pages[entry_index]->paddr();
+        entries[entry_index].size = chunk;
+        entries[entry_index].end_of_table = 0;
+        remaining -= chunk;
+        ++entry_index;
+    }
+    entries[entry_index - 1].end_of_table = 0x8000;
+}
+
+void PATAChannel::copy_to_dma_buffer(const u8* data, size_t size)
+{
+    for (size_t i = 0; size > 0; ++i) {
+        size_t chunk = min(size, (size_t)PAGE_SIZE);
+        memcpy(m_dma_buffer_pages[i]->paddr().offset(0xc0000000).as_ptr(), data, chunk);
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+void PATAChannel::copy_from_dma_buffer(u8* data, size_t size)
+{
+    for (size_t i = 0; size > 0; ++i) {
+        size_t chunk = min(size, (size_t)PAGE_SIZE);
+        memcpy(data, m_dma_buffer_pages[i]->paddr().offset(0xc0000000).as_ptr(), chunk);
+        data += chunk;
+        size -= chunk;
+    }
+}
+
 static void print_ide_status(u8 status)
 {
     klog() << "PATAChannel: print_ide_status: DRQ=" << ((status & ATA_SR_DRQ) != 0) << " BSY=" << ((status & ATA_SR_BSY) != 0) << " DRDY=" << ((status & ATA_SR_DRDY) != 0) << " DSC=" << ((status & ATA_SR_DSC) != 0) << " DF=" << ((status & ATA_SR_DF) != 0) << " CORR=" << ((status & ATA_SR_CORR) != 0) << " IDX=" << ((status & ATA_SR_IDX) != 0) << " ERR=" << ((status & ATA_SR_ERR) != 0);
@@ -271,10 +311,8 @@ bool PATAChannel::ata_read_sectors_with_dma(u32 lba, u16 count, u8* outbuf, bool
     dbg() << "PATAChannel::ata_read_sectors_with_dma (" << lba << " x" << count << ") -> " << outbuf;
 #endif
 
-    prdt().offset = m_dma_buffer_page->paddr();
-    prdt().size = 512 * count;
-
-    ASSERT(prdt().size <= PAGE_SIZE);
+    ASSERT(count <= max_dma_sectors);
+    setup_prdt(count);
 
     // Stop bus master
     m_bus_master_base.out<u8>(0);
@@ -329,7 +367,7 @@ bool PATAChannel::ata_read_sectors_with_dma(u32 lba, u16 count, u8* outbuf, bool
     if (m_device_error)
         return false;
 
-    memcpy(outbuf, m_dma_buffer_page->paddr().offset(0xc0000000).as_ptr(), 512 * count);
+    copy_from_dma_buffer(outbuf, 512 * count);
 
     // I read somewhere that this may trigger a cache flush so let's do it.
     m_bus_master_base.offset(2).out<u8>(m_bus_master_base.offset(2).in<u8>() | 0x6);
@@ -343,12 +381,9 @@ bool PATAChannel::ata_write_sectors_with_dma(u32 lba, u16 count, const u8* inbuf
     dbg() << "PATAChannel::ata_write_sectors_with_dma (" << lba << " x" << count << ") <- " << inbuf;
 #endif
 
-    prdt().offset = m_dma_buffer_page->paddr();
-    prdt().size = 512 * count;
-
-    memcpy(m_dma_buffer_page->paddr().offset(0xc0000000).as_ptr(), inbuf, 512 * count);
-
-    ASSERT(prdt().size <= PAGE_SIZE);
+    ASSERT(count <= max_dma_sectors);
+    setup_prdt(count);
+    copy_to_dma_buffer(inbuf, 512 * count);
 
     // Stop bus master
     m_bus_master_base.out<u8>(0);
@@ -533,4 +568,31 @@ bool PATAChannel::ata_write_sectors(u32 start_sector, u16 count, const u8* inbuf
     return !m_device_error;
 }
 
+bool PATAChannel::ata_flush_cache(bool slave_request)
+{
+    LOCKER(s_lock());
+#ifdef PATA_DEBUG
+    klog() << "PATAChannel::ata_flush_cache request";
+#endif
+
+    while (m_io_base.offset(ATA_REG_STATUS).in<u8>() & ATA_SR_BSY)
+        ;
+
+    u8 devsel = 0xe0;
+    if (slave_request)
+        devsel |= 0x10;
+    m_io_base.offset(ATA_REG_HDDEVSEL).out<u8>(devsel);
+
+    while (!(m_io_base.offset(ATA_REG_STATUS).in<u8>() & ATA_SR_DRDY))
+        ;
+
+    prepare_for_irq();
+    m_io_base.offset(ATA_REG_COMMAND).out<u8>(ATA_CMD_CACHE_FLUSH);
+    wait_for_irq();
+    u8 status = m_io_base.offset(ATA_REG_STATUS).in<u8>();
+    ASSERT(!(status & ATA_SR_BSY));
+
+    return !m_device_error;
+}
+
 }
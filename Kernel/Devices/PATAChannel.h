@@ -38,6 +38,7 @@
 
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Vector.h>
 #include <Kernel/Lock.h>
 #include <Kernel/PCI/Access.h>
 #include <Kernel/PCI/Device.h>
@@ -69,6 +70,12 @@ public:
     PATAChannel(PCI::Address address, ChannelType type, bool force_pio);
     virtual ~PATAChannel() override;
 
+    // The DMA scatter list covers this many pages (8 sectors each), so one
+    // command can move this many sectors. Larger transfers are split up by
+    // PATADiskDevice.
+    static const size_t dma_buffer_page_count = 16;
+    static const u16 max_dma_sectors = dma_buffer_page_count * 8;
+
     RefPtr<PATADiskDevice> master_device() { return m_master; };
     RefPtr<PATADiskDevice> slave_device() { return m_slave; };
 
@@ -86,9 +93,14 @@ private:
     bool ata_write_sectors_with_dma(u32, u16, const u8*, bool);
     bool ata_read_sectors(u32, u16, u8*, bool);
     bool ata_write_sectors(u32, u16, const u8*, bool);
+    bool ata_flush_cache(bool slave_request);
 
     inline void prepare_for_irq();
 
+    void setup_prdt(u16 count);
+    void copy_to_dma_buffer(const u8* data, size_t size);
+    void copy_from_dma_buffer(u8* data, size_t size);
+
     // Data members
     u8 m_channel_number { 0 }; // Channel number. 0 = master, 1 = slave
     IOAddress m_io_base;
@@ -97,9 +109,9 @@ private:
 
     WaitQueue m_irq_queue;
 
-    PhysicalRegionDescriptor& prdt() { return *reinterpret_cast<PhysicalRegionDescriptor*>(m_prdt_page->paddr().offset(0xc0000000).as_ptr()); }
+    PhysicalRegionDescriptor* prdt_entries() { return reinterpret_cast<PhysicalRegionDescriptor*>(m_prdt_page->paddr().offset(0xc0000000).as_ptr()); }
     RefPtr<PhysicalPage> m_prdt_page;
-    RefPtr<PhysicalPage> m_dma_buffer_page;
+    Vector<RefPtr<PhysicalPage>> m_dma_buffer_pages;
     IOAddress m_bus_master_base;
     Lockable<bool> m_dma_enabled;
 
@@ -57,15 +57,43 @@ const char* PATADiskDevice::class_name() const
 
 bool PATADiskDevice::read_blocks(unsigned index, u16 count, u8* out)
 {
-    if (!m_channel.m_bus_master_base.is_null() && m_channel.m_dma_enabled.resource())
-        return read_sectors_with_dma(index, count, out);
-    return read_sectors(index, count, out);
+    if (!m_channel.m_bus_master_base.is_null() && m_channel.m_dma_enabled.resource()) {
+        // Split the transfer along the channel's DMA scatter list capacity,
+        // so any contiguous run of blocks costs as few commands as possible.
+        while (count > 0) {
+            u16 chunk = min(count, PATAChannel::max_dma_sectors);
+            if (!read_sectors_with_dma(index, chunk, out))
+                return false;
+            index += chunk;
+            out += chunk * 512;
+            count -= chunk;
+        }
+        return true;
+    }
+    while (count > 0) {
+        u16 chunk = min(count, (u16)256);
+        if (!read_sectors(index, chunk, out))
+            return false;
+        index += chunk;
+        out += chunk * 512;
+        count -= chunk;
+    }
+    return true;
 }
 
 bool PATADiskDevice::write_blocks(unsigned index, u16 count, const u8* data)
 {
-    if (!m_channel.m_bus_master_base.is_null() && m_channel.m_dma_enabled.resource())
-        return write_sectors_with_dma(index, count, data);
+    if (!m_channel.m_bus_master_base.is_null() && m_channel.m_dma_enabled.resource()) {
+        while (count > 0) {
+            u16 chunk = min(count, PATAChannel::max_dma_sectors);
+            if (!write_sectors_with_dma(index, chunk, data))
+                return false;
+            index += chunk;
+            data += chunk * 512;
+            count -= chunk;
+        }
+        return true;
+    }
     for (unsigned i = 0; i < count; ++i) {
         if (!write_sectors(index + i, 1, data + i * 512))
             return false;
@@ -73,6 +101,11 @@ bool PATADiskDevice::write_blocks(unsigned index, u16 count, const u8* data)
     return true;
 }
 
+void PATADiskDevice::flush_write_cache()
+{
+    m_channel.ata_flush_cache(is_slave());
+}
+
 void PATADiskDevice::set_drive_geometry(u16 cyls, u16 heads, u16 spt)
 {
     m_cylinders = cyls;
@@ -86,15 +119,6 @@ ssize_t PATADiskDevice::read(FileDescription&, size_t offset, u8* outbuf, ssize_
     u16 whole_blocks = len / block_size();
     ssize_t remaining = len % block_size();
 
-    unsigned blocks_per_page = PAGE_SIZE / block_size();
-
-    // PATAChannel will chuck a wobbly if we try to read more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= blocks_per_page) {
-        whole_blocks = blocks_per_page;
-        remaining = 0;
-    }
-
 #ifdef PATA_DEVICE_DEBUG
     klog() << "PATADiskDevice::read() index=" << index << " whole_blocks=" << whole_blocks << " remaining=" << remaining;
 #endif
@@ -127,15 +151,6 @@ ssize_t PATADiskDevice::write(FileDescription&, size_t offset, const u8* inbuf,
     u16 whole_blocks = len / block_size();
     ssize_t remaining = len % block_size();
 
-    unsigned blocks_per_page = PAGE_SIZE / block_size();
-
-    // PATAChannel will chuck a wobbly if we try to write more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= blocks_per_page) {
-        whole_blocks = blocks_per_page;
-        remaining = 0;
-    }
-
 #ifdef PATA_DEVICE_DEBUG
     klog() << "PATADiskDevice::write() index=" << index << " whole_blocks=" << whole_blocks << " remaining=" << remaining;
 #endif
@@ -27,6 +27,7 @@
 #include <AK/Memory.h>
 #include <AK/StringView.h>
 #include <Kernel/Devices/SB16.h>
+#include <Kernel/FileSystem/FileDescription.h>
 #include <Kernel/Thread.h>
 #include <Kernel/VM/AnonymousVMObject.h>
 #include <Kernel/VM/MemoryManager.h>
@@ -83,7 +84,17 @@ SB16::SB16()
     , CharacterDevice(42, 42) // ### ?
 {
     s_the = this;
-    initialize();
+}
+
+KResultOr<NonnullRefPtr<FileDescription>> SB16::open(int options)
+{
+    // Probing and configuring the DSP is deferred until somebody actually
+    // opens the device, so it doesn't hold up the boot path.
+    if (!m_initialized) {
+        m_initialized = true;
+        initialize();
+    }
+    return CharacterDevice::open(options);
 }
 
 SB16::~SB16()
@@ -45,6 +45,7 @@ public:
     static SB16& the();
 
     // ^CharacterDevice
+    virtual KResultOr<NonnullRefPtr<FileDescription>> open(int options) override;
     virtual bool can_read(const FileDescription&, size_t) const override;
     virtual ssize_t read(FileDescription&, size_t, u8*, ssize_t) override;
     virtual ssize_t write(FileDescription&, size_t, const u8*, ssize_t) override;
@@ -71,6 +72,7 @@ private:
 
     OwnPtr<Region> m_dma_region;
     int m_major_version { 0 };
+    bool m_initialized { false };
 
     WaitQueue m_irq_queue;
 };
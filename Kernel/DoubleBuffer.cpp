@@ -49,6 +49,24 @@ DoubleBuffer::DoubleBuffer(size_t capacity)
     m_space_for_writing = capacity;
 }
 
+KResult DoubleBuffer::set_capacity(size_t capacity)
+{
+    LOCKER(m_lock);
+    if (!m_empty)
+        return KResult(-EBUSY);
+    m_storage = KBuffer::create_with_size(capacity * 2, Region::Access::Read | Region::Access::Write, "DoubleBuffer");
+    m_capacity = capacity;
+    m_buffer1.data = m_storage.data();
+    m_buffer1.size = 0;
+    m_buffer2.data = m_storage.data() + capacity;
+    m_buffer2.size = 0;
+    m_write_buffer = &m_buffer1;
+    m_read_buffer = &m_buffer2;
+    m_read_buffer_index = 0;
+    compute_lockfree_metadata();
+    return KSuccess;
+}
+
 void DoubleBuffer::flip()
 {
     ASSERT(m_read_buffer_index == m_read_buffer->size);
@@ -78,15 +96,22 @@ ssize_t DoubleBuffer::read(u8* data, ssize_t size)
         return 0;
     ASSERT(size > 0);
     LOCKER(m_lock);
-    if (m_read_buffer_index >= m_read_buffer->size && m_write_buffer->size != 0)
-        flip();
-    if (m_read_buffer_index >= m_read_buffer->size)
-        return 0;
-    ssize_t nread = min((ssize_t)m_read_buffer->size - (ssize_t)m_read_buffer_index, size);
-    memcpy(data, m_read_buffer->data + m_read_buffer_index, nread);
-    m_read_buffer_index += nread;
+    ssize_t total_nread = 0;
+    // Drain as much as the caller asked for in one go, flipping to the write
+    // buffer when the read buffer runs dry, instead of making the caller come
+    // back with another syscall for the other half.
+    while (total_nread < size) {
+        if (m_read_buffer_index >= m_read_buffer->size && m_write_buffer->size != 0)
+            flip();
+        if (m_read_buffer_index >= m_read_buffer->size)
+            break;
+        ssize_t nread = min((ssize_t)m_read_buffer->size - (ssize_t)m_read_buffer_index, size - total_nread);
+        memcpy(data + total_nread, m_read_buffer->data + m_read_buffer_index, nread);
+        m_read_buffer_index += nread;
+        total_nread += nread;
+    }
     compute_lockfree_metadata();
-    return nread;
+    return total_nread;
 }
 
 }
@@ -28,6 +28,7 @@
 
 #include <AK/Types.h>
 #include <Kernel/KBuffer.h>
+#include <Kernel/KResult.h>
 #include <Kernel/Lock.h>
 
 namespace Kernel {
@@ -41,6 +42,13 @@ public:
 
     bool is_empty() const { return m_empty; }
 
+    // How many bytes a read() could return right now: what's left of the
+    // read side plus everything queued on the write side.
+    size_t immediately_readable() const { return (m_read_buffer->size - m_read_buffer_index) + m_write_buffer->size; }
+
+    size_t capacity() const { return m_capacity; }
+    KResult set_capacity(size_t);
+
     size_t space_for_writing() const { return m_space_for_writing; }
 
 private:
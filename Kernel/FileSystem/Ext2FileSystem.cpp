@@ -285,7 +285,7 @@ bool Ext2FS::write_block_list_for_inode(InodeIndex inode_index, ext2_inode& e2in
             --remaining_blocks;
         }
         stream.fill_to_end(0);
-        bool success = write_block(e2inode.i_block[EXT2_IND_BLOCK], block_contents.data());
+        bool success = write_block(e2inode.i_block[EXT2_IND_BLOCK], block_contents.data(), nullptr, true);
         ASSERT(success);
     }
 
@@ -368,7 +368,7 @@ bool Ext2FS::write_block_list_for_inode(InodeIndex inode_index, ext2_inode& e2in
             }
 
             if (ind_block_dirty) {
-                bool success = write_block(indirect_block_index, ind_block_contents.data());
+                bool success = write_block(indirect_block_index, ind_block_contents.data(), nullptr, true);
                 ASSERT(success);
             }
         }
@@ -380,7 +380,7 @@ bool Ext2FS::write_block_list_for_inode(InodeIndex inode_index, ext2_inode& e2in
         }
 
         if (dind_block_dirty) {
-            bool success = write_block(e2inode.i_block[EXT2_DIND_BLOCK], dind_block_contents.data());
+            bool success = write_block(e2inode.i_block[EXT2_DIND_BLOCK], dind_block_contents.data(), nullptr, true);
             ASSERT(success);
         }
     }
@@ -496,6 +496,7 @@ void Ext2FS::free_inode(Ext2FSInode& inode)
     struct timeval now;
     kgettimeofday(now);
     inode.m_raw_inode.i_dtime = now.tv_sec;
+    inode.m_cached_metadata.clear();
     write_ext2_inode(inode.index(), inode.m_raw_inode);
 
     auto block_list = block_list_for_inode(inode.m_raw_inode, true);
@@ -521,23 +522,19 @@ void Ext2FS::flush_block_group_descriptor_table()
     LOCKER(m_lock);
     unsigned blocks_to_write = ceil_div(m_block_group_count * (unsigned)sizeof(ext2_group_desc), block_size());
     unsigned first_block_of_bgdt = block_size() == 1024 ? 2 : 1;
-    write_blocks(first_block_of_bgdt, blocks_to_write, (const u8*)block_group_descriptors());
+    write_blocks(first_block_of_bgdt, blocks_to_write, (const u8*)block_group_descriptors(), nullptr, true);
 }
 
 void Ext2FS::flush_writes()
 {
     LOCKER(m_lock);
-    if (m_super_block_dirty) {
-        flush_super_block();
-        m_super_block_dirty = false;
-    }
     if (m_block_group_descriptors_dirty) {
         flush_block_group_descriptor_table();
         m_block_group_descriptors_dirty = false;
     }
     for (auto& cached_bitmap : m_cached_bitmaps) {
         if (cached_bitmap->dirty) {
-            write_block(cached_bitmap->bitmap_block_index, cached_bitmap->buffer.data());
+            write_block(cached_bitmap->bitmap_block_index, cached_bitmap->buffer.data(), nullptr, true);
             cached_bitmap->dirty = false;
 #ifdef EXT2_DEBUG
             dbg() << "Flushed bitmap block " << cached_bitmap->bitmap_block_index;
@@ -547,6 +544,15 @@ void Ext2FS::flush_writes()
 
     FileBackedFS::flush_writes();
 
+    // The super block goes out last, after everything it summarizes is
+    // already stable on disk, and gets its own barrier since it bypasses
+    // the block cache.
+    if (m_super_block_dirty) {
+        flush_super_block();
+        m_super_block_dirty = false;
+        flush_device_write_cache();
+    }
+
     // Uncache Inodes that are only kept alive by the index-to-inode lookup cache.
     // We don't uncache Inodes that are being watched by at least one InodeWatcher.
 
@@ -579,6 +585,8 @@ Ext2FSInode::~Ext2FSInode()
 InodeMetadata Ext2FSInode::metadata() const
 {
     LOCKER(m_lock);
+    if (m_cached_metadata.has_value())
+        return m_cached_metadata.value();
     InodeMetadata metadata;
     metadata.inode = identifier();
     metadata.size = m_raw_inode.i_size;
@@ -600,6 +608,7 @@ InodeMetadata Ext2FSInode::metadata() const
         metadata.major_device = (dev & 0xfff00) >> 8;
         metadata.minor_device = (dev & 0xff) | ((dev >> 12) & 0xfff00);
     }
+    m_cached_metadata = metadata;
     return metadata;
 }
 
@@ -696,13 +705,35 @@ ssize_t Ext2FSInode::read_bytes(off_t offset, ssize_t count, u8* buffer, FileDes
     for (size_t bi = first_block_logical_index; remaining_count && bi <= last_block_logical_index; ++bi) {
         auto block_index = m_block_list[bi];
         ASSERT(block_index);
+        size_t offset_into_block = (bi == first_block_logical_index) ? offset_into_first_block : 0;
+
+        // Coalesce physically consecutive whole-block reads into a single
+        // multi-block request, straight into the caller's buffer.
+        if (offset_into_block == 0 && remaining_count >= (size_t)block_size) {
+            size_t run_length = 1;
+            while (bi + run_length <= last_block_logical_index
+                && remaining_count >= (run_length + 1) * block_size
+                && m_block_list[bi + run_length] == block_index + run_length)
+                ++run_length;
+            bool success = fs().read_blocks(block_index, run_length, out, description);
+            if (!success) {
+                klog() << "ext2fs: read_bytes: read_blocks(" << block_index << " x" << run_length << ") failed (lbi: " << bi << ")";
+                return -EIO;
+            }
+            size_t nbytes = run_length * block_size;
+            remaining_count -= nbytes;
+            nread += nbytes;
+            out += nbytes;
+            bi += run_length - 1;
+            continue;
+        }
+
         bool success = fs().read_block(block_index, block, description);
         if (!success) {
             klog() << "ext2fs: read_bytes: read_block(" << block_index << ") failed (lbi: " << bi << ")";
             return -EIO;
         }
 
-        size_t offset_into_block = (bi == first_block_logical_index) ? offset_into_first_block : 0;
         size_t num_bytes_to_copy = min(block_size - offset_into_block, remaining_count);
         memcpy(out, block + offset_into_block, num_bytes_to_copy);
         remaining_count -= num_bytes_to_copy;
@@ -757,6 +788,7 @@ KResult Ext2FSInode::resize(u64 new_size)
         return KResult(-EIO);
 
     m_raw_inode.i_size = new_size;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
 
     m_block_list = move(block_list);
@@ -784,6 +816,7 @@ ssize_t Ext2FSInode::write_bytes(off_t offset, ssize_t count, const u8* data, Fi
             memcpy(((u8*)m_raw_inode.i_block) + offset, data, (size_t)count);
             if ((size_t)(offset + count) > (size_t)m_raw_inode.i_size)
                 m_raw_inode.i_size = offset + count;
+            m_cached_metadata.clear();
             set_metadata_dirty(true);
             return count;
         }
@@ -827,6 +860,29 @@ ssize_t Ext2FSInode::write_bytes(off_t offset, ssize_t count, const u8* data, Fi
         size_t offset_into_block = (bi == first_block_logical_index) ? offset_into_first_block : 0;
         size_t num_bytes_to_copy = min(block_size - offset_into_block, remaining_count);
 
+        // Coalesce physically consecutive whole-block writes into a single
+        // multi-block request, straight from the caller's buffer. Whole
+        // blocks never need the read-modify-write or zero-padding below.
+        if (offset_into_block == 0 && num_bytes_to_copy == block_size) {
+            size_t run_length = 1;
+            while (bi + run_length <= last_block_logical_index
+                && remaining_count >= (run_length + 1) * block_size
+                && m_block_list[bi + run_length] == m_block_list[bi] + run_length)
+                ++run_length;
+            bool success = fs().write_blocks(m_block_list[bi], run_length, in, description);
+            if (!success) {
+                dbg() << "Ext2FS: write_blocks(" << m_block_list[bi] << " x" << run_length << ") failed (bi: " << bi << ")";
+                ASSERT_NOT_REACHED();
+                return -EIO;
+            }
+            size_t nbytes = run_length * block_size;
+            remaining_count -= nbytes;
+            nwritten += nbytes;
+            in += nbytes;
+            bi += run_length - 1;
+            continue;
+        }
+
         ByteBuffer block;
         if (offset_into_block != 0 || num_bytes_to_copy != block_size) {
             block = ByteBuffer::create_uninitialized(block_size);
@@ -948,6 +1004,7 @@ bool Ext2FSInode::write_directory(const Vector<FS::DirectoryEntry>& entries)
     ssize_t nwritten = write_bytes(0, directory_data.size(), directory_data.data(), nullptr);
     if (nwritten < 0)
         return false;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return static_cast<size_t>(nwritten) == directory_data.size();
 }
@@ -988,8 +1045,10 @@ KResult Ext2FSInode::add_child(InodeIdentifier child_id, const StringView& name,
 
     entries.empend(name.characters_without_null_termination(), name.length(), child_id, to_ext2_file_type(mode));
     bool success = write_directory(entries);
-    if (success)
+    if (success) {
         m_lookup_cache.set(name, child_id.index());
+        did_add_child(child_id, name);
+    }
     return KSuccess;
 }
 
@@ -1001,6 +1060,7 @@ KResult Ext2FSInode::remove_child(const StringView& name)
 #endif
     ASSERT(is_directory());
 
+    populate_lookup_cache();
     auto it = m_lookup_cache.find(name);
     if (it == m_lookup_cache.end())
         return KResult(-ENOENT);
@@ -1026,6 +1086,7 @@ KResult Ext2FSInode::remove_child(const StringView& name)
     }
 
     m_lookup_cache.remove(name);
+    did_remove_child(name);
 
     auto child_inode = fs().get_inode(child_id);
     child_inode->decrement_link_count();
@@ -1060,7 +1121,7 @@ bool Ext2FS::write_ext2_inode(unsigned inode, const ext2_inode& e2inode)
     if (!read_block_containing_inode(inode, block_index, offset, block))
         return false;
     memcpy(reinterpret_cast<ext2_inode*>(block + offset), &e2inode, inode_size());
-    bool success = write_block(block_index, block);
+    bool success = write_block(block_index, block, nullptr, true);
     ASSERT(success);
     return success;
 }
@@ -1110,20 +1171,28 @@ Vector<Ext2FS::BlockIndex> Ext2FS::allocate_blocks(GroupIndex preferred_group_in
         auto block_bitmap = Bitmap::wrap(cached_bitmap.buffer.data(), blocks_in_group);
 
         BlockIndex first_block_in_group = (group_index - 1) * blocks_per_group() + first_block_index();
-        size_t free_region_size = 0;
-        auto first_unset_bit_index = block_bitmap.find_longest_range_of_unset_bits(count - blocks.size(), free_region_size);
-        ASSERT(first_unset_bit_index.has_value());
-#ifdef EXT2_DEBUG
-        dbg() << "Ext2FS: allocating free region of size: " << free_region_size << "[" << group_index << "]";
-#endif
-        for (size_t i = 0; i < free_region_size; ++i) {
-            BlockIndex block_index = (first_unset_bit_index.value() + i) + first_block_in_group;
+
+        // Scan from the group's first-free hint rather than from bit 0, so
+        // streaming writes resume right where the previous allocation
+        // stopped instead of rescanning the whole bitmap every time.
+        size_t blocks_before = blocks.size();
+        for (size_t bit = cached_bitmap.first_free_hint; bit < (size_t)blocks_in_group && blocks.size() < count; ++bit) {
+            if (block_bitmap.get(bit))
+                continue;
+            BlockIndex block_index = bit + first_block_in_group;
             set_block_allocation_state(block_index, true);
             blocks.unchecked_append(block_index);
+            cached_bitmap.first_free_hint = bit + 1;
 #ifdef EXT2_DEBUG
             dbg() << "  allocated > " << block_index;
 #endif
         }
+        if (blocks.size() == blocks_before) {
+            // The hint was past the group's remaining free blocks; rescan
+            // this group once from the beginning.
+            ASSERT(cached_bitmap.first_free_hint != 0);
+            cached_bitmap.first_free_hint = 0;
+        }
     }
 
     ASSERT(blocks.size() == count);
@@ -1178,12 +1247,24 @@ unsigned Ext2FS::find_a_free_inode(GroupIndex preferred_group, off_t expected_si
 
     auto& cached_bitmap = get_bitmap_block(bgd.bg_inode_bitmap);
     auto inode_bitmap = Bitmap::wrap(cached_bitmap.buffer.data(), inodes_in_group);
-    for (size_t i = 0; i < inode_bitmap.size(); ++i) {
+    // Scan from the first-free hint; fall back to a full scan in case the
+    // hint had moved past inodes that were freed since.
+    for (size_t i = min(cached_bitmap.first_free_hint, (size_t)inode_bitmap.size()); i < inode_bitmap.size(); ++i) {
         if (inode_bitmap.get(i))
             continue;
         first_free_inode_in_group = first_inode_in_group + i;
+        cached_bitmap.first_free_hint = i;
         break;
     }
+    if (!first_free_inode_in_group) {
+        for (size_t i = 0; i < inode_bitmap.size(); ++i) {
+            if (inode_bitmap.get(i))
+                continue;
+            first_free_inode_in_group = first_inode_in_group + i;
+            cached_bitmap.first_free_hint = i;
+            break;
+        }
+    }
 
     if (!first_free_inode_in_group) {
         klog() << "Ext2FS: first_free_inode_in_group returned no inode, despite bgd claiming there are inodes :(";
@@ -1249,6 +1330,8 @@ bool Ext2FS::set_inode_allocation_state(InodeIndex inode_index, bool new_state)
 
     cached_bitmap.bitmap(inodes_per_group()).set(bit_index, new_state);
     cached_bitmap.dirty = true;
+    if (!new_state && bit_index < cached_bitmap.first_free_hint)
+        cached_bitmap.first_free_hint = bit_index;
 
     // Update superblock
 #ifdef EXT2_DEBUG
@@ -1320,6 +1403,8 @@ bool Ext2FS::set_block_allocation_state(BlockIndex block_index, bool new_state)
 
     cached_bitmap.bitmap(blocks_per_group()).set(bit_index, new_state);
     cached_bitmap.dirty = true;
+    if (!new_state && bit_index < cached_bitmap.first_free_hint)
+        cached_bitmap.first_free_hint = bit_index;
 
     // Update superblock
 #ifdef EXT2_DEBUG
@@ -1512,6 +1597,7 @@ int Ext2FSInode::set_atime(time_t t)
     if (fs().is_readonly())
         return -EROFS;
     m_raw_inode.i_atime = t;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return 0;
 }
@@ -1522,6 +1608,7 @@ int Ext2FSInode::set_ctime(time_t t)
     if (fs().is_readonly())
         return -EROFS;
     m_raw_inode.i_ctime = t;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return 0;
 }
@@ -1532,6 +1619,7 @@ int Ext2FSInode::set_mtime(time_t t)
     if (fs().is_readonly())
         return -EROFS;
     m_raw_inode.i_mtime = t;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return 0;
 }
@@ -1544,6 +1632,7 @@ KResult Ext2FSInode::increment_link_count()
     if (m_raw_inode.i_links_count == max_link_count)
         return KResult(-EMLINK);
     ++m_raw_inode.i_links_count;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return KSuccess;
 }
@@ -1557,6 +1646,7 @@ KResult Ext2FSInode::decrement_link_count()
     --m_raw_inode.i_links_count;
     if (ref_count() == 1 && m_raw_inode.i_links_count == 0)
         fs().uncache_inode(index());
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return KSuccess;
 }
@@ -1581,6 +1671,7 @@ KResult Ext2FSInode::chmod(mode_t mode)
     if (m_raw_inode.i_mode == mode)
         return KSuccess;
     m_raw_inode.i_mode = mode;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return KSuccess;
 }
@@ -1592,6 +1683,7 @@ KResult Ext2FSInode::chown(uid_t uid, gid_t gid)
         return KSuccess;
     m_raw_inode.i_uid = uid;
     m_raw_inode.i_gid = gid;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return KSuccess;
 }
@@ -1604,6 +1696,7 @@ KResult Ext2FSInode::truncate(u64 size)
     auto result = resize(size);
     if (result.is_error())
         return result;
+    m_cached_metadata.clear();
     set_metadata_dirty(true);
     return KSuccess;
 }
@@ -86,6 +86,9 @@ private:
     mutable Vector<unsigned> m_block_list;
     mutable HashMap<String, unsigned> m_lookup_cache;
     ext2_inode m_raw_inode;
+    // Rebuilding InodeMetadata from the raw inode on every metadata() call adds up
+    // when userspace stats whole directories, so we cache it until the raw inode changes.
+    mutable Optional<InodeMetadata> m_cached_metadata;
 };
 
 class Ext2FS final : public FileBackedFS {
@@ -179,6 +182,9 @@ private:
         }
         BlockIndex bitmap_block_index { 0 };
         bool dirty { false };
+        // Index below which every bit is known to be set. Allocation scans
+        // start here instead of at 0; freeing a bit lowers it again.
+        size_t first_free_hint { 0 };
         KBuffer buffer;
         Bitmap bitmap(u32 blocks_per_group) { return Bitmap::wrap(buffer.data(), blocks_per_group); }
     };
@@ -24,6 +24,9 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/HashMap.h>
+#include <AK/InlineLinkedList.h>
+#include <AK/QuickSort.h>
 #include <AK/StringView.h>
 #include <Kernel/Arch/i386/CPU.h>
 #include <Kernel/Devices/BlockDevice.h>
@@ -36,50 +39,52 @@
 
 namespace Kernel {
 
-struct CacheEntry {
-    time_t timestamp { 0 };
+struct CacheEntry : public InlineLinkedListNode<CacheEntry> {
     u32 block_index { 0 };
     u8* data { nullptr };
     bool has_data { false };
     bool is_dirty { false };
+    bool is_metadata { false };
+
+    // For InlineLinkedListNode
+    CacheEntry* m_next { nullptr };
+    CacheEntry* m_prev { nullptr };
 };
 
 class DiskCache {
 public:
-    explicit DiskCache(FileBackedFS& fs)
+    explicit DiskCache(FileBackedFS& fs, size_t entry_count = 10000)
         : m_fs(fs)
+        , m_entry_count(entry_count)
         , m_cached_block_data(KBuffer::create_with_size(m_entry_count * m_fs.block_size()))
         , m_entries(KBuffer::create_with_size(m_entry_count * sizeof(CacheEntry)))
     {
         for (size_t i = 0; i < m_entry_count; ++i) {
             entries()[i].data = m_cached_block_data.data() + i * m_fs.block_size();
+            m_clean_entries.append(&entries()[i]);
         }
     }
 
     ~DiskCache() {}
 
-    bool is_dirty() const { return m_dirty; }
-    void set_dirty(bool b) { m_dirty = b; }
+    bool is_dirty() const { return !m_dirty_entries.is_empty(); }
 
+    // Entries live on one of two LRU lists (clean or dirty), most recently
+    // used at the tail. The hash map makes lookup O(1); eviction takes the
+    // least recently used clean entry.
     CacheEntry& get(u32 block_index) const
     {
-        auto now = kgettimeofday().tv_sec;
-
-        CacheEntry* oldest_clean_entry = nullptr;
-        for (size_t i = 0; i < m_entry_count; ++i) {
-            auto& entry = const_cast<CacheEntry&>(entries()[i]);
-            if (entry.block_index == block_index) {
-                entry.timestamp = now;
-                return entry;
-            }
-            if (!entry.is_dirty) {
-                if (!oldest_clean_entry)
-                    oldest_clean_entry = &entry;
-                else if (entry.timestamp < oldest_clean_entry->timestamp)
-                    oldest_clean_entry = &entry;
-            }
+        auto& self = const_cast<DiskCache&>(*this);
+        auto it = self.m_map.find(block_index);
+        if (it != self.m_map.end()) {
+            auto* entry = it->value;
+            auto& lru_list = entry->is_dirty ? self.m_dirty_entries : self.m_clean_entries;
+            lru_list.remove(entry);
+            lru_list.append(entry);
+            return *entry;
         }
-        if (!oldest_clean_entry) {
+
+        if (self.m_clean_entries.is_empty()) {
             // Not a single clean entry! Flush writes and try again.
             // NOTE: We want to make sure we only call FileBackedFS flush here,
             //       not some FileBackedFS subclass flush!
@@ -87,23 +92,56 @@ public:
             return get(block_index);
         }
 
-        // Replace the oldest clean entry.
-        auto& new_entry = *oldest_clean_entry;
-        new_entry.timestamp = now;
-        new_entry.block_index = block_index;
-        new_entry.has_data = false;
-        new_entry.is_dirty = false;
-        return new_entry;
+        // Evict the least recently used clean entry.
+        auto* entry = self.m_clean_entries.head();
+        self.m_clean_entries.remove(entry);
+
+        auto old_it = self.m_map.find(entry->block_index);
+        if (old_it != self.m_map.end() && old_it->value == entry)
+            self.m_map.remove(entry->block_index);
+
+        entry->block_index = block_index;
+        entry->has_data = false;
+        entry->is_dirty = false;
+        self.m_map.set(block_index, entry);
+        self.m_clean_entries.append(entry);
+        return *entry;
+    }
+
+    CacheEntry* get_if_cached(u32 block_index)
+    {
+        auto it = m_map.find(block_index);
+        if (it == m_map.end())
+            return nullptr;
+        return it->value;
+    }
+
+    void mark_dirty(CacheEntry& entry)
+    {
+        if (entry.is_dirty)
+            return;
+        entry.is_dirty = true;
+        m_clean_entries.remove(&entry);
+        m_dirty_entries.append(&entry);
+    }
+
+    void mark_clean(CacheEntry& entry)
+    {
+        if (!entry.is_dirty)
+            return;
+        entry.is_dirty = false;
+        m_dirty_entries.remove(&entry);
+        m_clean_entries.append(&entry);
     }
 
     const CacheEntry* entries() const { return (const CacheEntry*)m_entries.data(); }
     CacheEntry* entries() { return (CacheEntry*)m_entries.data(); }
 
     template<typename Callback>
-    void for_each_entry(Callback callback)
+    void for_each_dirty_entry(Callback callback)
     {
-        for (size_t i = 0; i < m_entry_count; ++i)
-            callback(entries()[i]);
+        for (auto* entry = m_dirty_entries.head(); entry; entry = entry->next())
+            callback(*entry);
     }
 
 private:
@@ -111,7 +149,9 @@ private:
     size_t m_entry_count { 10000 };
     KBuffer m_cached_block_data;
     KBuffer m_entries;
-    bool m_dirty { false };
+    HashMap<u32, CacheEntry*> m_map;
+    InlineLinkedList<CacheEntry> m_clean_entries;
+    InlineLinkedList<CacheEntry> m_dirty_entries;
 };
 
 FileBackedFS::FileBackedFS(FileDescription& file_description)
@@ -124,7 +164,7 @@ FileBackedFS::~FileBackedFS()
 {
 }
 
-bool FileBackedFS::write_block(unsigned index, const u8* data, FileDescription* description)
+bool FileBackedFS::write_block(unsigned index, const u8* data, FileDescription* description, bool is_metadata)
 {
     ASSERT(m_logical_block_size);
 #ifdef FBFS_DEBUG
@@ -134,7 +174,13 @@ bool FileBackedFS::write_block(unsigned index, const u8* data, FileDescription*
     bool allow_cache = !description || !description->is_direct();
 
     if (!allow_cache) {
-        flush_specific_block_if_needed(index);
+        // Keep any cached copy coherent with what we're about to put on disk,
+        // instead of leaving a stale entry behind for later cached readers.
+        if (auto* entry = cache().get_if_cached(index)) {
+            memcpy(entry->data, data, block_size());
+            entry->has_data = true;
+            cache().mark_clean(*entry);
+        }
         u32 base_offset = static_cast<u32>(index) * static_cast<u32>(block_size());
         m_file_description->seek(base_offset, SEEK_SET);
         auto nwritten = m_file_description->write(data, block_size());
@@ -144,10 +190,9 @@ bool FileBackedFS::write_block(unsigned index, const u8* data, FileDescription*
 
     auto& entry = cache().get(index);
     memcpy(entry.data, data, block_size());
-    entry.is_dirty = true;
     entry.has_data = true;
-
-    cache().set_dirty(true);
+    entry.is_metadata = is_metadata;
+    cache().mark_dirty(entry);
     return true;
 }
 
@@ -187,14 +232,33 @@ bool FileBackedFS::raw_write_blocks(unsigned index, size_t count, const u8* buff
     return true;
 }
 
-bool FileBackedFS::write_blocks(unsigned index, unsigned count, const u8* data, FileDescription* description)
+bool FileBackedFS::write_blocks(unsigned index, unsigned count, const u8* data, FileDescription* description, bool is_metadata)
 {
     ASSERT(m_logical_block_size);
 #ifdef FBFS_DEBUG
     klog() << "FileBackedFileSystem::write_blocks " << index << " x" << count;
 #endif
+    bool allow_cache = !description || !description->is_direct();
+
+    if (!allow_cache) {
+        // One big transfer instead of a synchronous write per block, so the
+        // device can service it with a single (or few) DMA request(s).
+        for (unsigned i = 0; i < count; ++i) {
+            if (auto* entry = cache().get_if_cached(index + i)) {
+                memcpy(entry->data, data + i * block_size(), block_size());
+                entry->has_data = true;
+                cache().mark_clean(*entry);
+            }
+        }
+        u32 base_offset = static_cast<u32>(index) * static_cast<u32>(block_size());
+        m_file_description->seek(base_offset, SEEK_SET);
+        auto nwritten = m_file_description->write(data, count * block_size());
+        ASSERT(nwritten == (ssize_t)(count * block_size()));
+        return true;
+    }
+
     for (unsigned i = 0; i < count; ++i)
-        write_block(index + i, data + i * block_size(), description);
+        write_block(index + i, data + i * block_size(), description, is_metadata);
     return true;
 }
 
@@ -235,6 +299,22 @@ bool FileBackedFS::read_blocks(unsigned index, unsigned count, u8* buffer, FileD
         return false;
     if (count == 1)
         return read_block(index, buffer, description);
+
+    bool allow_cache = !description || !description->is_direct();
+
+    if (!allow_cache) {
+        // One big transfer instead of a synchronous read per block, so the
+        // device can service it with a single (or few) DMA request(s).
+        auto& self = const_cast<FileBackedFS&>(*this);
+        for (unsigned i = 0; i < count; ++i)
+            self.flush_specific_block_if_needed(index + i);
+        u32 base_offset = static_cast<u32>(index) * static_cast<u32>(block_size());
+        const_cast<FileDescription&>(*m_file_description).seek(base_offset, SEEK_SET);
+        auto nread = const_cast<FileDescription&>(*m_file_description).read(buffer, count * block_size());
+        ASSERT(nread == (ssize_t)(count * block_size()));
+        return true;
+    }
+
     u8* out = buffer;
 
     for (unsigned i = 0; i < count; ++i) {
@@ -249,16 +329,13 @@ bool FileBackedFS::read_blocks(unsigned index, unsigned count, u8* buffer, FileD
 void FileBackedFS::flush_specific_block_if_needed(unsigned index)
 {
     LOCKER(m_lock);
-    if (!cache().is_dirty())
+    auto* entry = cache().get_if_cached(index);
+    if (!entry || !entry->is_dirty)
         return;
-    cache().for_each_entry([&](CacheEntry& entry) {
-        if (entry.is_dirty && entry.block_index == index) {
-            u32 base_offset = static_cast<u32>(entry.block_index) * static_cast<u32>(block_size());
-            m_file_description->seek(base_offset, SEEK_SET);
-            m_file_description->write(entry.data, block_size());
-            entry.is_dirty = false;
-        }
-    });
+    u32 base_offset = static_cast<u32>(entry->block_index) * static_cast<u32>(block_size());
+    m_file_description->seek(base_offset, SEEK_SET);
+    m_file_description->write(entry->data, block_size());
+    cache().mark_clean(*entry);
 }
 
 void FileBackedFS::flush_writes_impl()
@@ -266,20 +343,67 @@ void FileBackedFS::flush_writes_impl()
     LOCKER(m_lock);
     if (!cache().is_dirty())
         return;
-    u32 count = 0;
-    cache().for_each_entry([&](CacheEntry& entry) {
-        if (!entry.is_dirty)
-            return;
-        u32 base_offset = static_cast<u32>(entry.block_index) * static_cast<u32>(block_size());
-        m_file_description->seek(base_offset, SEEK_SET);
-        m_file_description->write(entry.data, block_size());
-        ++count;
-        entry.is_dirty = false;
+
+    Vector<CacheEntry*> dirty_data_entries;
+    Vector<CacheEntry*> dirty_metadata_entries;
+    cache().for_each_dirty_entry([&](CacheEntry& entry) {
+        if (entry.is_metadata)
+            dirty_metadata_entries.append(&entry);
+        else
+            dirty_data_entries.append(&entry);
     });
-    cache().set_dirty(false);
+
+    static const size_t max_run_length = 32;
+    auto run_buffer = KBuffer::create_with_size(max_run_length * block_size());
+
+    u32 count = 0;
+    auto write_entries = [&](Vector<CacheEntry*>& dirty_entries) {
+        // Sort the dirty blocks and write adjacent ones with a single request
+        // each, instead of issuing one synchronous write per block.
+        quick_sort(dirty_entries.begin(), dirty_entries.end(), [](auto* a, auto* b) {
+            return a->block_index < b->block_index;
+        });
+        size_t i = 0;
+        while (i < dirty_entries.size()) {
+            size_t run_length = 1;
+            while (i + run_length < dirty_entries.size()
+                && run_length < max_run_length
+                && dirty_entries[i + run_length]->block_index == dirty_entries[i]->block_index + run_length)
+                ++run_length;
+            for (size_t j = 0; j < run_length; ++j)
+                memcpy(run_buffer.data() + j * block_size(), dirty_entries[i + j]->data, block_size());
+            u32 base_offset = static_cast<u32>(dirty_entries[i]->block_index) * static_cast<u32>(block_size());
+            m_file_description->seek(base_offset, SEEK_SET);
+            m_file_description->write(run_buffer.data(), run_length * block_size());
+            for (size_t j = 0; j < run_length; ++j)
+                cache().mark_clean(*dirty_entries[i + j]);
+            count += run_length;
+            i += run_length;
+        }
+    };
+
+    // Ordered write-back: every data block reaches the disk (and the disk's
+    // volatile write cache is emptied) before any metadata block that might
+    // refer to it. After a power loss we can lose recently written data, but
+    // metadata never ends up pointing at blocks that never made it out.
+    if (!dirty_data_entries.is_empty()) {
+        write_entries(dirty_data_entries);
+        flush_device_write_cache();
+    }
+    if (!dirty_metadata_entries.is_empty()) {
+        write_entries(dirty_metadata_entries);
+        flush_device_write_cache();
+    }
     dbg() << class_name() << ": Flushed " << count << " blocks to disk";
 }
 
+void FileBackedFS::flush_device_write_cache()
+{
+    auto& file = m_file_description->file();
+    if (file.is_block_device())
+        static_cast<BlockDevice&>(file).flush_write_cache();
+}
+
 void FileBackedFS::flush_writes()
 {
     flush_writes_impl();
@@ -61,8 +61,10 @@ protected:
     bool raw_read_blocks(unsigned index, size_t count, u8* buffer);
     bool raw_write_blocks(unsigned index, size_t count, const u8* buffer);
 
-    bool write_block(unsigned index, const u8*, FileDescription* = nullptr);
-    bool write_blocks(unsigned index, unsigned count, const u8*, FileDescription* = nullptr);
+    void flush_device_write_cache();
+
+    bool write_block(unsigned index, const u8*, FileDescription* = nullptr, bool is_metadata = false);
+    bool write_blocks(unsigned index, unsigned count, const u8*, FileDescription* = nullptr, bool is_metadata = false);
 
     size_t m_logical_block_size { 512 };
 
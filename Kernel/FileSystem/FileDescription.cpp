@@ -131,11 +131,38 @@ ssize_t FileDescription::read(u8* buffer, ssize_t count)
         return -EOVERFLOW;
     SmapDisabler disabler;
     int nread = m_file->read(*this, offset(), buffer, count);
-    if (nread > 0 && m_file->is_seekable())
+    if (nread > 0 && m_file->is_seekable()) {
+        if (m_current_offset == m_last_read_end)
+            ++m_sequential_read_count;
+        else
+            m_sequential_read_count = 0;
         m_current_offset += nread;
+        m_last_read_end = m_current_offset;
+        consider_read_ahead();
+    }
     return nread;
 }
 
+void FileDescription::consider_read_ahead()
+{
+    // After a few back-to-back sequential reads on an inode-backed file,
+    // pull the next chunk into the disk cache ahead of the consumer. Their
+    // subsequent reads then hit the cache instead of paying a device
+    // round-trip per chunk.
+    static const off_t read_ahead_chunk_size = 64 * KB;
+    if (!m_inode || m_sequential_read_count < 2)
+        return;
+    if (m_current_offset < m_read_ahead_until)
+        return;
+    off_t file_size = m_inode->size();
+    if (m_current_offset >= file_size)
+        return;
+    size_t read_ahead_size = min(read_ahead_chunk_size, file_size - m_current_offset);
+    auto scratch = ByteBuffer::create_uninitialized(read_ahead_size);
+    m_inode->read_bytes(m_current_offset, read_ahead_size, scratch.data(), nullptr);
+    m_read_ahead_until = m_current_offset + read_ahead_size;
+}
+
 ssize_t FileDescription::write(const u8* data, ssize_t size)
 {
     LOCKER(m_lock);
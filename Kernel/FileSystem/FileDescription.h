@@ -143,12 +143,19 @@ private:
     explicit FileDescription(File&);
     FileDescription(FIFO&, FIFO::Direction);
 
+    void consider_read_ahead();
+
     RefPtr<Custody> m_custody;
     RefPtr<Inode> m_inode;
     NonnullRefPtr<File> m_file;
 
     off_t m_current_offset { 0 };
 
+    // Sequential-read detection for read-ahead into the disk cache.
+    off_t m_last_read_end { 0 };
+    off_t m_read_ahead_until { 0 };
+    unsigned m_sequential_read_count { 0 };
+
     Optional<KBuffer> m_generator_cache;
 
     u32 m_file_flags { 0 };
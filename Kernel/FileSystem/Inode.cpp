@@ -212,11 +212,33 @@ void Inode::set_metadata_dirty(bool metadata_dirty)
         //        We don't always end up on this particular code path, for instance when writing to an ext2fs file.
         LOCKER(m_lock);
         for (auto& watcher : m_watchers) {
-            watcher->notify_inode_event({}, InodeWatcher::Event::Type::Modified);
+            watcher->notify_inode_event({}, *this, InodeWatcher::Event::Type::Modified);
         }
     }
 }
 
+void Inode::did_add_child(const InodeIdentifier& child_id, const StringView& name)
+{
+    LOCKER(m_lock);
+    if (m_watchers.is_empty())
+        return;
+    String owned_name = name;
+    for (auto& watcher : m_watchers) {
+        watcher->notify_child_event({}, *this, child_id, owned_name, InodeWatcher::Event::Type::ChildAdded);
+    }
+}
+
+void Inode::did_remove_child(const StringView& name)
+{
+    LOCKER(m_lock);
+    if (m_watchers.is_empty())
+        return;
+    String owned_name = name;
+    for (auto& watcher : m_watchers) {
+        watcher->notify_child_event({}, *this, {}, owned_name, InodeWatcher::Event::Type::ChildRemoved);
+    }
+}
+
 KResult Inode::prepare_to_write_data()
 {
     // FIXME: It's a poor design that filesystems are expected to call this before writing out data.
@@ -117,6 +117,8 @@ public:
 protected:
     Inode(FS& fs, unsigned index);
     void set_metadata_dirty(bool);
+    void did_add_child(const InodeIdentifier& child_id, const StringView& name);
+    void did_remove_child(const StringView& name);
     void inode_contents_changed(off_t, ssize_t, const u8*);
     void inode_size_changed(size_t old_size, size_t new_size);
     KResult prepare_to_write_data();
@@ -25,26 +25,66 @@
  */
 
 #include <AK/Memory.h>
+#include <AK/StringView.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/InodeWatcher.h>
 
 namespace Kernel {
 
-NonnullRefPtr<InodeWatcher> InodeWatcher::create(Inode& inode)
+NonnullRefPtr<InodeWatcher> InodeWatcher::create(Inode& inode, bool recursive)
 {
-    return adopt(*new InodeWatcher(inode));
+    return adopt(*new InodeWatcher(inode, recursive));
 }
 
-InodeWatcher::InodeWatcher(Inode& inode)
+InodeWatcher::InodeWatcher(Inode& inode, bool recursive)
     : m_inode(inode.make_weak_ptr())
+    , m_recursive(recursive)
 {
     inode.register_watcher({}, *this);
+    if (m_recursive && inode.is_directory())
+        watch_all_subdirectories(inode);
 }
 
 InodeWatcher::~InodeWatcher()
 {
     if (RefPtr<Inode> safe_inode = m_inode.ptr())
         safe_inode->unregister_watcher({}, *this);
+    for (auto& weak_inode : m_extra_watched_inodes) {
+        if (RefPtr<Inode> safe_inode = weak_inode.ptr())
+            safe_inode->unregister_watcher({}, *this);
+    }
+}
+
+bool InodeWatcher::is_watching(const Inode& inode) const
+{
+    if (m_inode.ptr() == &inode)
+        return true;
+    for (auto& weak_inode : m_extra_watched_inodes) {
+        if (weak_inode.ptr() == &inode)
+            return true;
+    }
+    return false;
+}
+
+void InodeWatcher::watch_all_subdirectories(Inode& directory)
+{
+    // We only hold weak pointers to the inodes we watch, same as the
+    // non-recursive case, so grab strong references for the traversal.
+    Vector<NonnullRefPtr<Inode>> subdirectories;
+    directory.traverse_as_directory([&](auto& entry) {
+        StringView name(entry.name, entry.name_length);
+        if (name == "." || name == "..")
+            return true;
+        auto child = directory.fs().get_inode(entry.inode);
+        if (child && child->is_directory() && !is_watching(*child))
+            subdirectories.append(child.release_nonnull());
+        return true;
+    });
+    for (auto& subdirectory : subdirectories) {
+        subdirectory->register_watcher({}, *this);
+        m_extra_watched_inodes.append(subdirectory->make_weak_ptr());
+        watch_all_subdirectories(subdirectory);
+    }
 }
 
 bool InodeWatcher::can_read(const FileDescription&, size_t) const
@@ -64,11 +104,30 @@ ssize_t InodeWatcher::read(FileDescription&, size_t, u8* buffer, ssize_t buffer_
     if (!m_inode)
         return 0;
 
-    // FIXME: What should we do if the output buffer is too small?
-    ASSERT(buffer_size >= (int)sizeof(Event));
-    auto event = m_queue.dequeue();
-    memcpy(buffer, &event, sizeof(event));
-    return sizeof(event);
+    // Drain as many whole events as fit, so a burst of changes costs one
+    // syscall instead of one per event.
+    ssize_t nwritten = 0;
+    u8* out = buffer;
+    while (!m_queue.is_empty()) {
+        auto& event = m_queue.first();
+        size_t name_length = min(event.child_name.length(), (size_t)255);
+        size_t event_size = sizeof(u8) + sizeof(u32) + sizeof(u8) + name_length;
+        if ((size_t)(buffer_size - nwritten) < event_size) {
+            if (nwritten == 0)
+                return -EINVAL;
+            break;
+        }
+        *out++ = (u8)event.type;
+        u32 inode_index = event.inode_index;
+        memcpy(out, &inode_index, sizeof(inode_index));
+        out += sizeof(inode_index);
+        *out++ = (u8)name_length;
+        memcpy(out, event.child_name.characters(), name_length);
+        out += name_length;
+        nwritten += event_size;
+        m_queue.dequeue();
+    }
+    return nwritten;
 }
 
 ssize_t InodeWatcher::write(FileDescription&, size_t, const u8*, ssize_t)
@@ -83,9 +142,24 @@ String InodeWatcher::absolute_path(const FileDescription&) const
     return String::format("InodeWatcher:%s", m_inode->identifier().to_string().characters());
 }
 
-void InodeWatcher::notify_inode_event(Badge<Inode>, Event::Type event_type)
+void InodeWatcher::notify_inode_event(Badge<Inode>, Inode& inode, Event::Type event_type)
 {
-    m_queue.enqueue({ event_type });
+    m_queue.enqueue({ event_type, inode.index(), {} });
+}
+
+void InodeWatcher::notify_child_event(Badge<Inode>, Inode& parent, const InodeIdentifier& child_id, const String& child_name, Event::Type event_type)
+{
+    m_queue.enqueue({ event_type, parent.index(), child_name });
+
+    // A recursive watcher starts watching new subdirectories as they appear,
+    // so the whole tree stays covered by this one file descriptor.
+    if (m_recursive && event_type == Event::Type::ChildAdded && child_id.is_valid()) {
+        auto child = parent.fs().get_inode(child_id);
+        if (child && child->is_directory() && !is_watching(*child)) {
+            child->register_watcher({}, *this);
+            m_extra_watched_inodes.append(child->make_weak_ptr());
+        }
+    }
 }
 
 }
@@ -28,8 +28,11 @@
 
 #include <AK/Badge.h>
 #include <AK/CircularQueue.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <Kernel/FileSystem/File.h>
+#include <Kernel/FileSystem/InodeIdentifier.h>
 
 namespace Kernel {
 
@@ -37,18 +40,30 @@ class Inode;
 
 class InodeWatcher final : public File {
 public:
-    static NonnullRefPtr<InodeWatcher> create(Inode&);
+    static NonnullRefPtr<InodeWatcher> create(Inode&, bool recursive = false);
     virtual ~InodeWatcher() override;
 
     struct Event {
-        enum class Type {
+        enum class Type : u8 {
             Invalid = 0,
             Modified,
+            ChildAdded,
+            ChildRemoved,
         };
 
         Type type { Type::Invalid };
+        u32 inode_index { 0 };
+        String child_name;
     };
 
+    // Each read() drains as many queued events as fit in the caller's
+    // buffer. The wire format per event is:
+    //
+    //   u8   type
+    //   u32  inode index of the inode the event happened on
+    //   u8   name length (0 if the event carries no name)
+    //   char name[name length] (not null-terminated)
+
     virtual bool can_read(const FileDescription&, size_t) const override;
     virtual bool can_write(const FileDescription&, size_t) const override;
     virtual ssize_t read(FileDescription&, size_t, u8*, ssize_t) override;
@@ -56,13 +71,19 @@ public:
     virtual String absolute_path(const FileDescription&) const override;
     virtual const char* class_name() const override { return "InodeWatcher"; };
 
-    void notify_inode_event(Badge<Inode>, Event::Type);
+    void notify_inode_event(Badge<Inode>, Inode&, Event::Type);
+    void notify_child_event(Badge<Inode>, Inode& parent, const InodeIdentifier& child_id, const String& child_name, Event::Type);
 
 private:
-    explicit InodeWatcher(Inode&);
+    InodeWatcher(Inode&, bool recursive);
+
+    void watch_all_subdirectories(Inode& directory);
+    bool is_watching(const Inode&) const;
 
     WeakPtr<Inode> m_inode;
-    CircularQueue<Event, 32> m_queue;
+    bool m_recursive { false };
+    Vector<WeakPtr<Inode>> m_extra_watched_inodes;
+    CircularQueue<Event, 128> m_queue;
 };
 
 }
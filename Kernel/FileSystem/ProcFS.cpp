@@ -51,6 +51,7 @@
 #include <Kernel/Net/UDPSocket.h>
 #include <Kernel/PCI/Access.h>
 #include <Kernel/Profiling.h>
+#include <Kernel/Syscall.h>
 #include <Kernel/TTY/TTY.h>
 #include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/PurgeableVMObject.h>
@@ -86,10 +87,12 @@ enum ProcFileType {
     FI_Root_interrupts,
     FI_Root_pci,
     FI_Root_devices,
+    FI_Root_locks,
     FI_Root_uptime,
     FI_Root_cmdline,
     FI_Root_modules,
     FI_Root_profile,
+    FI_Root_syscall_latency,
     FI_Root_self, // symlink
     FI_Root_sys,  // directory
     FI_Root_net,  // directory
@@ -393,6 +396,21 @@ Optional<KBuffer> procfs$devices(InodeIdentifier)
     return builder.build();
 }
 
+Optional<KBuffer> procfs$locks(InodeIdentifier)
+{
+    KBufferBuilder builder;
+    JsonArraySerializer array { builder };
+    Lock::for_each([&array](Lock& lock) {
+        auto obj = array.add_object();
+        obj.add("name", lock.name() ? lock.name() : "?");
+        obj.add("times_acquired", lock.times_acquired());
+        obj.add("times_contended", lock.times_contended());
+        obj.add("is_locked", lock.is_locked());
+    });
+    array.finish();
+    return builder.build();
+}
+
 Optional<KBuffer> procfs$uptime(InodeIdentifier)
 {
     KBufferBuilder builder;
@@ -442,6 +460,7 @@ Optional<KBuffer> procfs$profile(InodeIdentifier)
     Profiling::for_each_sample([&](auto& sample) {
         auto object = array.add_object();
         object.add("type", "sample");
+        object.add("pid", sample.pid);
         object.add("tid", sample.tid);
         object.add("timestamp", sample.timestamp);
         auto frames_array = object.add_array("stack");
@@ -830,6 +849,7 @@ Optional<KBuffer> procfs$memstat(InodeIdentifier)
     json.add("user_physical_available", MM.user_physical_pages() - MM.user_physical_pages_used());
     json.add("super_physical_allocated", MM.super_physical_pages_used());
     json.add("super_physical_available", MM.super_physical_pages() - MM.super_physical_pages_used());
+    json.add("memory_pressure", MM.is_under_memory_pressure());
     json.add("kmalloc_call_count", g_kmalloc_call_count);
     json.add("kfree_call_count", g_kfree_call_count);
     slab_alloc_stats([&json](size_t slab_size, size_t num_allocated, size_t num_free) {
@@ -841,9 +861,45 @@ Optional<KBuffer> procfs$memstat(InodeIdentifier)
     return builder.build();
 }
 
+Optional<KBuffer> procfs$syscall_latency(InodeIdentifier)
+{
+    KBufferBuilder builder;
+    JsonArraySerializer array { builder };
+    for (u32 function = 0; function < Syscall::Function::__Count; ++function) {
+        auto* histogram = Syscall::latency_histogram(function);
+        u32 count = 0;
+        for (size_t bucket = 0; bucket < Syscall::latency_bucket_count; ++bucket)
+            count += histogram[bucket];
+        if (count == 0)
+            continue;
+        auto obj = array.add_object();
+        obj.add("name", Syscall::to_string((Syscall::Function)function));
+        obj.add("count", count);
+        auto buckets = obj.add_array("log2_cycle_buckets");
+        for (size_t bucket = 0; bucket < Syscall::latency_bucket_count; ++bucket)
+            buckets.add(histogram[bucket]);
+        buckets.finish();
+    }
+    array.finish();
+    return builder.build();
+}
+
 Optional<KBuffer> procfs$all(InodeIdentifier)
 {
     InterruptDisabler disabler;
+
+    // Serializing every process and thread is by far the most expensive
+    // thing ProcFS does, and monitors poll this node continuously. Reuse
+    // the last snapshot until a process or thread actually changes state
+    // or the tick counters move on.
+    static KBuffer* s_cached_json;
+    static u32 s_cached_generation;
+    static u64 s_cached_uptime;
+    if (s_cached_json && s_cached_generation == g_process_state_generation && s_cached_uptime == g_uptime)
+        return *s_cached_json;
+    u32 generation_at_start = g_process_state_generation;
+    u64 uptime_at_start = g_uptime;
+
     auto processes = Process::all_processes();
     KBufferBuilder builder;
     JsonArraySerializer array { builder };
@@ -899,6 +955,7 @@ Optional<KBuffer> procfs$all(InodeIdentifier)
             thread_object.add("name", thread.name());
             thread_object.add("times_scheduled", thread.times_scheduled());
             thread_object.add("ticks", thread.ticks());
+            thread_object.add("cycles", thread.cycles());
             thread_object.add("state", thread.state_string());
             thread_object.add("priority", thread.priority());
             thread_object.add("effective_priority", thread.effective_priority());
@@ -919,7 +976,12 @@ Optional<KBuffer> procfs$all(InodeIdentifier)
     for (auto* process : processes)
         build_process(*process);
     array.finish();
-    return builder.build();
+
+    delete s_cached_json;
+    s_cached_json = new KBuffer(builder.build());
+    s_cached_generation = generation_at_start;
+    s_cached_uptime = uptime_at_start;
+    return *s_cached_json;
 }
 
 Optional<KBuffer> procfs$inodes(InodeIdentifier)
@@ -1067,6 +1129,20 @@ bool ProcFS::initialize()
             g_dump_kmalloc_stacks = kmalloc_stack_helper->resource();
         });
     }
+
+    static Lockable<bool>* syscall_latency_helper;
+
+    if (syscall_latency_helper == nullptr) {
+        syscall_latency_helper = new Lockable<bool>();
+        syscall_latency_helper->resource() = Syscall::g_latency_tracking_enabled;
+        ProcFS::add_sys_bool("syscall_latency", *syscall_latency_helper, [] {
+            bool enable = syscall_latency_helper->resource();
+            // Start each capture with a clean slate.
+            if (enable && !Syscall::g_latency_tracking_enabled)
+                Syscall::clear_latency_histograms();
+            Syscall::g_latency_tracking_enabled = enable;
+        });
+    }
     return true;
 }
 
@@ -1630,10 +1706,12 @@ ProcFS::ProcFS()
     m_entries[FI_Root_pci] = { "pci", FI_Root_pci, false, procfs$pci };
     m_entries[FI_Root_interrupts] = { "interrupts", FI_Root_interrupts, false, procfs$interrupts };
     m_entries[FI_Root_devices] = { "devices", FI_Root_devices, false, procfs$devices };
+    m_entries[FI_Root_locks] = { "locks", FI_Root_locks, false, procfs$locks };
     m_entries[FI_Root_uptime] = { "uptime", FI_Root_uptime, false, procfs$uptime };
     m_entries[FI_Root_cmdline] = { "cmdline", FI_Root_cmdline, true, procfs$cmdline };
     m_entries[FI_Root_modules] = { "modules", FI_Root_modules, true, procfs$modules };
     m_entries[FI_Root_profile] = { "profile", FI_Root_profile, false, procfs$profile };
+    m_entries[FI_Root_syscall_latency] = { "syscall_latency", FI_Root_syscall_latency, false, procfs$syscall_latency };
     m_entries[FI_Root_sys] = { "sys", FI_Root_sys, true };
     m_entries[FI_Root_net] = { "net", FI_Root_net, false };
 
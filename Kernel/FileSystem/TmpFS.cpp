@@ -188,7 +188,7 @@ ssize_t TmpFSInode::read_bytes(off_t offset, ssize_t size, u8* buffer, FileDescr
     ASSERT(size >= 0);
     ASSERT(offset >= 0);
 
-    if (!m_content.has_value())
+    if (m_content_chunks.is_empty())
         return 0;
 
     if (offset >= m_metadata.size)
@@ -197,8 +197,24 @@ ssize_t TmpFSInode::read_bytes(off_t offset, ssize_t size, u8* buffer, FileDescr
     if (static_cast<off_t>(size) > m_metadata.size - offset)
         size = m_metadata.size - offset;
 
-    memcpy(buffer, m_content.value().data() + offset, size);
-    return size;
+    ssize_t nread = 0;
+    while (nread < size) {
+        size_t chunk_index = offset / content_chunk_size;
+        size_t offset_in_chunk = offset % content_chunk_size;
+        size_t bytes_from_chunk = min(static_cast<size_t>(size - nread), content_chunk_size - offset_in_chunk);
+        memcpy(buffer + nread, m_content_chunks[chunk_index].data() + offset_in_chunk, bytes_from_chunk);
+        offset += bytes_from_chunk;
+        nread += bytes_from_chunk;
+    }
+    return nread;
+}
+
+void TmpFSInode::ensure_content_capacity(size_t size)
+{
+    // Chunks come back zero-filled, so any hole this creates reads as zeroes.
+    size_t needed_chunks = (size + content_chunk_size - 1) / content_chunk_size;
+    while (m_content_chunks.size() < needed_chunks)
+        m_content_chunks.append(KBuffer::create_with_size(content_chunk_size, Region::Access::Read | Region::Access::Write, "TmpFSInode: content"));
 }
 
 ssize_t TmpFSInode::write_bytes(off_t offset, ssize_t size, const u8* buffer, FileDescription*)
@@ -217,29 +233,23 @@ ssize_t TmpFSInode::write_bytes(off_t offset, ssize_t size, const u8* buffer, Fi
         new_size = offset + size;
 
     if (new_size > old_size) {
-        if (m_content.has_value() && m_content.value().capacity() >= (size_t)new_size) {
-            m_content.value().set_size(new_size);
-        } else {
-            // Grow the content buffer 2x the new sizeto accomodate repeating write() calls.
-            // Note that we're not actually committing physical memory to the buffer
-            // until it's needed. We only grow VM here.
-
-            // FIXME: Fix this so that no memcpy() is necessary, and we can just grow the
-            //        KBuffer and it will add physical pages as needed while keeping the
-            //        existing ones.
-            auto tmp = KBuffer::create_with_size(new_size * 2);
-            tmp.set_size(new_size);
-            if (m_content.has_value())
-                memcpy(tmp.data(), m_content.value().data(), old_size);
-            m_content = move(tmp);
-        }
+        ensure_content_capacity(new_size);
         m_metadata.size = new_size;
         set_metadata_dirty(true);
         set_metadata_dirty(false);
         inode_size_changed(old_size, new_size);
     }
 
-    memcpy(m_content.value().data() + offset, buffer, size);
+    off_t write_offset = offset;
+    ssize_t nwritten = 0;
+    while (nwritten < size) {
+        size_t chunk_index = write_offset / content_chunk_size;
+        size_t offset_in_chunk = write_offset % content_chunk_size;
+        size_t bytes_to_chunk = min(static_cast<size_t>(size - nwritten), content_chunk_size - offset_in_chunk);
+        memcpy(m_content_chunks[chunk_index].data() + offset_in_chunk, buffer + nwritten, bytes_to_chunk);
+        write_offset += bytes_to_chunk;
+        nwritten += bytes_to_chunk;
+    }
     inode_contents_changed(offset, size, buffer);
 
     return size;
@@ -313,6 +323,7 @@ KResult TmpFSInode::add_child(InodeIdentifier child_id, const StringView& name,
     m_children.set(owned_name, { entry, move(child) });
     set_metadata_dirty(true);
     set_metadata_dirty(false);
+    did_add_child(child_id, name);
     return KSuccess;
 }
 
@@ -330,6 +341,7 @@ KResult TmpFSInode::remove_child(const StringView& name)
     m_children.remove(it);
     set_metadata_dirty(true);
     set_metadata_dirty(false);
+    did_remove_child(name);
     return KSuccess;
 }
 
@@ -338,32 +350,29 @@ KResult TmpFSInode::truncate(u64 size)
     LOCKER(m_lock);
     ASSERT(!is_directory());
 
-    if (size == 0)
-        m_content.clear();
-    else if (!m_content.has_value()) {
-        m_content = KBuffer::create_with_size(size);
-    } else if (static_cast<size_t>(size) < m_content.value().capacity()) {
-        size_t prev_size = m_metadata.size;
-        m_content.value().set_size(size);
-        if (prev_size < static_cast<size_t>(size))
-            memset(m_content.value().data() + prev_size, 0, size - prev_size);
-    } else {
-        size_t prev_size = m_metadata.size;
-        KBuffer tmp = KBuffer::create_with_size(size);
-        memcpy(tmp.data(), m_content.value().data(), prev_size);
-        m_content = move(tmp);
+    size_t old_size = m_metadata.size;
+    if (old_size == size)
+        return KSuccess;
+
+    size_t needed_chunks = size ? (size + content_chunk_size - 1) / content_chunk_size : 0;
+    while (m_content_chunks.size() > needed_chunks)
+        m_content_chunks.take_last();
+    ensure_content_capacity(size);
+
+    if (static_cast<size_t>(size) < old_size && size > 0) {
+        // Zero the now-unused tail of the last chunk, so growing the file
+        // again later reads back zeroes.
+        size_t offset_in_chunk = size % content_chunk_size;
+        if (offset_in_chunk)
+            memset(m_content_chunks.last().data() + offset_in_chunk, 0, content_chunk_size - offset_in_chunk);
     }
 
-    size_t old_size = m_metadata.size;
     m_metadata.size = size;
     set_metadata_dirty(true);
     set_metadata_dirty(false);
 
-    if (old_size != (size_t)size) {
-        inode_size_changed(old_size, size);
-        if (m_content.has_value())
-            inode_contents_changed(0, size, m_content.value().data());
-    }
+    inode_size_changed(old_size, size);
+    inode_contents_changed(0, size, nullptr);
 
     return KSuccess;
 }
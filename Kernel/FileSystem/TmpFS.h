@@ -28,6 +28,7 @@
 
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
+#include <AK/Vector.h>
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/KBuffer.h>
@@ -99,10 +100,16 @@ private:
     static NonnullRefPtr<TmpFSInode> create(TmpFS&, InodeMetadata metadata, InodeIdentifier parent);
     static NonnullRefPtr<TmpFSInode> create_root(TmpFS&);
 
+    void ensure_content_capacity(size_t);
+
     InodeMetadata m_metadata;
     InodeIdentifier m_parent;
 
-    Optional<KBuffer> m_content;
+    // File content lives in a list of fixed-size chunks, each its own
+    // kernel allocation. Growing a file appends chunks to the list;
+    // existing content is never copied.
+    static const size_t content_chunk_size = 16 * KB;
+    Vector<KBuffer> m_content_chunks;
     struct Child {
         FS::DirectoryEntry entry;
         NonnullRefPtr<TmpFSInode> inode;
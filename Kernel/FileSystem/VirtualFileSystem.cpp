@@ -42,6 +42,7 @@ namespace Kernel {
 
 static VFS* s_the;
 static constexpr int symlink_recursion_limit { 5 }; // FIXME: increase?
+static constexpr size_t directory_cache_entry_limit { 2048 };
 
 VFS& VFS::the()
 {
@@ -67,6 +68,32 @@ InodeIdentifier VFS::root_inode_id() const
     return m_root_inode->identifier();
 }
 
+String VFS::directory_cache_key(const Inode& parent, const StringView& name)
+{
+    StringBuilder builder;
+    builder.appendf("%u:%u:", parent.fsid(), parent.index());
+    builder.append(name);
+    return builder.to_string();
+}
+
+void VFS::cache_directory_entry(const Inode& parent, const StringView& name, RefPtr<Inode> child, int mount_flags)
+{
+    // Keep the cache bounded the simple way: once it fills up, start over.
+    if (m_directory_cache.size() >= directory_cache_entry_limit)
+        m_directory_cache.clear();
+    m_directory_cache.set(directory_cache_key(parent, name), { move(child), mount_flags });
+}
+
+void VFS::invalidate_directory_cache_entry(const Inode& parent, const StringView& name)
+{
+    m_directory_cache.remove(directory_cache_key(parent, name));
+}
+
+void VFS::clear_directory_cache()
+{
+    m_directory_cache.clear();
+}
+
 KResult VFS::mount(FS& file_system, Custody& mount_point, int flags)
 {
     auto& inode = mount_point.inode();
@@ -74,6 +101,7 @@ KResult VFS::mount(FS& file_system, Custody& mount_point, int flags)
     // FIXME: check that this is not already a mount point
     Mount mount { file_system, &mount_point, flags };
     m_mounts.append(move(mount));
+    clear_directory_cache();
     return KSuccess;
 }
 
@@ -83,6 +111,7 @@ KResult VFS::bind_mount(Custody& source, Custody& mount_point, int flags)
     // FIXME: check that this is not already a mount point
     Mount mount { source.inode(), mount_point, flags };
     m_mounts.append(move(mount));
+    clear_directory_cache();
     return KSuccess;
 }
 
@@ -91,6 +120,10 @@ KResult VFS::unmount(InodeIdentifier guest_inode_id)
     LOCKER(m_lock);
     dbg() << "VFS: unmount called with inode " << guest_inode_id;
 
+    // Drop any cached lookups first; they hold inode references that would
+    // otherwise make the guest filesystem look busy.
+    clear_directory_cache();
+
     for (size_t i = 0; i < m_mounts.size(); ++i) {
         auto& mount = m_mounts.at(i);
         if (mount.guest() == guest_inode_id) {
@@ -293,6 +326,7 @@ KResult VFS::mknod(StringView path, mode_t mode, dev_t dev, Custody& base)
 
     FileSystemPath p(path);
     dbg() << "VFS::mknod: '" << p.basename() << "' mode=" << mode << " dev=" << dev << " in " << parent_inode.identifier();
+    invalidate_directory_cache_entry(parent_inode, p.basename());
     return parent_inode.fs().create_inode(parent_inode.identifier(), p.basename(), mode, 0, dev, Process::current->uid(), Process::current->gid()).result();
 }
 
@@ -320,6 +354,7 @@ KResultOr<NonnullRefPtr<FileDescription>> VFS::create(StringView path, int optio
     if (inode_or_error.is_error())
         return inode_or_error.error();
 
+    invalidate_directory_cache_entry(parent_inode, p.basename());
     auto new_custody = Custody::create(&parent_custody, p.basename(), inode_or_error.value(), parent_custody.mount_flags());
     auto description = FileDescription::create(*new_custody);
     description->set_rw_mode(options);
@@ -353,6 +388,7 @@ KResult VFS::mkdir(StringView path, mode_t mode, Custody& base)
 #ifdef VFS_DEBUG
     dbg() << "VFS::mkdir: '" << p.basename() << "' in " << parent_inode.identifier();
 #endif
+    invalidate_directory_cache_entry(parent_inode, p.basename());
     return parent_inode.fs().create_directory(parent_inode.identifier(), p.basename(), mode, Process::current->uid(), Process::current->gid());
 }
 
@@ -468,11 +504,14 @@ KResult VFS::rename(StringView old_path, StringView new_path, Custody& base)
             return result;
     }
 
+    invalidate_directory_cache_entry(new_parent_inode, new_basename);
     auto result = new_parent_inode.add_child(old_inode.identifier(), new_basename, old_inode.mode());
     if (result.is_error())
         return result;
 
-    result = old_parent_inode.remove_child(FileSystemPath(old_path).basename());
+    auto old_basename = FileSystemPath(old_path).basename();
+    invalidate_directory_cache_entry(old_parent_inode, old_basename);
+    result = old_parent_inode.remove_child(old_basename);
     if (result.is_error())
         return result;
 
@@ -555,7 +594,9 @@ KResult VFS::link(StringView old_path, StringView new_path, Custody& base)
     if (old_inode.is_directory())
         return KResult(-EPERM);
 
-    return parent_inode.add_child(old_inode.identifier(), FileSystemPath(new_path).basename(), old_inode.mode());
+    auto new_basename = FileSystemPath(new_path).basename();
+    invalidate_directory_cache_entry(parent_inode, new_basename);
+    return parent_inode.add_child(old_inode.identifier(), new_basename, old_inode.mode());
 }
 
 KResult VFS::unlink(StringView path, Custody& base)
@@ -579,7 +620,9 @@ KResult VFS::unlink(StringView path, Custody& base)
             return KResult(-EACCES);
     }
 
-    auto result = parent_inode.remove_child(FileSystemPath(path).basename());
+    auto basename = FileSystemPath(path).basename();
+    invalidate_directory_cache_entry(parent_inode, basename);
+    auto result = parent_inode.remove_child(basename);
     if (result.is_error())
         return result;
 
@@ -602,6 +645,7 @@ KResult VFS::symlink(StringView target, StringView linkpath, Custody& base)
 
     FileSystemPath p(linkpath);
     dbg() << "VFS::symlink: '" << p.basename() << "' (-> '" << target << "') in " << parent_inode.identifier();
+    invalidate_directory_cache_entry(parent_inode, p.basename());
     auto inode_or_error = parent_inode.fs().create_inode(parent_inode.identifier(), p.basename(), 0120644, 0, 0, Process::current->uid(), Process::current->gid());
     if (inode_or_error.is_error())
         return inode_or_error.error();
@@ -649,7 +693,9 @@ KResult VFS::rmdir(StringView path, Custody& base)
     if (result.is_error())
         return result;
 
-    return parent_inode.remove_child(FileSystemPath(path).basename());
+    auto basename = FileSystemPath(path).basename();
+    invalidate_directory_cache_entry(parent_inode, basename);
+    return parent_inode.remove_child(basename);
 }
 
 RefPtr<Inode> VFS::get_inode(InodeIdentifier inode_id)
@@ -823,7 +869,29 @@ KResultOr<NonnullRefPtr<Custody>> VFS::resolve_path_without_veil(StringView path
         }
 
         // Okay, let's look up this part.
-        auto child_inode = parent.inode().lookup(part);
+        RefPtr<Inode> child_inode;
+        int mount_flags_for_child = parent.mount_flags();
+
+        auto cache_it = m_directory_cache.find(directory_cache_key(parent.inode(), part));
+        if (cache_it != m_directory_cache.end()) {
+            child_inode = cache_it->value.inode;
+            if (cache_it->value.mount_flags >= 0)
+                mount_flags_for_child = cache_it->value.mount_flags;
+        } else {
+            child_inode = parent.inode().lookup(part);
+            int cached_mount_flags = -1;
+            if (child_inode) {
+                // See if there's something mounted on the child; in that case
+                // we would need to return the guest inode, not the host inode.
+                if (auto mount = find_mount_for_host(child_inode->identifier())) {
+                    child_inode = get_inode(mount->guest());
+                    mount_flags_for_child = mount->flags();
+                    cached_mount_flags = mount->flags();
+                }
+            }
+            cache_directory_entry(parent.inode(), part, child_inode, cached_mount_flags);
+        }
+
         if (!child_inode) {
             if (out_parent) {
                 // ENOENT with a non-null parent custody signals to caller that
@@ -834,15 +902,6 @@ KResultOr<NonnullRefPtr<Custody>> VFS::resolve_path_without_veil(StringView path
             return KResult(-ENOENT);
         }
 
-        int mount_flags_for_child = parent.mount_flags();
-
-        // See if there's something mounted on the child; in that case
-        // we would need to return the guest inode, not the host inode.
-        if (auto mount = find_mount_for_host(child_inode->identifier())) {
-            child_inode = get_inode(mount->guest());
-            mount_flags_for_child = mount->flags();
-        }
-
         custody = Custody::create(&parent, part, *child_inode, mount_flags_for_child);
 
         if (child_inode->metadata().is_symlink()) {
@@ -154,10 +154,26 @@ private:
     Mount* find_mount_for_host(InodeIdentifier);
     Mount* find_mount_for_guest(InodeIdentifier);
 
+    // Cache of recent (parent inode, name) lookups, layered over the Custody
+    // tree so hot paths resolve without calling into the filesystem.
+    // A null inode records a negative entry (the name does not exist.)
+    // mount_flags is -1 unless the child is a mount point, in which case it
+    // holds the mount's flags.
+    struct DirectoryCacheEntry {
+        RefPtr<Inode> inode;
+        int mount_flags { -1 };
+    };
+
+    static String directory_cache_key(const Inode& parent, const StringView& name);
+    void cache_directory_entry(const Inode& parent, const StringView& name, RefPtr<Inode> child, int mount_flags);
+    void invalidate_directory_cache_entry(const Inode& parent, const StringView& name);
+    void clear_directory_cache();
+
     Lock m_lock { "VFSLock" };
 
     RefPtr<Inode> m_root_inode;
     Vector<Mount> m_mounts;
+    HashMap<String, DirectoryCacheEntry> m_directory_cache;
 
     RefPtr<Custody> m_root_custody;
 };
@@ -34,6 +34,15 @@
 
 namespace Kernel {
 
+// Until the scheduler runs on more than the BSP, everything allocates on
+// CPU 0. The magazine layout is already per-CPU so SMP bringup only needs
+// to make this return the real CPU index.
+static constexpr size_t max_slab_cpus = 8;
+static inline size_t current_slab_cpu()
+{
+    return 0;
+}
+
 template<size_t templated_slab_size>
 class SlabAllocator {
 public:
@@ -52,6 +61,8 @@ public:
         m_freelist = &slabs[slab_count - 1];
         m_num_allocated = 0;
         m_num_free = slab_count;
+        for (size_t cpu = 0; cpu < max_slab_cpus; ++cpu)
+            m_magazines[cpu].count = 0;
     }
 
     constexpr size_t slab_size() const { return templated_slab_size; }
@@ -59,11 +70,12 @@ public:
     void* alloc()
     {
         InterruptDisabler disabler;
-        if (!m_freelist)
+        auto& magazine = m_magazines[current_slab_cpu()];
+        if (magazine.count == 0)
+            refill_magazine(magazine);
+        if (magazine.count == 0)
             return kmalloc(slab_size());
-        ASSERT(m_freelist);
-        void* ptr = m_freelist;
-        m_freelist = m_freelist->next;
+        void* ptr = magazine.objects[--magazine.count];
         ++m_num_allocated;
         --m_num_free;
 #ifdef SANITIZE_SLABS
@@ -80,14 +92,16 @@ public:
             kfree(ptr);
             return;
         }
-        ((FreeSlab*)ptr)->next = m_freelist;
 #ifdef SANITIZE_SLABS
         if (slab_size() > sizeof(FreeSlab*))
             memset(((FreeSlab*)ptr)->padding, SLAB_DEALLOC_SCRUB_BYTE, sizeof(FreeSlab::padding));
 #endif
-        m_freelist = (FreeSlab*)ptr;
-        ++m_num_allocated;
-        --m_num_free;
+        auto& magazine = m_magazines[current_slab_cpu()];
+        if (magazine.count == magazine_capacity)
+            drain_magazine(magazine);
+        magazine.objects[magazine.count++] = ptr;
+        --m_num_allocated;
+        ++m_num_free;
     }
 
     size_t num_allocated() const { return m_num_allocated; }
@@ -99,8 +113,36 @@ private:
         char padding[templated_slab_size - sizeof(FreeSlab*)];
     };
 
+    static constexpr size_t magazine_capacity = 32;
+
+    // A CPU-local stash of free slabs. The hot alloc/dealloc path only ever
+    // touches its own CPU's magazine; the shared freelist is a depot that
+    // magazines refill from and drain to in batches.
+    struct Magazine {
+        void* objects[magazine_capacity];
+        size_t count;
+    };
+
+    void refill_magazine(Magazine& magazine)
+    {
+        while (magazine.count < magazine_capacity / 2 && m_freelist) {
+            magazine.objects[magazine.count++] = m_freelist;
+            m_freelist = m_freelist->next;
+        }
+    }
+
+    void drain_magazine(Magazine& magazine)
+    {
+        while (magazine.count > magazine_capacity / 2) {
+            auto* slab = (FreeSlab*)magazine.objects[--magazine.count];
+            slab->next = m_freelist;
+            m_freelist = slab;
+        }
+    }
+
     // NOTE: These are not default-initialized to prevent an init-time constructor from overwriting them
     FreeSlab* m_freelist;
+    Magazine m_magazines[max_slab_cpus];
     size_t m_num_allocated;
     size_t m_num_free;
     void* m_base;
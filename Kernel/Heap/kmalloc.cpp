@@ -56,6 +56,49 @@ struct AllocationHeader {
 
 static u8 alloc_map[POOL_SIZE / CHUNK_SIZE / 8];
 
+// Segregated free lists for small allocations. Freed blocks whose chunk count
+// matches a size class exactly are cached here (their chunks stay marked as
+// allocated in alloc_map) so the common small kmalloc() never has to scan the
+// bitmap at all.
+static const size_t size_class_chunk_counts[] = { 1, 2, 3, 4, 6, 8, 12, 16 };
+static const size_t size_class_count = sizeof(size_class_chunk_counts) / sizeof(size_class_chunk_counts[0]);
+
+struct FreeListEntry {
+    AllocationHeader header;
+    FreeListEntry* next;
+};
+
+static FreeListEntry* s_free_lists[size_class_count];
+
+static inline int size_class_for_chunk_count(size_t chunk_count)
+{
+    for (size_t i = 0; i < size_class_count; ++i) {
+        if (chunk_count <= size_class_chunk_counts[i])
+            return (int)i;
+    }
+    return -1;
+}
+
+// Give every cached free-list block back to the bitmap. The lists only ever
+// grow otherwise, so a heap full of cached small blocks could fail a large
+// allocation that would fit just fine; this is the escape hatch for that.
+static void drain_free_lists()
+{
+    Bitmap bitmap_wrapper = Bitmap::wrap(alloc_map, POOL_SIZE / CHUNK_SIZE);
+    for (size_t i = 0; i < size_class_count; ++i) {
+        for (auto* entry = s_free_lists[i]; entry;) {
+            auto* next = entry->next;
+            FlatPtr start = ((FlatPtr)entry - (FlatPtr)BASE_PHYSICAL) / CHUNK_SIZE;
+            bitmap_wrapper.set_range(start, size_class_chunk_counts[i], false);
+#ifdef SANITIZE_KMALLOC
+            memset(entry, KFREE_SCRUB_BYTE, size_class_chunk_counts[i] * CHUNK_SIZE);
+#endif
+            entry = next;
+        }
+        s_free_lists[i] = nullptr;
+    }
+}
+
 volatile size_t sum_alloc = 0;
 volatile size_t sum_free = POOL_SIZE;
 volatile size_t kmalloc_sum_eternal = 0;
@@ -71,6 +114,7 @@ void kmalloc_init()
 {
     memset(&alloc_map, 0, sizeof(alloc_map));
     memset((void*)BASE_PHYSICAL, 0, POOL_SIZE);
+    memset(s_free_lists, 0, sizeof(s_free_lists));
 
     kmalloc_sum_eternal = 0;
     sum_alloc = 0;
@@ -149,6 +193,23 @@ void* kmalloc_impl(size_t size)
 
     size_t chunks_needed = (real_size + CHUNK_SIZE - 1) / CHUNK_SIZE;
 
+    int size_class = size_class_for_chunk_count(chunks_needed);
+    if (size_class >= 0) {
+        // Round up to the class size so the block can serve anyone in the
+        // same class after it's been freed.
+        chunks_needed = size_class_chunk_counts[size_class];
+        if (auto* entry = s_free_lists[size_class]) {
+            s_free_lists[size_class] = entry->next;
+            entry->header.allocation_size_in_chunks = chunks_needed;
+            sum_alloc += chunks_needed * CHUNK_SIZE;
+            sum_free -= chunks_needed * CHUNK_SIZE;
+#ifdef SANITIZE_KMALLOC
+            memset(entry->header.data, KMALLOC_SCRUB_BYTE, (chunks_needed * CHUNK_SIZE) - sizeof(AllocationHeader));
+#endif
+            return entry->header.data;
+        }
+    }
+
     Bitmap bitmap_wrapper = Bitmap::wrap(alloc_map, POOL_SIZE / CHUNK_SIZE);
     Optional<size_t> first_chunk;
 
@@ -160,6 +221,17 @@ void* kmalloc_impl(size_t size)
         first_chunk = bitmap_wrapper.find_best_fit(chunks_needed);
     }
 
+    if (!first_chunk.has_value()) {
+        // The bitmap may be fragmented by cached free-list blocks whose
+        // chunks are still marked as allocated. Give them all back and
+        // retry before declaring OOM.
+        drain_free_lists();
+        if (chunks_needed < best_fit_threshold)
+            first_chunk = bitmap_wrapper.find_first_fit(chunks_needed);
+        else
+            first_chunk = bitmap_wrapper.find_best_fit(chunks_needed);
+    }
+
     if (!first_chunk.has_value()) {
         klog() << "kmalloc(): PANIC! Out of memory (no suitable block for size " << size << ")";
         Kernel::dump_backtrace();
@@ -178,16 +250,31 @@ void kfree(void* ptr)
     ++g_kfree_call_count;
 
     auto* a = (AllocationHeader*)((((u8*)ptr) - sizeof(AllocationHeader)));
+    size_t allocation_size_in_chunks = a->allocation_size_in_chunks;
+
+    sum_alloc -= allocation_size_in_chunks * CHUNK_SIZE;
+    sum_free += allocation_size_in_chunks * CHUNK_SIZE;
+
+    int size_class = size_class_for_chunk_count(allocation_size_in_chunks);
+    if (size_class >= 0 && allocation_size_in_chunks == size_class_chunk_counts[size_class]) {
+        // Cache the block on its size-class free list instead of giving the
+        // chunks back to the bitmap.
+#ifdef SANITIZE_KMALLOC
+        memset(a->data, KFREE_SCRUB_BYTE, (allocation_size_in_chunks * CHUNK_SIZE) - sizeof(AllocationHeader));
+#endif
+        auto* entry = (FreeListEntry*)a;
+        entry->next = s_free_lists[size_class];
+        s_free_lists[size_class] = entry;
+        return;
+    }
+
     FlatPtr start = ((FlatPtr)a - (FlatPtr)BASE_PHYSICAL) / CHUNK_SIZE;
 
     Bitmap bitmap_wrapper = Bitmap::wrap(alloc_map, POOL_SIZE / CHUNK_SIZE);
-    bitmap_wrapper.set_range(start, a->allocation_size_in_chunks, false);
-
-    sum_alloc -= a->allocation_size_in_chunks * CHUNK_SIZE;
-    sum_free += a->allocation_size_in_chunks * CHUNK_SIZE;
+    bitmap_wrapper.set_range(start, allocation_size_in_chunks, false);
 
 #ifdef SANITIZE_KMALLOC
-    memset(a, KFREE_SCRUB_BYTE, a->allocation_size_in_chunks * CHUNK_SIZE);
+    memset(a, KFREE_SCRUB_BYTE, allocation_size_in_chunks * CHUNK_SIZE);
 #endif
 }
 
@@ -31,50 +31,64 @@
 
 namespace Kernel {
 
-inline bool KBufferBuilder::can_append(size_t size) const
+void KBufferBuilder::add_chunk()
 {
-    bool has_space = ((m_size + size) < m_buffer.size());
-    ASSERT(has_space);
-    return has_space;
+    m_chunks.append(KBuffer::create_with_size(chunk_size, Region::Access::Read | Region::Access::Write, "KBufferBuilder chunk"));
+    m_insertion_ptr = m_chunks.last().data();
+    m_remaining_space_in_current_chunk = chunk_size;
 }
 
 KBuffer KBufferBuilder::build()
 {
-    m_buffer.set_size(m_size);
-    return m_buffer;
+    // If everything fit in the first chunk, hand it out as-is.
+    if (m_chunks.size() == 1) {
+        auto buffer = m_chunks.take_last();
+        buffer.set_size(m_size);
+        return buffer;
+    }
+    auto buffer = KBuffer::create_with_size(m_size, Region::Access::Read | Region::Access::Write);
+    size_t nwritten = 0;
+    for (auto& chunk : m_chunks) {
+        size_t bytes_in_chunk = min(m_size - nwritten, chunk_size);
+        memcpy(buffer.data() + nwritten, chunk.data(), bytes_in_chunk);
+        nwritten += bytes_in_chunk;
+    }
+    buffer.set_size(m_size);
+    return buffer;
 }
 
 KBufferBuilder::KBufferBuilder()
-    : m_buffer(KBuffer::create_with_size(4 * MB, Region::Access::Read | Region::Access::Write))
 {
+    add_chunk();
+}
+
+void KBufferBuilder::append_bytes(const u8* data, size_t size)
+{
+    while (size) {
+        if (!m_remaining_space_in_current_chunk)
+            add_chunk();
+        size_t bytes_to_copy = min(size, m_remaining_space_in_current_chunk);
+        memcpy(m_insertion_ptr, data, bytes_to_copy);
+        m_insertion_ptr += bytes_to_copy;
+        m_remaining_space_in_current_chunk -= bytes_to_copy;
+        m_size += bytes_to_copy;
+        data += bytes_to_copy;
+        size -= bytes_to_copy;
+    }
 }
 
 void KBufferBuilder::append(const StringView& str)
 {
     if (str.is_empty())
         return;
-    if (!can_append(str.length()))
-        return;
-    memcpy(insertion_ptr(), str.characters_without_null_termination(), str.length());
-    m_size += str.length();
+    append_bytes((const u8*)str.characters_without_null_termination(), str.length());
 }
 
 void KBufferBuilder::append(const char* characters, int length)
 {
     if (!length)
         return;
-    if (!can_append(length))
-        return;
-    memcpy(insertion_ptr() + m_size, characters, length);
-    m_size += length;
-}
-
-void KBufferBuilder::append(char ch)
-{
-    if (!can_append(1))
-        return;
-    insertion_ptr()[0] = ch;
-    m_size += 1;
+    append_bytes((const u8*)characters, length);
 }
 
 void KBufferBuilder::appendvf(const char* fmt, va_list ap)
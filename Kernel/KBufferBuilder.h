@@ -27,11 +27,15 @@
 #pragma once
 
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <Kernel/KBuffer.h>
 #include <stdarg.h>
 
 namespace Kernel {
 
+// KBufferBuilder appends into a chain of fixed-size chunks and only
+// linearizes the result in build(), so growing a large document never
+// copies what's already been written.
 class KBufferBuilder {
 public:
     using OutputType = KBuffer;
@@ -40,18 +44,31 @@ public:
     ~KBufferBuilder() {}
 
     void append(const StringView&);
-    void append(char);
     void append(const char*, int);
     void appendf(const char*, ...);
     void appendvf(const char*, va_list);
 
+    // Kept inline as the fast path for appendf(), which emits one character at a time.
+    void append(char ch)
+    {
+        if (!m_remaining_space_in_current_chunk)
+            add_chunk();
+        *m_insertion_ptr++ = ch;
+        --m_remaining_space_in_current_chunk;
+        ++m_size;
+    }
+
     KBuffer build();
 
 private:
-    bool can_append(size_t) const;
-    u8* insertion_ptr() { return m_buffer.data() + m_size; }
+    void add_chunk();
+    void append_bytes(const u8*, size_t);
+
+    static const size_t chunk_size = 64 * KB;
 
-    KBuffer m_buffer;
+    Vector<KBuffer> m_chunks;
+    u8* m_insertion_ptr { nullptr };
+    size_t m_remaining_space_in_current_chunk { 0 };
     size_t m_size { 0 };
 };
 
@@ -62,11 +62,21 @@ const KernelSymbol* symbolicate_kernel_address(u32 address)
 {
     if (address < g_lowest_kernel_symbol_address || address > g_highest_kernel_symbol_address)
         return nullptr;
-    for (unsigned i = 0; i < s_symbol_count; ++i) {
-        if (address < s_symbols[i + 1].address)
-            return &s_symbols[i];
+    // The map file is sorted by address, so binary search for the last
+    // symbol at or before the address. Backtraces symbolicate every frame
+    // and the profiler every sample, so this gets called a lot.
+    size_t low = 0;
+    size_t high = s_symbol_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (s_symbols[middle].address <= address)
+            low = middle + 1;
+        else
+            high = middle;
     }
-    return nullptr;
+    if (!low)
+        return nullptr;
+    return &s_symbols[low - 1];
 }
 
 static void load_kernel_sybols_from_data(const ByteBuffer& buffer)
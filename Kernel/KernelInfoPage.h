@@ -32,9 +32,11 @@
 #    include <Kernel/UnixTypes.h>
 #else
 #    include <sys/time.h>
+#    include <time.h>
 #endif
 
 struct KernelInfoPage {
     volatile u32 serial;
     volatile struct timeval now;
+    volatile struct timespec monotonic_now;
 };
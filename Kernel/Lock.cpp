@@ -30,6 +30,14 @@
 
 namespace Kernel {
 
+Lock::List& Lock::all_locks()
+{
+    static List* s_list;
+    if (!s_list)
+        s_list = new List;
+    return *s_list;
+}
+
 static bool modes_conflict(Lock::Mode mode1, Lock::Mode mode2)
 {
     if (mode1 == Lock::Mode::Unlocked || mode2 == Lock::Mode::Unlocked)
@@ -50,6 +58,13 @@ void Lock::lock(Mode mode)
         dump_backtrace();
         hang();
     }
+    // Before going through a full wait-queue round trip, donate the rest of
+    // our time slice to the holder a few times and retry. Most critical
+    // sections are short, so the lock is usually free again by the time we
+    // get to run.
+    static const u32 max_spin_attempts = 3;
+    u32 spin_attempts = 0;
+
     for (;;) {
         bool expected = false;
         if (m_lock.compare_exchange_strong(expected, true, AK::memory_order_acq_rel)) {
@@ -62,9 +77,22 @@ void Lock::lock(Mode mode)
                     m_mode = mode;
                 m_holder = Thread::current;
                 m_times_locked++;
+                ++m_times_acquired;
                 m_lock.store(false, AK::memory_order_release);
                 return;
             }
+            if (spin_attempts == 0)
+                ++m_times_contended;
+            if (spin_attempts < max_spin_attempts) {
+                ++spin_attempts;
+                Thread* holder = m_holder;
+                m_lock.store(false, AK::memory_order_release);
+                if (holder)
+                    Scheduler::donate_to(holder, m_name);
+                else
+                    Scheduler::yield();
+                continue;
+            }
             timeval* timeout = nullptr;
             Thread::current->wait_on(m_queue, timeout, &m_lock, m_holder, m_name);
         }
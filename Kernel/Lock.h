@@ -28,6 +28,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/Atomic.h>
+#include <AK/IntrusiveList.h>
 #include <AK/Types.h>
 #include <Kernel/Arch/i386/CPU.h>
 #include <Kernel/Forward.h>
@@ -40,8 +41,15 @@ public:
     Lock(const char* name = nullptr)
         : m_name(name)
     {
+        InterruptDisabler disabler;
+        all_locks().append(*this);
+    }
+    ~Lock()
+    {
+        InterruptDisabler disabler;
+        if (m_list_node.is_in_list())
+            m_list_node.remove();
     }
-    ~Lock() { }
 
     enum class Mode {
         Unlocked,
@@ -57,12 +65,28 @@ public:
 
     const char* name() const { return m_name; }
 
+    u64 times_acquired() const { return m_times_acquired; }
+    u64 times_contended() const { return m_times_contended; }
+
+    template<typename Callback>
+    static void for_each(Callback);
+
 private:
+    IntrusiveListNode m_list_node;
+
+    typedef IntrusiveList<Lock, &Lock::m_list_node> List;
+    static List& all_locks();
+
     Atomic<bool> m_lock { false };
     const char* m_name { nullptr };
     WaitQueue m_queue;
     Mode m_mode { Mode::Unlocked };
 
+    // Cumulative acquisition count, and how many of those acquisitions had
+    // to wait for another holder first. Surfaced in /proc/locks.
+    u64 m_times_acquired { 0 };
+    u64 m_times_contended { 0 };
+
     // When locked exclusively, only the thread already holding the lock can
     // lock it again. When locked in shared mode, any thread can do that.
     u32 m_times_locked { 0 };
@@ -75,6 +99,14 @@ private:
     Thread* m_holder { nullptr };
 };
 
+template<typename Callback>
+inline void Lock::for_each(Callback callback)
+{
+    InterruptDisabler disabler;
+    for (auto& lock : all_locks())
+        callback(lock);
+}
+
 class Locker {
 public:
     ALWAYS_INLINE explicit Locker(Lock& l, Lock::Mode mode = Lock::Mode::Exclusive)
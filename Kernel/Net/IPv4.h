@@ -126,19 +126,41 @@ private:
 static_assert(sizeof(IPv4Packet) == 20);
 const LogStream& operator<<(const LogStream& stream, const IPv4Packet& packet);
 
-inline NetworkOrdered<u16> internet_checksum(const void* ptr, size_t count)
+// Ones'-complement accumulation for the internet checksum (RFC 1071).
+// We add native-endian words into a 64-bit counter and only fold and
+// byte-swap once in internet_checksum_finish(): the ones'-complement sum
+// of byte-swapped data is the byte-swap of the sum, so no per-word
+// conversion or overflow check is needed.
+inline u64 internet_checksum_partial(u64 checksum, const void* ptr, size_t count)
 {
-    u32 checksum = 0;
-    auto* w = (const u16*)ptr;
-    while (count > 1) {
-        checksum += convert_between_host_and_network(*w++);
-        if (checksum & 0x80000000)
-            checksum = (checksum & 0xffff) | (checksum >> 16);
+    auto* data = (const u8*)ptr;
+    while (count >= 4) {
+        checksum += *(const u32*)data;
+        data += 4;
+        count -= 4;
+    }
+    if (count >= 2) {
+        checksum += *(const u16*)data;
+        data += 2;
         count -= 2;
     }
-    while (checksum >> 16)
-        checksum = (checksum & 0xffff) + (checksum >> 16);
-    return ~checksum & 0xffff;
+    if (count)
+        checksum += *data;
+    return checksum;
+}
+
+inline NetworkOrdered<u16> internet_checksum_finish(u64 checksum)
+{
+    checksum = (checksum & 0xffffffff) + (checksum >> 32);
+    checksum = (checksum & 0xffff) + (checksum >> 16);
+    checksum = (checksum & 0xffff) + (checksum >> 16);
+    checksum = (checksum & 0xffff) + (checksum >> 16);
+    return convert_between_host_and_network((u16)(~checksum & 0xffff));
+}
+
+inline NetworkOrdered<u16> internet_checksum(const void* ptr, size_t count)
+{
+    return internet_checksum_finish(internet_checksum_partial(0, ptr, count));
 }
 
 }
@@ -210,7 +210,7 @@ ssize_t IPv4Socket::sendto(FileDescription&, const void* data, size_t data_lengt
         m_peer_port = ntohs(ia.sin_port);
     }
 
-    auto routing_decision = route_to(m_peer_address, m_local_address, bound_interface());
+    auto routing_decision = cached_route_to(m_peer_address, m_local_address);
     if (routing_decision.is_zero())
         return -EHOSTUNREACH;
 
@@ -283,9 +283,10 @@ ssize_t IPv4Socket::receive_packet_buffered(FileDescription& description, void*
 
         if (!m_receive_queue.is_empty()) {
             packet = m_receive_queue.take_first();
+            m_receive_queue_bytes -= packet.data.value().size();
             m_can_read = !m_receive_queue.is_empty();
 #ifdef IPV4_SOCKET_DEBUG
-            dbg() << "IPv4Socket(" << this << "): recvfrom without blocking " << packet.data.value().size() << " bytes, packets in queue: " << m_receive_queue.size_slow();
+            dbg() << "IPv4Socket(" << this << "): recvfrom without blocking " << packet.data.value().size() << " bytes, bytes in queue: " << m_receive_queue_bytes;
 #endif
         }
     }
@@ -309,9 +310,10 @@ ssize_t IPv4Socket::receive_packet_buffered(FileDescription& description, void*
         ASSERT(m_can_read);
         ASSERT(!m_receive_queue.is_empty());
         packet = m_receive_queue.take_first();
+        m_receive_queue_bytes -= packet.data.value().size();
         m_can_read = !m_receive_queue.is_empty();
 #ifdef IPV4_SOCKET_DEBUG
-        dbg() << "IPv4Socket(" << this << "): recvfrom with blocking " << packet.data.value().size() << " bytes, packets in queue: " << m_receive_queue.size_slow();
+        dbg() << "IPv4Socket(" << this << "): recvfrom with blocking " << packet.data.value().size() << " bytes, bytes in queue: " << m_receive_queue_bytes;
 #endif
     }
     ASSERT(packet.data.has_value());
@@ -358,6 +360,22 @@ ssize_t IPv4Socket::recvfrom(FileDescription& description, void* buffer, size_t
     return nreceived;
 }
 
+RoutingDecision IPv4Socket::cached_route_to(const IPv4Address& target, const IPv4Address& source)
+{
+    if (!m_cached_routing_decision.is_zero()
+        && m_cached_routing_target == target
+        && m_cached_routing_generation == routing_table_generation()) {
+        return m_cached_routing_decision;
+    }
+    auto routing_decision = route_to(target, source, bound_interface());
+    if (!routing_decision.is_zero()) {
+        m_cached_routing_decision = routing_decision;
+        m_cached_routing_target = target;
+        m_cached_routing_generation = routing_table_generation();
+    }
+    return routing_decision;
+}
+
 bool IPv4Socket::did_receive(const IPv4Address& source_address, u16 source_port, KBuffer&& packet)
 {
     LOCKER(lock());
@@ -378,12 +396,12 @@ bool IPv4Socket::did_receive(const IPv4Address& source_address, u16 source_port,
         m_receive_buffer.write(m_scratch_buffer.value().data(), nreceived);
         m_can_read = !m_receive_buffer.is_empty();
     } else {
-        // FIXME: Maybe track the number of packets so we don't have to walk the entire packet queue to count them..
-        if (m_receive_queue.size_slow() > 2000) {
+        if (m_receive_queue_bytes + packet_size > maximum_receive_queue_bytes) {
             dbg() << "IPv4Socket(" << this << "): did_receive refusing packet since queue is full.";
             return false;
         }
         m_receive_queue.append({ source_address, source_port, move(packet) });
+        m_receive_queue_bytes += packet_size;
         m_can_read = true;
     }
     m_bytes_received += packet_size;
@@ -391,7 +409,7 @@ bool IPv4Socket::did_receive(const IPv4Address& source_address, u16 source_port,
     if (buffer_mode() == BufferMode::Bytes)
         dbg() << "IPv4Socket(" << this << "): did_receive " << packet_size << " bytes, total_received=" << m_bytes_received;
     else
-        dbg() << "IPv4Socket(" << this << "): did_receive " << packet_size << " bytes, total_received=" << m_bytes_received << ", packets in queue: " << m_receive_queue.size_slow();
+        dbg() << "IPv4Socket(" << this << "): did_receive " << packet_size << " bytes, total_received=" << m_bytes_received << ", bytes in queue: " << m_receive_queue_bytes;
 #endif
     return true;
 }
@@ -33,6 +33,7 @@
 #include <Kernel/Lock.h>
 #include <Kernel/Net/IPv4.h>
 #include <Kernel/Net/IPv4SocketTuple.h>
+#include <Kernel/Net/Routing.h>
 #include <Kernel/Net/Socket.h>
 
 namespace Kernel {
@@ -107,6 +108,10 @@ protected:
     void set_local_address(IPv4Address address) { m_local_address = address; }
     void set_peer_address(IPv4Address address) { m_peer_address = address; }
 
+    // route_to() with a per-socket cache, so steady-state transmission to an
+    // unchanged target skips the adapter and ARP table walks.
+    RoutingDecision cached_route_to(const IPv4Address& target, const IPv4Address& source);
+
 private:
     virtual bool is_ipv4() const override { return true; }
 
@@ -123,9 +128,17 @@ private:
     };
 
     SinglyLinkedList<ReceivedPacket> m_receive_queue;
+    // Backlog is limited by queued bytes rather than packet count, so a burst
+    // of tiny datagrams doesn't get dropped long before memory is a concern.
+    static const size_t maximum_receive_queue_bytes = 512 * KB;
+    size_t m_receive_queue_bytes { 0 };
 
     DoubleBuffer m_receive_buffer;
 
+    RoutingDecision m_cached_routing_decision { nullptr, {} };
+    IPv4Address m_cached_routing_target;
+    u32 m_cached_routing_generation { 0 };
+
     u16 m_local_port { 0 };
     u16 m_peer_port { 0 };
 
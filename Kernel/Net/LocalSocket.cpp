@@ -32,11 +32,15 @@
 #include <Kernel/UnixTypes.h>
 #include <LibBareMetal/StdLib.h>
 #include <LibC/errno_numbers.h>
+#include <LibC/sys/ioctl_numbers.h>
 
 //#define DEBUG_LOCAL_SOCKET
 
 namespace Kernel {
 
+static const size_t minimum_stream_buffer_size = 4 * KB;
+static const size_t maximum_stream_buffer_size = 4 * MB;
+
 Lockable<InlineLinkedList<LocalSocket>>& LocalSocket::all_sockets()
 {
     static Lockable<InlineLinkedList<LocalSocket>>* s_list;
@@ -312,6 +316,22 @@ ssize_t LocalSocket::recvfrom(FileDescription& description, void* buffer, size_t
     return nread;
 }
 
+int LocalSocket::ioctl(FileDescription& description, unsigned request, unsigned arg)
+{
+    switch (request) {
+    case FIONREAD: {
+        // Lets userspace size a single recvfrom() to drain everything the
+        // socket has buffered, instead of reading in fixed-size chunks.
+        auto* out = (int*)arg;
+        if (!Process::current->validate_write_typed(out))
+            return -EFAULT;
+        *out = receive_buffer_for(description).immediately_readable();
+        return 0;
+    }
+    }
+    return -EINVAL;
+}
+
 StringView LocalSocket::socket_path() const
 {
     size_t len = strnlen(m_address.sun_path, sizeof(m_address.sun_path));
@@ -344,6 +364,34 @@ String LocalSocket::absolute_path(const FileDescription& description) const
     return builder.to_string();
 }
 
+KResult LocalSocket::setsockopt(int level, int option, const void* value, socklen_t value_size)
+{
+    if (level != SOL_SOCKET)
+        return Socket::setsockopt(level, option, value, value_size);
+
+    switch (option) {
+    case SO_SNDBUF:
+    case SO_RCVBUF: {
+        if (value_size != sizeof(int))
+            return KResult(-EINVAL);
+        int requested_size = *(const int*)value;
+        if (requested_size < (int)minimum_stream_buffer_size || requested_size > (int)maximum_stream_buffer_size)
+            return KResult(-EINVAL);
+        // There's no FileDescription here to tell us which direction is
+        // "send" for the caller, and peers that stream large payloads tend
+        // to want headroom both ways, so both internal buffers get resized.
+        // This only works while the buffers are empty, i.e. right after
+        // socket creation and before traffic starts flowing.
+        auto result = m_for_client.set_capacity(requested_size);
+        if (result.is_error())
+            return result;
+        return m_for_server.set_capacity(requested_size);
+    }
+    default:
+        return Socket::setsockopt(level, option, value, value_size);
+    }
+}
+
 KResult LocalSocket::getsockopt(FileDescription& description, int level, int option, void* value, socklen_t* value_size)
 {
     if (level != SOL_SOCKET)
@@ -370,6 +418,15 @@ KResult LocalSocket::getsockopt(FileDescription& description, int level, int opt
         }
         break;
     }
+    case SO_SNDBUF:
+    case SO_RCVBUF:
+        // Both directions are kept at the same capacity, so we don't need to
+        // resolve the description to a role here.
+        if (*value_size < (socklen_t)sizeof(int))
+            return KResult(-EINVAL);
+        *(int*)value = (int)m_for_server.capacity();
+        *value_size = sizeof(int);
+        return KSuccess;
     default:
         return Socket::getsockopt(description, level, option, value, value_size);
     }
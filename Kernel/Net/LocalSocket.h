@@ -59,6 +59,8 @@ public:
     virtual bool can_write(const FileDescription&, size_t) const override;
     virtual ssize_t sendto(FileDescription&, const void*, size_t, int, const sockaddr*, socklen_t) override;
     virtual ssize_t recvfrom(FileDescription&, void*, size_t, int flags, sockaddr*, socklen_t*) override;
+    virtual int ioctl(FileDescription&, unsigned request, unsigned arg) override;
+    virtual KResult setsockopt(int level, int option, const void*, socklen_t) override;
     virtual KResult getsockopt(FileDescription&, int level, int option, void*, socklen_t*) override;
     virtual KResult chown(uid_t, gid_t) override;
     virtual KResult chmod(mode_t) override;
@@ -32,6 +32,7 @@
 #include <Kernel/Net/EthernetFrameHeader.h>
 #include <Kernel/Net/LoopbackAdapter.h>
 #include <Kernel/Net/NetworkAdapter.h>
+#include <Kernel/Net/Routing.h>
 #include <Kernel/Random.h>
 #include <LibBareMetal/StdLib.h>
 
@@ -195,35 +196,39 @@ void NetworkAdapter::did_receive(const u8* data, size_t length)
         on_receive();
 }
 
-size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size)
+Optional<KBuffer> NetworkAdapter::dequeue_packet()
 {
     InterruptDisabler disabler;
     if (m_packet_queue.is_empty())
-        return 0;
-    auto packet = m_packet_queue.take_first();
-    size_t packet_size = packet.size();
-    ASSERT(packet_size <= buffer_size);
-    memcpy(buffer, packet.data(), packet_size);
+        return {};
+    return m_packet_queue.take_first();
+}
+
+void NetworkAdapter::release_packet_buffer(KBuffer&& buffer)
+{
+    InterruptDisabler disabler;
     if (m_unused_packet_buffers_count < 100) {
-        m_unused_packet_buffers.append(packet);
+        m_unused_packet_buffers.append(move(buffer));
         ++m_unused_packet_buffers_count;
     }
-    return packet_size;
 }
 
 void NetworkAdapter::set_ipv4_address(const IPv4Address& address)
 {
     m_ipv4_address = address;
+    bump_routing_table_generation();
 }
 
 void NetworkAdapter::set_ipv4_netmask(const IPv4Address& netmask)
 {
     m_ipv4_netmask = netmask;
+    bump_routing_table_generation();
 }
 
 void NetworkAdapter::set_ipv4_gateway(const IPv4Address& gateway)
 {
     m_ipv4_gateway = gateway;
+    bump_routing_table_generation();
 }
 
 void NetworkAdapter::set_interface_name(const StringView& basename)
@@ -29,6 +29,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Function.h>
 #include <AK/MACAddress.h>
+#include <AK/Optional.h>
 #include <AK/SinglyLinkedList.h>
 #include <AK/Types.h>
 #include <AK/WeakPtr.h>
@@ -66,7 +67,10 @@ public:
     void send_ipv4(const MACAddress&, const IPv4Address&, IPv4Protocol, const u8* payload, size_t payload_size, u8 ttl);
     void send_ipv4_fragmented(const MACAddress&, const IPv4Address&, IPv4Protocol, const u8* payload, size_t payload_size, u8 ttl);
 
-    size_t dequeue_packet(u8* buffer, size_t buffer_size);
+    // Loans the queued packet's buffer to the caller instead of copying it out.
+    // Hand it back with release_packet_buffer() when done so it can be reused.
+    Optional<KBuffer> dequeue_packet();
+    void release_packet_buffer(KBuffer&&);
 
     bool has_queued_packets() const { return !m_packet_queue.is_empty(); }
 
@@ -51,6 +51,7 @@
 
 namespace Kernel {
 
+static void process_packet(const u8* buffer, size_t packet_size);
 static void handle_arp(const EthernetFrameHeader&, size_t frame_size);
 static void handle_ipv4(const EthernetFrameHeader&, size_t frame_size);
 static void handle_icmp(const EthernetFrameHeader&, const IPv4Packet&);
@@ -89,76 +90,79 @@ void NetworkTask_main()
         };
     });
 
-    auto dequeue_packet = [&pending_packets](u8* buffer, size_t buffer_size) -> size_t {
-        if (pending_packets == 0)
-            return 0;
-        size_t packet_size = 0;
-        NetworkAdapter::for_each([&](auto& adapter) {
-            if (packet_size || !adapter.has_queued_packets())
-                return;
-            packet_size = adapter.dequeue_packet(buffer, buffer_size);
-            pending_packets--;
-#ifdef NETWORK_TASK_DEBUG
-            klog() << "NetworkTask: Dequeued packet from " << adapter.name().characters() << " (" << packet_size << " bytes)";
-#endif
-        });
-        return packet_size;
-    };
-
-    size_t buffer_size = 64 * KB;
-    auto buffer_region = MM.allocate_kernel_region(buffer_size, "Kernel Packet Buffer", Region::Access::Read | Region::Access::Write, false, true);
-    auto buffer = (u8*)buffer_region->vaddr().get();
+    // How many packets we'll drain from a single adapter before giving the
+    // other adapters a turn. Without batching we'd re-scan the adapter list
+    // (and bounce in and out of the wait queue) for every single packet.
+    static const int max_packets_per_batch = 64;
 
     klog() << "NetworkTask: Enter main loop.";
     for (;;) {
-        size_t packet_size = dequeue_packet(buffer, buffer_size);
-        if (!packet_size) {
+        if (pending_packets == 0) {
             Thread::current->wait_on(packet_wait_queue);
             continue;
         }
-        if (packet_size < sizeof(EthernetFrameHeader)) {
-            klog() << "NetworkTask: Packet is too small to be an Ethernet packet! (" << packet_size << ")";
-            continue;
-        }
-        auto& eth = *(const EthernetFrameHeader*)buffer;
-#ifdef ETHERNET_DEBUG
-        klog() << "NetworkTask: From " << eth.source().to_string().characters() << " to " << eth.destination().to_string().characters() << ", ether_type=" << String::format("%w", eth.ether_type()) << ", packet_length=" << packet_size;
+        NetworkAdapter::for_each([&](auto& adapter) {
+            int packets_from_this_adapter = 0;
+            while (adapter.has_queued_packets() && packets_from_this_adapter < max_packets_per_batch) {
+                auto packet = adapter.dequeue_packet();
+                if (!packet.has_value())
+                    break;
+                pending_packets--;
+                packets_from_this_adapter++;
+#ifdef NETWORK_TASK_DEBUG
+                klog() << "NetworkTask: Dequeued packet from " << adapter.name().characters() << " (" << packet.value().size() << " bytes)";
 #endif
-
-#ifdef ETHERNET_VERY_DEBUG
-        for (size_t i = 0; i < packet_size; i++) {
-            klog() << String::format("%b", buffer[i]);
-
-            switch (i % 16) {
-            case 7:
-                klog() << "  ";
-                break;
-            case 15:
-                klog() << "";
-                break;
-            default:
-                klog() << " ";
-                break;
+                process_packet(packet.value().data(), packet.value().size());
+                adapter.release_packet_buffer(move(packet.value()));
             }
-        }
+        });
+    }
+}
 
-        klog() << "";
+void process_packet(const u8* buffer, size_t packet_size)
+{
+    if (packet_size < sizeof(EthernetFrameHeader)) {
+        klog() << "NetworkTask: Packet is too small to be an Ethernet packet! (" << packet_size << ")";
+        return;
+    }
+    auto& eth = *(const EthernetFrameHeader*)buffer;
+#ifdef ETHERNET_DEBUG
+    klog() << "NetworkTask: From " << eth.source().to_string().characters() << " to " << eth.destination().to_string().characters() << ", ether_type=" << String::format("%w", eth.ether_type()) << ", packet_length=" << packet_size;
 #endif
 
-        switch (eth.ether_type()) {
-        case EtherType::ARP:
-            handle_arp(eth, packet_size);
-            break;
-        case EtherType::IPv4:
-            handle_ipv4(eth, packet_size);
+#ifdef ETHERNET_VERY_DEBUG
+    for (size_t i = 0; i < packet_size; i++) {
+        klog() << String::format("%b", buffer[i]);
+
+        switch (i % 16) {
+        case 7:
+            klog() << "  ";
             break;
-        case EtherType::IPv6:
-            // ignore
+        case 15:
+            klog() << "";
             break;
         default:
-            klog() << "NetworkTask: Unknown ethernet type 0x" << String::format("%x", eth.ether_type());
+            klog() << " ";
+            break;
         }
     }
+
+    klog() << "";
+#endif
+
+    switch (eth.ether_type()) {
+    case EtherType::ARP:
+        handle_arp(eth, packet_size);
+        break;
+    case EtherType::IPv4:
+        handle_ipv4(eth, packet_size);
+        break;
+    case EtherType::IPv6:
+        // ignore
+        break;
+    default:
+        klog() << "NetworkTask: Unknown ethernet type 0x" << String::format("%x", eth.ether_type());
+    }
 }
 
 void handle_arp(const EthernetFrameHeader& eth, size_t frame_size)
@@ -188,6 +192,7 @@ void handle_arp(const EthernetFrameHeader& eth, size_t frame_size)
         // FIXME: Support static ARP table entries.
         LOCKER(arp_table().lock());
         arp_table().resource().set(packet.sender_protocol_address(), packet.sender_hardware_address());
+        bump_routing_table_generation();
 
         klog() << "ARP table (" << arp_table().resource().size() << " entries):";
         for (auto& it : arp_table().resource()) {
@@ -205,6 +205,7 @@ void RTL8139NetworkAdapter::handle_irq(const RegisterState&)
 #ifdef RTL8139_DEBUG
             klog() << "RTL8139NetworkAdapter: tx complete";
 #endif
+            flush_tx_queue();
         }
         if (status & INT_TXERR) {
             klog() << "RTL8139NetworkAdapter: tx error - resetting device";
@@ -278,6 +279,10 @@ void RTL8139NetworkAdapter::reset()
     // choose irqs, then clear any pending
     out16(REG_IMR, INT_RXOK | INT_RXERR | INT_TXOK | INT_TXERR | INT_RX_BUFFER_OVERFLOW | INT_LINK_CHANGE | INT_RX_FIFO_OVERFLOW | INT_LENGTH_CHANGE | INT_SYSTEM_ERROR);
     out16(REG_ISR, 0xffff);
+
+    // the reset freed all four descriptors, so anything that queued up
+    // behind them can go out right away
+    flush_tx_queue();
 }
 
 void RTL8139NetworkAdapter::read_mac_address()
@@ -299,6 +304,24 @@ void RTL8139NetworkAdapter::send_raw(const u8* data, size_t length)
         return;
     }
 
+    InterruptDisabler disabler;
+
+    // Keep ordering: if packets are already waiting for a descriptor, this
+    // one has to go behind them rather than grabbing a freed slot first.
+    if (m_tx_queue.is_empty() && start_transmit(data, length))
+        return;
+
+    static const size_t maximum_tx_queue_size = 64;
+    if (m_tx_queue_size >= maximum_tx_queue_size) {
+        klog() << "RTL8139NetworkAdapter: tx queue full; discarding packet";
+        return;
+    }
+    m_tx_queue.append(KBuffer::copy(data, length));
+    ++m_tx_queue_size;
+}
+
+bool RTL8139NetworkAdapter::start_transmit(const u8* data, size_t length)
+{
     int hw_buffer = -1;
     for (int i = 0; i < RTL8139_TX_BUFFER_COUNT; i++) {
         int potential_buffer = (m_tx_next_buffer + i) % 4;
@@ -310,15 +333,13 @@ void RTL8139NetworkAdapter::send_raw(const u8* data, size_t length)
         }
     }
 
-    if (hw_buffer == -1) {
-        klog() << "RTL8139NetworkAdapter: hardware buffers full; discarding packet";
-        return;
-    } else {
+    if (hw_buffer == -1)
+        return false;
+
 #ifdef RTL8139_DEBUG
-        klog() << "RTL8139NetworkAdapter: chose buffer " << hw_buffer << " @ " << PhysicalAddress(m_tx_buffer_addr[hw_buffer]);
+    klog() << "RTL8139NetworkAdapter: chose buffer " << hw_buffer;
 #endif
-        m_tx_next_buffer = (hw_buffer + 1) % 4;
-    }
+    m_tx_next_buffer = (hw_buffer + 1) % 4;
 
     memcpy(m_tx_buffers[hw_buffer]->vaddr().as_ptr(), data, length);
     memset(m_tx_buffers[hw_buffer]->vaddr().as_ptr() + length, 0, TX_BUFFER_SIZE - length);
@@ -335,6 +356,18 @@ void RTL8139NetworkAdapter::send_raw(const u8* data, size_t length)
     }
 
     out32(REG_TXSTATUS0 + (hw_buffer * 4), length);
+    return true;
+}
+
+void RTL8139NetworkAdapter::flush_tx_queue()
+{
+    while (!m_tx_queue.is_empty()) {
+        auto& packet = m_tx_queue.first();
+        if (!start_transmit(packet.data(), packet.size()))
+            break;
+        m_tx_queue.take_first();
+        --m_tx_queue_size;
+    }
 }
 
 void RTL8139NetworkAdapter::receive()
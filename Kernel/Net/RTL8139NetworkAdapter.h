@@ -27,6 +27,7 @@
 #pragma once
 
 #include <AK/OwnPtr.h>
+#include <AK/SinglyLinkedList.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/PCI/Access.h>
 #include <Kernel/PCI/Device.h>
@@ -56,6 +57,9 @@ private:
     void reset();
     void read_mac_address();
 
+    bool start_transmit(const u8*, size_t);
+    void flush_tx_queue();
+
     void receive();
 
     void out8(u16 address, u8 data);
@@ -71,6 +75,10 @@ private:
     u16 m_rx_buffer_offset { 0 };
     Vector<OwnPtr<Region>> m_tx_buffers;
     u8 m_tx_next_buffer { 0 };
+    // Packets that arrived while all four descriptors were owned by the
+    // card; drained into freed descriptors on TXOK interrupts.
+    SinglyLinkedList<KBuffer> m_tx_queue;
+    size_t m_tx_queue_size { 0 };
     OwnPtr<Region> m_packet_buffer;
     bool m_link_up { false };
 };
@@ -41,6 +41,18 @@ Lockable<HashMap<IPv4Address, MACAddress>>& arp_table()
     return *the;
 }
 
+static u32 s_routing_table_generation;
+
+u32 routing_table_generation()
+{
+    return s_routing_table_generation;
+}
+
+void bump_routing_table_generation()
+{
+    ++s_routing_table_generation;
+}
+
 bool RoutingDecision::is_zero() const
 {
     return adapter.is_null() || next_hop.is_zero();
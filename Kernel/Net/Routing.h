@@ -41,4 +41,9 @@ RoutingDecision route_to(const IPv4Address& target, const IPv4Address& source, c
 
 Lockable<HashMap<IPv4Address, MACAddress>>& arp_table();
 
+// Bumped whenever the ARP table or an adapter's IPv4 configuration changes,
+// so cached RoutingDecisions can tell when they've gone stale.
+u32 routing_table_generation();
+void bump_routing_table_generation();
+
 }
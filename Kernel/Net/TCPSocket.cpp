@@ -40,9 +40,12 @@ namespace Kernel {
 
 void TCPSocket::for_each(Function<void(const TCPSocket&)> callback)
 {
-    LOCKER(sockets_by_tuple().lock(), Lock::Mode::Shared);
-    for (auto& it : sockets_by_tuple().resource())
-        callback(*it.value);
+    for (size_t shard_index = 0; shard_index < number_of_socket_shards; ++shard_index) {
+        auto& sockets = sockets_by_tuple(shard_index);
+        LOCKER(sockets.lock(), Lock::Mode::Shared);
+        for (auto& it : sockets.resource())
+            callback(*it.value);
+    }
 }
 
 void TCPSocket::set_state(State new_state)
@@ -70,29 +73,31 @@ Lockable<HashMap<IPv4SocketTuple, RefPtr<TCPSocket>>>& TCPSocket::closing_socket
     return *s_map;
 }
 
-Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>& TCPSocket::sockets_by_tuple()
+Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>& TCPSocket::sockets_by_tuple(u16 local_port)
 {
-    static Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>* s_map;
-    if (!s_map)
-        s_map = new Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>;
-    return *s_map;
+    static Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>* s_shards[number_of_socket_shards];
+    auto*& shard = s_shards[local_port % number_of_socket_shards];
+    if (!shard)
+        shard = new Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>;
+    return *shard;
 }
 
 RefPtr<TCPSocket> TCPSocket::from_tuple(const IPv4SocketTuple& tuple)
 {
-    LOCKER(sockets_by_tuple().lock(), Lock::Mode::Shared);
+    auto& sockets = sockets_by_tuple(tuple.local_port());
+    LOCKER(sockets.lock(), Lock::Mode::Shared);
 
-    auto exact_match = sockets_by_tuple().resource().get(tuple);
+    auto exact_match = sockets.resource().get(tuple);
     if (exact_match.has_value())
         return { *exact_match.value() };
 
     auto address_tuple = IPv4SocketTuple(tuple.local_address(), tuple.local_port(), IPv4Address(), 0);
-    auto address_match = sockets_by_tuple().resource().get(address_tuple);
+    auto address_match = sockets.resource().get(address_tuple);
     if (address_match.has_value())
         return { *address_match.value() };
 
     auto wildcard_tuple = IPv4SocketTuple(IPv4Address(), tuple.local_port(), IPv4Address(), 0);
-    auto wildcard_match = sockets_by_tuple().resource().get(wildcard_tuple);
+    auto wildcard_match = sockets.resource().get(wildcard_tuple);
     if (wildcard_match.has_value())
         return { *wildcard_match.value() };
 
@@ -108,8 +113,9 @@ RefPtr<TCPSocket> TCPSocket::create_client(const IPv4Address& new_local_address,
 {
     auto tuple = IPv4SocketTuple(new_local_address, new_local_port, new_peer_address, new_peer_port);
 
-    LOCKER(sockets_by_tuple().lock());
-    if (sockets_by_tuple().resource().contains(tuple))
+    auto& sockets = sockets_by_tuple(new_local_port);
+    LOCKER(sockets.lock());
+    if (sockets.resource().contains(tuple))
         return {};
 
     auto client = TCPSocket::create(protocol());
@@ -123,7 +129,7 @@ RefPtr<TCPSocket> TCPSocket::create_client(const IPv4Address& new_local_address,
     client->set_originator(*this);
 
     m_pending_release_for_accept.set(tuple, client);
-    sockets_by_tuple().resource().set(tuple, client);
+    sockets.resource().set(tuple, client);
 
     return from_tuple(tuple);
 }
@@ -148,8 +154,9 @@ TCPSocket::TCPSocket(int protocol)
 
 TCPSocket::~TCPSocket()
 {
-    LOCKER(sockets_by_tuple().lock());
-    sockets_by_tuple().resource().remove(tuple());
+    auto& sockets = sockets_by_tuple(tuple().local_port());
+    LOCKER(sockets.lock());
+    sockets.resource().remove(tuple());
 
 #ifdef TCP_SOCKET_DEBUG
     dbg() << "~TCPSocket in state " << to_string(state());
@@ -177,10 +184,32 @@ int TCPSocket::protocol_receive(const KBuffer& packet_buffer, void* buffer, size
 
 int TCPSocket::protocol_send(const void* data, size_t data_length)
 {
-    send_tcp_packet(TCPFlags::PUSH | TCPFlags::ACK, data, data_length);
+    m_pending_send_buffer.append(data, data_length);
+    flush_pending_send();
     return data_length;
 }
 
+void TCPSocket::flush_pending_send(bool force)
+{
+    while (!m_pending_send_buffer.is_empty()) {
+        size_t segment_size = min(m_pending_send_buffer.size(), maximum_segment_size);
+        if (!force && !m_no_delay && segment_size < maximum_segment_size) {
+            // Nagle: hold on to a sub-MSS segment while earlier data is still
+            // in flight; receive_tcp_packet() flushes us when the ACK arrives.
+            LOCKER(m_not_acked_lock, Lock::Mode::Shared);
+            if (!m_not_acked.is_empty())
+                return;
+        }
+        send_tcp_packet(TCPFlags::PUSH | TCPFlags::ACK, m_pending_send_buffer.data(), segment_size);
+        if (segment_size == m_pending_send_buffer.size()) {
+            m_pending_send_buffer.clear();
+        } else {
+            memmove(m_pending_send_buffer.data(), m_pending_send_buffer.data() + segment_size, m_pending_send_buffer.size() - segment_size);
+            m_pending_send_buffer.trim(m_pending_send_buffer.size() - segment_size);
+        }
+    }
+}
+
 void TCPSocket::send_tcp_packet(u16 flags, const void* payload, size_t payload_size)
 {
     auto buffer = ByteBuffer::create_zeroed(sizeof(TCPPacket) + payload_size);
@@ -212,7 +241,7 @@ void TCPSocket::send_tcp_packet(u16 flags, const void* payload, size_t payload_s
         return;
     }
 
-    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    auto routing_decision = cached_route_to(peer_address(), local_address());
     ASSERT(!routing_decision.is_zero());
 
     routing_decision.adapter->send_ipv4(
@@ -225,7 +254,7 @@ void TCPSocket::send_tcp_packet(u16 flags, const void* payload, size_t payload_s
 
 void TCPSocket::send_outgoing_packets()
 {
-    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    auto routing_decision = cached_route_to(peer_address(), local_address());
     ASSERT(!routing_decision.is_zero());
 
     auto now = kgettimeofday();
@@ -283,6 +312,9 @@ void TCPSocket::receive_tcp_packet(const TCPPacket& packet, u16 size)
 #endif
     }
 
+    if (packet.has_ack() && !m_pending_send_buffer.is_empty())
+        flush_pending_send();
+
     m_packets_in++;
     m_bytes_in += packet.header_size() + size;
 }
@@ -300,33 +332,11 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(const IPv4Address& source, c
 
     PseudoHeader pseudo_header { source, destination, 0, (u8)IPv4Protocol::TCP, sizeof(TCPPacket) + payload_size };
 
-    u32 checksum = 0;
-    auto* w = (const NetworkOrdered<u16>*)&pseudo_header;
-    for (size_t i = 0; i < sizeof(pseudo_header) / sizeof(u16); ++i) {
-        checksum += w[i];
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    w = (const NetworkOrdered<u16>*)&packet;
-    for (size_t i = 0; i < sizeof(packet) / sizeof(u16); ++i) {
-        checksum += w[i];
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
+    u64 checksum = internet_checksum_partial(0, &pseudo_header, sizeof(pseudo_header));
+    checksum = internet_checksum_partial(checksum, &packet, sizeof(TCPPacket));
     ASSERT(packet.data_offset() * 4 == sizeof(TCPPacket));
-    w = (const NetworkOrdered<u16>*)packet.payload();
-    for (size_t i = 0; i < payload_size / sizeof(u16); ++i) {
-        checksum += w[i];
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    if (payload_size & 1) {
-        u16 expanded_byte = ((const u8*)packet.payload())[payload_size - 1] << 8;
-        checksum += expanded_byte;
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    return ~(checksum & 0xffff);
+    checksum = internet_checksum_partial(checksum, packet.payload(), payload_size);
+    return internet_checksum_finish(checksum);
 }
 
 KResult TCPSocket::protocol_bind()
@@ -342,10 +352,12 @@ KResult TCPSocket::protocol_bind()
 
 KResult TCPSocket::protocol_listen()
 {
-    LOCKER(sockets_by_tuple().lock());
-    if (sockets_by_tuple().resource().contains(tuple()))
+    auto& sockets = sockets_by_tuple(tuple().local_port());
+    LOCKER(sockets.lock());
+    bool did_insert = false;
+    sockets.resource().find_or_insert(tuple(), this, did_insert);
+    if (!did_insert)
         return KResult(-EADDRINUSE);
-    sockets_by_tuple().resource().set(tuple(), this);
     set_direction(Direction::Passive);
     set_state(State::Listen);
     set_setup_state(SetupState::Completed);
@@ -392,14 +404,15 @@ int TCPSocket::protocol_allocate_local_port()
     static const u16 ephemeral_port_range_size = last_ephemeral_port - first_ephemeral_port;
     u16 first_scan_port = first_ephemeral_port + get_good_random<u16>() % ephemeral_port_range_size;
 
-    LOCKER(sockets_by_tuple().lock());
     for (u16 port = first_scan_port;;) {
         IPv4SocketTuple proposed_tuple(local_address(), port, peer_address(), peer_port());
 
-        auto it = sockets_by_tuple().resource().find(proposed_tuple);
-        if (it == sockets_by_tuple().resource().end()) {
+        auto& sockets = sockets_by_tuple(port);
+        LOCKER(sockets.lock());
+        auto it = sockets.resource().find(proposed_tuple);
+        if (it == sockets.resource().end()) {
             set_local_port(port);
-            sockets_by_tuple().resource().set(proposed_tuple, this);
+            sockets.resource().set(proposed_tuple, this);
             return port;
         }
         ++port;
@@ -433,6 +446,7 @@ void TCPSocket::shut_down_for_writing()
 #ifdef TCP_SOCKET_DEBUG
         dbg() << " Sending FIN/ACK from Established and moving into FinWait1";
 #endif
+        flush_pending_send(true);
         send_tcp_packet(TCPFlags::FIN | TCPFlags::ACK);
         set_state(State::FinWait1);
     } else {
@@ -447,6 +461,7 @@ void TCPSocket::close()
 #ifdef TCP_SOCKET_DEBUG
         dbg() << " Sending FIN from CloseWait and moving into LastAck";
 #endif
+        flush_pending_send(true);
         send_tcp_packet(TCPFlags::FIN | TCPFlags::ACK);
         set_state(State::LastAck);
     }
@@ -455,4 +470,38 @@ void TCPSocket::close()
     closing_sockets().resource().set(tuple(), *this);
 }
 
+KResult TCPSocket::setsockopt(int level, int option, const void* value, socklen_t value_size)
+{
+    if (level != IPPROTO_TCP)
+        return IPv4Socket::setsockopt(level, option, value, value_size);
+
+    switch (option) {
+    case TCP_NODELAY:
+        if (value_size < sizeof(int))
+            return KResult(-EINVAL);
+        m_no_delay = *(const int*)value;
+        if (m_no_delay && !m_pending_send_buffer.is_empty())
+            flush_pending_send();
+        return KSuccess;
+    default:
+        return KResult(-ENOPROTOOPT);
+    }
+}
+
+KResult TCPSocket::getsockopt(FileDescription& description, int level, int option, void* value, socklen_t* value_size)
+{
+    if (level != IPPROTO_TCP)
+        return IPv4Socket::getsockopt(description, level, option, value, value_size);
+
+    switch (option) {
+    case TCP_NODELAY:
+        if (*value_size < sizeof(int))
+            return KResult(-EINVAL);
+        *(int*)value = m_no_delay;
+        return KSuccess;
+    default:
+        return KResult(-ENOPROTOOPT);
+    }
+}
+
 }
@@ -153,7 +153,12 @@ public:
     void send_outgoing_packets();
     void receive_tcp_packet(const TCPPacket&, u16 size);
 
-    static Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>& sockets_by_tuple();
+    // The socket table is sharded by local port so packet steering for one
+    // port doesn't contend with binds and lookups on another. All three probe
+    // tuples in from_tuple() share the local port, so a lookup only ever
+    // touches one shard.
+    static const size_t number_of_socket_shards = 16;
+    static Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>& sockets_by_tuple(u16 local_port);
     static RefPtr<TCPSocket> from_tuple(const IPv4SocketTuple& tuple);
     static RefPtr<TCPSocket> from_endpoints(const IPv4Address& local_address, u16 local_port, const IPv4Address& peer_address, u16 peer_port);
 
@@ -167,6 +172,9 @@ public:
 
     virtual void close() override;
 
+    virtual KResult setsockopt(int level, int option, const void*, socklen_t) override;
+    virtual KResult getsockopt(FileDescription&, int level, int option, void*, socklen_t*) override;
+
 protected:
     void set_direction(Direction direction) { m_direction = direction; }
 
@@ -186,6 +194,10 @@ private:
     virtual KResult protocol_bind() override;
     virtual KResult protocol_listen() override;
 
+    void flush_pending_send(bool force = false);
+
+    static const size_t maximum_segment_size = 1460;
+
     WeakPtr<TCPSocket> m_originator;
     HashMap<IPv4SocketTuple, NonnullRefPtr<TCPSocket>> m_pending_release_for_accept;
     Direction m_direction { Direction::Unspecified };
@@ -208,6 +220,11 @@ private:
 
     Lock m_not_acked_lock { "TCPSocket unacked packets" };
     SinglyLinkedList<OutgoingPacket> m_not_acked;
+
+    // Small writes are coalesced here (Nagle style) while earlier data is
+    // still in flight, unless TCP_NODELAY is set.
+    ByteBuffer m_pending_send_buffer;
+    bool m_no_delay { false };
 };
 
 }
@@ -92,7 +92,7 @@ int UDPSocket::protocol_receive(const KBuffer& packet_buffer, void* buffer, size
 
 int UDPSocket::protocol_send(const void* data, size_t data_length)
 {
-    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    auto routing_decision = cached_route_to(peer_address(), local_address());
     if (routing_decision.is_zero())
         return -EHOSTUNREACH;
     auto buffer = ByteBuffer::create_zeroed(sizeof(UDPPacket) + data_length);
@@ -140,9 +140,10 @@ int UDPSocket::protocol_allocate_local_port()
 KResult UDPSocket::protocol_bind()
 {
     LOCKER(sockets_by_port().lock());
-    if (sockets_by_port().resource().contains(local_port()))
+    bool did_insert = false;
+    sockets_by_port().resource().find_or_insert(local_port(), this, did_insert);
+    if (!did_insert)
         return KResult(-EADDRINUSE);
-    sockets_by_port().resource().set(local_port(), this);
     return KSuccess;
 }
 
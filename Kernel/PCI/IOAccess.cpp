@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <Kernel/Arch/i386/CPU.h>
 #include <Kernel/PCI/IOAccess.h>
 #include <LibBareMetal/IO.h>
 
@@ -44,36 +45,46 @@ IOAccess::IOAccess()
     });
 }
 
+// Each config space access is an address write to 0xCF8 followed by a
+// data access on 0xCFC. Disable interrupts across the pair so that a
+// preempting thread can't clobber the address port in between; this is
+// what makes concurrent device probing from multiple kernel threads safe.
 u8 IOAccess::read8_field(Address address, u32 field)
 {
+    InterruptDisabler disabler;
     IO::out32(PCI_ADDRESS_PORT, address.io_address_for_field(field));
     return IO::in8(PCI_VALUE_PORT + (field & 3));
 }
 
 u16 IOAccess::read16_field(Address address, u32 field)
 {
+    InterruptDisabler disabler;
     IO::out32(PCI_ADDRESS_PORT, address.io_address_for_field(field));
     return IO::in16(PCI_VALUE_PORT + (field & 2));
 }
 
 u32 IOAccess::read32_field(Address address, u32 field)
 {
+    InterruptDisabler disabler;
     IO::out32(PCI_ADDRESS_PORT, address.io_address_for_field(field));
     return IO::in32(PCI_VALUE_PORT);
 }
 
 void IOAccess::write8_field(Address address, u32 field, u8 value)
 {
+    InterruptDisabler disabler;
     IO::out32(PCI_ADDRESS_PORT, address.io_address_for_field(field));
     IO::out8(PCI_VALUE_PORT + (field & 3), value);
 }
 void IOAccess::write16_field(Address address, u32 field, u16 value)
 {
+    InterruptDisabler disabler;
     IO::out32(PCI_ADDRESS_PORT, address.io_address_for_field(field));
     IO::out16(PCI_VALUE_PORT + (field & 2), value);
 }
 void IOAccess::write32_field(Address address, u32 field, u32 value)
 {
+    InterruptDisabler disabler;
     IO::out32(PCI_ADDRESS_PORT, address.io_address_for_field(field));
     IO::out32(PCI_VALUE_PORT, value);
 }
@@ -39,10 +39,14 @@ PerformanceEventBuffer::PerformanceEventBuffer()
 
 KResult PerformanceEventBuffer::append(int type, FlatPtr arg1, FlatPtr arg2)
 {
-    if (count() >= capacity())
+    // Claim a slot first, then fill it in place. If the buffer is full we
+    // just drop the event; the claimed index stays past capacity() and is
+    // never handed out again, so racing writers can't collide on a slot.
+    size_t index = m_count.fetch_add(1, AK::memory_order_acq_rel);
+    if (index >= capacity())
         return KResult(-ENOBUFS);
 
-    PerformanceEvent event;
+    auto& event = at(index);
     event.type = type;
 
     switch (type) {
@@ -82,7 +86,6 @@ KResult PerformanceEventBuffer::append(int type, FlatPtr arg1, FlatPtr arg2)
 #endif
 
     event.timestamp = g_uptime;
-    at(m_count++) = event;
     return KSuccess;
 }
 
@@ -102,7 +105,7 @@ KBuffer PerformanceEventBuffer::to_json(pid_t pid, const String& executable_path
     object.add("executable", executable_path);
 
     auto array = object.add_array("events");
-    for (size_t i = 0; i < m_count; ++i) {
+    for (size_t i = 0; i < count(); ++i) {
         auto& event = at(i);
         auto event_object = array.add_object();
         switch (event.type) {
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <Kernel/KBuffer.h>
 #include <Kernel/KResult.h>
 
@@ -62,7 +63,7 @@ public:
     KResult append(int type, FlatPtr arg1, FlatPtr arg2);
 
     size_t capacity() const { return m_buffer.size() / sizeof(PerformanceEvent); }
-    size_t count() const { return m_count; }
+    size_t count() const { return min(m_count.load(AK::memory_order_acquire), capacity()); }
     const PerformanceEvent& at(size_t index) const
     {
         return const_cast<PerformanceEventBuffer&>(*this).at(index);
@@ -73,7 +74,11 @@ public:
 private:
     PerformanceEvent& at(size_t index);
 
-    size_t m_count { 0 };
+    // Writers claim a slot with an atomic increment and then fill it in
+    // place, so concurrent threads (or an interrupt) never contend on a lock
+    // to record an event. Slot indices at or past capacity() mean the buffer
+    // is full and the event is dropped.
+    Atomic<size_t> m_count { 0 };
     KBuffer m_buffer;
 };
 
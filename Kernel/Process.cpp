@@ -101,6 +101,7 @@ Process* Process::current;
 
 static pid_t next_pid;
 InlineLinkedList<Process>* g_processes;
+volatile u32 g_process_state_generation;
 static String* s_hostname;
 static Lock* s_hostname_lock;
 static VirtualAddress s_info_page_address_for_userspace;
@@ -127,11 +128,12 @@ void Process::initialize()
     create_kernel_info_page();
 }
 
-void Process::update_info_page_timestamp(const timeval& tv)
+void Process::update_info_page_timestamp(const timeval& tv, const timespec& monotonic_ts)
 {
     auto* info_page = (KernelInfoPage*)s_info_page_address_for_kernel.as_ptr();
     info_page->serial++;
     const_cast<timeval&>(info_page->now) = tv;
+    const_cast<timespec&>(info_page->monotonic_now) = monotonic_ts;
 }
 
 Vector<pid_t> Process::all_pids()
@@ -242,16 +244,31 @@ Region* Process::allocate_region_with_vmobject(VirtualAddress vaddr, size_t size
     return allocate_region_with_vmobject(range, move(vmobject), offset_in_vmobject, name, prot);
 }
 
+// m_regions is kept sorted by base address (regions never overlap), so the
+// fault path and the mmap family can binary-search it.
+static size_t first_region_index_with_base_at_least(const NonnullOwnPtrVector<Region>& regions, VirtualAddress vaddr)
+{
+    size_t low = 0;
+    size_t high = regions.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (regions[middle].vaddr() < vaddr)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
 bool Process::deallocate_region(Region& region)
 {
     InterruptDisabler disabler;
     if (m_region_lookup_cache.region == &region)
         m_region_lookup_cache.region = nullptr;
-    for (size_t i = 0; i < m_regions.size(); ++i) {
-        if (&m_regions[i] == &region) {
-            m_regions.unstable_remove(i);
-            return true;
-        }
+    auto index = first_region_index_with_base_at_least(m_regions, region.vaddr());
+    if (index < m_regions.size() && &m_regions[index] == &region) {
+        m_regions.remove(index);
+        return true;
     }
     return false;
 }
@@ -262,7 +279,9 @@ Region* Process::region_from_range(const Range& range)
         return m_region_lookup_cache.region;
 
     size_t size = PAGE_ROUND_UP(range.size());
-    for (auto& region : m_regions) {
+    auto index = first_region_index_with_base_at_least(m_regions, range.base());
+    if (index < m_regions.size()) {
+        auto& region = m_regions[index];
         if (region.vaddr() == range.base() && region.size() == size) {
             m_region_lookup_cache.range = range;
             m_region_lookup_cache.region = region.make_weak_ptr();
@@ -274,10 +293,17 @@ Region* Process::region_from_range(const Range& range)
 
 Region* Process::region_containing(const Range& range)
 {
-    for (auto& region : m_regions) {
-        if (region.contains(range))
-            return &region;
+    auto index = first_region_index_with_base_at_least(m_regions, range.base());
+    // The containing region either starts exactly at range.base() or is the
+    // last one starting below it.
+    if (index == m_regions.size() || m_regions[index].vaddr() > range.base()) {
+        if (index == 0)
+            return nullptr;
+        --index;
     }
+    auto& region = m_regions[index];
+    if (region.contains(range))
+        return &region;
     return nullptr;
 }
 
@@ -405,6 +431,7 @@ void* Process::sys$mmap(const Syscall::SC_mmap_params* user_params)
     bool map_private = flags & MAP_PRIVATE;
     bool map_stack = flags & MAP_STACK;
     bool map_fixed = flags & MAP_FIXED;
+    bool map_populate = flags & MAP_POPULATE;
 
     if (map_shared && map_private)
         return (void*)-EINVAL;
@@ -429,10 +456,12 @@ void* Process::sys$mmap(const Syscall::SC_mmap_params* user_params)
         region = allocate_region_with_vmobject(range, vmobject, 0, !name.is_null() ? name : "mmap (purgeable)", prot);
         if (!region && (!map_fixed && addr != 0))
             region = allocate_region_with_vmobject({}, size, vmobject, 0, !name.is_null() ? name : "mmap (purgeable)", prot);
+        if (region && map_populate)
+            region->commit();
     } else if (map_anonymous) {
-        region = allocate_region(range, !name.is_null() ? name : "mmap", prot, false);
+        region = allocate_region(range, !name.is_null() ? name : "mmap", prot, map_populate);
         if (!region && (!map_fixed && addr != 0))
-            region = allocate_region(allocate_range({}, size), !name.is_null() ? name : "mmap", prot, false);
+            region = allocate_region(allocate_range({}, size), !name.is_null() ? name : "mmap", prot, map_populate);
     } else {
         if (offset < 0)
             return (void*)-EINVAL;
@@ -463,6 +492,9 @@ void* Process::sys$mmap(const Syscall::SC_mmap_params* user_params)
         if (region_or_error.is_error())
             return (void*)(int)region_or_error.error();
         region = region_or_error.value();
+        // FIXME: MAP_POPULATE on an inode-backed mapping should read ahead and
+        //        pre-fault the file contents. For now it's a best-effort hint
+        //        that only pre-faults anonymous and purgeable mappings.
     }
 
     if (!region)
@@ -751,7 +783,7 @@ pid_t Process::sys$fork(RegisterState& regs)
         dbg() << "fork: cloning Region{" << &region << "} '" << region.name() << "' @ " << region.vaddr();
 #endif
         auto& child_region = child->add_region(region.clone());
-        child_region.map(child->page_directory());
+        child_region.map_lazily(child->page_directory());
 
         if (&region == m_master_tls_region)
             child->m_master_tls_region = child_region.make_weak_ptr();
@@ -903,10 +935,11 @@ int Process::do_exec(NonnullRefPtr<FileDescription> main_program_description, Ve
     RefPtr<ELF::Loader> loader;
     {
         ArmedScopeGuard rollback_regions_guard([&]() {
-            ASSERT(Process::current == this);
             m_page_directory = move(old_page_directory);
             m_regions = move(old_regions);
-            MM.enter_process_paging_scope(*this);
+            // When exec'ing another process (spawn), the calling thread must
+            // get its own address space back, not the target's.
+            MM.enter_process_paging_scope(*Process::current);
         });
         loader = ELF::Loader::create(region->vaddr().as_ptr(), loader_metadata.size);
         // Load the correct executable -- either interp or main program.
@@ -930,17 +963,36 @@ int Process::do_exec(NonnullRefPtr<FileDescription> main_program_description, Ve
             }
             return nullptr;
         };
-        loader->alloc_section_hook = [&](VirtualAddress vaddr, size_t size, size_t alignment, bool is_readable, bool is_writable, const String& name) -> u8* {
-            ASSERT(size);
+        loader->map_writable_section_hook = [&](VirtualAddress vaddr, size_t size_in_memory, size_t alignment, size_t offset_in_image, size_t size_in_image, bool is_readable, bool is_writable, const String& name) -> u8* {
+            ASSERT(size_in_memory);
             ASSERT(alignment == PAGE_SIZE);
             int prot = 0;
             if (is_readable)
                 prot |= PROT_READ;
             if (is_writable)
                 prot |= PROT_WRITE;
-            if (auto* region = allocate_region(vaddr.offset(totally_random_offset), size, String(name), prot))
-                return region->vaddr().as_ptr();
-            return nullptr;
+            // Map the file-backed part of the segment copy-on-write from the
+            // executable's inode, so .data pages are only read in (and copied)
+            // when the program actually touches them.
+            size_t in_page_offset = vaddr.get() & ~PAGE_MASK;
+            size_t file_mapped_size = size_in_image ? PAGE_ROUND_UP(in_page_offset + size_in_image) : 0;
+            if (size_in_image) {
+                auto* region = allocate_region_with_vmobject(vaddr.offset(totally_random_offset), in_page_offset + size_in_image, PrivateInodeVMObject::create_with_inode(inode), offset_in_image - in_page_offset, String(name), prot);
+                if (!region)
+                    return nullptr;
+                // The tail of the last file-backed page contains whatever comes
+                // next in the image, but the program expects to find zeroed bss.
+                size_t tail_size = file_mapped_size - (in_page_offset + size_in_image);
+                if (tail_size)
+                    memset_user(region->vaddr().offset(in_page_offset + size_in_image).as_ptr(), 0, tail_size);
+            }
+            // Any whole pages past the file-backed part are plain anonymous
+            // (zero-fill) bss pages.
+            if (in_page_offset + size_in_memory > file_mapped_size) {
+                if (!allocate_region(vaddr.offset(totally_random_offset + file_mapped_size - in_page_offset), in_page_offset + size_in_memory - file_mapped_size, String(name), prot))
+                    return nullptr;
+            }
+            return vaddr.offset(totally_random_offset).as_ptr();
         };
 
         // FIXME: Move TLS region allocation to userspace: LibC and the dynamic loader.
@@ -1001,9 +1053,22 @@ int Process::do_exec(NonnullRefPtr<FileDescription> main_program_description, Ve
             m_egid = main_program_metadata.gid;
     }
 
-    Thread::current->set_default_signal_dispositions();
-    Thread::current->m_signal_mask = 0;
-    Thread::current->m_pending_signals = 0;
+    Thread* new_main_thread = nullptr;
+    if (Process::current == this) {
+        new_main_thread = Thread::current;
+    } else {
+        for_each_thread([&](auto& thread) {
+            new_main_thread = &thread;
+            return IterationDecision::Break;
+        });
+    }
+    ASSERT(new_main_thread);
+
+    // NOTE: These must target the thread that will run the new image, which
+    //       is not the calling thread when exec'ing a freshly spawned process.
+    new_main_thread->set_default_signal_dispositions();
+    new_main_thread->m_signal_mask = 0;
+    new_main_thread->m_pending_signals = 0;
 
     m_futex_queues.clear();
 
@@ -1019,17 +1084,6 @@ int Process::do_exec(NonnullRefPtr<FileDescription> main_program_description, Ve
         }
     }
 
-    Thread* new_main_thread = nullptr;
-    if (Process::current == this) {
-        new_main_thread = Thread::current;
-    } else {
-        for_each_thread([&](auto& thread) {
-            new_main_thread = &thread;
-            return IterationDecision::Break;
-        });
-    }
-    ASSERT(new_main_thread);
-
     // NOTE: We create the new stack before disabling interrupts since it will zero-fault
     //       and we don't want to deal with faults after this point.
     u32 new_userspace_esp = new_main_thread->make_userspace_stack_for_main_thread(move(arguments), move(environment));
@@ -1083,6 +1137,13 @@ int Process::do_exec(NonnullRefPtr<FileDescription> main_program_description, Ve
         Profiling::did_exec(path);
 
     new_main_thread->set_state(Thread::State::Skip1SchedulerPass);
+
+    // If we've been building the image on behalf of another process (spawn),
+    // the calling thread is still teleported into the new address space;
+    // switch back before returning to the caller.
+    if (Process::current != this)
+        MM.enter_process_paging_scope(*Process::current);
+
     big_lock().force_unlock_if_locked();
     return 0;
 }
@@ -1327,6 +1388,84 @@ int Process::sys$execve(const Syscall::SC_execve_params* user_params)
     return rc;
 }
 
+pid_t Process::sys$spawn(const Syscall::SC_spawn_params* user_params)
+{
+    REQUIRE_PROMISE(exec);
+
+    Syscall::SC_spawn_params params;
+    if (!validate_read_and_copy_typed(&params, user_params))
+        return -EFAULT;
+
+    if (params.arguments.length > ARG_MAX || params.environment.length > ARG_MAX)
+        return -E2BIG;
+
+    String path;
+    {
+        auto path_arg = get_syscall_path_argument(params.path);
+        if (path_arg.is_error())
+            return path_arg.error();
+        path = path_arg.value();
+    }
+
+    auto copy_user_strings = [&](const auto& list, auto& output) {
+        if (!list.length)
+            return true;
+        if (!validate_read_typed(list.strings, list.length))
+            return false;
+        Vector<Syscall::StringArgument, 32> strings;
+        strings.resize(list.length);
+        copy_from_user(strings.data(), list.strings, list.length * sizeof(Syscall::StringArgument));
+        for (size_t i = 0; i < list.length; ++i) {
+            auto string = validate_and_copy_string_from_user(strings[i]);
+            if (string.is_null())
+                return false;
+            output.append(move(string));
+        }
+        return true;
+    };
+
+    Vector<String> arguments;
+    if (!copy_user_strings(params.arguments, arguments))
+        return -EFAULT;
+
+    Vector<String> environment;
+    if (!copy_user_strings(params.environment, environment))
+        return -EFAULT;
+
+    // Unlike fork()+exec(), we build the child directly from the executable:
+    // no address space is cloned, so there are no CoW faults to pay off and
+    // nothing to tear down again on the exec side.
+    Thread* child_first_thread = nullptr;
+    auto* child = new Process(child_first_thread, m_name, m_uid, m_gid, m_pid, Ring3, m_cwd, nullptr, m_tty);
+    child->m_root_directory = m_root_directory;
+    child->m_root_directory_relative_to_global_root = m_root_directory_relative_to_global_root;
+    child->m_promises = m_promises;
+    child->m_execpromises = m_execpromises;
+    child->m_veil_state = m_veil_state;
+    child->m_unveiled_paths = m_unveiled_paths;
+    child->m_fds = m_fds;
+    child->m_sid = m_sid;
+    child->m_pgid = m_pgid;
+    child->m_umask = m_umask;
+    child->m_extra_gids = m_extra_gids;
+
+    int rc = child->exec(move(path), move(arguments), move(environment));
+    if (rc < 0) {
+        delete child_first_thread;
+        delete child;
+        return rc;
+    }
+
+    {
+        InterruptDisabler disabler;
+        g_processes->prepend(child);
+    }
+#ifdef TASK_DEBUG
+    klog() << "Process " << child->pid() << " (" << child->name().characters() << ") spawned from " << m_pid << " via spawn()";
+#endif
+    return child->pid();
+}
+
 Process* Process::create_user_process(Thread*& first_thread, const String& path, uid_t uid, gid_t gid, pid_t parent_pid, int& error, Vector<String>&& arguments, Vector<String>&& environment, TTY* tty)
 {
     auto parts = path.split('/');
@@ -1407,6 +1546,7 @@ Process::Process(Thread*& first_thread, const String& name, uid_t uid, gid_t gid
 #ifdef PROCESS_DEBUG
     dbg() << "Created new process " << m_name << "(" << m_pid << ")";
 #endif
+    ++g_process_state_generation;
 
     m_page_directory = PageDirectory::create_for_userspace(*this, fork_parent ? &fork_parent->page_directory().range_allocator() : nullptr);
 #ifdef MM_DEBUG
@@ -1425,6 +1565,7 @@ Process::Process(Thread*& first_thread, const String& name, uid_t uid, gid_t gid
 Process::~Process()
 {
     ASSERT(thread_count() == 0);
+    ++g_process_state_generation;
 }
 
 void Process::dump_regions()
@@ -1682,6 +1823,21 @@ ssize_t Process::sys$writev(int fd, const struct iovec* iov, int iov_count)
     if (!description->is_writable())
         return -EBADF;
 
+    // Most writev() traffic is small multi-part IPC messages. Gathering those
+    // into one contiguous buffer lets the file or socket below see a single
+    // write, so a header+payload pair doesn't turn into two TCP segments or
+    // two trips through a socket buffer.
+    static const size_t maximum_gather_size = 64 * KB;
+    if (iov_count > 1 && total_length > 0 && total_length <= maximum_gather_size) {
+        auto buffer = ByteBuffer::create_uninitialized(total_length);
+        size_t offset = 0;
+        for (auto& vec : vecs) {
+            copy_from_user(buffer.data() + offset, vec.iov_base, vec.iov_len);
+            offset += vec.iov_len;
+        }
+        return do_write(*description, buffer.data(), buffer.size());
+    }
+
     int nwritten = 0;
     for (auto& vec : vecs) {
         int rc = do_write(*description, (const u8*)vec.iov_base, vec.iov_len);
@@ -1696,6 +1852,127 @@ ssize_t Process::sys$writev(int fd, const struct iovec* iov, int iov_count)
     return nwritten;
 }
 
+ssize_t Process::sys$readv(int fd, const struct iovec* iov, int iov_count)
+{
+    REQUIRE_PROMISE(stdio);
+    if (iov_count < 0)
+        return -EINVAL;
+
+    if (!validate_read_typed(iov, iov_count))
+        return -EFAULT;
+
+    u64 total_length = 0;
+    Vector<iovec, 32> vecs;
+    vecs.resize(iov_count);
+    copy_from_user(vecs.data(), iov, iov_count * sizeof(iovec));
+    for (auto& vec : vecs) {
+        if (!validate_write(vec.iov_base, vec.iov_len))
+            return -EFAULT;
+        total_length += vec.iov_len;
+        if (total_length > INT32_MAX)
+            return -EINVAL;
+    }
+    if (total_length == 0)
+        return 0;
+
+    auto description = file_description(fd);
+    if (!description)
+        return -EBADF;
+    if (!description->is_readable())
+        return -EBADF;
+    if (description->is_directory())
+        return -EISDIR;
+
+    if (description->is_blocking()) {
+        if (!description->can_read()) {
+            if (Thread::current->block<Thread::ReadBlocker>(*description) != Thread::BlockResult::WokeNormally)
+                return -EINTR;
+            if (!description->can_read())
+                return -EAGAIN;
+        }
+    }
+
+    // One read into a contiguous buffer, scattered to the iovecs afterwards.
+    // Reading each iovec separately could block again after filling the
+    // first one, even though readv() should return what's already available.
+    auto buffer = ByteBuffer::create_uninitialized(min((size_t)total_length, (size_t)(64 * KB)));
+    ssize_t nread = description->read(buffer.data(), buffer.size());
+    if (nread <= 0)
+        return nread;
+
+    size_t remaining = (size_t)nread;
+    size_t offset = 0;
+    for (auto& vec : vecs) {
+        size_t nread_for_vec = min(vec.iov_len, remaining);
+        copy_to_user(vec.iov_base, buffer.data() + offset, nread_for_vec);
+        offset += nread_for_vec;
+        remaining -= nread_for_vec;
+        if (!remaining)
+            break;
+    }
+    return nread;
+}
+
+ssize_t Process::sys$sendfile(const Syscall::SC_sendfile_params* user_params)
+{
+    REQUIRE_PROMISE(stdio);
+    Syscall::SC_sendfile_params params;
+    if (!validate_read_and_copy_typed(&params, user_params))
+        return -EFAULT;
+    if (params.offset && !validate_write_typed(params.offset))
+        return -EFAULT;
+
+    auto in_description = file_description(params.in_fd);
+    if (!in_description)
+        return -EBADF;
+    if (!in_description->is_readable())
+        return -EBADF;
+    auto* inode = in_description->inode();
+    if (!inode || in_description->is_directory())
+        return -EINVAL;
+
+    auto out_description = file_description(params.out_fd);
+    if (!out_description)
+        return -EBADF;
+    if (!out_description->is_writable())
+        return -EBADF;
+
+    off_t in_offset = 0;
+    if (params.offset)
+        copy_from_user(&in_offset, params.offset);
+    else
+        in_offset = in_description->offset();
+    if (in_offset < 0)
+        return -EINVAL;
+
+    // Stream the file into the target in buffer-sized bites, without the
+    // usual round-trip through a userspace buffer.
+    auto buffer = ByteBuffer::create_uninitialized(min((size_t)params.count, (size_t)(64 * KB)));
+    size_t total_sent = 0;
+    while (total_sent < params.count) {
+        size_t chunk_size = min((size_t)(params.count - total_sent), buffer.size());
+        ssize_t nread = inode->read_bytes(in_offset, chunk_size, buffer.data(), in_description.ptr());
+        if (nread < 0)
+            return total_sent ? (ssize_t)total_sent : nread;
+        if (nread == 0)
+            break;
+        ssize_t nwritten = do_write(*out_description, buffer.data(), nread);
+        if (nwritten < 0)
+            return total_sent ? (ssize_t)total_sent : nwritten;
+        in_offset += nwritten;
+        total_sent += nwritten;
+        if (nwritten < nread)
+            break;
+    }
+
+    if (params.offset)
+        copy_to_user(params.offset, &in_offset, sizeof(in_offset));
+    else
+        in_description->seek(in_offset, SEEK_SET);
+
+    return total_sent;
+}
+
 ssize_t Process::do_write(FileDescription& description, const u8* data, int data_size)
 {
     ssize_t nwritten = 0;
@@ -1907,6 +2184,49 @@ int Process::sys$stat(const Syscall::SC_stat_params* user_params)
     return 0;
 }
 
+int Process::sys$batch_stat(const Syscall::SC_batch_stat_params* user_params)
+{
+    REQUIRE_PROMISE(rpath);
+    Syscall::SC_batch_stat_params params;
+    if (!validate_read_and_copy_typed(&params, user_params))
+        return -EFAULT;
+    if (params.paths.length > 1024)
+        return -E2BIG;
+    if (!params.paths.length)
+        return 0;
+    if (!validate_read_typed(params.paths.strings, params.paths.length))
+        return -EFAULT;
+    if (!validate_write(params.statbufs, sizeof(stat) * params.paths.length))
+        return -EFAULT;
+    if (!validate_write(params.results, sizeof(int) * params.paths.length))
+        return -EFAULT;
+
+    Vector<Syscall::StringArgument, 32> path_arguments;
+    path_arguments.resize(params.paths.length);
+    copy_from_user(path_arguments.data(), params.paths.strings, params.paths.length * sizeof(Syscall::StringArgument));
+
+    // A failure to stat one path is reported through its slot in params.results
+    // instead of failing the whole batch.
+    for (size_t i = 0; i < params.paths.length; ++i) {
+        auto path = get_syscall_path_argument(path_arguments[i]);
+        int result;
+        stat statbuf;
+        memset(&statbuf, 0, sizeof(statbuf));
+        if (path.is_error()) {
+            result = path.error();
+        } else {
+            auto metadata_or_error = VFS::the().lookup_metadata(path.value(), current_directory(), params.follow_symlinks ? 0 : O_NOFOLLOW_NOERROR);
+            if (metadata_or_error.is_error())
+                result = metadata_or_error.error();
+            else
+                result = metadata_or_error.value().stat(statbuf);
+        }
+        copy_to_user(&params.statbufs[i], &statbuf);
+        copy_to_user(&params.results[i], &result);
+    }
+    return 0;
+}
+
 template<typename DataType, typename SizeType>
 bool Process::validate(const Syscall::MutableBufferArgument<DataType, SizeType>& buffer)
 {
@@ -3167,7 +3487,18 @@ void Process::finalize()
         }
     }
 
-    m_regions.clear();
+    // Tearing down the address space is the most expensive part of
+    // finalizing a large process, so release the regions in bounded batches
+    // with a yield in between: exit latency stays off the hot path and
+    // runnable threads get to make progress between batches.
+    static const size_t max_regions_per_batch = 32;
+    while (!m_regions.is_empty()) {
+        size_t batch_size = min((size_t)m_regions.size(), max_regions_per_batch);
+        for (size_t i = 0; i < batch_size; ++i)
+            (void)m_regions.take_last();
+        if (!m_regions.is_empty())
+            Scheduler::yield();
+    }
 
     m_dead = true;
 }
@@ -3583,6 +3914,57 @@ int Process::sys$sched_getparam(pid_t pid, struct sched_param* param)
     return 0;
 }
 
+int Process::sys$sched_setaffinity(pid_t tid, const u32* user_mask)
+{
+    REQUIRE_PROMISE(proc);
+    if (!validate_read_typed(user_mask))
+        return -EFAULT;
+
+    u32 mask;
+    copy_from_user(&mask, user_mask);
+
+    // An empty mask would leave the thread with nowhere to run, and any
+    // usable mask has to include processor 0 while it's the only one up.
+    if (!(mask & 1))
+        return -EINVAL;
+
+    InterruptDisabler disabler;
+    auto* peer = Thread::current;
+    if (tid != 0)
+        peer = Thread::from_tid(tid);
+
+    if (!peer)
+        return -ESRCH;
+
+    if (!is_superuser() && m_euid != peer->process().m_uid && m_uid != peer->process().m_uid)
+        return -EPERM;
+
+    peer->set_cpu_affinity(mask);
+    return 0;
+}
+
+int Process::sys$sched_getaffinity(pid_t tid, u32* user_mask)
+{
+    REQUIRE_PROMISE(proc);
+    if (!validate_write_typed(user_mask))
+        return -EFAULT;
+
+    InterruptDisabler disabler;
+    auto* peer = Thread::current;
+    if (tid != 0)
+        peer = Thread::from_tid(tid);
+
+    if (!peer)
+        return -ESRCH;
+
+    if (!is_superuser() && m_euid != peer->process().m_uid && m_uid != peer->process().m_uid)
+        return -EPERM;
+
+    u32 mask = peer->cpu_affinity();
+    copy_to_user(user_mask, &mask);
+    return 0;
+}
+
 int Process::sys$getsockopt(const Syscall::SC_getsockopt_params* params)
 {
     if (!validate_read_typed(params))
@@ -4033,9 +4415,12 @@ int Process::sys$ftruncate(int fd, off_t length)
     return description->truncate(static_cast<u64>(length));
 }
 
-int Process::sys$watch_file(const char* user_path, size_t path_length)
+int Process::sys$watch_file(const char* user_path, size_t path_length, unsigned flags)
 {
     REQUIRE_PROMISE(rpath);
+    if (flags & ~WATCH_FILE_RECURSIVE)
+        return -EINVAL;
+
     auto path = get_syscall_path_argument(user_path, path_length);
     if (path.is_error())
         return path.error();
@@ -4050,11 +4435,15 @@ int Process::sys$watch_file(const char* user_path, size_t path_length)
     if (!inode.fs().supports_watchers())
         return -ENOTSUP;
 
+    bool recursive = flags & WATCH_FILE_RECURSIVE;
+    if (recursive && !inode.is_directory())
+        return -ENOTDIR;
+
     int fd = alloc_fd();
     if (fd < 0)
         return fd;
 
-    m_fds[fd].set(FileDescription::create(*InodeWatcher::create(inode)));
+    m_fds[fd].set(FileDescription::create(*InodeWatcher::create(inode, recursive)));
     m_fds[fd].description->set_readable(true);
     return fd;
 }
@@ -4604,6 +4993,13 @@ int Process::sys$profiling_enable(pid_t pid)
 {
     REQUIRE_NO_PROMISES;
     InterruptDisabler disabler;
+    if (pid == -1) {
+        // Whole-system profiling: sample every thread on every tick.
+        if (!is_superuser())
+            return -EPERM;
+        Profiling::start_all_processes();
+        return 0;
+    }
     auto* process = Process::from_pid(pid);
     if (!process)
         return -ESRCH;
@@ -4619,6 +5015,12 @@ int Process::sys$profiling_enable(pid_t pid)
 int Process::sys$profiling_disable(pid_t pid)
 {
     InterruptDisabler disabler;
+    if (pid == -1) {
+        if (!is_superuser())
+            return -EPERM;
+        Profiling::stop();
+        return 0;
+    }
     auto* process = Process::from_pid(pid);
     if (!process)
         return -ESRCH;
@@ -4850,7 +5252,7 @@ int Process::sys$pledge(const Syscall::SC_pledge_params* user_params)
 Region& Process::add_region(NonnullOwnPtr<Region> region)
 {
     auto* ptr = region.ptr();
-    m_regions.append(move(region));
+    m_regions.insert(first_region_index_with_base_at_least(m_regions, region->vaddr()), move(region));
     return *ptr;
 }
 
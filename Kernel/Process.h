@@ -134,7 +134,7 @@ public:
 
     static Process* from_pid(pid_t);
 
-    static void update_info_page_timestamp(const timeval&);
+    static void update_info_page_timestamp(const timeval&, const timespec& monotonic);
 
     const String& name() const { return m_name; }
     pid_t pid() const { return m_pid; }
@@ -172,7 +172,7 @@ public:
     int sys$sync();
     int sys$beep();
     int sys$get_process_name(char* buffer, int buffer_size);
-    int sys$watch_file(const char* path, size_t path_length);
+    int sys$watch_file(const char* path, size_t path_length, unsigned flags);
     int sys$dbgputch(u8);
     int sys$dbgputstr(const u8*, int length);
     int sys$dump_backtrace();
@@ -196,8 +196,13 @@ public:
     ssize_t sys$read(int fd, u8*, ssize_t);
     ssize_t sys$write(int fd, const u8*, ssize_t);
     ssize_t sys$writev(int fd, const struct iovec* iov, int iov_count);
+    ssize_t sys$readv(int fd, const struct iovec* iov, int iov_count);
+    ssize_t sys$sendfile(const Syscall::SC_sendfile_params*);
     int sys$fstat(int fd, stat*);
     int sys$stat(const Syscall::SC_stat_params*);
+    int sys$batch_stat(const Syscall::SC_batch_stat_params*);
+    int sys$sched_setaffinity(pid_t tid, const u32* mask);
+    int sys$sched_getaffinity(pid_t tid, u32* mask);
     int sys$lseek(int fd, off_t, int whence);
     int sys$kill(pid_t pid, int sig);
     [[noreturn]] void sys$exit(int status);
@@ -230,6 +235,7 @@ public:
     int sys$ptsname_r(int fd, char*, ssize_t);
     pid_t sys$fork(RegisterState&);
     int sys$execve(const Syscall::SC_execve_params*);
+    pid_t sys$spawn(const Syscall::SC_spawn_params*);
     int sys$getdtablesize();
     int sys$dup(int oldfd);
     int sys$dup2(int oldfd, int newfd);
@@ -583,6 +589,10 @@ private:
 
 extern InlineLinkedList<Process>* g_processes;
 
+// Bumped whenever a process or thread is created, dies, or changes state.
+// ProcFS uses this to avoid re-serializing an unchanged process list.
+extern volatile u32 g_process_state_generation;
+
 template<typename Callback>
 inline void Process::for_each(Callback callback)
 {
@@ -41,6 +41,7 @@ static KBufferImpl* s_profiling_buffer;
 static size_t s_slot_count;
 static size_t s_next_slot_index;
 static u32 s_pid;
+static bool s_profiling_all_processes;
 
 String& executable_path()
 {
@@ -55,6 +56,15 @@ u32 pid()
     return s_pid;
 }
 
+static void ensure_profiling_buffer()
+{
+    if (!s_profiling_buffer) {
+        s_profiling_buffer = RefPtr<KBufferImpl>(KBuffer::create_with_size(8 * MB).impl()).leak_ref();
+        s_profiling_buffer->region().commit();
+        s_slot_count = s_profiling_buffer->size() / sizeof(Sample);
+    }
+}
+
 void start(Process& process)
 {
     if (process.executable())
@@ -62,16 +72,27 @@ void start(Process& process)
     else
         executable_path() = {};
     s_pid = process.pid();
+    s_profiling_all_processes = false;
 
-    if (!s_profiling_buffer) {
-        s_profiling_buffer = RefPtr<KBufferImpl>(KBuffer::create_with_size(8 * MB).impl()).leak_ref();
-        s_profiling_buffer->region().commit();
-        s_slot_count = s_profiling_buffer->size() / sizeof(Sample);
-    }
+    ensure_profiling_buffer();
+    s_next_slot_index = 0;
+}
 
+void start_all_processes()
+{
+    executable_path() = {};
+    s_pid = (u32)-1;
+    s_profiling_all_processes = true;
+
+    ensure_profiling_buffer();
     s_next_slot_index = 0;
 }
 
+bool all_processes()
+{
+    return s_profiling_all_processes;
+}
+
 static Sample& sample_slot(size_t index)
 {
     return ((Sample*)s_profiling_buffer->data())[index];
@@ -87,6 +108,7 @@ Sample& next_sample_slot()
 
 void stop()
 {
+    s_profiling_all_processes = false;
 }
 
 void did_exec(const String& new_executable_path)
@@ -50,6 +50,8 @@ extern String& executable_path();
 
 Sample& next_sample_slot();
 void start(Process&);
+void start_all_processes();
+bool all_processes();
 void stop();
 void did_exec(const String& new_executable_path);
 void for_each_sample(Function<void(Sample&)>);
@@ -24,7 +24,6 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <AK/QuickSort.h>
 #include <AK/TemporaryChange.h>
 #include <Kernel/FileSystem/FileDescription.h>
 #include <Kernel/Net/Socket.h>
@@ -51,12 +50,21 @@ void Scheduler::init_thread(Thread& thread)
 void Scheduler::update_state_for_thread(Thread& thread)
 {
     ASSERT_INTERRUPTS_DISABLED();
-    auto& list = g_scheduler_data->thread_list_for_state(thread.state());
-
-    if (list.contains(thread))
+    auto& data = *g_scheduler_data;
+    bool is_runnable = Thread::is_runnable_state(thread.state());
+
+    if (thread.m_runnable_queue_index >= 0) {
+        if (is_runnable && (u32)thread.m_runnable_queue_index == SchedulerData::run_queue_index_for(thread))
+            return;
+        data.dequeue_runnable_thread(thread);
+    } else if (!is_runnable && data.m_nonrunnable_threads.contains(thread)) {
         return;
+    }
 
-    list.append(thread);
+    if (is_runnable)
+        data.enqueue_runnable_thread(thread);
+    else
+        data.m_nonrunnable_threads.append(thread);
 }
 
 static u32 time_slice_for(const Thread& thread)
@@ -209,33 +217,37 @@ bool Thread::SleepBlocker::should_unblock(Thread&, time_t, long)
     return m_wakeup_time <= g_uptime;
 }
 
-Thread::SelectBlocker::SelectBlocker(const timeval& tv, bool select_has_timeout, const FDVector& read_fds, const FDVector& write_fds, const FDVector& except_fds)
+Thread::SelectBlocker::SelectBlocker(const timeval& tv, bool select_has_timeout, const FDVector& read_fds, const FDVector& write_fds, const FDVector&)
     : m_select_timeout(tv)
     , m_select_has_timeout(select_has_timeout)
-    , m_select_read_fds(read_fds)
-    , m_select_write_fds(write_fds)
-    , m_select_exceptional_fds(except_fds)
 {
+    // Resolve the fd sets into FileDescriptions once up front, so every
+    // scheduling pass checks the cached descriptions instead of doing per-fd
+    // table lookups over and over.
+    auto& process = *Process::current;
+    for (int fd : read_fds) {
+        if (auto description = process.file_description(fd))
+            m_select_read_descriptions.append(description.release_nonnull());
+    }
+    for (int fd : write_fds) {
+        if (auto description = process.file_description(fd))
+            m_select_write_descriptions.append(description.release_nonnull());
+    }
 }
 
-bool Thread::SelectBlocker::should_unblock(Thread& thread, time_t now_sec, long now_usec)
+bool Thread::SelectBlocker::should_unblock(Thread&, time_t now_sec, long now_usec)
 {
     if (m_select_has_timeout) {
         if (now_sec > m_select_timeout.tv_sec || (now_sec == m_select_timeout.tv_sec && now_usec >= m_select_timeout.tv_usec))
             return true;
     }
 
-    auto& process = thread.process();
-    for (int fd : m_select_read_fds) {
-        if (!process.m_fds[fd])
-            continue;
-        if (process.m_fds[fd].description->can_read())
+    for (auto& description : m_select_read_descriptions) {
+        if (description->can_read())
             return true;
     }
-    for (int fd : m_select_write_fds) {
-        if (!process.m_fds[fd])
-            continue;
-        if (process.m_fds[fd].description->can_write())
+    for (auto& description : m_select_write_descriptions) {
+        if (description->can_write())
             return true;
     }
 
@@ -405,34 +417,60 @@ bool Scheduler::pick_next()
     });
 #endif
 
-    Vector<Thread*, 128> sorted_runnables;
-    for_each_runnable([&sorted_runnables](auto& thread) {
-        sorted_runnables.append(&thread);
-        return IterationDecision::Continue;
-    });
-    quick_sort(sorted_runnables, [](auto& a, auto& b) { return a->effective_priority() >= b->effective_priority(); });
-
+    auto& data = *g_scheduler_data;
     Thread* thread_to_schedule = nullptr;
+    int scheduled_level = -1;
 
-    for (auto* thread : sorted_runnables) {
-        if (thread->process().is_being_inspected())
+    // Scan the run queues from the highest non-empty priority level down and
+    // take the first eligible thread we find.
+    for (int level = SchedulerData::num_run_queues - 1; level >= 0 && !thread_to_schedule; --level) {
+        if (!(data.m_nonempty_run_queues & (1u << level)))
             continue;
+        for (auto& thread : data.m_run_queues[level]) {
+            if (thread.process().is_being_inspected())
+                continue;
 
-        if (thread->process().exec_tid() && thread->process().exec_tid() != thread->tid())
-            continue;
+            if (thread.process().exec_tid() && thread.process().exec_tid() != thread.tid())
+                continue;
 
-        ASSERT(thread->state() == Thread::Runnable || thread->state() == Thread::Running);
+            ASSERT(thread.state() == Thread::Runnable || thread.state() == Thread::Running);
 
-        if (!thread_to_schedule) {
-            thread->m_extra_priority = 0;
-            thread_to_schedule = thread;
-        } else {
-            thread->m_extra_priority++;
+            thread_to_schedule = &thread;
+            scheduled_level = level;
+            break;
         }
     }
 
-    if (!thread_to_schedule)
+    if (thread_to_schedule) {
+        // Anti-starvation aging: without it, a CPU-bound thread at a high
+        // level would starve everything below it forever. Each pass, the
+        // longest-waiting thread of every passed-over level gains a point
+        // of extra priority (shed again when it's finally scheduled), so
+        // waiters keep climbing towards the busy level instead of sitting
+        // behind it indefinitely.
+        u32 passed_over_levels = data.m_nonempty_run_queues & ((1u << scheduled_level) - 1);
+        for (int level = 0; level < scheduled_level; ++level) {
+            if (!(passed_over_levels & (1u << level)))
+                continue;
+            auto* waiter = data.m_run_queues[level].first();
+            if (!waiter || waiter == thread_to_schedule)
+                continue;
+            if (waiter->m_extra_priority < THREAD_PRIORITY_MAX)
+                waiter->m_extra_priority++;
+            if (SchedulerData::run_queue_index_for(*waiter) != (u32)level) {
+                data.dequeue_runnable_thread(*waiter);
+                data.enqueue_runnable_thread(*waiter);
+            }
+        }
+
+        // Rotate the chosen thread to the back of its level so that its
+        // same-priority peers get round-robined.
+        thread_to_schedule->m_extra_priority = 0;
+        data.dequeue_runnable_thread(*thread_to_schedule);
+        data.enqueue_runnable_thread(*thread_to_schedule);
+    } else {
         thread_to_schedule = g_colonel;
+    }
 
 #ifdef SCHEDULER_DEBUG
     dbg() << "Scheduler: Switch to " << *thread_to_schedule << " @ " << String::format("%04x:%08x", thread_to_schedule->tss().cs, thread_to_schedule->tss().eip);
@@ -492,6 +530,16 @@ bool Scheduler::context_switch(Thread& thread)
     thread.set_ticks_left(time_slice_for(thread));
     thread.did_schedule();
 
+    // Account CPU time to the outgoing thread in TSC cycles. The tick
+    // counters only resolve to whole timer ticks, so a thread that always
+    // yields before the tick fires (the audio mixer, for one) looks free
+    // under tick accounting while this counter still sees it.
+    static u64 s_last_accounting_tsc;
+    u64 now = read_tsc();
+    if (Thread::current && s_last_accounting_tsc)
+        Thread::current->accumulate_cycles(now - s_last_accounting_tsc);
+    s_last_accounting_tsc = now;
+
     if (Thread::current == &thread)
         return false;
 
@@ -599,9 +647,14 @@ void Scheduler::timer_tick(const RegisterState& regs)
     timeval tv;
     tv.tv_sec = TimeManagement::the().epoch_time();
     tv.tv_usec = TimeManagement::the().ticks_this_second() * 1000;
-    Process::update_info_page_timestamp(tv);
 
-    if (Process::current->is_profiling()) {
+    timespec monotonic_ts;
+    monotonic_ts.tv_sec = TimeManagement::the().seconds_since_boot();
+    monotonic_ts.tv_nsec = (long)TimeManagement::the().ticks_this_second() * 1'000'000;
+
+    Process::update_info_page_timestamp(tv, monotonic_ts);
+
+    if (Process::current->is_profiling() || Profiling::all_processes()) {
         SmapDisabler disabler;
         auto backtrace = Thread::current->raw_backtrace(regs.ebp, regs.eip);
         auto& sample = Profiling::next_sample_slot();
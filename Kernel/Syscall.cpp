@@ -67,6 +67,34 @@ namespace Syscall {
 
 static int handle(RegisterState&, u32 function, u32 arg1, u32 arg2, u32 arg3);
 
+bool g_latency_tracking_enabled;
+
+static u32 s_latency_histograms[Function::__Count][latency_bucket_count];
+
+const u32* latency_histogram(u32 function)
+{
+    ASSERT(function < Function::__Count);
+    return s_latency_histograms[function];
+}
+
+void clear_latency_histograms()
+{
+    memset(s_latency_histograms, 0, sizeof(s_latency_histograms));
+}
+
+static void record_latency(u32 function, u64 cycles)
+{
+    if (function >= Function::__Count)
+        return;
+    // Increments race against other threads when interrupts are enabled, but
+    // on a single CPU the worst case is a lost count, which is fine for a
+    // histogram. This keeps the hot path at a handful of instructions.
+    u32 bucket = 0;
+    while ((cycles >>= 1) && bucket < latency_bucket_count - 1)
+        ++bucket;
+    ++s_latency_histograms[function][bucket];
+}
+
 void initialize()
 {
     register_user_callable_interrupt_handler(syscall_vector, syscall_asm_entry);
@@ -83,6 +111,28 @@ static Handler s_syscall_table[] = {
 #undef __ENUMERATE_SYSCALL
 #undef __ENUMERATE_REMOVED_SYSCALL
 
+// Syscalls that only read immutable or thread-local state don't need to
+// serialize on the big process lock. Anything that touches the fd table,
+// the address space, or another process stays on the locked path.
+static bool syscall_needs_big_lock(u32 function)
+{
+    switch (function) {
+    case SC_gettid:
+    case SC_getpid:
+    case SC_getppid:
+    case SC_getuid:
+    case SC_getgid:
+    case SC_geteuid:
+    case SC_getegid:
+    case SC_getdtablesize:
+    case SC_yield:
+    case SC_donate:
+        return false;
+    default:
+        return true;
+    }
+}
+
 int handle(RegisterState& regs, u32 function, u32 arg1, u32 arg2, u32 arg3)
 {
     ASSERT_INTERRUPTS_ENABLED();
@@ -165,19 +215,26 @@ void syscall_handler(RegisterState& regs)
         ASSERT_NOT_REACHED();
     }
 
-    process.big_lock().lock();
     u32 function = regs.eax;
     u32 arg1 = regs.edx;
     u32 arg2 = regs.ecx;
     u32 arg3 = regs.ebx;
+
+    bool needs_big_lock = Syscall::syscall_needs_big_lock(function);
+    if (needs_big_lock)
+        process.big_lock().lock();
+    u64 start_cycles = Syscall::g_latency_tracking_enabled ? read_tsc() : 0;
     regs.eax = (u32)Syscall::handle(regs, function, arg1, arg2, arg3);
+    if (Syscall::g_latency_tracking_enabled)
+        Syscall::record_latency(function, read_tsc() - start_cycles);
 
     if (Thread::current->tracer() && Thread::current->tracer()->is_tracing_syscalls()) {
         Thread::current->tracer()->set_trace_syscalls(false);
         Thread::current->tracer_trap(regs);
     }
 
-    process.big_lock().unlock();
+    if (needs_big_lock)
+        process.big_lock().unlock();
 
     // Check if we're supposed to return to userspace or just die.
     Thread::current->die_if_needed();
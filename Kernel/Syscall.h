@@ -137,6 +137,7 @@ namespace Kernel {
     __ENUMERATE_SYSCALL(exit_thread)          \
     __ENUMERATE_SYSCALL(mknod)                \
     __ENUMERATE_SYSCALL(writev)               \
+    __ENUMERATE_SYSCALL(readv)                \
     __ENUMERATE_SYSCALL(beep)                 \
     __ENUMERATE_SYSCALL(getsockname)          \
     __ENUMERATE_SYSCALL(getpeername)          \
@@ -184,7 +185,12 @@ namespace Kernel {
     __ENUMERATE_SYSCALL(shutdown)             \
     __ENUMERATE_SYSCALL(get_stack_bounds)     \
     __ENUMERATE_SYSCALL(ptrace)               \
-    __ENUMERATE_SYSCALL(minherit)
+    __ENUMERATE_SYSCALL(minherit)             \
+    __ENUMERATE_SYSCALL(sendfile)             \
+    __ENUMERATE_SYSCALL(batch_stat)           \
+    __ENUMERATE_SYSCALL(sched_setaffinity)    \
+    __ENUMERATE_SYSCALL(sched_getaffinity)    \
+    __ENUMERATE_SYSCALL(spawn)
 
 namespace Syscall {
 
@@ -364,6 +370,12 @@ struct SC_execve_params {
     StringListArgument environment;
 };
 
+struct SC_spawn_params {
+    StringArgument path;
+    StringListArgument arguments;
+    StringListArgument environment;
+};
+
 struct SC_readlink_params {
     StringArgument path;
     MutableBufferArgument<char, size_t> buffer;
@@ -396,6 +408,13 @@ struct SC_rename_params {
     StringArgument new_path;
 };
 
+struct SC_sendfile_params {
+    int32_t out_fd;
+    int32_t in_fd;
+    int32_t* offset; // FIXME: 64-bit off_t?
+    uint32_t count;
+};
+
 struct SC_mount_params {
     int source_fd;
     StringArgument target;
@@ -426,6 +445,13 @@ struct SC_stat_params {
     bool follow_symlinks;
 };
 
+struct SC_batch_stat_params {
+    StringListArgument paths;
+    struct stat* statbufs; // One per path.
+    int* results;          // One per path: 0 on success, negative errno on failure.
+    bool follow_symlinks;
+};
+
 struct SC_ptrace_params {
     int request;
     pid_t pid;
@@ -441,6 +467,16 @@ struct SC_ptrace_peek_params {
 void initialize();
 int sync();
 
+#ifdef KERNEL
+// Opt-in per-syscall latency histograms. Buckets are log2 of elapsed TSC
+// cycles, so bucket N counts syscalls that took [2^N, 2^(N+1)) cycles.
+// Toggled via /proc/sys/syscall_latency, read via /proc/syscall_latency.
+static constexpr size_t latency_bucket_count = 32;
+extern bool g_latency_tracking_enabled;
+const u32* latency_histogram(u32 function);
+void clear_latency_histograms();
+#endif
+
 inline u32 invoke(Function function)
 {
     u32 result;
@@ -36,6 +36,8 @@
 
 namespace Kernel {
 
+static const size_t max_pty_buffer_capacity = 128 * KB;
+
 MasterPTY::MasterPTY(unsigned index)
     : CharacterDevice(200, index)
     , m_slave(adopt(*new SlavePTY(*this, index)))
@@ -63,7 +65,16 @@ ssize_t MasterPTY::read(FileDescription&, size_t, u8* buffer, ssize_t size)
 {
     if (!m_slave && m_buffer.is_empty())
         return 0;
-    return m_buffer.read(buffer, size);
+    ssize_t nread = m_buffer.read(buffer, size);
+    // If the slave kept filling the buffer while we drained it, give it a
+    // bigger one. DoubleBuffer can only be resized while empty, so this is
+    // the spot where that's cheap.
+    if (m_buffer_saturated && m_buffer.is_empty()) {
+        m_buffer_saturated = false;
+        if (m_buffer.capacity() < max_pty_buffer_capacity)
+            (void)m_buffer.set_capacity(min(m_buffer.capacity() * 2, max_pty_buffer_capacity));
+    }
+    return nread;
 }
 
 ssize_t MasterPTY::write(FileDescription&, size_t, const u8* buffer, ssize_t size)
@@ -101,15 +112,20 @@ ssize_t MasterPTY::on_slave_write(const u8* data, ssize_t size)
 {
     if (m_closed)
         return -EIO;
-    m_buffer.write(data, size);
-    return size;
+    ssize_t nwritten = m_buffer.write(data, size);
+    if (nwritten < size)
+        m_buffer_saturated = true;
+    return nwritten;
 }
 
 bool MasterPTY::can_write_from_slave() const
 {
     if (m_closed)
         return true;
-    return m_buffer.space_for_writing();
+    // Wake a blocked writer once there's a decent amount of room, not on the
+    // first free byte; otherwise a fast producer and a slow reader ping-pong
+    // the scheduler with a context switch per handful of bytes.
+    return m_buffer.space_for_writing() >= m_buffer.capacity() / 2;
 }
 
 void MasterPTY::close()
@@ -62,7 +62,9 @@ private:
     RefPtr<SlavePTY> m_slave;
     unsigned m_index;
     bool m_closed { false };
-    DoubleBuffer m_buffer;
+    // Starts small and grows (when drained) if the slave keeps filling it.
+    DoubleBuffer m_buffer { 16 * KB };
+    bool m_buffer_saturated { false };
     String m_pts_name;
 };
 
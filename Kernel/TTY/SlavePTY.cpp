@@ -65,10 +65,16 @@ void SlavePTY::echo(u8 ch)
     }
 }
 
+void SlavePTY::echo(const u8* data, size_t size)
+{
+    if (should_echo_input()) {
+        m_master->on_slave_write(data, (ssize_t)size);
+    }
+}
+
 void SlavePTY::on_master_write(const u8* buffer, ssize_t size)
 {
-    for (ssize_t i = 0; i < size; ++i)
-        emit(buffer[i]);
+    emit_batch(buffer, size);
 }
 
 ssize_t SlavePTY::on_tty_write(const u8* data, ssize_t size)
@@ -45,6 +45,7 @@ private:
     virtual StringView tty_name() const override;
     virtual ssize_t on_tty_write(const u8*, ssize_t) override;
     virtual void echo(u8) override;
+    virtual void echo(const u8*, size_t) override;
 
     // ^CharacterDevice
     virtual bool can_read(const FileDescription&, size_t) const override;
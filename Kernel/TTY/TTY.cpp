@@ -184,6 +184,46 @@ void TTY::emit(u8 ch)
     echo(ch);
 }
 
+void TTY::emit_batch(const u8* data, ssize_t size)
+{
+    // Queue and echo runs of plain characters in one go, and only drop down
+    // to the per-character path for the ones the line discipline actually
+    // cares about. Pasting into a canonical-mode TTY is mostly plain runs.
+    auto is_plain = [this](u8 ch) {
+        if (should_generate_signals()) {
+            if (ch == m_termios.c_cc[VINTR] || ch == m_termios.c_cc[VQUIT] || ch == m_termios.c_cc[VSUSP])
+                return false;
+        }
+        if (in_canonical_mode()) {
+            if (is_eof(ch) || is_kill(ch) || is_erase(ch) || is_werase(ch) || ch == '\n' || is_eol(ch))
+                return false;
+        }
+        return true;
+    };
+
+    ssize_t i = 0;
+    while (i < size) {
+        ssize_t run_start = i;
+        while (i < size && is_plain(data[i]))
+            ++i;
+        if (i > run_start) {
+            for (ssize_t j = run_start; j < i; ++j)
+                m_input_buffer.enqueue(data[j]);
+            echo(data + run_start, (size_t)(i - run_start));
+        }
+        if (i < size) {
+            emit(data[i]);
+            ++i;
+        }
+    }
+}
+
+void TTY::echo(const u8* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        echo(data[i]);
+}
+
 bool TTY::can_do_backspace() const
 {
     //can't do back space if we're empty. Plus, we don't want to
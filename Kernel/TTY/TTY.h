@@ -69,7 +69,9 @@ protected:
 
     TTY(unsigned major, unsigned minor);
     void emit(u8);
+    void emit_batch(const u8*, ssize_t);
     virtual void echo(u8) = 0;
+    virtual void echo(const u8*, size_t);
 
     bool can_do_backspace() const;
     void do_backspace();
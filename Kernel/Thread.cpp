@@ -317,20 +317,34 @@ void Thread::finalize()
 void Thread::finalize_dying_threads()
 {
     ASSERT(current == g_finalizer);
-    Vector<Thread*, 32> dying_threads;
-    {
-        InterruptDisabler disabler;
-        for_each_in_state(Thread::State::Dying, [&](Thread& thread) {
-            dying_threads.append(&thread);
-            return IterationDecision::Continue;
-        });
-    }
-    for (auto* thread : dying_threads) {
-        auto& process = thread->process();
-        thread->finalize();
-        delete thread;
-        if (process.m_thread_count == 0)
-            process.finalize();
+    // Reap in bounded batches so that a flood of dying threads doesn't turn
+    // into one monolithic sweep; if more remain after a batch, we re-arm the
+    // finalizer and yield, letting runnable threads in between the batches.
+    static const size_t max_threads_per_batch = 32;
+    for (;;) {
+        Vector<Thread*, max_threads_per_batch> dying_threads;
+        bool more_to_do = false;
+        {
+            InterruptDisabler disabler;
+            for_each_in_state(Thread::State::Dying, [&](Thread& thread) {
+                if (dying_threads.size() >= max_threads_per_batch) {
+                    more_to_do = true;
+                    return IterationDecision::Break;
+                }
+                dying_threads.append(&thread);
+                return IterationDecision::Continue;
+            });
+        }
+        for (auto* thread : dying_threads) {
+            auto& process = thread->process();
+            thread->finalize();
+            delete thread;
+            if (process.m_thread_count == 0)
+                process.finalize();
+        }
+        if (!more_to_do)
+            return;
+        Scheduler::yield();
     }
 }
 
@@ -745,6 +759,17 @@ bool Thread::is_thread(void* ptr)
     return thread_table().contains((Thread*)ptr);
 }
 
+void Thread::set_priority(u32 priority)
+{
+    InterruptDisabler disabler;
+    m_priority = priority;
+    // A runnable thread sits in the queue for its old effective priority;
+    // re-bucket it right away so the new priority takes effect immediately
+    // instead of at its next state transition.
+    if (m_runnable_queue_index >= 0)
+        Scheduler::update_state_for_thread(*this);
+}
+
 void Thread::set_state(State new_state)
 {
     InterruptDisabler disabler;
@@ -761,6 +786,7 @@ void Thread::set_state(State new_state)
     }
 
     m_state = new_state;
+    ++g_process_state_generation;
     if (m_process.pid() != 0) {
         Scheduler::update_state_for_thread(*this);
     }
@@ -855,12 +881,26 @@ Vector<FlatPtr> Thread::raw_backtrace(FlatPtr ebp, FlatPtr eip) const
     auto& process = const_cast<Process&>(this->process());
     ProcessPagingScope paging_scope(process);
     Vector<FlatPtr, Profiling::max_stack_frame_count> backtrace;
+    auto walk_frame_chain = [&](FlatPtr ebp) {
+        for (FlatPtr* stack_ptr = (FlatPtr*)ebp; process.validate_read_from_kernel(VirtualAddress(stack_ptr), sizeof(FlatPtr) * 2) && MM.can_read_without_faulting(process, VirtualAddress(stack_ptr), sizeof(FlatPtr) * 2); stack_ptr = (FlatPtr*)*stack_ptr) {
+            FlatPtr retaddr = stack_ptr[1];
+            backtrace.append(retaddr);
+            if (backtrace.size() == Profiling::max_stack_frame_count)
+                return;
+        }
+    };
     backtrace.append(eip);
-    for (FlatPtr* stack_ptr = (FlatPtr*)ebp; process.validate_read_from_kernel(VirtualAddress(stack_ptr), sizeof(FlatPtr) * 2) && MM.can_read_without_faulting(process, VirtualAddress(stack_ptr), sizeof(FlatPtr) * 2); stack_ptr = (FlatPtr*)*stack_ptr) {
-        FlatPtr retaddr = stack_ptr[1];
-        backtrace.append(retaddr);
-        if (backtrace.size() == Profiling::max_stack_frame_count)
-            break;
+    walk_frame_chain(ebp);
+    // If we sampled the thread while it was inside the kernel, keep walking
+    // with the userspace frames it entered from. The ring 3 register state
+    // was saved at the top of the kernel stack on entry, so this gives us
+    // mixed stacks instead of traces that stop at the syscall boundary.
+    if (!is_user_address(VirtualAddress(eip)) && !process.is_ring0() && backtrace.size() < Profiling::max_stack_frame_count) {
+        auto& regs = const_cast<Thread&>(*this).get_register_dump_from_stack();
+        if (is_user_address(VirtualAddress(regs.eip))) {
+            backtrace.append(regs.eip);
+            walk_frame_chain(regs.ebp);
+        }
     }
     return backtrace;
 }
@@ -86,7 +86,7 @@ public:
     int tid() const { return m_tid; }
     int pid() const;
 
-    void set_priority(u32 p) { m_priority = p; }
+    void set_priority(u32);
     u32 priority() const { return m_priority; }
 
     void set_priority_boost(u32 boost) { m_priority_boost = boost; }
@@ -226,9 +226,8 @@ public:
     private:
         timeval m_select_timeout;
         bool m_select_has_timeout { false };
-        const FDVector& m_select_read_fds;
-        const FDVector& m_select_write_fds;
-        const FDVector& m_select_exceptional_fds;
+        Vector<NonnullRefPtr<FileDescription>> m_select_read_descriptions;
+        Vector<NonnullRefPtr<FileDescription>> m_select_write_descriptions;
     };
 
     class WaitBlocker final : public Blocker {
@@ -286,6 +285,16 @@ public:
     const char* state_string() const;
     u32 ticks() const { return m_ticks; }
 
+    u64 cycles() const { return m_cycles; }
+    void accumulate_cycles(u64 cycles) { m_cycles += cycles; }
+
+    // One bit per processor this thread may run on. With only one
+    // processor brought up, the scheduler doesn't consult this yet; it
+    // exists so affinity policy can be expressed (and inherited) before
+    // SMP scheduling lands.
+    u32 cpu_affinity() const { return m_cpu_affinity; }
+    void set_cpu_affinity(u32 affinity) { m_cpu_affinity = affinity; }
+
     VirtualAddress thread_specific_data() const { return m_thread_specific_data; }
 
     u64 sleep(u32 ticks);
@@ -450,6 +459,7 @@ public:
 private:
     IntrusiveListNode m_runnable_list_node;
     IntrusiveListNode m_wait_queue_node;
+    int m_runnable_queue_index { -1 };
 
 private:
     friend class SchedulerData;
@@ -465,6 +475,8 @@ private:
     FarPtr m_far_ptr;
     u32 m_ticks { 0 };
     u32 m_ticks_left { 0 };
+    u64 m_cycles { 0 };
+    u32 m_cpu_affinity { 0xffffffff };
     u32 m_times_scheduled { 0 };
     u32 m_pending_signals { 0 };
     u32 m_signal_mask { 0 };
@@ -554,14 +566,37 @@ const LogStream& operator<<(const LogStream&, const Thread&);
 struct SchedulerData {
     typedef IntrusiveList<Thread, &Thread::m_runnable_list_node> ThreadList;
 
-    ThreadList m_runnable_threads;
+    // Runnable threads are kept in one ready list per priority level, with a
+    // bitmask recording which levels are non-empty, so picking the next
+    // thread doesn't require walking every runnable thread.
+    static constexpr u32 num_run_queues = 32;
+
+    static u32 run_queue_index_for(const Thread& thread)
+    {
+        u32 priority = min(thread.effective_priority(), (u32)THREAD_PRIORITY_MAX);
+        return priority * num_run_queues / (THREAD_PRIORITY_MAX + 1);
+    }
+
+    ThreadList m_run_queues[num_run_queues];
+    u32 m_nonempty_run_queues { 0 };
     ThreadList m_nonrunnable_threads;
 
-    ThreadList& thread_list_for_state(Thread::State state)
+    void enqueue_runnable_thread(Thread& thread)
     {
-        if (Thread::is_runnable_state(state))
-            return m_runnable_threads;
-        return m_nonrunnable_threads;
+        u32 index = run_queue_index_for(thread);
+        m_run_queues[index].append(thread);
+        m_nonempty_run_queues |= 1u << index;
+        thread.m_runnable_queue_index = (int)index;
+    }
+
+    void dequeue_runnable_thread(Thread& thread)
+    {
+        ASSERT(thread.m_runnable_queue_index >= 0);
+        u32 index = (u32)thread.m_runnable_queue_index;
+        m_run_queues[index].remove(thread);
+        if (m_run_queues[index].is_empty())
+            m_nonempty_run_queues &= ~(1u << index);
+        thread.m_runnable_queue_index = -1;
     }
 };
 
@@ -569,12 +604,14 @@ template<typename Callback>
 inline IterationDecision Scheduler::for_each_runnable(Callback callback)
 {
     ASSERT_INTERRUPTS_DISABLED();
-    auto& tl = g_scheduler_data->m_runnable_threads;
-    for (auto it = tl.begin(); it != tl.end();) {
-        auto& thread = *it;
-        it = ++it;
-        if (callback(thread) == IterationDecision::Break)
-            return IterationDecision::Break;
+    for (int i = SchedulerData::num_run_queues - 1; i >= 0; --i) {
+        auto& tl = g_scheduler_data->m_run_queues[i];
+        for (auto it = tl.begin(); it != tl.end();) {
+            auto& thread = *it;
+            it = ++it;
+            if (callback(thread) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
     }
 
     return IterationDecision::Continue;
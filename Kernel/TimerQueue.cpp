@@ -27,6 +27,7 @@
 #include <AK/Function.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
+#include <AK/Vector.h>
 #include <Kernel/Scheduler.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/TimerQueue.h>
@@ -45,31 +46,17 @@ TimerQueue& TimerQueue::the()
 TimerQueue::TimerQueue()
 {
     m_ticks_per_second = TimeManagement::the().ticks_per_second();
+    m_current_tick = g_uptime;
 }
 
 TimerId TimerQueue::add_timer(NonnullOwnPtr<Timer>&& timer)
 {
-    u64 timer_expiration = timer->expires;
-    ASSERT(timer_expiration >= g_uptime);
+    ASSERT(timer->expires >= g_uptime);
 
     timer->id = ++m_timer_id_count;
 
-    if (m_timer_queue.is_empty()) {
-        m_timer_queue.append(move(timer));
-        m_next_timer_due = timer_expiration;
-    } else {
-        auto following_timer = m_timer_queue.find([&timer_expiration](auto& other) { return other->expires > timer_expiration; });
-
-        if (following_timer.is_end()) {
-            m_timer_queue.append(move(timer));
-        } else {
-            auto next_timer_needs_update = following_timer.is_begin();
-            m_timer_queue.insert_before(following_timer, move(timer));
-
-            if (next_timer_needs_update)
-                m_next_timer_due = timer_expiration;
-        }
-    }
+    m_wheel[timer->expires & (timer_wheel_size - 1)].append(move(timer));
+    ++m_timer_count;
 
     return m_timer_id_count;
 }
@@ -84,40 +71,47 @@ TimerId TimerQueue::add_timer(timeval& deadline, Function<void()>&& callback)
 
 bool TimerQueue::cancel_timer(TimerId id)
 {
-    auto it = m_timer_queue.find([id](auto& timer) { return timer->id == id; });
-    if (it.is_end())
-        return false;
-
-    auto was_next_timer = it.is_begin();
-    m_timer_queue.remove(it);
-
-    if (was_next_timer)
-        update_next_timer_due();
-
-    return true;
+    for (auto& slot : m_wheel) {
+        auto it = slot.find([id](auto& timer) { return timer->id == id; });
+        if (!it.is_end()) {
+            slot.remove(it);
+            --m_timer_count;
+            return true;
+        }
+    }
+    return false;
 }
 
 void TimerQueue::fire()
 {
-    if (m_timer_queue.is_empty())
+    if (m_current_tick + 1 >= g_uptime) {
+        if (!m_timer_count)
+            m_current_tick = g_uptime ? g_uptime - 1 : 0;
         return;
-
-    ASSERT(m_next_timer_due == m_timer_queue.first()->expires);
-
-    while (!m_timer_queue.is_empty() && g_uptime > m_timer_queue.first()->expires) {
-        auto timer = m_timer_queue.take_first();
-        timer->callback();
     }
 
-    update_next_timer_due();
-}
+    // Visit every slot between the last tick we processed and now; normally
+    // that's exactly one. A timer fires on the first tick after its expiry,
+    // so a slot entry whose expiry is still in the future belongs to a later
+    // rotation of the wheel and is left alone.
+    Vector<Function<void()>, 8> expired_callbacks;
+    while (m_current_tick + 1 < g_uptime) {
+        ++m_current_tick;
+        if (!m_timer_count)
+            continue;
+        auto& slot = m_wheel[m_current_tick & (timer_wheel_size - 1)];
+        for (;;) {
+            auto it = slot.find([this](auto& timer) { return timer->expires <= m_current_tick; });
+            if (it.is_end())
+                break;
+            expired_callbacks.append(move((*it)->callback));
+            slot.remove(it);
+            --m_timer_count;
+        }
+    }
 
-void TimerQueue::update_next_timer_due()
-{
-    if (m_timer_queue.is_empty())
-        m_next_timer_due = 0;
-    else
-        m_next_timer_due = m_timer_queue.first()->expires;
+    for (auto& callback : expired_callbacks)
+        callback();
 }
 
 }
@@ -66,15 +66,20 @@ public:
 private:
     TimerQueue();
 
-    void update_next_timer_due();
-
     u64 microseconds_to_ticks(u64 micro_seconds) { return micro_seconds * (m_ticks_per_second / 1'000'000); }
     u64 seconds_to_ticks(u64 seconds) { return seconds * m_ticks_per_second; }
 
-    u64 m_next_timer_due { 0 };
+    // Hashed timing wheel: a timer lives in the slot its expiry tick hashes
+    // to, so insertion is O(1) and each tick only looks at a single slot.
+    // Timers due on a later rotation of the wheel just stay in their slot
+    // until their expiry tick actually comes around.
+    static constexpr u64 timer_wheel_size = 256;
+
+    u64 m_current_tick { 0 };
     u64 m_timer_id_count { 0 };
     u64 m_ticks_per_second { 0 };
-    SinglyLinkedList<NonnullOwnPtr<Timer>> m_timer_queue;
+    size_t m_timer_count { 0 };
+    SinglyLinkedList<NonnullOwnPtr<Timer>> m_wheel[timer_wheel_size];
 };
 
 }
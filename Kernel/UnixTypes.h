@@ -57,6 +57,9 @@
 #define MAP_ANON MAP_ANONYMOUS
 #define MAP_STACK 0x40
 #define MAP_PURGEABLE 0x80
+#define MAP_POPULATE 0x100
+
+#define WATCH_FILE_RECURSIVE (1 << 0)
 
 #define PROT_READ 0x1
 #define PROT_WRITE 0x2
@@ -404,6 +407,8 @@ struct pollfd {
 #define SO_PEERCRED 5
 #define SO_REUSEADDR 6
 #define SO_BINDTODEVICE 7
+#define SO_SNDBUF 8
+#define SO_RCVBUF 10
 
 #define IPPROTO_IP 0
 #define IPPROTO_ICMP 1
@@ -412,6 +417,8 @@ struct pollfd {
 
 #define IP_TTL 2
 
+#define TCP_NODELAY 10
+
 struct ucred {
     pid_t pid;
     uid_t uid;
@@ -279,11 +279,8 @@ Region* MemoryManager::kernel_region_from_vaddr(VirtualAddress vaddr)
 
 Region* MemoryManager::user_region_from_vaddr(Process& process, VirtualAddress vaddr)
 {
-    // FIXME: Use a binary search tree (maybe red/black?) or some other more appropriate data structure!
-    for (auto& region : process.m_regions) {
-        if (region.contains(vaddr))
-            return &region;
-    }
+    if (auto* region = process.region_containing({ vaddr, 1 }))
+        return region;
 #ifdef MM_DEBUG
     dbg() << process << " Couldn't find user region for " << vaddr;
 #endif
@@ -431,9 +428,61 @@ RefPtr<PhysicalPage> MemoryManager::find_free_user_physical_page()
     return page;
 }
 
+void MemoryManager::refill_zeroed_page_pool()
+{
+    // Pre-zeroing is a luxury; don't start eating into memory the system
+    // actually needs. Keep a generous reserve of truly free pages.
+    static const size_t free_page_reserve = 1024;
+    for (;;) {
+        InterruptDisabler disabler;
+        if (m_zeroed_free_pages.size() >= zeroed_page_pool_capacity)
+            return;
+        if (m_user_physical_pages - m_user_physical_pages_used < free_page_reserve)
+            return;
+        auto page = find_free_user_physical_page();
+        if (!page)
+            return;
+        auto* ptr = quickmap_page(*page);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+        m_zeroed_free_pages.append(move(page));
+    }
+}
+
+int MemoryManager::purge_volatile_memory()
+{
+    int purged_page_count = 0;
+    for_each_vmobject([&](auto& vmobject) {
+        if (vmobject.is_purgeable())
+            purged_page_count += static_cast<PurgeableVMObject&>(vmobject).purge_with_interrupts_disabled({});
+        return IterationDecision::Continue;
+    });
+    return purged_page_count;
+}
+
 RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill should_zero_fill)
 {
     InterruptDisabler disabler;
+
+    // Purge volatile memory proactively when we cross the low watermark,
+    // instead of waiting until we're completely out of pages. One purge per
+    // crossing; the flag rearms once we climb back above the watermark.
+    if (is_under_memory_pressure()) {
+        if (!m_has_purged_under_memory_pressure) {
+            m_has_purged_under_memory_pressure = true;
+            int purged_page_count = purge_volatile_memory();
+            if (purged_page_count)
+                klog() << "MM: Memory pressure, purged " << purged_page_count << " volatile pages";
+        }
+    } else {
+        m_has_purged_under_memory_pressure = false;
+    }
+
+    if (should_zero_fill == ShouldZeroFill::Yes && !m_zeroed_free_pages.is_empty()) {
+        ++m_user_physical_pages_used;
+        return m_zeroed_free_pages.take_last();
+    }
+
     RefPtr<PhysicalPage> page = find_free_user_physical_page();
 
     if (!page) {
@@ -441,19 +490,12 @@ RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill s
             klog() << "MM: no user physical regions available (?)";
         }
 
-        for_each_vmobject([&](auto& vmobject) {
-            if (vmobject.is_purgeable()) {
-                auto& purgeable_vmobject = static_cast<PurgeableVMObject&>(vmobject);
-                int purged_page_count = purgeable_vmobject.purge_with_interrupts_disabled({});
-                if (purged_page_count) {
-                    klog() << "MM: Purge saved the day! Purged " << purged_page_count << " pages from PurgeableVMObject{" << &purgeable_vmobject << "}";
-                    page = find_free_user_physical_page();
-                    ASSERT(page);
-                    return IterationDecision::Break;
-                }
-            }
-            return IterationDecision::Continue;
-        });
+        int purged_page_count = purge_volatile_memory();
+        if (purged_page_count) {
+            klog() << "MM: Purge saved the day! Purged " << purged_page_count << " pages";
+            page = find_free_user_physical_page();
+            ASSERT(page);
+        }
 
         if (!page) {
             klog() << "MM: no user physical pages available";
@@ -567,15 +609,24 @@ void MemoryManager::flush_entire_tlb()
     write_cr3(read_cr3());
 }
 
-void MemoryManager::flush_tlb(VirtualAddress vaddr)
+void MemoryManager::flush_tlb(VirtualAddress vaddr, size_t page_count)
 {
 #ifdef MM_DEBUG
-    dbg() << "MM: Flush page " << vaddr;
+    dbg() << "MM: Flush " << page_count << " pages at " << vaddr;
 #endif
-    asm volatile("invlpg %0"
-                 :
-                 : "m"(*(char*)vaddr.get())
-                 : "memory");
+    // Above a certain range size it's cheaper to reload CR3 and let the TLB
+    // repopulate than to issue one invlpg per page.
+    static const size_t full_flush_threshold = 32;
+    if (page_count >= full_flush_threshold) {
+        flush_entire_tlb();
+        return;
+    }
+    for (size_t i = 0; i < page_count; ++i) {
+        asm volatile("invlpg %0"
+                     :
+                     : "m"(*(char*)vaddr.offset(i * PAGE_SIZE).get())
+                     : "memory");
+    }
 }
 
 extern "C" PageTableEntry boot_pd3_pde1023_pt[1024];
@@ -99,6 +99,7 @@ public:
     };
 
     RefPtr<PhysicalPage> allocate_user_physical_page(ShouldZeroFill = ShouldZeroFill::Yes);
+    void refill_zeroed_page_pool();
     RefPtr<PhysicalPage> allocate_supervisor_physical_page();
     Vector<RefPtr<PhysicalPage>> allocate_contiguous_supervisor_physical_pages(size_t size);
     void deallocate_user_physical_page(PhysicalPage&&);
@@ -111,6 +112,10 @@ public:
     OwnPtr<Region> allocate_kernel_region_with_vmobject(const Range&, VMObject&, const StringView& name, u8 access, bool user_accessible = false, bool cacheable = true);
     OwnPtr<Region> allocate_user_accessible_kernel_region(size_t, const StringView& name, u8 access, bool cacheable = true);
 
+    // True when free user physical memory has dropped below the low
+    // watermark. Caches should shrink when they see this.
+    bool is_under_memory_pressure() const { return m_user_physical_pages - m_user_physical_pages_used < low_memory_watermark_pages; }
+
     unsigned user_physical_pages() const { return m_user_physical_pages; }
     unsigned user_physical_pages_used() const { return m_user_physical_pages_used; }
     unsigned super_physical_pages() const { return m_super_physical_pages; }
@@ -154,7 +159,7 @@ private:
     void protect_kernel_image();
     void parse_memory_map();
     void flush_entire_tlb();
-    void flush_tlb(VirtualAddress);
+    void flush_tlb(VirtualAddress, size_t page_count = 1);
 
     static Region* user_region_from_vaddr(Process&, VirtualAddress);
     static Region* kernel_region_from_vaddr(VirtualAddress);
@@ -162,6 +167,7 @@ private:
     static Region* region_from_vaddr(VirtualAddress);
 
     RefPtr<PhysicalPage> find_free_user_physical_page();
+    int purge_volatile_memory();
     u8* quickmap_page(PhysicalPage&);
     void unquickmap_page();
 
@@ -178,6 +184,14 @@ private:
 
     RefPtr<PhysicalPage> m_shared_zero_page;
 
+    // Pages zeroed ahead of time (by PageZeroingTask) so that anonymous
+    // page faults can usually skip the inline memset.
+    static const size_t zeroed_page_pool_capacity = 64;
+    Vector<RefPtr<PhysicalPage>> m_zeroed_free_pages;
+
+    static const unsigned low_memory_watermark_pages = 512;
+    bool m_has_purged_under_memory_pressure { false };
+
     unsigned m_user_physical_pages { 0 };
     unsigned m_user_physical_pages_used { 0 };
     unsigned m_super_physical_pages { 0 };
@@ -61,6 +61,12 @@ unsigned PhysicalRegion::finalize_capacity()
     m_pages = (m_upper.get() - m_lower.get()) / PAGE_SIZE;
     m_bitmap.grow(m_pages, false);
 
+    // Populate the free stack in reverse so that pages pop out in ascending
+    // address order.
+    m_free_list.ensure_capacity(m_pages);
+    for (unsigned page = m_pages; page > 0; --page)
+        m_free_list.unchecked_append(page - 1);
+
     return size();
 }
 
@@ -113,10 +119,17 @@ RefPtr<PhysicalPage> PhysicalRegion::take_free_page(bool supervisor)
 {
     ASSERT(m_pages);
 
-    if (m_used == m_pages)
-        return nullptr;
-
-    return PhysicalPage::create(m_lower.offset(find_contiguous_free_pages(1) * PAGE_SIZE), supervisor);
+    while (!m_free_list.is_empty()) {
+        auto page = m_free_list.take_last();
+        // Stale entry: a contiguous allocation already claimed this page
+        // through the bitmap.
+        if (m_bitmap.get(page))
+            continue;
+        m_bitmap.set(page, true);
+        m_used++;
+        return PhysicalPage::create(m_lower.offset(page * PAGE_SIZE), supervisor);
+    }
+    return nullptr;
 }
 
 void PhysicalRegion::return_page_at(PhysicalAddress addr)
@@ -136,6 +149,7 @@ void PhysicalRegion::return_page_at(PhysicalAddress addr)
         m_last = page;
 
     m_bitmap.set(page, false);
+    m_free_list.append(page);
     m_used--;
 }
 
@@ -30,6 +30,7 @@
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <AK/Vector.h>
 #include <Kernel/VM/PhysicalPage.h>
 
 namespace Kernel {
@@ -68,6 +69,10 @@ private:
     unsigned m_used { 0 };
     unsigned m_last { 0 };
     Bitmap m_bitmap;
+    // Stack of free page indices so single-page allocation doesn't have to
+    // scan the bitmap. Entries go stale when a contiguous allocation claims
+    // pages through the bitmap; take_free_page() skips those lazily.
+    Vector<unsigned> m_free_list;
 };
 
 }
@@ -24,8 +24,6 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <AK/BinarySearch.h>
-#include <AK/QuickSort.h>
 #include <Kernel/Random.h>
 #include <Kernel/Thread.h>
 #include <Kernel/VM/RangeAllocator.h>
@@ -43,6 +41,7 @@ void RangeAllocator::initialize_with_range(VirtualAddress base, size_t size)
 {
     m_total_range = { base, size };
     m_available_ranges.append({ base, size });
+    m_ranges_by_size.append({ base, size });
 #ifdef VRA_DEBUG
     dump();
 #endif
@@ -52,6 +51,7 @@ void RangeAllocator::initialize_from_parent(const RangeAllocator& parent_allocat
 {
     m_total_range = parent_allocator.m_total_range;
     m_available_ranges = parent_allocator.m_available_ranges;
+    m_ranges_by_size = parent_allocator.m_ranges_by_size;
 }
 
 RangeAllocator::~RangeAllocator()
@@ -83,13 +83,70 @@ Vector<Range, 2> Range::carve(const Range& taken)
     return parts;
 }
 
-void RangeAllocator::carve_at_index(int index, const Range& range)
+static int compare_by_size(const Range& a, const Range& b)
 {
-    auto remaining_parts = m_available_ranges[index].carve(range);
-    ASSERT(remaining_parts.size() >= 1);
-    m_available_ranges[index] = remaining_parts[0];
-    if (remaining_parts.size() == 2)
-        m_available_ranges.insert(index + 1, move(remaining_parts[1]));
+    if (a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+    if (a.base() != b.base())
+        return a.base() < b.base() ? -1 : 1;
+    return 0;
+}
+
+static size_t first_index_with_base_at_least(const Vector<Range>& ranges, VirtualAddress base)
+{
+    size_t low = 0;
+    size_t high = ranges.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (ranges[middle].base() < base)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+static size_t first_index_with_size_at_least(const Vector<Range>& ranges, size_t size)
+{
+    size_t low = 0;
+    size_t high = ranges.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (ranges[middle].size() < size)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+void RangeAllocator::insert_available_range(const Range& range)
+{
+    m_available_ranges.insert(first_index_with_base_at_least(m_available_ranges, range.base()), Range(range));
+
+    size_t low = 0;
+    size_t high = m_ranges_by_size.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (compare_by_size(m_ranges_by_size[middle], range) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    m_ranges_by_size.insert(low, Range(range));
+}
+
+void RangeAllocator::remove_available_range(const Range& range)
+{
+    auto address_index = first_index_with_base_at_least(m_available_ranges, range.base());
+    ASSERT(address_index < m_available_ranges.size() && m_available_ranges[address_index] == range);
+    m_available_ranges.remove(address_index);
+
+    auto size_index = first_index_with_size_at_least(m_ranges_by_size, range.size());
+    while (size_index < m_ranges_by_size.size() && !(m_ranges_by_size[size_index] == range))
+        ++size_index;
+    ASSERT(size_index < m_ranges_by_size.size());
+    m_ranges_by_size.remove(size_index);
 }
 
 Range RangeAllocator::allocate_anywhere(size_t size, size_t alignment)
@@ -106,32 +163,27 @@ Range RangeAllocator::allocate_anywhere(size_t size, size_t alignment)
     size_t offset_from_effective_base = 0;
 #endif
 
-    for (size_t i = 0; i < m_available_ranges.size(); ++i) {
-        auto& available_range = m_available_ranges[i];
-        // FIXME: This check is probably excluding some valid candidates when using a large alignment.
-        if (available_range.size() < (effective_size + alignment))
-            continue;
+    // Best fit: the smallest available range that can hold the allocation.
+    // FIXME: This check is probably excluding some valid candidates when using a large alignment.
+    auto index = first_index_with_size_at_least(m_ranges_by_size, effective_size + alignment);
+    if (index == m_ranges_by_size.size()) {
+        klog() << "VRA: Failed to allocate anywhere: " << size << ", " << alignment;
+        return {};
+    }
+    auto available_range = m_ranges_by_size[index];
 
-        FlatPtr initial_base = available_range.base().offset(offset_from_effective_base).get();
-        FlatPtr aligned_base = round_up_to_power_of_two(initial_base, alignment);
+    FlatPtr initial_base = available_range.base().offset(offset_from_effective_base).get();
+    FlatPtr aligned_base = round_up_to_power_of_two(initial_base, alignment);
 
-        Range allocated_range(VirtualAddress(aligned_base), size);
-        if (available_range == allocated_range) {
+    Range allocated_range(VirtualAddress(aligned_base), size);
+    remove_available_range(available_range);
+    for (auto& part : available_range.carve(allocated_range))
+        insert_available_range(part);
 #ifdef VRA_DEBUG
-            dbg() << "VRA: Allocated perfect-fit anywhere(" << String::format("%zu", size) << ", " << String::format("%zu", alignment) << "): " << String::format("%x", allocated_range.base().get());
-#endif
-            m_available_ranges.remove(i);
-            return allocated_range;
-        }
-        carve_at_index(i, allocated_range);
-#ifdef VRA_DEBUG
-        dbg() << "VRA: Allocated anywhere(" << String::format("%zu", size) << ", " << String::format("%zu", alignment) << "): " << String::format("%x", allocated_range.base().get());
-        dump();
+    dbg() << "VRA: Allocated anywhere(" << String::format("%zu", size) << ", " << String::format("%zu", alignment) << "): " << String::format("%x", allocated_range.base().get());
+    dump();
 #endif
-        return allocated_range;
-    }
-    klog() << "VRA: Failed to allocate anywhere: " << size << ", " << alignment;
-    return {};
+    return allocated_range;
 }
 
 Range RangeAllocator::allocate_specific(VirtualAddress base, size_t size)
@@ -140,23 +192,28 @@ Range RangeAllocator::allocate_specific(VirtualAddress base, size_t size)
         return {};
 
     Range allocated_range(base, size);
-    for (size_t i = 0; i < m_available_ranges.size(); ++i) {
-        auto& available_range = m_available_ranges[i];
-        if (!available_range.contains(base, size))
-            continue;
-        if (available_range == allocated_range) {
-            m_available_ranges.remove(i);
-            return allocated_range;
+    // The candidate is the last available range starting at or below base.
+    auto index = first_index_with_base_at_least(m_available_ranges, base);
+    if (index == m_available_ranges.size() || m_available_ranges[index].base() > base) {
+        if (index == 0) {
+            dbg() << "VRA: Failed to allocate specific range: " << base << "(" << size << ")";
+            return {};
         }
-        carve_at_index(i, allocated_range);
+        --index;
+    }
+    auto available_range = m_available_ranges[index];
+    if (!available_range.contains(base, size)) {
+        dbg() << "VRA: Failed to allocate specific range: " << base << "(" << size << ")";
+        return {};
+    }
+    remove_available_range(available_range);
+    for (auto& part : available_range.carve(allocated_range))
+        insert_available_range(part);
 #ifdef VRA_DEBUG
-        dbg() << "VRA: Allocated specific(" << size << "): " << String::format("%x", available_range.base().get());
-        dump();
+    dbg() << "VRA: Allocated specific(" << size << "): " << String::format("%x", available_range.base().get());
+    dump();
 #endif
-        return allocated_range;
-    }
-    dbg() << "VRA: Failed to allocate specific range: " << base << "(" << size << ")";
-    return {};
+    return allocated_range;
 }
 
 void RangeAllocator::deallocate(Range range)
@@ -170,37 +227,22 @@ void RangeAllocator::deallocate(Range range)
     dump();
 #endif
 
-    ASSERT(!m_available_ranges.is_empty());
-
-    int nearby_index = 0;
-    auto* existing_range = binary_search(
-        m_available_ranges.data(), m_available_ranges.size(), range, [](auto& a, auto& b) {
-            return a.base().get() - b.end().get();
-        },
-        &nearby_index);
-
-    size_t inserted_index = 0;
-    if (existing_range) {
-        existing_range->m_size += range.size();
-        inserted_index = nearby_index;
-    } else {
-        m_available_ranges.insert_before_matching(
-            Range(range), [&](auto& entry) {
-                return entry.base() >= range.end();
-            },
-            nearby_index, &inserted_index);
+    // Coalesce with the free neighbors on either side, then insert the
+    // merged range back into both sort orders.
+    Range merged_range = range;
+    auto index = first_index_with_base_at_least(m_available_ranges, range.base());
+    if (index > 0 && m_available_ranges[index - 1].end() == range.base()) {
+        auto predecessor = m_available_ranges[index - 1];
+        remove_available_range(predecessor);
+        merged_range = { predecessor.base(), predecessor.size() + merged_range.size() };
+        --index;
     }
-
-    if (inserted_index < (m_available_ranges.size() - 1)) {
-        // We already merged with previous. Try to merge with next.
-        auto& inserted_range = m_available_ranges[inserted_index];
-        auto& next_range = m_available_ranges[inserted_index + 1];
-        if (inserted_range.end() == next_range.base()) {
-            inserted_range.m_size += next_range.size();
-            m_available_ranges.remove(inserted_index + 1);
-            return;
-        }
+    if (index < m_available_ranges.size() && m_available_ranges[index].base() == merged_range.end()) {
+        auto successor = m_available_ranges[index];
+        remove_available_range(successor);
+        merged_range = { merged_range.base(), merged_range.size() + successor.size() };
     }
+    insert_available_range(merged_range);
 #ifdef VRA_DEBUG
     dbg() << "VRA: After deallocate";
     dump();
@@ -91,9 +91,14 @@ public:
     void dump() const;
 
 private:
-    void carve_at_index(int, const Range&);
+    void insert_available_range(const Range&);
+    void remove_available_range(const Range&);
 
+    // The same set of free ranges, kept in two sort orders: by base address
+    // for allocate_specific() and coalescing on deallocate(), and by
+    // (size, base) so allocate_anywhere() can binary-search for a best fit.
     Vector<Range> m_available_ranges;
+    Vector<Range> m_ranges_by_size;
     Range m_total_range;
 };
 
@@ -242,7 +242,6 @@ void Region::map_individual_page_impl(size_t page_index)
         dbg() << "MM: >> region map (PD=" << m_page_directory->cr3() << ", PTE=" << (void*)pte.raw() << "{" << &pte << "}) " << name() << " " << page_vaddr << " => " << page->paddr() << " (@" << page << ")";
 #endif
     }
-    MM.flush_tlb(page_vaddr);
 }
 
 void Region::remap_page(size_t page_index)
@@ -251,6 +250,7 @@ void Region::remap_page(size_t page_index)
     InterruptDisabler disabler;
     ASSERT(physical_page(page_index));
     map_individual_page_impl(page_index);
+    MM.flush_tlb(vaddr().offset(page_index * PAGE_SIZE));
 }
 
 void Region::unmap(ShouldDeallocateVirtualMemoryRange deallocate_range)
@@ -261,12 +261,12 @@ void Region::unmap(ShouldDeallocateVirtualMemoryRange deallocate_range)
         auto vaddr = this->vaddr().offset(i * PAGE_SIZE);
         auto& pte = MM.ensure_pte(*m_page_directory, vaddr);
         pte.clear();
-        MM.flush_tlb(vaddr);
 #ifdef MM_DEBUG
         auto* page = physical_page(i);
         dbg() << "MM: >> Unmapped " << vaddr << " => P" << String::format("%p", page ? page->paddr().get() : 0) << " <<";
 #endif
     }
+    MM.flush_tlb(vaddr(), page_count());
     if (deallocate_range == ShouldDeallocateVirtualMemoryRange::Yes)
         m_page_directory->range_allocator().deallocate(range());
     m_page_directory = nullptr;
@@ -287,6 +287,16 @@ void Region::map(PageDirectory& page_directory)
 #endif
     for (size_t page_index = 0; page_index < page_count(); ++page_index)
         map_individual_page_impl(page_index);
+    MM.flush_tlb(vaddr(), page_count());
+}
+
+void Region::map_lazily(PageDirectory& page_directory)
+{
+    // Attach to the page directory without writing any PTEs. Every page
+    // starts out not-present and gets filled in by handle_fault() on first
+    // touch, so a fork that's immediately followed by exec never pays for
+    // page tables the child wasn't going to use.
+    set_page_directory(page_directory);
 }
 
 void Region::remap()
@@ -313,6 +323,23 @@ PageFaultResponse Region::handle_fault(const PageFault& fault)
 #endif
             return handle_inode_fault(page_index_in_region);
         }
+        // A not-present fault may simply mean the PTE hasn't been written
+        // yet even though the VMObject already has a page: fork() attaches
+        // the child's regions lazily via map_lazily(). Map the page in, and
+        // take the usual zero/COW paths if this was a write to a page we
+        // still share with someone.
+        if (auto* page = physical_page(page_index_in_region)) {
+            if (page->is_shared_zero_page()) {
+                if (fault.is_write())
+                    return handle_zero_fault(page_index_in_region);
+                remap_page(page_index_in_region);
+                return PageFaultResponse::Continue;
+            }
+            remap_page(page_index_in_region);
+            if (fault.is_write() && should_cow(page_index_in_region))
+                return handle_cow_fault(page_index_in_region);
+            return PageFaultResponse::Continue;
+        }
 #ifdef MAP_SHARED_ZERO_PAGE_LAZILY
         if (fault.is_read()) {
             physical_page_slot(page_index_in_region) = MM.shared_zero_page();
@@ -163,6 +163,7 @@ public:
 
     void set_page_directory(PageDirectory&);
     void map(PageDirectory&);
+    void map_lazily(PageDirectory&);
     enum class ShouldDeallocateVirtualMemoryRange {
         No,
         Yes,
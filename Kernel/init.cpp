@@ -70,7 +70,9 @@
 #include <Kernel/Scheduler.h>
 #include <Kernel/TTY/PTYMultiplexer.h>
 #include <Kernel/TTY/VirtualConsole.h>
+#include <Kernel/Tasks/DebugLogTask.h>
 #include <Kernel/Tasks/FinalizerTask.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
 #include <Kernel/Tasks/SyncTask.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/VM/MemoryManager.h>
@@ -165,6 +167,8 @@ void init_stage2()
 {
     SyncTask::spawn();
     FinalizerTask::spawn();
+    PageZeroingTask::spawn();
+    DebugLogTask::spawn();
 
     PCI::initialize();
 
@@ -192,10 +196,20 @@ void init_stage2()
         }
     }
 
-    E1000NetworkAdapter::detect();
-    RTL8139NetworkAdapter::detect();
-
-    LoopbackAdapter::the();
+    // Network adapter probing is independent of the disk/VFS critical path
+    // below, so do it on its own kernel thread; PATAChannel spends a fair
+    // amount of time waiting on the drive, and the PCI scans for the
+    // adapters can overlap with that. NetworkTask is spawned from here as
+    // well, since it configures the adapters it finds at startup.
+    Thread* network_probe_thread = nullptr;
+    Process::create_kernel_process(network_probe_thread, "NetworkProbe", [] {
+        E1000NetworkAdapter::detect();
+        RTL8139NetworkAdapter::detect();
+        LoopbackAdapter::the();
+        NetworkTask::spawn();
+        Process::current->sys$exit(0);
+        ASSERT_NOT_REACHED();
+    });
 
     Syscall::initialize();
 
@@ -325,8 +339,6 @@ void init_stage2()
         thread->set_priority(THREAD_PRIORITY_HIGH);
     }
 
-    NetworkTask::spawn();
-
     Process::current->sys$exit(0);
     ASSERT_NOT_REACHED();
 }
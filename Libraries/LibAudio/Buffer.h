@@ -28,6 +28,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/SharedBuffer.h>
+#include <AK/SharedBufferPool.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <string.h>
@@ -89,8 +90,8 @@ struct Sample {
 };
 
 // Small helper to resample from one playback rate to another
-// This isn't really "smart", in that we just insert (or drop) samples.
-// Should do better...
+// Output samples are linearly interpolated between the two nearest
+// source samples.
 class ResampleHelper {
 public:
     ResampleHelper(double source, double target);
@@ -103,6 +104,8 @@ private:
     double m_current_ratio { 0 };
     double m_last_sample_l { 0 };
     double m_last_sample_r { 0 };
+    double m_previous_sample_l { 0 };
+    double m_previous_sample_r { 0 };
 };
 
 // A buffer of audio samples, normalized to 44100hz.
@@ -127,7 +130,7 @@ public:
 
 private:
     explicit Buffer(Vector<Sample>&& samples)
-        : m_buffer(*SharedBuffer::create_with_size(samples.size() * sizeof(Sample)))
+        : m_buffer(*SharedBufferPool::the().acquire(samples.size() * sizeof(Sample)))
         , m_sample_count(samples.size())
     {
         memcpy(m_buffer->data(), samples.data(), samples.size() * sizeof(Sample));
@@ -25,6 +25,7 @@
  */
 
 #include <AK/SharedBuffer.h>
+#include <AK/SharedBufferPool.h>
 #include <LibAudio/Buffer.h>
 #include <LibAudio/ClientConnection.h>
 
@@ -46,8 +47,10 @@ void ClientConnection::enqueue(const Buffer& buffer)
     for (;;) {
         const_cast<Buffer&>(buffer).shared_buffer().share_with(server_pid());
         auto response = send_sync<Messages::AudioServer::EnqueueBuffer>(buffer.shbuf_id(), buffer.sample_count());
-        if (response->success())
+        if (response->success()) {
+            m_enqueued_buffers.set(buffer.shbuf_id(), const_cast<Buffer&>(buffer));
             break;
+        }
         sleep(1);
     }
 }
@@ -56,6 +59,8 @@ bool ClientConnection::try_enqueue(const Buffer& buffer)
 {
     const_cast<Buffer&>(buffer).shared_buffer().share_with(server_pid());
     auto response = send_sync<Messages::AudioServer::EnqueueBuffer>(buffer.shbuf_id(), buffer.sample_count());
+    if (response->success())
+        m_enqueued_buffers.set(buffer.shbuf_id(), const_cast<Buffer&>(buffer));
     return response->success();
 }
 
@@ -104,8 +109,23 @@ int ClientConnection::get_playing_buffer()
     return send_sync<Messages::AudioServer::GetPlayingBuffer>()->buffer_id();
 }
 
+int ClientConnection::get_enqueued_buffers()
+{
+    return send_sync<Messages::AudioServer::GetEnqueuedBuffers>()->buffer_count();
+}
+
 void ClientConnection::handle(const Messages::AudioClient::FinishedPlayingBuffer& message)
 {
+    auto it = m_enqueued_buffers.find(message.buffer_id());
+    if (it != m_enqueued_buffers.end()) {
+        auto buffer = it->value;
+        m_enqueued_buffers.remove(it);
+        // If we were the last ones holding on to this buffer, the server is
+        // done with it too, and its shared memory can be handed out again.
+        if (buffer->ref_count() == 1)
+            SharedBufferPool::the().recycle(buffer->shared_buffer());
+    }
+
     if (on_finish_playing_buffer)
         on_finish_playing_buffer(message.buffer_id());
 }
@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
 #include <AudioServer/AudioClientEndpoint.h>
 #include <AudioServer/AudioServerEndpoint.h>
 #include <LibIPC/ServerConnection.h>
@@ -53,6 +55,7 @@ public:
     int get_remaining_samples();
     int get_played_samples();
     int get_playing_buffer();
+    int get_enqueued_buffers();
 
     void set_paused(bool paused);
     void clear_buffer(bool paused = false);
@@ -63,6 +66,11 @@ public:
 private:
     virtual void handle(const Messages::AudioClient::FinishedPlayingBuffer&) override;
     virtual void handle(const Messages::AudioClient::MutedStateChanged&) override;
+
+    // Buffers we've enqueued but the server hasn't finished playing yet.
+    // Keeping them alive lets us recycle their shared memory once the server
+    // tells us it's done with them.
+    HashMap<i32, NonnullRefPtr<Buffer>> m_enqueued_buffers;
 };
 
 }
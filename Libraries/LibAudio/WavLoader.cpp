@@ -190,6 +190,8 @@ ResampleHelper::ResampleHelper(double source, double target)
 
 void ResampleHelper::process_sample(double sample_l, double sample_r)
 {
+    m_previous_sample_l = m_last_sample_l;
+    m_previous_sample_r = m_last_sample_r;
     m_last_sample_l = sample_l;
     m_last_sample_r = sample_r;
     m_current_ratio += 1;
@@ -198,9 +200,15 @@ void ResampleHelper::process_sample(double sample_l, double sample_r)
 bool ResampleHelper::read_sample(double& next_l, double& next_r)
 {
     if (m_current_ratio > 0) {
+        // Interpolate between the previous and the current source sample;
+        // repeating whichever sample is nearest (what we used to do) aliases
+        // audibly when upsampling low-rate files.
+        double fraction = 1 - m_current_ratio;
+        if (fraction < 0)
+            fraction = 0;
+        next_l = m_previous_sample_l + (m_last_sample_l - m_previous_sample_l) * fraction;
+        next_r = m_previous_sample_r + (m_last_sample_r - m_previous_sample_r) * fraction;
         m_current_ratio -= m_ratio;
-        next_l = m_last_sample_l;
-        next_r = m_last_sample_r;
         return true;
     }
 
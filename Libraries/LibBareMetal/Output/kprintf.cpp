@@ -96,10 +96,85 @@ static void serial_putch(char ch)
         was_cr = false;
 }
 
+#if defined(KERNEL)
+// Staging ring for serial debug output. Once the DebugLogTask is up,
+// characters headed for the UART are parked here and drained by the task,
+// so the logging thread no longer busy-waits at baud rate for every
+// character. Until then (early boot), output falls through synchronously.
+// On overflow we overwrite the oldest characters, dmesg-style, and keep
+// count so the drainer can report the loss.
+static const size_t debug_log_ring_size = 65536;
+static char s_debug_log_ring[debug_log_ring_size];
+static size_t s_debug_log_head;
+static size_t s_debug_log_tail;
+static size_t s_debug_log_dropped;
+static bool s_debug_log_ring_enabled;
+
+static void debug_ring_put(char ch)
+{
+    if (!s_debug_log_ring_enabled) {
+        serial_putch(ch);
+        return;
+    }
+    Kernel::InterruptDisabler disabler;
+    if (s_debug_log_head - s_debug_log_tail == debug_log_ring_size) {
+        ++s_debug_log_tail;
+        ++s_debug_log_dropped;
+    }
+    s_debug_log_ring[s_debug_log_head % debug_log_ring_size] = ch;
+    ++s_debug_log_head;
+}
+
+void klog_ring_enable()
+{
+    s_debug_log_ring_enabled = true;
+}
+
+size_t klog_ring_drain()
+{
+    size_t total = 0;
+    for (;;) {
+        char chunk[256];
+        size_t count = 0;
+        {
+            Kernel::InterruptDisabler disabler;
+            while (count < sizeof(chunk) && s_debug_log_tail != s_debug_log_head) {
+                chunk[count++] = s_debug_log_ring[s_debug_log_tail % debug_log_ring_size];
+                ++s_debug_log_tail;
+            }
+        }
+        if (!count)
+            break;
+        // The slow UART busy-wait happens out here, with interrupts enabled.
+        for (size_t i = 0; i < count; ++i)
+            serial_putch(chunk[i]);
+        total += count;
+    }
+    size_t dropped = 0;
+    {
+        Kernel::InterruptDisabler disabler;
+        dropped = s_debug_log_dropped;
+        s_debug_log_dropped = 0;
+    }
+    if (dropped) {
+        char buffer[64];
+        int length = sprintf(buffer, "klog: ring overflow, lost %u characters\n", (unsigned)dropped);
+        for (int i = 0; i < length; ++i)
+            serial_putch(buffer[i]);
+    }
+    return total;
+}
+#else
+static void debug_ring_put(char ch)
+{
+    serial_putch(ch);
+}
+#endif
+
 static void console_out(char ch)
 {
     if (serial_debug)
-        serial_putch(ch);
+        debug_ring_put(ch);
 
     // It would be bad to reach the assert in Console()::the() and do a stack overflow
 
@@ -144,7 +219,7 @@ int sprintf(char* buffer, const char* fmt, ...)
 static void debugger_out(char ch)
 {
     if (serial_debug)
-        serial_putch(ch);
+        debug_ring_put(ch);
     IO::out8(0xe9, ch);
 }
 
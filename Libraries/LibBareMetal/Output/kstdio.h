@@ -38,6 +38,11 @@ void set_serial_debug(bool on_or_off);
 int get_serial_debug();
 }
 
+#if defined(KERNEL)
+void klog_ring_enable();
+size_t klog_ring_drain();
+#endif
+
 #if defined(KERNEL) || defined(BOOTSTRAPPER)
 #    define printf dbgprintf
 #endif
@@ -43,6 +43,8 @@ struct __STDIO_FILE {
     char* buffer;
     size_t buffer_size;
     size_t buffer_index;
+    int owns_buffer;
+    size_t full_flush_count;
     int have_ungotten;
     char ungotten;
     char default_buffer[BUFSIZ];
@@ -43,7 +43,12 @@ int fcntl(int fd, int cmd, ...)
 
 int watch_file(const char* path, size_t path_length)
 {
-    int rc = syscall(SC_watch_file, path, path_length);
+    return watch_file_with_flags(path, path_length, 0);
+}
+
+int watch_file_with_flags(const char* path, size_t path_length, unsigned flags)
+{
+    int rc = syscall(SC_watch_file, path, path_length, flags);
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
@@ -91,7 +91,11 @@ int openat(int dirfd, const char* path, int options, ...);
 int openat_with_path_length(int dirfd, const char* path, size_t path_length, int options, mode_t);
 
 int fcntl(int fd, int cmd, ...);
+
+#define WATCH_FILE_RECURSIVE (1 << 0)
+
 int watch_file(const char* path, size_t path_length);
+int watch_file_with_flags(const char* path, size_t path_length, unsigned flags);
 
 #define F_RDLCK 0
 #define F_WRLCK 1
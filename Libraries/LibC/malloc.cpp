@@ -30,14 +30,14 @@
 #include <AK/Vector.h>
 #include <LibThread/Lock.h>
 #include <assert.h>
+#include <fcntl.h>
 #include <mallocdefs.h>
 #include <serenity.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
-
-// FIXME: Thread safety.
+#include <unistd.h>
 
 //#define MALLOC_DEBUG
 #define RECYCLE_BIG_ALLOCATIONS
@@ -59,6 +59,9 @@ static bool s_log_malloc = false;
 static bool s_scrub_malloc = true;
 static bool s_scrub_free = true;
 static bool s_profiling = false;
+static unsigned s_trace_interval = 0;
+static unsigned s_trace_countdown = 0;
+static malloc_trace_ring* s_trace_ring = nullptr;
 static unsigned short size_classes[] = { 8, 16, 32, 64, 128, 252, 508, 1016, 2036, 4090, 8188, 16376, 32756, 0 };
 static constexpr size_t num_size_classes = sizeof(size_classes) / sizeof(unsigned short);
 
@@ -163,6 +166,28 @@ static Allocator* allocator_for_size(size_t size, size_t& good_size)
     return nullptr;
 }
 
+static int size_class_index_for_size(size_t size)
+{
+    for (int i = 0; size_classes[i]; ++i) {
+        if (size <= size_classes[i])
+            return i;
+    }
+    return -1;
+}
+
+// Per-thread cache in front of the shared size classes. The common
+// malloc/free pair is served from here without taking the malloc lock;
+// when a bin fills up, half of it is flushed back to the shared blocks
+// under a single lock acquisition.
+constexpr size_t tcache_chunks_per_bin = 32;
+
+struct ThreadCacheBin {
+    FreelistEntry* head { nullptr };
+    size_t count { 0 };
+};
+
+static __thread ThreadCacheBin t_cache[num_size_classes];
+
 static BigAllocator* big_allocator_for_size(size_t size)
 {
     if (size == 65536)
@@ -196,14 +221,27 @@ static void os_free(void* ptr, size_t size)
 
 static void* malloc_impl(size_t size)
 {
-    LOCKER(malloc_lock());
-
     if (s_log_malloc)
         dbgprintf("LibC: malloc(%zu)\n", size);
 
     if (!size)
         return nullptr;
 
+    int class_index = size_class_index_for_size(size);
+    if (class_index >= 0) {
+        auto& bin = t_cache[class_index];
+        if (bin.head) {
+            auto* entry = bin.head;
+            bin.head = entry->next;
+            --bin.count;
+            if (s_scrub_malloc)
+                memset(entry, MALLOC_SCRUB_BYTE, size_classes[class_index]);
+            return entry;
+        }
+    }
+
+    LOCKER(malloc_lock());
+
     size_t good_size;
     auto* allocator = allocator_for_size(size, good_size);
 
@@ -286,51 +324,17 @@ static void* malloc_impl(size_t size)
     return ptr;
 }
 
-static void free_impl(void* ptr)
+// Expects the malloc lock to be held, and the chunk to be scrubbed already.
+static void release_chunk_while_locked(void* ptr)
 {
-    ScopedValueRollback rollback(errno);
-
-    if (!ptr)
-        return;
-
-    LOCKER(malloc_lock());
-
     void* block_base = (void*)((FlatPtr)ptr & block_mask);
-    size_t magic = *(size_t*)block_base;
-
-    if (magic == MAGIC_BIGALLOC_HEADER) {
-        auto* block = (BigAllocationBlock*)block_base;
-#ifdef RECYCLE_BIG_ALLOCATIONS
-        if (auto* allocator = big_allocator_for_size(block->m_size)) {
-            if (allocator->blocks.size() < number_of_big_blocks_to_keep_around_per_size_class) {
-                allocator->blocks.append(block);
-                size_t this_block_size = block->m_size;
-                if (mprotect(block, this_block_size, PROT_NONE) < 0) {
-                    perror("mprotect");
-                    ASSERT_NOT_REACHED();
-                }
-                if (madvise(block, this_block_size, MADV_SET_VOLATILE) != 0) {
-                    perror("madvise");
-                    ASSERT_NOT_REACHED();
-                }
-                return;
-            }
-        }
-#endif
-        os_free(block, block->m_size);
-        return;
-    }
-
-    assert(magic == MAGIC_PAGE_HEADER);
     auto* block = (ChunkedBlock*)block_base;
+    assert(block->m_magic == MAGIC_PAGE_HEADER);
 
 #ifdef MALLOC_DEBUG
     dbgprintf("LibC: freeing %p in allocator %p (size=%u, used=%u)\n", ptr, block, block->bytes_per_chunk(), block->used_chunks());
 #endif
 
-    if (s_scrub_free)
-        memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
-
     auto* entry = (FreelistEntry*)ptr;
     entry->next = block->m_freelist;
     block->m_freelist = entry;
@@ -369,11 +373,95 @@ static void free_impl(void* ptr)
     }
 }
 
+static void flush_thread_cache_bin(ThreadCacheBin& bin, size_t keep_count)
+{
+    LOCKER(malloc_lock());
+    while (bin.count > keep_count) {
+        auto* entry = bin.head;
+        bin.head = entry->next;
+        --bin.count;
+        release_chunk_while_locked(entry);
+    }
+}
+
+static void free_impl(void* ptr)
+{
+    ScopedValueRollback rollback(errno);
+
+    if (!ptr)
+        return;
+
+    // Reading the block header without the lock is fine: the block can't go
+    // away while one of its chunks (or the big allocation itself) is still
+    // live and being freed here.
+    void* block_base = (void*)((FlatPtr)ptr & block_mask);
+    size_t magic = *(size_t*)block_base;
+
+    if (magic == MAGIC_PAGE_HEADER) {
+        auto* block = (ChunkedBlock*)block_base;
+        int class_index = size_class_index_for_size(block->m_size);
+        assert(class_index >= 0);
+        if (s_scrub_free)
+            memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
+        auto& bin = t_cache[class_index];
+        auto* entry = (FreelistEntry*)ptr;
+        entry->next = bin.head;
+        bin.head = entry;
+        ++bin.count;
+        if (bin.count >= tcache_chunks_per_bin)
+            flush_thread_cache_bin(bin, tcache_chunks_per_bin / 2);
+        return;
+    }
+
+    LOCKER(malloc_lock());
+
+    if (magic == MAGIC_BIGALLOC_HEADER) {
+        auto* block = (BigAllocationBlock*)block_base;
+#ifdef RECYCLE_BIG_ALLOCATIONS
+        if (auto* allocator = big_allocator_for_size(block->m_size)) {
+            if (allocator->blocks.size() < number_of_big_blocks_to_keep_around_per_size_class) {
+                allocator->blocks.append(block);
+                size_t this_block_size = block->m_size;
+                if (mprotect(block, this_block_size, PROT_NONE) < 0) {
+                    perror("mprotect");
+                    ASSERT_NOT_REACHED();
+                }
+                if (madvise(block, this_block_size, MADV_SET_VOLATILE) != 0) {
+                    perror("madvise");
+                    ASSERT_NOT_REACHED();
+                }
+                return;
+            }
+        }
+#endif
+        os_free(block, block->m_size);
+        return;
+    }
+
+    assert(magic == MAGIC_PAGE_HEADER);
+    release_chunk_while_locked(ptr);
+}
+
+static void trace_allocation(size_t size, void* return_address)
+{
+    auto& ring = *s_trace_ring;
+    unsigned slot = ring.head % ring.capacity;
+    ring.entries[slot].size = size;
+    ring.entries[slot].return_address = return_address;
+    // Fill the entry before advancing head so a reader never sees a
+    // half-written slot.
+    ring.head = ring.head + 1;
+}
+
 void* malloc(size_t size)
 {
     void* ptr = malloc_impl(size);
     if (s_profiling)
         perf_event(PERF_EVENT_MALLOC, size, reinterpret_cast<FlatPtr>(ptr));
+    if (s_trace_ring && --s_trace_countdown == 0) {
+        s_trace_countdown = s_trace_interval;
+        trace_allocation(size, __builtin_return_address(0));
+    }
     return ptr;
 }
 
@@ -419,6 +507,53 @@ void* realloc(void* ptr, size_t size)
     return new_ptr;
 }
 
+size_t malloc_trim()
+{
+    LOCKER(malloc_lock());
+    size_t bytes_released = 0;
+    for (size_t i = 0; i < num_size_classes; ++i) {
+        auto& allocator = allocators()[i];
+        while (allocator.empty_block_count) {
+            auto* block = allocator.empty_blocks[--allocator.empty_block_count];
+            os_free(block, block_size);
+            --allocator.block_count;
+            bytes_released += block_size;
+        }
+    }
+    for (auto& allocator : big_allocators()) {
+        while (!allocator.blocks.is_empty()) {
+            auto* block = allocator.blocks.take_last();
+            // These blocks are PROT_NONE so their header is unreadable, but
+            // the big allocator only ever recycles block_size allocations.
+            os_free(block, block_size);
+            bytes_released += block_size;
+        }
+    }
+    return bytes_released;
+}
+
+void malloc_statistics(struct malloc_stats* stats)
+{
+    LOCKER(malloc_lock());
+    memset(stats, 0, sizeof(*stats));
+    static_assert(num_size_classes <= MALLOC_STATS_SIZE_CLASS_CAPACITY);
+    for (size_t i = 0; size_classes[i]; ++i) {
+        auto& allocator = allocators()[i];
+        auto& out = stats->size_classes[i];
+        out.chunk_size = size_classes[i];
+        out.block_count = allocator.block_count;
+        out.empty_block_count = allocator.empty_block_count;
+        for (auto* block = allocator.usable_blocks.head(); block; block = block->next()) {
+            out.free_chunk_count += block->free_chunks();
+            out.used_chunk_count += block->used_chunks();
+        }
+        for (auto* block = allocator.full_blocks.head(); block; block = block->next())
+            out.used_chunk_count += block->used_chunks();
+        stats->heap_size += allocator.block_count * block_size;
+        ++stats->size_class_count;
+    }
+}
+
 void __malloc_init()
 {
     new (&malloc_lock()) LibThread::Lock();
@@ -437,5 +572,32 @@ void __malloc_init()
     }
 
     new (&big_allocators()[0])(BigAllocator);
+
+    if (char* trace_env = getenv("LIBC_TRACE_MALLOC")) {
+        int interval = atoi(trace_env);
+        s_trace_interval = interval > 0 ? (unsigned)interval : 100;
+        void* ring_memory = nullptr;
+        int shbuf_id = shbuf_create(sizeof(malloc_trace_ring), &ring_memory);
+        if (shbuf_id >= 0) {
+            shbuf_allow_all(shbuf_id);
+            s_trace_ring = (malloc_trace_ring*)ring_memory;
+            s_trace_ring->magic = MALLOC_TRACE_MAGIC;
+            s_trace_ring->sample_interval = s_trace_interval;
+            s_trace_ring->capacity = MALLOC_TRACE_ENTRY_CAPACITY;
+            s_trace_ring->head = 0;
+            s_trace_countdown = s_trace_interval;
+            // Publish the shbuf id where MallocTracer expects it. No stdio
+            // here; we don't want the tracer itself showing up in the trace.
+            char path[64];
+            sprintf(path, "/tmp/malloc-trace.%d", getpid());
+            char id_string[16];
+            sprintf(id_string, "%d\n", shbuf_id);
+            int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd >= 0) {
+                write(fd, id_string, strlen(id_string));
+                close(fd);
+            }
+        }
+    }
 }
 }
@@ -26,6 +26,55 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <sys/cdefs.h>
+
 #define MALLOC_SCRUB_BYTE 0xdc
 #define FREE_SCRUB_BYTE 0xed
 
+#define MALLOC_STATS_SIZE_CLASS_CAPACITY 16
+
+__BEGIN_DECLS
+
+struct malloc_stats {
+    size_t heap_size; // Bytes currently mapped for chunked blocks.
+    size_t size_class_count;
+    struct {
+        size_t chunk_size;
+        size_t block_count;       // Live blocks, including kept-around empty ones.
+        size_t empty_block_count; // Kept-around volatile blocks.
+        size_t free_chunk_count;
+        size_t used_chunk_count; // Includes chunks sitting in thread caches.
+    } size_classes[MALLOC_STATS_SIZE_CLASS_CAPACITY];
+};
+
+void malloc_statistics(struct malloc_stats*);
+
+// Releases kept-around empty blocks back to the kernel immediately and
+// returns the number of bytes unmapped. Empty blocks are volatile anyway,
+// so the kernel can also reclaim them on its own under memory pressure.
+size_t malloc_trim(void);
+
+// Sampling allocation tracer. When LIBC_TRACE_MALLOC is set, malloc()
+// records every Nth allocation's size and return address into a shared
+// buffer with this layout, and writes the shbuf id to
+// /tmp/malloc-trace.<pid> so MallocTracer can attach.
+#define MALLOC_TRACE_MAGIC 0x4d545263
+#define MALLOC_TRACE_ENTRY_CAPACITY 4096
+
+struct malloc_trace_entry {
+    size_t size;
+    void* return_address;
+};
+
+struct malloc_trace_ring {
+    unsigned magic;
+    unsigned sample_interval;
+    unsigned capacity;
+    // Total samples ever taken; sample i lives at entries[i % capacity].
+    volatile unsigned head;
+    struct malloc_trace_entry entries[MALLOC_TRACE_ENTRY_CAPACITY];
+};
+
+__END_DECLS
+
@@ -59,4 +59,16 @@ int sched_getparam(pid_t pid, struct sched_param* param)
     int rc = syscall(SC_sched_getparam, pid, param);
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
+
+int sched_setaffinity(pid_t pid, const uint32_t* mask)
+{
+    int rc = syscall(SC_sched_setaffinity, pid, mask);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int sched_getaffinity(pid_t pid, uint32_t* mask)
+{
+    int rc = syscall(SC_sched_getaffinity, pid, mask);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
 }
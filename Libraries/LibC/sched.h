@@ -47,4 +47,8 @@ int sched_get_priority_max(int policy);
 int sched_setparam(pid_t pid, const struct sched_param* param);
 int sched_getparam(pid_t pid, struct sched_param* param);
 
+// One bit per processor; pid 0 means the calling thread.
+int sched_setaffinity(pid_t pid, const uint32_t* mask);
+int sched_getaffinity(pid_t pid, uint32_t* mask);
+
 __END_DECLS
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <Kernel/Syscall.h>
+#include <alloca.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct FileAction {
+    enum class Type {
+        Close,
+        Dup2,
+        Open,
+    };
+    Type type { Type::Close };
+    int fd { -1 };
+    int new_fd { -1 };
+    String path;
+    int flags { 0 };
+    mode_t mode { 0 };
+};
+
+static Vector<FileAction>* actions_for(const posix_spawn_file_actions_t* file_actions)
+{
+    if (!file_actions)
+        return nullptr;
+    return static_cast<Vector<FileAction>*>(file_actions->state);
+}
+
+// The fast path is only usable when the child doesn't need any setup between
+// "created" and "running the new executable": the spawn() syscall builds the
+// child directly from the executable, so there is no window to apply file
+// actions or attributes in.
+static bool can_use_spawn_syscall(const posix_spawn_file_actions_t* file_actions, const posix_spawnattr_t* attr)
+{
+    if (attr && attr->flags)
+        return false;
+    auto* actions = actions_for(file_actions);
+    if (actions && !actions->is_empty())
+        return false;
+    return true;
+}
+
+static int spawn_via_syscall(pid_t* out_pid, const char* path, char* const argv[], char* const envp[])
+{
+    size_t arg_count = 0;
+    for (size_t i = 0; argv[i]; ++i)
+        ++arg_count;
+
+    size_t env_count = 0;
+    for (size_t i = 0; envp[i]; ++i)
+        ++env_count;
+
+    auto copy_strings = [&](auto& vec, size_t count, auto& output) {
+        output.length = count;
+        for (size_t i = 0; vec[i]; ++i) {
+            output.strings[i].characters = vec[i];
+            output.strings[i].length = strlen(vec[i]);
+        }
+    };
+
+    Syscall::SC_spawn_params params;
+    params.arguments.strings = (Syscall::StringArgument*)alloca(arg_count * sizeof(Syscall::StringArgument));
+    params.environment.strings = (Syscall::StringArgument*)alloca(env_count * sizeof(Syscall::StringArgument));
+
+    params.path = { path, strlen(path) };
+    copy_strings(argv, arg_count, params.arguments);
+    copy_strings(envp, env_count, params.environment);
+
+    int rc = syscall(SC_spawn, &params);
+    if (rc < 0)
+        return -rc;
+    if (out_pid)
+        *out_pid = rc;
+    return 0;
+}
+
+static int spawn_via_fork(pid_t* out_pid, const char* path, const posix_spawn_file_actions_t* file_actions, const posix_spawnattr_t* attr, char* const argv[], char* const envp[])
+{
+    pid_t child_pid = fork();
+    if (child_pid < 0)
+        return errno;
+
+    if (child_pid == 0) {
+        if (attr) {
+            if (attr->flags & POSIX_SPAWN_SETSIGMASK)
+                sigprocmask(SIG_SETMASK, &attr->sigmask, nullptr);
+            if (attr->flags & POSIX_SPAWN_SETSIGDEF) {
+                for (int signal = 1; signal < NSIG; ++signal) {
+                    if (sigismember(&attr->sigdefault, signal))
+                        ::signal(signal, SIG_DFL);
+                }
+            }
+            if (attr->flags & POSIX_SPAWN_SETPGROUP) {
+                if (setpgid(0, attr->pgroup) < 0)
+                    _exit(127);
+            }
+            if (attr->flags & POSIX_SPAWN_SETSCHEDPARAM) {
+                if (sched_setparam(0, &attr->schedparam) < 0)
+                    _exit(127);
+            }
+            if (attr->flags & POSIX_SPAWN_RESETIDS) {
+                if (setgid(getgid()) < 0 || setuid(getuid()) < 0)
+                    _exit(127);
+            }
+        }
+
+        if (auto* actions = actions_for(file_actions)) {
+            for (auto& action : *actions) {
+                switch (action.type) {
+                case FileAction::Type::Close:
+                    if (close(action.fd) < 0)
+                        _exit(127);
+                    break;
+                case FileAction::Type::Dup2:
+                    if (dup2(action.fd, action.new_fd) < 0)
+                        _exit(127);
+                    break;
+                case FileAction::Type::Open: {
+                    int opened_fd = open(action.path.characters(), action.flags, action.mode);
+                    if (opened_fd < 0)
+                        _exit(127);
+                    if (opened_fd != action.fd) {
+                        if (dup2(opened_fd, action.fd) < 0)
+                            _exit(127);
+                        close(opened_fd);
+                    }
+                    break;
+                }
+                }
+            }
+        }
+
+        execve(path, argv, envp);
+        _exit(127);
+    }
+
+    if (out_pid)
+        *out_pid = child_pid;
+    return 0;
+}
+
+extern "C" {
+
+int posix_spawn(pid_t* out_pid, const char* path, const posix_spawn_file_actions_t* file_actions, const posix_spawnattr_t* attr, char* const argv[], char* const envp[])
+{
+    if (!envp)
+        envp = environ;
+    if (can_use_spawn_syscall(file_actions, attr))
+        return spawn_via_syscall(out_pid, path, argv, envp);
+    return spawn_via_fork(out_pid, path, file_actions, attr, argv, envp);
+}
+
+int posix_spawnp(pid_t* out_pid, const char* file, const posix_spawn_file_actions_t* file_actions, const posix_spawnattr_t* attr, char* const argv[], char* const envp[])
+{
+    if (strchr(file, '/'))
+        return posix_spawn(out_pid, file, file_actions, attr, argv, envp);
+
+    String path = getenv("PATH");
+    if (path.is_empty())
+        path = "/bin:/usr/bin";
+    auto parts = path.split(':');
+    int rc = ENOENT;
+    for (auto& part : parts) {
+        auto candidate = String::format("%s/%s", part.characters(), file);
+        rc = posix_spawn(out_pid, candidate.characters(), file_actions, attr, argv, envp);
+        if (rc != ENOENT)
+            return rc;
+    }
+    return rc;
+}
+
+int posix_spawn_file_actions_init(posix_spawn_file_actions_t* file_actions)
+{
+    file_actions->state = new Vector<FileAction>;
+    return 0;
+}
+
+int posix_spawn_file_actions_destroy(posix_spawn_file_actions_t* file_actions)
+{
+    delete actions_for(file_actions);
+    file_actions->state = nullptr;
+    return 0;
+}
+
+int posix_spawn_file_actions_addclose(posix_spawn_file_actions_t* file_actions, int fd)
+{
+    if (fd < 0)
+        return EBADF;
+    FileAction action;
+    action.type = FileAction::Type::Close;
+    action.fd = fd;
+    actions_for(file_actions)->append(move(action));
+    return 0;
+}
+
+int posix_spawn_file_actions_adddup2(posix_spawn_file_actions_t* file_actions, int old_fd, int new_fd)
+{
+    if (old_fd < 0 || new_fd < 0)
+        return EBADF;
+    FileAction action;
+    action.type = FileAction::Type::Dup2;
+    action.fd = old_fd;
+    action.new_fd = new_fd;
+    actions_for(file_actions)->append(move(action));
+    return 0;
+}
+
+int posix_spawn_file_actions_addopen(posix_spawn_file_actions_t* file_actions, int fd, const char* path, int flags, mode_t mode)
+{
+    if (fd < 0)
+        return EBADF;
+    FileAction action;
+    action.type = FileAction::Type::Open;
+    action.fd = fd;
+    action.path = path;
+    action.flags = flags;
+    action.mode = mode;
+    actions_for(file_actions)->append(move(action));
+    return 0;
+}
+
+int posix_spawnattr_init(posix_spawnattr_t* attr)
+{
+    attr->flags = 0;
+    attr->pgroup = 0;
+    attr->schedparam = { 0 };
+    attr->schedpolicy = SCHED_OTHER;
+    sigemptyset(&attr->sigdefault);
+    sigemptyset(&attr->sigmask);
+    return 0;
+}
+
+int posix_spawnattr_destroy(posix_spawnattr_t*)
+{
+    return 0;
+}
+
+int posix_spawnattr_getflags(const posix_spawnattr_t* attr, short* out_flags)
+{
+    *out_flags = attr->flags;
+    return 0;
+}
+
+int posix_spawnattr_setflags(posix_spawnattr_t* attr, short flags)
+{
+    if (flags & ~(POSIX_SPAWN_RESETIDS | POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSCHEDPARAM | POSIX_SPAWN_SETSCHEDULER))
+        return EINVAL;
+    attr->flags = flags;
+    return 0;
+}
+
+int posix_spawnattr_getpgroup(const posix_spawnattr_t* attr, pid_t* out_pgroup)
+{
+    *out_pgroup = attr->pgroup;
+    return 0;
+}
+
+int posix_spawnattr_setpgroup(posix_spawnattr_t* attr, pid_t pgroup)
+{
+    attr->pgroup = pgroup;
+    return 0;
+}
+
+int posix_spawnattr_getschedparam(const posix_spawnattr_t* attr, struct sched_param* out_schedparam)
+{
+    *out_schedparam = attr->schedparam;
+    return 0;
+}
+
+int posix_spawnattr_setschedparam(posix_spawnattr_t* attr, const struct sched_param* schedparam)
+{
+    attr->schedparam = *schedparam;
+    return 0;
+}
+
+int posix_spawnattr_getschedpolicy(const posix_spawnattr_t* attr, int* out_schedpolicy)
+{
+    *out_schedpolicy = attr->schedpolicy;
+    return 0;
+}
+
+int posix_spawnattr_setschedpolicy(posix_spawnattr_t* attr, int schedpolicy)
+{
+    attr->schedpolicy = schedpolicy;
+    return 0;
+}
+
+int posix_spawnattr_getsigdefault(const posix_spawnattr_t* attr, sigset_t* out_sigdefault)
+{
+    *out_sigdefault = attr->sigdefault;
+    return 0;
+}
+
+int posix_spawnattr_setsigdefault(posix_spawnattr_t* attr, const sigset_t* sigdefault)
+{
+    attr->sigdefault = *sigdefault;
+    return 0;
+}
+
+int posix_spawnattr_getsigmask(const posix_spawnattr_t* attr, sigset_t* out_sigmask)
+{
+    *out_sigmask = attr->sigmask;
+    return 0;
+}
+
+int posix_spawnattr_setsigmask(posix_spawnattr_t* attr, const sigset_t* sigmask)
+{
+    attr->sigmask = *sigmask;
+    return 0;
+}
+}
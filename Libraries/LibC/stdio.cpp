@@ -37,6 +37,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -53,6 +54,35 @@ void init_FILE(FILE& fp, int fd, int mode)
     fp.buffer = fp.default_buffer;
     fp.buffer_size = BUFSIZ;
     fp.mode = mode;
+    fp.owns_buffer = false;
+    fp.full_flush_count = 0;
+}
+
+static constexpr size_t max_stream_buffer_size = 32768;
+
+// A stream that keeps flushing a full buffer is doing bulk I/O, so grow the
+// buffer to amortize the syscall cost. Buffers installed with setvbuf() are
+// the caller's business and stay as they are.
+static void consider_growing_buffer(FILE& stream)
+{
+    if (stream.mode != _IOFBF)
+        return;
+    if (stream.buffer != stream.default_buffer && !stream.owns_buffer)
+        return;
+    if (stream.buffer_size >= max_stream_buffer_size)
+        return;
+    if (++stream.full_flush_count < 4)
+        return;
+    size_t new_size = stream.buffer_size * 2;
+    auto* new_buffer = (char*)malloc(new_size);
+    if (!new_buffer)
+        return;
+    if (stream.owns_buffer)
+        free(stream.buffer);
+    stream.buffer = new_buffer;
+    stream.buffer_size = new_size;
+    stream.owns_buffer = true;
+    stream.full_flush_count = 0;
 }
 
 static FILE* make_FILE(int fd)
@@ -80,6 +110,10 @@ int setvbuf(FILE* stream, char* buf, int mode, size_t size)
         return -1;
     }
     stream->mode = mode;
+    if (stream->owns_buffer) {
+        free(stream->buffer);
+        stream->owns_buffer = false;
+    }
     if (buf) {
         stream->buffer = buf;
         stream->buffer_size = size;
@@ -88,6 +122,7 @@ int setvbuf(FILE* stream, char* buf, int mode, size_t size)
         stream->buffer_size = BUFSIZ;
     }
     stream->buffer_index = 0;
+    stream->full_flush_count = 0;
     return 0;
 }
 
@@ -179,6 +214,11 @@ int getchar()
     return getc(stdin);
 }
 
+int getchar_unlocked()
+{
+    return getc_unlocked(stdin);
+}
+
 ssize_t getdelim(char** lineptr, size_t* n, int delim, FILE* stream)
 {
     char *ptr, *eptr;
@@ -242,25 +282,41 @@ int fputc(int ch, FILE* stream)
     assert(stream);
     assert(stream->buffer_index < stream->buffer_size);
     stream->buffer[stream->buffer_index++] = ch;
-    if (stream->buffer_index >= stream->buffer_size)
+    if (stream->buffer_index >= stream->buffer_size) {
         fflush(stream);
-    else if (stream->mode == _IONBF || (stream->mode == _IOLBF && ch == '\n'))
+        consider_growing_buffer(*stream);
+    } else if (stream->mode == _IONBF || (stream->mode == _IOLBF && ch == '\n'))
         fflush(stream);
     if (stream->eof || stream->error)
         return EOF;
     return (u8)ch;
 }
 
+int fputc_unlocked(int ch, FILE* stream)
+{
+    return fputc(ch, stream);
+}
+
 int putc(int ch, FILE* stream)
 {
     return fputc(ch, stream);
 }
 
+int putc_unlocked(int ch, FILE* stream)
+{
+    return fputc(ch, stream);
+}
+
 int putchar(int ch)
 {
     return putc(ch, stdout);
 }
 
+int putchar_unlocked(int ch)
+{
+    return putc_unlocked(ch, stdout);
+}
+
 int fputs(const char* s, FILE* stream)
 {
     for (; *s; ++s) {
@@ -326,8 +382,37 @@ size_t fwrite(const void* ptr, size_t size, size_t nmemb, FILE* stream)
 {
     assert(stream);
     auto* bytes = (const u8*)ptr;
+    size_t total = size * nmemb;
+
+    // A payload at least as large as the buffer would just stream through
+    // it, so write whatever is already buffered and the payload with a
+    // single writev() instead. Line-buffered streams still have to take the
+    // slow path to find newlines.
+    if (stream->mode != _IOLBF && total >= stream->buffer_size) {
+        struct iovec iov[2];
+        int iov_count = 0;
+        if (stream->buffer_index) {
+            iov[iov_count].iov_base = stream->buffer;
+            iov[iov_count].iov_len = stream->buffer_index;
+            ++iov_count;
+        }
+        iov[iov_count].iov_base = const_cast<u8*>(bytes);
+        iov[iov_count].iov_len = total;
+        ++iov_count;
+        size_t previously_buffered = stream->buffer_index;
+        stream->buffer_index = 0;
+        ssize_t rc = writev(stream->fd, iov, iov_count);
+        if (rc < 0) {
+            stream->error = errno;
+            return 0;
+        }
+        if ((size_t)rc <= previously_buffered)
+            return 0;
+        return (rc - previously_buffered) / size;
+    }
+
     ssize_t nwritten = 0;
-    for (size_t i = 0; i < (size * nmemb); ++i) {
+    for (size_t i = 0; i < total; ++i) {
         int rc = fputc(bytes[i], stream);
         if (rc == EOF)
             break;
@@ -336,6 +421,11 @@ size_t fwrite(const void* ptr, size_t size, size_t nmemb, FILE* stream)
     return nwritten / size;
 }
 
+size_t fwrite_unlocked(const void* ptr, size_t size, size_t nmemb, FILE* stream)
+{
+    return fwrite(ptr, size, nmemb, stream);
+}
+
 int fseek(FILE* stream, long offset, int whence)
 {
     assert(stream);
@@ -537,6 +627,8 @@ int fclose(FILE* stream)
 {
     fflush(stream);
     int rc = close(stream->fd);
+    if (stream->owns_buffer)
+        free(stream->buffer);
     if (stream != &__default_streams[0] && stream != &__default_streams[1] && stream != &__default_streams[2])
         free(stream);
     return rc;
@@ -63,10 +63,12 @@ int fsetpos(FILE*, const fpos_t*);
 long ftell(FILE*);
 char* fgets(char* buffer, int size, FILE*);
 int fputc(int ch, FILE*);
+int fputc_unlocked(int ch, FILE*);
 int fileno(FILE*);
 int fgetc(FILE*);
 int getc(FILE*);
 int getc_unlocked(FILE* stream);
+int getchar_unlocked(void);
 int getchar();
 ssize_t getdelim(char**, size_t*, int, FILE*);
 ssize_t getline(char**, size_t*, FILE*);
@@ -85,6 +87,7 @@ int feof(FILE*);
 int fflush(FILE*);
 size_t fread(void* ptr, size_t size, size_t nmemb, FILE*);
 size_t fwrite(const void* ptr, size_t size, size_t nmemb, FILE*);
+size_t fwrite_unlocked(const void* ptr, size_t size, size_t nmemb, FILE*);
 int vprintf(const char* fmt, va_list);
 int vfprintf(FILE*, const char* fmt, va_list);
 int vsprintf(char* buffer, const char* fmt, va_list);
@@ -97,7 +100,9 @@ int dbgputstr(const char*, ssize_t);
 int sprintf(char* buffer, const char* fmt, ...);
 int snprintf(char* buffer, size_t, const char* fmt, ...);
 int putchar(int ch);
+int putchar_unlocked(int ch);
 int putc(int ch, FILE*);
+int putc_unlocked(int ch, FILE*);
 int puts(const char*);
 int fputs(const char*, FILE*);
 void perror(const char*);
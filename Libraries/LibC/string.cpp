@@ -35,8 +35,132 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if ARCH(I386)
+#    include <cpuid.h>
+#    include <emmintrin.h>
+#endif
+
 extern "C" {
 
+#if ARCH(I386)
+// Runtime-dispatched SSE2 kernels for the hot memory functions.
+// Userspace only: the kernel doesn't save SIMD state for its own threads,
+// so its StdLib keeps the integer versions.
+static bool has_sse2()
+{
+    static int s_has_sse2 = -1;
+    if (s_has_sse2 == -1) {
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        s_has_sse2 = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (edx & (1 << 26))) ? 1 : 0;
+    }
+    return s_has_sse2 == 1;
+}
+
+__attribute__((target("sse2"))) static int sse2_memcmp(const u8* s1, const u8* s2, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto a = _mm_loadu_si128((const __m128i*)(s1 + i));
+        auto b = _mm_loadu_si128((const __m128i*)(s2 + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+        if (mask != 0xffff) {
+            size_t offset = i + __builtin_ctz(~mask & 0xffff);
+            return s1[offset] < s2[offset] ? -1 : 1;
+        }
+    }
+    for (; i < n; ++i) {
+        if (s1[i] != s2[i])
+            return s1[i] < s2[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+__attribute__((target("sse2"))) static size_t sse2_strlen(const char* str)
+{
+    const char* s = str;
+    // Probe bytewise up to a 16-byte boundary; aligned loads can then never
+    // cross a page into unmapped memory.
+    while ((FlatPtr)s & 15) {
+        if (!*s)
+            return s - str;
+        ++s;
+    }
+    auto zero = _mm_setzero_si128();
+    for (;;) {
+        auto chunk = _mm_load_si128((const __m128i*)s);
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+        if (mask)
+            return (s - str) + __builtin_ctz(mask);
+        s += 16;
+    }
+}
+
+__attribute__((target("sse2"))) static void* sse2_memcpy(void* dest, const void* src, size_t len)
+{
+    auto* dest_ptr = (u8*)dest;
+    auto* src_ptr = (const u8*)src;
+
+    // Align the destination so the stores below never split a cache line.
+    if ((FlatPtr)dest_ptr & 15) {
+        size_t prologue = 16 - ((FlatPtr)dest_ptr & 15);
+        len -= prologue;
+        asm volatile(
+            "rep movsb\n"
+            : "=S"(src_ptr), "=D"(dest_ptr), "=c"(prologue)
+            : "0"(src_ptr), "1"(dest_ptr), "2"(prologue)
+            : "memory");
+    }
+    while (len >= 64) {
+        auto chunk0 = _mm_loadu_si128((const __m128i*)src_ptr);
+        auto chunk1 = _mm_loadu_si128((const __m128i*)(src_ptr + 16));
+        auto chunk2 = _mm_loadu_si128((const __m128i*)(src_ptr + 32));
+        auto chunk3 = _mm_loadu_si128((const __m128i*)(src_ptr + 48));
+        _mm_store_si128((__m128i*)dest_ptr, chunk0);
+        _mm_store_si128((__m128i*)(dest_ptr + 16), chunk1);
+        _mm_store_si128((__m128i*)(dest_ptr + 32), chunk2);
+        _mm_store_si128((__m128i*)(dest_ptr + 48), chunk3);
+        src_ptr += 64;
+        dest_ptr += 64;
+        len -= 64;
+    }
+    if (len)
+        memcpy(dest_ptr, src_ptr, len);
+    return dest;
+}
+
+__attribute__((target("sse2"))) static void* sse2_memset(void* dest, int c, size_t len)
+{
+    auto* dest_ptr = (u8*)dest;
+    auto value = _mm_set1_epi8((char)c);
+
+    if ((FlatPtr)dest_ptr & 15) {
+        size_t prologue = 16 - ((FlatPtr)dest_ptr & 15);
+        len -= prologue;
+        asm volatile(
+            "rep stosb\n"
+            : "=D"(dest_ptr), "=c"(prologue)
+            : "0"(dest_ptr), "1"(prologue), "a"(c)
+            : "memory");
+    }
+    while (len >= 64) {
+        _mm_store_si128((__m128i*)dest_ptr, value);
+        _mm_store_si128((__m128i*)(dest_ptr + 16), value);
+        _mm_store_si128((__m128i*)(dest_ptr + 32), value);
+        _mm_store_si128((__m128i*)(dest_ptr + 48), value);
+        dest_ptr += 64;
+        len -= 64;
+    }
+    while (len >= 16) {
+        _mm_store_si128((__m128i*)dest_ptr, value);
+        dest_ptr += 16;
+        len -= 16;
+    }
+    if (len)
+        memset(dest_ptr, c, len);
+    return dest;
+}
+#endif
+
 void bzero(void* dest, size_t n)
 {
     memset(dest, 0, n);
@@ -75,6 +199,10 @@ size_t strcspn(const char* s, const char* reject)
 
 size_t strlen(const char* str)
 {
+#if ARCH(I386)
+    if (has_sse2())
+        return sse2_strlen(str);
+#endif
     size_t len = 0;
     while (*(str++))
         ++len;
@@ -131,6 +259,10 @@ int memcmp(const void* v1, const void* v2, size_t n)
 {
     auto* s1 = (const uint8_t*)v1;
     auto* s2 = (const uint8_t*)v2;
+#if ARCH(I386)
+    if (n >= 16 && has_sse2())
+        return sse2_memcmp(s1, s2, n);
+#endif
     while (n-- > 0) {
         if (*s1++ != *s2++)
             return s1[-1] < s2[-1] ? -1 : 1;
@@ -189,8 +321,11 @@ void* mmx_memcpy(void* dest, const void* src, size_t len)
 
 void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 {
-    if (n >= 1024)
+    if (n >= 1024) {
+        if (has_sse2())
+            return sse2_memcpy(dest_ptr, src_ptr, n);
         return mmx_memcpy(dest_ptr, src_ptr, n);
+    }
 
     u32 dest = (u32)dest_ptr;
     u32 src = (u32)src_ptr;
@@ -214,6 +349,9 @@ void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 
 void* memset(void* dest_ptr, int c, size_t n)
 {
+    if (n >= 256 && has_sse2())
+        return sse2_memset(dest_ptr, c, n);
+
     u32 dest = (u32)dest_ptr;
     // FIXME: Support starting at an unaligned address.
     if (!(dest & 0x3) && n >= 12) {
@@ -258,7 +396,9 @@ void* memset(void* dest_ptr, int c, size_t n)
 
 void* memmove(void* dest, const void* src, size_t n)
 {
-    if (dest < src)
+    // Copying forward is fine unless the destination overlaps the tail of
+    // the source.
+    if (dest < src || (const u8*)dest >= (const u8*)src + n)
         return memcpy(dest, src, n);
 
     u8* pd = (u8*)dest;
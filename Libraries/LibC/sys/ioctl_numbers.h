@@ -64,5 +64,6 @@ enum IOCtlNumber {
     SIOCGIFHWADDR,
     SIOCSIFNETMASK,
     SIOCADDRT,
-    SIOCDELRT
+    SIOCDELRT,
+    FIONREAD
 };
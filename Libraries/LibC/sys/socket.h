@@ -59,6 +59,8 @@ __BEGIN_DECLS
 #define IPPROTO_TCP 6
 #define IPPROTO_UDP 17
 
+#define TCP_NODELAY 10
+
 #define MSG_DONTWAIT 0x40
 
 struct sockaddr {
@@ -82,7 +84,9 @@ struct ucred {
 #define SO_PEERCRED 5
 #define SO_REUSEADDR 6
 #define SO_BINDTODEVICE 7
+#define SO_SNDBUF 8
 #define SO_KEEPALIVE 9
+#define SO_RCVBUF 10
 
 int socket(int domain, int type, int protocol);
 int bind(int sockfd, const struct sockaddr* addr, socklen_t);
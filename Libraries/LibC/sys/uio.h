@@ -37,5 +37,6 @@ struct iovec {
 };
 
 ssize_t writev(int fd, const struct iovec*, int iov_count);
+ssize_t readv(int fd, const struct iovec*, int iov_count);
 
 __END_DECLS
@@ -257,6 +257,13 @@ ssize_t write(int fd, const void* buf, size_t count)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+ssize_t sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    Syscall::SC_sendfile_params params { out_fd, in_fd, offset, count };
+    int rc = syscall(SC_sendfile, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int ttyname_r(int fd, char* buffer, size_t size)
 {
     int rc = syscall(SC_ttyname_r, fd, buffer, size);
@@ -298,6 +305,28 @@ int stat(const char* path, struct stat* statbuf)
     return do_stat(path, statbuf, true);
 }
 
+int batch_stat(const char* const* paths, size_t count, struct stat* statbufs, int* results, int follow_symlinks)
+{
+    if (!count)
+        return 0;
+    if (!paths || !statbufs || !results) {
+        errno = EFAULT;
+        return -1;
+    }
+    Syscall::SC_batch_stat_params params;
+    params.paths.strings = (Syscall::StringArgument*)alloca(count * sizeof(Syscall::StringArgument));
+    params.paths.length = count;
+    for (size_t i = 0; i < count; ++i) {
+        params.paths.strings[i].characters = paths[i];
+        params.paths.strings[i].length = strlen(paths[i]);
+    }
+    params.statbufs = statbufs;
+    params.results = results;
+    params.follow_symlinks = follow_symlinks;
+    int rc = syscall(SC_batch_stat, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int fstat(int fd, struct stat* statbuf)
 {
     int rc = syscall(SC_fstat, fd, statbuf);
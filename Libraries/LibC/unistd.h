@@ -93,6 +93,7 @@ int tcsetpgrp(int fd, pid_t pgid);
 ssize_t read(int fd, void* buf, size_t count);
 ssize_t pread(int fd, void* buf, size_t count, off_t);
 ssize_t write(int fd, const void* buf, size_t count);
+ssize_t sendfile(int out_fd, int in_fd, off_t* offset, size_t count);
 int close(int fd);
 int chdir(const char* path);
 int fchdir(int fd);
@@ -101,6 +102,7 @@ char* getwd(char* buffer);
 int fstat(int fd, struct stat* statbuf);
 int lstat(const char* path, struct stat* statbuf);
 int stat(const char* path, struct stat* statbuf);
+int batch_stat(const char* const* paths, size_t count, struct stat* statbufs, int* results, int follow_symlinks);
 int sleep(unsigned seconds);
 int usleep(useconds_t);
 int gethostname(char*, size_t);
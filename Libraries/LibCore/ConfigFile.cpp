@@ -24,16 +24,32 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/MappedFile.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/File.h>
+#include <LibCore/Notifier.h>
 #include <LibCore/StandardPaths.h>
+#include <fcntl.h>
 #include <pwd.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace Core {
 
+// A compiled copy of the INI contents, stored next to it. It's validated
+// against the INI's mtime and size, so a stale cache is simply ignored.
+static const u32 config_cache_magic = 0x436e6643; // 'CnfC'
+
+struct [[gnu::packed]] ConfigCacheHeader {
+    u32 magic;
+    u32 ini_mtime;
+    u32 ini_size;
+    u32 group_count;
+};
+
 NonnullRefPtr<ConfigFile> ConfigFile::get_for_app(const String& app_name)
 {
     String home_path = StandardPaths::home_directory();
@@ -61,12 +77,144 @@ ConfigFile::ConfigFile(const String& file_name)
 ConfigFile::~ConfigFile()
 {
     sync();
+    if (m_watch_fd >= 0)
+        close(m_watch_fd);
+}
+
+String ConfigFile::cache_file_name() const
+{
+    return String::format("%s.cache", m_file_name.characters());
+}
+
+bool ConfigFile::load_from_cache()
+{
+    struct stat ini_st;
+    if (stat(m_file_name.characters(), &ini_st) < 0)
+        return false;
+
+    MappedFile cache(cache_file_name());
+    if (!cache.is_valid())
+        return false;
+
+    const u8* data = (const u8*)cache.data();
+    size_t size = cache.size();
+    if (size < sizeof(ConfigCacheHeader))
+        return false;
+
+    ConfigCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != config_cache_magic)
+        return false;
+    if (header.ini_mtime != (u32)ini_st.st_mtime || header.ini_size != (u32)ini_st.st_size)
+        return false;
+
+    size_t offset = sizeof(header);
+    auto read_u32 = [&](u32& out) -> bool {
+        if (size - offset < sizeof(u32))
+            return false;
+        memcpy(&out, data + offset, sizeof(u32));
+        offset += sizeof(u32);
+        return true;
+    };
+    auto read_string = [&](String& out) -> bool {
+        u32 length = 0;
+        if (!read_u32(length))
+            return false;
+        if (size - offset < length)
+            return false;
+        out = String((const char*)data + offset, length);
+        offset += length;
+        return true;
+    };
+
+    HashMap<String, HashMap<String, String>> groups;
+    for (u32 i = 0; i < header.group_count; ++i) {
+        String group_name;
+        u32 key_count = 0;
+        if (!read_string(group_name) || !read_u32(key_count))
+            return false;
+        auto& group = groups.ensure(group_name);
+        for (u32 j = 0; j < key_count; ++j) {
+            String key;
+            String value;
+            if (!read_string(key) || !read_string(value))
+                return false;
+            group.set(key, value);
+        }
+    }
+
+    m_groups = move(groups);
+    return true;
+}
+
+void ConfigFile::save_cache()
+{
+    // Best effort: a config in a directory we can't write to (e.g. /etc)
+    // simply doesn't get a cache.
+    struct stat ini_st;
+    if (stat(m_file_name.characters(), &ini_st) < 0)
+        return;
+
+    FILE* fp = fopen(cache_file_name().characters(), "wb");
+    if (!fp)
+        return;
+
+    ConfigCacheHeader header;
+    header.magic = config_cache_magic;
+    header.ini_mtime = (u32)ini_st.st_mtime;
+    header.ini_size = (u32)ini_st.st_size;
+    header.group_count = m_groups.size();
+    fwrite(&header, sizeof(header), 1, fp);
+
+    auto write_string = [fp](const String& string) {
+        u32 length = string.length();
+        fwrite(&length, sizeof(length), 1, fp);
+        fwrite(string.characters(), 1, length, fp);
+    };
+
+    for (auto& it : m_groups) {
+        write_string(it.key);
+        u32 key_count = it.value.size();
+        fwrite(&key_count, sizeof(key_count), 1, fp);
+        for (auto& jt : it.value) {
+            write_string(jt.key);
+            write_string(jt.value);
+        }
+    }
+
+    fclose(fp);
+}
+
+void ConfigFile::enable_change_notifications()
+{
+#ifdef __serenity__
+    if (m_notifier)
+        return;
+    m_watch_fd = watch_file(m_file_name.characters(), m_file_name.length());
+    if (m_watch_fd < 0) {
+        perror("watch_file");
+        return;
+    }
+    fcntl(m_watch_fd, F_SETFD, FD_CLOEXEC);
+    m_notifier = Notifier::construct(m_watch_fd, Notifier::Event::Read);
+    m_notifier->on_ready_to_read = [this] {
+        u8 buffer[128];
+        int rc = read(m_watch_fd, buffer, sizeof(buffer));
+        ASSERT(rc >= 0);
+        reparse();
+        if (on_change)
+            on_change();
+    };
+#endif
 }
 
 void ConfigFile::reparse()
 {
     m_groups.clear();
 
+    if (load_from_cache())
+        return;
+
     auto file = File::construct(m_file_name);
     if (!file->open(IODevice::OpenMode::ReadOnly))
         return;
@@ -109,6 +257,8 @@ void ConfigFile::reparse()
         }
         }
     }
+
+    save_cache();
 }
 
 String ConfigFile::read_entry(const String& group, const String& key, const String& default_value) const
@@ -181,6 +331,8 @@ bool ConfigFile::sync()
 
     fclose(fp);
 
+    save_cache();
+
     m_dirty = false;
     return true;
 }
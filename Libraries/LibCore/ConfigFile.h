@@ -26,11 +26,13 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibCore/Forward.h>
 #include <LibGfx/Color.h>
 
 namespace Core {
@@ -68,14 +70,26 @@ public:
 
     String file_name() const { return m_file_name; }
 
+    // Starts watching the file for changes. When it's modified on disk, the
+    // in-memory contents are re-read and this hook is invoked. Requires a
+    // running Core::EventLoop.
+    void enable_change_notifications();
+    Function<void()> on_change;
+
 private:
     explicit ConfigFile(const String& file_name);
 
     void reparse();
+    String cache_file_name() const;
+    bool load_from_cache();
+    void save_cache();
 
     String m_file_name;
     HashMap<String, HashMap<String, String>> m_groups;
     bool m_dirty { false };
+
+    int m_watch_fd { -1 };
+    RefPtr<Notifier> m_notifier;
 };
 
 }
@@ -0,0 +1,517 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibCore/Deflate.h>
+#include <string.h>
+
+namespace Core {
+
+// RFC 1951 section 3.2.5: base values and extra bit counts for the
+// length codes (symbols 257-285) and distance codes (symbols 0-29).
+static const u16 length_bases[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const u8 length_extra_bits[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const u16 distance_bases[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const u8 distance_extra_bits[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static u16 reverse_bits(u16 value, unsigned bit_count)
+{
+    u16 result = 0;
+    for (unsigned i = 0; i < bit_count; ++i) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+bool DeflateDecompressor::CanonicalCode::build(const u8* code_lengths, size_t symbol_count)
+{
+    memset(fast_table, 0, sizeof(fast_table));
+    memset(length_counts, 0, sizeof(length_counts));
+
+    for (size_t symbol = 0; symbol < symbol_count; ++symbol)
+        ++length_counts[code_lengths[symbol]];
+    length_counts[0] = 0;
+
+    // Reject over-subscribed codes. Incomplete codes are allowed (a block
+    // may have a single distance code, or none at all); using a bit
+    // pattern they don't cover is caught during decoding.
+    int available = 1;
+    for (unsigned length = 1; length <= 15; ++length) {
+        available = (available << 1) - length_counts[length];
+        if (available < 0)
+            return false;
+    }
+
+    // Sort symbols by (code length, symbol), which is exactly canonical
+    // code order; this is what the slow path indexes into.
+    u16 offsets[16];
+    offsets[1] = 0;
+    for (unsigned length = 1; length < 15; ++length)
+        offsets[length + 1] = offsets[length] + length_counts[length];
+
+    u16 next_code[16];
+    unsigned code = 0;
+    for (unsigned length = 1; length <= 15; ++length) {
+        code = (code + length_counts[length - 1]) << 1;
+        next_code[length] = code;
+    }
+
+    for (size_t symbol = 0; symbol < symbol_count; ++symbol) {
+        unsigned length = code_lengths[symbol];
+        if (!length)
+            continue;
+        sorted_symbols[offsets[length]++] = symbol;
+        unsigned symbol_code = next_code[length]++;
+        if (length <= max_fast_bits) {
+            // The bit stream serves up codes LSB-first, so the table is
+            // indexed by the bit-reversed code, replicated across every
+            // value of the bits above it.
+            unsigned reversed = reverse_bits(symbol_code, length);
+            for (unsigned index = reversed; index < (1u << max_fast_bits); index += (1u << length))
+                fast_table[index] = (length << 12) | symbol;
+        }
+    }
+    return true;
+}
+
+DeflateDecompressor::DeflateDecompressor()
+{
+    memset(m_window, 0, sizeof(m_window));
+    memset(&m_literal_code, 0, sizeof(m_literal_code));
+    memset(&m_distance_code, 0, sizeof(m_distance_code));
+}
+
+DeflateDecompressor::BitStreamPosition DeflateDecompressor::save_position() const
+{
+    return { m_input_offset, m_bit_buffer, m_bits_in_buffer };
+}
+
+void DeflateDecompressor::restore_position(const BitStreamPosition& position)
+{
+    m_input_offset = position.input_offset;
+    m_bit_buffer = position.bit_buffer;
+    m_bits_in_buffer = position.bits_in_buffer;
+}
+
+bool DeflateDecompressor::try_ensure_bits(unsigned count)
+{
+    while (m_bits_in_buffer < count) {
+        if (m_input_offset >= m_input.size())
+            return false;
+        m_bit_buffer |= (u32)m_input[m_input_offset++] << m_bits_in_buffer;
+        m_bits_in_buffer += 8;
+    }
+    return true;
+}
+
+u32 DeflateDecompressor::peek_bits(unsigned count) const
+{
+    return m_bit_buffer & ((1u << count) - 1);
+}
+
+void DeflateDecompressor::discard_bits(unsigned count)
+{
+    m_bit_buffer >>= count;
+    m_bits_in_buffer -= count;
+}
+
+bool DeflateDecompressor::try_read_bits(unsigned count, u32& value)
+{
+    if (!count) {
+        value = 0;
+        return true;
+    }
+    if (!try_ensure_bits(count))
+        return false;
+    value = peek_bits(count);
+    discard_bits(count);
+    return true;
+}
+
+bool DeflateDecompressor::try_decode_symbol(const CanonicalCode& code, unsigned& symbol)
+{
+    if (try_ensure_bits(CanonicalCode::max_fast_bits)) {
+        u16 entry = code.fast_table[peek_bits(CanonicalCode::max_fast_bits)];
+        if (entry) {
+            discard_bits(entry >> 12);
+            symbol = entry & 0xfff;
+            return true;
+        }
+    } else if (m_bits_in_buffer) {
+        // Near the end of the input we may not be able to peek a full
+        // max_fast_bits; entries are replicated across the missing upper
+        // bits, so a short enough code still resolves.
+        u16 entry = code.fast_table[peek_bits(CanonicalCode::max_fast_bits)];
+        if (entry && (unsigned)(entry >> 12) <= m_bits_in_buffer) {
+            discard_bits(entry >> 12);
+            symbol = entry & 0xfff;
+            return true;
+        }
+    }
+
+    // Slow path: walk the canonical code one bit at a time.
+    unsigned code_bits = 0;
+    unsigned first = 0;
+    unsigned index = 0;
+    for (unsigned length = 1; length <= 15; ++length) {
+        u32 bit;
+        if (!try_read_bits(1, bit))
+            return false;
+        code_bits = (code_bits << 1) | bit;
+        unsigned count = code.length_counts[length];
+        if (code_bits - first < count) {
+            symbol = code.sorted_symbols[index + (code_bits - first)];
+            return true;
+        }
+        index += count;
+        first = (first + count) << 1;
+    }
+    m_state = State::Error;
+    return false;
+}
+
+void DeflateDecompressor::emit_byte(u8 byte)
+{
+    m_window[m_window_position] = byte;
+    m_window_position = (m_window_position + 1) & (window_size - 1);
+    ++m_total_output;
+    m_output.append(byte);
+}
+
+bool DeflateDecompressor::copy_from_window(unsigned distance, unsigned length)
+{
+    if (!distance || distance > window_size || distance > m_total_output) {
+        m_state = State::Error;
+        return false;
+    }
+    for (unsigned i = 0; i < length; ++i) {
+        // Re-reading through the window as we go makes overlapping copies
+        // (distance < length) replicate, as DEFLATE requires.
+        u8 byte = m_window[(m_window_position - distance) & (window_size - 1)];
+        emit_byte(byte);
+    }
+    return true;
+}
+
+const DeflateDecompressor::CanonicalCode& DeflateDecompressor::fixed_literal_code()
+{
+    static CanonicalCode code;
+    static bool initialized = false;
+    if (!initialized) {
+        u8 lengths[288];
+        for (size_t i = 0; i < 144; ++i)
+            lengths[i] = 8;
+        for (size_t i = 144; i < 256; ++i)
+            lengths[i] = 9;
+        for (size_t i = 256; i < 280; ++i)
+            lengths[i] = 7;
+        for (size_t i = 280; i < 288; ++i)
+            lengths[i] = 8;
+        code.build(lengths, 288);
+        initialized = true;
+    }
+    return code;
+}
+
+const DeflateDecompressor::CanonicalCode& DeflateDecompressor::fixed_distance_code()
+{
+    static CanonicalCode code;
+    static bool initialized = false;
+    if (!initialized) {
+        u8 lengths[30];
+        for (size_t i = 0; i < 30; ++i)
+            lengths[i] = 5;
+        code.build(lengths, 30);
+        initialized = true;
+    }
+    return code;
+}
+
+bool DeflateDecompressor::read_dynamic_codes()
+{
+    u32 hlit, hdist, hclen;
+    if (!try_read_bits(5, hlit) || !try_read_bits(5, hdist) || !try_read_bits(4, hclen))
+        return false;
+    size_t literal_count = hlit + 257;
+    size_t distance_count = hdist + 1;
+    size_t code_length_count = hclen + 4;
+    if (literal_count > 286 || distance_count > 30) {
+        m_state = State::Error;
+        return false;
+    }
+
+    static const u8 code_length_order[19] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+    };
+    u8 code_length_lengths[19];
+    memset(code_length_lengths, 0, sizeof(code_length_lengths));
+    for (size_t i = 0; i < code_length_count; ++i) {
+        u32 length;
+        if (!try_read_bits(3, length))
+            return false;
+        code_length_lengths[code_length_order[i]] = length;
+    }
+
+    CanonicalCode code_length_code;
+    if (!code_length_code.build(code_length_lengths, 19)) {
+        m_state = State::Error;
+        return false;
+    }
+
+    u8 lengths[288 + 30];
+    size_t total = literal_count + distance_count;
+    size_t index = 0;
+    while (index < total) {
+        unsigned symbol;
+        if (!try_decode_symbol(code_length_code, symbol))
+            return false;
+        if (symbol < 16) {
+            lengths[index++] = symbol;
+            continue;
+        }
+        unsigned repeat;
+        u8 value = 0;
+        u32 extra;
+        if (symbol == 16) {
+            if (!index) {
+                m_state = State::Error;
+                return false;
+            }
+            if (!try_read_bits(2, extra))
+                return false;
+            repeat = 3 + extra;
+            value = lengths[index - 1];
+        } else if (symbol == 17) {
+            if (!try_read_bits(3, extra))
+                return false;
+            repeat = 3 + extra;
+        } else {
+            if (!try_read_bits(7, extra))
+                return false;
+            repeat = 11 + extra;
+        }
+        if (index + repeat > total) {
+            m_state = State::Error;
+            return false;
+        }
+        while (repeat--)
+            lengths[index++] = value;
+    }
+
+    if (!m_literal_code.build(lengths, literal_count)
+        || !m_distance_code.build(lengths + literal_count, distance_count)) {
+        m_state = State::Error;
+        return false;
+    }
+    return true;
+}
+
+bool DeflateDecompressor::process_block_header()
+{
+    u32 is_final, block_type;
+    if (!try_read_bits(1, is_final) || !try_read_bits(2, block_type))
+        return false;
+    m_is_final_block = is_final;
+
+    switch (block_type) {
+    case 0: {
+        // Stored blocks start at the next byte boundary.
+        discard_bits(m_bits_in_buffer % 8);
+        u32 length, inverted_length;
+        if (!try_read_bits(16, length) || !try_read_bits(16, inverted_length))
+            return false;
+        if ((length ^ 0xffff) != inverted_length) {
+            m_state = State::Error;
+            return false;
+        }
+        m_stored_bytes_remaining = length;
+        m_state = State::StoredBlock;
+        return true;
+    }
+    case 1:
+        m_literal_code = fixed_literal_code();
+        m_distance_code = fixed_distance_code();
+        m_state = State::CompressedBlock;
+        return true;
+    case 2:
+        if (!read_dynamic_codes())
+            return false;
+        m_state = State::CompressedBlock;
+        return true;
+    default:
+        m_state = State::Error;
+        return false;
+    }
+}
+
+bool DeflateDecompressor::process_stored_block()
+{
+    // Drain any whole bytes still sitting in the bit buffer, then copy
+    // straight from the input.
+    while (m_stored_bytes_remaining && m_bits_in_buffer >= 8) {
+        emit_byte(peek_bits(8));
+        discard_bits(8);
+        --m_stored_bytes_remaining;
+    }
+    while (m_stored_bytes_remaining && m_input_offset < m_input.size()) {
+        emit_byte(m_input[m_input_offset++]);
+        --m_stored_bytes_remaining;
+    }
+    if (m_stored_bytes_remaining)
+        return false;
+    m_state = m_is_final_block ? State::Finished : State::BlockHeader;
+    return true;
+}
+
+bool DeflateDecompressor::process_compressed_block()
+{
+    for (;;) {
+        auto saved = save_position();
+        unsigned symbol;
+        if (!try_decode_symbol(m_literal_code, symbol)) {
+            if (m_state != State::Error)
+                restore_position(saved);
+            return false;
+        }
+        if (symbol < 256) {
+            emit_byte(symbol);
+            continue;
+        }
+        if (symbol == 256) {
+            m_state = m_is_final_block ? State::Finished : State::BlockHeader;
+            return true;
+        }
+        if (symbol > 285) {
+            m_state = State::Error;
+            return false;
+        }
+
+        unsigned length_index = symbol - 257;
+        u32 extra;
+        if (!try_read_bits(length_extra_bits[length_index], extra)) {
+            restore_position(saved);
+            return false;
+        }
+        unsigned length = length_bases[length_index] + extra;
+
+        unsigned distance_symbol;
+        if (!try_decode_symbol(m_distance_code, distance_symbol)) {
+            if (m_state != State::Error)
+                restore_position(saved);
+            return false;
+        }
+        if (distance_symbol > 29) {
+            m_state = State::Error;
+            return false;
+        }
+        if (!try_read_bits(distance_extra_bits[distance_symbol], extra)) {
+            restore_position(saved);
+            return false;
+        }
+        unsigned distance = distance_bases[distance_symbol] + extra;
+
+        if (!copy_from_window(distance, length))
+            return false;
+    }
+}
+
+void DeflateDecompressor::process()
+{
+    for (;;) {
+        switch (m_state) {
+        case State::BlockHeader: {
+            auto saved = save_position();
+            if (!process_block_header()) {
+                if (m_state != State::Error)
+                    restore_position(saved);
+                return;
+            }
+            break;
+        }
+        case State::StoredBlock:
+            if (!process_stored_block())
+                return;
+            break;
+        case State::CompressedBlock:
+            if (!process_compressed_block())
+                return;
+            break;
+        case State::Finished:
+        case State::Error:
+            return;
+        }
+    }
+}
+
+bool DeflateDecompressor::write(const u8* data, size_t size)
+{
+    if (m_state == State::Error)
+        return false;
+    m_input.append(data, size);
+    process();
+    // Drop consumed input so the pending buffer doesn't grow without bound.
+    if (m_input_offset == m_input.size()) {
+        m_input.clear_with_capacity();
+        m_input_offset = 0;
+    } else if (m_input_offset >= 16 * 1024) {
+        Vector<u8> remaining;
+        remaining.append(m_input.data() + m_input_offset, m_input.size() - m_input_offset);
+        m_input = move(remaining);
+        m_input_offset = 0;
+    }
+    return m_state != State::Error;
+}
+
+ByteBuffer DeflateDecompressor::take_output()
+{
+    auto buffer = ByteBuffer::copy(m_output.data(), m_output.size());
+    m_output.clear_with_capacity();
+    return buffer;
+}
+
+Optional<ByteBuffer> DeflateDecompressor::decompress_all(const u8* data, size_t size)
+{
+    DeflateDecompressor decompressor;
+    if (!decompressor.write(data, size))
+        return {};
+    if (!decompressor.is_finished())
+        return {};
+    return decompressor.take_output();
+}
+
+}
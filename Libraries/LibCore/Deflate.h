@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace Core {
+
+// A streaming DEFLATE (RFC 1951) decompressor. Compressed input may be fed
+// in arbitrary chunks with write() as it arrives off the network, and the
+// decompressed bytes drained with take_output() as they become available.
+// decompress_all() is the one-shot convenience wrapper.
+class DeflateDecompressor {
+public:
+    DeflateDecompressor();
+
+    // Feed a chunk of compressed input and decompress as much as possible.
+    // Returns false if the stream turns out to be corrupt.
+    bool write(const u8* data, size_t size);
+
+    // Hand out everything decompressed since the last call.
+    ByteBuffer take_output();
+
+    bool is_finished() const { return m_state == State::Finished; }
+    bool has_error() const { return m_state == State::Error; }
+
+    // Inflate an entire raw DEFLATE stream in one go.
+    static Optional<ByteBuffer> decompress_all(const u8* data, size_t size);
+
+private:
+    // A canonical Huffman code with a multi-bit lookup table: codes no
+    // longer than max_fast_bits resolve with a single table load, longer
+    // codes fall back to a bit-by-bit canonical walk.
+    struct CanonicalCode {
+        static const unsigned max_fast_bits = 9;
+        // (code length << 12) | symbol, or 0 if no code of <= max_fast_bits
+        // bits matches this bit pattern.
+        u16 fast_table[1 << max_fast_bits];
+        u16 length_counts[16];
+        u16 sorted_symbols[288];
+
+        bool build(const u8* code_lengths, size_t symbol_count);
+    };
+
+    enum class State {
+        BlockHeader,
+        StoredBlock,
+        CompressedBlock,
+        Finished,
+        Error,
+    };
+
+    // Everything needed to rewind the bit reader when we run out of input
+    // in the middle of a symbol and have to wait for the next write().
+    struct BitStreamPosition {
+        size_t input_offset;
+        u32 bit_buffer;
+        unsigned bits_in_buffer;
+    };
+
+    BitStreamPosition save_position() const;
+    void restore_position(const BitStreamPosition&);
+
+    bool try_ensure_bits(unsigned count);
+    u32 peek_bits(unsigned count) const;
+    void discard_bits(unsigned count);
+    bool try_read_bits(unsigned count, u32& value);
+    bool try_decode_symbol(const CanonicalCode&, unsigned& symbol);
+
+    void emit_byte(u8);
+    bool copy_from_window(unsigned distance, unsigned length);
+
+    void process();
+    bool process_block_header();
+    bool process_stored_block();
+    bool process_compressed_block();
+    bool read_dynamic_codes();
+
+    static const CanonicalCode& fixed_literal_code();
+    static const CanonicalCode& fixed_distance_code();
+
+    State m_state { State::BlockHeader };
+    bool m_is_final_block { false };
+
+    Vector<u8> m_input;
+    size_t m_input_offset { 0 };
+    u32 m_bit_buffer { 0 };
+    unsigned m_bits_in_buffer { 0 };
+
+    size_t m_stored_bytes_remaining { 0 };
+
+    CanonicalCode m_literal_code;
+    CanonicalCode m_distance_code;
+
+    Vector<u8> m_output;
+
+    // LZ77 history window; back-references reach at most 32KiB back.
+    static const size_t window_size = 32 * 1024;
+    u8 m_window[window_size];
+    size_t m_window_position { 0 };
+    size_t m_total_output { 0 };
+};
+
+}
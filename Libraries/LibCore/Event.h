@@ -57,6 +57,17 @@ public:
 
     unsigned type() const { return m_type; }
 
+    // An idempotent event class may opt into coalescing: when one is posted
+    // while the receiver's most recently queued event has the same type, the
+    // queued event absorbs the new one instead of the queue growing.
+    virtual bool is_coalescible() const { return false; }
+    // Merge a newer coalescible event (same receiver and type) into this one.
+    virtual void absorb(Event&&) {}
+
+    // High-priority events (paints) are dispatched ahead of other queued
+    // events so they aren't starved behind event storms.
+    virtual bool is_high_priority() const { return false; }
+
     bool is_accepted() const { return m_accepted; }
     void accept() { m_accepted = true; }
     void ignore() { m_accepted = false; }
@@ -81,6 +81,80 @@ int EventLoop::s_wake_pipe_fds[2];
 static RefPtr<LocalServer> s_rpc_server;
 HashMap<int, RefPtr<RPCClient>> s_rpc_clients;
 
+// Min-heap over timer fire times so that finding the next expiration is O(1)
+// instead of a walk over every registered timer. Entries are never erased from
+// the middle: when a timer is unregistered or reloaded, its old entry goes
+// stale and is discarded lazily when it reaches the top of the heap.
+struct EventLoopTimerHeapEntry {
+    timeval fire_time { 0, 0 };
+    int timer_id { 0 };
+};
+static Vector<EventLoopTimerHeapEntry>* s_timer_heap;
+
+// Incrementally maintained mirror of all notifier fds. wait_for_event() copies
+// these instead of rebuilding the sets from every notifier on each iteration.
+static fd_set s_notifier_read_fds;
+static fd_set s_notifier_write_fds;
+static int s_highest_notifier_fd { -1 };
+
+static bool timeval_less(const timeval& a, const timeval& b)
+{
+    return a.tv_sec < b.tv_sec || (a.tv_sec == b.tv_sec && a.tv_usec < b.tv_usec);
+}
+
+static void timer_heap_push(const timeval& fire_time, int timer_id)
+{
+    auto& heap = *s_timer_heap;
+    heap.append({ fire_time, timer_id });
+    size_t index = heap.size() - 1;
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!timeval_less(heap[index].fire_time, heap[parent].fire_time))
+            break;
+        swap(heap[index], heap[parent]);
+        index = parent;
+    }
+}
+
+static void timer_heap_pop()
+{
+    auto& heap = *s_timer_heap;
+    heap[0] = heap.last();
+    heap.take_last();
+    size_t index = 0;
+    for (;;) {
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        size_t smallest = index;
+        if (left < heap.size() && timeval_less(heap[left].fire_time, heap[smallest].fire_time))
+            smallest = left;
+        if (right < heap.size() && timeval_less(heap[right].fire_time, heap[smallest].fire_time))
+            smallest = right;
+        if (smallest == index)
+            break;
+        swap(heap[index], heap[smallest]);
+        index = smallest;
+    }
+}
+
+// Returns the live timer whose entry sits at the top of the heap, discarding
+// stale entries along the way. Null only if the heap runs empty.
+static EventLoopTimer* live_timer_at_heap_top()
+{
+    while (!s_timer_heap->is_empty()) {
+        auto& entry = s_timer_heap->first();
+        auto it = s_timers->find(entry.timer_id);
+        if (it == s_timers->end()
+            || it->value->fire_time.tv_sec != entry.fire_time.tv_sec
+            || it->value->fire_time.tv_usec != entry.fire_time.tv_usec) {
+            timer_heap_pop();
+            continue;
+        }
+        return it->value.ptr();
+    }
+    return nullptr;
+}
+
 class RPCClient : public Object {
     C_OBJECT(RPCClient)
 public:
@@ -217,7 +291,10 @@ EventLoop::EventLoop()
     if (!s_event_loop_stack) {
         s_event_loop_stack = new Vector<EventLoop*>;
         s_timers = new HashMap<int, NonnullOwnPtr<EventLoopTimer>>;
+        s_timer_heap = new Vector<EventLoopTimerHeapEntry>;
         s_notifiers = new HashTable<Notifier*>;
+        FD_ZERO(&s_notifier_read_fds);
+        FD_ZERO(&s_notifier_write_fds);
     }
 
     if (!s_main_event_loop) {
@@ -329,6 +406,28 @@ void EventLoop::pump(WaitMode mode)
         events = move(m_queued_events);
     }
 
+    // Dispatch high-priority events (paints) first so a burst of queued
+    // timer or notifier events can't starve rendering.
+    bool have_high_priority_events = false;
+    for (auto& queued_event : events) {
+        if (queued_event.event->is_high_priority()) {
+            have_high_priority_events = true;
+            break;
+        }
+    }
+    if (have_high_priority_events) {
+        decltype(m_queued_events) high_priority_events;
+        decltype(m_queued_events) normal_events;
+        for (auto& queued_event : events) {
+            if (queued_event.event->is_high_priority())
+                high_priority_events.append(move(queued_event));
+            else
+                normal_events.append(move(queued_event));
+        }
+        events = move(high_priority_events);
+        events.append(move(normal_events));
+    }
+
     for (size_t i = 0; i < events.size(); ++i) {
         auto& queued_event = events.at(i);
         auto* receiver = queued_event.receiver.ptr();
@@ -377,34 +476,34 @@ void EventLoop::post_event(Object& receiver, NonnullOwnPtr<Event>&& event)
 #ifdef CEVENTLOOP_DEBUG
     dbg() << "Core::EventLoop::post_event: {" << m_queued_events.size() << "} << receiver=" << receiver << ", event=" << event;
 #endif
+    if (event->is_coalescible()) {
+        // Only coalesce with the receiver's most recently queued event, so
+        // we never move an event past a later one for the same receiver.
+        for (size_t i = m_queued_events.size(); i > 0; --i) {
+            auto& queued_event = m_queued_events[i - 1];
+            if (queued_event.receiver.ptr() != &receiver)
+                continue;
+            if (queued_event.event->type() == event->type()) {
+                queued_event.event->absorb(move(*event));
+                return;
+            }
+            break;
+        }
+    }
     m_queued_events.empend(receiver, move(event));
 }
 
 void EventLoop::wait_for_event(WaitMode mode)
 {
-    fd_set rfds;
-    fd_set wfds;
-    FD_ZERO(&rfds);
-    FD_ZERO(&wfds);
-
-    int max_fd = 0;
-    auto add_fd_to_set = [&max_fd](int fd, fd_set& set) {
-        FD_SET(fd, &set);
-        if (fd > max_fd)
-            max_fd = fd;
-    };
-
-    int max_fd_added = -1;
-    add_fd_to_set(s_wake_pipe_fds[0], rfds);
-    max_fd = max(max_fd, max_fd_added);
-    for (auto& notifier : *s_notifiers) {
-        if (notifier->event_mask() & Notifier::Read)
-            add_fd_to_set(notifier->fd(), rfds);
-        if (notifier->event_mask() & Notifier::Write)
-            add_fd_to_set(notifier->fd(), wfds);
-        if (notifier->event_mask() & Notifier::Exceptional)
-            ASSERT_NOT_REACHED();
-    }
+    // select() scribbles on the sets it's given, so hand it copies of the
+    // incrementally maintained notifier sets.
+    fd_set rfds = s_notifier_read_fds;
+    fd_set wfds = s_notifier_write_fds;
+
+    int max_fd = s_highest_notifier_fd;
+    FD_SET(s_wake_pipe_fds[0], &rfds);
+    if (s_wake_pipe_fds[0] > max_fd)
+        max_fd = s_wake_pipe_fds[0];
 
     bool queued_events_is_empty;
     {
@@ -452,26 +551,37 @@ void EventLoop::wait_for_event(WaitMode mode)
         now.tv_usec = now_spec.tv_nsec / 1000;
     }
 
-    for (auto& it : *s_timers) {
-        auto& timer = *it.value;
-        if (!timer.has_expired(now))
-            continue;
-        if (it.value->fire_when_not_visible == TimerShouldFireWhenNotVisible::No
-            && it.value->owner
-            && !it.value->owner->is_visible_for_timer_purposes()) {
+    // Fire expired timers straight off the top of the heap. Expired timers
+    // whose owner isn't visible stay registered but don't fire yet; set their
+    // entries aside and push them back once we're done so they keep their
+    // place in the heap.
+    Vector<EventLoopTimerHeapEntry, 8> deferred_entries;
+    for (;;) {
+        auto* timer = live_timer_at_heap_top();
+        if (!timer || !timer->has_expired(now))
+            break;
+        if (timer->fire_when_not_visible == TimerShouldFireWhenNotVisible::No
+            && timer->owner
+            && !timer->owner->is_visible_for_timer_purposes()) {
+            deferred_entries.append(s_timer_heap->first());
+            timer_heap_pop();
             continue;
         }
 #ifdef CEVENTLOOP_DEBUG
-        dbg() << "Core::EventLoop: Timer " << timer.timer_id << " has expired, sending Core::TimerEvent to " << timer.owner;
+        dbg() << "Core::EventLoop: Timer " << timer->timer_id << " has expired, sending Core::TimerEvent to " << timer->owner;
 #endif
-        post_event(*timer.owner, make<TimerEvent>(timer.timer_id));
-        if (timer.should_reload) {
-            timer.reload(now);
+        post_event(*timer->owner, make<TimerEvent>(timer->timer_id));
+        timer_heap_pop();
+        if (timer->should_reload) {
+            timer->reload(now);
+            timer_heap_push(timer->fire_time, timer->timer_id);
         } else {
             // FIXME: Support removing expired timers that don't want to reload.
             ASSERT_NOT_REACHED();
         }
     }
+    for (auto& entry : deferred_entries)
+        timer_heap_push(entry.fire_time, entry.timer_id);
 
     if (!marked_fd_count)
         return;
@@ -503,18 +613,26 @@ void EventLoopTimer::reload(const timeval& now)
 void EventLoop::get_next_timer_expiration(timeval& soonest)
 {
     ASSERT(!s_timers->is_empty());
-    bool has_checked_any = false;
-    for (auto& it : *s_timers) {
-        auto& fire_time = it.value->fire_time;
-        if (it.value->fire_when_not_visible == TimerShouldFireWhenNotVisible::No
-            && it.value->owner
-            && !it.value->owner->is_visible_for_timer_purposes()) {
+    // Pop past entries whose timer can't fire right now because its owner
+    // isn't visible, then push them back; the heap top is then the soonest
+    // timer that can actually fire.
+    Vector<EventLoopTimerHeapEntry, 8> invisible_entries;
+    for (;;) {
+        auto* timer = live_timer_at_heap_top();
+        if (!timer)
+            break;
+        if (timer->fire_when_not_visible == TimerShouldFireWhenNotVisible::No
+            && timer->owner
+            && !timer->owner->is_visible_for_timer_purposes()) {
+            invisible_entries.append(s_timer_heap->first());
+            timer_heap_pop();
             continue;
         }
-        if (!has_checked_any || fire_time.tv_sec < soonest.tv_sec || (fire_time.tv_sec == soonest.tv_sec && fire_time.tv_usec < soonest.tv_usec))
-            soonest = fire_time;
-        has_checked_any = true;
+        soonest = timer->fire_time;
+        break;
     }
+    for (auto& entry : invisible_entries)
+        timer_heap_push(entry.fire_time, entry.timer_id);
 }
 
 int EventLoop::register_timer(Object& object, int milliseconds, bool should_reload, TimerShouldFireWhenNotVisible fire_when_not_visible)
@@ -533,6 +651,7 @@ int EventLoop::register_timer(Object& object, int milliseconds, bool should_relo
     timer->fire_when_not_visible = fire_when_not_visible;
     int timer_id = s_id_allocator->allocate();
     timer->timer_id = timer_id;
+    timer_heap_push(timer->fire_time, timer_id);
     s_timers->set(timer_id, move(timer));
     return timer_id;
 }
@@ -543,6 +662,8 @@ bool EventLoop::unregister_timer(int timer_id)
     auto it = s_timers->find(timer_id);
     if (it == s_timers->end())
         return false;
+    // The heap entry for this timer is now stale and will be discarded when
+    // it bubbles up to the top.
     s_timers->remove(it);
     return true;
 }
@@ -550,11 +671,34 @@ bool EventLoop::unregister_timer(int timer_id)
 void EventLoop::register_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->set(&notifier);
+    if (notifier.event_mask() & Notifier::Read)
+        FD_SET(notifier.fd(), &s_notifier_read_fds);
+    if (notifier.event_mask() & Notifier::Write)
+        FD_SET(notifier.fd(), &s_notifier_write_fds);
+    if (notifier.event_mask() & Notifier::Exceptional)
+        ASSERT_NOT_REACHED();
+    if (notifier.fd() > s_highest_notifier_fd)
+        s_highest_notifier_fd = notifier.fd();
 }
 
 void EventLoop::unregister_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->remove(&notifier);
+    FD_CLR(notifier.fd(), &s_notifier_read_fds);
+    FD_CLR(notifier.fd(), &s_notifier_write_fds);
+    // Another notifier may share the fd we just cleared, so restore any
+    // surviving interest, and recompute the highest fd while we're at it.
+    s_highest_notifier_fd = -1;
+    for (auto& other : *s_notifiers) {
+        if (other->fd() == notifier.fd()) {
+            if (other->event_mask() & Notifier::Read)
+                FD_SET(other->fd(), &s_notifier_read_fds);
+            if (other->event_mask() & Notifier::Write)
+                FD_SET(other->fd(), &s_notifier_write_fds);
+        }
+        if (other->fd() > s_highest_notifier_fd)
+            s_highest_notifier_fd = other->fd();
+    }
 }
 
 void EventLoop::wake()
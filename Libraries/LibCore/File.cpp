@@ -28,6 +28,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -41,6 +42,14 @@ Result<NonnullRefPtr<File>, String> File::open(const String& filename, IODevice:
     return file;
 }
 
+Result<MappedFile, String> File::map(const String& filename)
+{
+    MappedFile mapped_file(filename);
+    if (!mapped_file.is_valid())
+        return String::format("Could not map %s: %s", filename.characters(), strerror(errno));
+    return move(mapped_file);
+}
+
 File::File(const StringView& filename, Object* parent)
     : IODevice(parent)
     , m_filename(filename)
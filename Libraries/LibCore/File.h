@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/MappedFile.h>
 #include <AK/Result.h>
 #include <AK/String.h>
 #include <LibCore/IODevice.h>
@@ -39,6 +40,11 @@ public:
 
     static Result<NonnullRefPtr<File>, String> open(const String& filename, IODevice::OpenMode, mode_t = 0644);
 
+    // Memory-map an entire file read-only instead of streaming it through
+    // read(). Whole-file consumers (image decoders, font loaders, etc.)
+    // should prefer this; the mapping is released when the MappedFile dies.
+    static Result<MappedFile, String> map(const String& filename);
+
     String filename() const { return m_filename; }
     void set_filename(const StringView& filename) { m_filename = filename; }
 
@@ -26,8 +26,8 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/Optional.h>
+#include <LibCore/Deflate.h>
 #include <LibCore/Gzip.h>
-#include <LibCore/puff.h>
 #include <limits.h>
 #include <stddef.h>
 
@@ -117,39 +117,12 @@ Optional<ByteBuffer> Gzip::decompress(const ByteBuffer& data)
     }
 
     auto source = optional_payload.value();
-    unsigned long source_len = source.size();
-    auto destination = ByteBuffer::create_uninitialized(1024);
-    while (true) {
-        unsigned long destination_len = destination.size();
-
-#ifdef DEBUG_GZIP
-        dbg() << "Gzip::decompress: Calling puff()\n"
-              << "  destination_data = " << destination.data() << "\n"
-              << "  destination_len = " << destination_len << "\n"
-              << "  source_data = " << source.data() << "\n"
-              << "  source_len = " << source_len;
-#endif
-
-        auto puff_ret = puff(
-            destination.data(), &destination_len,
-            source.data(), &source_len);
-
-        if (puff_ret == 0) {
-            dbg() << "Gzip::decompress: Decompression success.";
-            destination.trim(destination_len);
-            break;
-        }
-
-        if (puff_ret == 1) {
-            // FIXME: Find a better way of decompressing without needing to try over and over again.
-            dbg() << "Gzip::decompress: Output buffer exhausted. Growing.";
-            destination.grow(destination.size() * 2);
-        } else {
-            dbg() << "Gzip::decompress: Error. puff() returned: " << puff_ret;
-            ASSERT_NOT_REACHED();
-        }
+    auto destination = DeflateDecompressor::decompress_all(source.data(), source.size());
+    if (!destination.has_value()) {
+        dbg() << "Gzip::decompress: DEFLATE stream is invalid or truncated.";
+        return Optional<ByteBuffer>();
     }
-
+    dbg() << "Gzip::decompress: Decompression success. Size = " << destination.value().size();
     return destination;
 }
 
@@ -143,18 +143,40 @@ ByteBuffer IODevice::read_all()
     off_t file_size = 0;
     struct stat st;
     int rc = fstat(fd(), &st);
-    if (rc == 0)
+    if (rc == 0 && S_ISREG(st.st_mode))
         file_size = st.st_size;
 
-    Vector<u8> data;
-    data.ensure_capacity(file_size);
+    size_t buffered_size = m_buffered_data.size();
+    auto buffer = ByteBuffer::create_uninitialized(buffered_size + file_size);
+    size_t used = 0;
 
-    if (!m_buffered_data.is_empty()) {
-        data.append(m_buffered_data.data(), m_buffered_data.size());
+    if (buffered_size) {
+        memcpy(buffer.data(), m_buffered_data.data(), buffered_size);
         m_buffered_data.clear();
+        used = buffered_size;
+    }
+
+    // Regular files: read the size stat() reported straight into place
+    // instead of going through a 4KiB chunk-and-append loop.
+    bool saw_eof = false;
+    while (used < buffer.size()) {
+        int nread = ::read(m_fd, buffer.data() + used, buffer.size() - used);
+        if (nread < 0) {
+            set_error(errno);
+            buffer.trim(used);
+            return buffer.is_empty() ? ByteBuffer() : buffer;
+        }
+        if (nread == 0) {
+            set_eof(true);
+            saw_eof = true;
+            break;
+        }
+        used += nread;
     }
 
-    while (true) {
+    // Pipes, sockets and anything that grew since the stat() still get
+    // drained the chunked way.
+    while (!saw_eof) {
         char read_buffer[4096];
         int nread = ::read(m_fd, read_buffer, sizeof(read_buffer));
         if (nread < 0) {
@@ -165,11 +187,16 @@ ByteBuffer IODevice::read_all()
             set_eof(true);
             break;
         }
-        data.append((const u8*)read_buffer, nread);
+        if (used + (size_t)nread > buffer.size())
+            buffer.grow(max(buffer.size() * 2, used + (size_t)nread));
+        memcpy(buffer.data() + used, read_buffer, nread);
+        used += nread;
     }
-    if (data.is_empty())
+
+    buffer.trim(used);
+    if (buffer.is_empty())
         return {};
-    return ByteBuffer::copy(data.data(), data.size());
+    return buffer;
 }
 
 ByteBuffer IODevice::read_line(size_t max_size)
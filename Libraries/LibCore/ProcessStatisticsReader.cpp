@@ -24,8 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
+#include <AK/JsonParser.h>
 #include <AK/JsonValue.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
@@ -36,6 +35,163 @@ namespace Core {
 
 HashMap<uid_t, String> ProcessStatisticsReader::s_usernames;
 
+// Builds the process map directly from the parser's event stream, so the
+// JsonValue tree for /proc/all (easily hundreds of kilobytes) is never
+// materialized.
+class ProcessStatisticsClient final : public JsonParser::StreamingClient {
+public:
+    explicit ProcessStatisticsClient(HashMap<pid_t, Core::ProcessStatistics>& map)
+        : m_map(map)
+    {
+    }
+
+    virtual void on_object_start() override
+    {
+        if (m_state == State::InProcessArray) {
+            m_state = State::InProcess;
+            m_process = {};
+        } else if (m_state == State::InThreadArray) {
+            m_state = State::InThread;
+            m_thread = {};
+        }
+    }
+
+    virtual void on_object_key(const StringView& key) override
+    {
+        m_key = key;
+    }
+
+    virtual void on_object_end() override
+    {
+        if (m_state == State::InThread) {
+            m_process.threads.append(move(m_thread));
+            m_state = State::InThreadArray;
+        } else if (m_state == State::InProcess) {
+            m_map.set(m_process.pid, move(m_process));
+            m_state = State::InProcessArray;
+        }
+    }
+
+    virtual void on_array_start() override
+    {
+        if (m_state == State::Start)
+            m_state = State::InProcessArray;
+        else if (m_state == State::InProcess && m_key == "threads")
+            m_state = State::InThreadArray;
+    }
+
+    virtual void on_array_end() override
+    {
+        if (m_state == State::InThreadArray)
+            m_state = State::InProcess;
+        else if (m_state == State::InProcessArray)
+            m_state = State::Start;
+    }
+
+    virtual void on_string(const StringView& value) override
+    {
+        if (m_state == State::InProcess) {
+            if (m_key == "name")
+                m_process.name = value;
+            else if (m_key == "tty")
+                m_process.tty = value;
+            else if (m_key == "pledge")
+                m_process.pledge = value;
+            else if (m_key == "veil")
+                m_process.veil = value;
+        } else if (m_state == State::InThread) {
+            if (m_key == "name")
+                m_thread.name = value;
+            else if (m_key == "state")
+                m_thread.state = value;
+        }
+    }
+
+    virtual void on_number(const JsonValue& value) override
+    {
+        if (m_state == State::InProcess) {
+            if (m_key == "pid")
+                m_process.pid = value.to_u32();
+            else if (m_key == "pgid")
+                m_process.pgid = value.to_u32();
+            else if (m_key == "pgp")
+                m_process.pgp = value.to_u32();
+            else if (m_key == "sid")
+                m_process.sid = value.to_u32();
+            else if (m_key == "uid")
+                m_process.uid = value.to_u32();
+            else if (m_key == "gid")
+                m_process.gid = value.to_u32();
+            else if (m_key == "ppid")
+                m_process.ppid = value.to_u32();
+            else if (m_key == "nfds")
+                m_process.nfds = value.to_u32();
+            else if (m_key == "amount_virtual")
+                m_process.amount_virtual = value.to_u32();
+            else if (m_key == "amount_resident")
+                m_process.amount_resident = value.to_u32();
+            else if (m_key == "amount_shared")
+                m_process.amount_shared = value.to_u32();
+            else if (m_key == "amount_dirty_private")
+                m_process.amount_dirty_private = value.to_u32();
+            else if (m_key == "amount_clean_inode")
+                m_process.amount_clean_inode = value.to_u32();
+            else if (m_key == "amount_purgeable_volatile")
+                m_process.amount_purgeable_volatile = value.to_u32();
+            else if (m_key == "amount_purgeable_nonvolatile")
+                m_process.amount_purgeable_nonvolatile = value.to_u32();
+            else if (m_key == "icon_id")
+                m_process.icon_id = value.to_int();
+        } else if (m_state == State::InThread) {
+            if (m_key == "tid")
+                m_thread.tid = value.to_u32();
+            else if (m_key == "times_scheduled")
+                m_thread.times_scheduled = value.to_u32();
+            else if (m_key == "ticks")
+                m_thread.ticks = value.to_u32();
+            else if (m_key == "priority")
+                m_thread.priority = value.to_u32();
+            else if (m_key == "effective_priority")
+                m_thread.effective_priority = value.to_u32();
+            else if (m_key == "syscall_count")
+                m_thread.syscall_count = value.to_u32();
+            else if (m_key == "inode_faults")
+                m_thread.inode_faults = value.to_u32();
+            else if (m_key == "zero_faults")
+                m_thread.zero_faults = value.to_u32();
+            else if (m_key == "cow_faults")
+                m_thread.cow_faults = value.to_u32();
+            else if (m_key == "unix_socket_read_bytes")
+                m_thread.unix_socket_read_bytes = value.to_u32();
+            else if (m_key == "unix_socket_write_bytes")
+                m_thread.unix_socket_write_bytes = value.to_u32();
+            else if (m_key == "ipv4_socket_read_bytes")
+                m_thread.ipv4_socket_read_bytes = value.to_u32();
+            else if (m_key == "ipv4_socket_write_bytes")
+                m_thread.ipv4_socket_write_bytes = value.to_u32();
+            else if (m_key == "file_read_bytes")
+                m_thread.file_read_bytes = value.to_u32();
+            else if (m_key == "file_write_bytes")
+                m_thread.file_write_bytes = value.to_u32();
+        }
+    }
+
+private:
+    enum class State {
+        Start,
+        InProcessArray,
+        InProcess,
+        InThreadArray,
+        InThread,
+    };
+
+    HashMap<pid_t, Core::ProcessStatistics>& m_map;
+    State m_state { State::Start };
+    String m_key;
+    Core::ProcessStatistics m_process;
+    Core::ThreadStatistics m_thread;
+};
+
 HashMap<pid_t, Core::ProcessStatistics> ProcessStatisticsReader::get_all()
 {
     auto file = Core::File::construct("/proc/all");
@@ -47,62 +203,12 @@ HashMap<pid_t, Core::ProcessStatistics> ProcessStatisticsReader::get_all()
     HashMap<pid_t, Core::ProcessStatistics> map;
 
     auto file_contents = file->read_all();
-    auto json = JsonValue::from_string(file_contents);
-    json.as_array().for_each([&](auto& value) {
-        const JsonObject& process_object = value.as_object();
-        Core::ProcessStatistics process;
-
-        // kernel data first
-        process.pid = process_object.get("pid").to_u32();
-        process.pgid = process_object.get("pgid").to_u32();
-        process.pgp = process_object.get("pgp").to_u32();
-        process.sid = process_object.get("sid").to_u32();
-        process.uid = process_object.get("uid").to_u32();
-        process.gid = process_object.get("gid").to_u32();
-        process.ppid = process_object.get("ppid").to_u32();
-        process.nfds = process_object.get("nfds").to_u32();
-        process.name = process_object.get("name").to_string();
-        process.tty = process_object.get("tty").to_string();
-        process.pledge = process_object.get("pledge").to_string();
-        process.veil = process_object.get("veil").to_string();
-        process.amount_virtual = process_object.get("amount_virtual").to_u32();
-        process.amount_resident = process_object.get("amount_resident").to_u32();
-        process.amount_shared = process_object.get("amount_shared").to_u32();
-        process.amount_dirty_private = process_object.get("amount_dirty_private").to_u32();
-        process.amount_clean_inode = process_object.get("amount_clean_inode").to_u32();
-        process.amount_purgeable_volatile = process_object.get("amount_purgeable_volatile").to_u32();
-        process.amount_purgeable_nonvolatile = process_object.get("amount_purgeable_nonvolatile").to_u32();
-        process.icon_id = process_object.get("icon_id").to_int();
-
-        auto& thread_array = process_object.get_ptr("threads")->as_array();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
-            Core::ThreadStatistics thread;
-            thread.tid = thread_object.get("tid").to_u32();
-            thread.times_scheduled = thread_object.get("times_scheduled").to_u32();
-            thread.name = thread_object.get("name").to_string();
-            thread.state = thread_object.get("state").to_string();
-            thread.ticks = thread_object.get("ticks").to_u32();
-            thread.priority = thread_object.get("priority").to_u32();
-            thread.effective_priority = thread_object.get("effective_priority").to_u32();
-            thread.syscall_count = thread_object.get("syscall_count").to_u32();
-            thread.inode_faults = thread_object.get("inode_faults").to_u32();
-            thread.zero_faults = thread_object.get("zero_faults").to_u32();
-            thread.cow_faults = thread_object.get("cow_faults").to_u32();
-            thread.unix_socket_read_bytes = thread_object.get("unix_socket_read_bytes").to_u32();
-            thread.unix_socket_write_bytes = thread_object.get("unix_socket_write_bytes").to_u32();
-            thread.ipv4_socket_read_bytes = thread_object.get("ipv4_socket_read_bytes").to_u32();
-            thread.ipv4_socket_write_bytes = thread_object.get("ipv4_socket_write_bytes").to_u32();
-            thread.file_read_bytes = thread_object.get("file_read_bytes").to_u32();
-            thread.file_write_bytes = thread_object.get("file_write_bytes").to_u32();
-            process.threads.append(move(thread));
-        });
-
-        // and synthetic data last
-        process.username = username_from_uid(process.uid);
-        map.set(process.pid, process);
-    });
+    ProcessStatisticsClient client(map);
+    JsonParser parser(file_contents);
+    parser.parse(client);
+
+    for (auto& it : map)
+        it.value.username = username_from_uid(it.value.uid);
 
     return map;
 }
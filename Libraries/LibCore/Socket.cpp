@@ -190,6 +190,12 @@ void Socket::did_update_fd(int fd)
     }
 }
 
+void Socket::set_read_notifications_enabled(bool enabled)
+{
+    if (m_read_notifier)
+        m_read_notifier->set_enabled(enabled);
+}
+
 void Socket::ensure_read_notifier()
 {
     ASSERT(m_connected);
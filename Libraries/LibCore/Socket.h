@@ -55,6 +55,10 @@ public:
     bool is_connected() const { return m_connected; }
     void set_blocking(bool blocking);
 
+    // Temporarily stop (or resume) on_ready_to_read callbacks without
+    // tearing down the hook. Useful for flow control.
+    void set_read_notifications_enabled(bool);
+
     SocketAddress source_address() const { return m_source_address; }
     int source_port() const { return m_source_port; }
 
@@ -73,7 +73,9 @@ namespace Cipher {
             auto block_size = cipher.block_size();
 
             while (length >= block_size) {
-                block.overwrite(in.slice_view(offset, block_size));
+                // Note: not in.slice_view() -- wrapping up a view allocates,
+                // and we'd be doing it once per block.
+                block.overwrite(in.offset_pointer(offset), block_size);
                 block.apply_initialization_vector(iv);
                 cipher.encrypt_block(block, block);
                 out.overwrite(offset, block.get().data(), block_size);
@@ -83,7 +85,7 @@ namespace Cipher {
             }
 
             if (length > 0) {
-                block.overwrite(in.slice_view(offset, length));
+                block.overwrite(in.offset_pointer(offset), length);
                 block.apply_initialization_vector(iv);
                 cipher.encrypt_block(block, block);
                 out.overwrite(offset, block.get().data(), block_size);
@@ -88,13 +88,34 @@ inline void SHA256::transform(const u8* data)
 
 void SHA256::update(const u8* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
+    // Fill up (and flush) any partial block we are holding on to first.
+    if (m_data_length) {
+        auto available = BlockSize - m_data_length;
+        if (available > length)
+            available = length;
+        __builtin_memcpy(m_data_buffer + m_data_length, message, available);
+        m_data_length += available;
+        message += available;
+        length -= available;
         if (m_data_length == BlockSize) {
             transform(m_data_buffer);
             m_bit_length += 512;
             m_data_length = 0;
         }
-        m_data_buffer[m_data_length++] = message[i];
+    }
+
+    // Hash whole blocks straight out of the message, without staging them
+    // through the data buffer a byte at a time.
+    while (length >= BlockSize) {
+        transform(message);
+        m_bit_length += 512;
+        message += BlockSize;
+        length -= BlockSize;
+    }
+
+    if (length) {
+        __builtin_memcpy(m_data_buffer, message, length);
+        m_data_length = length;
     }
 }
 
@@ -196,13 +217,34 @@ inline void SHA512::transform(const u8* data)
 
 void SHA512::update(const u8* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
+    // Fill up (and flush) any partial block we are holding on to first.
+    if (m_data_length) {
+        auto available = BlockSize - m_data_length;
+        if (available > length)
+            available = length;
+        __builtin_memcpy(m_data_buffer + m_data_length, message, available);
+        m_data_length += available;
+        message += available;
+        length -= available;
         if (m_data_length == BlockSize) {
             transform(m_data_buffer);
             m_bit_length += 1024;
             m_data_length = 0;
         }
-        m_data_buffer[m_data_length++] = message[i];
+    }
+
+    // Hash whole blocks straight out of the message, without staging them
+    // through the data buffer a byte at a time.
+    while (length >= BlockSize) {
+        transform(message);
+        m_bit_length += 1024;
+        message += BlockSize;
+        length -= BlockSize;
+    }
+
+    if (length) {
+        __builtin_memcpy(m_data_buffer, message, length);
+        m_data_length = length;
     }
 }
 
@@ -72,26 +72,179 @@ static auto ModularInverse(const UnsignedBigInteger& a_, const UnsignedBigIntege
     return x.divided_by(b).remainder;
 }
 
+// Computes x^-1 mod 2^32 for odd x.
+static u32 MontgomeryInverse(u32 word)
+{
+    // Any odd x is its own inverse mod 8, and each Newton-Raphson round
+    // doubles the number of correct bits.
+    u32 inverse = word;
+    for (auto i = 0; i < 4; ++i)
+        inverse *= 2 - word * inverse;
+    return inverse;
+}
+
+// One CIOS (coarsely integrated operand scanning) Montgomery multiplication:
+// result <- a * b / R mod m, where R = 2^(32*k) and m_inverse = -m^-1 mod 2^32.
+// `t' is k + 2 words of scratch; `result' may alias `a' or `b'.
+static void MontgomeryMultiply(const u32* a, const u32* b, const u32* m, u32 m_inverse, size_t k, u32* t, u32* result)
+{
+    __builtin_memset(t, 0, (k + 2) * sizeof(u32));
+    for (size_t i = 0; i < k; ++i) {
+        u64 carry = 0;
+        for (size_t j = 0; j < k; ++j) {
+            u64 value = (u64)a[i] * b[j] + t[j] + carry;
+            t[j] = (u32)value;
+            carry = value >> 32;
+        }
+        u64 value = (u64)t[k] + carry;
+        t[k] = (u32)value;
+        t[k + 1] = (u32)(value >> 32);
+
+        u32 multiplier = t[0] * m_inverse;
+        carry = ((u64)multiplier * m[0] + t[0]) >> 32;
+        for (size_t j = 1; j < k; ++j) {
+            value = (u64)multiplier * m[j] + t[j] + carry;
+            t[j - 1] = (u32)value;
+            carry = value >> 32;
+        }
+        value = (u64)t[k] + carry;
+        t[k - 1] = (u32)value;
+        t[k] = t[k + 1] + (u32)(value >> 32);
+    }
+
+    // The intermediate value is < 2m, so at most one subtraction is needed.
+    bool needs_subtraction = true;
+    if (!t[k]) {
+        for (int i = (int)k - 1; i >= 0; --i) {
+            if (t[i] != m[i]) {
+                needs_subtraction = t[i] > m[i];
+                break;
+            }
+        }
+    }
+    if (needs_subtraction) {
+        u64 borrow = 0;
+        for (size_t i = 0; i < k; ++i) {
+            u64 value = (u64)t[i] - m[i] - borrow;
+            result[i] = (u32)value;
+            borrow = (value >> 32) & 1;
+        }
+    } else {
+        __builtin_memcpy(result, t, k * sizeof(u32));
+    }
+}
+
 static auto ModularPower(const UnsignedBigInteger& b, const UnsignedBigInteger& e, const UnsignedBigInteger& m) -> UnsignedBigInteger
 {
     if (m == 1)
         return 0;
 
-    UnsignedBigInteger ep { e };
-    UnsignedBigInteger base { b };
-    UnsignedBigInteger exp { 1 };
+    auto k = m.trimmed_length();
+    if (k == 0 || (m.words()[0] & 1) == 0) {
+        // Montgomery reduction needs an odd modulus; every caller of interest
+        // (RSA, Miller-Rabin) passes one, but keep plain square-and-multiply
+        // around for the rest.
+        UnsignedBigInteger ep { e };
+        UnsignedBigInteger base { b };
+        UnsignedBigInteger exp { 1 };
 
-    while (!(ep < 1)) {
+        while (!(ep < 1)) {
 #ifdef NT_DEBUG
-        dbg() << ep.to_base10();
+            dbg() << ep.to_base10();
 #endif
-        if (ep.words()[0] % 2 == 1) {
-            exp = exp.multiplied_by(base).divided_by(m).remainder;
+            if (ep.words()[0] % 2 == 1) {
+                exp = exp.multiplied_by(base).divided_by(m).remainder;
+            }
+            ep = ep.divided_by(2).quotient;
+            base = base.multiplied_by(base).divided_by(m).remainder;
         }
-        ep = ep.divided_by(2).quotient;
-        base = base.multiplied_by(base).divided_by(m).remainder;
+        return exp;
     }
-    return exp;
+
+    // Montgomery-form exponentiation with fixed 4-bit windows. Everything
+    // operates on raw k-word arrays; these vectors up front are the only
+    // allocations the whole exponentiation makes.
+    const u32* modulus = m.words().data();
+    u32 modulus_inverse = ~MontgomeryInverse(modulus[0]) + 1;
+
+    Vector<u32> scratch;
+    scratch.resize(k + 2);
+
+    // R^2 mod m (R = 2^(32k)) by modular doubling; only needs shift and subtract.
+    Vector<u32> rr;
+    rr.resize(k);
+    __builtin_memset(rr.data(), 0, k * sizeof(u32));
+    rr[0] = 1;
+    for (size_t bit = 0; bit < 2 * 32 * k; ++bit) {
+        u32 carry = 0;
+        for (size_t i = 0; i < k; ++i) {
+            u32 word = rr[i];
+            rr[i] = (word << 1) | carry;
+            carry = word >> 31;
+        }
+        bool needs_subtraction = carry;
+        if (!needs_subtraction) {
+            for (int i = (int)k - 1; i >= 0; --i) {
+                if (rr[i] != modulus[i]) {
+                    needs_subtraction = rr[i] > modulus[i];
+                    break;
+                }
+                if (i == 0)
+                    needs_subtraction = true;
+            }
+        }
+        if (needs_subtraction) {
+            u64 borrow = 0;
+            for (size_t i = 0; i < k; ++i) {
+                u64 value = (u64)rr[i] - modulus[i] - borrow;
+                rr[i] = (u32)value;
+                borrow = (value >> 32) & 1;
+            }
+        }
+    }
+
+    // The base reduced mod m, zero-padded out to k words.
+    auto base_mod = b.divided_by(m).remainder;
+    Vector<u32> base_words;
+    base_words.resize(k);
+    __builtin_memset(base_words.data(), 0, k * sizeof(u32));
+    for (size_t i = 0; i < base_mod.trimmed_length(); ++i)
+        base_words[i] = base_mod.words()[i];
+
+    Vector<u32> one;
+    one.resize(k);
+    __builtin_memset(one.data(), 0, k * sizeof(u32));
+    one[0] = 1;
+
+    // table[w] = base^w in Montgomery form; table[0] is the Montgomery "1".
+    Vector<u32> table;
+    table.resize(16 * k);
+    MontgomeryMultiply(one.data(), rr.data(), modulus, modulus_inverse, k, scratch.data(), &table[0]);
+    MontgomeryMultiply(base_words.data(), rr.data(), modulus, modulus_inverse, k, scratch.data(), &table[k]);
+    for (size_t w = 2; w < 16; ++w)
+        MontgomeryMultiply(&table[(w - 1) * k], &table[k], modulus, modulus_inverse, k, scratch.data(), &table[w * k]);
+
+    Vector<u32> accumulator;
+    accumulator.resize(k);
+    __builtin_memcpy(accumulator.data(), &table[0], k * sizeof(u32));
+
+    auto exponent_length = e.trimmed_length();
+    for (int window_index = 8 * (int)exponent_length - 1; window_index >= 0; --window_index) {
+        for (auto i = 0; i < 4; ++i)
+            MontgomeryMultiply(accumulator.data(), accumulator.data(), modulus, modulus_inverse, k, scratch.data(), accumulator.data());
+        u32 window = (e.words()[window_index / 8] >> ((window_index % 8) * 4)) & 0xf;
+        if (window)
+            MontgomeryMultiply(accumulator.data(), &table[window * k], modulus, modulus_inverse, k, scratch.data(), accumulator.data());
+    }
+
+    // Convert back out of Montgomery form.
+    MontgomeryMultiply(accumulator.data(), one.data(), modulus, modulus_inverse, k, scratch.data(), accumulator.data());
+
+    AK::Vector<u32, STARTING_WORD_SIZE> result_words;
+    result_words.ensure_capacity(k);
+    for (size_t i = 0; i < k; ++i)
+        result_words.unchecked_append(accumulator[i]);
+    return UnsignedBigInteger { move(result_words) };
 }
 
 static auto GCD(const UnsignedBigInteger& a, const UnsignedBigInteger& b) -> UnsignedBigInteger
@@ -30,7 +30,14 @@
 DebugInfo::DebugInfo(NonnullRefPtr<const ELF::Loader> elf)
     : m_elf(elf)
 {
-    prepare_lines();
+}
+
+void DebugInfo::ensure_lines() const
+{
+    if (m_prepared_lines)
+        return;
+    m_prepared_lines = true;
+    const_cast<DebugInfo&>(*this).prepare_lines();
 }
 
 void DebugInfo::prepare_lines()
@@ -65,23 +72,33 @@ void DebugInfo::prepare_lines()
 
 Optional<DebugInfo::SourcePosition> DebugInfo::get_source_position(u32 target_address) const
 {
+    ensure_lines();
 
     if (m_sorted_lines.is_empty())
         return {};
     if (target_address < m_sorted_lines[0].address)
         return {};
 
-    // TODO: We can do a binray search here
-    for (size_t i = 0; i < m_sorted_lines.size() - 1; ++i) {
-        if (m_sorted_lines[i + 1].address > target_address) {
-            return Optional<SourcePosition>({ m_sorted_lines[i].file, m_sorted_lines[i].line, m_sorted_lines[i].address });
-        }
+    // Binary search for the last entry whose address is <= target_address.
+    size_t low = 0;
+    size_t high = m_sorted_lines.size() - 1;
+    while (low < high) {
+        size_t mid = low + (high - low + 1) / 2;
+        if (m_sorted_lines[mid].address <= target_address)
+            low = mid;
+        else
+            high = mid - 1;
     }
-    return {};
+    if (low == m_sorted_lines.size() - 1)
+        return {};
+    while (low > 0 && m_sorted_lines[low - 1].address == m_sorted_lines[low].address)
+        --low;
+    return Optional<SourcePosition>({ m_sorted_lines[low].file, m_sorted_lines[low].line, m_sorted_lines[low].address });
 }
 
 Optional<u32> DebugInfo::get_instruction_from_source(const String& file, size_t line) const
 {
+    ensure_lines();
     for (const auto& line_entry : m_sorted_lines) {
         if (line_entry.file == file && line_entry.line == line)
             return Optional<u32>(line_entry.address);
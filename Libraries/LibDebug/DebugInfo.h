@@ -51,6 +51,7 @@ public:
     template<typename Callback>
     void for_each_source_position(Callback callback) const
     {
+        ensure_lines();
         String previous_file = "";
         size_t previous_line = 0;
         for (const auto& line_info : m_sorted_lines) {
@@ -63,9 +64,13 @@ public:
     }
 
 private:
+    // The line table is parsed lazily on the first query, so merely holding
+    // a DebugInfo (e.g. in DebugInfoCache) costs nothing.
+    void ensure_lines() const;
     void prepare_lines();
 
     NonnullRefPtr<const ELF::Loader> m_elf;
 
+    mutable bool m_prepared_lines { false };
     Vector<LineProgram::LineInfo> m_sorted_lines;
 };
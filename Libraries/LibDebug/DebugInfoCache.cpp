@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DebugInfoCache.h"
+
+DebugInfo* DebugInfoCache::get(const String& path)
+{
+    auto it = m_images.find(path);
+    if (it != m_images.end()) {
+        it->value->last_used = ++m_generation;
+        return &*it->value->debug_info;
+    }
+
+    MappedFile file(path);
+    if (!file.is_valid())
+        return nullptr;
+    auto loader = ELF::Loader::create(static_cast<const u8*>(file.data()), file.size());
+    if (!loader->image().is_valid())
+        return nullptr;
+
+    if (m_images.size() >= m_capacity)
+        evict_least_recently_used();
+
+    auto image = make<CachedImage>(CachedImage { move(file), loader, make<DebugInfo>(loader), ++m_generation });
+    auto* debug_info = &*image->debug_info;
+    m_images.set(path, move(image));
+    return debug_info;
+}
+
+void DebugInfoCache::evict_least_recently_used()
+{
+    if (m_images.is_empty())
+        return;
+    auto* oldest = &*m_images.begin();
+    for (auto& it : m_images) {
+        if (it.value->last_used < oldest->value->last_used)
+            oldest = &it;
+    }
+    m_images.remove(oldest->key);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/MappedFile.h>
+#include <AK/NonnullOwnPtr.h>
+#include <Libraries/LibDebug/DebugInfo.h>
+
+// Keeps the mapped image, ELF loader and parsed DebugInfo for the last few
+// queried images alive, so symbolicating many addresses across the same
+// handful of libraries parses each image's debug sections at most once.
+// Least-recently-used images are dropped once the cache is full.
+class DebugInfoCache {
+public:
+    explicit DebugInfoCache(size_t capacity = 8)
+        : m_capacity(capacity)
+    {
+    }
+
+    // Returns the cached debug info for the image at `path`, mapping and
+    // parsing it on first use. Returns nullptr if the file can't be mapped
+    // or isn't a valid ELF image.
+    DebugInfo* get(const String& path);
+
+    void clear() { m_images.clear(); }
+
+private:
+    struct CachedImage {
+        MappedFile file;
+        NonnullRefPtr<const ELF::Loader> loader;
+        NonnullOwnPtr<DebugInfo> debug_info;
+        u64 last_used { 0 };
+    };
+
+    void evict_least_recently_used();
+
+    size_t m_capacity { 8 };
+    u64 m_generation { 0 };
+    HashMap<String, NonnullOwnPtr<CachedImage>> m_images;
+};
@@ -117,7 +117,12 @@ bool DynamicLoader::load_from_image(unsigned flags)
     munmap(m_file_mapping, m_file_size);
     m_file_mapping = MAP_FAILED;
 
-    m_dynamic_object = AK::make<DynamicObject>(m_text_segment_load_address, m_dynamic_section_address);
+    // The DynamicObject's "base address" is really the load bias: the delta
+    // between link-time and load-time addresses. For a library linked at
+    // zero that's the same as the mapping address; for a prebound library
+    // mapped at its preferred address it's zero, and every link-time address
+    // is already correct.
+    m_dynamic_object = AK::make<DynamicObject>(VirtualAddress { m_load_bias }, m_dynamic_section_address);
 
     return load_stage_2(flags);
 }
@@ -127,7 +132,9 @@ bool DynamicLoader::load_stage_2(unsigned flags)
     ASSERT(flags & RTLD_GLOBAL);
     ASSERT(flags & RTLD_LAZY);
 
-#ifdef DYNAMIC_LOAD_DEBUG
+#ifdef DYNAMIC_LOAD_VERBOSE
+    // Formatting the whole dynamic section is expensive enough to show up in
+    // application cold-start, so it's verbose-only.
     m_dynamic_object->dump();
 #endif
 
@@ -189,21 +196,34 @@ void DynamicLoader::load_program_headers(const Image& elf_image)
 
     // Process regions in order: .text, .data, .tls
     auto* region = text_region_ptr;
-    void* text_segment_begin = mmap_with_name(nullptr, region->required_load_size(), region->mmap_prot(), MAP_PRIVATE, m_image_fd, region->offset(), String::format(".text: %s", m_filename.characters()).characters());
+    String text_mmap_name = String::format(".text: %s", m_filename.characters());
+    // A prebound library links its segments at a preferred address, so first
+    // ask for exactly that; if we get it, the load bias is zero and the
+    // relative relocation pass below becomes a no-op, leaving those pages
+    // clean. Plain -fPIC libraries link at zero and take the old path.
+    void* preferred_load_address = region->desired_load_address().as_ptr();
+    void* text_segment_begin = MAP_FAILED;
+    if (preferred_load_address)
+        text_segment_begin = mmap_with_name(preferred_load_address, region->required_load_size(), region->mmap_prot(), MAP_PRIVATE, m_image_fd, region->offset(), text_mmap_name.characters());
+    if (MAP_FAILED == text_segment_begin)
+        text_segment_begin = mmap_with_name(nullptr, region->required_load_size(), region->mmap_prot(), MAP_PRIVATE, m_image_fd, region->offset(), text_mmap_name.characters());
     if (MAP_FAILED == text_segment_begin) {
         ASSERT_NOT_REACHED();
     }
     m_text_segment_size = region->required_load_size();
     m_text_segment_load_address = VirtualAddress { (u32)text_segment_begin };
+    m_load_bias = m_text_segment_load_address.get() - region->desired_load_address().get();
 
-    m_dynamic_section_address = dynamic_region_desired_vaddr.offset(m_text_segment_load_address.get());
+    m_dynamic_section_address = dynamic_region_desired_vaddr.offset(m_load_bias);
 
     region = data_region_ptr;
-    void* data_segment_begin = mmap_with_name((u8*)text_segment_begin + m_text_segment_size, region->required_load_size(), region->mmap_prot(), MAP_ANONYMOUS | MAP_PRIVATE, 0, 0, String::format(".data: %s", m_filename.characters()).characters());
+    // Place the data segment where the link laid it out, relative to where
+    // the text segment actually ended up.
+    void* data_segment_begin = mmap_with_name(region->desired_load_address().offset(m_load_bias).as_ptr(), region->required_load_size(), region->mmap_prot(), MAP_ANONYMOUS | MAP_PRIVATE, 0, 0, String::format(".data: %s", m_filename.characters()).characters());
     if (MAP_FAILED == data_segment_begin) {
         ASSERT_NOT_REACHED();
     }
-    VirtualAddress data_segment_actual_addr = region->desired_load_address().offset((u32)text_segment_begin);
+    VirtualAddress data_segment_actual_addr = region->desired_load_address().offset(m_load_bias);
     memcpy(data_segment_actual_addr.as_ptr(), (u8*)m_file_mapping + region->offset(), region->size_in_image());
 
     // FIXME: Do some kind of 'allocate TLS section' or some such from a per-application pool
@@ -211,7 +231,7 @@ void DynamicLoader::load_program_headers(const Image& elf_image)
         region = tls_region_ptr;
         // FIXME: This can't be right either. TLS needs some real work i'd say :)
         m_tls_segment_address = tls_region_ptr->desired_load_address();
-        VirtualAddress tls_segment_actual_addr = region->desired_load_address().offset((u32)text_segment_begin);
+        VirtualAddress tls_segment_actual_addr = region->desired_load_address().offset(m_load_bias);
         memcpy(tls_segment_actual_addr.as_ptr(), (u8*)m_file_mapping + region->offset(), region->size_in_image());
     }
 }
@@ -224,7 +244,30 @@ void DynamicLoader::do_relocations()
 
     auto main_relocation_section = m_dynamic_object->relocation_section();
 
+    // R_386_RELATIVE relocations come first (that's what DT_RELCOUNT means)
+    // and only need the load base added, so blast through them in a tight
+    // loop instead of going through the type dispatch below. For libraries
+    // like LibGUI/LibGfx nearly every relocation is a relative one, and this
+    // is most of what application cold-start spends in the loader.
+    size_t relative_count = m_dynamic_object->number_of_relative_relocations();
+    if (relative_count > main_relocation_section.entry_count())
+        relative_count = main_relocation_section.entry_count();
+    // With a load bias of zero (a prebound library mapped at its preferred
+    // address) the relative relocations are no-ops; skipping the writes (but
+    // still skipping past the entries below) keeps those pages clean instead
+    // of faulting in a private copy of each one.
+    if (load_base_address != 0) {
+        auto* relative_entry = (const Elf32_Rel*)main_relocation_section.address().as_ptr();
+        for (size_t i = 0; i < relative_count; ++i, ++relative_entry) {
+            ASSERT(ELF32_R_TYPE(relative_entry->r_info) == R_386_RELATIVE);
+            *(u32*)(load_base_address + relative_entry->r_offset) += load_base_address;
+        }
+    }
+    size_t first_non_relative_offset = relative_count * main_relocation_section.entry_size();
+
     main_relocation_section.for_each_relocation([&](const DynamicObject::Relocation& relocation) {
+        if (relocation.offset_in_section() < first_non_relative_offset)
+            return IterationDecision::Continue;
         VERBOSE("====== RELOCATION %d: offset 0x%08X, type %d, symidx %08X\n", relocation.offset_in_section() / main_relocation_section.entry_size(), relocation.offset(), relocation.type(), relocation.symbol_index());
         u32* patch_ptr = (u32*)(load_base_address + relocation.offset());
         switch (relocation.type()) {
@@ -117,6 +117,10 @@ private:
     VirtualAddress m_text_segment_load_address;
     size_t m_text_segment_size;
 
+    // Delta between link-time and load-time addresses. Zero for a prebound
+    // library mapped at its preferred address.
+    u32 m_load_bias { 0 };
+
     VirtualAddress m_tls_segment_address;
     VirtualAddress m_dynamic_section_address;
 };
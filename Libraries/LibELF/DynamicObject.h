@@ -210,6 +210,10 @@ public:
     bool must_bind_now() const { return m_dt_flags & DF_BIND_NOW; }
     bool has_static_thread_local_storage() const { return m_dt_flags & DF_STATIC_TLS; }
 
+    // From DT_RELCOUNT: how many R_386_RELATIVE relocations sit at the front
+    // of the relocation table.
+    size_t number_of_relative_relocations() const { return m_number_of_relocations; }
+
     VirtualAddress plt_got_base_address() const { return m_base_address.offset(m_procedure_linkage_table_offset); }
     VirtualAddress base_address() const { return m_base_address; }
 
@@ -91,32 +91,31 @@ bool Loader::layout()
 #endif
 #ifdef KERNEL
         if (program_header.is_writable()) {
-            auto* allocated_section = alloc_section_hook(
+            if (!m_image.is_within_image(program_header.raw_data(), program_header.size_in_image())) {
+                dbg() << "Shenanigans! Writable ELF PT_LOAD header sneaks outside of executable.";
+                failed = true;
+                return;
+            }
+            // Writable segments are mapped copy-on-write straight from the
+            // executable instead of being copied into fresh pages up front.
+            // The hook takes care of zero-filling whatever lies beyond the
+            // file-backed part (the bss).
+            // FIXME: There's an opportunity to munmap, or at least mprotect, the padding space between
+            //     the .text and .data PT_LOAD sections of the executable.
+            //     Accessing it would definitely be a bug.
+            auto* mapped_section = map_writable_section_hook(
                 program_header.vaddr(),
                 program_header.size_in_memory(),
                 program_header.alignment(),
+                program_header.offset(),
+                program_header.size_in_image(),
                 program_header.is_readable(),
                 program_header.is_writable(),
                 String::format("elf-alloc-%s%s", program_header.is_readable() ? "r" : "", program_header.is_writable() ? "w" : ""));
-            if (!allocated_section) {
-                failed = true;
-                return;
-            }
-            if (!m_image.is_within_image(program_header.raw_data(), program_header.size_in_image())) {
-                dbg() << "Shenanigans! Writable ELF PT_LOAD header sneaks outside of executable.";
+            if (!mapped_section) {
                 failed = true;
                 return;
             }
-            // It's not always the case with PIE executables (and very well shouldn't be) that the
-            // virtual address in the program header matches the one we end up giving the process.
-            // In order to copy the data image correctly into memory, we need to copy the data starting at
-            // the right initial page offset into the pages allocated for the elf_alloc-XX section.
-            // FIXME: There's an opportunity to munmap, or at least mprotect, the padding space between
-            //     the .text and .data PT_LOAD sections of the executable.
-            //     Accessing it would definitely be a bug.
-            auto page_offset = program_header.vaddr();
-            page_offset.mask(~PAGE_MASK);
-            do_memcpy((u8*)allocated_section + page_offset.get(), program_header.raw_data(), program_header.size_in_image());
         } else {
             auto* mapped_section = map_section_hook(
                 program_header.vaddr(),
@@ -172,17 +171,12 @@ Optional<Image::Symbol> Loader::find_demangled_function(const String& name) cons
     return found;
 }
 
-#ifndef KERNEL
-Optional<Image::Symbol> Loader::find_symbol(u32 address, u32* out_offset) const
+Loader::SortedSymbol* Loader::sorted_symbols() const
 {
-    if (!m_symbol_count)
-        return {};
-
-    SortedSymbol* sorted_symbols = nullptr;
-#    ifdef KERNEL
+#ifdef KERNEL
     if (!m_sorted_symbols_region) {
         m_sorted_symbols_region = MM.allocate_kernel_region(PAGE_ROUND_UP(m_symbol_count * sizeof(SortedSymbol)), "Sorted symbols", Kernel::Region::Access::Read | Kernel::Region::Access::Write);
-        sorted_symbols = (SortedSymbol*)m_sorted_symbols_region->vaddr().as_ptr();
+        auto* sorted_symbols = (SortedSymbol*)m_sorted_symbols_region->vaddr().as_ptr();
         size_t index = 0;
         m_image.for_each_symbol([&](auto& symbol) {
             sorted_symbols[index++] = { symbol.value(), symbol.name() };
@@ -191,10 +185,9 @@ Optional<Image::Symbol> Loader::find_symbol(u32 address, u32* out_offset) const
         quick_sort(sorted_symbols, sorted_symbols + m_symbol_count, [](auto& a, auto& b) {
             return a.address < b.address;
         });
-    } else {
-        sorted_symbols = (SortedSymbol*)m_sorted_symbols_region->vaddr().as_ptr();
     }
-#    else
+    return (SortedSymbol*)m_sorted_symbols_region->vaddr().as_ptr();
+#else
     if (m_sorted_symbols.is_empty()) {
         m_sorted_symbols.ensure_capacity(m_symbol_count);
         m_image.for_each_symbol([this](auto& symbol) {
@@ -205,20 +198,40 @@ Optional<Image::Symbol> Loader::find_symbol(u32 address, u32* out_offset) const
             return a.address < b.address;
         });
     }
-    sorted_symbols = m_sorted_symbols.data();
-#    endif
+    return m_sorted_symbols.data();
+#endif
+}
 
-    for (size_t i = 0; i < m_symbol_count; ++i) {
-        if (sorted_symbols[i].address > address) {
-            if (i == 0)
-                return {};
-            auto& symbol = sorted_symbols[i - 1];
-            if (out_offset)
-                *out_offset = address - symbol.address;
-            return symbol.symbol;
-        }
+// Index of the first symbol whose address is greater than the given one,
+// or m_symbol_count if there is none.
+size_t Loader::first_symbol_index_after_address(u32 address) const
+{
+    auto* symbols = sorted_symbols();
+    size_t low = 0;
+    size_t high = m_symbol_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (symbols[middle].address <= address)
+            low = middle + 1;
+        else
+            high = middle;
     }
-    return {};
+    return low;
+}
+
+#ifndef KERNEL
+Optional<Image::Symbol> Loader::find_symbol(u32 address, u32* out_offset) const
+{
+    if (!m_symbol_count)
+        return {};
+
+    size_t after = first_symbol_index_after_address(address);
+    if (after == 0 || after == m_symbol_count)
+        return {};
+    auto& symbol = sorted_symbols()[after - 1];
+    if (out_offset)
+        *out_offset = address - symbol.address;
+    return symbol.symbol;
 }
 #endif
 
@@ -229,63 +242,33 @@ String Loader::symbolicate(u32 address, u32* out_offset) const
             *out_offset = 0;
         return "??";
     }
-    SortedSymbol* sorted_symbols = nullptr;
-#ifdef KERNEL
-    if (!m_sorted_symbols_region) {
-        m_sorted_symbols_region = MM.allocate_kernel_region(PAGE_ROUND_UP(m_symbol_count * sizeof(SortedSymbol)), "Sorted symbols", Kernel::Region::Access::Read | Kernel::Region::Access::Write);
-        sorted_symbols = (SortedSymbol*)m_sorted_symbols_region->vaddr().as_ptr();
-        size_t index = 0;
-        m_image.for_each_symbol([&](auto& symbol) {
-            sorted_symbols[index++] = { symbol.value(), symbol.name() };
-            return IterationDecision::Continue;
-        });
-        quick_sort(sorted_symbols, sorted_symbols + m_symbol_count, [](auto& a, auto& b) {
-            return a.address < b.address;
-        });
-    } else {
-        sorted_symbols = (SortedSymbol*)m_sorted_symbols_region->vaddr().as_ptr();
+
+    size_t after = first_symbol_index_after_address(address);
+    if (after == m_symbol_count) {
+        if (out_offset)
+            *out_offset = 0;
+        return "??";
     }
-#else
-    if (m_sorted_symbols.is_empty()) {
-        m_sorted_symbols.ensure_capacity(m_symbol_count);
-        m_image.for_each_symbol([this](auto& symbol) {
-            m_sorted_symbols.append({ symbol.value(), symbol.name(), {}, {} });
-            return IterationDecision::Continue;
-        });
-        quick_sort(m_sorted_symbols, [](auto& a, auto& b) {
-            return a.address < b.address;
-        });
+    if (after == 0) {
+        if (out_offset)
+            *out_offset = 0;
+        return "!!";
     }
-    sorted_symbols = m_sorted_symbols.data();
-#endif
-
-    for (size_t i = 0; i < m_symbol_count; ++i) {
-        if (sorted_symbols[i].address > address) {
-            if (i == 0) {
-                if (out_offset)
-                    *out_offset = 0;
-                return "!!";
-            }
-            auto& symbol = sorted_symbols[i - 1];
+    auto& symbol = sorted_symbols()[after - 1];
 
 #ifdef KERNEL
-            auto demangled_name = demangle(symbol.name);
+    auto demangled_name = demangle(symbol.name);
 #else
-            auto& demangled_name = symbol.demangled_name;
-            if (demangled_name.is_null())
-                demangled_name = demangle(symbol.name);
+    auto& demangled_name = symbol.demangled_name;
+    if (demangled_name.is_null())
+        demangled_name = demangle(symbol.name);
 #endif
 
-            if (out_offset) {
-                *out_offset = address - symbol.address;
-                return demangled_name;
-            }
-            return String::format("%s +%u", demangled_name.characters(), address - symbol.address);
-        }
+    if (out_offset) {
+        *out_offset = address - symbol.address;
+        return demangled_name;
     }
-    if (out_offset)
-        *out_offset = 0;
-    return "??";
+    return String::format("%s +%u", demangled_name.characters(), address - symbol.address);
 }
 
 } // end namespace ELF
@@ -50,9 +50,9 @@ public:
 
     bool load();
 #if defined(KERNEL)
-    Function<void*(VirtualAddress, size_t, size_t, bool, bool, const String&)> alloc_section_hook;
     Function<void*(size_t, size_t)> tls_section_hook;
     Function<void*(VirtualAddress, size_t, size_t, size_t, bool r, bool w, bool x, const String&)> map_section_hook;
+    Function<void*(VirtualAddress, size_t, size_t, size_t, size_t, bool r, bool w, const String&)> map_writable_section_hook;
 #endif
     VirtualAddress entry() const
     {
@@ -99,6 +99,10 @@ private:
         Optional<Image::Symbol> symbol;
 #endif
     };
+
+    // Built on first use, then reused by every lookup.
+    SortedSymbol* sorted_symbols() const;
+    size_t first_symbol_index_after_address(u32 address) const;
 #ifdef KERNEL
     mutable OwnPtr<Kernel::Region> m_sorted_symbols_region;
 #else
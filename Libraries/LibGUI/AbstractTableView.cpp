@@ -70,6 +70,17 @@ void AbstractTableView::update_column_sizes()
     int row_count = model.row_count();
     int key_column = model.key_column();
 
+    // Only measure rows around the visible window. With tens of thousands of
+    // rows, measuring every cell on every model update dwarfs the painting.
+    // Column widths only ever grow, so rows revealed later can only widen a
+    // column, never invalidate it; did_scroll() re-measures newly exposed
+    // rows, and the already-measured range is skipped below.
+    static const int measurement_margin_rows = 100;
+    int first_visible_row = visible_content_rect().top() / item_height();
+    int last_visible_row = first_visible_row + visible_content_rect().height() / item_height() + 1;
+    int first_row = max(0, first_visible_row - measurement_margin_rows);
+    int last_row = min(row_count - 1, last_visible_row + measurement_margin_rows);
+
     for (int column = 0; column < column_count; ++column) {
         if (is_column_hidden(column))
             continue;
@@ -77,7 +88,9 @@ void AbstractTableView::update_column_sizes()
         if (column == key_column)
             header_width += font().width(" \xc3\xb6");
         int column_width = header_width;
-        for (int row = 0; row < row_count; ++row) {
+        for (int row = first_row; row <= last_row; ++row) {
+            if (row >= m_first_measured_row && row <= m_last_measured_row)
+                continue;
             auto cell_data = model.data(model.index(row, column));
             int cell_width = 0;
             if (cell_data.is_bitmap()) {
@@ -91,6 +104,26 @@ void AbstractTableView::update_column_sizes()
         column_data.width = max(column_data.width, column_width);
         column_data.has_initialized_width = true;
     }
+
+    if (m_first_measured_row == -1 || first_row > m_last_measured_row + 1 || last_row < m_first_measured_row - 1) {
+        // Disjoint from what we measured before; forgetting the old range
+        // only means we might measure those rows again someday.
+        m_first_measured_row = first_row;
+        m_last_measured_row = last_row;
+    } else {
+        m_first_measured_row = min(m_first_measured_row, first_row);
+        m_last_measured_row = max(m_last_measured_row, last_row);
+    }
+}
+
+void AbstractTableView::did_scroll()
+{
+    AbstractView::did_scroll();
+    // Newly revealed rows may need a column to grow. Only relevant when the
+    // windowed measurement above has run; in particular TreeView has its own
+    // update_column_sizes() and doesn't want it re-run on every scroll.
+    if (m_first_measured_row != -1)
+        update_column_sizes();
 }
 
 void AbstractTableView::update_content_size()
@@ -401,17 +434,21 @@ ModelIndex AbstractTableView::index_at_event_position(const Gfx::Point& position
         return {};
 
     auto adjusted_position = this->adjusted_position(position);
-    for (int row = 0, row_count = model()->row_count(); row < row_count; ++row) {
-        if (!row_rect(row).contains(adjusted_position))
+    // All rows have the same height, so jump straight to the right one
+    // instead of scanning the whole model.
+    if (adjusted_position.y() < header_height())
+        return {};
+    int row = (adjusted_position.y() - header_height()) / item_height();
+    if (row >= model()->row_count())
+        return {};
+    if (!row_rect(row).contains(adjusted_position))
+        return {};
+    for (int column = 0, column_count = model()->column_count(); column < column_count; ++column) {
+        if (!content_rect(row, column).contains(adjusted_position))
             continue;
-        for (int column = 0, column_count = model()->column_count(); column < column_count; ++column) {
-            if (!content_rect(row, column).contains(adjusted_position))
-                continue;
-            return model()->index(row, column);
-        }
-        return model()->index(row, 0);
+        return model()->index(row, column);
     }
-    return {};
+    return model()->index(row, 0);
 }
 
 ModelIndex AbstractTableView::index_at_event_position(const Gfx::Point& position) const
@@ -570,6 +607,9 @@ Gfx::Point AbstractTableView::adjusted_position(const Gfx::Point& position) cons
 void AbstractTableView::did_update_model(unsigned flags)
 {
     AbstractView::did_update_model(flags);
+    // All cell measurements are stale now.
+    m_first_measured_row = -1;
+    m_last_measured_row = -1;
     update_column_sizes();
     update_content_size();
     update();
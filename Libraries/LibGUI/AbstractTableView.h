@@ -111,6 +111,7 @@ protected:
     int column_width(int) const;
     void update_content_size();
     virtual void update_column_sizes();
+    virtual void did_scroll() override;
     virtual int item_count() const;
 
 private:
@@ -119,6 +120,10 @@ private:
     bool m_in_column_resize { false };
     bool m_alternating_row_colors { true };
     int m_horizontal_padding { 5 };
+    // The contiguous row range whose cells have been measured for column
+    // sizing since the last model update.
+    int m_first_measured_row { -1 };
+    int m_last_measured_row { -1 };
     Gfx::Point m_column_resize_origin;
     int m_column_resize_original_width { 0 };
     int m_resizing_column { -1 };
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018-2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibGUI/BitmapCache.h>
+#include <LibGUI/WindowServerConnection.h>
+#include <LibGfx/Bitmap.h>
+
+namespace GUI {
+
+BitmapCache& BitmapCache::the()
+{
+    static BitmapCache* s_the;
+    if (!s_the)
+        s_the = new BitmapCache;
+    return *s_the;
+}
+
+BitmapCache::BitmapCache()
+{
+}
+
+RefPtr<Gfx::Bitmap> BitmapCache::load(const String& path)
+{
+    auto it = m_bitmaps.find(path);
+    if (it != m_bitmaps.end())
+        return it->value;
+
+    auto response = WindowServerConnection::the().send_sync<Messages::WindowServer::GetSharedBitmap>(path);
+    RefPtr<Gfx::Bitmap> bitmap = response->bitmap().bitmap();
+    if (!bitmap) {
+        // The server only serves /res/ assets; decode anything else ourselves.
+        bitmap = Gfx::Bitmap::load_from_file(path);
+        if (!bitmap)
+            return nullptr;
+    }
+
+    m_bitmaps.set(path, bitmap);
+    return bitmap;
+}
+
+}
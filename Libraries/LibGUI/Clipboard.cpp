@@ -25,7 +25,6 @@
  */
 
 #include <AK/Badge.h>
-#include <AK/SharedBuffer.h>
 #include <LibGUI/Clipboard.h>
 #include <LibGUI/WindowServerConnection.h>
 
@@ -46,37 +45,24 @@ Clipboard::Clipboard()
 Clipboard::DataAndType Clipboard::data_and_type() const
 {
     auto response = WindowServerConnection::the().send_sync<Messages::WindowServer::GetClipboardContents>();
-    if (response->shbuf_id() < 0)
+    auto& contents = response->contents();
+    if (!contents.is_valid())
         return {};
-    auto shared_buffer = SharedBuffer::create_from_shbuf_id(response->shbuf_id());
-    if (!shared_buffer) {
-        dbgprintf("GUI::Clipboard::data() failed to attach to the shared buffer\n");
-        return {};
-    }
-    if (response->content_size() > shared_buffer->size()) {
-        dbgprintf("GUI::Clipboard::data() clipping contents size is greater than shared buffer size\n");
-        return {};
-    }
-    auto data = String((const char*)shared_buffer->data(), response->content_size());
+    auto data = String((const char*)contents.data(), contents.size());
     auto type = response->content_type();
     return { data, type };
 }
 
 void Clipboard::set_data(const StringView& data, const String& type)
 {
-    auto shared_buffer = SharedBuffer::create_with_size(data.length() + 1);
-    if (!shared_buffer) {
+    auto contents = IPC::SharedByteBuffer::create_with_data(data.characters_without_null_termination(), data.length());
+    if (!contents.is_valid()) {
         dbgprintf("GUI::Clipboard::set_data() failed to create a shared buffer\n");
         return;
     }
-    if (!data.is_empty())
-        memcpy(shared_buffer->data(), data.characters_without_null_termination(), data.length() + 1);
-    else
-        ((u8*)shared_buffer->data())[0] = '\0';
-    shared_buffer->seal();
-    shared_buffer->share_with(WindowServerConnection::the().server_pid());
+    contents.share_with(WindowServerConnection::the().server_pid());
 
-    WindowServerConnection::the().send_sync<Messages::WindowServer::SetClipboardContents>(shared_buffer->shbuf_id(), data.length(), type);
+    WindowServerConnection::the().send_sync<Messages::WindowServer::SetClipboardContents>(contents, type);
 }
 
 void Clipboard::did_receive_clipboard_contents_changed(Badge<WindowServerConnection>, const String& data_type)
@@ -31,8 +31,9 @@
 
 namespace GUI {
 
-CppLexer::CppLexer(const StringView& input)
+CppLexer::CppLexer(const StringView& input, State initial_state)
     : m_input(input)
+    , m_state(initial_state)
 {
 }
 
@@ -298,6 +299,72 @@ Vector<CppToken> CppLexer::lex()
         }
     };
 
+    // Consumes the rest of a quoted string, starting just past the opening
+    // quote (or at the start of the input, when resuming an unterminated
+    // string from a previous line).
+    auto consume_string_tail = [&](char closing, CppToken::Type type, State unterminated_state) {
+        bool terminated = false;
+        while (peek()) {
+            if (peek() == '\\') {
+                size_t escape = match_escape_sequence();
+                if (escape > 0) {
+                    commit_token(type);
+                    begin_token();
+                    for (size_t i = 0; i < escape; ++i)
+                        consume();
+                    commit_token(CppToken::Type::EscapeSequence);
+                    begin_token();
+                    continue;
+                }
+            }
+
+            if (consume() == closing) {
+                terminated = true;
+                break;
+            }
+        }
+        if (!terminated)
+            m_state = unterminated_state;
+        commit_token(type);
+    };
+
+    // Consumes the rest of a block comment, starting just past the opening
+    // "/*" (or at the start of the input, when resuming.)
+    auto consume_block_comment_tail = [&] {
+        bool comment_block_ends = false;
+        while (peek()) {
+            if (peek() == '*' && peek(1) == '/') {
+                comment_block_ends = true;
+                break;
+            }
+
+            consume();
+        }
+
+        if (comment_block_ends) {
+            consume();
+            consume();
+        } else {
+            m_state = State::InBlockComment;
+        }
+
+        commit_token(CppToken::Type::Comment);
+    };
+
+    // If we were handed the middle of a multi-line construct, finish it
+    // before dropping into the regular token loop.
+    if (peek() && m_state != State::Free) {
+        auto resume_state = m_state;
+        m_state = State::Free;
+        begin_token();
+        if (resume_state == State::InBlockComment)
+            consume_block_comment_tail();
+        else if (resume_state == State::InDoubleQuotedString)
+            consume_string_tail('"', CppToken::Type::DoubleQuotedString, State::InDoubleQuotedString);
+        else
+            consume_string_tail('\'', CppToken::Type::SingleQuotedString, State::InSingleQuotedString);
+    }
+
     while (m_index < m_input.length()) {
         auto ch = peek();
         if (isspace(ch)) {
@@ -393,68 +460,19 @@ Vector<CppToken> CppLexer::lex()
             begin_token();
             consume();
             consume();
-            bool comment_block_ends = false;
-            while (peek()) {
-                if (peek() == '*' && peek(1) == '/') {
-                    comment_block_ends = true;
-                    break;
-                }
-
-                consume();
-            }
-
-            if (comment_block_ends) {
-                consume();
-                consume();
-            }
-
-            commit_token(CppToken::Type::Comment);
+            consume_block_comment_tail();
             continue;
         }
         if (ch == '"') {
             begin_token();
             consume();
-            while (peek()) {
-                if (peek() == '\\') {
-                    size_t escape = match_escape_sequence();
-                    if (escape > 0) {
-                        commit_token(CppToken::Type::DoubleQuotedString);
-                        begin_token();
-                        for (size_t i = 0; i < escape; ++i)
-                            consume();
-                        commit_token(CppToken::Type::EscapeSequence);
-                        begin_token();
-                        continue;
-                    }
-                }
-
-                if (consume() == '"')
-                    break;
-            }
-            commit_token(CppToken::Type::DoubleQuotedString);
+            consume_string_tail('"', CppToken::Type::DoubleQuotedString, State::InDoubleQuotedString);
             continue;
         }
         if (ch == '\'') {
             begin_token();
             consume();
-            while (peek()) {
-                if (peek() == '\\') {
-                    size_t escape = match_escape_sequence();
-                    if (escape > 0) {
-                        commit_token(CppToken::Type::SingleQuotedString);
-                        begin_token();
-                        for (size_t i = 0; i < escape; ++i)
-                            consume();
-                        commit_token(CppToken::Type::EscapeSequence);
-                        begin_token();
-                        continue;
-                    }
-                }
-
-                if (consume() == '\'')
-                    break;
-            }
-            commit_token(CppToken::Type::SingleQuotedString);
+            consume_string_tail('\'', CppToken::Type::SingleQuotedString, State::InSingleQuotedString);
             continue;
         }
         if (isdigit(ch) || (ch == '.' && isdigit(peek(1)))) {
@@ -87,10 +87,24 @@ struct CppToken {
 
 class CppLexer {
 public:
-    CppLexer(const StringView&);
+    // The lexer state at an input boundary. Only constructs that can span
+    // multiple lines need to be represented here; everything else is
+    // contained within a single line. This is what lets callers lex one
+    // line at a time: feed each line the previous line's end state.
+    enum class State {
+        Free,
+        InBlockComment,
+        InDoubleQuotedString,
+        InSingleQuotedString,
+    };
+
+    explicit CppLexer(const StringView&, State initial_state = State::Free);
 
     Vector<CppToken> lex();
 
+    // The state we ended up in after lex() consumed all input.
+    State state() const { return m_state; }
+
 private:
     char peek(size_t offset = 0) const;
     char consume();
@@ -99,6 +113,7 @@ private:
     size_t m_index { 0 };
     CppPosition m_previous_position { 0, 0 };
     CppPosition m_position { 0, 0 };
+    State m_state { State::Free };
 };
 
 }
@@ -76,26 +76,68 @@ bool CppSyntaxHighlighter::is_navigatable(void* token) const
 void CppSyntaxHighlighter::rehighlight(Gfx::Palette palette)
 {
     ASSERT(m_editor);
-    auto text = m_editor->text();
-    CppLexer lexer(text);
-    auto tokens = lexer.lex();
+    auto& document = m_editor->document();
+    size_t line_count = document.line_count();
 
+    auto line_is_unchanged = [&](size_t line_index) {
+        auto& cache = m_line_caches[line_index];
+        if (cache.text.is_null())
+            return false;
+        auto view = document.line(line_index).view();
+        return cache.text.length() == view.length()
+            && !memcmp(cache.text.characters(), view.characters_without_null_termination(), view.length());
+    };
+
+    // If lines were inserted or removed, shift the cache to match so that
+    // everything below the edit keeps lining up with its old cache entry.
+    // We only handle one contiguous run of inserted/removed lines here;
+    // anything fancier just falls out as cache misses below.
+    if (line_count != m_line_caches.size()) {
+        size_t first_mismatch = 0;
+        size_t common_line_count = min(line_count, m_line_caches.size());
+        while (first_mismatch < common_line_count && line_is_unchanged(first_mismatch))
+            ++first_mismatch;
+        while (m_line_caches.size() < line_count)
+            m_line_caches.insert(first_mismatch, LineCache());
+        while (m_line_caches.size() > line_count)
+            m_line_caches.remove(first_mismatch);
+    }
+
+    // Lex each line with the previous line's end state as its entry state.
+    // Lines whose text and entry state both match the cache are reused
+    // as-is, so a typical edit only re-lexes the affected lines (plus any
+    // following lines until the boundary states reconverge, e.g. after
+    // opening a block comment.)
     Vector<GUI::TextDocumentSpan> spans;
-    for (auto& token : tokens) {
+    auto state = CppLexer::State::Free;
+    for (size_t line_index = 0; line_index < line_count; ++line_index) {
+        auto& cache = m_line_caches[line_index];
+        if (cache.entry_state != state || !line_is_unchanged(line_index)) {
+            auto view = document.line(line_index).view();
+            CppLexer lexer(view, state);
+            cache.tokens = lexer.lex();
+            cache.text = view;
+            cache.entry_state = state;
+            cache.exit_state = lexer.state();
+        }
+        state = cache.exit_state;
+
+        for (auto& token : cache.tokens) {
 #ifdef DEBUG_SYNTAX_HIGHLIGHTING
-        dbg() << token.to_string() << " @ " << token.m_start.line << ":" << token.m_start.column << " - " << token.m_end.line << ":" << token.m_end.column;
+            dbg() << token.to_string() << " @ " << line_index << ":" << token.m_start.column << " - " << line_index << ":" << token.m_end.column;
 #endif
-        GUI::TextDocumentSpan span;
-        span.range.set_start({ token.m_start.line, token.m_start.column });
-        span.range.set_end({ token.m_end.line, token.m_end.column });
-        auto style = style_for_token_type(palette, token.m_type);
-        span.color = style.color;
-        span.font = style.font;
-        span.is_skippable = token.m_type == CppToken::Type::Whitespace;
-        span.data = reinterpret_cast<void*>(token.m_type);
-        spans.append(span);
+            GUI::TextDocumentSpan span;
+            span.range.set_start({ line_index, token.m_start.column });
+            span.range.set_end({ line_index, token.m_end.column });
+            auto style = style_for_token_type(palette, token.m_type);
+            span.color = style.color;
+            span.font = style.font;
+            span.is_skippable = token.m_type == CppToken::Type::Whitespace;
+            span.data = reinterpret_cast<void*>(token.m_type);
+            spans.append(span);
+        }
     }
-    m_editor->document().set_spans(spans);
+    document.set_spans(spans);
 
     m_has_brace_buddies = false;
     highlight_matching_token_pair();
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <LibGUI/CppLexer.h>
 #include <LibGUI/SyntaxHighlighter.h>
 
 namespace GUI {
@@ -44,6 +45,20 @@ public:
 protected:
     virtual Vector<MatchingTokenPair> matching_token_pairs() const override;
     virtual bool token_types_equal(void*, void*) const override;
+
+private:
+    // Cached lex result for one document line, so that editing only pays
+    // for re-lexing the lines it actually affected. A cache entry is valid
+    // for as long as the line's text and the lexer state entering the line
+    // are both unchanged; a null text means "never lexed".
+    struct LineCache {
+        String text;
+        CppLexer::State entry_state { CppLexer::State::Free };
+        CppLexer::State exit_state { CppLexer::State::Free };
+        Vector<CppToken> tokens;
+    };
+
+    Vector<LineCache> m_line_caches;
 };
 
 }
@@ -180,6 +180,36 @@ public:
     const Vector<Gfx::Rect, 32>& rects() const { return m_rects; }
     Gfx::Size window_size() const { return m_window_size; }
 
+    // Invalidation storms collapse into a single paint covering the union
+    // of the dirty rects.
+    virtual bool is_coalescible() const override { return true; }
+    virtual bool is_high_priority() const override { return true; }
+    virtual void absorb(Core::Event&& other) override
+    {
+        auto& newer = static_cast<MultiPaintEvent&>(other);
+        if (m_window_size != newer.m_window_size || newer.m_rects.first().is_empty()) {
+            // A size change or full-window invalidation supersedes the old rects.
+            m_rects = newer.m_rects;
+            m_window_size = newer.m_window_size;
+            return;
+        }
+        if (m_rects.first().is_empty()) {
+            // We already cover the whole window.
+            return;
+        }
+        for (auto& rect : newer.m_rects) {
+            bool contained = false;
+            for (auto& existing_rect : m_rects) {
+                if (existing_rect.contains(rect)) {
+                    contained = true;
+                    break;
+                }
+            }
+            if (!contained)
+                m_rects.append(rect);
+        }
+    }
+
 private:
     Vector<Gfx::Rect, 32> m_rects;
     Gfx::Size m_window_size;
@@ -303,6 +333,17 @@ public:
     unsigned modifiers() const { return m_modifiers; }
     int wheel_delta() const { return m_wheel_delta; }
 
+    // Queued mouse moves collapse into the latest one; clicks and wheel
+    // events must all be delivered.
+    virtual bool is_coalescible() const override { return type() == MouseMove; }
+    virtual void absorb(Core::Event&& other) override
+    {
+        auto& newer = static_cast<MouseEvent&>(other);
+        m_position = newer.m_position;
+        m_buttons = newer.m_buttons;
+        m_modifiers = newer.m_modifiers;
+    }
+
 private:
     Gfx::Point m_position;
     unsigned m_buttons { 0 };
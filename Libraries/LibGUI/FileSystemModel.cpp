@@ -65,6 +65,12 @@ bool FileSystemModel::Node::fetch_data(const String& full_path, bool is_root)
         return false;
     }
 
+    populate_data_from_stat(full_path, st);
+    return true;
+}
+
+void FileSystemModel::Node::populate_data_from_stat(const String& full_path, const struct stat& st)
+{
     size = st.st_size;
     mode = st.st_mode;
     uid = st.st_uid;
@@ -82,8 +88,6 @@ bool FileSystemModel::Node::fetch_data(const String& full_path, bool is_root)
             symlink_target = String(buffer, length - 1);
         }
     }
-
-    return true;
 }
 
 void FileSystemModel::Node::traverse_if_needed(const FileSystemModel& model)
@@ -101,16 +105,39 @@ void FileSystemModel::Node::traverse_if_needed(const FileSystemModel& model)
         return;
     }
 
-    while (di.has_next()) {
-        String name = di.next_path();
-        String child_path = String::format("%s/%s", full_path.characters(), name.characters());
-        NonnullOwnPtr<Node> child = make<Node>();
-        bool ok = child->fetch_data(child_path, false);
-        if (!ok)
+    Vector<String> child_names;
+    while (di.has_next())
+        child_names.append(di.next_path());
+
+    // Stat all the children with a single batch_stat() call instead of
+    // one lstat() syscall per directory entry.
+    Vector<String> child_paths;
+    Vector<const char*> child_path_characters;
+    child_paths.ensure_capacity(child_names.size());
+    child_path_characters.ensure_capacity(child_names.size());
+    for (auto& name : child_names) {
+        child_paths.append(String::format("%s/%s", full_path.characters(), name.characters()));
+        child_path_characters.append(child_paths.last().characters());
+    }
+
+    Vector<struct stat> stats;
+    Vector<int> results;
+    stats.resize(child_names.size());
+    results.resize(child_names.size());
+    if (batch_stat(child_path_characters.data(), child_path_characters.size(), stats.data(), results.data(), false) < 0) {
+        m_error = errno;
+        perror("batch_stat");
+        return;
+    }
+
+    for (size_t i = 0; i < child_names.size(); ++i) {
+        if (results[i] < 0)
             continue;
+        NonnullOwnPtr<Node> child = make<Node>();
+        child->populate_data_from_stat(child_paths[i], stats[i]);
         if (model.m_mode == DirectoriesOnly && !S_ISDIR(child->mode))
             continue;
-        child->name = name;
+        child->name = child_names[i];
         child->parent = this;
         total_size += child->size;
         children.append(move(child));
@@ -128,7 +155,7 @@ void FileSystemModel::Node::traverse_if_needed(const FileSystemModel& model)
     dbg() << "Watching " << full_path << " for changes, m_watch_fd = " << m_watch_fd;
     m_notifier = Core::Notifier::construct(m_watch_fd, Core::Notifier::Event::Read);
     m_notifier->on_ready_to_read = [this, &model] {
-        char buffer[32];
+        char buffer[4096];
         int rc = read(m_notifier->fd(), buffer, sizeof(buffer));
         ASSERT(rc >= 0);
 
@@ -466,7 +493,7 @@ static RefPtr<Gfx::Bitmap> render_thumbnail(const StringView& path)
     destination.center_within(thumbnail->rect());
 
     Painter painter(*thumbnail);
-    painter.draw_scaled_bitmap(destination, *png_bitmap, png_bitmap->rect());
+    painter.draw_scaled_bitmap(destination, *png_bitmap, png_bitmap->rect(), Painter::ScalingMode::BoxSampling);
     return thumbnail;
 }
 
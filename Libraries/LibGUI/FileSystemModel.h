@@ -116,6 +116,7 @@ public:
         void traverse_if_needed(const FileSystemModel&);
         void reify_if_needed(const FileSystemModel&);
         bool fetch_data(const String& full_path, bool is_root);
+        void populate_data_from_stat(const String& full_path, const struct stat&);
     };
 
     static NonnullRefPtr<FileSystemModel> create(const StringView& root_path = "/", Mode mode = Mode::FilesAndDirectories)
@@ -45,6 +45,21 @@ FontDatabase& FontDatabase::the()
 
 FontDatabase::FontDatabase()
 {
+    // Note that we don't enumerate /res/fonts here; apps that only ever use
+    // the default fonts shouldn't pay for inspecting every installed font
+    // at startup. The scan happens on the first actual query instead.
+}
+
+FontDatabase::~FontDatabase()
+{
+}
+
+void FontDatabase::ensure_scanned() const
+{
+    if (m_scanned)
+        return;
+    m_scanned = true;
+
     Core::DirIterator di("/res/fonts", Core::DirIterator::SkipDots);
     if (di.has_error()) {
         fprintf(stderr, "DirIterator: %s\n", di.error_string());
@@ -56,22 +71,22 @@ FontDatabase::FontDatabase()
             continue;
 
         auto path = String::format("/res/fonts/%s", name.characters());
-        if (auto font = Gfx::Font::load_from_file(path)) {
-            Metadata metadata;
-            metadata.path = path;
-            metadata.glyph_height = font->glyph_height();
-            metadata.is_fixed_width = font->is_fixed_width();
-            m_name_to_metadata.set(font->name(), move(metadata));
-        }
+        // The header has everything we need; the glyph data isn't read
+        // until someone actually asks for this face via get_by_name().
+        auto file_metadata = Gfx::Font::load_metadata_from_file(path);
+        if (!file_metadata.has_value())
+            continue;
+        Metadata metadata;
+        metadata.path = path;
+        metadata.glyph_height = file_metadata.value().glyph_height;
+        metadata.is_fixed_width = file_metadata.value().is_fixed_width;
+        m_name_to_metadata.set(file_metadata.value().name, move(metadata));
     }
 }
 
-FontDatabase::~FontDatabase()
-{
-}
-
 void FontDatabase::for_each_font(Function<void(const StringView&)> callback)
 {
+    ensure_scanned();
     Vector<String> names;
     names.ensure_capacity(m_name_to_metadata.size());
     for (auto& it : m_name_to_metadata)
@@ -83,6 +98,7 @@ void FontDatabase::for_each_font(Function<void(const StringView&)> callback)
 
 void FontDatabase::for_each_fixed_width_font(Function<void(const StringView&)> callback)
 {
+    ensure_scanned();
     Vector<String> names;
     names.ensure_capacity(m_name_to_metadata.size());
     for (auto& it : m_name_to_metadata) {
@@ -96,6 +112,7 @@ void FontDatabase::for_each_fixed_width_font(Function<void(const StringView&)> c
 
 RefPtr<Gfx::Font> FontDatabase::get_by_name(const StringView& name)
 {
+    ensure_scanned();
     auto it = m_name_to_metadata.find(name);
     if (it == m_name_to_metadata.end())
         return nullptr;
@@ -49,6 +49,7 @@ public:
 
     Optional<Metadata> get_metadata_by_name(const StringView& name) const
     {
+        ensure_scanned();
         return m_name_to_metadata.get(name);
     }
 
@@ -56,7 +57,10 @@ private:
     FontDatabase();
     ~FontDatabase();
 
-    HashMap<String, Metadata> m_name_to_metadata;
+    void ensure_scanned() const;
+
+    mutable HashMap<String, Metadata> m_name_to_metadata;
+    mutable bool m_scanned { false };
 };
 
 }
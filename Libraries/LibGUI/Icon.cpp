@@ -25,6 +25,7 @@
  */
 
 #include <AK/String.h>
+#include <LibGUI/BitmapCache.h>
 #include <LibGUI/Icon.h>
 #include <LibGfx/Bitmap.h>
 
@@ -94,8 +95,8 @@ void IconImpl::set_bitmap_for_size(int size, RefPtr<Gfx::Bitmap>&& bitmap)
 
 Icon Icon::default_icon(const StringView& name)
 {
-    auto bitmap16 = Gfx::Bitmap::load_from_file(String::format("/res/icons/16x16/%s.png", String(name).characters()));
-    auto bitmap32 = Gfx::Bitmap::load_from_file(String::format("/res/icons/32x32/%s.png", String(name).characters()));
+    auto bitmap16 = BitmapCache::the().load(String::format("/res/icons/16x16/%s.png", String(name).characters()));
+    auto bitmap32 = BitmapCache::the().load(String::format("/res/icons/32x32/%s.png", String(name).characters()));
     return Icon(move(bitmap16), move(bitmap32));
 }
 
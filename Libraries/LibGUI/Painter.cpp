@@ -36,10 +36,15 @@ Painter::Painter(Gfx::Bitmap& bitmap)
 }
 
 Painter::Painter(Widget& widget)
-    : Painter(*widget.window()->back_bitmap())
+    : Painter(widget.window()->paint_redirection().bitmap
+            ? *widget.window()->paint_redirection().bitmap
+            : *widget.window()->back_bitmap())
 {
     state().font = &widget.font();
     auto origin_rect = widget.window_relative_rect();
+    // When painting is redirected into a widget's backing layer, coordinates
+    // are relative to the layer's origin instead of the window's.
+    origin_rect.move_by(-widget.window()->paint_redirection().origin);
     state().translation = origin_rect.location();
     state().clip_rect = origin_rect;
     m_clip_origin = origin_rect;
@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/NonnullOwnPtrVector.h>
 #include <AK/QuickSort.h>
 #include <LibGUI/AbstractView.h>
 #include <LibGUI/SortingProxyModel.h>
@@ -112,33 +113,82 @@ void SortingProxyModel::set_key_column_and_sort_order(int column, SortOrder sort
 
 void SortingProxyModel::resort()
 {
-    auto old_row_mappings = m_row_mappings;
+    auto old_row_mappings = move(m_row_mappings);
     int row_count = target().row_count();
-    m_row_mappings.resize(row_count);
-    for (int i = 0; i < row_count; ++i)
-        m_row_mappings[i] = i;
     if (m_key_column == -1) {
+        m_row_mappings.resize(row_count);
+        for (int i = 0; i < row_count; ++i)
+            m_row_mappings[i] = i;
         did_update(Model::UpdateFlag::DontInvalidateIndexes);
         return;
     }
-    quick_sort(m_row_mappings, [&](auto row1, auto row2) -> bool {
-        auto data1 = target().data(target().index(row1, m_key_column), Model::Role::Sort);
-        auto data2 = target().data(target().index(row2, m_key_column), Model::Role::Sort);
+
+    // Fetch (and normalize) each row's sort key exactly once up front, instead
+    // of re-fetching two of them for every comparison inside the sort.
+    NonnullOwnPtrVector<Variant> sort_keys;
+    sort_keys.ensure_capacity(row_count);
+    for (int i = 0; i < row_count; ++i) {
+        auto data = target().data(target().index(i, m_key_column), Model::Role::Sort);
+        if (!m_sorting_case_sensitive && data.is_string())
+            data = data.as_string().to_lowercase();
+        sort_keys.append(make<Variant>(data));
+    }
+
+    auto is_less_than = [&](int row1, int row2) -> bool {
+        auto& data1 = sort_keys[row1];
+        auto& data2 = sort_keys[row2];
         if (data1 == data2)
-            return 0;
-        bool is_less_than;
-        if (data1.is_string() && data2.is_string() && !m_sorting_case_sensitive)
-            is_less_than = data1.as_string().to_lowercase() < data2.as_string().to_lowercase();
-        else
-            is_less_than = data1 < data2;
+            return false;
+        bool is_less_than = data1 < data2;
         return m_sort_order == SortOrder::Ascending ? is_less_than : !is_less_than;
-    });
+    };
+
+    auto is_sorted = [&](const Vector<int>& mappings) {
+        for (size_t i = 1; i < mappings.size(); ++i) {
+            if (is_less_than(mappings[i], mappings[i - 1]))
+                return false;
+        }
+        return true;
+    };
+
+    // Row updates usually leave the old ordering intact (or merely append new
+    // rows at the end of the target), so before paying for a full sort, check
+    // if the old mapping is still sorted under the new keys. If it is, keep it
+    // and merge in whatever rows are new.
+    bool reused_old_mappings = false;
+    if (!old_row_mappings.is_empty() && old_row_mappings.size() <= (size_t)row_count && is_sorted(old_row_mappings)) {
+        Vector<int> new_rows;
+        new_rows.ensure_capacity(row_count - old_row_mappings.size());
+        for (int i = (int)old_row_mappings.size(); i < row_count; ++i)
+            new_rows.append(i);
+        quick_sort(new_rows, is_less_than);
+
+        m_row_mappings.ensure_capacity(row_count);
+        size_t old_index = 0;
+        size_t new_index = 0;
+        while (old_index < old_row_mappings.size() || new_index < new_rows.size()) {
+            if (new_index == new_rows.size() || (old_index < old_row_mappings.size() && !is_less_than(new_rows[new_index], old_row_mappings[old_index])))
+                m_row_mappings.append(old_row_mappings[old_index++]);
+            else
+                m_row_mappings.append(new_rows[new_index++]);
+        }
+        reused_old_mappings = true;
+    }
+
+    if (!reused_old_mappings) {
+        m_row_mappings.resize(row_count);
+        for (int i = 0; i < row_count; ++i)
+            m_row_mappings[i] = i;
+        quick_sort(m_row_mappings, is_less_than);
+    }
+
     did_update(Model::UpdateFlag::DontInvalidateIndexes);
     for_each_view([&](AbstractView& view) {
         auto& selection = view.selection();
         Vector<ModelIndex> selected_indexes_in_target;
         selection.for_each_index([&](const ModelIndex& index) {
-            selected_indexes_in_target.append(target().index(old_row_mappings[index.row()], index.column()));
+            if ((size_t)index.row() < old_row_mappings.size())
+                selected_indexes_in_target.append(target().index(old_row_mappings[index.row()], index.column()));
         });
 
         selection.clear();
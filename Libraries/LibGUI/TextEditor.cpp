@@ -111,8 +111,7 @@ void TextEditor::set_text(const StringView& text)
 
     document().set_text(text);
 
-    update_content_size();
-    recompute_all_visual_lines();
+    invalidate_visual_layout();
     if (is_single_line())
         set_cursor(0, line(0).length());
     else
@@ -125,9 +124,18 @@ void TextEditor::update_content_size()
 {
     int content_width = 0;
     int content_height = 0;
-    for (auto& line : m_line_visual_data) {
-        content_width = max(line.visual_rect.width(), content_width);
-        content_height += line.visual_rect.height();
+    if (is_line_wrapping_enabled()) {
+        for (auto& line : m_line_visual_data) {
+            content_width = max(line.visual_rect.width(), content_width);
+            content_height += line.visual_rect.height();
+        }
+    } else {
+        // Without wrapping, every line is one visual line of uniform height,
+        // so there's no need to walk the whole document here. The width is
+        // the widest line measured so far; off-screen lines contribute once
+        // they've been laid out.
+        content_width = m_widest_line_width;
+        content_height = (int)line_count() * line_height();
     }
     content_width += m_horizontal_content_padding * 2;
     if (is_right_text_alignment(m_text_alignment))
@@ -147,15 +155,19 @@ TextPosition TextEditor::text_position_at(const Gfx::Point& a_position) const
     size_t line_index = 0;
 
     if (is_line_wrapping_enabled()) {
-        for (size_t i = 0; i < line_count(); ++i) {
-            auto& rect = m_line_visual_data[i].visual_rect;
-            if (position.y() >= rect.top() && position.y() <= rect.bottom()) {
-                line_index = i;
-                break;
-            }
+        // Visual rects are stacked top to bottom, so we can binary search the
+        // y coordinate instead of scanning every line.
+        size_t low = 0;
+        size_t high = line_count() - 1;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            auto& rect = m_line_visual_data[mid].visual_rect;
             if (position.y() > rect.bottom())
-                line_index = line_count() - 1;
+                low = mid + 1;
+            else
+                high = mid;
         }
+        line_index = low;
     } else {
         line_index = (size_t)(position.y() / line_height());
     }
@@ -410,8 +422,11 @@ void TextEditor::paint_event(PaintEvent& event)
     };
     painter.add_clip_rect(text_clip_rect);
 
+    int widest_line_width_before_painting = m_widest_line_width;
+
     for (size_t line_index = first_visible_line; line_index <= last_visible_line; ++line_index) {
         auto& line = this->line(line_index);
+        recompute_visual_lines(line_index);
 
         bool physical_line_has_selection = has_selection && line_index >= selection.start().line() && line_index <= selection.end().line();
         size_t first_visual_line_with_selection = 0;
@@ -518,6 +533,11 @@ void TextEditor::paint_event(PaintEvent& event)
 
     if (is_focused() && m_cursor_state)
         painter.fill_rect(cursor_content_rect(), palette().text_cursor());
+
+    // If laying out the visible lines turned up a wider line than we'd seen
+    // before, grow the horizontal scroll range to match.
+    if (m_widest_line_width != widest_line_width_before_painting)
+        update_content_size();
 }
 
 void TextEditor::toggle_selection_if_needed_for_event(const KeyEvent& event)
@@ -1224,8 +1244,7 @@ void TextEditor::leave_event(Core::Event&)
 
 void TextEditor::did_change()
 {
-    update_content_size();
-    recompute_all_visual_lines();
+    invalidate_visual_layout();
     m_undo_action->set_enabled(can_undo());
     m_redo_action->set_enabled(can_redo());
     if (!m_has_pending_change_notification) {
@@ -1302,8 +1321,7 @@ void TextEditor::set_text_alignment(Gfx::TextAlignment alignment)
 void TextEditor::resize_event(ResizeEvent& event)
 {
     ScrollableWidget::resize_event(event);
-    update_content_size();
-    recompute_all_visual_lines();
+    invalidate_visual_layout();
 }
 
 void TextEditor::theme_change_event(ThemeChangeEvent& event)
@@ -1331,6 +1349,21 @@ void TextEditor::clear_selection()
     update();
 }
 
+void TextEditor::invalidate_visual_layout()
+{
+    // Bumping the generation marks every line's cached layout as stale;
+    // individual lines are re-measured lazily when they're next used, so a
+    // single-line edit only ever pays for the lines that end up on screen.
+    ++m_layout_generation;
+    if (is_line_wrapping_enabled()) {
+        // Wrapped lines have variable heights, so each line's y position
+        // depends on everything above it; reflow eagerly in that case.
+        recompute_all_visual_lines();
+        return;
+    }
+    update_content_size();
+}
+
 void TextEditor::recompute_all_visual_lines()
 {
     int y_offset = 0;
@@ -1366,10 +1399,14 @@ size_t TextEditor::visual_line_containing(size_t line_index, size_t column) cons
     return visual_line_index;
 }
 
-void TextEditor::recompute_visual_lines(size_t line_index)
+void TextEditor::recompute_visual_lines(size_t line_index) const
 {
-    auto& line = document().line(line_index);
     auto& visual_data = m_line_visual_data[line_index];
+    if (visual_data.layout_generation == m_layout_generation)
+        return;
+    visual_data.layout_generation = m_layout_generation;
+
+    auto& line = document().line(line_index);
 
     visual_data.visual_line_breaks.clear_with_capacity();
 
@@ -1392,10 +1429,15 @@ void TextEditor::recompute_visual_lines(size_t line_index)
 
     visual_data.visual_line_breaks.append(line.length());
 
-    if (is_line_wrapping_enabled())
+    if (is_line_wrapping_enabled()) {
         visual_data.visual_rect = { m_horizontal_content_padding, 0, available_width, static_cast<int>(visual_data.visual_line_breaks.size()) * line_height() };
-    else
-        visual_data.visual_rect = { m_horizontal_content_padding, 0, font().width(line.view()), line_height() };
+    } else {
+        // Without wrapping we know our y position outright, so set it here;
+        // there's no eager relayout pass to fill it in for us.
+        visual_data.visual_rect = { m_horizontal_content_padding, (int)line_index * line_height(), font().width(line.view()), line_height() };
+        if (visual_data.visual_rect.width() > m_widest_line_width)
+            m_widest_line_width = visual_data.visual_rect.width();
+    }
 }
 
 template<typename Callback>
@@ -1405,6 +1447,8 @@ void TextEditor::for_each_visual_line(size_t line_index, Callback callback) cons
     size_t start_of_line = 0;
     size_t visual_line_index = 0;
 
+    recompute_visual_lines(line_index);
+
     auto& line = document().line(line_index);
     auto& visual_data = m_line_visual_data[line_index];
 
@@ -1434,8 +1478,7 @@ void TextEditor::set_line_wrapping_enabled(bool enabled)
 
     m_line_wrapping_enabled = enabled;
     horizontal_scrollbar().set_visible(!m_line_wrapping_enabled);
-    update_content_size();
-    recompute_all_visual_lines();
+    invalidate_visual_layout();
     update();
 }
 
@@ -1447,7 +1490,8 @@ void TextEditor::add_custom_context_menu_action(Action& action)
 void TextEditor::did_change_font()
 {
     vertical_scrollbar().set_step(line_height());
-    recompute_all_visual_lines();
+    m_widest_line_width = 0;
+    invalidate_visual_layout();
     update();
     Widget::did_change_font();
 }
@@ -1455,28 +1499,29 @@ void TextEditor::did_change_font()
 void TextEditor::document_did_append_line()
 {
     m_line_visual_data.append(make<LineVisualData>());
-    recompute_all_visual_lines();
+    invalidate_visual_layout();
     update();
 }
 
 void TextEditor::document_did_remove_line(size_t line_index)
 {
     m_line_visual_data.remove(line_index);
-    recompute_all_visual_lines();
+    invalidate_visual_layout();
     update();
 }
 
 void TextEditor::document_did_remove_all_lines()
 {
     m_line_visual_data.clear();
-    recompute_all_visual_lines();
+    m_widest_line_width = 0;
+    invalidate_visual_layout();
     update();
 }
 
 void TextEditor::document_did_insert_line(size_t line_index)
 {
     m_line_visual_data.insert(line_index, make<LineVisualData>());
-    recompute_all_visual_lines();
+    invalidate_visual_layout();
     update();
 }
 
@@ -1491,6 +1536,7 @@ void TextEditor::document_did_set_text()
     m_line_visual_data.clear();
     for (size_t i = 0; i < m_document->line_count(); ++i)
         m_line_visual_data.append(make<LineVisualData>());
+    m_widest_line_width = 0;
     document_did_change();
 }
 
@@ -1513,7 +1559,8 @@ void TextEditor::set_document(TextDocument& document)
     m_cursor = { 0, 0 };
     if (has_selection())
         m_selection.clear();
-    recompute_all_visual_lines();
+    m_widest_line_width = 0;
+    invalidate_visual_layout();
     update();
     m_document->register_client(*this);
 }
@@ -191,6 +191,7 @@ private:
     int content_x_for_position(const TextPosition&) const;
     Gfx::Rect ruler_rect_in_inner_coordinates() const;
     Gfx::Rect visible_text_rect_in_inner_coordinates() const;
+    void invalidate_visual_layout();
     void recompute_all_visual_lines();
     void ensure_cursor_is_valid();
     void flush_pending_change_notification_if_needed();
@@ -200,7 +201,7 @@ private:
     void sort_selected_lines();
 
     size_t visual_line_containing(size_t line_index, size_t column) const;
-    void recompute_visual_lines(size_t line_index);
+    void recompute_visual_lines(size_t line_index) const;
 
     void automatic_selection_scroll_timer_fired();
 
@@ -247,9 +248,22 @@ private:
     struct LineVisualData {
         Vector<size_t, 1> visual_line_breaks;
         Gfx::Rect visual_rect;
+        // Compared against TextEditor::m_layout_generation to know whether
+        // this cache entry is current; stale entries are recomputed on use.
+        size_t layout_generation { 0 };
     };
 
-    NonnullOwnPtrVector<LineVisualData> m_line_visual_data;
+    // Visual line layout is computed lazily: editing bumps the generation
+    // counter instead of re-measuring every line, and individual lines are
+    // laid out again the first time they're actually needed (e.g. painted.)
+    // Line wrapping makes each line's y position depend on the heights of
+    // all lines above it, so enabling it falls back to eager relayout.
+    mutable NonnullOwnPtrVector<LineVisualData> m_line_visual_data;
+    size_t m_layout_generation { 1 };
+    // Widest line we've measured so far, for sizing the horizontal scroll
+    // range without walking the whole document. Only grows, except when the
+    // document or font is replaced.
+    mutable int m_widest_line_width { 0 };
 
     OwnPtr<SyntaxHighlighter> m_highlighter;
 
@@ -207,6 +207,9 @@ void Widget::event(Core::Event& event)
     case Event::Drop:
         return drop_event(static_cast<DropEvent&>(event));
     case Event::ThemeChange:
+        // The layer was rendered with the old theme's colors.
+        if (m_backing_layer_enabled)
+            add_backing_layer_dirty_rect(rect());
         return theme_change_event(static_cast<ThemeChangeEvent&>(event));
     case Event::Enter:
         return handle_enter_event(event);
@@ -222,6 +225,20 @@ void Widget::event(Core::Event& event)
 void Widget::handle_paint_event(PaintEvent& event)
 {
     ASSERT(is_visible());
+    if (m_backing_layer_enabled) {
+        repaint_backing_layer_if_needed();
+        if (m_backing_layer) {
+            Painter painter(*this);
+            painter.blit(event.rect().location(), *m_backing_layer, event.rect());
+            return;
+        }
+        // Couldn't allocate a layer; fall through and paint directly.
+    }
+    paint_everything(event);
+}
+
+void Widget::paint_everything(PaintEvent& event)
+{
     if (fill_with_background_color()) {
         Painter painter(*this);
         painter.fill_rect(event.rect(), palette().color(background_role()));
@@ -251,6 +268,54 @@ void Widget::handle_paint_event(PaintEvent& event)
     }
 }
 
+void Widget::repaint_backing_layer_if_needed()
+{
+    auto* window = this->window();
+    if (!window)
+        return;
+    if (!m_backing_layer || m_backing_layer->size() != size()) {
+        m_backing_layer = Gfx::Bitmap::create(Gfx::BitmapFormat::RGB32, size());
+        m_backing_layer_dirty_rects.clear_with_capacity();
+        m_backing_layer_dirty_rects.append(rect());
+    }
+    if (!m_backing_layer || m_backing_layer_dirty_rects.is_empty())
+        return;
+
+    // Redirect all painters created for this subtree into the layer bitmap.
+    // The previous redirection is restored afterwards so that layer-backed
+    // widgets nest correctly.
+    auto previous_redirection = window->paint_redirection();
+    window->set_paint_redirection({ m_backing_layer.ptr(), window_relative_rect().location() });
+    auto dirty_rects = move(m_backing_layer_dirty_rects);
+    for (auto& dirty_rect : dirty_rects) {
+        PaintEvent layer_event(dirty_rect);
+        paint_everything(layer_event);
+    }
+    window->set_paint_redirection(previous_redirection);
+}
+
+void Widget::add_backing_layer_dirty_rect(const Gfx::Rect& a_rect)
+{
+    auto dirty_rect = a_rect.intersected(rect());
+    if (dirty_rect.is_empty())
+        return;
+    for (auto& rect : m_backing_layer_dirty_rects) {
+        if (rect.contains(dirty_rect))
+            return;
+    }
+    m_backing_layer_dirty_rects.append(dirty_rect);
+}
+
+void Widget::set_backing_layer_enabled(bool enabled)
+{
+    if (m_backing_layer_enabled == enabled)
+        return;
+    m_backing_layer_enabled = enabled;
+    m_backing_layer = nullptr;
+    m_backing_layer_dirty_rects.clear_with_capacity();
+    update();
+}
+
 void Widget::set_layout(NonnullRefPtr<Layout> layout)
 {
     if (m_layout) {
@@ -438,12 +503,21 @@ void Widget::update(const Gfx::Rect& rect)
     if (!updates_enabled())
         return;
 
+    if (m_backing_layer_enabled)
+        add_backing_layer_dirty_rect(rect);
+
     Window* window = m_window;
     Widget* parent = parent_widget();
+    auto rect_in_parent = rect.translated(relative_position());
     while (parent) {
         if (!parent->updates_enabled())
             return;
+        // Dirt inside a layer-backed ancestor has to be re-rendered into its
+        // layer, not just repainted on screen.
+        if (parent->m_backing_layer_enabled)
+            parent->add_backing_layer_dirty_rect(rect_in_parent);
         window = parent->m_window;
+        rect_in_parent.move_by(parent->relative_position());
         parent = parent->parent_widget();
     }
     if (window)
@@ -127,6 +127,14 @@ public:
     bool updates_enabled() const { return m_updates_enabled; }
     void set_updates_enabled(bool);
 
+    // Opt-in retained backing layer for expensive widgets. The subtree is
+    // rendered into a layer bitmap that only dirty regions get re-rendered
+    // into; everything else (e.g. repainting areas uncovered by another
+    // window) becomes a blit. The widget must be opaque, i.e. it has to
+    // paint every pixel of its rect.
+    bool is_backing_layer_enabled() const { return m_backing_layer_enabled; }
+    void set_backing_layer_enabled(bool);
+
     virtual void event(Core::Event&) override;
 
     // This is called after children have been painted.
@@ -307,6 +315,9 @@ protected:
 
 private:
     void handle_paint_event(PaintEvent&);
+    void paint_everything(PaintEvent&);
+    void repaint_backing_layer_if_needed();
+    void add_backing_layer_dirty_rect(const Gfx::Rect&);
     void handle_resize_event(ResizeEvent&);
     void handle_mousedown_event(MouseEvent&);
     void handle_mousedoubleclick_event(MouseEvent&);
@@ -337,6 +348,10 @@ private:
     bool m_greedy_for_hits { false };
     bool m_enabled { true };
     bool m_updates_enabled { true };
+    bool m_backing_layer_enabled { false };
+
+    RefPtr<Gfx::Bitmap> m_backing_layer;
+    Vector<Gfx::Rect, 4> m_backing_layer_dirty_rects;
 
     NonnullRefPtr<Gfx::PaletteImpl> m_palette;
 };
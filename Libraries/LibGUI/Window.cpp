@@ -27,6 +27,7 @@
 #include <AK/HashMap.h>
 #include <AK/JsonObject.h>
 #include <AK/NeverDestroyed.h>
+#include <AK/QuickSort.h>
 #include <AK/SharedBuffer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/MimeData.h>
@@ -131,7 +132,7 @@ void Window::server_did_destroy()
     reified_windows->remove(m_window_id);
     m_window_id = 0;
     m_visible = false;
-    m_pending_paint_event_rects.clear();
+    m_pending_dirty_tiles.clear();
     m_back_bitmap = nullptr;
     m_front_bitmap = nullptr;
     m_override_cursor = StandardCursor::None;
@@ -266,17 +267,22 @@ void Window::event(Core::Event& event)
         auto& paint_event = static_cast<MultiPaintEvent&>(event);
         auto rects = paint_event.rects();
         ASSERT(!rects.is_empty());
+        bool created_new_backing_store = false;
         if (m_back_bitmap && m_back_bitmap->size() != paint_event.window_size()) {
-            // Eagerly discard the backing store if we learn from this paint event that it needs to be bigger.
-            // Otherwise we would have to wait for a resize event to tell us. This way we don't waste the
-            // effort on painting into an undersized bitmap that will be thrown away anyway.
-            m_back_bitmap = nullptr;
+            // If the over-allocated shared buffer still fits the new size, re-wrap
+            // it instead of allocating a fresh buffer on every resize step. Either
+            // way the old contents are stale, so below we treat this like a brand
+            // new backing store and repaint it in full.
+            m_back_bitmap = reuse_backing_bitmap(paint_event.window_size());
+            if (m_back_bitmap)
+                m_back_bitmap->shared_buffer()->set_nonvolatile();
+            created_new_backing_store = true;
         }
-        bool created_new_backing_store = !m_back_bitmap;
         if (!m_back_bitmap) {
             m_back_bitmap = create_backing_bitmap(paint_event.window_size());
             ASSERT(m_back_bitmap);
-        } else if (m_double_buffering_enabled) {
+            created_new_backing_store = true;
+        } else if (!created_new_backing_store && m_double_buffering_enabled) {
             bool still_has_pixels = m_back_bitmap->shared_buffer()->set_nonvolatile();
             if (!still_has_pixels) {
                 m_back_bitmap = create_backing_bitmap(paint_event.window_size());
@@ -341,11 +347,12 @@ void Window::event(Core::Event& event)
 
     if (event.type() == Event::Resize) {
         auto new_size = static_cast<ResizeEvent&>(event).size();
-        if (m_back_bitmap && m_back_bitmap->size() != new_size)
-            m_back_bitmap = nullptr;
-        if (!m_pending_paint_event_rects.is_empty()) {
-            m_pending_paint_event_rects.clear_with_capacity();
-            m_pending_paint_event_rects.append({ {}, new_size });
+        // NOTE: We keep the back bitmap around even though its size is now
+        //       wrong; the next paint will re-wrap its over-allocated shared
+        //       buffer at the new size if it still fits.
+        if (!m_pending_dirty_tiles.is_empty()) {
+            m_pending_dirty_tiles.clear();
+            add_pending_dirty_tiles({ {}, new_size });
         }
         m_rect_when_windowless = { {}, new_size };
         m_main_widget->set_relative_rect({ {}, new_size });
@@ -403,32 +410,87 @@ void Window::force_update()
     WindowServerConnection::the().post_message(Messages::WindowServer::InvalidateRect(m_window_id, { { 0, 0, rect.width(), rect.height() } }, true));
 }
 
-void Window::update(const Gfx::Rect& a_rect)
+// Pending damage is tracked per fixed-size tile rather than as a list of
+// raw rects: any number of update() calls collapses into a bounded set of
+// dirty tiles, and overlapping updates can never repaint the same pixels
+// twice. take_pending_dirty_rects() turns the tiles back into a few
+// maximal tile-aligned rects for the flush protocol.
+static const int pending_update_tile_size = 64;
+
+static unsigned pending_update_tile_key(int tx, int ty)
 {
-    if (!is_visible())
-        return;
+    return ((unsigned)ty << 16) | (unsigned)tx;
+}
 
-    for (auto& pending_rect : m_pending_paint_event_rects) {
-        if (pending_rect.contains(a_rect)) {
-#ifdef UPDATE_COALESCING_DEBUG
-            dbgprintf("Ignoring %s since it's contained by pending rect %s\n", a_rect.to_string().characters(), pending_rect.to_string().characters());
-#endif
-            return;
+void Window::add_pending_dirty_tiles(const Gfx::Rect& rect)
+{
+    int first_tile_x = max(0, rect.left()) / pending_update_tile_size;
+    int first_tile_y = max(0, rect.top()) / pending_update_tile_size;
+    int last_tile_x = max(0, rect.right()) / pending_update_tile_size;
+    int last_tile_y = max(0, rect.bottom()) / pending_update_tile_size;
+    for (int ty = first_tile_y; ty <= last_tile_y; ++ty) {
+        for (int tx = first_tile_x; tx <= last_tile_x; ++tx)
+            m_pending_dirty_tiles.set(pending_update_tile_key(tx, ty));
+    }
+}
+
+Vector<Gfx::Rect> Window::take_pending_dirty_rects()
+{
+    auto tiles = move(m_pending_dirty_tiles);
+    Vector<unsigned> keys;
+    keys.ensure_capacity(tiles.size());
+    for (auto& key : tiles)
+        keys.append(key);
+    // The key encoding sorts by (tile_y, tile_x).
+    quick_sort(keys, [](auto a, auto b) { return a < b; });
+
+    Vector<Gfx::Rect> rects;
+    for (size_t i = 0; i < keys.size();) {
+        int ty = keys[i] >> 16;
+        int tx = keys[i] & 0xffff;
+        // Grow a horizontal run of adjacent tiles...
+        size_t j = i + 1;
+        while (j < keys.size() && keys[j] == keys[j - 1] + 1 && (int)(keys[j] >> 16) == ty)
+            ++j;
+        Gfx::Rect run {
+            tx * pending_update_tile_size,
+            ty * pending_update_tile_size,
+            (int)(j - i) * pending_update_tile_size,
+            pending_update_tile_size
+        };
+        // ...and stack it onto a rect with the same horizontal extent
+        // directly above it, if there is one.
+        bool merged = false;
+        for (auto& rect : rects) {
+            if (rect.left() == run.left() && rect.width() == run.width() && rect.bottom() + 1 == run.top()) {
+                rect.set_height(rect.height() + run.height());
+                merged = true;
+                break;
+            }
         }
+        if (!merged)
+            rects.append(run);
+        i = j;
     }
+    return rects;
+}
+
+void Window::update(const Gfx::Rect& a_rect)
+{
+    if (!is_visible())
+        return;
+    if (a_rect.is_empty())
+        return;
 
-    if (m_pending_paint_event_rects.is_empty()) {
+    if (m_pending_dirty_tiles.is_empty()) {
         deferred_invoke([this](auto&) {
-            auto rects = move(m_pending_paint_event_rects);
+            auto rects = take_pending_dirty_rects();
             if (rects.is_empty())
                 return;
-            Vector<Gfx::Rect> rects_to_send;
-            for (auto& r : rects)
-                rects_to_send.append(r);
-            WindowServerConnection::the().post_message(Messages::WindowServer::InvalidateRect(m_window_id, rects_to_send, false));
+            WindowServerConnection::the().post_message(Messages::WindowServer::InvalidateRect(m_window_id, rects, false));
         });
     }
-    m_pending_paint_event_rects.append(a_rect);
+    add_pending_dirty_tiles(a_rect);
 }
 
 void Window::set_main_widget(Widget* widget)
@@ -491,7 +553,7 @@ void Window::set_has_alpha_channel(bool value)
     if (!is_visible())
         return;
 
-    m_pending_paint_event_rects.clear();
+    m_pending_dirty_tiles.clear();
     m_back_bitmap = nullptr;
     m_front_bitmap = nullptr;
 
@@ -538,9 +600,17 @@ void Window::flip(const Vector<Gfx::Rect, 32>& dirty_rects)
 
     set_current_backing_bitmap(*m_front_bitmap);
 
-    if (!m_back_bitmap || m_back_bitmap->size() != m_front_bitmap->size()) {
+    bool back_bitmap_is_fresh = false;
+    if (m_back_bitmap && m_back_bitmap->size() != m_front_bitmap->size()) {
+        m_back_bitmap = reuse_backing_bitmap(m_front_bitmap->size());
+        back_bitmap_is_fresh = true;
+    }
+    if (!m_back_bitmap) {
         m_back_bitmap = create_backing_bitmap(m_front_bitmap->size());
         ASSERT(m_back_bitmap);
+        back_bitmap_is_fresh = true;
+    }
+    if (back_bitmap_is_fresh) {
         memcpy(m_back_bitmap->scanline(0), m_front_bitmap->scanline(0), m_front_bitmap->size_in_bytes());
         m_back_bitmap->shared_buffer()->set_volatile();
         return;
@@ -568,8 +638,37 @@ RefPtr<Gfx::Bitmap> Window::create_shared_bitmap(Gfx::BitmapFormat format, const
 
 RefPtr<Gfx::Bitmap> Window::create_backing_bitmap(const Gfx::Size& size)
 {
+    ASSERT(WindowServerConnection::the().server_pid());
+    ASSERT(!size.is_empty());
+    auto format = m_has_alpha_channel ? Gfx::BitmapFormat::RGBA32 : Gfx::BitmapFormat::RGB32;
+    size_t pitch = round_up_to_power_of_two(size.width() * sizeof(Gfx::RGBA32), 16);
+    size_t size_in_bytes = size.height() * pitch;
+    // Over-allocate the shared buffer at the next power of two, so that
+    // interactive resizing can usually re-wrap this buffer at the new size
+    // instead of allocating (and sharing) a fresh one on every step.
+    size_t allocation_size = 4 * KB;
+    while (allocation_size < size_in_bytes)
+        allocation_size *= 2;
+    auto shared_buffer = SharedBuffer::create_with_size(allocation_size);
+    ASSERT(shared_buffer);
+    shared_buffer->share_with(WindowServerConnection::the().server_pid());
+    return Gfx::Bitmap::create_with_shared_buffer(format, *shared_buffer, size);
+}
+
+RefPtr<Gfx::Bitmap> Window::reuse_backing_bitmap(const Gfx::Size& size)
+{
+    // Re-wraps the current back bitmap's over-allocated shared buffer at a new
+    // size, if it still fits. Returns nullptr if it doesn't (or the format is
+    // no longer right), in which case the caller should allocate a fresh one.
+    if (!m_back_bitmap || !m_back_bitmap->shared_buffer())
+        return nullptr;
     auto format = m_has_alpha_channel ? Gfx::BitmapFormat::RGBA32 : Gfx::BitmapFormat::RGB32;
-    return create_shared_bitmap(format, size);
+    if (m_back_bitmap->format() != format)
+        return nullptr;
+    size_t pitch = round_up_to_power_of_two(size.width() * sizeof(Gfx::RGBA32), 16);
+    if (static_cast<size_t>(m_back_bitmap->shared_buffer()->size()) < size.height() * pitch)
+        return nullptr;
+    return Gfx::Bitmap::create_with_shared_buffer(format, *m_back_bitmap->shared_buffer(), size);
 }
 
 void Window::set_modal(bool modal)
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <AK/String.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Object.h>
@@ -155,6 +156,16 @@ public:
     Gfx::Bitmap* front_bitmap() { return m_front_bitmap.ptr(); }
     Gfx::Bitmap* back_bitmap() { return m_back_bitmap.ptr(); }
 
+    // While set, painters created for this window's widgets target the given
+    // bitmap (a widget's backing layer) instead of the back bitmap. The
+    // origin is the layer's window-relative location.
+    struct PaintRedirection {
+        Gfx::Bitmap* bitmap { nullptr };
+        Gfx::Point origin;
+    };
+    PaintRedirection paint_redirection() const { return m_paint_redirection; }
+    void set_paint_redirection(PaintRedirection redirection) { m_paint_redirection = redirection; }
+
     Gfx::Size size_increment() const { return m_size_increment; }
     void set_size_increment(const Gfx::Size&);
     Gfx::Size base_size() const { return m_base_size; }
@@ -194,13 +205,17 @@ private:
     void server_did_destroy();
 
     RefPtr<Gfx::Bitmap> create_backing_bitmap(const Gfx::Size&);
+    RefPtr<Gfx::Bitmap> reuse_backing_bitmap(const Gfx::Size&);
     RefPtr<Gfx::Bitmap> create_shared_bitmap(Gfx::BitmapFormat, const Gfx::Size&);
     void set_current_backing_bitmap(Gfx::Bitmap&, bool flush_immediately = false);
     void flip(const Vector<Gfx::Rect, 32>& dirty_rects);
     void force_update();
+    void add_pending_dirty_tiles(const Gfx::Rect&);
+    Vector<Gfx::Rect> take_pending_dirty_rects();
 
     RefPtr<Gfx::Bitmap> m_front_bitmap;
     RefPtr<Gfx::Bitmap> m_back_bitmap;
+    PaintRedirection m_paint_redirection;
     RefPtr<Gfx::Bitmap> m_icon;
     int m_window_id { 0 };
     float m_opacity_when_windowless { 1.0f };
@@ -211,7 +226,9 @@ private:
     WeakPtr<Widget> m_hovered_widget;
     Gfx::Rect m_rect_when_windowless;
     String m_title_when_windowless;
-    Vector<Gfx::Rect, 32> m_pending_paint_event_rects;
+    // Pending damage is tracked as a set of dirty 64x64 tiles instead of a
+    // list of raw rects; see update().
+    HashTable<unsigned> m_pending_dirty_tiles;
     Gfx::Size m_size_increment;
     Gfx::Size m_base_size;
     Color m_background_color { Color::WarmGray };
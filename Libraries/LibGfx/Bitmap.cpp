@@ -199,7 +199,7 @@ void Bitmap::set_mmap_name(const StringView& name)
 
 void Bitmap::fill(Color color)
 {
-    ASSERT(m_format == BitmapFormat::RGB32 || m_format == BitmapFormat::RGBA32);
+    ASSERT(m_format == BitmapFormat::RGB32 || m_format == BitmapFormat::RGBA32 || m_format == BitmapFormat::RGBA32Premultiplied);
     for (int y = 0; y < height(); ++y) {
         auto* scanline = this->scanline(y);
         fast_u32_fill(scanline, color.value(), width());
@@ -39,6 +39,11 @@ enum class BitmapFormat {
     Invalid,
     RGB32,
     RGBA32,
+    // Like RGBA32, but the color channels are premultiplied by alpha.
+    // Compositing a premultiplied source over an opaque destination is
+    // multiply-add only (no divides), which is what the span kernels in
+    // Painter want. PNG decoding emits this format for images with alpha.
+    RGBA32Premultiplied,
     Indexed8
 };
 
@@ -86,6 +91,7 @@ public:
             return 8;
         case BitmapFormat::RGB32:
         case BitmapFormat::RGBA32:
+        case BitmapFormat::RGBA32Premultiplied:
             return 32;
         default:
             ASSERT_NOT_REACHED();
@@ -101,7 +107,8 @@ public:
 
     void fill(Color);
 
-    bool has_alpha_channel() const { return m_format == BitmapFormat::RGBA32; }
+    bool has_alpha_channel() const { return m_format == BitmapFormat::RGBA32 || m_format == BitmapFormat::RGBA32Premultiplied; }
+    bool has_premultiplied_alpha() const { return m_format == BitmapFormat::RGBA32Premultiplied; }
     BitmapFormat format() const { return m_format; }
 
     void set_mmap_name(const StringView&);
@@ -196,6 +203,14 @@ inline Color Bitmap::get_pixel<BitmapFormat::RGBA32>(int x, int y) const
     return Color::from_rgba(scanline(y)[x]);
 }
 
+// NOTE: This returns the stored (premultiplied) value; use
+// Color::unpremultiplied() if you need straight alpha.
+template<>
+inline Color Bitmap::get_pixel<BitmapFormat::RGBA32Premultiplied>(int x, int y) const
+{
+    return Color::from_rgba(scanline(y)[x]);
+}
+
 template<>
 inline Color Bitmap::get_pixel<BitmapFormat::Indexed8>(int x, int y) const
 {
@@ -209,6 +224,8 @@ inline Color Bitmap::get_pixel(int x, int y) const
         return get_pixel<BitmapFormat::RGB32>(x, y);
     case BitmapFormat::RGBA32:
         return get_pixel<BitmapFormat::RGBA32>(x, y);
+    case BitmapFormat::RGBA32Premultiplied:
+        return get_pixel<BitmapFormat::RGBA32Premultiplied>(x, y);
     case BitmapFormat::Indexed8:
         return get_pixel<BitmapFormat::Indexed8>(x, y);
     default:
@@ -229,6 +246,13 @@ inline void Bitmap::set_pixel<BitmapFormat::RGBA32>(int x, int y, Color color)
     scanline(y)[x] = color.value();
 }
 
+// NOTE: The caller is expected to pass an already-premultiplied color.
+template<>
+inline void Bitmap::set_pixel<BitmapFormat::RGBA32Premultiplied>(int x, int y, Color color)
+{
+    scanline(y)[x] = color.value();
+}
+
 inline void Bitmap::set_pixel(int x, int y, Color color)
 {
     switch (m_format) {
@@ -238,6 +262,9 @@ inline void Bitmap::set_pixel(int x, int y, Color color)
     case BitmapFormat::RGBA32:
         set_pixel<BitmapFormat::RGBA32>(x, y, color);
         break;
+    case BitmapFormat::RGBA32Premultiplied:
+        set_pixel<BitmapFormat::RGBA32Premultiplied>(x, y, color);
+        break;
     case BitmapFormat::Indexed8:
         ASSERT_NOT_REACHED();
     default:
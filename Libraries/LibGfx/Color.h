@@ -136,6 +136,35 @@ public:
         return Color(r, g, b, a);
     }
 
+    // Source-over where the source carries premultiplied channels and *this
+    // is the destination. Multiply-add only; the /255 is by a constant, so
+    // the compiler strength-reduces it to a multiply and shift.
+    Color blend_premultiplied(Color source) const
+    {
+        unsigned inverse_alpha = 255u - source.alpha();
+        u8 r = source.red() + red() * inverse_alpha / 255;
+        u8 g = source.green() + green() * inverse_alpha / 255;
+        u8 b = source.blue() + blue() * inverse_alpha / 255;
+        u8 a = source.alpha() + alpha() * inverse_alpha / 255;
+        return Color(r, g, b, a);
+    }
+
+    Color premultiplied() const
+    {
+        return Color(red() * alpha() / 255, green() * alpha() / 255, blue() * alpha() / 255, alpha());
+    }
+
+    Color unpremultiplied() const
+    {
+        if (!alpha() || alpha() == 255)
+            return *this;
+        // Clamp in case a channel exceeds alpha (malformed input.)
+        int r = min(255, red() * 255 / alpha());
+        int g = min(255, green() * 255 / alpha());
+        int b = min(255, blue() * 255 / alpha());
+        return Color(r, g, b, alpha());
+    }
+
     Color to_grayscale() const
     {
         int gray = (red() + green() + blue()) / 3;
@@ -28,48 +28,76 @@
 
 namespace Gfx {
 
+// Past this many rects we start coalescing instead of keeping the set
+// exact. Each rect costs the Compositor a separate blit, and pathological
+// invalidation patterns (many small widget updates) otherwise explode the
+// count without bound.
+static const size_t maximum_rect_count = 256;
+
 void DisjointRectSet::add(const Rect& new_rect)
 {
-    for (auto& rect : m_rects) {
-        if (rect.contains(new_rect))
-            return;
+    if (new_rect.is_empty())
+        return;
+
+    // If the new rect doesn't even touch the bounding rect of the set,
+    // it can't overlap any member and we can skip the scan entirely.
+    if (!m_rects.is_empty() && m_bounding_rect.intersects(new_rect)) {
+        // The rects already in the set are pairwise disjoint, so we only
+        // need to shatter the new rect against the members it overlaps;
+        // everything already in the set stays put.
+        Vector<Rect, 32> pieces;
+        pieces.append(new_rect);
+        for (auto& existing_rect : m_rects) {
+            if (!existing_rect.intersects(new_rect))
+                continue;
+            Vector<Rect, 32> leftovers;
+            for (auto& piece : pieces) {
+                if (existing_rect.contains(piece))
+                    continue;
+                for (auto& shard : piece.shatter(existing_rect))
+                    leftovers.append(shard);
+            }
+            pieces = move(leftovers);
+            if (pieces.is_empty())
+                return;
+        }
+        for (auto& piece : pieces)
+            m_rects.append(piece);
+    } else {
+        m_rects.append(new_rect);
     }
 
-    m_rects.append(new_rect);
-    if (m_rects.size() > 1)
-        shatter();
+    m_bounding_rect = m_bounding_rect.united(new_rect);
+    if (m_rects.size() > maximum_rect_count)
+        coalesce();
 }
 
-void DisjointRectSet::shatter()
+void DisjointRectSet::coalesce()
 {
-    Vector<Rect, 32> output;
-    output.ensure_capacity(m_rects.size());
-    bool pass_had_intersections = false;
+    // First try lossless merges: two rects that share a full edge can be
+    // replaced by their union without over-invalidating anything.
+    bool merged_something = false;
     do {
-        pass_had_intersections = false;
-        output.clear_with_capacity();
+        merged_something = false;
         for (size_t i = 0; i < m_rects.size(); ++i) {
-            auto& r1 = m_rects[i];
-            for (size_t j = 0; j < m_rects.size(); ++j) {
-                if (i == j)
-                    continue;
-                auto& r2 = m_rects[j];
-                if (!r1.intersects(r2))
+            for (size_t j = i + 1; j < m_rects.size(); ++j) {
+                auto united = m_rects[i].united(m_rects[j]);
+                if (united.width() * united.height() != m_rects[i].width() * m_rects[i].height() + m_rects[j].width() * m_rects[j].height())
                     continue;
-                pass_had_intersections = true;
-                auto pieces = r1.shatter(r2);
-                for (auto& piece : pieces)
-                    output.append(piece);
-                m_rects.remove(i);
-                for (; i < m_rects.size(); ++i)
-                    output.append(m_rects[i]);
-                goto next_pass;
+                m_rects[i] = united;
+                m_rects.remove(j);
+                merged_something = true;
+                --j;
             }
-            output.append(r1);
         }
-    next_pass:
-        swap(output, m_rects);
-    } while (pass_had_intersections);
+    } while (merged_something && m_rects.size() > maximum_rect_count);
+
+    // Still too many? Give up on precision and collapse into the bounding
+    // rect. Over-invalidating beats spending the frame juggling rects.
+    if (m_rects.size() > maximum_rect_count) {
+        m_rects.clear_with_capacity();
+        m_rects.append(m_bounding_rect);
+    }
 }
 
 }
@@ -37,22 +37,45 @@ public:
     ~DisjointRectSet() {}
     DisjointRectSet(DisjointRectSet&& other)
         : m_rects(move(other.m_rects))
+        , m_bounding_rect(other.m_bounding_rect)
     {
+        other.m_bounding_rect = {};
     }
 
     void add(const Rect&);
 
     bool is_empty() const { return m_rects.is_empty(); }
     size_t size() const { return m_rects.size(); }
+    Rect bounding_rect() const { return m_bounding_rect; }
 
-    void clear() { m_rects.clear(); }
-    void clear_with_capacity() { m_rects.clear_with_capacity(); }
+    bool intersects(const Rect& rect) const
+    {
+        if (!m_bounding_rect.intersects(rect))
+            return false;
+        for (auto& r : m_rects) {
+            if (r.intersects(rect))
+                return true;
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        m_rects.clear();
+        m_bounding_rect = {};
+    }
+    void clear_with_capacity()
+    {
+        m_rects.clear_with_capacity();
+        m_bounding_rect = {};
+    }
     const Vector<Rect, 32>& rects() const { return m_rects; }
 
 private:
-    void shatter();
+    void coalesce();
 
     Vector<Rect, 32> m_rects;
+    Rect m_bounding_rect;
 };
 
 }
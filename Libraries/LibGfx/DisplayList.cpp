@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/DisplayList.h>
+#include <LibGfx/Font.h>
+#include <LibGfx/Painter.h>
+
+namespace Gfx {
+
+void DisplayList::replay(Painter& painter)
+{
+    for (auto& command : m_commands)
+        command(painter);
+}
+
+void RecordingPainter::clear_rect(const Rect& rect, Color color)
+{
+    m_display_list.append([=](Painter& painter) { painter.clear_rect(rect, color); });
+}
+
+void RecordingPainter::fill_rect(const Rect& rect, Color color)
+{
+    m_display_list.append([=](Painter& painter) { painter.fill_rect(rect, color); });
+}
+
+void RecordingPainter::fill_rect_with_gradient(Orientation orientation, const Rect& rect, Color gradient_start, Color gradient_end)
+{
+    m_display_list.append([=](Painter& painter) { painter.fill_rect_with_gradient(orientation, rect, gradient_start, gradient_end); });
+}
+
+void RecordingPainter::draw_rect(const Rect& rect, Color color, bool rough)
+{
+    m_display_list.append([=](Painter& painter) { painter.draw_rect(rect, color, rough); });
+}
+
+void RecordingPainter::set_pixel(const Point& point, Color color)
+{
+    m_display_list.append([=](Painter& painter) { painter.set_pixel(point, color); });
+}
+
+void RecordingPainter::draw_line(const Point& point1, const Point& point2, Color color, int thickness, bool dotted)
+{
+    m_display_list.append([=](Painter& painter) { painter.draw_line(point1, point2, color, thickness, dotted); });
+}
+
+void RecordingPainter::draw_scaled_bitmap(const Rect& dst_rect, const Bitmap& bitmap, const Rect& src_rect)
+{
+    m_display_list.append([=, &bitmap](Painter& painter) { painter.draw_scaled_bitmap(dst_rect, bitmap, src_rect); });
+}
+
+void RecordingPainter::blit(const Point& position, const Bitmap& bitmap, const Rect& src_rect, float opacity)
+{
+    m_display_list.append([=, &bitmap](Painter& painter) { painter.blit(position, bitmap, src_rect, opacity); });
+}
+
+void RecordingPainter::draw_text(const Rect& rect, const StringView& text, const Font& font, TextAlignment alignment, Color color, TextElision elision)
+{
+    String copied_text = text;
+    m_display_list.append([=, &font](Painter& painter) { painter.draw_text(rect, copied_text, font, alignment, color, elision); });
+}
+
+void RecordingPainter::draw_text(const Rect& rect, const StringView& text, TextAlignment alignment, Color color, TextElision elision)
+{
+    String copied_text = text;
+    m_display_list.append([=](Painter& painter) { painter.draw_text(rect, copied_text, alignment, color, elision); });
+}
+
+void RecordingPainter::translate(int dx, int dy)
+{
+    m_display_list.append([=](Painter& painter) { painter.translate(dx, dy); });
+}
+
+void RecordingPainter::add_clip_rect(const Rect& rect)
+{
+    m_display_list.append([=](Painter& painter) { painter.add_clip_rect(rect); });
+}
+
+void RecordingPainter::clear_clip_rect()
+{
+    m_display_list.append([](Painter& painter) { painter.clear_clip_rect(); });
+}
+
+void RecordingPainter::save()
+{
+    m_display_list.append([](Painter& painter) { painter.save(); });
+}
+
+void RecordingPainter::restore()
+{
+    m_display_list.append([](Painter& painter) { painter.restore(); });
+}
+
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Orientation.h>
+#include <LibGfx/Rect.h>
+#include <LibGfx/TextAlignment.h>
+#include <LibGfx/TextElision.h>
+
+namespace Gfx {
+
+// A recorded list of draw commands with all their arguments captured, so
+// the actual rasterization can happen later -- possibly on another thread.
+// Recording is cheap (no pixels are touched), and replay() only writes to
+// the target Painter's bitmap, so a recorded list can safely be handed to
+// a LibThread worker while the recording thread goes back to its event
+// loop.
+class DisplayList : public RefCounted<DisplayList> {
+public:
+    static NonnullRefPtr<DisplayList> create() { return adopt(*new DisplayList); }
+
+    void append(Function<void(Painter&)>&& command) { m_commands.append(move(command)); }
+    void replay(Painter&);
+
+    size_t command_count() const { return m_commands.size(); }
+    bool is_empty() const { return m_commands.is_empty(); }
+    void clear() { m_commands.clear(); }
+
+private:
+    DisplayList() {}
+
+    Vector<Function<void(Painter&)>> m_commands;
+};
+
+// Records the core Painter primitives into a DisplayList instead of
+// painting them. Mirrors Painter's signatures so paint code can be
+// switched over by changing the painter type. Referenced bitmaps and
+// fonts are captured by reference and must stay alive until replay;
+// strings are copied since StringView arguments rarely outlive the
+// paint call that passes them.
+class RecordingPainter {
+public:
+    explicit RecordingPainter(DisplayList& display_list)
+        : m_display_list(display_list)
+    {
+    }
+
+    void clear_rect(const Rect&, Color);
+    void fill_rect(const Rect&, Color);
+    void fill_rect_with_gradient(Orientation, const Rect&, Color gradient_start, Color gradient_end);
+    void draw_rect(const Rect&, Color, bool rough = false);
+    void set_pixel(const Point&, Color);
+    void draw_line(const Point&, const Point&, Color, int thickness = 1, bool dotted = false);
+    void draw_scaled_bitmap(const Rect& dst_rect, const Bitmap&, const Rect& src_rect);
+    void blit(const Point&, const Bitmap&, const Rect& src_rect, float opacity = 1.0f);
+    void draw_text(const Rect&, const StringView&, const Font&, TextAlignment = TextAlignment::TopLeft, Color = Color::Black, TextElision = TextElision::None);
+    void draw_text(const Rect&, const StringView&, TextAlignment = TextAlignment::TopLeft, Color = Color::Black, TextElision = TextElision::None);
+
+    void translate(int dx, int dy);
+    void translate(const Point& delta) { translate(delta.x(), delta.y()); }
+    void add_clip_rect(const Rect&);
+    void clear_clip_rect();
+    void save();
+    void restore();
+
+    DisplayList& display_list() { return m_display_list; }
+
+private:
+    DisplayList& m_display_list;
+};
+
+}
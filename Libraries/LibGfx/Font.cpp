@@ -28,6 +28,7 @@
 #include "Bitmap.h"
 #include "Emoji.h"
 #include <AK/BufferStream.h>
+#include <AK/HashMap.h>
 #include <AK/MappedFile.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Utf8View.h>
@@ -171,8 +172,26 @@ RefPtr<Font> Font::load_from_memory(const u8* data)
     return adopt(*new Font(String(header.name), rows, widths, !header.is_variable_width, header.glyph_width, header.glyph_height, header.glyph_spacing));
 }
 
+// One Font instance per path per process. The glyph data itself lives in
+// the mmap()ed .font file, whose pages the kernel already shares between
+// every process mapping it, so caching here removes the last per-process
+// duplication: redundant Font objects and mappings of the same path.
+// Callers that want to mutate a font (FontEditor) clone() theirs first.
+static HashMap<String, RefPtr<Font>>& font_cache()
+{
+    static HashMap<String, RefPtr<Font>>* s_cache;
+    if (!s_cache)
+        s_cache = new HashMap<String, RefPtr<Font>>;
+    return *s_cache;
+}
+
 RefPtr<Font> Font::load_from_file(const StringView& path)
 {
+    String key(path);
+    auto it = font_cache().find(key);
+    if (it != font_cache().end())
+        return it->value;
+
     MappedFile mapped_file(path);
     if (!mapped_file.is_valid())
         return nullptr;
@@ -182,9 +201,38 @@ RefPtr<Font> Font::load_from_file(const StringView& path)
         return nullptr;
 
     font->m_mapped_file = move(mapped_file);
+    font_cache().set(key, font);
     return font;
 }
 
+Optional<Font::FileMetadata> Font::load_metadata_from_file(const StringView& path)
+{
+    // Only read the fixed-size header; unlike load_from_file() this doesn't
+    // map the glyph data or construct a Font, so it's suitable for scanning
+    // a whole directory of fonts just to learn their names.
+    int fd = open_with_path_length(path.characters_without_null_termination(), path.length(), O_RDONLY, 0);
+    if (fd < 0)
+        return {};
+
+    FontFileHeader header;
+    ssize_t nread = read(fd, &header, sizeof(header));
+    close(fd);
+    if (nread != sizeof(header))
+        return {};
+
+    if (memcmp(header.magic, "!Fnt", 4))
+        return {};
+    if (header.name[63] != '\0')
+        return {};
+
+    FileMetadata metadata;
+    metadata.name = header.name;
+    metadata.glyph_width = header.glyph_width;
+    metadata.glyph_height = header.glyph_height;
+    metadata.is_fixed_width = !header.is_variable_width;
+    return metadata;
+}
+
 bool Font::write_to_file(const StringView& path)
 {
     int fd = creat_with_path_length(path.characters_without_null_termination(), path.length(), 0644);
@@ -217,6 +265,9 @@ bool Font::write_to_file(const StringView& path)
     ASSERT(nwritten == (ssize_t)buffer.size());
     int rc = close(fd);
     ASSERT(rc == 0);
+
+    // The file changed under any cached mapping of this path.
+    font_cache().remove(String(path));
     return true;
 }
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <AK/MappedFile.h>
+#include <AK/Optional.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/String.h>
@@ -82,6 +83,17 @@ public:
     static RefPtr<Font> load_from_file(const StringView& path);
     bool write_to_file(const StringView& path);
 
+    // Everything the font file header tells us about a face, without
+    // mapping or parsing the glyph data. Cheap enough to call for every
+    // file in /res/fonts when enumerating.
+    struct FileMetadata {
+        String name;
+        u8 glyph_width { 0 };
+        u8 glyph_height { 0 };
+        bool is_fixed_width { false };
+    };
+    static Optional<FileMetadata> load_metadata_from_file(const StringView& path);
+
     ~Font();
 
     GlyphBitmap glyph_bitmap(char ch) const { return GlyphBitmap(&m_rows[(u8)ch * m_glyph_height], { glyph_width(ch), m_glyph_height }); }
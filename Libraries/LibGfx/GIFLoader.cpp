@@ -30,6 +30,7 @@
 #include <AK/MappedFile.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <LibGfx/GIFLoader.h>
+#include <LibGfx/Painter.h>
 #include <LibM/math.h>
 #include <stdio.h>
 #include <string.h>
@@ -38,6 +39,13 @@ namespace Gfx {
 
 static bool load_gif_impl(GIFLoadingContext&);
 
+struct AnimationFrame {
+    RefPtr<Gfx::Bitmap> bitmap;
+    Rect rect;
+    u8 disposal_method { 0 };
+    int duration { 0 }; // in milliseconds
+};
+
 struct GIFLoadingContext {
     enum State {
         NotDecoded = 0,
@@ -50,7 +58,14 @@ struct GIFLoadingContext {
     size_t data_size { 0 };
     int width { -1 };
     int height { -1 };
-    Vector<RefPtr<Gfx::Bitmap>> frames {};
+    Vector<AnimationFrame> frames {};
+
+    // Animation playback: the canvas holds the composited logical screen
+    // with the first `frames_composited` frames applied. The snapshot is
+    // kept around for the "restore to previous" disposal method.
+    RefPtr<Gfx::Bitmap> canvas;
+    RefPtr<Gfx::Bitmap> canvas_snapshot;
+    size_t frames_composited { 0 };
 };
 
 RefPtr<Gfx::Bitmap> load_gif(const StringView& path)
@@ -100,6 +115,11 @@ struct ImageDescriptor {
     RGB color_map[256];
     u8 lzw_min_code_size;
     Vector<u8> lzw_encoded_bytes;
+
+    // From the preceding Graphic Control Extension, if any.
+    u8 disposal_method { 0 };
+    int duration { 0 }; // in milliseconds
+    int transparent_color_index { -1 };
 };
 
 Optional<GIFFormat> decode_gif_header(BufferStream& stream)
@@ -316,6 +336,10 @@ bool load_gif_impl(GIFLoadingContext& context)
 
     NonnullOwnPtrVector<ImageDescriptor> images;
 
+    u8 pending_disposal_method = 0;
+    int pending_duration = 0;
+    int pending_transparent_color_index = -1;
+
     for (;;) {
         u8 sentinel = 0;
         stream >> sentinel;
@@ -330,6 +354,7 @@ bool load_gif_impl(GIFLoadingContext& context)
             printf("Extension block of type %02x\n", extension_type);
 
             u8 sub_block_length = 0;
+            Vector<u8> sub_block;
 
             for (;;) {
                 stream >> sub_block_length;
@@ -340,13 +365,24 @@ bool load_gif_impl(GIFLoadingContext& context)
                 if (sub_block_length == 0)
                     break;
 
-                u8 dummy;
-                for (u16 i = 0; i < sub_block_length; ++i)
-                    stream >> dummy;
+                u8 byte;
+                for (u16 i = 0; i < sub_block_length; ++i) {
+                    stream >> byte;
+                    if (extension_type == 0xf9)
+                        sub_block.append(byte);
+                }
 
                 if (stream.handle_read_failure())
                     return false;
             }
+
+            // Graphic Control Extension: disposal method, frame delay and
+            // transparency for the next image descriptor.
+            if (extension_type == 0xf9 && sub_block.size() >= 4) {
+                pending_disposal_method = (sub_block[0] >> 2) & 7;
+                pending_duration = (sub_block[1] | (sub_block[2] << 8)) * 10;
+                pending_transparent_color_index = (sub_block[0] & 1) ? sub_block[3] : -1;
+            }
             continue;
         }
 
@@ -363,6 +399,25 @@ bool load_gif_impl(GIFLoadingContext& context)
                 return false;
             printf("Image descriptor: %d,%d %dx%d, %02x\n", image.x, image.y, image.width, image.height, packed_fields);
 
+            image.disposal_method = pending_disposal_method;
+            image.duration = pending_duration;
+            image.transparent_color_index = pending_transparent_color_index;
+            pending_disposal_method = 0;
+            pending_duration = 0;
+            pending_transparent_color_index = -1;
+
+            image.use_global_color_map = !(packed_fields & 0x80);
+            if (!image.use_global_color_map) {
+                int local_map_entry_count = 2 << (packed_fields & 7);
+                for (int i = 0; i < local_map_entry_count; ++i) {
+                    stream >> image.color_map[i].r;
+                    stream >> image.color_map[i].g;
+                    stream >> image.color_map[i].b;
+                }
+                if (stream.handle_read_failure())
+                    return false;
+            }
+
             stream >> image.lzw_min_code_size;
 
             printf("min code size: %u\n", image.lzw_min_code_size);
@@ -417,6 +472,11 @@ bool load_gif_impl(GIFLoadingContext& context)
         const int end_of_information_code = decoder.add_control_code();
 
         auto bitmap = Bitmap::create_purgeable(BitmapFormat::RGBA32, { image.width, image.height });
+        if (!bitmap)
+            return false;
+
+        const auto* color_map = image.use_global_color_map ? logical_screen.color_map : image.color_map;
+        const int max_pixel_index = image.width * image.height;
 
         int pixel_index = 0;
         while (true) {
@@ -436,21 +496,27 @@ bool load_gif_impl(GIFLoadingContext& context)
             auto colors = decoder.get_output();
 
             for (const auto& color : colors) {
-                auto rgb = logical_screen.color_map[color];
+                if (pixel_index >= max_pixel_index)
+                    break;
 
                 int x = pixel_index % image.width;
                 int y = pixel_index / image.width;
 
+                if (color == image.transparent_color_index) {
+                    // Leave the pixel fully transparent so the composited
+                    // canvas shows through.
+                    ++pixel_index;
+                    continue;
+                }
+
+                auto rgb = color_map[color];
                 Color c = Color(rgb.r, rgb.g, rgb.b);
                 bitmap->set_pixel(x, y, c);
                 ++pixel_index;
             }
         }
 
-        context.frames.append(bitmap);
-
-        // FIXME: for now only decode the first frame.
-        break;
+        context.frames.append({ bitmap, { image.x, image.y, image.width, image.height }, image.disposal_method, image.duration });
     }
 
     context.state = GIFLoadingContext::State::BitmapDecoded;
@@ -482,30 +548,118 @@ Size GIFImageDecoderPlugin::size()
     return { m_context->width, m_context->height };
 }
 
+// Composites the next animation frame onto the canvas and returns the
+// rect that changed: the frame's own rect plus whatever the previous
+// frame's disposal method touched.
+static Rect composite_next_animation_frame(GIFLoadingContext& context)
+{
+    size_t index = context.frames_composited;
+    auto& frame = context.frames[index];
+    Painter painter(*context.canvas);
+    Rect dirty_rect = frame.rect;
+
+    if (index == 0) {
+        painter.clear_rect(context.canvas->rect(), Color());
+        dirty_rect = context.canvas->rect();
+    } else {
+        auto& previous_frame = context.frames[index - 1];
+        if (previous_frame.disposal_method == 2) {
+            // Restore to background: modern decoders treat this as
+            // clearing the frame's rect to transparent.
+            painter.clear_rect(previous_frame.rect.intersected(context.canvas->rect()), Color());
+            dirty_rect = dirty_rect.united(previous_frame.rect);
+        } else if (previous_frame.disposal_method == 3 && context.canvas_snapshot) {
+            // Restore to previous: revert to the canvas as it was before
+            // the previous frame was drawn.
+            for (int y = 0; y < context.canvas->height(); ++y)
+                memcpy(context.canvas->scanline(y), context.canvas_snapshot->scanline(y), context.canvas->width() * sizeof(RGBA32));
+            dirty_rect = dirty_rect.united(previous_frame.rect);
+        }
+    }
+
+    if (frame.disposal_method == 3) {
+        if (!context.canvas_snapshot)
+            context.canvas_snapshot = Bitmap::create(BitmapFormat::RGBA32, { context.canvas->width(), context.canvas->height() });
+        if (context.canvas_snapshot) {
+            for (int y = 0; y < context.canvas->height(); ++y)
+                memcpy(context.canvas_snapshot->scanline(y), context.canvas->scanline(y), context.canvas->width() * sizeof(RGBA32));
+        }
+    }
+
+    painter.blit_with_alpha(frame.rect.location(), *frame.bitmap, frame.bitmap->rect());
+    ++context.frames_composited;
+    return dirty_rect.intersected(context.canvas->rect());
+}
+
 RefPtr<Gfx::Bitmap> GIFImageDecoderPlugin::bitmap()
 {
-    if (m_context->state == GIFLoadingContext::State::Error) {
-        return nullptr;
+    return frame(0).image;
+}
+
+bool GIFImageDecoderPlugin::is_animated()
+{
+    if (m_context->state == GIFLoadingContext::State::Error)
+        return false;
+
+    if (m_context->state < GIFLoadingContext::State::BitmapDecoded) {
+        if (!load_gif_impl(*m_context)) {
+            m_context->state = GIFLoadingContext::State::Error;
+            return false;
+        }
     }
 
+    return m_context->frames.size() > 1;
+}
+
+size_t GIFImageDecoderPlugin::frame_count()
+{
+    if (!is_animated())
+        return 1;
+    return m_context->frames.size();
+}
+
+ImageFrameDescriptor GIFImageDecoderPlugin::frame(size_t index)
+{
+    if (m_context->state == GIFLoadingContext::State::Error)
+        return {};
+
     if (m_context->state < GIFLoadingContext::State::BitmapDecoded) {
         if (!load_gif_impl(*m_context)) {
             m_context->state = GIFLoadingContext::State::Error;
-            return nullptr;
+            return {};
         }
     }
 
-    // FIXME: for now only return the first frame.
-    if (m_context->frames.is_empty()) {
-        return nullptr;
+    if (m_context->frames.is_empty())
+        return {};
+
+    index %= m_context->frames.size();
+
+    if (!m_context->canvas) {
+        m_context->canvas = Bitmap::create(BitmapFormat::RGBA32, { m_context->width, m_context->height });
+        if (!m_context->canvas)
+            return {};
     }
-    return m_context->frames.first();
+
+    Rect dirty_rect;
+    if (m_context->frames_composited != index + 1) {
+        // Seeking backwards (or looping around) restarts compositing from
+        // the first frame.
+        if (m_context->frames_composited > index + 1)
+            m_context->frames_composited = 0;
+        while (m_context->frames_composited < index + 1)
+            dirty_rect = dirty_rect.united(composite_next_animation_frame(*m_context));
+    }
+
+    // The returned bitmap is the live canvas: it stays valid until the
+    // next call to frame().
+    return { m_context->canvas, m_context->frames[index].duration, dirty_rect };
 }
 
 void GIFImageDecoderPlugin::set_volatile()
 {
     for (auto& frame : m_context->frames) {
-        frame->set_volatile();
+        frame.bitmap->set_volatile();
     }
 }
 
@@ -517,7 +671,7 @@ bool GIFImageDecoderPlugin::set_nonvolatile()
 
     bool success = true;
     for (auto& frame : m_context->frames) {
-        success &= frame->set_nonvolatile();
+        success &= frame.bitmap->set_nonvolatile();
     }
     return success;
 }
@@ -52,4 +52,14 @@ RefPtr<Gfx::Bitmap> ImageDecoder::bitmap() const
     return m_plugin->bitmap();
 }
 
+ImageFrameDescriptor ImageDecoderPlugin::frame(size_t)
+{
+    // Single-frame plugins: the whole image is one frame.
+    auto image = bitmap();
+    if (!image)
+        return {};
+    auto rect = image->rect();
+    return { move(image), 0, rect };
+}
+
 }
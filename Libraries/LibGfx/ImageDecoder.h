@@ -26,15 +26,28 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <LibGfx/Rect.h>
 #include <LibGfx/Size.h>
 
 namespace Gfx {
 
 class Bitmap;
 
+// One displayable frame of an (possibly animated) image: the fully
+// composited bitmap, how long it should stay on screen, and which part
+// of it changed relative to the previously requested frame so callers
+// can invalidate only that region.
+struct ImageFrameDescriptor {
+    RefPtr<Bitmap> image;
+    int duration { 0 }; // in milliseconds
+    Rect dirty_rect;
+};
+
 class ImageDecoderPlugin {
 public:
     virtual ~ImageDecoderPlugin() {}
@@ -47,6 +60,16 @@ public:
 
     virtual bool sniff() = 0;
 
+    virtual bool is_animated() { return false; }
+    virtual size_t frame_count() { return 1; }
+    virtual ImageFrameDescriptor frame(size_t index);
+
+    // Invoked from within bitmap() as (rows_decoded, total_rows) each time
+    // another batch of scanlines has landed in the bitmap, so callers can
+    // paint partial images while a large one decodes. Plugins that decode
+    // all-or-nothing may ignore this.
+    virtual void set_progress_callback(Function<void(int, int)>) {}
+
 protected:
     ImageDecoderPlugin() {}
 };
@@ -63,6 +86,10 @@ public:
     void set_volatile() { m_plugin->set_volatile(); }
     [[nodiscard]] bool set_nonvolatile() { return m_plugin->set_nonvolatile(); }
     bool sniff() { return m_plugin->sniff(); };
+    void set_progress_callback(Function<void(int, int)> callback) { m_plugin->set_progress_callback(move(callback)); }
+    bool is_animated() const { return m_plugin->is_animated(); }
+    size_t frame_count() const { return m_plugin->frame_count(); }
+    ImageFrameDescriptor frame(size_t index) const { return m_plugin->frame(index); }
 
 private:
     ImageDecoder(const u8*, size_t);
@@ -26,6 +26,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/FileSystemPath.h>
+#include <AK/Function.h>
 #include <AK/MappedFile.h>
 #include <AK/NetworkOrdered.h>
 #include <LibCore/puff.h>
@@ -131,6 +132,7 @@ struct PNGLoadingContext {
     Vector<u8> compressed_data;
     Vector<PaletteEntry> palette_data;
     Vector<u8> palette_transparency_data;
+    Function<void(int, int)> on_progress;
 };
 
 class Streamer {
@@ -313,13 +315,12 @@ ALWAYS_INLINE static void unfilter_impl(Gfx::Bitmap& bitmap, int y, const void*
     }
 }
 
-NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
+NEVER_INLINE FLATTEN static void unpack_scanlines_to_rgba(PNGLoadingContext& context, int first_row, int last_row)
 {
-    // First unpack the scanlines to RGBA:
     switch (context.color_type) {
     case 0:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* gray_values = (u8*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -330,7 +331,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
                 }
             }
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* gray_values = (u16*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -343,7 +344,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* gray_values = (u8*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
@@ -361,7 +362,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
         break;
     case 4:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* tuples = (Tuple*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -372,7 +373,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
                 }
             }
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* tuples = (Tuple16*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -388,7 +389,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
         break;
     case 2:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* triplets = (Triplet*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -399,7 +400,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
                 }
             }
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* triplets = (Triplet16*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -415,11 +416,11 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
         break;
     case 6:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
             }
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* triplets = (Quad16*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -435,7 +436,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
         break;
     case 3:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* palette_index = (u8*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
@@ -452,7 +453,7 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
+            for (int y = first_row; y <= last_row; ++y) {
                 auto* palette_indexes = (u8*)context.scanlines[y].data.data();
                 for (int i = 0; i < context.width; ++i) {
                     auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
@@ -476,49 +477,84 @@ NEVER_INLINE FLATTEN static void unfilter(PNGLoadingContext& context)
         ASSERT_NOT_REACHED();
         break;
     }
+}
 
-    auto dummy_scanline = ByteBuffer::create_zeroed(context.width * sizeof(RGBA32));
-
-    for (int y = 0; y < context.height; ++y) {
+NEVER_INLINE FLATTEN static void unfilter_scanlines(PNGLoadingContext& context, int first_row, int last_row, const void* dummy_scanline_data)
+{
+    for (int y = first_row; y <= last_row; ++y) {
         auto filter = context.scanlines[y].filter;
         if (filter == 0) {
             if (context.has_alpha())
-                unfilter_impl<true, 0>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<true, 0>(*context.bitmap, y, dummy_scanline_data);
             else
-                unfilter_impl<false, 0>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<false, 0>(*context.bitmap, y, dummy_scanline_data);
             continue;
         }
         if (filter == 1) {
             if (context.has_alpha())
-                unfilter_impl<true, 1>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<true, 1>(*context.bitmap, y, dummy_scanline_data);
             else
-                unfilter_impl<false, 1>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<false, 1>(*context.bitmap, y, dummy_scanline_data);
             continue;
         }
         if (filter == 2) {
             if (context.has_alpha())
-                unfilter_impl<true, 2>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<true, 2>(*context.bitmap, y, dummy_scanline_data);
             else
-                unfilter_impl<false, 2>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<false, 2>(*context.bitmap, y, dummy_scanline_data);
             continue;
         }
         if (filter == 3) {
             if (context.has_alpha())
-                unfilter_impl<true, 3>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<true, 3>(*context.bitmap, y, dummy_scanline_data);
             else
-                unfilter_impl<false, 3>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<false, 3>(*context.bitmap, y, dummy_scanline_data);
             continue;
         }
         if (filter == 4) {
             if (context.has_alpha())
-                unfilter_impl<true, 4>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<true, 4>(*context.bitmap, y, dummy_scanline_data);
             else
-                unfilter_impl<false, 4>(*context.bitmap, y, dummy_scanline.data());
+                unfilter_impl<false, 4>(*context.bitmap, y, dummy_scanline_data);
             continue;
         }
     }
 }
 
+// The bitmap we emit is RGBA32Premultiplied, so Painter's compositing inner
+// loops never have to divide; PNG carries straight alpha, so convert here,
+// once, at decode time.
+static void premultiply_scanlines(PNGLoadingContext& context, int first_row, int last_row)
+{
+    for (int y = first_row; y <= last_row; ++y) {
+        auto* pixels = context.bitmap->scanline(y);
+        for (int i = 0; i < context.width; ++i)
+            pixels[i] = Color::from_rgba(pixels[i]).premultiplied().value();
+    }
+}
+
+NEVER_INLINE static void unfilter(PNGLoadingContext& context)
+{
+    auto dummy_scanline = ByteBuffer::create_zeroed(context.width * sizeof(RGBA32));
+
+    // Decode in batches of rows instead of making two whole-image passes:
+    // a batch is still cache-hot from unpacking when we unfilter it, and
+    // each completed batch is reported through on_progress so callers can
+    // paint partial images while a large one decodes. A scanline only ever
+    // depends on the one above it (filters 2-4), so batches could also be
+    // farmed out to worker threads by splitting at rows with filter 0 or 1.
+    const int batch_size = 64;
+    for (int first_row = 0; first_row < context.height; first_row += batch_size) {
+        int last_row = min(first_row + batch_size, context.height) - 1;
+        unpack_scanlines_to_rgba(context, first_row, last_row);
+        unfilter_scanlines(context, first_row, last_row, dummy_scanline.data());
+        if (context.has_alpha())
+            premultiply_scanlines(context, first_row, last_row);
+        if (context.on_progress)
+            context.on_progress(last_row + 1, context.height);
+    }
+}
+
 static bool decode_png_header(PNGLoadingContext& context)
 {
     if (context.state >= PNGLoadingContext::HeaderDecoded)
@@ -632,7 +668,7 @@ static bool decode_png_bitmap(PNGLoadingContext& context)
         }
     }
 
-    context.bitmap = Bitmap::create_purgeable(context.has_alpha() ? BitmapFormat::RGBA32 : BitmapFormat::RGB32, { context.width, context.height });
+    context.bitmap = Bitmap::create_purgeable(context.has_alpha() ? BitmapFormat::RGBA32Premultiplied : BitmapFormat::RGB32, { context.width, context.height });
 
     unfilter(context);
 
@@ -829,6 +865,11 @@ bool PNGImageDecoderPlugin::set_nonvolatile()
     return m_context->bitmap->set_nonvolatile();
 }
 
+void PNGImageDecoderPlugin::set_progress_callback(Function<void(int, int)> callback)
+{
+    m_context->on_progress = move(callback);
+}
+
 bool PNGImageDecoderPlugin::sniff()
 {
     return decode_png_header(*m_context);
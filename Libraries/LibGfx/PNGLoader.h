@@ -46,6 +46,7 @@ public:
     virtual void set_volatile() override;
     [[nodiscard]] virtual bool set_nonvolatile() override;
     virtual bool sniff() override;
+    virtual void set_progress_callback(Function<void(int, int)>) override;
 
 private:
     OwnPtr<PNGLoadingContext> m_context;
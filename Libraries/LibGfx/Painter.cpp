@@ -30,7 +30,9 @@
 #include "Font.h"
 #include <AK/Assertions.h>
 #include <AK/Function.h>
+#include <AK/HashFunctions.h>
 #include <AK/Memory.h>
+#include <AK/QuickSort.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
@@ -40,12 +42,278 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#if defined(__i386__) || defined(__x86_64__)
+#    include <cpuid.h>
+#    include <emmintrin.h>
+#endif
+
 #if defined(__GNUC__) && !defined(__clang__)
 #    pragma GCC optimize("O3")
 #endif
 
 namespace Gfx {
 
+// ---------------------------------------------------------------------------
+// Span engine
+//
+// The fill/blit hot loops funnel into these kernels, each of which
+// composites a whole scanline span with no per-pixel calls. A kernel is
+// picked once per fill/blit call, outside the scanline loop; on x86 with
+// SSE2 we use vector versions that process four pixels per step.
+//
+// All kernels assume an opaque destination (the alpha byte of the target is
+// ignored and written as 0xff), which is exactly the WindowServer
+// compositing case; callers with an alpha-carrying target keep the generic
+// Color::blend() path. Channel math is floor((src * a + dst * (255 - a)) /
+// 255), matching Color::blend() against an opaque destination bit for bit.
+// ---------------------------------------------------------------------------
+
+static bool can_use_sse2()
+{
+#if defined(__x86_64__)
+    return true;
+#elif defined(__i386__)
+    static int s_has_sse2 = -1;
+    if (s_has_sse2 < 0) {
+        u32 eax, ebx, ecx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            s_has_sse2 = (edx >> 26) & 1;
+        else
+            s_has_sse2 = 0;
+    }
+    return s_has_sse2;
+#else
+    return false;
+#endif
+}
+
+static ALWAYS_INLINE RGBA32 blend_pixel_opaque_dst(RGBA32 dst, RGBA32 src, unsigned alpha)
+{
+    unsigned inverse_alpha = 255 - alpha;
+    unsigned r = (((src >> 16) & 0xff) * alpha + ((dst >> 16) & 0xff) * inverse_alpha) / 255;
+    unsigned g = (((src >> 8) & 0xff) * alpha + ((dst >> 8) & 0xff) * inverse_alpha) / 255;
+    unsigned b = ((src & 0xff) * alpha + (dst & 0xff) * inverse_alpha) / 255;
+    return 0xff000000 | (r << 16) | (g << 8) | b;
+}
+
+// For premultiplied sources the source channels already carry their alpha
+// factor, so the blend is a pure multiply-add: dst = src + dst * (255 - a).
+static ALWAYS_INLINE RGBA32 blend_pixel_premultiplied_opaque_dst(RGBA32 dst, RGBA32 src, unsigned alpha)
+{
+    unsigned inverse_alpha = 255 - alpha;
+    unsigned r = ((src >> 16) & 0xff) + ((dst >> 16) & 0xff) * inverse_alpha / 255;
+    unsigned g = ((src >> 8) & 0xff) + ((dst >> 8) & 0xff) * inverse_alpha / 255;
+    unsigned b = (src & 0xff) + (dst & 0xff) * inverse_alpha / 255;
+    return 0xff000000 | (r << 16) | (g << 8) | b;
+}
+
+typedef void (*FillSpanKernel)(RGBA32* dst, size_t count, RGBA32 color, unsigned alpha);
+typedef void (*BlitSpanKernel)(RGBA32* dst, const RGBA32* src, size_t count, unsigned alpha);
+
+static void fill_span_blended(RGBA32* dst, size_t count, RGBA32 color, unsigned alpha)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = blend_pixel_opaque_dst(dst[i], color, alpha);
+}
+
+static void blit_span_constant_alpha(RGBA32* dst, const RGBA32* src, size_t count, unsigned alpha)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = blend_pixel_opaque_dst(dst[i], src[i], alpha);
+}
+
+static void blit_span_per_pixel_alpha(RGBA32* dst, const RGBA32* src, size_t count, unsigned)
+{
+    for (size_t i = 0; i < count; ++i) {
+        unsigned alpha = src[i] >> 24;
+        if (alpha == 0xff)
+            dst[i] = src[i];
+        else if (alpha)
+            dst[i] = blend_pixel_opaque_dst(dst[i], src[i], alpha);
+    }
+}
+
+static void blit_span_per_pixel_alpha_premultiplied(RGBA32* dst, const RGBA32* src, size_t count, unsigned)
+{
+    for (size_t i = 0; i < count; ++i) {
+        unsigned alpha = src[i] >> 24;
+        if (alpha == 0xff)
+            dst[i] = src[i];
+        else if (alpha)
+            dst[i] = blend_pixel_premultiplied_opaque_dst(dst[i], src[i], alpha);
+    }
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+
+// Exact floor(x / 255) on each 16-bit lane: (x * 0x8081) >> 23.
+__attribute__((target("sse2"))) static ALWAYS_INLINE __m128i div255_epu16(__m128i value)
+{
+    return _mm_srli_epi16(_mm_mulhi_epu16(value, _mm_set1_epi16((short)0x8081)), 7);
+}
+
+__attribute__((target("sse2"))) static ALWAYS_INLINE __m128i blend_quad_opaque_dst(__m128i dst, __m128i src, __m128i alpha_lo, __m128i alpha_hi)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i all_255 = _mm_set1_epi16(255);
+    __m128i src_lo = _mm_unpacklo_epi8(src, zero);
+    __m128i src_hi = _mm_unpackhi_epi8(src, zero);
+    __m128i dst_lo = _mm_unpacklo_epi8(dst, zero);
+    __m128i dst_hi = _mm_unpackhi_epi8(dst, zero);
+    __m128i blended_lo = div255_epu16(_mm_add_epi16(
+        _mm_mullo_epi16(src_lo, alpha_lo),
+        _mm_mullo_epi16(dst_lo, _mm_sub_epi16(all_255, alpha_lo))));
+    __m128i blended_hi = div255_epu16(_mm_add_epi16(
+        _mm_mullo_epi16(src_hi, alpha_hi),
+        _mm_mullo_epi16(dst_hi, _mm_sub_epi16(all_255, alpha_hi))));
+    return _mm_or_si128(_mm_packus_epi16(blended_lo, blended_hi), _mm_set1_epi32(0xff000000));
+}
+
+__attribute__((target("sse2"))) static void fill_span_blended_sse2(RGBA32* dst, size_t count, RGBA32 color, unsigned alpha)
+{
+    __m128i color_quad = _mm_set1_epi32(color);
+    __m128i alpha_16 = _mm_set1_epi16(alpha);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        _mm_storeu_si128((__m128i*)(dst + i), blend_quad_opaque_dst(d, color_quad, alpha_16, alpha_16));
+    }
+    for (; i < count; ++i)
+        dst[i] = blend_pixel_opaque_dst(dst[i], color, alpha);
+}
+
+__attribute__((target("sse2"))) static void blit_span_constant_alpha_sse2(RGBA32* dst, const RGBA32* src, size_t count, unsigned alpha)
+{
+    __m128i alpha_16 = _mm_set1_epi16(alpha);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        _mm_storeu_si128((__m128i*)(dst + i), blend_quad_opaque_dst(d, s, alpha_16, alpha_16));
+    }
+    for (; i < count; ++i)
+        dst[i] = blend_pixel_opaque_dst(dst[i], src[i], alpha);
+}
+
+__attribute__((target("sse2"))) static void blit_span_per_pixel_alpha_sse2(RGBA32* dst, const RGBA32* src, size_t count, unsigned)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i alpha_bytes = _mm_and_si128(s, alpha_mask);
+        // Whole groups of opaque or transparent pixels skip the blend.
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(alpha_bytes, alpha_mask)) == 0xffff) {
+            _mm_storeu_si128((__m128i*)(dst + i), s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(alpha_bytes, zero)) == 0xffff)
+            continue;
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        // Broadcast each pixel's alpha across its four 16-bit lanes.
+        __m128i src_lo = _mm_unpacklo_epi8(s, zero);
+        __m128i src_hi = _mm_unpackhi_epi8(s, zero);
+        __m128i alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_lo, 0xff), 0xff);
+        __m128i alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_hi, 0xff), 0xff);
+        __m128i blended = blend_quad_opaque_dst(d, s, alpha_lo, alpha_hi);
+        // Transparent pixels within the group leave dst untouched, like the
+        // scalar kernel.
+        __m128i transparent = _mm_cmpeq_epi32(alpha_bytes, zero);
+        blended = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, blended));
+        _mm_storeu_si128((__m128i*)(dst + i), blended);
+    }
+    for (; i < count; ++i) {
+        unsigned alpha = src[i] >> 24;
+        if (alpha == 0xff)
+            dst[i] = src[i];
+        else if (alpha)
+            dst[i] = blend_pixel_opaque_dst(dst[i], src[i], alpha);
+    }
+}
+
+__attribute__((target("sse2"))) static void blit_span_per_pixel_alpha_premultiplied_sse2(RGBA32* dst, const RGBA32* src, size_t count, unsigned)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i all_255 = _mm_set1_epi16(255);
+    __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i alpha_bytes = _mm_and_si128(s, alpha_mask);
+        // Whole groups of opaque or transparent pixels skip the blend.
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(alpha_bytes, alpha_mask)) == 0xffff) {
+            _mm_storeu_si128((__m128i*)(dst + i), s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(alpha_bytes, zero)) == 0xffff)
+            continue;
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i src_lo = _mm_unpacklo_epi8(s, zero);
+        __m128i src_hi = _mm_unpackhi_epi8(s, zero);
+        __m128i dst_lo = _mm_unpacklo_epi8(d, zero);
+        __m128i dst_hi = _mm_unpackhi_epi8(d, zero);
+        // Broadcast each pixel's alpha across its four 16-bit lanes.
+        __m128i alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_lo, 0xff), 0xff);
+        __m128i alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_hi, 0xff), 0xff);
+        // dst = src + dst * (255 - alpha) / 255; no per-channel alpha multiply
+        // on the source, since its channels are already premultiplied.
+        __m128i blended_lo = _mm_add_epi16(src_lo, div255_epu16(_mm_mullo_epi16(dst_lo, _mm_sub_epi16(all_255, alpha_lo))));
+        __m128i blended_hi = _mm_add_epi16(src_hi, div255_epu16(_mm_mullo_epi16(dst_hi, _mm_sub_epi16(all_255, alpha_hi))));
+        __m128i blended = _mm_or_si128(_mm_packus_epi16(blended_lo, blended_hi), alpha_mask);
+        // Transparent pixels within the group leave dst untouched, like the
+        // scalar kernel.
+        __m128i transparent = _mm_cmpeq_epi32(alpha_bytes, zero);
+        blended = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, blended));
+        _mm_storeu_si128((__m128i*)(dst + i), blended);
+    }
+    for (; i < count; ++i) {
+        unsigned alpha = src[i] >> 24;
+        if (alpha == 0xff)
+            dst[i] = src[i];
+        else if (alpha)
+            dst[i] = blend_pixel_premultiplied_opaque_dst(dst[i], src[i], alpha);
+    }
+}
+
+#endif
+
+static FillSpanKernel choose_fill_span_blended()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    if (can_use_sse2())
+        return fill_span_blended_sse2;
+#endif
+    return fill_span_blended;
+}
+
+static BlitSpanKernel choose_blit_span_constant_alpha()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    if (can_use_sse2())
+        return blit_span_constant_alpha_sse2;
+#endif
+    return blit_span_constant_alpha;
+}
+
+static BlitSpanKernel choose_blit_span_per_pixel_alpha()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    if (can_use_sse2())
+        return blit_span_per_pixel_alpha_sse2;
+#endif
+    return blit_span_per_pixel_alpha;
+}
+
+static BlitSpanKernel choose_blit_span_per_pixel_alpha_premultiplied()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    if (can_use_sse2())
+        return blit_span_per_pixel_alpha_premultiplied_sse2;
+#endif
+    return blit_span_per_pixel_alpha_premultiplied;
+}
+
 template<BitmapFormat format = BitmapFormat::Invalid>
 ALWAYS_INLINE Color get_pixel(const Gfx::Bitmap& bitmap, int x, int y)
 {
@@ -55,6 +323,10 @@ ALWAYS_INLINE Color get_pixel(const Gfx::Bitmap& bitmap, int x, int y)
         return Color::from_rgb(bitmap.scanline(y)[x]);
     if constexpr (format == BitmapFormat::RGBA32)
         return Color::from_rgba(bitmap.scanline(y)[x]);
+    // The scaled paths blend with straight-alpha math, so hand them an
+    // unpremultiplied color.
+    if constexpr (format == BitmapFormat::RGBA32Premultiplied)
+        return Color::from_rgba(bitmap.scanline(y)[x]).unpremultiplied();
     return bitmap.get_pixel(x, y);
 }
 
@@ -128,6 +400,15 @@ void Painter::fill_rect(const Rect& a_rect, Color color)
     RGBA32* dst = m_target->scanline(rect.top()) + rect.left();
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
 
+    if (!m_target->has_alpha_channel()) {
+        auto fill_span = choose_fill_span_blended();
+        for (int i = rect.height() - 1; i >= 0; --i) {
+            fill_span(dst, rect.width(), color.value(), color.alpha());
+            dst += dst_skip;
+        }
+        return;
+    }
+
     for (int i = rect.height() - 1; i >= 0; --i) {
         for (int j = 0; j < rect.width(); ++j)
             dst[j] = Color::from_rgba(dst[j]).blend(color).value();
@@ -402,16 +683,20 @@ void Painter::blit_scaled(const Rect& dst_rect_raw, const Gfx::Bitmap& source, c
     RGBA32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
 
+    // 16.16 fixed-point stepping; no float math in the per-pixel loop.
+    int hscale_fixed = (int)(hscale * 65536.0f);
+    int vscale_fixed = (int)(vscale * 65536.0f);
+
     int x_start = first_column + src_rect.left();
     for (int row = first_row; row <= last_row; ++row) {
-        int sr = (row + src_rect.top()) * vscale;
+        int sr = ((row + src_rect.top()) * vscale_fixed) >> 16;
         if (sr >= source.size().height() || sr < 0) {
             dst += dst_skip;
             continue;
         }
         const RGBA32* sl = source.scanline(sr);
         for (int x = x_start; x < clipped_rect.width() + x_start; ++x) {
-            int sx = x * hscale;
+            int sx = (x * hscale_fixed) >> 16;
             if (sx < source.size().width() && sx >= 0)
                 dst[x - x_start] = sl[sx];
         }
@@ -430,6 +715,8 @@ void Painter::blit_with_opacity(const Point& position, const Gfx::Bitmap& source
         return blit(position, source, src_rect);
 
     u8 alpha = 255 * opacity;
+    if (!alpha)
+        return;
 
     Rect safe_src_rect = Rect::intersection(src_rect, source.rect());
     Rect dst_rect(position, safe_src_rect.size());
@@ -446,13 +733,27 @@ void Painter::blit_with_opacity(const Point& position, const Gfx::Bitmap& source
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
     const unsigned src_skip = source.pitch() / sizeof(RGBA32);
 
-    for (int row = first_row; row <= last_row; ++row) {
-        for (int x = 0; x <= (last_column - first_column); ++x) {
-            Color src_color_with_alpha = Color::from_rgb(src[x]);
-            src_color_with_alpha.set_alpha(alpha);
-            Color dst_color = Color::from_rgb(dst[x]);
-            dst[x] = dst_color.blend(src_color_with_alpha).value();
+    if (source.has_premultiplied_alpha()) {
+        // Scale both the source channels and its per-pixel alpha by the
+        // constant opacity, then do the usual premultiplied source-over.
+        for (int row = first_row; row <= last_row; ++row) {
+            for (int x = 0; x <= last_column - first_column; ++x) {
+                unsigned src_alpha = (src[x] >> 24) * alpha / 255;
+                unsigned inverse_alpha = 255 - src_alpha;
+                unsigned r = ((src[x] >> 16) & 0xff) * alpha / 255 + ((dst[x] >> 16) & 0xff) * inverse_alpha / 255;
+                unsigned g = ((src[x] >> 8) & 0xff) * alpha / 255 + ((dst[x] >> 8) & 0xff) * inverse_alpha / 255;
+                unsigned b = (src[x] & 0xff) * alpha / 255 + (dst[x] & 0xff) * inverse_alpha / 255;
+                dst[x] = 0xff000000 | (r << 16) | (g << 8) | b;
+            }
+            dst += dst_skip;
+            src += src_skip;
         }
+        return;
+    }
+
+    auto blit_span = choose_blit_span_constant_alpha();
+    for (int row = first_row; row <= last_row; ++row) {
+        blit_span(dst, src, last_column - first_column + 1, alpha);
         dst += dst_skip;
         src += src_skip;
     }
@@ -476,13 +777,17 @@ void Painter::blit_filtered(const Point& position, const Gfx::Bitmap& source, co
 
     for (int row = first_row; row <= last_row; ++row) {
         for (int x = 0; x <= (last_column - first_column); ++x) {
-            u8 alpha = Color::from_rgba(src[x]).alpha();
+            auto src_color = Color::from_rgba(src[x]);
+            // Filters operate on straight-alpha colors.
+            if (source.has_premultiplied_alpha())
+                src_color = src_color.unpremultiplied();
+            u8 alpha = src_color.alpha();
             if (alpha == 0xff)
-                dst[x] = filter(Color::from_rgba(src[x])).value();
+                dst[x] = filter(src_color).value();
             else if (!alpha)
                 continue;
             else
-                dst[x] = Color::from_rgba(dst[x]).blend(filter(Color::from_rgba(src[x]))).value();
+                dst[x] = Color::from_rgba(dst[x]).blend(filter(src_color)).value();
         }
         dst += dst_skip;
         src += src_skip;
@@ -515,7 +820,7 @@ void Painter::draw_tiled_bitmap(const Rect& a_dst_rect, const Gfx::Bitmap& sourc
     RGBA32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
 
-    if (source.format() == BitmapFormat::RGB32 || source.format() == BitmapFormat::RGBA32) {
+    if (source.format() == BitmapFormat::RGB32 || source.format() == BitmapFormat::RGBA32 || source.format() == BitmapFormat::RGBA32Premultiplied) {
         int x_start = first_column + a_dst_rect.left();
         for (int row = first_row; row <= last_row; ++row) {
             const RGBA32* sl = source.scanline((row + a_dst_rect.top())
@@ -546,7 +851,7 @@ void Painter::blit_offset(const Point& position,
     RGBA32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
 
-    if (source.format() == BitmapFormat::RGB32 || source.format() == BitmapFormat::RGBA32) {
+    if (source.format() == BitmapFormat::RGB32 || source.format() == BitmapFormat::RGBA32 || source.format() == BitmapFormat::RGBA32Premultiplied) {
         int x_start = first_column + src_rect.left();
         for (int row = first_row; row <= last_row; ++row) {
             int sr = row - offset.y() + src_rect.top();
@@ -585,6 +890,16 @@ void Painter::blit_with_alpha(const Point& position, const Gfx::Bitmap& source,
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
     const size_t src_skip = source.pitch() / sizeof(RGBA32);
 
+    if (!m_target->has_alpha_channel()) {
+        auto blit_span = source.has_premultiplied_alpha() ? choose_blit_span_per_pixel_alpha_premultiplied() : choose_blit_span_per_pixel_alpha();
+        for (int row = first_row; row <= last_row; ++row) {
+            blit_span(dst, src, last_column - first_column + 1, 0);
+            dst += dst_skip;
+            src += src_skip;
+        }
+        return;
+    }
+
     for (int row = first_row; row <= last_row; ++row) {
         for (int x = 0; x <= (last_column - first_column); ++x) {
             u8 alpha = Color::from_rgba(src[x]).alpha();
@@ -592,6 +907,8 @@ void Painter::blit_with_alpha(const Point& position, const Gfx::Bitmap& source,
                 dst[x] = src[x];
             else if (!alpha)
                 continue;
+            else if (source.has_premultiplied_alpha())
+                dst[x] = Color::from_rgba(dst[x]).blend_premultiplied(Color::from_rgba(src[x])).value();
             else
                 dst[x] = Color::from_rgba(dst[x]).blend(Color::from_rgba(src[x])).value();
         }
@@ -618,7 +935,7 @@ void Painter::blit(const Point& position, const Gfx::Bitmap& source, const Rect&
     RGBA32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
 
-    if (source.format() == BitmapFormat::RGB32 || source.format() == BitmapFormat::RGBA32) {
+    if (source.format() == BitmapFormat::RGB32 || source.format() == BitmapFormat::RGBA32 || source.format() == BitmapFormat::RGBA32Premultiplied) {
         const RGBA32* src = source.scanline(src_rect.top() + first_row) + src_rect.left() + first_column;
         const size_t src_skip = source.pitch() / sizeof(RGBA32);
         for (int row = first_row; row <= last_row; ++row) {
@@ -665,9 +982,82 @@ ALWAYS_INLINE static void do_draw_integer_scaled_bitmap(Gfx::Bitmap& target, con
     }
 }
 
+// Linear interpolation between two pixels with an 8-bit mix factor,
+// per channel in 16.16-friendly integer math. mix == 0 gives a,
+// mix == 255 gives (nearly) b.
+ALWAYS_INLINE static Color interpolate_pixels(const Color& a, const Color& b, u8 mix)
+{
+    return Color(
+        a.red() + (((b.red() - a.red()) * mix) >> 8),
+        a.green() + (((b.green() - a.green()) * mix) >> 8),
+        a.blue() + (((b.blue() - a.blue()) * mix) >> 8),
+        a.alpha() + (((b.alpha() - a.alpha()) * mix) >> 8));
+}
+
 template<bool has_alpha_channel, typename GetPixel>
-ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, const Rect& dst_rect, const Rect& clipped_rect, const Gfx::Bitmap& source, const Rect& src_rect, int hscale, int vscale, GetPixel get_pixel)
+ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, const Rect& dst_rect, const Rect& clipped_rect, const Gfx::Bitmap& source, const Rect& src_rect, int hscale, int vscale, GetPixel get_pixel, Painter::ScalingMode scaling_mode)
 {
+    if (scaling_mode == Painter::ScalingMode::Bilinear) {
+        const int last_src_x = src_rect.width() - 1;
+        const int last_src_y = src_rect.height() - 1;
+        for (int y = clipped_rect.top(); y <= clipped_rect.bottom(); ++y) {
+            auto* scanline = (Color*)target.scanline(y);
+            // 16.16 fixed-point source coordinate; the fractional bits are
+            // the blend weights for the two neighboring taps.
+            int source_y = (y - dst_rect.y()) * vscale;
+            int y0 = min(source_y >> 16, last_src_y);
+            int y1 = min(y0 + 1, last_src_y);
+            u8 y_mix = (source_y >> 8) & 0xff;
+            for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
+                int source_x = (x - dst_rect.x()) * hscale;
+                int x0 = min(source_x >> 16, last_src_x);
+                int x1 = min(x0 + 1, last_src_x);
+                u8 x_mix = (source_x >> 8) & 0xff;
+                auto top = interpolate_pixels(get_pixel(source, x0, y0), get_pixel(source, x1, y0), x_mix);
+                auto bottom = interpolate_pixels(get_pixel(source, x0, y1), get_pixel(source, x1, y1), x_mix);
+                auto src_pixel = interpolate_pixels(top, bottom, y_mix);
+                if constexpr (has_alpha_channel)
+                    scanline[x] = scanline[x].blend(src_pixel);
+                else
+                    scanline[x] = src_pixel;
+            }
+        }
+        return;
+    }
+
+    if (scaling_mode == Painter::ScalingMode::BoxSampling) {
+        for (int y = clipped_rect.top(); y <= clipped_rect.bottom(); ++y) {
+            auto* scanline = (Color*)target.scanline(y);
+            int y0 = ((y - dst_rect.y()) * vscale) >> 16;
+            int y1 = min((((y - dst_rect.y() + 1) * vscale) >> 16), src_rect.height());
+            if (y1 <= y0)
+                y1 = y0 + 1;
+            for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
+                int x0 = ((x - dst_rect.x()) * hscale) >> 16;
+                int x1 = min((((x - dst_rect.x() + 1) * hscale) >> 16), src_rect.width());
+                if (x1 <= x0)
+                    x1 = x0 + 1;
+                u32 red = 0, green = 0, blue = 0, alpha = 0;
+                for (int sy = y0; sy < y1; ++sy) {
+                    for (int sx = x0; sx < x1; ++sx) {
+                        auto pixel = get_pixel(source, sx, sy);
+                        red += pixel.red();
+                        green += pixel.green();
+                        blue += pixel.blue();
+                        alpha += pixel.alpha();
+                    }
+                }
+                u32 sample_count = (y1 - y0) * (x1 - x0);
+                Color src_pixel(red / sample_count, green / sample_count, blue / sample_count, alpha / sample_count);
+                if constexpr (has_alpha_channel)
+                    scanline[x] = scanline[x].blend(src_pixel);
+                else
+                    scanline[x] = src_pixel;
+            }
+        }
+        return;
+    }
+
     if (dst_rect == clipped_rect && !(dst_rect.width() % src_rect.width()) && !(dst_rect.height() % src_rect.height())) {
         int hfactor = dst_rect.width() / src_rect.width();
         int vfactor = dst_rect.height() / src_rect.height();
@@ -695,7 +1085,7 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, const Rect&
     }
 }
 
-void Painter::draw_scaled_bitmap(const Rect& a_dst_rect, const Gfx::Bitmap& source, const Rect& src_rect)
+void Painter::draw_scaled_bitmap(const Rect& a_dst_rect, const Gfx::Bitmap& source, const Rect& src_rect, ScalingMode scaling_mode)
 {
     auto dst_rect = a_dst_rect;
     if (dst_rect.size() == src_rect.size())
@@ -714,31 +1104,34 @@ void Painter::draw_scaled_bitmap(const Rect& a_dst_rect, const Gfx::Bitmap& sour
     if (source.has_alpha_channel()) {
         switch (source.format()) {
         case BitmapFormat::RGB32:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGB32>);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGB32>, scaling_mode);
             break;
         case BitmapFormat::RGBA32:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGBA32>);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGBA32>, scaling_mode);
+            break;
+        case BitmapFormat::RGBA32Premultiplied:
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGBA32Premultiplied>, scaling_mode);
             break;
         case BitmapFormat::Indexed8:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Indexed8>);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Indexed8>, scaling_mode);
             break;
         default:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Invalid>);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Invalid>, scaling_mode);
             break;
         }
     } else {
         switch (source.format()) {
         case BitmapFormat::RGB32:
-            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGB32>);
+            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGB32>, scaling_mode);
             break;
         case BitmapFormat::RGBA32:
-            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGBA32>);
+            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::RGBA32>, scaling_mode);
             break;
         case BitmapFormat::Indexed8:
-            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Indexed8>);
+            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Indexed8>, scaling_mode);
             break;
         default:
-            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Invalid>);
+            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, hscale, vscale, get_pixel<BitmapFormat::Invalid>, scaling_mode);
             break;
         }
     }
@@ -790,6 +1183,133 @@ void Painter::draw_glyph_or_emoji(const Point& point, u32 codepoint, const Font&
     draw_emoji(point, *emoji, font);
 }
 
+// draw_text() re-consults the Font for every glyph of every line, every
+// frame, and terminal/editor repaints redraw mostly identical lines. We
+// cache rendered runs keyed on (font, text, color): the glyphs are laid
+// out once into an RGBA32 strip with the color baked in, and a repeated
+// line becomes a single blit_with_alpha() of that strip. Writing pixels
+// via the strip is bit-identical to the per-glyph path (draw_bitmap()
+// stores color.value() where a glyph bit is set and leaves everything
+// else alone), so this is restricted to runs it can reproduce exactly:
+// Latin-1 text with an opaque color. Emoji and translucent text keep
+// taking the per-glyph path.
+
+struct GlyphRunCacheEntry {
+    RefPtr<const Font> font;
+    String text;
+    RGBA32 color { 0 };
+    RefPtr<Gfx::Bitmap> strip;
+    u64 last_used { 0 };
+};
+
+static const size_t glyph_run_cache_size = 256;
+static const size_t glyph_run_cache_probe_length = 8;
+static const size_t glyph_run_max_cacheable_length = 256;
+static GlyphRunCacheEntry* s_glyph_run_cache;
+static u64 s_glyph_run_cache_time;
+
+static GlyphRunCacheEntry* glyph_run_cache()
+{
+    if (!s_glyph_run_cache)
+        s_glyph_run_cache = new GlyphRunCacheEntry[glyph_run_cache_size];
+    return s_glyph_run_cache;
+}
+
+void Painter::invalidate_glyph_run_cache()
+{
+    if (!s_glyph_run_cache)
+        return;
+    for (size_t i = 0; i < glyph_run_cache_size; ++i)
+        s_glyph_run_cache[i] = {};
+}
+
+void Painter::invalidate_glyph_run_cache(const Font& font)
+{
+    if (!s_glyph_run_cache)
+        return;
+    for (size_t i = 0; i < glyph_run_cache_size; ++i) {
+        if (s_glyph_run_cache[i].font == &font)
+            s_glyph_run_cache[i] = {};
+    }
+}
+
+static bool is_glyph_run_cacheable(const Utf8View& text, const Font& font, Color color)
+{
+    if (color.alpha() != 255)
+        return false;
+    if (font.glyph_height() == 0)
+        return false;
+    size_t length = 0;
+    for (u32 codepoint : text) {
+        // Emoji render from shared bitmaps; keep them on the per-glyph path.
+        if (codepoint >= 256)
+            return false;
+        ++length;
+    }
+    return length > 0 && length <= glyph_run_max_cacheable_length;
+}
+
+static RefPtr<Gfx::Bitmap> render_glyph_run(const Utf8View& text, const Font& font, Color color)
+{
+    int width = 0;
+    for (u32 codepoint : text)
+        width += font.glyph_width((char)codepoint) + font.glyph_spacing();
+    if (width <= 0)
+        return nullptr;
+    auto strip = Bitmap::create(BitmapFormat::RGBA32, { width, font.glyph_height() });
+    if (!strip)
+        return nullptr;
+    // A freshly created Bitmap is zero-filled, i.e. fully transparent.
+    int x = 0;
+    for (u32 codepoint : text) {
+        if (codepoint != ' ') {
+            auto bitmap = font.glyph_bitmap((char)codepoint);
+            for (int y = 0; y < bitmap.height(); ++y) {
+                auto* scanline = strip->scanline(y);
+                for (int glyph_x = 0; glyph_x < bitmap.width(); ++glyph_x) {
+                    if (bitmap.bit_at(glyph_x, y))
+                        scanline[x + glyph_x] = color.value();
+                }
+            }
+        }
+        x += font.glyph_width((char)codepoint) + font.glyph_spacing();
+    }
+    return strip;
+}
+
+static bool draw_glyph_run_from_cache(Painter& painter, const Point& point, const Utf8View& text, const Font& font, Color color)
+{
+    if (!is_glyph_run_cacheable(text, font, color))
+        return false;
+
+    auto& string = text.as_string();
+    auto* cache = glyph_run_cache();
+    size_t start_index = pair_int_hash(string.hash(), pair_int_hash(ptr_hash(&font), color.value())) % glyph_run_cache_size;
+
+    GlyphRunCacheEntry* victim = nullptr;
+    for (size_t i = 0; i < glyph_run_cache_probe_length; ++i) {
+        auto& entry = cache[(start_index + i) % glyph_run_cache_size];
+        if (entry.font == &font && entry.color == color.value() && entry.text == string) {
+            entry.last_used = ++s_glyph_run_cache_time;
+            painter.blit_with_alpha(point, *entry.strip, entry.strip->rect());
+            return true;
+        }
+        if (!victim || entry.last_used < victim->last_used)
+            victim = &entry;
+    }
+
+    auto strip = render_glyph_run(text, font, color);
+    if (!strip)
+        return false;
+    victim->font = &font;
+    victim->text = string;
+    victim->color = color.value();
+    victim->strip = strip;
+    victim->last_used = ++s_glyph_run_cache_time;
+    painter.blit_with_alpha(point, *strip, strip->rect());
+    return true;
+}
+
 void Painter::draw_text_line(const Rect& a_rect, const Utf8View& text, const Font& font, TextAlignment alignment, Color color, TextElision elision)
 {
     auto rect = a_rect;
@@ -843,6 +1363,10 @@ void Painter::draw_text_line(const Rect& a_rect, const Utf8View& text, const Fon
     }
 
     auto point = rect.location();
+
+    if (draw_glyph_run_from_cache(*this, point, final_text, font, color))
+        return;
+
     int space_width = font.glyph_width(' ') + font.glyph_spacing();
 
     for (u32 codepoint : final_text) {
@@ -1071,6 +1595,198 @@ PainterStateSaver::~PainterStateSaver()
     m_painter.restore();
 }
 
+// ---------------------------------------------------------------------------
+// fill_path(): active-edge-table scanline rasterizer.
+//
+// The path is flattened into a table of non-horizontal edges sorted by their
+// top scanline. Walking down the bitmap we keep an "active" list of edges
+// crossing the current scanline, step each one's x incrementally by its
+// slope, and fill the spans the winding rule selects. Each pixel row is
+// sampled on four sub-scanlines and span ends get fractional horizontal
+// coverage, so anti-aliasing falls out of the same accumulation; runs of
+// equal coverage are handed to fill_rect() as single spans with a scaled
+// alpha, which feeds the span kernels.
+// ---------------------------------------------------------------------------
+
+struct PathRasterizerEdge {
+    float x { 0 };     // x at the current sub-scanline
+    float dxdy { 0 };  // x step per sub-scanline
+    int top { 0 };     // first sub-scanline (inclusive)
+    int bottom { 0 };  // last sub-scanline (exclusive)
+    int direction { 0 };
+};
+
+static const int fill_path_subsamples = 4;
+
+void Painter::fill_path(const Path& path, Color color, WindingRule winding_rule)
+{
+    if (color.alpha() == 0)
+        return;
+
+    // Only the part of the path that can end up inside the clip matters.
+    auto visible_rect = clip_rect().translated(-translation());
+
+    Vector<PathRasterizerEdge, 32> edges;
+    float min_x = 1e9f, max_x = -1e9f;
+
+    auto add_edge = [&](const FloatPoint& from, const FloatPoint& to) {
+        if (from.y() == to.y())
+            return;
+        auto p0 = from;
+        auto p1 = to;
+        int direction = 1;
+        if (p0.y() > p1.y()) {
+            swap(p0, p1);
+            direction = -1;
+        }
+        PathRasterizerEdge edge;
+        // Sub-scanline i samples the path at y = (i + 0.5) / subsamples.
+        edge.top = (int)ceilf(p0.y() * fill_path_subsamples - 0.5f);
+        edge.bottom = (int)ceilf(p1.y() * fill_path_subsamples - 0.5f);
+        if (edge.top >= edge.bottom)
+            return;
+        edge.dxdy = (p1.x() - p0.x()) / ((p1.y() - p0.y()) * fill_path_subsamples);
+        float top_sample_y = (edge.top + 0.5f) / fill_path_subsamples;
+        edge.x = p0.x() + (top_sample_y - p0.y()) * (p1.x() - p0.x()) / (p1.y() - p0.y());
+        edge.direction = direction;
+        edges.append(edge);
+        min_x = min(min_x, min(p0.x(), p1.x()));
+        max_x = max(max_x, max(p0.x(), p1.x()));
+    };
+
+    FloatPoint cursor;
+    FloatPoint subpath_start;
+    bool has_subpath = false;
+    for (auto& segment : path.segments()) {
+        switch (segment.type) {
+        case Path::Segment::Type::Invalid:
+            ASSERT_NOT_REACHED();
+            break;
+        case Path::Segment::Type::MoveTo:
+            if (has_subpath)
+                add_edge(cursor, subpath_start);
+            cursor = segment.point;
+            subpath_start = segment.point;
+            has_subpath = true;
+            break;
+        case Path::Segment::Type::LineTo:
+            if (!has_subpath) {
+                subpath_start = cursor;
+                has_subpath = true;
+            }
+            add_edge(cursor, segment.point);
+            cursor = segment.point;
+            break;
+        }
+    }
+    if (has_subpath)
+        add_edge(cursor, subpath_start);
+
+    if (edges.is_empty())
+        return;
+
+    quick_sort(edges, [](auto& a, auto& b) { return a.top < b.top; });
+
+    int first_pixel_x = max((int)floorf(min_x), visible_rect.left());
+    int last_pixel_x = min((int)ceilf(max_x), visible_rect.right() + 1);
+    if (first_pixel_x >= last_pixel_x)
+        return;
+    int row_width = last_pixel_x - first_pixel_x;
+
+    int first_subscanline = max(edges.first().top, visible_rect.top() * fill_path_subsamples);
+    int last_subscanline = edges.first().bottom;
+    for (auto& edge : edges)
+        last_subscanline = max(last_subscanline, edge.bottom);
+    last_subscanline = min(last_subscanline, (visible_rect.bottom() + 1) * fill_path_subsamples);
+
+    // Coverage for one pixel row; a fully covered pixel accumulates
+    // 64 units per sub-scanline, 256 in total.
+    Vector<u16, 256> coverage;
+    coverage.resize(row_width);
+    memset(coverage.data(), 0, row_width * sizeof(u16));
+
+    auto emit_coverage_row = [&](int pixel_y) {
+        for (int i = 0; i < row_width;) {
+            u16 this_coverage = coverage[i];
+            int run_start = i;
+            for (; i < row_width && coverage[i] == this_coverage; ++i)
+                coverage[i] = 0;
+            if (!this_coverage)
+                continue;
+            u32 alpha = ((u32)min(this_coverage, (u16)256) * (color.alpha() + 1)) >> 8;
+            fill_rect({ first_pixel_x + run_start, pixel_y, i - run_start, 1 }, color.with_alpha(min(alpha, 255u)));
+        }
+    };
+
+    auto accumulate_span = [&](float span_start, float span_end) {
+        span_start = max(span_start, (float)first_pixel_x);
+        span_end = min(span_end, (float)last_pixel_x);
+        if (span_start >= span_end)
+            return;
+        int first = (int)floorf(span_start);
+        int last = (int)ceilf(span_end) - 1;
+        if (first == last) {
+            coverage[first - first_pixel_x] += (u16)((span_end - span_start) * 64);
+            return;
+        }
+        coverage[first - first_pixel_x] += (u16)(((first + 1) - span_start) * 64);
+        for (int x = first + 1; x < last; ++x)
+            coverage[x - first_pixel_x] += 64;
+        coverage[last - first_pixel_x] += (u16)((span_end - last) * 64);
+    };
+
+    Vector<PathRasterizerEdge, 32> active_edges;
+    size_t next_edge = 0;
+
+    int current_pixel_y = first_subscanline / fill_path_subsamples;
+    for (int subscanline = first_subscanline; subscanline < last_subscanline; ++subscanline) {
+        int pixel_y = subscanline / fill_path_subsamples;
+        if (pixel_y != current_pixel_y) {
+            emit_coverage_row(current_pixel_y);
+            current_pixel_y = pixel_y;
+        }
+
+        for (size_t i = 0; i < active_edges.size();) {
+            if (active_edges[i].bottom <= subscanline) {
+                active_edges.remove(i);
+                continue;
+            }
+            active_edges[i].x += active_edges[i].dxdy;
+            ++i;
+        }
+        while (next_edge < edges.size() && edges[next_edge].top <= subscanline) {
+            if (edges[next_edge].bottom > subscanline) {
+                auto edge = edges[next_edge];
+                edge.x += (subscanline - edge.top) * edge.dxdy;
+                active_edges.append(edge);
+            }
+            ++next_edge;
+        }
+
+        // The active list is nearly sorted from the previous sub-scanline,
+        // so insertion sort is effectively linear here.
+        for (size_t i = 1; i < active_edges.size(); ++i) {
+            for (size_t j = i; j > 0 && active_edges[j - 1].x > active_edges[j].x; --j)
+                swap(active_edges[j - 1], active_edges[j]);
+        }
+
+        int winding = 0;
+        float span_start = 0;
+        for (auto& edge : active_edges) {
+            int previous_winding = winding;
+            if (winding_rule == WindingRule::Nonzero)
+                winding += edge.direction;
+            else
+                winding ^= 1;
+            if (!previous_winding && winding)
+                span_start = edge.x;
+            else if (previous_winding && !winding)
+                accumulate_span(span_start, edge.x);
+        }
+    }
+    emit_coverage_row(current_pixel_y);
+}
+
 void Painter::stroke_path(const Path& path, Color color, int thickness)
 {
     FloatPoint cursor;
@@ -41,6 +41,20 @@ namespace Gfx {
 
 class Painter {
 public:
+    // How draw_scaled_bitmap() samples the source:
+    // - NearestNeighbor: fastest, blocky when enlarging, drops pixels when
+    //   shrinking. The default, and what everything used historically.
+    // - Bilinear: fixed-point weighted blend of the four surrounding source
+    //   pixels; what you want for photos and scaled page images.
+    // - BoxSampling: averages the whole source box behind each destination
+    //   pixel; best for strong downscales (thumbnails), where bilinear
+    //   would still skip most source pixels.
+    enum class ScalingMode {
+        NearestNeighbor,
+        Bilinear,
+        BoxSampling,
+    };
+
     explicit Painter(Gfx::Bitmap&);
     ~Painter();
     void clear_rect(const Rect&, Color);
@@ -55,7 +69,7 @@ public:
     void draw_ellipse_intersecting(const Rect&, Color, int thickness = 1);
     void set_pixel(const Point&, Color);
     void draw_line(const Point&, const Point&, Color, int thickness = 1, bool dotted = false);
-    void draw_scaled_bitmap(const Rect& dst_rect, const Gfx::Bitmap&, const Rect& src_rect);
+    void draw_scaled_bitmap(const Rect& dst_rect, const Gfx::Bitmap&, const Rect& src_rect, ScalingMode = ScalingMode::NearestNeighbor);
     void blit(const Point&, const Gfx::Bitmap&, const Rect& src_rect, float opacity = 1.0f);
     void blit_dimmed(const Point&, const Gfx::Bitmap&, const Rect& src_rect);
     void blit_brightened(const Point&, const Gfx::Bitmap&, const Rect& src_rect);
@@ -70,8 +84,20 @@ public:
     void draw_emoji(const Point&, const Gfx::Bitmap&, const Font&);
     void draw_glyph_or_emoji(const Point&, u32 codepoint, const Font&, Color);
 
+    // draw_text() keeps a cache of rendered glyph runs. Code that mutates
+    // a Font's glyph data in place (e.g. FontEditor) must call one of
+    // these so stale runs don't keep getting blitted.
+    static void invalidate_glyph_run_cache();
+    static void invalidate_glyph_run_cache(const Font&);
+
     void stroke_path(const Path&, Color, int thickness);
 
+    enum class WindingRule {
+        Nonzero,
+        EvenOdd,
+    };
+    void fill_path(const Path&, Color, WindingRule = WindingRule::Nonzero);
+
     const Font& font() const { return *state().font; }
     void set_font(const Font& font) { state().font = &font; }
 
@@ -44,21 +44,36 @@ bool decode(Decoder& decoder, Gfx::ShareableBitmap& shareable_bitmap)
 {
     i32 shbuf_id = 0;
     Gfx::Size size;
+    i32 raw_format = 0;
     if (!decoder.decode(shbuf_id))
         return false;
     if (!decoder.decode(size))
         return false;
+    if (!decoder.decode(raw_format))
+        return false;
 
     if (shbuf_id == -1)
         return true;
 
+    // Only the raw 32-bit formats can travel this way; indexed bitmaps
+    // would need their palette serialized as well.
+    auto format = (Gfx::BitmapFormat)raw_format;
+    switch (format) {
+    case Gfx::BitmapFormat::RGB32:
+    case Gfx::BitmapFormat::RGBA32:
+    case Gfx::BitmapFormat::RGBA32Premultiplied:
+        break;
+    default:
+        return false;
+    }
+
     dbg() << "Decoding a ShareableBitmap with shbuf_id=" << shbuf_id << ", size=" << size;
 
     auto shared_buffer = SharedBuffer::create_from_shbuf_id(shbuf_id);
     if (!shared_buffer)
         return false;
 
-    auto bitmap = Gfx::Bitmap::create_with_shared_buffer(Gfx::BitmapFormat::RGBA32, shared_buffer.release_nonnull(), size);
+    auto bitmap = Gfx::Bitmap::create_with_shared_buffer(format, shared_buffer.release_nonnull(), size);
     shareable_bitmap = bitmap->to_shareable_bitmap();
     return true;
 }
@@ -29,6 +29,7 @@
 #include <LibHTTP/HttpJob.h>
 #include <LibHTTP/HttpResponse.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 
 //#define HTTPJOB_DEBUG
@@ -86,8 +87,11 @@ void HttpJob::on_socket_connected()
 #endif
 
     bool success = m_socket->send(raw_request);
-    if (!success)
+    if (!success) {
+        if (retry_on_fresh_connection())
+            return;
         return deferred_invoke([this](auto&) { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+    }
 
     m_socket->on_ready_to_read = [&] {
         if (is_cancelled())
@@ -97,6 +101,8 @@ void HttpJob::on_socket_connected()
                 return;
             auto line = m_socket->read_line(PAGE_SIZE);
             if (line.is_null()) {
+                if (retry_on_fresh_connection())
+                    return;
                 fprintf(stderr, "HttpJob: Expected HTTP status\n");
                 return deferred_invoke([this](auto&) { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
             }
@@ -125,6 +131,8 @@ void HttpJob::on_socket_connected()
             auto chomped_line = String::copy(line, Chomp);
             if (chomped_line.is_empty()) {
                 m_state = State::InBody;
+                auto transfer_encoding = m_headers.get("Transfer-Encoding");
+                m_chunked = transfer_encoding.has_value() && transfer_encoding.value().equals_ignoring_case("chunked");
                 return;
             }
             auto parts = chomped_line.split(':');
@@ -146,6 +154,8 @@ void HttpJob::on_socket_connected()
         }
         ASSERT(m_state == State::InBody);
         ASSERT(m_socket->can_read());
+        if (m_chunked)
+            return read_chunked_body();
         auto payload = m_socket->receive(64 * KB);
         if (!payload) {
             if (m_socket->eof())
@@ -154,6 +164,8 @@ void HttpJob::on_socket_connected()
         }
         m_received_buffers.append(payload);
         m_received_size += payload.size();
+        if (on_body_chunk && !m_headers.get("Content-Encoding").has_value())
+            on_body_chunk(payload);
 
         auto content_length_header = m_headers.get("Content-Length");
         if (content_length_header.has_value()) {
@@ -161,12 +173,88 @@ void HttpJob::on_socket_connected()
             auto content_length = content_length_header.value().to_uint(ok);
             if (ok && m_received_size >= content_length) {
                 m_received_size = content_length;
+                m_socket_reusable = response_allows_reuse();
                 finish_up();
             }
         }
     };
 }
 
+void HttpJob::read_chunked_body()
+{
+    for (;;) {
+        if (m_chunk_remaining > 0) {
+            if (!m_socket->can_read())
+                return;
+            auto payload = m_socket->receive(m_chunk_remaining < 64 * KB ? m_chunk_remaining : 64 * KB);
+            if (!payload) {
+                if (m_socket->eof())
+                    return finish_up();
+                return deferred_invoke([this](auto&) { did_fail(Core::NetworkJob::Error::ProtocolFailed); });
+            }
+            m_chunk_remaining -= payload.size();
+            m_received_size += payload.size();
+            if (on_body_chunk && !m_headers.get("Content-Encoding").has_value())
+                on_body_chunk(payload);
+            m_received_buffers.append(move(payload));
+            continue;
+        }
+        if (!m_socket->can_read_line())
+            return;
+        auto line = m_socket->read_line(PAGE_SIZE);
+        if (line.is_null()) {
+            fprintf(stderr, "HttpJob: Expected chunk header\n");
+            return deferred_invoke([this](auto&) { did_fail(Core::NetworkJob::Error::ProtocolFailed); });
+        }
+        auto chomped_line = String::copy(line, Chomp);
+        if (chomped_line.is_empty()) {
+            // A blank line separates chunks; the one after the last chunk
+            // (and any trailers) ends the response.
+            if (m_in_last_chunk) {
+                m_socket_reusable = response_allows_reuse();
+                return finish_up();
+            }
+            continue;
+        }
+        if (m_in_last_chunk) {
+            // Skip trailer headers.
+            continue;
+        }
+        auto chunk_size = strtoul(chomped_line.characters(), nullptr, 16);
+        if (!chunk_size)
+            m_in_last_chunk = true;
+        else
+            m_chunk_remaining = chunk_size;
+    }
+}
+
+bool HttpJob::response_allows_reuse() const
+{
+    if (!m_request.keep_alive())
+        return false;
+    auto connection = m_headers.get("Connection");
+    if (connection.has_value() && connection.value().equals_ignoring_case("close"))
+        return false;
+    return true;
+}
+
+bool HttpJob::retry_on_fresh_connection()
+{
+    // A keep-alive connection we were handed may have gone stale before the
+    // server saw our request; transparently redo it on a fresh connection.
+    if (!m_reusing_socket)
+        return false;
+    m_reusing_socket = false;
+    deferred_invoke([this](auto&) {
+        m_socket->on_ready_to_read = nullptr;
+        remove_child(*m_socket);
+        m_socket = nullptr;
+        m_state = State::InStatus;
+        start();
+    });
+    return true;
+}
+
 void HttpJob::finish_up()
 {
     m_state = State::Finished;
@@ -207,6 +295,27 @@ void HttpJob::start()
     }
 }
 
+void HttpJob::start(NonnullRefPtr<Core::Socket> socket)
+{
+    ASSERT(!m_socket);
+    m_reusing_socket = true;
+    m_socket = move(socket);
+    add_child(*m_socket);
+    on_socket_connected();
+}
+
+RefPtr<Core::Socket> HttpJob::release_socket()
+{
+    ASSERT(m_state == State::Finished);
+    auto socket = move(m_socket);
+    if (socket) {
+        socket->on_ready_to_read = nullptr;
+        socket->on_connected = nullptr;
+        remove_child(*socket);
+    }
+    return socket;
+}
+
 void HttpJob::shutdown()
 {
     if (!m_socket)
@@ -41,13 +41,27 @@ public:
     virtual ~HttpJob() override;
 
     virtual void start() override;
+    void start(NonnullRefPtr<Core::Socket>);
     virtual void shutdown() override;
 
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     const HttpResponse* response() const { return static_cast<const HttpResponse*>(Core::NetworkJob::response()); }
 
+    // Invoked for each piece of body data as it arrives, but only when the
+    // response has no Content-Encoding (encoded bodies are only usable once
+    // decoded in full).
+    Function<void(const ByteBuffer&)> on_body_chunk;
+
+    // Whether the connection survived the response and can carry another
+    // request. Only meaningful after the job has finished.
+    bool socket_can_be_reused() const { return m_socket_reusable; }
+    RefPtr<Core::Socket> release_socket();
+
 private:
     void on_socket_connected();
+    void read_chunked_body();
+    bool response_allows_reuse() const;
+    bool retry_on_fresh_connection();
     void finish_up();
 
     enum class State {
@@ -64,6 +78,11 @@ private:
     HashMap<String, String> m_headers;
     Vector<ByteBuffer> m_received_buffers;
     size_t m_received_size { 0 };
+    size_t m_chunk_remaining { 0 };
+    bool m_chunked { false };
+    bool m_in_last_chunk { false };
+    bool m_reusing_socket { false };
+    bool m_socket_reusable { false };
 };
 
 }
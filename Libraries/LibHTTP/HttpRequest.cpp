@@ -67,7 +67,10 @@ ByteBuffer HttpRequest::to_raw_request() const
     builder.append(m_url.path());
     builder.append(" HTTP/1.1\r\nHost: ");
     builder.append(m_url.host());
-    builder.append("\r\nConnection: close\r\n\r\n");
+    if (m_keep_alive)
+        builder.append("\r\nConnection: keep-alive\r\n\r\n");
+    else
+        builder.append("\r\nConnection: close\r\n\r\n");
     return builder.to_byte_buffer();
 }
 
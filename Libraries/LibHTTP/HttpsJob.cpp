@@ -164,6 +164,8 @@ void HttpsJob::on_socket_connected()
         }
         m_received_buffers.append(payload);
         m_received_size += payload.size();
+        if (on_body_chunk && !m_headers.get("Content-Encoding").has_value())
+            on_body_chunk(payload);
 
         auto content_length_header = m_headers.get("Content-Length");
         if (content_length_header.has_value()) {
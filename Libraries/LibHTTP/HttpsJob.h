@@ -46,6 +46,11 @@ public:
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     const HttpResponse* response() const { return static_cast<const HttpResponse*>(Core::NetworkJob::response()); }
 
+    // Invoked for each piece of body data as it arrives, but only when the
+    // response has no Content-Encoding (encoded bodies are only usable once
+    // decoded in full).
+    Function<void(const ByteBuffer&)> on_body_chunk;
+
 private:
     RefPtr<TLS::TLSv12> construct_socket() { return TLS::TLSv12::construct(this); }
     void on_socket_connected();
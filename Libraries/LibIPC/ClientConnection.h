@@ -37,6 +37,7 @@
 #include <LibIPC/Message.h>
 #include <errno.h>
 #include <stdio.h>
+#include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -108,19 +109,41 @@ public:
 
         auto buffer = message.encode();
 
+        // Outgoing messages are batched and flushed once per event loop spin,
+        // so a burst of small messages (e.g. invalidation rects during a
+        // window drag) costs one write() instead of one per message.
+        if (m_out_buffer.is_empty()) {
+            deferred_invoke([this](auto&) {
+                flush_outgoing_messages();
+            });
+        }
+        m_out_buffer.append(buffer.data(), buffer.size());
+
+        if (m_out_buffer.size() >= max_buffered_bytes_before_flush)
+            flush_outgoing_messages();
+    }
+
+    void flush_outgoing_messages()
+    {
+        if (m_out_buffer.is_empty())
+            return;
+        auto buffer = move(m_out_buffer);
+        if (!m_socket->is_open())
+            return;
+
         int nwritten = write(m_socket->fd(), buffer.data(), buffer.size());
         if (nwritten < 0) {
             switch (errno) {
             case EPIPE:
-                dbg() << *this << "::post_message: Disconnected from peer";
+                dbg() << *this << "::flush_outgoing_messages: Disconnected from peer";
                 shutdown();
                 return;
             case EAGAIN:
-                dbg() << *this << "::post_message: Client buffer overflowed.";
+                dbg() << *this << "::flush_outgoing_messages: Client buffer overflowed.";
                 did_misbehave();
                 return;
             default:
-                perror("Connection::post_message write");
+                perror("Connection::flush_outgoing_messages write");
                 ASSERT_NOT_REACHED();
             }
         }
@@ -131,6 +154,21 @@ public:
     void drain_messages_from_client()
     {
         Vector<u8> bytes;
+
+        // Ask the kernel how much the socket already has buffered, so the
+        // common case is one right-sized recv() instead of filling 4KB
+        // chunks; the loop below still picks up anything that arrives in
+        // between and handles sockets without FIONREAD support.
+        int pending = 0;
+        if (ioctl(m_socket->fd(), FIONREAD, &pending) >= 0 && pending > 0) {
+            bytes.resize(pending);
+            ssize_t nread = recv(m_socket->fd(), bytes.data(), bytes.size(), MSG_DONTWAIT);
+            if (nread < 0)
+                bytes.clear();
+            else
+                bytes.resize(nread);
+        }
+
         for (;;) {
             u8 buffer[4096];
             ssize_t nread = recv(m_socket->fd(), buffer, sizeof(buffer), MSG_DONTWAIT);
@@ -177,6 +215,12 @@ public:
 
     void shutdown()
     {
+        // Best-effort flush of anything still batched; we're tearing the
+        // connection down, so errors don't matter anymore.
+        if (!m_out_buffer.is_empty() && m_socket->is_open()) {
+            auto buffer = move(m_out_buffer);
+            (void)write(m_socket->fd(), buffer.data(), buffer.size());
+        }
         m_socket->close();
         die();
     }
@@ -200,8 +244,13 @@ protected:
     }
 
 private:
+    // Don't let a message storm grow the batch past what the socket buffer
+    // can reasonably take in one write().
+    static const size_t max_buffered_bytes_before_flush = 16 * KB;
+
     Endpoint& m_endpoint;
     RefPtr<Core::LocalSocket> m_socket;
+    Vector<u8> m_out_buffer;
     int m_client_id { -1 };
     int m_client_pid { -1 };
 };
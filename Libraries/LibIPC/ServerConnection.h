@@ -81,6 +81,10 @@ public:
     template<typename MessageType>
     OwnPtr<MessageType> wait_for_specific_message()
     {
+        // We're about to block on the socket, so everything we've batched
+        // has to be on the wire first.
+        flush_outgoing_messages();
+
         // Double check we don't already have the event waiting for us.
         // Otherwise we might end up blocked for a while for no reason.
         for (size_t i = 0; i < m_unprocessed_messages.size(); ++i) {
@@ -115,14 +119,33 @@ public:
     bool post_message(const Message& message)
     {
         auto buffer = message.encode();
+
+        // Outgoing messages are batched and flushed once per event loop spin
+        // (or before we block waiting for a response), so bursts of small
+        // asynchronous messages cost one write() instead of one each.
+        if (m_out_buffer.is_empty()) {
+            deferred_invoke([this](auto&) {
+                flush_outgoing_messages();
+            });
+        }
+        m_out_buffer.append(buffer.data(), buffer.size());
+
+        if (m_out_buffer.size() >= max_buffered_bytes_before_flush)
+            flush_outgoing_messages();
+        return true;
+    }
+
+    void flush_outgoing_messages()
+    {
+        if (m_out_buffer.is_empty())
+            return;
+        auto buffer = move(m_out_buffer);
         int nwritten = write(m_connection->fd(), buffer.data(), buffer.size());
         if (nwritten < 0) {
             perror("write");
             ASSERT_NOT_REACHED();
-            return false;
         }
         ASSERT(static_cast<size_t>(nwritten) == buffer.size());
-        return true;
     }
 
     template<typename RequestType, typename... Args>
@@ -188,9 +211,14 @@ private:
         }
     }
 
+    // Don't let a message storm grow the batch past what the socket buffer
+    // can reasonably take in one write().
+    static const size_t max_buffered_bytes_before_flush = 16 * KB;
+
     LocalEndpoint& m_local_endpoint;
     RefPtr<Core::LocalSocket> m_connection;
     RefPtr<Core::Notifier> m_notifier;
+    Vector<u8> m_out_buffer;
     Vector<OwnPtr<Message>> m_unprocessed_messages;
     int m_server_pid { -1 };
     int m_my_client_id { -1 };
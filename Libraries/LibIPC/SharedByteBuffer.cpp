@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __serenity__
+
+#include <AK/LogStream.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/SharedByteBuffer.h>
+#include <string.h>
+
+namespace IPC {
+
+SharedByteBuffer SharedByteBuffer::create_with_data(const void* data, size_t size)
+{
+    // A SharedBuffer can't be zero-sized, but an empty payload is perfectly
+    // valid, so always allocate at least one byte.
+    auto buffer = SharedBuffer::create_with_size(size ? size : 1);
+    if (!buffer)
+        return {};
+    if (size)
+        memcpy(buffer->data(), data, size);
+    buffer->seal();
+
+    SharedByteBuffer shared_byte_buffer;
+    shared_byte_buffer.m_buffer = move(buffer);
+    shared_byte_buffer.m_size = size;
+    return shared_byte_buffer;
+}
+
+SharedByteBuffer SharedByteBuffer::create_from_shbuf_id(i32 shbuf_id, size_t size)
+{
+    auto buffer = SharedBuffer::create_from_shbuf_id(shbuf_id);
+    if (!buffer)
+        return {};
+    if (size > (size_t)buffer->size()) {
+        dbg() << "SharedByteBuffer: claimed size " << size << " is larger than the underlying buffer (" << buffer->size() << ")";
+        return {};
+    }
+
+    SharedByteBuffer shared_byte_buffer;
+    shared_byte_buffer.m_buffer = move(buffer);
+    shared_byte_buffer.m_size = size;
+    return shared_byte_buffer;
+}
+
+SharedByteBuffer SharedByteBuffer::create_from_buffer(NonnullRefPtr<SharedBuffer> buffer, size_t size)
+{
+    ASSERT(size <= (size_t)buffer->size());
+
+    SharedByteBuffer shared_byte_buffer;
+    shared_byte_buffer.m_buffer = move(buffer);
+    shared_byte_buffer.m_size = size;
+    return shared_byte_buffer;
+}
+
+void SharedByteBuffer::share_with(pid_t peer_pid)
+{
+    if (m_buffer)
+        m_buffer->share_with(peer_pid);
+}
+
+bool decode(Decoder& decoder, SharedByteBuffer& shared_byte_buffer)
+{
+    i32 shbuf_id = 0;
+    u32 size = 0;
+    if (!decoder.decode(shbuf_id))
+        return false;
+    if (!decoder.decode(size))
+        return false;
+
+    if (shbuf_id == -1)
+        return true;
+
+    shared_byte_buffer = SharedByteBuffer::create_from_shbuf_id(shbuf_id, size);
+    return shared_byte_buffer.is_valid();
+}
+
+}
+
+#endif
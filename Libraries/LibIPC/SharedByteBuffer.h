@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifdef __serenity__
+
+#include <AK/RefPtr.h>
+#include <AK/SharedBuffer.h>
+
+namespace IPC {
+
+// A blob of bytes that travels out-of-line: only the shbuf handle and the
+// size cross the socket, so large payloads don't get copied through the
+// message stream. The sender must share_with() the peer before sending,
+// just like with Gfx::ShareableBitmap.
+class SharedByteBuffer {
+public:
+    SharedByteBuffer() {}
+
+    static SharedByteBuffer create_with_data(const void* data, size_t);
+    static SharedByteBuffer create_from_shbuf_id(i32 shbuf_id, size_t size);
+    // Wraps an existing buffer without copying, for relaying the same
+    // payload to another peer. The caller should make sure the buffer is
+    // sealed if the original owner could still write to it.
+    static SharedByteBuffer create_from_buffer(NonnullRefPtr<SharedBuffer>, size_t size);
+
+    bool is_valid() const { return m_buffer; }
+
+    i32 shbuf_id() const { return m_buffer ? m_buffer->shbuf_id() : -1; }
+    size_t size() const { return m_size; }
+    const u8* data() const { return m_buffer ? (const u8*)m_buffer->data() : nullptr; }
+
+    const RefPtr<SharedBuffer>& shared_buffer() const { return m_buffer; }
+
+    void share_with(pid_t);
+
+private:
+    RefPtr<SharedBuffer> m_buffer;
+    size_t m_size { 0 };
+};
+
+class Decoder;
+bool decode(Decoder&, SharedByteBuffer&);
+
+}
+
+#endif
@@ -83,7 +83,7 @@ CallExpression::ThisAndCallee CallExpression::compute_this_and_callee(Interprete
         auto* this_value = object_value.to_object(interpreter.heap());
         if (interpreter.exception())
             return {};
-        auto callee = this_value->get(member_expression.computed_property_name(interpreter)).value_or(js_undefined());
+        auto callee = member_expression.get_from_object(interpreter, *this_value);
         return { this_value, callee };
     }
     return { &interpreter.global_object(), m_callee->execute(interpreter) };
@@ -1111,6 +1111,41 @@ String MemberExpression::to_string_approximation() const
     return String::format("%s.%s", object_string.characters(), static_cast<const Identifier&>(*m_property).string().characters());
 }
 
+Value MemberExpression::get_from_object(Interpreter& interpreter, Object& object) const
+{
+    if (is_computed())
+        return object.get(computed_property_name(interpreter)).value_or(js_undefined());
+
+    ASSERT(m_property->is_identifier());
+    auto& property_name = static_cast<const Identifier&>(*m_property).string();
+
+    // Unique (dictionary) shapes mutate in place -- deleting a property
+    // shifts the offsets of everything after it without changing the Shape
+    // pointer -- so a cached offset can't be trusted for them.
+    if (!object.shape().is_unique()) {
+        if (&object.shape() == m_cached_shape && interpreter.heap().gc_epoch() == m_cache_gc_epoch) {
+            auto value = object.get_direct(m_cached_property_offset);
+            if (!value.is_empty() && !(value.is_object() && value.as_object().is_native_property()))
+                return value;
+        }
+
+        auto metadata = object.shape().lookup(property_name);
+        if (metadata.has_value()) {
+            auto value = object.get_direct(metadata.value().offset);
+            if (!value.is_empty() && !(value.is_object() && value.as_object().is_native_property())) {
+                m_cached_shape = &object.shape();
+                m_cached_property_offset = metadata.value().offset;
+                m_cache_gc_epoch = interpreter.heap().gc_epoch();
+                return value;
+            }
+        }
+    }
+
+    // Native properties, accessors and prototype chain walks stay on the
+    // regular path; only plain own properties are cached.
+    return object.get(property_name).value_or(js_undefined());
+}
+
 Value MemberExpression::execute(Interpreter& interpreter) const
 {
     auto object_value = m_object->execute(interpreter);
@@ -1119,7 +1154,7 @@ Value MemberExpression::execute(Interpreter& interpreter) const
     auto* object_result = object_value.to_object(interpreter.heap());
     if (interpreter.exception())
         return {};
-    return object_result->get(computed_property_name(interpreter)).value_or(js_undefined());
+    return get_from_object(interpreter, *object_result);
 }
 
 Value StringLiteral::execute(Interpreter& interpreter) const
@@ -1185,8 +1220,13 @@ Value ArrayExpression::execute(Interpreter& interpreter) const
                         string_to_spread = value.as_string().string();
                     else
                         string_to_spread = static_cast<const StringObject&>(value.as_object()).primitive_string().string();
-                    for (size_t i = 0; i < string_to_spread.length(); ++i)
-                        array->elements().append(js_string(interpreter, string_to_spread.substring(i, 1)));
+                    for (size_t i = 0; i < string_to_spread.length(); ++i) {
+                        // Allocate before calling elements(), so that a GC
+                        // triggered by the allocation can't run between the
+                        // write barrier and the append.
+                        auto* string = js_string(interpreter, string_to_spread.substring(i, 1));
+                        array->elements().append(string);
+                    }
                     continue;
                 }
                 interpreter.throw_exception<TypeError>(String::format("%s is not iterable", value.to_string().characters()));
@@ -1407,4 +1447,457 @@ void ScopeNode::add_variables(NonnullRefPtrVector<VariableDeclaration> variables
     m_variables.append(move(variables));
 }
 
+// Bytecode generation. Each node either compiles itself and returns the
+// register holding its result, or returns an empty Optional, in which case
+// the whole function falls back to the AST interpreter.
+
+Optional<Bytecode::Register> ScopeNode::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Nested blocks with lexical declarations would need their own
+    // environment; those stay on the AST path. (The function body itself
+    // doesn't go through here, so hoisted "var"s are not affected.)
+    if (!variables().is_empty())
+        return {};
+    for (auto& child : children()) {
+        if (!child.generate_bytecode(generator).has_value())
+            return {};
+    }
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> ExpressionStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    return m_expression->generate_bytecode(generator);
+}
+
+Optional<Bytecode::Register> VariableDeclaration::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (m_declaration_kind != DeclarationKind::Var)
+        return {};
+    for (auto& declarator : m_declarations) {
+        if (auto* init = declarator.init()) {
+            auto value = init->generate_bytecode(generator);
+            if (!value.has_value())
+                return {};
+            auto local = generator.lookup_local(declarator.id().string());
+            if (!local.has_value())
+                return {};
+            generator.emit({ Bytecode::Op::Mov, local.value().index, value.value().index });
+        }
+    }
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> ReturnStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    Optional<Bytecode::Register> value;
+    if (m_argument) {
+        value = m_argument->generate_bytecode(generator);
+        if (!value.has_value())
+            return {};
+    } else {
+        value = generator.allocate_register();
+        generator.emit({ Bytecode::Op::LoadConstant, value.value().index, 0, 0, generator.add_constant(js_undefined()) });
+    }
+    generator.emit({ Bytecode::Op::Return, 0, value.value().index });
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> IfStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto predicate = m_predicate->generate_bytecode(generator);
+    if (!predicate.has_value())
+        return {};
+    auto jump_to_alternate = generator.emit({ Bytecode::Op::JumpIfFalse, 0, predicate.value().index });
+    if (!m_consequent->generate_bytecode(generator).has_value())
+        return {};
+    if (m_alternate) {
+        auto jump_to_end = generator.emit({ Bytecode::Op::Jump });
+        generator.patch_jump(jump_to_alternate);
+        if (!m_alternate->generate_bytecode(generator).has_value())
+            return {};
+        generator.patch_jump(jump_to_end);
+    } else {
+        generator.patch_jump(jump_to_alternate);
+    }
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> WhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Not breakable: break inside a plain while-loop isn't handled by
+    // WhileStatement::execute() either, so anything relying on it keeps the
+    // AST interpreter's behavior.
+    generator.begin_loop(false);
+    auto top_of_loop = generator.instruction_count();
+    auto test = m_test->generate_bytecode(generator);
+    if (!test.has_value()) {
+        generator.end_loop(0, 0);
+        return {};
+    }
+    auto jump_out = generator.emit({ Bytecode::Op::JumpIfFalse, 0, test.value().index });
+    if (!m_body->generate_bytecode(generator).has_value()) {
+        generator.end_loop(0, 0);
+        return {};
+    }
+    generator.emit({ Bytecode::Op::Jump, 0, 0, 0, (int)top_of_loop });
+    generator.patch_jump(jump_out);
+    generator.end_loop(0, 0);
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> DoWhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.begin_loop(false);
+    auto top_of_loop = generator.instruction_count();
+    if (!m_body->generate_bytecode(generator).has_value()) {
+        generator.end_loop(0, 0);
+        return {};
+    }
+    auto test = m_test->generate_bytecode(generator);
+    if (!test.has_value()) {
+        generator.end_loop(0, 0);
+        return {};
+    }
+    generator.emit({ Bytecode::Op::JumpIfTrue, 0, test.value().index, 0, (int)top_of_loop });
+    generator.end_loop(0, 0);
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> ForStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // A let/const init would need the wrapper scope from execute(); the
+    // VariableDeclaration codegen already rejects those.
+    if (m_init && !m_init->generate_bytecode(generator).has_value())
+        return {};
+
+    auto top_of_loop = generator.instruction_count();
+    Optional<size_t> jump_out;
+    if (m_test) {
+        auto test = m_test->generate_bytecode(generator);
+        if (!test.has_value())
+            return {};
+        jump_out = generator.emit({ Bytecode::Op::JumpIfFalse, 0, test.value().index });
+    }
+
+    generator.begin_loop(true);
+    if (!m_body->generate_bytecode(generator).has_value()) {
+        generator.end_loop(0, 0);
+        return {};
+    }
+
+    auto continue_target = generator.instruction_count();
+    if (m_update && !m_update->generate_bytecode(generator).has_value()) {
+        generator.end_loop(0, 0);
+        return {};
+    }
+    generator.emit({ Bytecode::Op::Jump, 0, 0, 0, (int)top_of_loop });
+
+    auto break_target = generator.instruction_count();
+    if (jump_out.has_value())
+        generator.patch_jump(jump_out.value());
+    generator.end_loop(continue_target, break_target);
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> BreakStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (!generator.in_breakable_loop())
+        return {};
+    generator.emit_break();
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> ContinueStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (!generator.in_breakable_loop())
+        return {};
+    generator.emit_continue();
+    return Bytecode::Register {};
+}
+
+Optional<Bytecode::Register> BooleanLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit({ Bytecode::Op::LoadConstant, dst.index, 0, 0, generator.add_constant(Value(m_value)) });
+    return dst;
+}
+
+Optional<Bytecode::Register> NumericLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit({ Bytecode::Op::LoadConstant, dst.index, 0, 0, generator.add_constant(Value(m_value)) });
+    return dst;
+}
+
+Optional<Bytecode::Register> StringLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit({ Bytecode::Op::LoadConstant, dst.index, 0, 0, generator.add_constant(js_string(generator.interpreter(), m_value)) });
+    return dst;
+}
+
+Optional<Bytecode::Register> NullLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit({ Bytecode::Op::LoadConstant, dst.index, 0, 0, generator.add_constant(js_null()) });
+    return dst;
+}
+
+Optional<Bytecode::Register> Identifier::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Copy locals into a fresh register so the value survives a later write
+    // to the same local within this expression, e.g. "a + (a = 1)".
+    auto dst = generator.allocate_register();
+    auto local = generator.lookup_local(m_string);
+    if (local.has_value())
+        generator.emit({ Bytecode::Op::Mov, dst.index, local.value().index });
+    else
+        generator.emit({ Bytecode::Op::GetVariable, dst.index, 0, 0, generator.add_name(m_string) });
+    return dst;
+}
+
+static Bytecode::Op bytecode_op_for_binary_op(BinaryOp op)
+{
+    switch (op) {
+    case BinaryOp::Addition:
+        return Bytecode::Op::Add;
+    case BinaryOp::Subtraction:
+        return Bytecode::Op::Sub;
+    case BinaryOp::Multiplication:
+        return Bytecode::Op::Mul;
+    case BinaryOp::Division:
+        return Bytecode::Op::Div;
+    case BinaryOp::Modulo:
+        return Bytecode::Op::Mod;
+    case BinaryOp::Exponentiation:
+        return Bytecode::Op::Exp;
+    case BinaryOp::TypedEquals:
+        return Bytecode::Op::TypedEquals;
+    case BinaryOp::TypedInequals:
+        return Bytecode::Op::TypedInequals;
+    case BinaryOp::AbstractEquals:
+        return Bytecode::Op::AbstractEquals;
+    case BinaryOp::AbstractInequals:
+        return Bytecode::Op::AbstractInequals;
+    case BinaryOp::GreaterThan:
+        return Bytecode::Op::GreaterThan;
+    case BinaryOp::GreaterThanEquals:
+        return Bytecode::Op::GreaterThanEquals;
+    case BinaryOp::LessThan:
+        return Bytecode::Op::LessThan;
+    case BinaryOp::LessThanEquals:
+        return Bytecode::Op::LessThanEquals;
+    case BinaryOp::BitwiseAnd:
+        return Bytecode::Op::BitwiseAnd;
+    case BinaryOp::BitwiseOr:
+        return Bytecode::Op::BitwiseOr;
+    case BinaryOp::BitwiseXor:
+        return Bytecode::Op::BitwiseXor;
+    case BinaryOp::LeftShift:
+        return Bytecode::Op::LeftShift;
+    case BinaryOp::RightShift:
+        return Bytecode::Op::RightShift;
+    case BinaryOp::UnsignedRightShift:
+        return Bytecode::Op::UnsignedRightShift;
+    case BinaryOp::In:
+        return Bytecode::Op::In;
+    case BinaryOp::InstanceOf:
+        return Bytecode::Op::InstanceOf;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+Optional<Bytecode::Register> BinaryExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto lhs = m_lhs->generate_bytecode(generator);
+    if (!lhs.has_value())
+        return {};
+    auto rhs = m_rhs->generate_bytecode(generator);
+    if (!rhs.has_value())
+        return {};
+    auto dst = generator.allocate_register();
+    generator.emit({ bytecode_op_for_binary_op(m_op), dst.index, lhs.value().index, rhs.value().index });
+    return dst;
+}
+
+Optional<Bytecode::Register> LogicalExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto result = generator.allocate_register();
+    auto lhs = m_lhs->generate_bytecode(generator);
+    if (!lhs.has_value())
+        return {};
+    generator.emit({ Bytecode::Op::Mov, result.index, lhs.value().index });
+
+    size_t jump_past_rhs = 0;
+    switch (m_op) {
+    case LogicalOp::And:
+        jump_past_rhs = generator.emit({ Bytecode::Op::JumpIfFalse, 0, result.index });
+        break;
+    case LogicalOp::Or:
+        jump_past_rhs = generator.emit({ Bytecode::Op::JumpIfTrue, 0, result.index });
+        break;
+    case LogicalOp::NullishCoalescing:
+        jump_past_rhs = generator.emit({ Bytecode::Op::JumpIfNotNullish, 0, result.index });
+        break;
+    }
+
+    auto rhs = m_rhs->generate_bytecode(generator);
+    if (!rhs.has_value())
+        return {};
+    generator.emit({ Bytecode::Op::Mov, result.index, rhs.value().index });
+    generator.patch_jump(jump_past_rhs);
+    return result;
+}
+
+Optional<Bytecode::Register> UnaryExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // typeof needs string allocation per hit and delete needs references;
+    // neither is worth carrying in the bytecode tier.
+    if (m_op == UnaryOp::Typeof || m_op == UnaryOp::Delete)
+        return {};
+    auto lhs = m_lhs->generate_bytecode(generator);
+    if (!lhs.has_value())
+        return {};
+    auto dst = generator.allocate_register();
+    switch (m_op) {
+    case UnaryOp::BitwiseNot:
+        generator.emit({ Bytecode::Op::BitwiseNot, dst.index, lhs.value().index });
+        break;
+    case UnaryOp::Not:
+        generator.emit({ Bytecode::Op::Not, dst.index, lhs.value().index });
+        break;
+    case UnaryOp::Plus:
+        generator.emit({ Bytecode::Op::UnaryPlus, dst.index, lhs.value().index });
+        break;
+    case UnaryOp::Minus:
+        generator.emit({ Bytecode::Op::UnaryMinus, dst.index, lhs.value().index });
+        break;
+    case UnaryOp::Void:
+        generator.emit({ Bytecode::Op::LoadConstant, dst.index, 0, 0, generator.add_constant(js_undefined()) });
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+    return dst;
+}
+
+Optional<Bytecode::Register> AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Only identifier targets; member expression stores go through
+    // to_reference() and Object::put, which stay on the AST path.
+    if (!m_lhs->is_identifier())
+        return {};
+    auto& name = static_cast<const Identifier&>(*m_lhs).string();
+
+    // Note the evaluation order: execute() computes the right-hand side
+    // before reading the old value for compound assignments.
+    auto rhs = m_rhs->generate_bytecode(generator);
+    if (!rhs.has_value())
+        return {};
+
+    auto local = generator.lookup_local(name);
+    auto result = rhs.value();
+
+    if (m_op != AssignmentOp::Assignment) {
+        Bytecode::Op op;
+        switch (m_op) {
+        case AssignmentOp::AdditionAssignment:
+            op = Bytecode::Op::Add;
+            break;
+        case AssignmentOp::SubtractionAssignment:
+            op = Bytecode::Op::Sub;
+            break;
+        case AssignmentOp::MultiplicationAssignment:
+            op = Bytecode::Op::Mul;
+            break;
+        case AssignmentOp::DivisionAssignment:
+            op = Bytecode::Op::Div;
+            break;
+        case AssignmentOp::LeftShiftAssignment:
+            op = Bytecode::Op::LeftShift;
+            break;
+        case AssignmentOp::RightShiftAssignment:
+            op = Bytecode::Op::RightShift;
+            break;
+        case AssignmentOp::UnsignedRightShiftAssignment:
+            op = Bytecode::Op::UnsignedRightShift;
+            break;
+        default:
+            ASSERT_NOT_REACHED();
+        }
+        Bytecode::Register old_value;
+        if (local.has_value()) {
+            old_value = local.value();
+        } else {
+            old_value = generator.allocate_register();
+            generator.emit({ Bytecode::Op::GetVariable, old_value.index, 0, 0, generator.add_name(name) });
+        }
+        result = generator.allocate_register();
+        generator.emit({ op, result.index, old_value.index, rhs.value().index });
+    }
+
+    if (local.has_value())
+        generator.emit({ Bytecode::Op::Mov, local.value().index, result.index });
+    else
+        generator.emit({ Bytecode::Op::SetVariable, 0, result.index, 0, generator.add_name(name) });
+    return result;
+}
+
+Optional<Bytecode::Register> UpdateExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (!m_argument->is_identifier())
+        return {};
+    auto& name = static_cast<const Identifier&>(*m_argument).string();
+    auto local = generator.lookup_local(name);
+
+    auto old_value = generator.allocate_register();
+    if (local.has_value())
+        generator.emit({ Bytecode::Op::Mov, old_value.index, local.value().index });
+    else
+        generator.emit({ Bytecode::Op::GetVariable, old_value.index, 0, 0, generator.add_name(name) });
+    generator.emit({ Bytecode::Op::ToNumber, old_value.index, old_value.index });
+
+    auto new_value = generator.allocate_register();
+    generator.emit({ m_op == UpdateOp::Increment ? Bytecode::Op::Increment : Bytecode::Op::Decrement, new_value.index, old_value.index });
+
+    if (local.has_value())
+        generator.emit({ Bytecode::Op::Mov, local.value().index, new_value.index });
+    else
+        generator.emit({ Bytecode::Op::SetVariable, 0, new_value.index, 0, generator.add_name(name) });
+    return m_prefixed ? new_value : old_value;
+}
+
+Optional<Bytecode::Register> ConditionalExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto result = generator.allocate_register();
+    auto test = m_test->generate_bytecode(generator);
+    if (!test.has_value())
+        return {};
+    auto jump_to_alternate = generator.emit({ Bytecode::Op::JumpIfFalse, 0, test.value().index });
+    auto consequent = m_consequent->generate_bytecode(generator);
+    if (!consequent.has_value())
+        return {};
+    generator.emit({ Bytecode::Op::Mov, result.index, consequent.value().index });
+    auto jump_to_end = generator.emit({ Bytecode::Op::Jump });
+    generator.patch_jump(jump_to_alternate);
+    auto alternate = m_alternate->generate_bytecode(generator);
+    if (!alternate.has_value())
+        return {};
+    generator.emit({ Bytecode::Op::Mov, result.index, alternate.value().index });
+    generator.patch_jump(jump_to_end);
+    return result;
+}
+
+Optional<Bytecode::Register> SequenceExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    Optional<Bytecode::Register> last;
+    for (auto& expression : m_expressions) {
+        last = expression.generate_bytecode(generator);
+        if (!last.has_value())
+            return {};
+    }
+    return last;
+}
+
 }
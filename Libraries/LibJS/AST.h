@@ -33,6 +33,7 @@
 #include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibJS/Bytecode.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Runtime/PropertyName.h>
 #include <LibJS/Runtime/Value.h>
@@ -53,6 +54,10 @@ public:
     virtual ~ASTNode() {}
     virtual const char* class_name() const = 0;
     virtual Value execute(Interpreter&) const = 0;
+    // Compiles this node for the bytecode tier, returning the register
+    // holding its result. An empty result means "not supported"; the whole
+    // function then stays on the AST interpreter.
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const { return {}; }
     virtual void dump(int indent) const;
     virtual bool is_identifier() const { return false; }
     virtual bool is_spread_expression() const { return false; }
@@ -85,6 +90,7 @@ public:
     }
 
     Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     const char* class_name() const override { return "ExpressionStatement"; }
     virtual void dump(int indent) const override;
 
@@ -108,6 +114,7 @@ public:
 
     const NonnullRefPtrVector<Statement>& children() const { return m_children; }
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     void add_variables(NonnullRefPtrVector<VariableDeclaration>);
@@ -224,6 +231,7 @@ public:
     const Expression* argument() const { return m_argument; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -246,6 +254,7 @@ public:
     const Statement* alternate() const { return m_alternate; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -268,6 +277,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -289,6 +299,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -314,6 +325,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -360,6 +372,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -386,6 +399,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -415,6 +429,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -433,6 +448,7 @@ public:
 
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     virtual const char* class_name() const override { return "SequenceExpression"; }
@@ -453,6 +469,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -469,6 +486,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -485,6 +503,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -498,6 +517,7 @@ public:
     explicit NullLiteral() {}
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -514,6 +534,7 @@ public:
     const FlyString& string() const { return m_string; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
     virtual bool is_identifier() const override { return true; }
     virtual Reference to_reference(Interpreter&) const override;
@@ -607,6 +628,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -632,6 +654,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -681,6 +704,7 @@ public:
     DeclarationKind declaration_kind() const { return m_declaration_kind; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     const NonnullRefPtrVector<VariableDeclarator>& declarations() const { return m_declarations; }
@@ -770,6 +794,8 @@ public:
 
     PropertyName computed_property_name(Interpreter&) const;
 
+    Value get_from_object(Interpreter&, Object&) const;
+
     String to_string_approximation() const;
 
 private:
@@ -779,6 +805,15 @@ private:
     NonnullRefPtr<Expression> m_object;
     NonnullRefPtr<Expression> m_property;
     bool m_computed { false };
+
+    // Monomorphic inline cache for non-computed accesses: as long as this
+    // site keeps seeing objects with the same shape, the property loads
+    // straight out of the object's storage with no hash lookup. The cached
+    // shape pointer doesn't keep the shape alive, so the cache only counts
+    // as valid if no garbage collection has happened since it was filled.
+    mutable Shape* m_cached_shape { nullptr };
+    mutable size_t m_cached_property_offset { 0 };
+    mutable size_t m_cache_gc_epoch { 0 };
 };
 
 class ConditionalExpression final : public Expression {
@@ -792,6 +827,7 @@ public:
 
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     virtual const char* class_name() const override { return "ConditionalExpression"; }
@@ -908,6 +944,7 @@ public:
     BreakStatement() {}
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     virtual const char* class_name() const override { return "BreakStatement"; }
@@ -918,6 +955,7 @@ public:
     ContinueStatement() {}
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     virtual const char* class_name() const override { return "ContinueStatement"; }
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS {
+namespace Bytecode {
+
+Generator::Generator(JS::Interpreter& interpreter, NonnullOwnPtr<Block> block)
+    : m_interpreter(interpreter)
+    , m_block(move(block))
+{
+}
+
+OwnPtr<Block> Generator::generate(JS::Interpreter& interpreter, const ScopeNode& body, const Vector<FlyString>& parameters)
+{
+    Generator generator(interpreter, make<Block>(interpreter.heap()));
+
+    for (auto& parameter : parameters) {
+        // Duplicate parameter names would need last-one-wins handling; not
+        // worth the bother here.
+        bool did_insert = false;
+        generator.m_locals.find_or_insert(parameter, generator.allocate_register().index, did_insert);
+        if (!did_insert)
+            return nullptr;
+    }
+    generator.m_block->set_parameter_count(parameters.size());
+
+    // The parser has already hoisted "var" declarations to the function
+    // level, so this covers every local. Anything lexically scoped bails
+    // out to the AST interpreter.
+    for (auto& declaration : body.variables()) {
+        if (declaration.declaration_kind() != DeclarationKind::Var)
+            return nullptr;
+        for (auto& declarator : declaration.declarations()) {
+            generator.m_locals.ensure(declarator.id().string(), [&] { return generator.allocate_register().index; });
+        }
+    }
+
+    for (auto& child : body.children()) {
+        if (!child.generate_bytecode(generator).has_value())
+            return nullptr;
+    }
+
+    generator.m_block->set_register_count(generator.m_register_count);
+    return move(generator.m_block);
+}
+
+Register Generator::allocate_register()
+{
+    return { m_register_count++ };
+}
+
+Optional<Register> Generator::lookup_local(const FlyString& name) const
+{
+    auto local = m_locals.get(name);
+    if (!local.has_value())
+        return {};
+    return Register { local.value() };
+}
+
+int Generator::add_constant(Value value)
+{
+    m_block->constant_list().append(value);
+    return m_block->constants().size() - 1;
+}
+
+int Generator::add_name(const FlyString& name)
+{
+    m_block->names().append(name);
+    return m_block->names().size() - 1;
+}
+
+size_t Generator::emit(Instruction instruction)
+{
+    m_block->instructions().append(instruction);
+    return m_block->instructions().size() - 1;
+}
+
+void Generator::patch_jump(size_t instruction_index)
+{
+    m_block->instructions()[instruction_index].index = (int)instruction_count();
+}
+
+void Generator::begin_loop(bool breakable)
+{
+    m_loop_stack.append({ breakable, {}, {} });
+}
+
+void Generator::end_loop(size_t continue_target, size_t break_target)
+{
+    auto context = m_loop_stack.take_last();
+    for (auto jump : context.break_jumps)
+        m_block->instructions()[jump].index = (int)break_target;
+    for (auto jump : context.continue_jumps)
+        m_block->instructions()[jump].index = (int)continue_target;
+}
+
+void Generator::emit_break()
+{
+    ASSERT(in_breakable_loop());
+    m_loop_stack.last().break_jumps.append(emit({ Op::Jump }));
+}
+
+void Generator::emit_continue()
+{
+    ASSERT(in_breakable_loop());
+    m_loop_stack.last().continue_jumps.append(emit({ Op::Jump }));
+}
+
+Value Interpreter::run(JS::Interpreter& interpreter, const Block& block, const Vector<Value>& arguments)
+{
+    // Registers are a MarkedValueList, so everything in flight is a GC root.
+    MarkedValueList register_list(interpreter.heap());
+    auto& registers = register_list.values();
+    registers.ensure_capacity(block.register_count());
+    for (int i = 0; i < block.register_count(); ++i)
+        registers.unchecked_append(js_undefined());
+
+    auto argument_count = min(arguments.size(), (size_t)block.parameter_count());
+    for (size_t i = 0; i < argument_count; ++i)
+        registers[i] = arguments[i];
+
+    auto& instructions = block.instructions();
+    auto& constants = block.constants();
+    auto& names = block.names();
+
+    size_t pc = 0;
+    while (pc < instructions.size()) {
+        auto& instruction = instructions[pc];
+        bool did_jump = false;
+        switch (instruction.op) {
+        case Op::LoadConstant:
+            registers[instruction.dst] = constants[instruction.index];
+            break;
+        case Op::Mov:
+            registers[instruction.dst] = registers[instruction.src1];
+            break;
+        case Op::Add:
+            registers[instruction.dst] = add(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::Sub:
+            registers[instruction.dst] = sub(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::Mul:
+            registers[instruction.dst] = mul(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::Div:
+            registers[instruction.dst] = div(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::Mod:
+            registers[instruction.dst] = mod(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::Exp:
+            registers[instruction.dst] = exp(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::TypedEquals:
+            registers[instruction.dst] = typed_eq(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::TypedInequals:
+            registers[instruction.dst] = Value(!typed_eq(interpreter, registers[instruction.src1], registers[instruction.src2]).as_bool());
+            break;
+        case Op::AbstractEquals:
+            registers[instruction.dst] = eq(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::AbstractInequals:
+            registers[instruction.dst] = Value(!eq(interpreter, registers[instruction.src1], registers[instruction.src2]).as_bool());
+            break;
+        case Op::GreaterThan:
+            registers[instruction.dst] = greater_than(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::GreaterThanEquals:
+            registers[instruction.dst] = greater_than_equals(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::LessThan:
+            registers[instruction.dst] = less_than(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::LessThanEquals:
+            registers[instruction.dst] = less_than_equals(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::BitwiseAnd:
+            registers[instruction.dst] = bitwise_and(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::BitwiseOr:
+            registers[instruction.dst] = bitwise_or(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::BitwiseXor:
+            registers[instruction.dst] = bitwise_xor(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::LeftShift:
+            registers[instruction.dst] = left_shift(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::RightShift:
+            registers[instruction.dst] = right_shift(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::UnsignedRightShift:
+            registers[instruction.dst] = unsigned_right_shift(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::In:
+            registers[instruction.dst] = in(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::InstanceOf:
+            registers[instruction.dst] = instance_of(interpreter, registers[instruction.src1], registers[instruction.src2]);
+            break;
+        case Op::BitwiseNot:
+            registers[instruction.dst] = bitwise_not(interpreter, registers[instruction.src1]);
+            break;
+        case Op::Not:
+            registers[instruction.dst] = Value(!registers[instruction.src1].to_boolean());
+            break;
+        case Op::UnaryPlus:
+            registers[instruction.dst] = unary_plus(interpreter, registers[instruction.src1]);
+            break;
+        case Op::UnaryMinus:
+            registers[instruction.dst] = unary_minus(interpreter, registers[instruction.src1]);
+            break;
+        case Op::ToNumber:
+            registers[instruction.dst] = registers[instruction.src1].to_number();
+            break;
+        case Op::Increment:
+            registers[instruction.dst] = Value(registers[instruction.src1].as_double() + 1);
+            break;
+        case Op::Decrement:
+            registers[instruction.dst] = Value(registers[instruction.src1].as_double() - 1);
+            break;
+        case Op::GetVariable: {
+            auto value = interpreter.get_variable(names[instruction.index]);
+            // An unresolvable identifier is a ReferenceError, exactly as in
+            // Identifier::execute(); the empty Value must not leak into
+            // other ops.
+            if (value.is_empty())
+                value = interpreter.throw_exception<ReferenceError>(String::format("'%s' not known", names[instruction.index].characters()));
+            registers[instruction.dst] = value;
+            break;
+        }
+        case Op::SetVariable:
+            interpreter.set_variable(names[instruction.index], registers[instruction.src1]);
+            break;
+        case Op::Jump:
+            pc = instruction.index;
+            did_jump = true;
+            break;
+        case Op::JumpIfFalse:
+            if (!registers[instruction.src1].to_boolean()) {
+                pc = instruction.index;
+                did_jump = true;
+            }
+            break;
+        case Op::JumpIfTrue:
+            if (registers[instruction.src1].to_boolean()) {
+                pc = instruction.index;
+                did_jump = true;
+            }
+            break;
+        case Op::JumpIfNotNullish: {
+            auto value = registers[instruction.src1];
+            if (!value.is_null() && !value.is_undefined()) {
+                pc = instruction.index;
+                did_jump = true;
+            }
+            break;
+        }
+        case Op::Return:
+            return registers[instruction.src1];
+        }
+        if (interpreter.exception())
+            return {};
+        if (!did_jump)
+            ++pc;
+    }
+    return js_undefined();
+}
+
+}
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/MarkedValueList.h>
+
+// A small register-based bytecode tier for function bodies. The generator
+// only understands a subset of the AST (arithmetic, comparisons, logic,
+// local/global variables, if/while/do-while/for, break/continue/return);
+// bodies containing anything else simply keep running through the AST
+// interpreter. Locals and parameters live in registers, so hot numeric
+// loops skip the LexicalEnvironment machinery entirely.
+
+namespace JS {
+namespace Bytecode {
+
+struct Register {
+    int index { 0 };
+};
+
+enum class Op : u8 {
+    LoadConstant,       // dst <- constants[index]
+    Mov,                // dst <- src1
+    Add,                // dst <- src1 (op) src2, likewise below
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Exp,
+    TypedEquals,
+    TypedInequals,
+    AbstractEquals,
+    AbstractInequals,
+    GreaterThan,
+    GreaterThanEquals,
+    LessThan,
+    LessThanEquals,
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+    LeftShift,
+    RightShift,
+    UnsignedRightShift,
+    In,
+    InstanceOf,
+    BitwiseNot,         // dst <- (op) src1, likewise below
+    Not,
+    UnaryPlus,
+    UnaryMinus,
+    ToNumber,
+    Increment,          // dst <- src1 + 1, src1 must already be a number
+    Decrement,          // dst <- src1 - 1, src1 must already be a number
+    GetVariable,        // dst <- lookup of names[index] (non-locals only)
+    SetVariable,        // names[index] <- src1 (non-locals only)
+    Jump,               // pc <- index
+    JumpIfFalse,        // pc <- index if !ToBoolean(src1)
+    JumpIfTrue,         // pc <- index if ToBoolean(src1)
+    JumpIfNotNullish,   // pc <- index unless src1 is null or undefined
+    Return,             // return src1
+};
+
+struct Instruction {
+    Op op { Op::LoadConstant };
+    int dst { 0 };
+    int src1 { 0 };
+    int src2 { 0 };
+    int index { 0 }; // constant index, name index or jump target
+};
+
+class Block {
+public:
+    explicit Block(Heap& heap)
+        : m_constants(heap)
+    {
+    }
+
+    const Vector<Instruction>& instructions() const { return m_instructions; }
+    Vector<Instruction>& instructions() { return m_instructions; }
+
+    // A MarkedValueList, so string constants created at generation time
+    // stay alive for as long as the block does.
+    const Vector<Value, 32>& constants() const { return const_cast<MarkedValueList&>(m_constants).values(); }
+    MarkedValueList& constant_list() { return m_constants; }
+
+    const Vector<FlyString>& names() const { return m_names; }
+    Vector<FlyString>& names() { return m_names; }
+
+    int register_count() const { return m_register_count; }
+    void set_register_count(int count) { m_register_count = count; }
+
+    // Parameters occupy the first registers, in declaration order.
+    int parameter_count() const { return m_parameter_count; }
+    void set_parameter_count(int count) { m_parameter_count = count; }
+
+private:
+    Vector<Instruction> m_instructions;
+    MarkedValueList m_constants;
+    Vector<FlyString> m_names;
+    int m_register_count { 0 };
+    int m_parameter_count { 0 };
+};
+
+class Generator {
+public:
+    // Returns nullptr if the body contains anything the bytecode tier
+    // doesn't understand; the caller then sticks with the AST interpreter.
+    static OwnPtr<Block> generate(JS::Interpreter&, const ScopeNode& body, const Vector<FlyString>& parameters);
+
+    Register allocate_register();
+    Optional<Register> lookup_local(const FlyString& name) const;
+
+    int add_constant(Value);
+    int add_name(const FlyString&);
+
+    size_t emit(Instruction);
+    size_t instruction_count() const { return m_block->instructions().size(); }
+    void patch_jump(size_t instruction_index);
+
+    JS::Interpreter& interpreter() { return m_interpreter; }
+
+    // break/continue bookkeeping. Only for-loops are breakable, matching
+    // the unwind handling in ForStatement::execute(); break inside a plain
+    // while-loop stays on the AST path.
+    void begin_loop(bool breakable);
+    void end_loop(size_t continue_target, size_t break_target);
+    bool in_breakable_loop() const { return !m_loop_stack.is_empty() && m_loop_stack.last().breakable; }
+    void emit_break();
+    void emit_continue();
+
+private:
+    Generator(JS::Interpreter&, NonnullOwnPtr<Block>);
+
+    struct LoopContext {
+        bool breakable { false };
+        Vector<size_t> break_jumps;
+        Vector<size_t> continue_jumps;
+    };
+
+    JS::Interpreter& m_interpreter;
+    OwnPtr<Block> m_block;
+    HashMap<FlyString, int> m_locals;
+    int m_register_count { 0 };
+    Vector<LoopContext> m_loop_stack;
+};
+
+class Interpreter {
+public:
+    static Value run(JS::Interpreter&, const Block&, const Vector<Value>& arguments);
+};
+
+}
+}
@@ -97,17 +97,10 @@ void Console::trace(String title)
 
 unsigned Console::count(String label)
 {
-    auto counter_value = m_counters.get(label);
-    if (!counter_value.has_value()) {
-        add_message(ConsoleMessageKind::Count, String::format("%s: 1", label.characters()));
-        m_counters.set(label, 1);
-        return 1;
-    }
-
-    auto new_counter_value = counter_value.value() + 1;
-    add_message(ConsoleMessageKind::Count, String::format("%s: %u", label.characters(), new_counter_value));
-    m_counters.set(label, new_counter_value);
-    return new_counter_value;
+    auto& counter_value = m_counters.ensure(label);
+    ++counter_value;
+    add_message(ConsoleMessageKind::Count, String::format("%s: %u", label.characters(), counter_value));
+    return counter_value;
 }
 
 bool Console::count_reset(String label)
@@ -26,14 +26,18 @@
 
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/MarkedValueList.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/PrimitiveString.h>
 #include <setjmp.h>
 #include <stdio.h>
+#include <time.h>
 
 #ifdef __serenity__
 #    include <serenity.h>
@@ -47,6 +51,13 @@
 
 namespace JS {
 
+static u64 monotonic_now_ms()
+{
+    struct timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
 Heap::Heap(Interpreter& interpreter)
     : m_interpreter(interpreter)
 {
@@ -84,16 +95,50 @@ Cell* Heap::allocate_cell(size_t size)
 
 void Heap::collect_garbage(CollectionType collection_type)
 {
-    if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
-        HashTable<Cell*> roots;
-        gather_roots(roots);
-        mark_live_cells(roots);
+    if (collection_type == CollectionType::CollectEverything) {
+        // Nothing is marked, so every cell in every generation gets swept.
+        ++m_gc_epoch;
+        u64 start_ms = monotonic_now_ms();
+        sweep_dead_cells(true);
+        m_remembered_cells.clear();
+        ++m_stats.full_collections;
+        m_stats.last_pause_ms = monotonic_now_ms() - start_ms;
+        m_stats.total_pause_ms += m_stats.last_pause_ms;
+        return;
+    }
+
+    if (m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
     }
-    sweep_dead_cells();
+    ++m_gc_epoch;
+    u64 start_ms = monotonic_now_ms();
+
+    // Most collections are minor: they only consider cells allocated since
+    // the last collection. Anything that survives a collection is promoted
+    // in place to the old generation (the conservative stack scan pins cells,
+    // so we can never move them) and is only looked at again by an occasional
+    // major collection. Minor collections find old->young pointers via the
+    // remembered set that Cell::did_mutate() maintains.
+    bool is_major_collection = ++m_minor_collections_since_last_major_gc >= m_max_minor_collections_between_major_gc;
+    if (is_major_collection)
+        m_minor_collections_since_last_major_gc = 0;
+
+    HashTable<Cell*> roots;
+    gather_roots(roots);
+    mark_live_cells(roots, is_major_collection);
+    sweep_dead_cells(is_major_collection);
+
+    // Every young cell either died or was just promoted, so nothing in the
+    // remembered set can point into the (now empty) young generation anymore.
+    m_remembered_cells.clear();
+
+    if (is_major_collection)
+        ++m_stats.major_collections;
+    else
+        ++m_stats.minor_collections;
+    m_stats.last_pause_ms = monotonic_now_ms() - start_ms;
+    m_stats.total_pause_ms += m_stats.last_pause_ms;
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -112,6 +157,13 @@ void Heap::gather_roots(HashTable<Cell*>& roots)
         }
     }
 
+    if (m_empty_string)
+        roots.set(m_empty_string);
+    for (auto* string : m_single_ascii_character_strings) {
+        if (string)
+            roots.set(string);
+    }
+
 #ifdef HEAP_DEBUG
     dbg() << "gather_roots:";
     for (auto* root : roots) {
@@ -198,56 +250,109 @@ Cell* Heap::cell_from_possible_pointer(FlatPtr pointer)
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    MarkingVisitor() {}
+    explicit MarkingVisitor(bool mark_old_generation)
+        : m_mark_old_generation(mark_old_generation)
+    {
+    }
 
     virtual void visit_impl(Cell* cell)
     {
         if (cell->is_marked())
             return;
+        if (!m_mark_old_generation && cell->is_old())
+            return;
 #ifdef HEAP_DEBUG
         dbg() << "  ! " << cell;
 #endif
         cell->set_marked(true);
-        cell->visit_children(*this);
+        m_work_queue.append(cell);
     }
+
+    // Children are marked via an explicit work queue rather than recursion,
+    // so deep graphs (long rope strings, linked lists built in JS, ...)
+    // can't overflow the native stack.
+    void mark_all_reachable()
+    {
+        while (!m_work_queue.is_empty())
+            m_work_queue.take_last()->visit_children(*this);
+    }
+
+private:
+    bool m_mark_old_generation { true };
+    Vector<Cell*> m_work_queue;
 };
 
-void Heap::mark_live_cells(const HashTable<Cell*>& roots)
+void Heap::mark_live_cells(const HashTable<Cell*>& roots, bool mark_old_generation)
 {
 #ifdef HEAP_DEBUG
     dbg() << "mark_live_cells:";
 #endif
-    MarkingVisitor visitor;
+    MarkingVisitor visitor(mark_old_generation);
     for (auto* root : roots)
         visitor.visit(root);
+
+    // In a minor collection the old generation is neither marked nor swept,
+    // but old cells mutated since the last collection may now be the only
+    // thing keeping a young cell alive, so mark through their children.
+    if (!mark_old_generation) {
+        for (auto* cell : m_remembered_cells)
+            cell->visit_children(visitor);
+    }
+
+    visitor.mark_all_reachable();
 }
 
-void Heap::sweep_dead_cells()
+void Heap::sweep_dead_cells(bool sweep_old_generation)
 {
 #ifdef HEAP_DEBUG
     dbg() << "sweep_dead_cells:";
 #endif
     Vector<HeapBlock*, 32> empty_blocks;
 
+    size_t swept_count = 0;
+    size_t surviving_count = 0;
+    size_t young_swept_count = 0;
+    size_t promoted_count = 0;
+
     for (auto& block : m_blocks) {
+        if (!sweep_old_generation && !block->has_young_cells())
+            continue;
         bool block_has_live_cells = false;
         block->for_each_cell([&](Cell* cell) {
-            if (cell->is_live()) {
-                if (!cell->is_marked()) {
+            if (!cell->is_live())
+                return;
+            if (!sweep_old_generation && cell->is_old()) {
+                block_has_live_cells = true;
+                return;
+            }
+            if (!cell->is_marked()) {
 #ifdef HEAP_DEBUG
-                    dbg() << "  ~ " << cell;
+                dbg() << "  ~ " << cell;
 #endif
-                    block->deallocate(cell);
-                } else {
-                    cell->set_marked(false);
-                    block_has_live_cells = true;
+                if (!cell->is_old())
+                    ++young_swept_count;
+                ++swept_count;
+                block->deallocate(cell);
+            } else {
+                cell->set_marked(false);
+                ++surviving_count;
+                if (!cell->is_old()) {
+                    cell->set_old(true);
+                    block->did_promote_cell();
+                    ++promoted_count;
                 }
+                block_has_live_cells = true;
             }
         });
         if (!block_has_live_cells)
             empty_blocks.append(block);
     }
 
+    m_stats.last_cells_swept = swept_count;
+    m_stats.last_cells_surviving = surviving_count;
+    size_t young_considered = young_swept_count + promoted_count;
+    m_stats.last_survivor_percent = young_considered ? promoted_count * 100 / young_considered : 0;
+
     for (auto* block : empty_blocks) {
 #ifdef HEAP_DEBUG
         dbg() << " - Reclaim HeapBlock @ " << block << ": cell_size=" << block->cell_size();
@@ -262,6 +367,78 @@ void Heap::sweep_dead_cells()
 #endif
 }
 
+void Heap::did_mutate_cell(Badge<Cell>, Cell& cell)
+{
+    m_remembered_cells.set(&cell);
+}
+
+class ReferenceCapturingVisitor final : public Cell::Visitor {
+public:
+    virtual void visit_impl(Cell* cell) override { m_references.append(cell); }
+    const Vector<Cell*>& references() const { return m_references; }
+
+private:
+    Vector<Cell*> m_references;
+};
+
+String Heap::generate_snapshot()
+{
+    JsonObject snapshot;
+    JsonArray blocks;
+    JsonObject census;
+    JsonArray cells;
+
+    for (auto& block : m_blocks) {
+        size_t live_count = 0;
+        block->for_each_cell([&](Cell* cell) {
+            if (!cell->is_live())
+                return;
+            ++live_count;
+
+            auto type = cell->class_name();
+            census.set(type, census.get(type).to_u32(0) + 1);
+
+            JsonObject cell_object;
+            cell_object.set("address", String::format("%p", cell));
+            cell_object.set("type", type);
+            cell_object.set("old", cell->is_old());
+            ReferenceCapturingVisitor visitor;
+            cell->visit_children(visitor);
+            JsonArray references;
+            for (auto* reference : visitor.references())
+                references.append(String::format("%p", reference));
+            cell_object.set("references", move(references));
+            cells.append(move(cell_object));
+        });
+
+        JsonObject block_object;
+        block_object.set("cell_size", (u32)block->cell_size());
+        block_object.set("cell_count", (u32)block->cell_count());
+        block_object.set("live_count", (u32)live_count);
+        blocks.append(move(block_object));
+    }
+
+    snapshot.set("blocks", move(blocks));
+    snapshot.set("census", move(census));
+    snapshot.set("cells", move(cells));
+    return snapshot.to_string();
+}
+
+PrimitiveString* Heap::empty_string()
+{
+    if (!m_empty_string)
+        m_empty_string = allocate<PrimitiveString>(String(""));
+    return m_empty_string;
+}
+
+PrimitiveString* Heap::single_ascii_character_string(u8 character)
+{
+    ASSERT(character < 0x80);
+    if (!m_single_ascii_character_strings[character])
+        m_single_ascii_character_strings[character] = allocate<PrimitiveString>(String((const char*)&character, 1));
+    return m_single_ascii_character_strings[character];
+}
+
 void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
 {
     ASSERT(!m_handles.contains(&impl));
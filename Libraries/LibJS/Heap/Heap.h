@@ -29,6 +29,7 @@
 #include <AK/HashTable.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/String.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
@@ -60,11 +61,42 @@ public:
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage);
 
+    struct GCStats {
+        size_t minor_collections { 0 };
+        size_t major_collections { 0 };
+        size_t full_collections { 0 };
+        u64 last_pause_ms { 0 };
+        u64 total_pause_ms { 0 };
+        size_t last_cells_swept { 0 };
+        size_t last_cells_surviving { 0 };
+        // Of the young cells considered by the last collection, how many
+        // survived (were promoted), in percent.
+        size_t last_survivor_percent { 0 };
+    };
+    const GCStats& stats() const { return m_stats; }
+
+    // JSON description of the live heap: per-block occupancy, a census of
+    // live cells by type, and each cell's outgoing references.
+    String generate_snapshot();
+
     Interpreter& interpreter() { return m_interpreter; }
 
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // Incremented by every collection. Anything caching a raw Cell* without
+    // keeping it alive (e.g. the inline caches in the AST) can compare epochs
+    // to find out whether the pointer may have been swept since it was cached.
+    size_t gc_epoch() const { return m_gc_epoch; }
+
+    void did_mutate_cell(Badge<Cell>, Cell&);
+
+    // Shared PrimitiveStrings for the empty string and single ASCII
+    // characters, so character-at-a-time code doesn't allocate a cell per
+    // character. Created lazily and kept alive as roots.
+    PrimitiveString* empty_string();
+    PrimitiveString* single_ascii_character_string(u8 character);
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -79,14 +111,18 @@ private:
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(const HashTable<Cell*>& live_cells);
-    void sweep_dead_cells();
+    void mark_live_cells(const HashTable<Cell*>& live_cells, bool mark_old_generation);
+    void sweep_dead_cells(bool sweep_old_generation);
 
     Cell* cell_from_possible_pointer(FlatPtr);
 
     size_t m_max_allocations_between_gc { 10000 };
     size_t m_allocations_since_last_gc { false };
 
+    size_t m_max_minor_collections_between_major_gc { 4 };
+    size_t m_minor_collections_since_last_major_gc { 0 };
+    size_t m_gc_epoch { 0 };
+
     bool m_should_collect_on_every_allocation { false };
 
     Interpreter& m_interpreter;
@@ -95,8 +131,17 @@ private:
 
     HashTable<MarkedValueList*> m_marked_value_lists;
 
+    // Old cells that may have acquired pointers into the young generation
+    // since the last collection. See Cell::did_mutate().
+    HashTable<Cell*> m_remembered_cells;
+
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+
+    GCStats m_stats;
+
+    PrimitiveString* m_empty_string { nullptr };
+    PrimitiveString* m_single_ascii_character_strings[128] {};
 };
 
 }
@@ -76,6 +76,7 @@ Cell* HeapBlock::allocate()
 {
     if (!m_freelist)
         return nullptr;
+    ++m_young_cell_count;
     return exchange(m_freelist, m_freelist->next);
 }
 
@@ -83,6 +84,10 @@ void HeapBlock::deallocate(Cell* cell)
 {
     ASSERT(cell->is_live());
     ASSERT(!cell->is_marked());
+    if (!cell->is_old()) {
+        ASSERT(m_young_cell_count > 0);
+        --m_young_cell_count;
+    }
     cell->~Cell();
     auto* freelist_entry = static_cast<FreelistEntry*>(cell);
     freelist_entry->set_live(false);
@@ -47,6 +47,14 @@ public:
     Cell* allocate();
     void deallocate(Cell*);
 
+    // Lets the sweep phase skip whole blocks during a minor collection.
+    bool has_young_cells() const { return m_young_cell_count > 0; }
+    void did_promote_cell()
+    {
+        ASSERT(m_young_cell_count > 0);
+        --m_young_cell_count;
+    }
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -78,6 +86,7 @@ private:
 
     Heap& m_heap;
     size_t m_cell_size { 0 };
+    size_t m_young_cell_count { 0 };
     FreelistEntry* m_freelist { nullptr };
     u8 m_storage[];
 };
@@ -71,9 +71,11 @@ private:
     size_t m_line_column = 1;
     bool m_log_errors = true;
 
-    static HashMap<String, TokenType> s_keywords;
-    static HashMap<String, TokenType> s_three_char_tokens;
-    static HashMap<String, TokenType> s_two_char_tokens;
+    // Keyed by StringView (the keys are string literals) so that lookups
+    // with views into the source don't allocate.
+    static HashMap<StringView, TokenType> s_keywords;
+    static HashMap<StringView, TokenType> s_three_char_tokens;
+    static HashMap<StringView, TokenType> s_two_char_tokens;
     static HashMap<char, TokenType> s_single_char_tokens;
 };
 
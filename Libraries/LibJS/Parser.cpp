@@ -1233,13 +1233,37 @@ void Parser::syntax_error(const String& message, size_t line, size_t column)
 
 void Parser::save_state()
 {
-    m_saved_state = m_parser_state;
+    SavedState state {
+        m_parser_state.m_lexer,
+        m_parser_state.m_current_token,
+        m_parser_state.m_has_errors,
+        {},
+        {}
+    };
+    for (auto& scope : m_parser_state.m_var_scopes)
+        state.m_var_scope_sizes.append(scope.size());
+    for (auto& scope : m_parser_state.m_let_scopes)
+        state.m_let_scope_sizes.append(scope.size());
+    m_saved_state = move(state);
 }
 
 void Parser::load_state()
 {
     ASSERT(m_saved_state.has_value());
-    m_parser_state = m_saved_state.value();
+    auto& saved_state = m_saved_state.value();
+    m_parser_state.m_lexer = saved_state.m_lexer;
+    m_parser_state.m_current_token = saved_state.m_current_token;
+    m_parser_state.m_has_errors = saved_state.m_has_errors;
+    // Drop any declarations hoisted during the failed speculation. Scope
+    // pushes are balanced, so anything past the recorded sizes is ours.
+    while (m_parser_state.m_var_scopes.size() > saved_state.m_var_scope_sizes.size())
+        m_parser_state.m_var_scopes.take_last();
+    for (size_t i = 0; i < m_parser_state.m_var_scopes.size(); ++i)
+        m_parser_state.m_var_scopes[i].shrink(saved_state.m_var_scope_sizes[i]);
+    while (m_parser_state.m_let_scopes.size() > saved_state.m_let_scope_sizes.size())
+        m_parser_state.m_let_scopes.take_last();
+    for (size_t i = 0; i < m_parser_state.m_let_scopes.size(); ++i)
+        m_parser_state.m_let_scopes[i].shrink(saved_state.m_let_scope_sizes[i]);
     m_saved_state.clear();
 }
 
@@ -107,7 +107,20 @@ private:
         explicit ParserState(Lexer);
     };
 
+    // Rewind snapshot for speculative parsing, see
+    // try_parse_arrow_function_expression(). Only the lexer position is
+    // copied; the hoisted-declaration scopes are rolled back to the recorded
+    // sizes on load_state(). Copying the scope stacks outright made every
+    // speculation O(n) in the declarations seen so far.
+    struct SavedState {
+        Lexer m_lexer;
+        Token m_current_token;
+        bool m_has_errors = false;
+        Vector<size_t> m_var_scope_sizes;
+        Vector<size_t> m_let_scope_sizes;
+    };
+
     ParserState m_parser_state;
-    Optional<ParserState> m_saved_state;
+    Optional<SavedState> m_saved_state;
 };
 }
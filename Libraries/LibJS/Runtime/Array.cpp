@@ -79,7 +79,7 @@ void Array::length_setter(Interpreter& interpreter, Value value)
         interpreter.throw_exception<RangeError>("Invalid array length");
         return;
     }
-    array->elements().resize(length.as_double());
+    array->resize_elements(length.as_double());
 }
 
 }
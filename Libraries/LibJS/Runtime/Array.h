@@ -39,7 +39,7 @@ public:
     explicit Array(Object& prototype);
     virtual ~Array() override;
 
-    i32 length() const { return static_cast<i32>(elements().size()); }
+    i32 length() const { return static_cast<i32>(max(elements().size(), sparse_elements_bound())); }
 
 private:
     virtual const char* class_name() const override { return "Array"; }
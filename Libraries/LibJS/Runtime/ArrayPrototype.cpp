@@ -92,13 +92,13 @@ Value ArrayPrototype::filter(Interpreter& interpreter)
     if (!callback)
         return {};
     auto this_value = interpreter.argument(1);
-    auto initial_array_size = array->elements().size();
+    auto initial_array_size = static_cast<size_t>(array->length());
     auto* new_array = Array::create(interpreter.global_object());
 
     for (size_t i = 0; i < initial_array_size; ++i) {
-        if (i >= array->elements().size())
+        if (i >= static_cast<size_t>(array->length()))
             break;
-        auto value = array->elements()[i];
+        auto value = array->element(i);
         if (value.is_empty())
             continue;
         MarkedValueList arguments(interpreter.heap());
@@ -123,11 +123,11 @@ Value ArrayPrototype::for_each(Interpreter& interpreter)
     if (!callback)
         return {};
     auto this_value = interpreter.argument(1);
-    auto initial_array_size = array->elements().size();
+    auto initial_array_size = static_cast<size_t>(array->length());
     for (size_t i = 0; i < initial_array_size; ++i) {
-        if (i >= array->elements().size())
+        if (i >= static_cast<size_t>(array->length()))
             break;
-        auto value = array->elements()[i];
+        auto value = array->element(i);
         if (value.is_empty())
             continue;
         MarkedValueList arguments(interpreter.heap());
@@ -154,15 +154,15 @@ Value ArrayPrototype::map(Interpreter& interpreter)
         return {};
 
     auto this_value = interpreter.argument(1);
-    auto initial_array_size = array->elements().size();
+    auto initial_array_size = static_cast<size_t>(array->length());
     auto* new_array = Array::create(interpreter.global_object());
-    new_array->elements().resize(initial_array_size);
+    new_array->resize_elements(initial_array_size);
 
     for (size_t i = 0; i < initial_array_size; ++i) {
-        if (i >= array->elements().size())
+        if (i >= static_cast<size_t>(array->length()))
             break;
 
-        auto value = array->elements()[i];
+        auto value = array->element(i);
         if (value.is_empty())
             continue;
 
@@ -175,7 +175,7 @@ Value ArrayPrototype::map(Interpreter& interpreter)
         if (interpreter.exception())
             return {};
 
-        new_array->elements()[i] = result;
+        new_array->put_by_index(i, result);
     }
     return Value(new_array);
 }
@@ -185,6 +185,13 @@ Value ArrayPrototype::push(Interpreter& interpreter)
     auto* array = array_from(interpreter);
     if (!array)
         return {};
+    if (static_cast<size_t>(array->length()) != array->elements().size()) {
+        // The array has (or had) sparse elements, so new elements have to go
+        // in at "length", which is past the end of the packed vector.
+        for (size_t i = 0; i < interpreter.argument_count(); ++i)
+            array->put_by_index(array->length(), interpreter.argument(i));
+        return Value(array->length());
+    }
     for (size_t i = 0; i < interpreter.argument_count(); ++i)
         array->elements().append(interpreter.argument(i));
     return Value(array->length());
@@ -205,6 +212,14 @@ Value ArrayPrototype::pop(Interpreter& interpreter)
     auto* array = array_from(interpreter);
     if (!array)
         return {};
+    if (static_cast<size_t>(array->length()) != array->elements().size()) {
+        auto index = array->length() - 1;
+        auto value = array->element(index);
+        array->resize_elements(index);
+        if (value.is_empty())
+            return js_undefined();
+        return value;
+    }
     if (array->elements().is_empty())
         return js_undefined();
     return array->elements().take_last().value_or(js_undefined());
@@ -223,10 +238,10 @@ Value ArrayPrototype::shift(Interpreter& interpreter)
 static Value join_array_with_separator(Interpreter& interpreter, const Array& array, StringView separator)
 {
     StringBuilder builder;
-    for (size_t i = 0; i < array.elements().size(); ++i) {
+    for (size_t i = 0; i < static_cast<size_t>(array.length()); ++i) {
         if (i != 0)
             builder.append(separator);
-        auto value = array.elements()[i];
+        auto value = array.element(i);
         if (!value.is_empty() && !value.is_undefined() && !value.is_null())
             builder.append(value.to_string());
     }
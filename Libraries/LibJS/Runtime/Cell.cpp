@@ -46,6 +46,11 @@ void Cell::Visitor::visit(Value value)
         visit_impl(value.as_cell());
 }
 
+void Cell::add_to_remembered_set()
+{
+    heap().did_mutate_cell({}, *this);
+}
+
 Heap& Cell::heap() const
 {
     return HeapBlock::from_cell(this)->heap();
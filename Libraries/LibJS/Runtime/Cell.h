@@ -45,6 +45,23 @@ public:
     bool is_live() const { return m_live; }
     void set_live(bool b) { m_live = b; }
 
+    // A cell becomes "old" by surviving a garbage collection. Old cells are
+    // never moved (the conservative stack scan forbids that) and are only
+    // considered for collection by the occasional major collection.
+    bool is_old() const { return m_old; }
+    void set_old(bool b) { m_old = b; }
+
+    // Generational write barrier. Call this after storing into a member that
+    // visit_children() would visit, anywhere outside the constructor. If this
+    // cell is already old, it gets added to the heap's remembered set so the
+    // next minor collection rescans it for pointers into the young generation.
+    void did_mutate()
+    {
+        if (!m_old)
+            return;
+        add_to_remembered_set();
+    }
+
     virtual const char* class_name() const = 0;
 
     class Visitor {
@@ -66,8 +83,11 @@ protected:
     Cell() {}
 
 private:
+    void add_to_remembered_set();
+
     bool m_mark { false };
     bool m_live { true };
+    bool m_old { false };
 };
 
 const LogStream& operator<<(const LogStream&, const Cell*);
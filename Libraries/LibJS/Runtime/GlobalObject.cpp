@@ -80,6 +80,8 @@ void GlobalObject::initialize()
 
     u8 attr = Attribute::Writable | Attribute::Configurable;
     put_native_function("gc", gc, 0, attr);
+    put_native_function("gcStats", gc_stats, 0, attr);
+    put_native_function("gcSnapshot", gc_snapshot, 0, attr);
     put_native_function("isNaN", is_nan, 1, attr);
     put_native_function("isFinite", is_finite, 1, attr);
 
@@ -130,6 +132,26 @@ Value GlobalObject::gc(Interpreter& interpreter)
     return js_undefined();
 }
 
+Value GlobalObject::gc_stats(Interpreter& interpreter)
+{
+    auto& stats = interpreter.heap().stats();
+    auto* object = Object::create_empty(interpreter, interpreter.global_object());
+    object->put("minorCollections", Value((i32)stats.minor_collections));
+    object->put("majorCollections", Value((i32)stats.major_collections));
+    object->put("fullCollections", Value((i32)stats.full_collections));
+    object->put("lastPauseMs", Value((double)stats.last_pause_ms));
+    object->put("totalPauseMs", Value((double)stats.total_pause_ms));
+    object->put("lastCellsSwept", Value((i32)stats.last_cells_swept));
+    object->put("lastCellsSurviving", Value((i32)stats.last_cells_surviving));
+    object->put("lastSurvivorPercent", Value((i32)stats.last_survivor_percent));
+    return object;
+}
+
+Value GlobalObject::gc_snapshot(Interpreter& interpreter)
+{
+    return js_string(interpreter, interpreter.heap().generate_snapshot());
+}
+
 Value GlobalObject::is_nan(Interpreter& interpreter)
 {
     return Value(interpreter.argument(0).to_number().is_nan());
@@ -56,6 +56,8 @@ private:
     virtual const char* class_name() const override { return "GlobalObject"; }
 
     static Value gc(Interpreter&);
+    static Value gc_stats(Interpreter&);
+    static Value gc_snapshot(Interpreter&);
     static Value is_nan(Interpreter&);
     static Value is_finite(Interpreter&);
 
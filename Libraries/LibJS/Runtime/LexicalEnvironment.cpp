@@ -24,7 +24,9 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <LibJS/AST.h>
 #include <LibJS/Runtime/LexicalEnvironment.h>
+#include <LibJS/Runtime/ScriptFunction.h>
 
 namespace JS {
 
@@ -38,6 +40,15 @@ LexicalEnvironment::LexicalEnvironment(HashMap<FlyString, Variable> variables, L
 {
 }
 
+LexicalEnvironment::LexicalEnvironment(const ScriptFunction& function, LexicalEnvironment* parent)
+    : m_parent(parent)
+    , m_slot_function(&function)
+{
+    m_slot_values.resize(function.local_names().size());
+    for (auto& value : m_slot_values)
+        value = js_undefined();
+}
+
 LexicalEnvironment::~LexicalEnvironment()
 {
 }
@@ -48,16 +59,40 @@ void LexicalEnvironment::visit_children(Visitor& visitor)
     visitor.visit(m_parent);
     for (auto& it : m_variables)
         visitor.visit(it.value.value);
+
+    visitor.visit(const_cast<ScriptFunction*>(m_slot_function));
+    for (auto& value : m_slot_values)
+        visitor.visit(value);
 }
 
 Optional<Variable> LexicalEnvironment::get(const FlyString& name) const
 {
+    if (m_slot_function) {
+        auto& names = m_slot_function->local_names();
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name)
+                return Variable { m_slot_values[i], DeclarationKind::Var };
+        }
+        return {};
+    }
     return m_variables.get(name);
 }
 
 void LexicalEnvironment::set(const FlyString& name, Variable variable)
 {
+    if (m_slot_function) {
+        auto& names = m_slot_function->local_names();
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                m_slot_values[i] = variable.value;
+                did_mutate();
+                return;
+            }
+        }
+        // Names the function doesn't know about fall through to the map.
+    }
     m_variables.set(name, variable);
+    did_mutate();
 }
 
 }
@@ -38,10 +38,16 @@ struct Variable {
     DeclarationKind declaration_kind;
 };
 
+class ScriptFunction;
+
 class LexicalEnvironment final : public Cell {
 public:
     LexicalEnvironment();
     LexicalEnvironment(HashMap<FlyString, Variable> variables, LexicalEnvironment* parent);
+    // Slot-based environment for calling a ScriptFunction: the local names
+    // live on the function, so entering a call only allocates value storage
+    // and lookup is a short scan instead of hashing.
+    LexicalEnvironment(const ScriptFunction&, LexicalEnvironment* parent);
     virtual ~LexicalEnvironment() override;
 
     LexicalEnvironment* parent() { return m_parent; }
@@ -59,6 +65,9 @@ private:
 
     LexicalEnvironment* m_parent { nullptr };
     HashMap<FlyString, Variable> m_variables;
+
+    const ScriptFunction* m_slot_function { nullptr };
+    Vector<Value> m_slot_values;
 };
 
 }
@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/QuickSort.h>
 #include <AK/String.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
@@ -39,6 +40,10 @@
 
 namespace JS {
 
+// How far past the end of the packed element vector a write may land and
+// still grow the vector. Anything beyond that goes to the sparse map.
+static const size_t sparse_elements_slack = 512;
+
 Object* Object::create_empty(Interpreter&, GlobalObject& global_object)
 {
     return global_object.heap().allocate<Object>(global_object.object_prototype());
@@ -77,6 +82,7 @@ void Object::set_prototype(Object* new_prototype)
         return;
     }
     m_shape = m_shape->create_prototype_transition(new_prototype);
+    did_mutate();
 }
 
 bool Object::has_prototype(const Object* prototype) const
@@ -151,6 +157,30 @@ Value Object::get_own_properties(const Object& this_object, GetOwnPropertyMode k
         ++property_index;
     }
 
+    if (!m_sparse_elements.is_empty()) {
+        Vector<u32> sparse_indices;
+        sparse_indices.ensure_capacity(m_sparse_elements.size());
+        for (auto& it : m_sparse_elements)
+            sparse_indices.append(it.key);
+        quick_sort(sparse_indices);
+
+        for (auto index : sparse_indices) {
+            auto value = m_sparse_elements.get(index).value();
+            if (kind == GetOwnPropertyMode::Key) {
+                properties_array->put_by_index(property_index, js_string(interpreter(), String::number(index)));
+            } else if (kind == GetOwnPropertyMode::Value) {
+                properties_array->put_by_index(property_index, value);
+            } else {
+                auto* entry_array = Array::create(interpreter().global_object());
+                entry_array->put_by_index(0, js_string(interpreter(), String::number(index)));
+                entry_array->put_by_index(1, value);
+                properties_array->put_by_index(property_index, entry_array);
+            }
+
+            ++property_index;
+        }
+    }
+
     for (auto& it : this_object.shape().property_table_ordered()) {
         if (it.value.attributes & attributes) {
             size_t offset = it.value.offset + property_index;
@@ -191,6 +221,7 @@ void Object::set_shape(Shape& new_shape)
 {
     m_storage.resize(new_shape.property_count());
     m_shape = &new_shape;
+    did_mutate();
 }
 
 bool Object::define_property(const FlyString& property_name, const Object& descriptor, bool throw_exceptions)
@@ -258,6 +289,7 @@ bool Object::put_own_property(Object& this_object, const FlyString& property_nam
         interpreter.pop_call_frame();
     } else {
         m_storage[metadata.value().offset] = value;
+        did_mutate();
     }
     return true;
 }
@@ -270,6 +302,7 @@ Value Object::delete_property(PropertyName property_name)
             elements()[property_name.as_number()] = {};
             return Value(true);
         }
+        m_sparse_elements.remove(property_name.as_number());
         return Value(true);
     }
     auto metadata = shape().lookup(property_name.as_string());
@@ -293,6 +326,7 @@ void Object::ensure_shape_is_unique()
         return;
 
     m_shape = m_shape->create_unique_clone();
+    did_mutate();
 }
 
 Value Object::get_by_index(i32 property_index) const
@@ -314,6 +348,12 @@ Value Object::get_by_index(i32 property_index) const
                 return {};
             return value;
         }
+        if (static_cast<size_t>(property_index) < object->m_sparse_elements_bound) {
+            auto value = object->m_sparse_elements.get(property_index);
+            if (value.has_value())
+                return value.value();
+            return {};
+        }
         object = object->prototype();
     }
     return {};
@@ -348,14 +388,68 @@ bool Object::put_by_index(i32 property_index, Value value, u8 attributes)
     ASSERT(!value.is_empty());
     if (property_index < 0)
         return put(String::number(property_index), value, attributes);
-    // FIXME: Implement some kind of sparse storage for arrays with huge indices.
-    // Also: Take attributes into account here
-    if (static_cast<size_t>(property_index) >= m_elements.size())
+    // FIXME: Take attributes into account here
+    if (static_cast<size_t>(property_index) >= m_elements.size() + sparse_elements_slack) {
+        // Way past the end of the packed vector: store in the sparse map
+        // instead of materializing a huge run of holes.
+        m_sparse_elements.set(property_index, value);
+        if (static_cast<size_t>(property_index) >= m_sparse_elements_bound)
+            m_sparse_elements_bound = property_index + 1;
+        did_mutate();
+        return true;
+    }
+    if (static_cast<size_t>(property_index) >= m_elements.size()) {
         m_elements.resize(property_index + 1);
+        // If the packed vector has grown into sparse territory, fold the
+        // sparse entries it now covers back in.
+        if (!m_sparse_elements.is_empty()) {
+            Vector<u32> moved_keys;
+            for (auto& it : m_sparse_elements) {
+                if (it.key < m_elements.size()) {
+                    m_elements[it.key] = it.value;
+                    moved_keys.append(it.key);
+                }
+            }
+            for (auto key : moved_keys)
+                m_sparse_elements.remove(key);
+        }
+    }
     m_elements[property_index] = value;
+    did_mutate();
     return true;
 }
 
+Value Object::element(u32 index) const
+{
+    if (index < m_elements.size())
+        return m_elements[index];
+    auto value = m_sparse_elements.get(index);
+    if (value.has_value())
+        return value.value();
+    return {};
+}
+
+void Object::resize_elements(size_t new_size)
+{
+    if (new_size <= m_elements.size()) {
+        m_elements.resize(new_size);
+        m_sparse_elements.clear();
+        m_sparse_elements_bound = 0;
+    } else if (m_sparse_elements.is_empty() && new_size <= m_elements.size() + sparse_elements_slack) {
+        m_elements.resize(new_size);
+    } else {
+        Vector<u32> removed_keys;
+        for (auto& it : m_sparse_elements) {
+            if (it.key >= new_size)
+                removed_keys.append(it.key);
+        }
+        for (auto key : removed_keys)
+            m_sparse_elements.remove(key);
+        m_sparse_elements_bound = new_size;
+    }
+    did_mutate();
+}
+
 bool Object::put(const FlyString& property_name, Value value, u8 attributes)
 {
     ASSERT(!value.is_empty());
@@ -416,6 +510,9 @@ void Object::visit_children(Cell::Visitor& visitor)
 
     for (auto& value : m_elements)
         visitor.visit(value);
+
+    for (auto& it : m_sparse_elements)
+        visitor.visit(it.value);
 }
 
 bool Object::has_property(const FlyString& property_name) const
@@ -436,9 +533,9 @@ bool Object::has_own_property(const FlyString& property_name) const
     if (ok && property_index >= 0) {
         if (is_string_object())
             return property_index < (i32)static_cast<const StringObject*>(this)->primitive_string().string().length();
-        if (static_cast<size_t>(property_index) >= m_elements.size())
-            return false;
-        return !m_elements[property_index].is_empty();
+        if (static_cast<size_t>(property_index) < m_elements.size())
+            return !m_elements[property_index].is_empty();
+        return m_sparse_elements.contains(property_index);
     }
     return shape().lookup(property_name).has_value();
 }
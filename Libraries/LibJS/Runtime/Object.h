@@ -114,7 +114,31 @@ public:
     Value get_direct(size_t index) const { return m_storage[index]; }
 
     const Vector<Value>& elements() const { return m_elements; }
-    Vector<Value>& elements() { return m_elements; }
+
+    // Indexed elements far past the end of the packed vector live in a hash
+    // map instead, so "a[1000000] = 1" doesn't materialize a million holes.
+    // See put_by_index().
+    bool has_sparse_elements() const { return !m_sparse_elements.is_empty(); }
+    size_t sparse_elements_bound() const { return m_sparse_elements_bound; }
+
+    // Own indexed element, whether packed or sparse. An empty value means
+    // there's a hole at this index.
+    Value element(u32 index) const;
+
+    // Truncates or extends the indexed storage, like assigning to an Array's
+    // "length". Growth far beyond the packed vector only moves the bound.
+    void resize_elements(size_t new_size);
+
+    // Handing out a mutable reference counts as a write for the generational
+    // write barrier. Note that callers must not allocate cells between calling
+    // this and writing through the reference, or a minor collection could
+    // still miss the new pointer; reuse of a stale reference after allocating
+    // has the same problem.
+    Vector<Value>& elements()
+    {
+        did_mutate();
+        return m_elements;
+    }
 
 private:
     void set_shape(Shape&);
@@ -123,6 +147,12 @@ private:
     Shape* m_shape { nullptr };
     Vector<Value> m_storage;
     Vector<Value> m_elements;
+
+    // Dictionary-mode storage for indices way past m_elements.size().
+    // m_sparse_elements_bound is one past the highest index ever stored
+    // here, i.e. what an Array's "length" has to cover.
+    HashMap<u32, Value> m_sparse_elements;
+    size_t m_sparse_elements_bound { 0 };
 };
 
 }
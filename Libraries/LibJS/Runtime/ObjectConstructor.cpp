@@ -76,12 +76,18 @@ Value ObjectConstructor::get_own_property_names(Interpreter& interpreter)
         return {};
     auto* result = Array::create(interpreter.global_object());
     for (size_t i = 0; i < object->elements().size(); ++i) {
-        if (!object->elements()[i].is_empty())
-            result->elements().append(js_string(interpreter, String::number(i)));
+        if (!object->elements()[i].is_empty()) {
+            // Allocate the string before calling elements(), so that a GC
+            // triggered by the allocation can't run between the write barrier
+            // and the append.
+            auto* string = js_string(interpreter, String::number(i));
+            result->elements().append(string);
+        }
     }
 
     for (auto& it : object->shape().property_table_ordered()) {
-        result->elements().append(js_string(interpreter, it.key));
+        auto* string = js_string(interpreter, it.key);
+        result->elements().append(string);
     }
     return result;
 }
@@ -24,6 +24,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/PrimitiveString.h>
@@ -35,18 +37,72 @@ PrimitiveString::PrimitiveString(String string)
 {
 }
 
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_lhs(&lhs)
+    , m_rhs(&rhs)
+    , m_is_rope(true)
+{
+}
+
 PrimitiveString::~PrimitiveString()
 {
 }
 
+void PrimitiveString::visit_children(Visitor& visitor)
+{
+    Cell::visit_children(visitor);
+    visitor.visit(m_lhs);
+    visitor.visit(m_rhs);
+}
+
+void PrimitiveString::flatten() const
+{
+    // Iterative in-order walk; a long "s += x" loop builds a rope as deep
+    // as the number of concatenations, so recursing here would blow the
+    // stack. Only this node caches the result; interior nodes that someone
+    // else still references flatten on their own when asked.
+    StringBuilder builder;
+    Vector<const PrimitiveString*, 32> stack;
+    stack.append(this);
+    while (!stack.is_empty()) {
+        auto* current = stack.take_last();
+        if (current->m_is_rope) {
+            stack.append(current->m_rhs);
+            stack.append(current->m_lhs);
+            continue;
+        }
+        builder.append(current->m_string);
+    }
+    m_string = builder.to_string();
+    m_is_rope = false;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
+}
+
 PrimitiveString* js_string(Heap& heap, String string)
 {
+    if (string.is_empty())
+        return heap.empty_string();
+    if (string.length() == 1) {
+        auto ch = (u8)string.characters()[0];
+        if (ch < 0x80)
+            return heap.single_ascii_character_string(ch);
+    }
     return heap.allocate<PrimitiveString>(move(string));
 }
 
 PrimitiveString* js_string(Interpreter& interpreter, String string)
 {
-    return js_string(interpreter.heap(), string);
+    return js_string(interpreter.heap(), move(string));
+}
+
+PrimitiveString* js_rope_string(Heap& heap, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    if (lhs.is_empty())
+        return &rhs;
+    if (rhs.is_empty())
+        return &lhs;
+    return heap.allocate<PrimitiveString>(lhs, rhs);
 }
 
 }
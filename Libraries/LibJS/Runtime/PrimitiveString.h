@@ -34,17 +34,35 @@ namespace JS {
 class PrimitiveString final : public Cell {
 public:
     explicit PrimitiveString(String);
+    // Rope concatenation: holds on to both halves and only builds the
+    // combined string when somebody asks for it. This makes "s += x" loops
+    // O(n) overall instead of quadratic.
+    PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs);
     virtual ~PrimitiveString();
 
-    const String& string() const { return m_string; }
+    const String& string() const
+    {
+        if (m_is_rope)
+            flatten();
+        return m_string;
+    }
+
+    bool is_empty() const { return !m_is_rope && m_string.is_empty(); }
 
 private:
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_children(Visitor&) override;
+
+    void flatten() const;
 
-    String m_string;
+    mutable String m_string;
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
+    mutable bool m_is_rope { false };
 };
 
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(Interpreter&, String);
+PrimitiveString* js_rope_string(Heap&, PrimitiveString& lhs, PrimitiveString& rhs);
 
 }
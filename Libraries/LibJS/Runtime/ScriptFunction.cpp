@@ -26,6 +26,7 @@
 
 #include <AK/Function.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
@@ -73,38 +74,53 @@ void ScriptFunction::visit_children(Visitor& visitor)
     visitor.visit(m_parent_environment);
 }
 
-LexicalEnvironment* ScriptFunction::create_environment()
+const Vector<FlyString>& ScriptFunction::local_names() const
 {
-    HashMap<FlyString, Variable> variables;
-    for (auto& parameter : m_parameters) {
-        variables.set(parameter, { js_undefined(), DeclarationKind::Var });
-    }
-
-    if (body().is_scope_node()) {
-        for (auto& declaration : static_cast<const ScopeNode&>(body()).variables()) {
-            for (auto& declarator : declaration.declarations()) {
-                variables.set(declarator.id().string(), { js_undefined(), DeclarationKind::Var });
+    if (!m_computed_local_names) {
+        m_computed_local_names = true;
+        for (auto& parameter : m_parameters) {
+            if (!m_local_names.contains_slow(parameter))
+                m_local_names.append(parameter);
+        }
+        if (body().is_scope_node()) {
+            for (auto& declaration : static_cast<const ScopeNode&>(body()).variables()) {
+                for (auto& declarator : declaration.declarations()) {
+                    if (!m_local_names.contains_slow(declarator.id().string()))
+                        m_local_names.append(declarator.id().string());
+                }
             }
         }
     }
-    if (variables.is_empty())
+    return m_local_names;
+}
+
+LexicalEnvironment* ScriptFunction::create_environment()
+{
+    if (local_names().is_empty())
         return m_parent_environment;
-    return heap().allocate<LexicalEnvironment>(move(variables), m_parent_environment);
+    return heap().allocate<LexicalEnvironment>(*this, m_parent_environment);
 }
 
 Value ScriptFunction::call(Interpreter& interpreter)
 {
+    if (!m_tried_bytecode) {
+        m_tried_bytecode = true;
+        if (body().is_scope_node())
+            m_bytecode_block = Bytecode::Generator::generate(interpreter, static_cast<const ScopeNode&>(body()), m_parameters);
+    }
+    if (m_bytecode_block)
+        return Bytecode::Interpreter::run(interpreter, *m_bytecode_block, interpreter.call_frame().arguments);
+
     auto& argument_values = interpreter.call_frame().arguments;
-    ArgumentVector arguments;
     for (size_t i = 0; i < m_parameters.size(); ++i) {
-        auto name = parameters()[i];
         auto value = js_undefined();
         if (i < argument_values.size())
             value = argument_values[i];
-        arguments.append({ name, value });
-        interpreter.current_environment()->set(name, { value, DeclarationKind::Var });
+        interpreter.current_environment()->set(m_parameters[i], { value, DeclarationKind::Var });
     }
-    return interpreter.run(m_body, arguments, ScopeType::Function);
+    // enter_scope() ignores the argument list for function scopes; the
+    // parameters were just written into the environment above.
+    return interpreter.run(m_body, {}, ScopeType::Function);
 }
 
 Value ScriptFunction::construct(Interpreter& interpreter)
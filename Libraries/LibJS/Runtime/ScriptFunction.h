@@ -26,10 +26,15 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <LibJS/Runtime/Function.h>
 
 namespace JS {
 
+namespace Bytecode {
+class Block;
+}
+
 class ScriptFunction final : public Function {
 public:
     static ScriptFunction* create(GlobalObject&, const FlyString& name, const Statement& body, Vector<FlyString> parameters, LexicalEnvironment* parent_environment);
@@ -40,6 +45,11 @@ public:
     const Statement& body() const { return m_body; }
     const Vector<FlyString>& parameters() const { return m_parameters; };
 
+    // Parameter and hoisted variable names, deduplicated, in slot order.
+    // Computed once on the first call and shared by every slot-based
+    // LexicalEnvironment this function creates.
+    const Vector<FlyString>& local_names() const;
+
     virtual Value call(Interpreter&) override;
     virtual Value construct(Interpreter&) override;
 
@@ -58,6 +68,14 @@ private:
     NonnullRefPtr<Statement> m_body;
     const Vector<FlyString> m_parameters;
     LexicalEnvironment* m_parent_environment { nullptr };
+
+    // Compiled lazily on the first call; stays null if the body contains
+    // anything the bytecode tier doesn't support.
+    OwnPtr<Bytecode::Block> m_bytecode_block;
+    bool m_tried_bytecode { false };
+
+    mutable Vector<FlyString> m_local_names;
+    mutable bool m_computed_local_names { false };
 };
 
 }
@@ -47,6 +47,7 @@ Shape* Shape::create_put_transition(const FlyString& property_name, u8 attribute
         return existing_shape;
     auto* new_shape = heap().allocate<Shape>(this, property_name, attributes, TransitionType::Put);
     m_forward_transitions.set(key, new_shape);
+    did_mutate();
     return new_shape;
 }
 
@@ -57,12 +58,21 @@ Shape* Shape::create_configure_transition(const FlyString& property_name, u8 att
         return existing_shape;
     auto* new_shape = heap().allocate<Shape>(this, property_name, attributes, TransitionType::Configure);
     m_forward_transitions.set(key, new_shape);
+    did_mutate();
     return new_shape;
 }
 
 Shape* Shape::create_prototype_transition(Object* new_prototype)
 {
-    return heap().allocate<Shape>(this, new_prototype);
+    // Cache these like put/configure transitions, so every object built the
+    // same way ends up with the same shape. This is what makes two `new Foo`
+    // instances comparable by shape pointer.
+    if (auto* existing_shape = m_prototype_transitions.get(new_prototype).value_or(nullptr))
+        return existing_shape;
+    auto* new_shape = heap().allocate<Shape>(this, new_prototype);
+    m_prototype_transitions.set(new_prototype, new_shape);
+    did_mutate();
+    return new_shape;
 }
 
 Shape::Shape()
@@ -96,6 +106,8 @@ void Shape::visit_children(Cell::Visitor& visitor)
     visitor.visit(m_previous);
     for (auto& it : m_forward_transitions)
         visitor.visit(it.value);
+    for (auto& it : m_prototype_transitions)
+        visitor.visit(it.value);
 }
 
 Optional<PropertyMetadata> Shape::lookup(const FlyString& property_name) const
@@ -95,7 +95,11 @@ public:
 
     Vector<Property> property_table_ordered() const;
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype)
+    {
+        m_prototype = new_prototype;
+        did_mutate();
+    }
 
     void remove_property_from_unique_shape(const FlyString&, size_t offset);
     void add_property_to_unique_shape(const FlyString&, u8 attributes);
@@ -110,6 +114,7 @@ private:
     mutable OwnPtr<HashMap<FlyString, PropertyMetadata>> m_property_table;
 
     HashMap<TransitionKey, Shape*> m_forward_transitions;
+    HashMap<Object*, Shape*> m_prototype_transitions;
     Shape* m_previous { nullptr };
     FlyString m_property_name;
     u8 m_attributes { 0 };
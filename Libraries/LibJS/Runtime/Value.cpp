@@ -298,8 +298,13 @@ Value add(Interpreter& interpreter, Value lhs, Value rhs)
     auto lhs_primitive = lhs.to_primitive(interpreter);
     auto rhs_primitive = rhs.to_primitive(interpreter);
 
-    if (lhs_primitive.is_string() || rhs_primitive.is_string())
-        return js_string(interpreter.heap(), String::format("%s%s", lhs_primitive.to_string().characters(), rhs_primitive.to_string().characters()));
+    if (lhs_primitive.is_string() || rhs_primitive.is_string()) {
+        // Concatenation builds a lazy rope instead of copying both sides;
+        // see PrimitiveString::flatten().
+        auto* lhs_string = lhs_primitive.is_string() ? &lhs_primitive.as_string() : js_string(interpreter, lhs_primitive.to_string());
+        auto* rhs_string = rhs_primitive.is_string() ? &rhs_primitive.as_string() : js_string(interpreter, rhs_primitive.to_string());
+        return js_rope_string(interpreter.heap(), *lhs_string, *rhs_string);
+    }
 
     return Value(lhs_primitive.to_number().as_double() + rhs_primitive.to_number().as_double());
 }
@@ -58,8 +58,17 @@ Editor::~Editor()
 
 void Editor::add_to_history(const String& line)
 {
-    if ((m_history.size() + 1) > m_history_capacity)
+    if ((m_history.size() + 1) > m_history_capacity) {
         m_history.take_first();
+        // Every history index just shifted down by one.
+        for (auto& bucket : m_history_prefix_index) {
+            bucket.value.remove_all_matching([](size_t index) { return index == 0; });
+            for (auto& index : bucket.value)
+                --index;
+        }
+    }
+    if (!line.is_empty())
+        m_history_prefix_index.ensure((u32)(u8)line[0]).append(m_history.size());
     m_history.append(line);
 }
 
@@ -782,13 +791,32 @@ bool Editor::search(const StringView& phrase, bool allow_empty, bool from_beginn
     // do not search for empty strings
     if (allow_empty || phrase.length() > 0) {
         size_t search_offset = m_search_offset;
-        for (size_t i = m_history_cursor; i > 0; --i) {
-            auto contains = from_beginning ? m_history[i - 1].starts_with(phrase) : m_history[i - 1].contains(phrase);
-            if (contains) {
-                last_matching_offset = i - 1;
-                if (search_offset == 0)
+        auto take_match = [&](size_t index) -> bool {
+            last_matching_offset = index;
+            if (search_offset == 0)
+                return true;
+            --search_offset;
+            return false;
+        };
+        if (from_beginning && phrase.length() > 0) {
+            // Only entries starting with the same byte can possibly match,
+            // so walk just that prefix bucket instead of all of history.
+            auto bucket = m_history_prefix_index.find((u32)(u8)phrase[0]);
+            if (bucket != m_history_prefix_index.end()) {
+                auto& indices = bucket->value;
+                for (size_t i = indices.size(); i > 0; --i) {
+                    auto index = indices[i - 1];
+                    if (index >= m_history_cursor)
+                        continue;
+                    if (m_history[index].starts_with(phrase) && take_match(index))
+                        break;
+                }
+            }
+        } else {
+            for (size_t i = m_history_cursor; i > 0; --i) {
+                auto contains = from_beginning ? m_history[i - 1].starts_with(phrase) : m_history[i - 1].contains(phrase);
+                if (contains && take_match(i - 1))
                     break;
-                --search_offset;
             }
         }
 
@@ -880,12 +908,39 @@ void Editor::refresh_display()
             fputs((char*)m_pending_chars.data(), stdout);
             m_pending_chars.clear();
             m_drawn_cursor = m_cursor;
+            m_drawn_buffer = m_buffer;
             m_cached_buffer_size = m_buffer.size();
             fflush(stdout);
             return;
         }
     }
 
+    // If the prompt is still in place, nothing is styled, and both the old
+    // and the new content fit on a single line, we only have to repaint from
+    // the first character that actually changed.
+    bool can_patch_line = m_cached_prompt_valid && !has_cleaned_up
+        && m_spans_starting.is_empty() && m_spans_ending.is_empty()
+        && current_prompt_length() + max(m_buffer.size(), m_cached_buffer_size) < m_num_columns;
+
+    if (can_patch_line) {
+        size_t common = 0;
+        auto limit = min(m_buffer.size(), m_drawn_buffer.size());
+        while (common < limit && m_buffer[common] == m_drawn_buffer[common])
+            ++common;
+        vt_move_absolute(m_origin_x, common + current_prompt_length() + m_origin_y);
+        vt_clear_to_end_of_line();
+        for (size_t i = common; i < m_buffer.size(); ++i)
+            fputc(m_buffer[i], stdout);
+        m_pending_chars.clear();
+        m_drawn_buffer = m_buffer;
+        m_refresh_needed = false;
+        m_cached_buffer_size = m_buffer.size();
+        m_chars_inserted_in_the_middle = 0;
+        reposition_cursor();
+        fflush(stdout);
+        return;
+    }
+
     // ouch, reflow entire line
     // FIXME: handle multiline stuff
     if (!has_cleaned_up) {
@@ -912,6 +967,7 @@ void Editor::refresh_display()
     }
     vt_apply_style({}); // don't bleed to EOL
     m_pending_chars.clear();
+    m_drawn_buffer = m_buffer;
     m_refresh_needed = false;
     m_cached_buffer_size = m_buffer.size();
     m_chars_inserted_in_the_middle = 0;
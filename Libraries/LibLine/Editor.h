@@ -274,6 +274,7 @@ private:
     Vector<char, 1024> m_pre_search_buffer;
 
     Vector<char, 1024> m_buffer;
+    Vector<char, 1024> m_drawn_buffer;
     ByteBuffer m_pending_chars;
     size_t m_cursor { 0 };
     size_t m_drawn_cursor { 0 };
@@ -319,6 +320,9 @@ private:
 
     // FIXME: This should be something more take_first()-friendly.
     Vector<String> m_history;
+    // First-byte buckets of history indices (ascending), so prefix search
+    // only looks at entries that can possibly match.
+    HashMap<u32, Vector<size_t>> m_history_prefix_index;
     size_t m_history_cursor { 0 };
     size_t m_history_capacity { 100 };
 
@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/OwnPtr.h>
 #include <AK/StringBuilder.h>
 #include <LibMarkdown/CodeBlock.h>
 #include <LibMarkdown/Document.h>
@@ -42,9 +43,10 @@ String Document::render_to_html() const
     builder.append("<head></head>\n");
     builder.append("<body>\n");
 
-    for (auto& block : m_blocks) {
-        auto s = block.render_to_html();
-        builder.append(s);
+    for (auto& entry : m_blocks) {
+        if (entry.html.is_null())
+            entry.html = entry.block->render_to_html();
+        builder.append(entry.html);
     }
 
     builder.append("</body>\n");
@@ -56,23 +58,41 @@ String Document::render_for_terminal() const
 {
     StringBuilder builder;
 
-    for (auto& block : m_blocks) {
-        auto s = block.render_for_terminal();
-        builder.append(s);
+    for (auto& entry : m_blocks) {
+        if (entry.terminal.is_null())
+            entry.terminal = entry.block->render_for_terminal();
+        builder.append(entry.terminal);
     }
 
     return builder.build();
 }
 
 template<typename BlockType>
-static bool helper(Vector<StringView>::ConstIterator& lines, NonnullOwnPtrVector<Block>& blocks)
+static OwnPtr<Block> helper(Vector<StringView>::ConstIterator& lines)
 {
     NonnullOwnPtr<BlockType> block = make<BlockType>();
     bool success = block->parse(lines);
     if (!success)
+        return nullptr;
+    return move(block);
+}
+
+// A previously parsed block may be reused if the lines it consumed are
+// unchanged and it would stop at the same place. Block parsers only ever
+// look one line past what they consume, so matching the recorded span plus
+// the stop line is enough to guarantee an identical parse.
+static bool can_reuse_block(const Vector<StringView>& lines_vec, size_t start, const Vector<String>& source_lines, const String& stop_line)
+{
+    size_t end = start + source_lines.size();
+    if (end > lines_vec.size())
         return false;
-    blocks.append(move(block));
-    return true;
+    for (size_t i = 0; i < source_lines.size(); ++i) {
+        if (lines_vec[start + i] != source_lines[i])
+            return false;
+    }
+    if (end == lines_vec.size())
+        return stop_line.is_null();
+    return !stop_line.is_null() && lines_vec[end] == stop_line;
 }
 
 bool Document::parse(const StringView& str)
@@ -80,6 +100,9 @@ bool Document::parse(const StringView& str)
     const Vector<StringView> lines_vec = str.lines();
     auto lines = lines_vec.begin();
 
+    Vector<ParsedBlock> previous_blocks = move(m_blocks);
+    size_t reuse_cursor = 0;
+
     while (true) {
         if (lines.is_end())
             return true;
@@ -89,10 +112,38 @@ bool Document::parse(const StringView& str)
             continue;
         }
 
-        bool any = helper<List>(lines, m_blocks) || helper<Paragraph>(lines, m_blocks) || helper<CodeBlock>(lines, m_blocks) || helper<Heading>(lines, m_blocks);
+        size_t start = lines.index();
+
+        bool reused = false;
+        for (size_t i = reuse_cursor; i < previous_blocks.size(); ++i) {
+            auto& candidate = previous_blocks[i];
+            if (!can_reuse_block(lines_vec, start, candidate.source_lines, candidate.stop_line))
+                continue;
+            lines = lines + candidate.source_lines.size();
+            m_blocks.append(move(candidate));
+            reuse_cursor = i + 1;
+            reused = true;
+            break;
+        }
+        if (reused)
+            continue;
 
-        if (!any)
+        auto block = helper<List>(lines);
+        if (!block)
+            block = helper<Paragraph>(lines);
+        if (!block)
+            block = helper<CodeBlock>(lines);
+        if (!block)
+            block = helper<Heading>(lines);
+
+        if (!block)
             return false;
+
+        Vector<String> source_lines;
+        for (size_t i = start; i < lines.index(); ++i)
+            source_lines.append(lines_vec[i]);
+        String stop_line = lines.is_end() ? String() : String(lines_vec[lines.index()]);
+        m_blocks.append({ block.release_nonnull(), move(source_lines), move(stop_line), {}, {} });
     }
 }
 
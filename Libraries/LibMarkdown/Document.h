@@ -26,8 +26,9 @@
 
 #pragma once
 
-#include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibMarkdown/Block.h>
 
 namespace Markdown {
@@ -37,10 +38,27 @@ public:
     String render_to_html() const;
     String render_for_terminal() const;
 
+    // Parsing is incremental: calling parse() again reuses blocks whose
+    // source lines are unchanged (along with their cached render output)
+    // instead of re-parsing the whole document.
     bool parse(const StringView&);
 
 private:
-    NonnullOwnPtrVector<Block> m_blocks;
+    struct ParsedBlock {
+        NonnullOwnPtr<Block> block;
+        // The source lines this block consumed, plus the line that made it
+        // stop (null at end of document). A block is only reused when both
+        // match, since e.g. Paragraph decides where to end by peeking at
+        // the next line.
+        Vector<String> source_lines;
+        String stop_line;
+        // Render output is memoized per block, so re-rendering after an
+        // edit only visits blocks that were actually re-parsed.
+        mutable String html;
+        mutable String terminal;
+    };
+
+    Vector<ParsedBlock> m_blocks;
 };
 
 }
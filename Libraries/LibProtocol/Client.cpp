@@ -74,6 +74,14 @@ void Client::handle(const Messages::ProtocolClient::DownloadFinished& message)
     m_downloads.remove(message.download_id());
 }
 
+void Client::handle(const Messages::ProtocolClient::DownloadChunk& message)
+{
+    if (auto download = const_cast<Download*>(m_downloads.get(message.download_id()).value_or(nullptr))) {
+        download->did_receive_chunk({}, message.shbuf_id(), message.chunk_size());
+    }
+    send_sync<Messages::ProtocolServer::DisownSharedBuffer>(message.shbuf_id());
+}
+
 void Client::handle(const Messages::ProtocolClient::DownloadProgress& message)
 {
     if (auto download = const_cast<Download*>(m_downloads.get(message.download_id()).value_or(nullptr))) {
@@ -50,6 +50,7 @@ public:
 
 private:
     virtual void handle(const Messages::ProtocolClient::DownloadProgress&) override;
+    virtual void handle(const Messages::ProtocolClient::DownloadChunk&) override;
     virtual void handle(const Messages::ProtocolClient::DownloadFinished&) override;
 
     HashMap<i32, RefPtr<Download>> m_downloads;
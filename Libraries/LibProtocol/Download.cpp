@@ -41,11 +41,28 @@ bool Download::stop()
     return m_client->stop_download({}, *this);
 }
 
+void Download::did_receive_chunk(Badge<Client>, i32 shbuf_id, u32 chunk_size)
+{
+    auto shared_buffer = SharedBuffer::create_from_shbuf_id(shbuf_id);
+    if (!shared_buffer)
+        return;
+    auto chunk = ByteBuffer::wrap(shared_buffer->data(), chunk_size);
+    m_streamed_payload.append(chunk.data(), chunk.size());
+    if (on_chunk)
+        on_chunk(chunk);
+}
+
 void Download::did_finish(Badge<Client>, bool success, u32 total_size, i32 shbuf_id)
 {
     if (!on_finish)
         return;
 
+    if (success && shbuf_id == -1 && !m_streamed_payload.is_null()) {
+        // The payload already arrived in chunks; hand over what we assembled.
+        on_finish(success, m_streamed_payload, nullptr);
+        return;
+    }
+
     ByteBuffer payload;
     RefPtr<SharedBuffer> shared_buffer;
     if (success && shbuf_id != -1) {
@@ -48,14 +48,19 @@ public:
 
     Function<void(bool success, const ByteBuffer& payload, RefPtr<SharedBuffer> payload_storage)> on_finish;
     Function<void(u32 total_size, u32 downloaded_size)> on_progress;
+    // Invoked for each piece of the payload as it arrives, for downloads the
+    // server delivers incrementally. on_finish still receives the full payload.
+    Function<void(const ByteBuffer&)> on_chunk;
 
     void did_finish(Badge<Client>, bool success, u32 total_size, i32 shbuf_id);
     void did_progress(Badge<Client>, u32 total_size, u32 downloaded_size);
+    void did_receive_chunk(Badge<Client>, i32 shbuf_id, u32 chunk_size);
 
 private:
     explicit Download(Client&, i32 download_id);
     WeakPtr<Client> m_client;
     int m_download_id { -1 };
+    ByteBuffer m_streamed_payload;
 };
 
 }
@@ -167,31 +167,64 @@ int pthread_mutex_destroy(pthread_mutex_t*)
     return 0;
 }
 
+// Mutex states: an unlocked mutex is 0, a locked mutex with no waiters is 1,
+// and a locked mutex that (maybe) has waiters sleeping in the kernel is 2.
+// Only state 2 requires a FUTEX_WAKE on unlock, so the uncontended paths
+// never enter the kernel at all.
+enum {
+    MUTEX_UNLOCKED = 0,
+    MUTEX_LOCKED = 1,
+    MUTEX_LOCKED_NEED_WAKE = 2,
+};
+
+static const int mutex_spin_limit = 40;
+
 int pthread_mutex_lock(pthread_mutex_t* mutex)
 {
     auto& atomic = reinterpret_cast<Atomic<u32>&>(mutex->lock);
     pthread_t this_thread = pthread_self();
-    for (;;) {
-        u32 expected = false;
-        if (!atomic.compare_exchange_strong(expected, true, AK::memory_order_acq_rel)) {
-            if (mutex->type == PTHREAD_MUTEX_RECURSIVE && mutex->owner == this_thread) {
-                mutex->level++;
-                return 0;
-            }
-            sched_yield();
-            continue;
-        }
+
+    u32 expected = MUTEX_UNLOCKED;
+    if (atomic.compare_exchange_strong(expected, MUTEX_LOCKED, AK::memory_order_acq_rel)) {
         mutex->owner = this_thread;
         mutex->level = 0;
         return 0;
     }
+
+    if (mutex->type == PTHREAD_MUTEX_RECURSIVE && mutex->owner == this_thread) {
+        mutex->level++;
+        return 0;
+    }
+
+    // Adaptive spinning: the owner is probably mid-critical-section, so
+    // retry a bounded number of times before paying for a kernel round-trip.
+    for (int i = 0; i < mutex_spin_limit; ++i) {
+        expected = MUTEX_UNLOCKED;
+        if (atomic.compare_exchange_strong(expected, MUTEX_LOCKED, AK::memory_order_acq_rel)) {
+            mutex->owner = this_thread;
+            mutex->level = 0;
+            return 0;
+        }
+    }
+
+    // Slow path: advertise that we're going to sleep, then do so. After a
+    // wakeup we must take the lock in state 2, since we can't tell whether
+    // other waiters remain in the queue behind us.
+    u32 state = atomic.exchange(MUTEX_LOCKED_NEED_WAKE, AK::memory_order_acquire);
+    while (state != MUTEX_UNLOCKED) {
+        futex((int32_t*)&mutex->lock, FUTEX_WAIT, MUTEX_LOCKED_NEED_WAKE, nullptr);
+        state = atomic.exchange(MUTEX_LOCKED_NEED_WAKE, AK::memory_order_acquire);
+    }
+    mutex->owner = this_thread;
+    mutex->level = 0;
+    return 0;
 }
 
 int pthread_mutex_trylock(pthread_mutex_t* mutex)
 {
     auto& atomic = reinterpret_cast<Atomic<u32>&>(mutex->lock);
-    u32 expected = false;
-    if (!atomic.compare_exchange_strong(expected, true, AK::memory_order_acq_rel)) {
+    u32 expected = MUTEX_UNLOCKED;
+    if (!atomic.compare_exchange_strong(expected, MUTEX_LOCKED, AK::memory_order_acq_rel)) {
         if (mutex->type == PTHREAD_MUTEX_RECURSIVE && mutex->owner == pthread_self()) {
             mutex->level++;
             return 0;
@@ -210,7 +243,10 @@ int pthread_mutex_unlock(pthread_mutex_t* mutex)
         return 0;
     }
     mutex->owner = 0;
-    mutex->lock = 0;
+    auto& atomic = reinterpret_cast<Atomic<u32>&>(mutex->lock);
+    u32 previous = atomic.exchange(MUTEX_UNLOCKED, AK::memory_order_release);
+    if (previous == MUTEX_LOCKED_NEED_WAKE)
+        futex((int32_t*)&mutex->lock, FUTEX_WAKE, 1, nullptr);
     return 0;
 }
 
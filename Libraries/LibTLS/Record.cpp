@@ -200,7 +200,12 @@ ssize_t TLSv12::handle_message(const ByteBuffer& buffer)
         ASSERT(m_aes_remote);
         auto iv_size = iv_length();
 
-        auto decrypted = m_aes_remote->create_aligned_buffer(length - iv_size);
+        // Decrypt into the connection-wide scratch buffer rather than a
+        // freshly allocated one; nothing downstream holds on to the record
+        // past this call, so the scratch space can be reused for the next one.
+        if (m_unencrypted_scratch_buffer.size() < length - iv_size)
+            m_unencrypted_scratch_buffer = m_aes_remote->create_aligned_buffer(length - iv_size);
+        auto decrypted = ByteBuffer::wrap(m_unencrypted_scratch_buffer.data(), length - iv_size);
         auto iv = buffer.slice_view(header_size, iv_size);
 
         m_aes_remote->decrypt(buffer.slice_view(header_size + iv_size, length - iv_size), decrypted, iv);
@@ -237,7 +242,10 @@ ssize_t TLSv12::handle_message(const ByteBuffer& buffer)
 
             return (i8)Error::IntegrityCheckFailed;
         }
-        plain = decrypted.slice(0, length - mac_size);
+        // A view suffices here: ApplicationData is copied into the application
+        // buffer right below, and handshake payloads are consumed before we
+        // return (the unencrypted path already hands out a view of `buffer').
+        plain = decrypted.slice_view(0, length - mac_size);
     }
     m_context.remote_sequence_number++;
 
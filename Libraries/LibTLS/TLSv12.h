@@ -444,6 +444,11 @@ private:
 
     OwnPtr<Crypto::Cipher::AESCipher::CBCMode> m_aes_local;
     OwnPtr<Crypto::Cipher::AESCipher::CBCMode> m_aes_remote;
+
+    // Scratch space for record decryption. Records arrive back-to-back on a
+    // busy connection, so we decrypt them all into this one buffer instead of
+    // allocating a fresh buffer per record.
+    ByteBuffer m_unencrypted_scratch_buffer;
 };
 
 namespace Constants {
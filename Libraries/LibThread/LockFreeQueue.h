@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <sched.h>
+
+namespace LibThread {
+
+// A bounded single-producer/single-consumer ring. Neither side ever takes
+// a lock: the producer only writes m_head and the consumer only writes
+// m_tail, so the two threads never store to the same word. Capacity must
+// be a power of two.
+template<typename T, size_t Capacity>
+class SPSCQueue {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    bool try_enqueue(T&& value)
+    {
+        size_t head = m_head.load(AK::memory_order_relaxed);
+        size_t tail = m_tail.load(AK::memory_order_acquire);
+        if (head - tail == Capacity)
+            return false;
+        m_slots[head & (Capacity - 1)] = move(value);
+        m_head.store(head + 1, AK::memory_order_release);
+        return true;
+    }
+
+    bool try_dequeue(T& value)
+    {
+        size_t tail = m_tail.load(AK::memory_order_relaxed);
+        size_t head = m_head.load(AK::memory_order_acquire);
+        if (tail == head)
+            return false;
+        value = move(m_slots[tail & (Capacity - 1)]);
+        m_tail.store(tail + 1, AK::memory_order_release);
+        return true;
+    }
+
+    // Blocking variants. These just yield between attempts for now;
+    // once the kernel grows a futex-style primitive, the backoff should
+    // sleep in the kernel instead of burning scheduler round-trips.
+    void enqueue(T&& value)
+    {
+        while (!try_enqueue(move(value)))
+            sched_yield();
+    }
+
+    T dequeue()
+    {
+        T value;
+        while (!try_dequeue(value))
+            sched_yield();
+        return value;
+    }
+
+    bool is_empty() const
+    {
+        return m_head.load(AK::memory_order_acquire) == m_tail.load(AK::memory_order_acquire);
+    }
+
+    size_t size() const
+    {
+        return m_head.load(AK::memory_order_acquire) - m_tail.load(AK::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    Atomic<size_t> m_head { 0 };
+    Atomic<size_t> m_tail { 0 };
+    T m_slots[Capacity];
+};
+
+// A bounded multi-producer/multi-consumer queue with ticket sequencing:
+// every slot carries a sequence number, producers and consumers claim a
+// ticket with fetch-and-add-style CAS and then wait for "their" slot to
+// come around. No operation holds a lock while touching the payload, so
+// a preempted producer only delays the slot it claimed, not the queue.
+template<typename T, size_t Capacity>
+class MPMCQueue {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    MPMCQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].sequence.store(i, AK::memory_order_relaxed);
+    }
+
+    bool try_enqueue(T&& value)
+    {
+        size_t ticket = m_enqueue_ticket.load(AK::memory_order_relaxed);
+        for (;;) {
+            auto& slot = m_slots[ticket & (Capacity - 1)];
+            size_t sequence = slot.sequence.load(AK::memory_order_acquire);
+            ssize_t difference = (ssize_t)(sequence - ticket);
+            if (difference == 0) {
+                if (m_enqueue_ticket.compare_exchange_strong(ticket, ticket + 1, AK::memory_order_relaxed)) {
+                    slot.value = move(value);
+                    slot.sequence.store(ticket + 1, AK::memory_order_release);
+                    return true;
+                }
+                // CAS failure updated our ticket; try again with the new one.
+            } else if (difference < 0) {
+                // The slot is still occupied by an element from the
+                // previous lap: the queue is full.
+                return false;
+            } else {
+                ticket = m_enqueue_ticket.load(AK::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_dequeue(T& value)
+    {
+        size_t ticket = m_dequeue_ticket.load(AK::memory_order_relaxed);
+        for (;;) {
+            auto& slot = m_slots[ticket & (Capacity - 1)];
+            size_t sequence = slot.sequence.load(AK::memory_order_acquire);
+            ssize_t difference = (ssize_t)(sequence - (ticket + 1));
+            if (difference == 0) {
+                if (m_dequeue_ticket.compare_exchange_strong(ticket, ticket + 1, AK::memory_order_relaxed)) {
+                    value = move(slot.value);
+                    slot.sequence.store(ticket + Capacity, AK::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // The slot hasn't been published yet: the queue is empty.
+                return false;
+            } else {
+                ticket = m_dequeue_ticket.load(AK::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Same story as SPSCQueue: yield-based backoff until we have futexes.
+    void enqueue(T&& value)
+    {
+        while (!try_enqueue(move(value)))
+            sched_yield();
+    }
+
+    T dequeue()
+    {
+        T value;
+        while (!try_dequeue(value))
+            sched_yield();
+        return value;
+    }
+
+    bool is_empty() const
+    {
+        return m_dequeue_ticket.load(AK::memory_order_acquire) >= m_enqueue_ticket.load(AK::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    struct Slot {
+        Atomic<size_t> sequence { 0 };
+        T value;
+    };
+
+    Slot m_slots[Capacity];
+    Atomic<size_t> m_enqueue_ticket { 0 };
+    Atomic<size_t> m_dequeue_ticket { 0 };
+};
+
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/String.h>
+#include <LibCore/File.h>
+#include <LibThread/Lock.h>
+#include <LibThread/Thread.h>
+#include <LibThread/ThreadPool.h>
+
+namespace LibThread {
+
+struct ThreadPool::Worker {
+    Lock lock;
+    // New tasks go on the back; the owning worker pops from the back and
+    // thieves take from the front, so they rarely contend for the same end.
+    Vector<Function<void()>> tasks;
+    RefPtr<Thread> thread;
+};
+
+static size_t detect_processor_count()
+{
+    // The kernel emits one "cpuid:" section per processor.
+    auto file = Core::File::construct("/proc/cpuinfo");
+    if (!file->open(Core::IODevice::ReadOnly))
+        return 1;
+    auto contents = String::copy(file->read_all());
+    size_t count = 0;
+    for (size_t i = 0; i + 6 <= contents.length(); ++i) {
+        if (!memcmp(contents.characters() + i, "cpuid:", 6))
+            ++count;
+    }
+    return count ? count : 1;
+}
+
+ThreadPool& ThreadPool::the()
+{
+    static ThreadPool* s_the;
+    if (!s_the)
+        s_the = new ThreadPool;
+    return *s_the;
+}
+
+ThreadPool::ThreadPool()
+{
+    pthread_mutex_init(&m_idle_mutex, nullptr);
+    pthread_cond_init(&m_idle_cond, nullptr);
+
+    size_t count = detect_processor_count();
+    for (size_t i = 0; i < count; ++i)
+        m_workers.append(make<Worker>());
+    for (size_t i = 0; i < count; ++i) {
+        auto thread = Thread::construct([this, i]() -> int {
+            worker_loop(i);
+            return 0;
+        },
+            String::format("ThreadPool[%zu]", i));
+        thread->start();
+        m_workers[i].thread = move(thread);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    // The pool is a process-lifetime singleton; the workers never exit.
+    ASSERT_NOT_REACHED();
+}
+
+void ThreadPool::submit(Function<void()> task)
+{
+    auto& worker = m_workers[m_next_queue++ % m_workers.size()];
+    {
+        LOCKER(worker.lock);
+        worker.tasks.append(move(task));
+    }
+    pthread_mutex_lock(&m_idle_mutex);
+    ++m_pending_task_count;
+    pthread_cond_signal(&m_idle_cond);
+    pthread_mutex_unlock(&m_idle_mutex);
+}
+
+Function<void()> ThreadPool::take_task(size_t worker_index)
+{
+    {
+        auto& worker = m_workers[worker_index];
+        LOCKER(worker.lock);
+        if (!worker.tasks.is_empty())
+            return worker.tasks.take_last();
+    }
+    // Nothing of our own; go steal from the front of a sibling's queue.
+    for (size_t offset = 1; offset < m_workers.size(); ++offset) {
+        auto& victim = m_workers[(worker_index + offset) % m_workers.size()];
+        LOCKER(victim.lock);
+        if (!victim.tasks.is_empty())
+            return victim.tasks.take_first();
+    }
+    return nullptr;
+}
+
+void ThreadPool::worker_loop(size_t worker_index)
+{
+    for (;;) {
+        if (auto task = take_task(worker_index)) {
+            pthread_mutex_lock(&m_idle_mutex);
+            ASSERT(m_pending_task_count > 0);
+            --m_pending_task_count;
+            pthread_mutex_unlock(&m_idle_mutex);
+            task();
+            continue;
+        }
+        pthread_mutex_lock(&m_idle_mutex);
+        while (!m_pending_task_count)
+            pthread_cond_wait(&m_idle_cond, &m_idle_mutex);
+        pthread_mutex_unlock(&m_idle_mutex);
+    }
+}
+
+}
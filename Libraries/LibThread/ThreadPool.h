@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/Vector.h>
+#include <pthread.h>
+
+namespace LibThread {
+
+// A pool of worker threads, one per CPU, with per-worker task queues and
+// work stealing: an idle worker first drains its own queue, then steals
+// from its siblings before going to sleep. Use it instead of spawning a
+// fresh Thread for every little piece of parallel work.
+class ThreadPool {
+public:
+    static ThreadPool& the();
+
+    size_t worker_count() const { return m_workers.size(); }
+
+    // Runs the task on some worker thread, eventually. The task must not
+    // touch anything that isn't safe to touch off the main thread.
+    void submit(Function<void()>);
+
+    // Calls callback(i) for every i in [begin, end), carved into one chunk
+    // per participant. The calling thread works on its own chunk while the
+    // workers handle the rest, and we don't return until every index has
+    // been visited. Iterations must be independent of each other.
+    template<typename Callback>
+    void parallel_for(size_t begin, size_t end, Callback callback)
+    {
+        if (begin >= end)
+            return;
+        size_t count = end - begin;
+        // The calling thread participates, so even a single-CPU pool gets
+        // some overlap between the caller and its one worker.
+        size_t chunk_count = worker_count() + 1;
+        if (chunk_count > count)
+            chunk_count = count;
+        if (chunk_count < 2) {
+            for (size_t i = begin; i < end; ++i)
+                callback(i);
+            return;
+        }
+        size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+        Latch latch(chunk_count - 1);
+        for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+            size_t chunk_begin = begin + chunk * chunk_size;
+            size_t chunk_end = min(chunk_begin + chunk_size, end);
+            submit([&callback, &latch, chunk_begin, chunk_end] {
+                for (size_t i = chunk_begin; i < chunk_end; ++i)
+                    callback(i);
+                latch.count_down();
+            });
+        }
+        for (size_t i = begin; i < min(begin + chunk_size, end); ++i)
+            callback(i);
+        latch.wait();
+    }
+
+    // Maps input through callback, one output element per input element,
+    // distributing the elements across the pool.
+    template<typename U, typename T, typename Callback>
+    Vector<U> parallel_map(const Vector<T>& input, Callback callback)
+    {
+        Vector<U> output;
+        output.resize(input.size());
+        parallel_for(0, input.size(), [&](size_t i) {
+            output[i] = callback(input[i]);
+        });
+        return output;
+    }
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+
+    // A one-shot countdown for waiting on a batch of submitted tasks.
+    class Latch {
+    public:
+        explicit Latch(size_t count)
+            : m_count(count)
+        {
+            pthread_mutex_init(&m_mutex, nullptr);
+            pthread_cond_init(&m_cond, nullptr);
+        }
+        ~Latch()
+        {
+            pthread_mutex_destroy(&m_mutex);
+            pthread_cond_destroy(&m_cond);
+        }
+        void count_down()
+        {
+            pthread_mutex_lock(&m_mutex);
+            ASSERT(m_count > 0);
+            if (!--m_count)
+                pthread_cond_broadcast(&m_cond);
+            pthread_mutex_unlock(&m_mutex);
+        }
+        void wait()
+        {
+            pthread_mutex_lock(&m_mutex);
+            while (m_count)
+                pthread_cond_wait(&m_cond, &m_mutex);
+            pthread_mutex_unlock(&m_mutex);
+        }
+
+    private:
+        size_t m_count { 0 };
+        pthread_mutex_t m_mutex;
+        pthread_cond_t m_cond;
+    };
+
+    struct Worker;
+
+    Function<void()> take_task(size_t worker_index);
+    void worker_loop(size_t worker_index);
+
+    NonnullOwnPtrVector<Worker> m_workers;
+    size_t m_next_queue { 0 };
+
+    pthread_mutex_t m_idle_mutex;
+    pthread_cond_t m_idle_cond;
+    size_t m_pending_task_count { 0 };
+};
+
+}
@@ -94,6 +94,14 @@ bool Terminal::Line::has_only_one_background_color() const
 {
     if (!m_length)
         return true;
+    if (is_compacted()) {
+        auto color = m_attribute_runs[0].attribute.background_color;
+        for (size_t i = 1; i < m_attribute_runs.size(); ++i) {
+            if (m_attribute_runs[i].attribute.background_color != color)
+                return false;
+        }
+        return true;
+    }
     // FIXME: Cache this result?
     auto color = attributes[0].background_color;
     for (size_t i = 1; i < m_length; ++i) {
@@ -103,6 +111,43 @@ bool Terminal::Line::has_only_one_background_color() const
     return true;
 }
 
+void Terminal::Line::compact()
+{
+    if (is_compacted())
+        return;
+    m_attribute_runs.clear_with_capacity();
+    for (size_t i = 0; i < m_length; ++i) {
+        if (m_attribute_runs.is_empty() || m_attribute_runs.last().attribute != attributes[i])
+            m_attribute_runs.append({ 1, attributes[i] });
+        else
+            ++m_attribute_runs.last().length;
+    }
+    delete[] attributes;
+    attributes = nullptr;
+}
+
+const Attribute& Terminal::Line::attribute_at(size_t index) const
+{
+    ASSERT(index < m_length);
+    if (!is_compacted())
+        return attributes[index];
+    for (auto& run : m_attribute_runs) {
+        if (index < run.length)
+            return run.attribute;
+        index -= run.length;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+size_t Terminal::Line::approximate_memory_cost() const
+{
+    size_t cost = sizeof(Line) + m_length;
+    if (attributes)
+        cost += m_length * sizeof(Attribute);
+    cost += m_attribute_runs.size() * sizeof(AttributeRun);
+    return cost;
+}
+
 void Terminal::clear()
 {
     for (size_t i = 0; i < rows(); ++i)
@@ -125,6 +170,24 @@ inline bool is_valid_final_character(u8 ch)
     return ch >= 0x40 && ch <= 0x7e;
 }
 
+// Anything on_char() would simply print at the cursor, i.e. not one of the
+// control bytes it handles specially.
+inline bool is_plain_character(u8 ch)
+{
+    switch (ch) {
+    case '\0':
+    case '\033':
+    case 8: // Backspace
+    case '\a':
+    case '\t':
+    case '\r':
+    case '\n':
+        return false;
+    default:
+        return true;
+    }
+}
+
 void Terminal::alter_mode(bool should_set, bool question_param, const ParamVector& params)
 {
     int mode = 2;
@@ -746,10 +809,7 @@ void Terminal::scroll_up()
     // NOTE: We have to invalidate the cursor first.
     invalidate_cursor();
     if (m_scroll_region_top == 0) {
-        auto line = move(m_lines.ptr_at(m_scroll_region_top));
-        m_history.append(move(line));
-        while (m_history.size() > max_history_size())
-            m_history.take_first();
+        add_line_to_history(move(m_lines.ptr_at(m_scroll_region_top)));
         m_client.terminal_history_changed();
     }
     m_lines.remove(m_scroll_region_top);
@@ -757,6 +817,32 @@ void Terminal::scroll_up()
     m_need_full_flush = true;
 }
 
+void Terminal::add_line_to_history(NonnullOwnPtr<Line>&& line)
+{
+    line->compact();
+    if (m_history.is_empty())
+        m_history.resize(max_history_size());
+
+    m_history_bytes += line->approximate_memory_cost();
+    if (m_history_size == m_history.size()) {
+        // The ring is full; recycle the oldest slot.
+        m_history_bytes -= m_history[m_history_start]->approximate_memory_cost();
+        m_history[m_history_start] = move(line);
+        m_history_start = (m_history_start + 1) % m_history.size();
+    } else {
+        m_history[(m_history_start + m_history_size) % m_history.size()] = move(line);
+        ++m_history_size;
+    }
+
+    while (m_history_bytes > max_history_bytes() && m_history_size > 1) {
+        auto& oldest = m_history[m_history_start];
+        m_history_bytes -= oldest->approximate_memory_cost();
+        oldest = nullptr;
+        m_history_start = (m_history_start + 1) % m_history.size();
+        --m_history_size;
+    }
+}
+
 void Terminal::scroll_down()
 {
     // NOTE: We have to invalidate the cursor first.
@@ -956,10 +1042,41 @@ void Terminal::on_char(u8 ch)
     }
 }
 
+void Terminal::process_input(const u8* data, size_t length)
+{
+    size_t i = 0;
+    while (i < length) {
+        if (m_escape_state == Normal && is_plain_character(data[i])) {
+            // Scan ahead over the run of plain characters and put them on the
+            // current line in one go instead of running the state machine
+            // once per byte. We stop one column short of the right edge so
+            // the wraparound dance stays in on_char().
+            size_t run_length = 1;
+            while (i + run_length < length && is_plain_character(data[i + run_length]))
+                ++run_length;
+            size_t columns_left = columns() - m_cursor_column;
+            if (run_length > 1 && columns_left > 1) {
+                size_t n = min(run_length, columns_left - 1);
+                auto& line = this->line(m_cursor_row);
+                for (size_t j = 0; j < n; ++j) {
+                    line.characters[m_cursor_column + j] = data[i + j];
+                    line.attributes[m_cursor_column + j] = m_current_attribute;
+                    line.attributes[m_cursor_column + j].flags |= Attribute::Touched;
+                }
+                line.dirty = true;
+                m_last_char = data[i + n - 1];
+                set_cursor(m_cursor_row, m_cursor_column + n);
+                i += n;
+                continue;
+            }
+        }
+        on_char(data[i++]);
+    }
+}
+
 void Terminal::inject_string(const StringView& str)
 {
-    for (size_t i = 0; i < str.length(); ++i)
-        on_char(str[i]);
+    process_input((const u8*)str.characters_without_null_termination(), str.length());
 }
 
 void Terminal::emit_string(const StringView& str)
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibVT/Position.h>
@@ -94,6 +95,7 @@ public:
 
     void invalidate_cursor();
     void on_char(u8);
+    void process_input(const u8*, size_t);
 
     void clear();
     void set_size(u16 columns, u16 rows);
@@ -111,8 +113,21 @@ public:
         void set_length(u16);
         StringView text() const { return { characters, m_length }; }
 
+        // Scrollback lines are never written to again, so when a line moves
+        // into history we run-length encode its attributes and drop the
+        // per-cell array. Most lines compress to a handful of runs.
+        struct AttributeRun {
+            u16 length { 0 };
+            Attribute attribute;
+        };
+        void compact();
+        bool is_compacted() const { return !attributes; }
+        const Attribute& attribute_at(size_t index) const;
+        size_t approximate_memory_cost() const;
+
         u8* characters { nullptr };
         Attribute* attributes { nullptr };
+        Vector<AttributeRun> m_attribute_runs;
         bool dirty { false };
         u16 m_length { 0 };
     };
@@ -129,7 +144,13 @@ public:
     }
 
     size_t max_history_size() const { return 500; }
-    const NonnullOwnPtrVector<Line>& history() const { return m_history; }
+    size_t max_history_bytes() const { return 512 * KB; }
+    size_t history_size() const { return m_history_size; }
+    const Line& history_line(size_t index) const
+    {
+        ASSERT(index < m_history_size);
+        return *m_history[(m_history_start + index) % m_history.size()];
+    }
 
     void inject_string(const StringView&);
 
@@ -180,9 +201,17 @@ private:
     void RI();
     void DSR();
 
+    void add_line_to_history(NonnullOwnPtr<Line>&&);
+
     TerminalClient& m_client;
 
-    NonnullOwnPtrVector<Line> m_history;
+    // Scrollback is a circular arena: a fixed ring of line slots plus a byte
+    // budget. When either limit is hit we start dropping the oldest lines.
+    Vector<OwnPtr<Line>> m_history;
+    size_t m_history_start { 0 };
+    size_t m_history_size { 0 };
+    size_t m_history_bytes { 0 };
+
     NonnullOwnPtrVector<Line> m_lines;
 
     size_t m_scroll_region_top { 0 };
@@ -77,9 +77,11 @@ void TerminalWidget::set_pty_master_fd(int fd)
             set_pty_master_fd(-1);
             return;
         }
-        for (ssize_t i = 0; i < nread; ++i)
-            m_terminal.on_char(buffer[i]);
-        flush_dirty_lines();
+        m_terminal.process_input(buffer, nread);
+        // Coalesce repaints: a program spewing output fast enough to fill
+        // the pty buffer would otherwise have us flushing once per read().
+        if (!m_flush_timer->is_active())
+            m_flush_timer->start();
     };
 }
 
@@ -92,6 +94,10 @@ TerminalWidget::TerminalWidget(int ptm_fd, bool automatic_size_policy, RefPtr<Co
     m_cursor_blink_timer = add<Core::Timer>();
     m_visual_beep_timer = add<Core::Timer>();
 
+    m_flush_timer = Core::Timer::create_single_shot(16, [this] {
+        flush_dirty_lines();
+    });
+
     m_scrollbar = add<GUI::ScrollBar>(Orientation::Vertical);
     m_scrollbar->set_relative_rect(0, 0, 16, 0);
     m_scrollbar->on_change = [this](int) {
@@ -314,13 +320,13 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
     int row_with_cursor = m_terminal.cursor_row();
     if (m_scrollbar->value() != m_scrollbar->max()) {
         rows_from_history = min((int)m_terminal.rows(), m_scrollbar->max() - m_scrollbar->value());
-        first_row_from_history = m_terminal.history().size() - (m_scrollbar->max() - m_scrollbar->value());
+        first_row_from_history = m_terminal.history_size() - (m_scrollbar->max() - m_scrollbar->value());
         row_with_cursor = m_terminal.cursor_row() + rows_from_history;
     }
 
     auto line_for_visual_row = [&](u16 row) -> const VT::Terminal::Line& {
         if (row < rows_from_history)
-            return m_terminal.history().at(first_row_from_history + row);
+            return m_terminal.history_line(first_row_from_history + row);
         return m_terminal.line(row - rows_from_history);
     };
 
@@ -333,7 +339,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         if (m_visual_beep_timer->is_active())
             painter.clear_rect(row_rect, Color::Red);
         else if (has_only_one_background_color)
-            painter.clear_rect(row_rect, lookup_color(line.attributes[0].background_color).with_alpha(m_opacity));
+            painter.clear_rect(row_rect, lookup_color(line.attribute_at(0).background_color).with_alpha(m_opacity));
 
         // The terminal insists on thinking characters and
         // bytes are the same thing. We want to still draw
@@ -365,7 +371,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
                     && row == row_with_cursor
                     && column == m_terminal.cursor_column();
                 should_reverse_fill_for_cursor_or_selection |= selection_contains({ row, column });
-                attribute = line.attributes[column];
+                attribute = line.attribute_at(column);
                 auto character_rect = glyph_rect(row, column);
                 auto cell_rect = character_rect.inflated(0, m_line_spacing);
                 if (!has_only_one_background_color || should_reverse_fill_for_cursor_or_selection) {
@@ -393,7 +399,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         auto& cursor_line = line_for_visual_row(row_with_cursor);
         if (m_terminal.cursor_row() < (m_terminal.rows() - rows_from_history)) {
             auto cell_rect = glyph_rect(row_with_cursor, m_terminal.cursor_column()).inflated(0, m_line_spacing);
-            painter.draw_rect(cell_rect, lookup_color(cursor_line.attributes[m_terminal.cursor_column()].foreground_color));
+            painter.draw_rect(cell_rect, lookup_color(cursor_line.attribute_at(m_terminal.cursor_column()).foreground_color));
         }
     }
 }
@@ -669,7 +675,7 @@ int TerminalWidget::last_selection_column_on_row(int row) const
 void TerminalWidget::terminal_history_changed()
 {
     bool was_max = m_scrollbar->value() == m_scrollbar->max();
-    m_scrollbar->set_max(m_terminal.history().size());
+    m_scrollbar->set_max(m_terminal.history_size());
     if (was_max)
         m_scrollbar->set_value(m_scrollbar->max());
     m_scrollbar->update();
@@ -158,6 +158,7 @@ private:
 
     RefPtr<Core::Timer> m_cursor_blink_timer;
     RefPtr<Core::Timer> m_visual_beep_timer;
+    RefPtr<Core::Timer> m_flush_timer;
     RefPtr<Core::ConfigFile> m_config;
 
     RefPtr<GUI::ScrollBar> m_scrollbar;
@@ -61,6 +61,7 @@ CanvasRenderingContext2DWrapper::CanvasRenderingContext2DWrapper(CanvasRendering
     put_native_function("beginPath", begin_path, 0);
     put_native_function("closePath", close_path, 0);
     put_native_function("stroke", stroke, 0);
+    put_native_function("fill", fill, 0);
     put_native_function("moveTo", move_to, 2);
     put_native_function("lineTo", line_to, 2);
 
@@ -218,6 +219,19 @@ JS::Value CanvasRenderingContext2DWrapper::stroke(JS::Interpreter& interpreter)
     return JS::js_undefined();
 }
 
+JS::Value CanvasRenderingContext2DWrapper::fill(JS::Interpreter& interpreter)
+{
+    auto* impl = impl_from(interpreter);
+    if (!impl)
+        return {};
+    auto& arguments = interpreter.call_frame().arguments;
+    String fill_rule = "nonzero";
+    if (arguments.size() >= 1)
+        fill_rule = arguments[0].to_string();
+    impl->fill(fill_rule);
+    return JS::js_undefined();
+}
+
 JS::Value CanvasRenderingContext2DWrapper::move_to(JS::Interpreter& interpreter)
 {
     auto* impl = impl_from(interpreter);
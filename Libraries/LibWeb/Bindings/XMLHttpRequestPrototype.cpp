@@ -97,7 +97,16 @@ JS::Value XMLHttpRequestPrototype::response_text_getter(JS::Interpreter& interpr
     auto* impl = impl_from(interpreter);
     if (!impl)
         return {};
-    return JS::js_string(interpreter, impl->response_text());
+    // Join the received chunks with a rope instead of flattening them into
+    // a fresh String on every access; the rope only materializes if the
+    // script actually looks at the characters.
+    auto& fragments = impl->response_fragments();
+    if (fragments.is_empty())
+        return JS::js_string(interpreter, String::empty());
+    auto* string = JS::js_string(interpreter, fragments.first());
+    for (size_t i = 1; i < fragments.size(); ++i)
+        string = JS::js_rope_string(interpreter.heap(), *string, *JS::js_string(interpreter, fragments[i]));
+    return string;
 }
 
 }
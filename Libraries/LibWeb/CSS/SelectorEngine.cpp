@@ -101,7 +101,47 @@ bool matches(const Selector::SimpleSelector& component, const Element& element)
     }
 }
 
-bool matches(const Selector& selector, int component_list_index, const Element& element)
+AncestorFilter build_ancestor_filter(const Element& element)
+{
+    AncestorFilter filter;
+    for (auto* ancestor = element.parent(); ancestor; ancestor = ancestor->parent()) {
+        if (!is<Element>(*ancestor))
+            continue;
+        auto& ancestor_element = to<Element>(*ancestor);
+        filter.add(ancestor_element.tag_name().hash());
+        auto id = ancestor_element.attribute("id");
+        if (!id.is_empty())
+            filter.add(id.hash());
+        auto class_attribute = ancestor_element.attribute("class");
+        if (!class_attribute.is_empty()) {
+            for (auto& class_name : class_attribute.split_view(' '))
+                filter.add(class_name.hash());
+        }
+    }
+    return filter;
+}
+
+// Checks whether the given compound selector could possibly match any
+// ancestor of the element the filter was built for. Only simple selectors
+// on identifiers are considered; anything else is assumed to match.
+static bool ancestor_filter_allows(const AncestorFilter& filter, const Vector<Selector::SimpleSelector>& compound_selector)
+{
+    for (auto& component : compound_selector) {
+        switch (component.type) {
+        case Selector::SimpleSelector::Type::Id:
+        case Selector::SimpleSelector::Type::Class:
+        case Selector::SimpleSelector::Type::TagName:
+            if (!filter.may_contain(component.value.hash()))
+                return false;
+            break;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+bool matches(const Selector& selector, int component_list_index, const Element& element, const AncestorFilter* ancestor_filter = nullptr)
 {
     auto& component_list = selector.complex_selectors()[component_list_index];
     for (auto& component : component_list.compound_selector) {
@@ -113,10 +153,15 @@ bool matches(const Selector& selector, int component_list_index, const Element&
         return true;
     case Selector::ComplexSelector::Relation::Descendant:
         ASSERT(component_list_index != 0);
+        // NOTE: We can only consult the filter for the compound selector that has
+        //       to match an ancestor directly. Compounds further to the left may
+        //       be separated by sibling combinators and match elsewhere.
+        if (ancestor_filter && !ancestor_filter_allows(*ancestor_filter, selector.complex_selectors()[component_list_index - 1].compound_selector))
+            return false;
         for (auto* ancestor = element.parent(); ancestor; ancestor = ancestor->parent()) {
             if (!is<Element>(*ancestor))
                 continue;
-            if (matches(selector, component_list_index - 1, to<Element>(*ancestor)))
+            if (matches(selector, component_list_index - 1, to<Element>(*ancestor), ancestor_filter))
                 return true;
         }
         return false;
@@ -141,10 +186,10 @@ bool matches(const Selector& selector, int component_list_index, const Element&
     ASSERT_NOT_REACHED();
 }
 
-bool matches(const Selector& selector, const Element& element)
+bool matches(const Selector& selector, const Element& element, const AncestorFilter* ancestor_filter)
 {
     ASSERT(!selector.complex_selectors().is_empty());
-    return matches(selector, selector.complex_selectors().size() - 1, element);
+    return matches(selector, selector.complex_selectors().size() - 1, element, ancestor_filter);
 }
 
 }
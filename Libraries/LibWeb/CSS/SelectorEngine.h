@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/Types.h>
 #include <LibWeb/CSS/Selector.h>
 
 namespace Web {
@@ -34,7 +35,30 @@ class Element;
 
 namespace SelectorEngine {
 
-bool matches(const Selector&, const Element&);
+// A tiny bloom filter over the identifiers (tag names, ids, classes) found
+// on an element's ancestor chain. Descendant matching can then reject most
+// non-matching selectors without walking the parent chain at all.
+class AncestorFilter {
+public:
+    void add(u32 hash) { m_mask |= mask_for_hash(hash); }
+    bool may_contain(u32 hash) const
+    {
+        u64 mask = mask_for_hash(hash);
+        return (m_mask & mask) == mask;
+    }
+
+private:
+    static u64 mask_for_hash(u32 hash)
+    {
+        return (1ull << (hash & 63)) | (1ull << ((hash >> 16) & 63));
+    }
+
+    u64 m_mask { 0 };
+};
+
+AncestorFilter build_ancestor_filter(const Element&);
+
+bool matches(const Selector&, const Element&, const AncestorFilter* = nullptr);
 
 }
 
@@ -36,8 +36,9 @@ StyleProperties::StyleProperties()
 }
 
 StyleProperties::StyleProperties(const StyleProperties& other)
-    : m_property_values(other.m_property_values)
 {
+    for (size_t i = 0; i < (size_t)CSS::PropertyID::__Count; ++i)
+        m_property_values[i] = other.m_property_values[i];
     if (other.m_font) {
         m_font = other.m_font->clone();
     } else {
@@ -52,15 +53,15 @@ NonnullRefPtr<StyleProperties> StyleProperties::clone() const
 
 void StyleProperties::set_property(CSS::PropertyID id, NonnullRefPtr<StyleValue> value)
 {
-    m_property_values.set((unsigned)id, move(value));
+    m_property_values[(size_t)id] = move(value);
 }
 
 Optional<NonnullRefPtr<StyleValue>> StyleProperties::property(CSS::PropertyID id) const
 {
-    auto it = m_property_values.find((unsigned)id);
-    if (it == m_property_values.end())
+    auto& slot = m_property_values[(size_t)id];
+    if (!slot)
         return {};
-    return it->value;
+    return NonnullRefPtr<StyleValue>(*slot);
 }
 
 Length StyleProperties::length_or_fallback(CSS::PropertyID id, const Length& fallback) const
@@ -180,18 +181,16 @@ CSS::Position StyleProperties::position() const
 
 bool StyleProperties::operator==(const StyleProperties& other) const
 {
-    if (m_property_values.size() != other.m_property_values.size())
-        return false;
-
-    for (auto& it : m_property_values) {
-        auto jt = other.m_property_values.find(it.key);
-        if (jt == other.m_property_values.end())
+    for (size_t i = 0; i < (size_t)CSS::PropertyID::__Count; ++i) {
+        auto& my_value = m_property_values[i];
+        auto& other_value = other.m_property_values[i];
+        if (!my_value != !other_value)
             return false;
-        auto& my_value = *it.value;
-        auto& other_value = *jt->value;
-        if (my_value.type() != other_value.type())
+        if (!my_value)
+            continue;
+        if (my_value->type() != other_value->type())
             return false;
-        if (my_value.to_string() != other_value.to_string())
+        if (my_value->to_string() != other_value->to_string())
             return false;
     }
 
@@ -26,7 +26,6 @@
 
 #pragma once
 
-#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/Forward.h>
@@ -47,8 +46,10 @@ public:
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (auto& it : m_property_values)
-            callback((CSS::PropertyID)it.key, *it.value);
+        for (size_t i = 0; i < (size_t)CSS::PropertyID::__Count; ++i) {
+            if (m_property_values[i])
+                callback((CSS::PropertyID)i, *m_property_values[i]);
+        }
     }
 
     void set_property(CSS::PropertyID, NonnullRefPtr<StyleValue> value);
@@ -73,7 +74,9 @@ public:
     CSS::Position position() const;
 
 private:
-    HashMap<unsigned, NonnullRefPtr<StyleValue>> m_property_values;
+    // One fixed slot per PropertyID: property reads during style recalc
+    // and layout are plain array indexing, no hashing.
+    RefPtr<StyleValue> m_property_values[(size_t)CSS::PropertyID::__Count];
 
     void load_font() const;
 
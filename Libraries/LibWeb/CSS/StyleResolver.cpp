@@ -24,8 +24,11 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/QuickSort.h>
+#include <LibWeb/CSS/DefaultStyleSheet.h>
 #include <LibWeb/CSS/SelectorEngine.h>
 #include <LibWeb/CSS/StyleResolver.h>
+#include <LibWeb/CSS/StyleRule.h>
 #include <LibWeb/CSS/StyleSheet.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
@@ -49,9 +52,9 @@ static StyleSheet& default_stylesheet()
 {
     static StyleSheet* sheet;
     if (!sheet) {
-        extern const char default_stylesheet_source[];
-        String css = default_stylesheet_source;
-        sheet = parse_css(css).leak_ref();
+        // The UA sheet was compiled to object construction code at build
+        // time, so this doesn't have to run the CSS parser.
+        sheet = &create_default_stylesheet().leak_ref();
     }
     return *sheet;
 }
@@ -65,25 +68,117 @@ void StyleResolver::for_each_stylesheet(Callback callback) const
     }
 }
 
-NonnullRefPtrVector<StyleRule> StyleResolver::collect_matching_rules(const Element& element) const
+static const Selector::SimpleSelector* index_key_for_selector(const Selector& selector)
 {
-    NonnullRefPtrVector<StyleRule> matching_rules;
+    auto& compound_selector = selector.complex_selectors().last().compound_selector;
+    const Selector::SimpleSelector* class_key = nullptr;
+    const Selector::SimpleSelector* tag_name_key = nullptr;
+    for (auto& simple_selector : compound_selector) {
+        if (simple_selector.type == Selector::SimpleSelector::Type::Id)
+            return &simple_selector;
+        if (simple_selector.type == Selector::SimpleSelector::Type::Class && !class_key)
+            class_key = &simple_selector;
+        if (simple_selector.type == Selector::SimpleSelector::Type::TagName && !tag_name_key)
+            tag_name_key = &simple_selector;
+    }
+    if (class_key)
+        return class_key;
+    return tag_name_key;
+}
 
+void StyleResolver::ensure_rule_index() const
+{
+    // Stylesheets arrive one by one while the document loads, so rebuild the
+    // index whenever the sheet or rule count has changed since last time.
+    size_t stylesheet_count = 0;
+    size_t rule_count = 0;
+    for_each_stylesheet([&](auto& sheet) {
+        ++stylesheet_count;
+        rule_count += sheet.rules().size();
+    });
+
+    if (m_rule_index && m_rule_index->stylesheet_count == stylesheet_count && m_rule_index->rule_count == rule_count)
+        return;
+
+    auto index = make<RuleIndex>();
+    index->stylesheet_count = stylesheet_count;
+    index->rule_count = rule_count;
+
+    size_t position = 0;
     for_each_stylesheet([&](auto& sheet) {
         for (auto& rule : sheet.rules()) {
-            for (auto& selector : rule.selectors()) {
-                if (SelectorEngine::matches(selector, element)) {
-                    matching_rules.append(rule);
-                    break;
-                }
+            for (size_t i = 0; i < rule.selectors().size(); ++i) {
+                auto& selector = rule.selectors()[i];
+                IndexedRule entry { rule, i, position };
+                const Selector::SimpleSelector* key = nullptr;
+                if (!selector.complex_selectors().is_empty())
+                    key = index_key_for_selector(selector);
+                if (!key)
+                    index->other_rules.append(move(entry));
+                else if (key->type == Selector::SimpleSelector::Type::Id)
+                    index->rules_by_id.ensure(key->value).append(move(entry));
+                else if (key->type == Selector::SimpleSelector::Type::Class)
+                    index->rules_by_class.ensure(key->value).append(move(entry));
+                else
+                    index->rules_by_tag_name.ensure(key->value).append(move(entry));
             }
+            ++position;
         }
     });
 
+    m_rule_index = move(index);
+}
+
+Vector<const StyleRule*, 32> StyleResolver::collect_matching_rules(const Element& element) const
+{
+    ensure_rule_index();
+
+    Vector<const IndexedRule*, 32> candidates;
+    auto add_candidates_from_bucket = [&](auto& bucket_map, const FlyString& key) {
+        auto it = bucket_map.find(key);
+        if (it == bucket_map.end())
+            return;
+        for (auto& entry : it->value)
+            candidates.append(&entry);
+    };
+
+    auto id = element.attribute("id");
+    if (!id.is_null())
+        add_candidates_from_bucket(m_rule_index->rules_by_id, id);
+    auto class_attribute = element.attribute("class");
+    if (!class_attribute.is_empty()) {
+        // Split the same way Element::has_class() does.
+        for (auto& class_name : class_attribute.split_view(' '))
+            add_candidates_from_bucket(m_rule_index->rules_by_class, class_name);
+    }
+    add_candidates_from_bucket(m_rule_index->rules_by_tag_name, element.tag_name());
+    for (auto& entry : m_rule_index->other_rules)
+        candidates.append(&entry);
+
+    auto ancestor_filter = SelectorEngine::build_ancestor_filter(element);
+
+    Vector<const IndexedRule*, 32> matched_entries;
+    for (auto* candidate : candidates) {
+        if (SelectorEngine::matches(candidate->rule->selectors()[candidate->selector_index], element, &ancestor_filter))
+            matched_entries.append(candidate);
+    }
+    quick_sort(matched_entries, [](auto* a, auto* b) { return a->position < b->position; });
+
+    // The stylesheets own the rules and outlive style resolution, so hand
+    // back borrowed pointers instead of bumping every matched rule's
+    // ref count per styled element.
+    Vector<const StyleRule*, 32> matching_rules;
+    for (size_t i = 0; i < matched_entries.size(); ++i) {
+        // A rule can match through several of its selectors; emit it once.
+        if (i > 0 && matched_entries[i]->position == matched_entries[i - 1]->position)
+            continue;
+        matching_rules.append(matched_entries[i]->rule.ptr());
+    }
+
 #ifdef HTML_DEBUG
     dbgprintf("Rules matching Element{%p}\n", &element);
-    for (auto& rule : matching_rules) {
-        dump_rule(rule);
+    for (auto* rule : matching_rules) {
+        dump_rule(*rule);
     }
 #endif
 
@@ -365,8 +460,8 @@ NonnullRefPtr<StyleProperties> StyleResolver::resolve_style(const Element& eleme
     element.apply_presentational_hints(*style);
 
     auto matching_rules = collect_matching_rules(element);
-    for (auto& rule : matching_rules) {
-        for (auto& property : rule.declaration().properties()) {
+    for (auto* rule : matching_rules) {
+        for (auto& property : rule->declaration().properties()) {
             set_property_expanding_shorthands(style, property.property_id, property.value);
         }
     }
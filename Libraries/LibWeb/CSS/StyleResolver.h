@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <LibWeb/CSS/StyleProperties.h>
@@ -48,7 +49,9 @@ public:
 
     NonnullRefPtr<StyleProperties> resolve_style(const Element&, const StyleProperties* parent_style) const;
 
-    NonnullRefPtrVector<StyleRule> collect_matching_rules(const Element&) const;
+    // The returned pointers borrow from the document's stylesheets, which
+    // outlive any one style resolution; no ref counts change hands.
+    Vector<const StyleRule*, 32> collect_matching_rules(const Element&) const;
 
     static bool is_inherited_property(CSS::PropertyID);
 
@@ -56,7 +59,30 @@ private:
     template<typename Callback>
     void for_each_stylesheet(Callback) const;
 
+    // Rules bucketed by the most specific key (id, then class, then tag
+    // name) of their rightmost compound selector, so an element only has to
+    // run the selector engine against plausible candidates. Rules without
+    // such a key (e.g. "*") go in other_rules and are tested against every
+    // element. One entry per selector; position is the rule's document-wide
+    // cascade order.
+    struct IndexedRule {
+        NonnullRefPtr<StyleRule> rule;
+        size_t selector_index { 0 };
+        size_t position { 0 };
+    };
+    struct RuleIndex {
+        HashMap<FlyString, Vector<IndexedRule>> rules_by_id;
+        HashMap<FlyString, Vector<IndexedRule>> rules_by_class;
+        HashMap<FlyString, Vector<IndexedRule>> rules_by_tag_name;
+        Vector<IndexedRule> other_rules;
+        size_t stylesheet_count { 0 };
+        size_t rule_count { 0 };
+    };
+
+    void ensure_rule_index() const;
+
     Document& m_document;
+    mutable OwnPtr<RuleIndex> m_rule_index;
 };
 
 }
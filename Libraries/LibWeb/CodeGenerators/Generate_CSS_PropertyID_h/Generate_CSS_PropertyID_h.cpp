@@ -72,6 +72,8 @@ int main(int argc, char** argv)
         out() << "    " << title_casify(name) << ",";
     });
 
+    out() << "    __Count,";
+
     out() << "};\n\
 PropertyID property_id_from_string(const StringView&);\n\
 const char* string_from_property_id(PropertyID);\n\
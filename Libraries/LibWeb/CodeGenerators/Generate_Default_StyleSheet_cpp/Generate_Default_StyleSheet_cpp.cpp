@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2020, the SerenityOS developers.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compiles the UA stylesheet (CSS/Default.css) into C++ that constructs the
+// StyleSheet object tree directly, so nothing has to run the CSS parser at
+// runtime. The sheet only uses a small, stable subset of CSS: compound
+// selectors with tag/class/id/universal parts and :pseudo-classes, and
+// single-token declaration values. Values the generator can resolve
+// statically (lengths, hex colors, inherit/initial/auto) become direct
+// StyleValue constructor calls; anything else falls back to a
+// parse_css_value() call, which mirrors exactly what the runtime parser
+// would have done with that value string.
+
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibCore/File.h>
+#include <ctype.h>
+#include <stdio.h>
+
+static String title_casify(const String& dashy_name)
+{
+    auto parts = dashy_name.split('-');
+    StringBuilder builder;
+    for (auto& part : parts) {
+        if (part.is_empty())
+            continue;
+        builder.append(toupper(part[0]));
+        if (part.length() == 1)
+            continue;
+        builder.append(part.substring_view(1, part.length() - 1));
+    }
+    return builder.to_string();
+}
+
+static String escape_string(const StringView& string)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < string.length(); ++i) {
+        char ch = string[i];
+        if (ch == '"' || ch == '\\')
+            builder.append('\\');
+        builder.append(ch);
+    }
+    return builder.to_string();
+}
+
+static Optional<size_t> find_from(const String& haystack, char needle, size_t start)
+{
+    for (size_t i = start; i < haystack.length(); ++i) {
+        if (haystack[i] == needle)
+            return i;
+    }
+    return {};
+}
+
+static String trim_whitespace(const StringView& view)
+{
+    size_t start = 0;
+    size_t end = view.length();
+    while (start < end && isspace(view[start]))
+        ++start;
+    while (end > start && isspace(view[end - 1]))
+        --end;
+    return view.substring_view(start, end - start);
+}
+
+static bool is_number_token(const StringView& view)
+{
+    StringView digits = view;
+    if (digits.length() >= 2 && digits[digits.length() - 2] == 'p' && digits[digits.length() - 1] == 'x')
+        digits = digits.substring_view(0, digits.length() - 2);
+    if (digits.is_empty())
+        return false;
+    size_t i = 0;
+    if (digits[0] == '-')
+        ++i;
+    if (i == digits.length())
+        return false;
+    bool seen_dot = false;
+    for (; i < digits.length(); ++i) {
+        if (digits[i] == '.') {
+            if (seen_dot)
+                return false;
+            seen_dot = true;
+            continue;
+        }
+        if (!isdigit(digits[i]))
+            return false;
+    }
+    return true;
+}
+
+static String number_without_unit(const String& value)
+{
+    if (value.length() >= 2 && value[value.length() - 2] == 'p' && value[value.length() - 1] == 'x')
+        return value.substring(0, value.length() - 2);
+    return value;
+}
+
+// Emits the expression constructing the StyleValue for a declaration value,
+// mirroring parse_css_value()'s decisions where they're statically knowable.
+static String style_value_expression(const String& value)
+{
+    if (is_number_token(value)) {
+        auto number = number_without_unit(value);
+        const char* suffix = number.index_of(".").has_value() ? "f" : ".0f";
+        return String::format("LengthStyleValue::create(Length(%s%s, Length::Type::Absolute))", number.characters(), suffix);
+    }
+    if (value == "inherit")
+        return "InheritStyleValue::create()";
+    if (value == "initial")
+        return "InitialStyleValue::create()";
+    if (value == "auto")
+        return "LengthStyleValue::create(Length())";
+    if (value == "-libhtml-link")
+        return "IdentifierStyleValue::create(CSS::ValueID::VendorSpecificLink)";
+    if (value.length() == 7 && value[0] == '#') {
+        bool valid = true;
+        for (size_t i = 1; i < 7; ++i)
+            valid = valid && isxdigit(value[i]);
+        if (valid)
+            return String::format("ColorStyleValue::create(Color::from_rgb(0x%s))", value.substring(1, 6).characters());
+    }
+    // Named colors and plain identifiers: let the runtime value parser
+    // decide, same as the text parser would per declaration.
+    return String::format("parse_css_value(\"%s\")", escape_string(value).characters());
+}
+
+struct SimpleSelector {
+    String type { "Invalid" };
+    String pseudo_class { "None" };
+    String value;
+};
+
+static bool parse_simple_selector(const String& part, SimpleSelector& out)
+{
+    String base = part;
+    auto colon_index = part.index_of(":");
+    if (colon_index.has_value()) {
+        base = part.substring(0, colon_index.value());
+        auto pseudo = part.substring(colon_index.value() + 1, part.length() - colon_index.value() - 1);
+        if (pseudo == "link")
+            out.pseudo_class = "Link";
+        else if (pseudo == "hover")
+            out.pseudo_class = "Hover";
+        else if (pseudo == "first-child")
+            out.pseudo_class = "FirstChild";
+        else if (pseudo == "last-child")
+            out.pseudo_class = "LastChild";
+        else if (pseudo == "only-child")
+            out.pseudo_class = "OnlyChild";
+        else if (pseudo == "empty")
+            out.pseudo_class = "Empty";
+        else
+            return false;
+    }
+    if (base == "*") {
+        out.type = "Universal";
+        return true;
+    }
+    if (base.starts_with(".")) {
+        out.type = "Class";
+        out.value = base.substring(1, base.length() - 1);
+        return true;
+    }
+    if (base.starts_with("#")) {
+        out.type = "Id";
+        out.value = base.substring(1, base.length() - 1);
+        return true;
+    }
+    if (base.is_empty())
+        return !colon_index.has_value() ? false : true;
+    for (size_t i = 0; i < base.length(); ++i) {
+        if (!isalnum(base[i]) && base[i] != '-')
+            return false;
+    }
+    out.type = "TagName";
+    out.value = base;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <path/to/CSS/Default.css>\n", argv[0]);
+        return 1;
+    }
+    auto file = Core::File::construct(argv[1]);
+    if (!file->open(Core::IODevice::ReadOnly))
+        return 1;
+
+    String css = String::copy(file->read_all());
+
+    out() << "#include <LibGfx/Color.h>";
+    out() << "#include <LibWeb/CSS/DefaultStyleSheet.h>";
+    out() << "#include <LibWeb/CSS/StyleSheet.h>";
+    out() << "#include <LibWeb/Parser/CSSParser.h>";
+    out() << "";
+    out() << "namespace Web {";
+    out() << "";
+    out() << "NonnullRefPtr<StyleSheet> create_default_stylesheet()";
+    out() << "{";
+    out() << "    NonnullRefPtrVector<StyleRule> rules;";
+
+    size_t index = 0;
+    while (index < css.length()) {
+        // Selector group up to '{'.
+        auto open_index = find_from(css, '{', index);
+        if (!open_index.has_value())
+            break;
+        auto close_index = find_from(css, '}', open_index.value());
+        if (!close_index.has_value()) {
+            fprintf(stderr, "Generate_Default_StyleSheet_cpp: unterminated rule\n");
+            return 1;
+        }
+        String selector_group = trim_whitespace(css.substring_view(index, open_index.value() - index));
+        String body = css.substring(open_index.value() + 1, close_index.value() - open_index.value() - 1);
+        index = close_index.value() + 1;
+
+        out() << "    {";
+        out() << "        Vector<Selector> selectors;";
+        for (auto& selector_text : selector_group.split(',')) {
+            auto trimmed = trim_whitespace(selector_text);
+            if (trimmed.is_empty())
+                continue;
+            out() << "        {";
+            out() << "            Vector<Selector::ComplexSelector> complex_selectors;";
+            String relation = "None";
+            StringBuilder normalized;
+            for (size_t i = 0; i < trimmed.length(); ++i)
+                normalized.append(isspace(trimmed[i]) ? ' ' : trimmed[i]);
+            for (auto& part : normalized.to_string().split(' ')) {
+                auto compound = trim_whitespace(part);
+                if (compound.is_empty())
+                    continue;
+                if (compound == ">") {
+                    relation = "ImmediateChild";
+                    continue;
+                }
+                if (compound == "+") {
+                    relation = "AdjacentSibling";
+                    continue;
+                }
+                if (compound == "~") {
+                    relation = "GeneralSibling";
+                    continue;
+                }
+                SimpleSelector simple;
+                if (!parse_simple_selector(compound, simple)) {
+                    fprintf(stderr, "Generate_Default_StyleSheet_cpp: unsupported selector '%s'\n", compound.characters());
+                    return 1;
+                }
+                StringBuilder builder;
+                builder.appendf("            complex_selectors.append({ Selector::ComplexSelector::Relation::%s, { { Selector::SimpleSelector::Type::%s, Selector::SimpleSelector::PseudoClass::%s, \"%s\" } } });",
+                    relation.characters(), simple.type.characters(), simple.pseudo_class.characters(), escape_string(simple.value).characters());
+                out() << builder.to_string();
+                relation = "Descendant";
+            }
+            out() << "            selectors.append(Selector(move(complex_selectors)));";
+            out() << "        }";
+        }
+
+        out() << "        Vector<StyleProperty> properties;";
+        for (auto& declaration : body.split(';')) {
+            auto trimmed = trim_whitespace(declaration);
+            if (trimmed.is_empty())
+                continue;
+            auto colon_index = trimmed.index_of(":");
+            if (!colon_index.has_value()) {
+                fprintf(stderr, "Generate_Default_StyleSheet_cpp: malformed declaration '%s'\n", trimmed.characters());
+                return 1;
+            }
+            String property_name = trim_whitespace(trimmed.substring_view(0, colon_index.value()));
+            String value = trim_whitespace(trimmed.substring_view(colon_index.value() + 1, trimmed.length() - colon_index.value() - 1));
+            bool important = false;
+            if (value.ends_with("!important")) {
+                important = true;
+                value = trim_whitespace(value.substring_view(0, value.length() - 10));
+            }
+            StringBuilder builder;
+            builder.appendf("        properties.append({ CSS::PropertyID::%s, %s, %s });",
+                title_casify(property_name).characters(), style_value_expression(value).characters(), important ? "true" : "false");
+            out() << builder.to_string();
+        }
+        out() << "        rules.append(StyleRule::create(move(selectors), StyleDeclaration::create(move(properties))));";
+        out() << "    }";
+    }
+
+    out() << "    return StyleSheet::create(move(rules));";
+    out() << "}";
+    out() << "";
+    out() << "}";
+
+    return 0;
+}
@@ -176,6 +176,20 @@ void CanvasRenderingContext2D::stroke()
     painter->stroke_path(m_path, m_stroke_style, m_line_width);
 }
 
+void CanvasRenderingContext2D::fill(const String& fill_rule)
+{
+    auto painter = this->painter();
+    if (!painter)
+        return;
+
+    auto winding_rule = Gfx::Painter::WindingRule::Nonzero;
+    if (fill_rule == "evenodd")
+        winding_rule = Gfx::Painter::WindingRule::EvenOdd;
+
+    painter->fill_path(m_path, m_fill_style, winding_rule);
+    did_draw(Gfx::FloatRect());
+}
+
 RefPtr<ImageData> CanvasRenderingContext2D::create_image_data(JS::GlobalObject& global_object, int width, int height) const
 {
     return ImageData::create_with_size(global_object, width, height);
@@ -70,6 +70,7 @@ public:
     void move_to(float x, float y);
     void line_to(float x, float y);
     void stroke();
+    void fill(const String& fill_rule);
 
     RefPtr<ImageData> create_image_data(JS::GlobalObject&, int width, int height) const;
     void put_image_data(const ImageData&, float x, float y);
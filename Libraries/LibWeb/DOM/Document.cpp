@@ -231,6 +231,7 @@ void Document::layout()
     }
     m_layout_root->layout();
     m_layout_root->set_needs_display();
+    m_layout_root->clear_needs_layout();
 }
 
 void Document::update_style()
@@ -248,7 +249,32 @@ void Document::update_layout()
     if (!frame())
         return;
 
-    layout();
+    if (!m_layout_root || m_layout_root->needs_layout()) {
+        layout();
+    } else if (m_layout_root->child_needs_layout()) {
+        // Only dirty subtrees get re-laid-out. A dirty block is re-laid-out
+        // in place; if its rect changes, the damage escapes into its
+        // containing block, so we bubble up and relayout that one as well.
+        m_layout_root->for_each_in_subtree([&](auto& node) {
+            if (!node.needs_layout())
+                return IterationDecision::Continue;
+            auto* block = node.is_block() ? static_cast<LayoutBlock*>(&node) : const_cast<LayoutBlock*>(node.containing_block());
+            while (block) {
+                auto old_rect = block->rect();
+                block->layout();
+                block->set_needs_display();
+                if (block->rect() == old_rect)
+                    break;
+                block = const_cast<LayoutBlock*>(block->containing_block());
+            }
+            return IterationDecision::Continue;
+        });
+        m_layout_root->clear_needs_layout();
+    } else {
+        // Nothing is dirty; leave the layout tree alone.
+        return;
+    }
+
     if (on_layout_updated)
         on_layout_updated();
 }
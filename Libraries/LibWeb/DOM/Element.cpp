@@ -159,6 +159,25 @@ static StyleDifference compute_style_difference(const StyleProperties& old_style
     else if (new_style.color_or_fallback(CSS::PropertyID::BackgroundColor, document, Color::Black) != old_style.color_or_fallback(CSS::PropertyID::BackgroundColor, document, Color::Black))
         needs_repaint = true;
 
+    // A difference in anything other than the paint-only colors above can
+    // move boxes around, so be conservative and relayout.
+    auto is_paint_only_property = [](CSS::PropertyID property_id) {
+        return property_id == CSS::PropertyID::Color || property_id == CSS::PropertyID::BackgroundColor;
+    };
+    auto has_layout_affecting_difference = [&](const StyleProperties& a, const StyleProperties& b) {
+        bool result = false;
+        a.for_each_property([&](auto property_id, auto& value) {
+            if (result || is_paint_only_property(property_id))
+                return;
+            auto other_value = b.property(property_id);
+            if (!other_value.has_value() || other_value.value()->to_string() != value.to_string())
+                result = true;
+        });
+        return result;
+    };
+    if (has_layout_affecting_difference(old_style, new_style) || has_layout_affecting_difference(new_style, old_style))
+        needs_relayout = true;
+
     if (needs_relayout)
         return StyleDifference::NeedsRelayout;
     if (needs_repaint)
@@ -182,6 +201,8 @@ void Element::recompute_style()
         // We need a new layout tree here!
         LayoutTreeBuilder tree_builder;
         tree_builder.build(*this);
+        if (layout_node())
+            layout_node()->set_needs_layout();
         return;
     }
     auto diff = compute_style_difference(layout_node()->style(), *style, document());
@@ -189,7 +210,8 @@ void Element::recompute_style()
         return;
     layout_node()->set_style(*style);
     if (diff == StyleDifference::NeedsRelayout) {
-        ASSERT_NOT_REACHED();
+        layout_node()->set_needs_layout();
+        return;
     }
     if (diff == StyleDifference::NeedsRepaint) {
         layout_node()->set_needs_display();
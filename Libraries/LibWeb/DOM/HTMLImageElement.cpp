@@ -24,12 +24,14 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <LibCore/Timer.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageDecoder.h>
 #include <LibWeb/CSS/StyleResolver.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/HTMLImageElement.h>
+#include <LibWeb/Frame.h>
 #include <LibWeb/Layout/LayoutImage.h>
 #include <LibWeb/ResourceLoader.h>
 
@@ -42,6 +44,8 @@ HTMLImageElement::HTMLImageElement(Document& document, const FlyString& tag_name
 
 HTMLImageElement::~HTMLImageElement()
 {
+    if (m_image_cache_entry && !m_is_volatile)
+        m_image_cache_entry->mark_volatile();
 }
 
 void HTMLImageElement::parse_attribute(const FlyString& name, const String& value)
@@ -53,7 +57,14 @@ void HTMLImageElement::parse_attribute(const FlyString& name, const String& valu
 void HTMLImageElement::load_image(const String& src)
 {
     URL src_url = document().complete_url(src);
-    ResourceLoader::the().load(src_url, [this, weak_element = make_weak_ptr()](auto data) {
+
+    // Someone else may have downloaded and decoded this image already.
+    if (auto cached_entry = ImageCache::the().get(src_url)) {
+        adopt_image_cache_entry(cached_entry.release_nonnull());
+        return;
+    }
+
+    ResourceLoader::the().load(src_url, [this, weak_element = make_weak_ptr(), src_url](auto data) {
         if (!weak_element) {
             dbg() << "HTMLImageElement: Load completed after element destroyed.";
             return;
@@ -63,13 +74,66 @@ void HTMLImageElement::load_image(const String& src)
             return;
         }
 
-        m_encoded_data = data;
-        m_image_decoder = Gfx::ImageDecoder::create(m_encoded_data.data(), m_encoded_data.size());
+        adopt_image_cache_entry(ImageCache::the().add(src_url, move(data)));
+    });
+}
+
+void HTMLImageElement::adopt_image_cache_entry(NonnullRefPtr<ImageCacheEntry> entry)
+{
+    if (m_image_cache_entry && !m_is_volatile)
+        m_image_cache_entry->mark_volatile();
+    m_image_cache_entry = move(entry);
+    m_is_volatile = false;
+    m_image_cache_entry->mark_nonvolatile();
+
+    auto* decoder = image_decoder();
+
+    m_current_frame = nullptr;
+    m_current_frame_index = 0;
+    m_animation_timer = nullptr;
+    if (decoder && decoder->is_animated() && decoder->frame_count() > 1) {
+        auto first_frame = decoder->frame(0);
+        m_current_frame = first_frame.image;
+        m_animation_timer = Core::Timer::construct();
+        m_animation_timer->set_interval(first_frame.duration < 20 ? 100 : first_frame.duration);
+        m_animation_timer->on_timeout = [this] { animate(); };
+        m_animation_timer->start();
+    }
 
-        document().update_layout();
+    if (layout_node())
+        layout_node()->set_needs_layout();
+    document().update_layout();
 
-        dispatch_event(Event::create("load"));
-    });
+    dispatch_event(Event::create("load"));
+}
+
+void HTMLImageElement::animate()
+{
+    if (!layout_node())
+        return;
+
+    auto* decoder = image_decoder();
+    m_current_frame_index = (m_current_frame_index + 1) % decoder->frame_count();
+    auto current_frame = decoder->frame(m_current_frame_index);
+    m_current_frame = current_frame.image;
+
+    if (current_frame.duration != m_animation_timer->interval())
+        m_animation_timer->restart(current_frame.duration < 20 ? 100 : current_frame.duration);
+
+    // Invalidate only the region this frame actually changed, as long as
+    // the image is displayed unscaled.
+    if (layout_node()->is_box()) {
+        auto image_rect = enclosing_int_rect(to<LayoutBox>(*layout_node()).rect());
+        auto dirty_rect = current_frame.dirty_rect;
+        if (image_rect.size() == Gfx::Size(decoder->width(), decoder->height()))
+            dirty_rect.move_by(image_rect.x(), image_rect.y());
+        else
+            dirty_rect = image_rect;
+        if (auto* frame = document().frame())
+            frame->set_needs_display(dirty_rect);
+    } else {
+        layout_node()->set_needs_display();
+    }
 }
 
 int HTMLImageElement::preferred_width() const
@@ -79,8 +143,8 @@ int HTMLImageElement::preferred_width() const
     if (ok)
         return width;
 
-    if (m_image_decoder)
-        return m_image_decoder->width();
+    if (auto* decoder = image_decoder())
+        return decoder->width();
 
     return 0;
 }
@@ -92,8 +156,8 @@ int HTMLImageElement::preferred_height() const
     if (ok)
         return height;
 
-    if (m_image_decoder)
-        return m_image_decoder->height();
+    if (auto* decoder = image_decoder())
+        return decoder->height();
 
     return 0;
 }
@@ -109,23 +173,23 @@ RefPtr<LayoutNode> HTMLImageElement::create_layout_node(const StyleProperties* p
 
 const Gfx::Bitmap* HTMLImageElement::bitmap() const
 {
-    if (!m_image_decoder)
+    auto* decoder = image_decoder();
+    if (!decoder)
         return nullptr;
-    return m_image_decoder->bitmap();
+    if (m_current_frame)
+        return m_current_frame;
+    return decoder->bitmap();
 }
 
 void HTMLImageElement::set_volatile(Badge<LayoutDocument>, bool v)
 {
-    if (!m_image_decoder)
-        return;
-    if (v) {
-        m_image_decoder->set_volatile();
-        return;
-    }
-    bool has_image = m_image_decoder->set_nonvolatile();
-    if (has_image)
+    if (!m_image_cache_entry || v == m_is_volatile)
         return;
-    m_image_decoder = Gfx::ImageDecoder::create(m_encoded_data.data(), m_encoded_data.size());
+    m_is_volatile = v;
+    if (v)
+        m_image_cache_entry->mark_volatile();
+    else
+        m_image_cache_entry->mark_nonvolatile();
 }
 
 }
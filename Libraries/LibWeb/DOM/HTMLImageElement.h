@@ -27,8 +27,10 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <LibCore/Forward.h>
 #include <LibGfx/Forward.h>
 #include <LibWeb/DOM/HTMLElement.h>
+#include <LibWeb/ImageCache.h>
 
 namespace Web {
 
@@ -49,17 +51,29 @@ public:
     int preferred_height() const;
 
     const Gfx::Bitmap* bitmap() const;
-    const Gfx::ImageDecoder* image_decoder() const { return m_image_decoder; }
+    const Gfx::ImageDecoder* image_decoder() const { return m_image_cache_entry ? m_image_cache_entry->decoder() : nullptr; }
 
     void set_volatile(Badge<LayoutDocument>, bool);
 
 private:
     void load_image(const String& src);
+    void adopt_image_cache_entry(NonnullRefPtr<ImageCacheEntry>);
+    void animate();
+
+    Gfx::ImageDecoder* image_decoder() { return m_image_cache_entry ? m_image_cache_entry->decoder() : nullptr; }
 
     virtual RefPtr<LayoutNode> create_layout_node(const StyleProperties* parent_style) const override;
 
-    RefPtr<Gfx::ImageDecoder> m_image_decoder;
-    ByteBuffer m_encoded_data;
+    // Decoded bitmap and retained encoded data live in the process-wide
+    // ImageCache, shared with other elements showing the same URL.
+    RefPtr<ImageCacheEntry> m_image_cache_entry;
+    bool m_is_volatile { false };
+
+    // Animated images: the currently displayed frame and the timer that
+    // advances it.
+    RefPtr<Gfx::Bitmap> m_current_frame;
+    size_t m_current_frame_index { 0 };
+    RefPtr<Core::Timer> m_animation_timer;
 };
 
 template<>
@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/StringBuilder.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Function.h>
 #include <LibWeb/Bindings/EventWrapper.h>
@@ -48,15 +49,20 @@ XMLHttpRequest::~XMLHttpRequest()
 
 void XMLHttpRequest::set_ready_state(ReadyState ready_state)
 {
-    // FIXME: call onreadystatechange once we have that
     m_ready_state = ready_state;
+    dispatch_event(Event::create("readystatechange"));
 }
 
 String XMLHttpRequest::response_text() const
 {
-    if (m_response.is_null())
+    if (m_response_fragments.is_empty())
         return {};
-    return String::copy(m_response);
+    if (m_response_fragments.size() == 1)
+        return m_response_fragments.first();
+    StringBuilder builder;
+    for (auto& fragment : m_response_fragments)
+        builder.append(fragment);
+    return builder.to_string();
 }
 
 void XMLHttpRequest::open(const String& method, const String& url)
@@ -68,16 +74,20 @@ void XMLHttpRequest::open(const String& method, const String& url)
 
 void XMLHttpRequest::send()
 {
-    // FIXME: in order to properly set ReadyState::HeadersReceived and ReadyState::Loading,
-    // we need to make ResourceLoader give us more detailed updates than just "done" and "error".
+    // FIXME: We still can't set ReadyState::HeadersReceived, since ResourceLoader
+    // doesn't tell us about headers separately from the first body chunk.
     ResourceLoader::the().load(
         m_window->document().complete_url(m_url),
         [weak_this = make_weak_ptr()](auto& data) {
             if (!weak_this)
                 return;
-            const_cast<XMLHttpRequest&>(*weak_this).m_response = data;
-            const_cast<XMLHttpRequest&>(*weak_this).set_ready_state(ReadyState::Done);
-            const_cast<XMLHttpRequest&>(*weak_this).dispatch_event(Event::create("load"));
+            auto& xhr = const_cast<XMLHttpRequest&>(*weak_this);
+            // If the body arrived in chunks, we already have it; don't keep
+            // a second copy of the whole payload around.
+            if (xhr.m_response_fragments.is_empty() && !data.is_null())
+                xhr.m_response_fragments.append(String::copy(data));
+            xhr.set_ready_state(ReadyState::Done);
+            xhr.dispatch_event(Event::create("load"));
         },
         [weak_this = make_weak_ptr()](auto& error) {
             if (!weak_this)
@@ -85,6 +95,15 @@ void XMLHttpRequest::send()
             dbg() << "XHR failed to load: " << error;
             const_cast<XMLHttpRequest&>(*weak_this).set_ready_state(ReadyState::Done);
             const_cast<XMLHttpRequest&>(*weak_this).dispatch_event(Event::create("error"));
+        },
+        [weak_this = make_weak_ptr()](auto& chunk) {
+            if (!weak_this)
+                return;
+            auto& xhr = const_cast<XMLHttpRequest&>(*weak_this);
+            xhr.m_response_fragments.append(String::copy(chunk));
+            if (xhr.m_ready_state != ReadyState::Loading)
+                xhr.set_ready_state(ReadyState::Loading);
+            xhr.dispatch_event(Event::create("progress"));
         });
 }
 
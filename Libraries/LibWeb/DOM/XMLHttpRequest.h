@@ -26,8 +26,9 @@
 
 #pragma once
 
-#include <AK/ByteBuffer.h>
 #include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
 #include <AK/Weakable.h>
 #include <LibWeb/Bindings/Wrappable.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -59,6 +60,12 @@ public:
 
     ReadyState ready_state() const { return m_ready_state; };
     String response_text() const;
+
+    // The body as it has arrived so far, one String per network chunk.
+    // Kept unjoined so the responseText binding can build a rope string
+    // over the pieces instead of flattening them on every access.
+    const Vector<String>& response_fragments() const { return m_response_fragments; }
+
     void open(const String& method, const String& url);
     void send();
 
@@ -78,7 +85,7 @@ private:
     String m_method;
     String m_url;
 
-    ByteBuffer m_response;
+    Vector<String> m_response_fragments;
 };
 
 }
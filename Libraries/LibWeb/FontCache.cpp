@@ -45,3 +45,20 @@ void FontCache::set(const FontSelector& font_selector, NonnullRefPtr<Gfx::Font>
 {
     m_fonts.set(font_selector, move(font));
 }
+
+float FontCache::text_width(const Gfx::Font& font, const String& text)
+{
+    TextWidthKey key { &font, text };
+    auto cached_width = m_text_widths.get(key);
+    if (cached_width.has_value())
+        return cached_width.value();
+
+    float width = font.width(text);
+
+    // Keep the cache from growing without bound on pathological pages.
+    static const size_t max_cached_text_widths = 4096;
+    if (m_text_widths.size() >= max_cached_text_widths)
+        m_text_widths.clear();
+    m_text_widths.set(move(key), width);
+    return width;
+}
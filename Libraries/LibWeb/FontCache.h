@@ -40,11 +40,25 @@ struct FontSelector {
     }
 };
 
+struct TextWidthKey {
+    const Gfx::Font* font { nullptr };
+    String text;
+
+    bool operator==(const TextWidthKey& other) const
+    {
+        return font == other.font && text == other.text;
+    }
+};
+
 namespace AK {
 template<>
 struct Traits<FontSelector> : public GenericTraits<FontSelector> {
     static unsigned hash(const FontSelector& key) { return pair_int_hash(key.family.hash(), key.weight.hash()); }
 };
+template<>
+struct Traits<TextWidthKey> : public GenericTraits<TextWidthKey> {
+    static unsigned hash(const TextWidthKey& key) { return pair_int_hash(ptr_hash(key.font), key.text.hash()); }
+};
 }
 
 class FontCache {
@@ -53,7 +67,12 @@ public:
     RefPtr<Gfx::Font> get(const FontSelector&) const;
     void set(const FontSelector&, NonnullRefPtr<Gfx::Font>);
 
+    // Memoized Font::width(). Text layout measures the same words over and
+    // over across reflows, and each measurement walks the whole string.
+    float text_width(const Gfx::Font&, const String&);
+
 private:
     FontCache() {}
     mutable HashMap<FontSelector, NonnullRefPtr<Gfx::Font>> m_fonts;
+    HashMap<TextWidthKey, float> m_text_widths;
 };
@@ -126,6 +126,10 @@ void HtmlView::layout_and_sync_size()
 
     main_frame().set_viewport_rect(visible_content_rect());
 
+    // Layout may have moved anything anywhere; the retained viewport is
+    // no longer trustworthy.
+    m_viewport_bitmap_valid = false;
+
 #ifdef HTML_DEBUG
     dbgprintf("\033[33;1mLayout tree after layout:\033[0m\n");
     ::dump_tree(*layout_root());
@@ -138,6 +142,30 @@ void HtmlView::resize_event(GUI::ResizeEvent& event)
     layout_and_sync_size();
 }
 
+void HtmlView::render_into_viewport_bitmap(const Gfx::Rect& bitmap_rect, const Gfx::Point& scroll_position)
+{
+    if (bitmap_rect.is_empty())
+        return;
+
+    GUI::Painter painter(*m_viewport_bitmap);
+    painter.add_clip_rect(bitmap_rect);
+
+    painter.fill_rect(bitmap_rect, document()->background_color(palette()));
+
+    if (auto background_bitmap = document()->background_image()) {
+        painter.draw_tiled_bitmap(bitmap_rect, *background_bitmap);
+    }
+
+    painter.translate(-scroll_position.x(), -scroll_position.y());
+
+    RenderingContext context(painter, palette());
+    context.set_should_show_line_box_borders(m_should_show_line_box_borders);
+    // Restricting the viewport to the strip we're rendering lets layout
+    // nodes that cull against it skip themselves entirely.
+    context.set_viewport_rect(bitmap_rect.translated(scroll_position));
+    layout_root()->render(context);
+}
+
 void HtmlView::paint_event(GUI::PaintEvent& event)
 {
     GUI::Frame::paint_event(event);
@@ -151,19 +179,49 @@ void HtmlView::paint_event(GUI::PaintEvent& event)
         return;
     }
 
-    painter.fill_rect(event.rect(), document()->background_color(palette()));
+    auto inner_rect = widget_inner_rect();
+    if (!m_viewport_bitmap || m_viewport_bitmap->size() != inner_rect.size()) {
+        m_viewport_bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::RGB32, inner_rect.size());
+        m_viewport_bitmap_valid = false;
+    }
 
-    if (auto background_bitmap = document()->background_image()) {
-        painter.draw_tiled_bitmap(event.rect(), *background_bitmap);
+    Gfx::Point scroll_position { horizontal_scrollbar().value(), vertical_scrollbar().value() };
+    int delta_x = scroll_position.x() - m_viewport_scroll_position.x();
+    int delta_y = scroll_position.y() - m_viewport_scroll_position.y();
+    bool scrolled = m_scrolled_since_last_paint;
+    m_scrolled_since_last_paint = false;
+
+    if (m_viewport_bitmap_valid && scrolled && delta_x == 0 && delta_y != 0 && abs(delta_y) < inner_rect.height()) {
+        // Scroll blitting: shift the retained viewport by the scroll delta
+        // and re-render only the strip that came into view, so the cost of
+        // scrolling is proportional to the delta instead of the viewport.
+        // Purely vertical deltas are the common case; anything else takes
+        // the full re-render below.
+        int height = inner_rect.height();
+        size_t row_bytes = m_viewport_bitmap->pitch();
+        if (delta_y > 0) {
+            for (int y = 0; y < height - delta_y; ++y)
+                memcpy(m_viewport_bitmap->scanline(y), m_viewport_bitmap->scanline(y + delta_y), row_bytes);
+        } else {
+            for (int y = height - 1; y >= -delta_y; --y)
+                memcpy(m_viewport_bitmap->scanline(y), m_viewport_bitmap->scanline(y + delta_y), row_bytes);
+        }
+        Gfx::Rect exposed_rect = delta_y > 0
+            ? Gfx::Rect { 0, height - delta_y, inner_rect.width(), delta_y }
+            : Gfx::Rect { 0, 0, inner_rect.width(), -delta_y };
+        render_into_viewport_bitmap(exposed_rect, scroll_position);
+    } else if (m_viewport_bitmap_valid && !scrolled && delta_x == 0 && delta_y == 0) {
+        // Content invalidation without scrolling: refresh only the dirty part.
+        auto dirty_rect = event.rect().translated(-inner_rect.location()).intersected({ {}, inner_rect.size() });
+        render_into_viewport_bitmap(dirty_rect, scroll_position);
+    } else {
+        render_into_viewport_bitmap({ {}, inner_rect.size() }, scroll_position);
     }
 
-    painter.translate(frame_thickness(), frame_thickness());
-    painter.translate(-horizontal_scrollbar().value(), -vertical_scrollbar().value());
+    m_viewport_bitmap_valid = true;
+    m_viewport_scroll_position = scroll_position;
 
-    RenderingContext context(painter, palette());
-    context.set_should_show_line_box_borders(m_should_show_line_box_borders);
-    context.set_viewport_rect(visible_content_rect());
-    layout_root()->render(context);
+    painter.blit(inner_rect.location(), *m_viewport_bitmap, { {}, inner_rect.size() });
 }
 
 void HtmlView::mousemove_event(GUI::MouseEvent& event)
@@ -370,6 +428,7 @@ void HtmlView::load(const URL& url)
             if (url.path().ends_with(".png") || url.path().ends_with(".gif")) {
                 document = create_image_document(data, url);
             } else {
+                prefetch_html_resources(data, url);
                 document = parse_html_document(data, url);
             }
             ASSERT(document);
@@ -495,6 +554,7 @@ void HtmlView::dump_selection(const char* event_name)
 void HtmlView::did_scroll()
 {
     main_frame().set_viewport_rect(visible_content_rect());
+    m_scrolled_since_last_paint = true;
 }
 
 Gfx::Point HtmlView::compute_mouse_event_offset(const Gfx::Point& event_position, const LayoutNode& layout_node) const
@@ -81,10 +81,18 @@ private:
     void run_javascript_url(const String& url);
     void layout_and_sync_size();
     void dump_selection(const char* event_name);
+    void render_into_viewport_bitmap(const Gfx::Rect& bitmap_rect, const Gfx::Point& scroll_position);
     Gfx::Point compute_mouse_event_offset(const Gfx::Point&, const LayoutNode&) const;
 
     RefPtr<Web::Frame> m_main_frame;
 
+    // Retained copy of the rendered viewport so scrolling can blit the
+    // still-visible part and re-render only the newly exposed strip.
+    RefPtr<Gfx::Bitmap> m_viewport_bitmap;
+    Gfx::Point m_viewport_scroll_position;
+    bool m_viewport_bitmap_valid { false };
+    bool m_scrolled_since_last_paint { false };
+
     bool m_should_show_line_box_borders { false };
     bool m_in_mouse_selection { false };
 };
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018-2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageDecoder.h>
+#include <LibWeb/ImageCache.h>
+
+namespace Web {
+
+// Decoded (not encoded) bytes across all entries before LRU eviction
+// starts throwing out entries nobody is displaying.
+static const size_t cache_byte_budget = 32 * 1024 * 1024;
+
+ImageCache& ImageCache::the()
+{
+    static ImageCache* s_the;
+    if (!s_the)
+        s_the = new ImageCache;
+    return *s_the;
+}
+
+ImageCacheEntry::ImageCacheEntry(ByteBuffer&& encoded_data)
+    : m_encoded_data(move(encoded_data))
+{
+    m_decoder = Gfx::ImageDecoder::create(m_encoded_data.data(), m_encoded_data.size());
+}
+
+ImageCacheEntry::~ImageCacheEntry()
+{
+}
+
+void ImageCacheEntry::mark_volatile()
+{
+    ASSERT(m_nonvolatile_count > 0);
+    if (--m_nonvolatile_count == 0 && m_decoder)
+        m_decoder->set_volatile();
+}
+
+void ImageCacheEntry::mark_nonvolatile()
+{
+    if (++m_nonvolatile_count != 1 || !m_decoder)
+        return;
+    bool has_image = m_decoder->set_nonvolatile();
+    if (has_image)
+        return;
+    // The kernel purged the decoded bitmap while we weren't looking at
+    // it; decode the retained data again.
+    m_decoder = Gfx::ImageDecoder::create(m_encoded_data.data(), m_encoded_data.size());
+}
+
+size_t ImageCacheEntry::decoded_byte_size() const
+{
+    if (!m_decoder)
+        return 0;
+    return static_cast<size_t>(m_decoder->width()) * m_decoder->height() * sizeof(Gfx::RGBA32);
+}
+
+RefPtr<ImageCacheEntry> ImageCache::get(const URL& url)
+{
+    auto it = m_entries.find(url.to_string());
+    if (it == m_entries.end())
+        return nullptr;
+    it->value->set_last_used(++m_use_counter);
+    return it->value;
+}
+
+NonnullRefPtr<ImageCacheEntry> ImageCache::add(const URL& url, ByteBuffer&& encoded_data)
+{
+    auto entry = adopt(*new ImageCacheEntry(move(encoded_data)));
+    entry->set_last_used(++m_use_counter);
+    m_entries.set(url.to_string(), entry);
+    evict_if_needed();
+    return entry;
+}
+
+void ImageCache::evict_if_needed()
+{
+    size_t total_size = 0;
+    for (auto& it : m_entries)
+        total_size += it.value->decoded_byte_size();
+
+    while (total_size > cache_byte_budget) {
+        // Throw out the least recently used entry that no element is
+        // still holding on to.
+        String victim_key;
+        unsigned victim_last_used = 0;
+        size_t victim_size = 0;
+        for (auto& it : m_entries) {
+            if (it.value->ref_count() > 1)
+                continue;
+            if (victim_key.is_null() || it.value->last_used() < victim_last_used) {
+                victim_key = it.key;
+                victim_last_used = it.value->last_used();
+                victim_size = it.value->decoded_byte_size();
+            }
+        }
+        if (victim_key.is_null())
+            break;
+        m_entries.remove(victim_key);
+        total_size -= victim_size;
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2018-2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/URL.h>
+#include <LibGfx/Forward.h>
+
+namespace Web {
+
+// One decoded image, shared by every HTMLImageElement showing the same
+// URL. The encoded data is kept around so the bitmap can be re-decoded
+// after the kernel purges its volatile storage.
+class ImageCacheEntry : public RefCounted<ImageCacheEntry> {
+public:
+    explicit ImageCacheEntry(ByteBuffer&& encoded_data);
+    ~ImageCacheEntry();
+
+    const ByteBuffer& encoded_data() const { return m_encoded_data; }
+    Gfx::ImageDecoder* decoder() { return m_decoder.ptr(); }
+    const Gfx::ImageDecoder* decoder() const { return m_decoder.ptr(); }
+
+    // Volatility is refcounted: the decoded bitmap only becomes purgeable
+    // once every user has marked the entry volatile.
+    void mark_volatile();
+    void mark_nonvolatile();
+
+    size_t decoded_byte_size() const;
+
+    unsigned last_used() const { return m_last_used; }
+    void set_last_used(unsigned value) { m_last_used = value; }
+
+private:
+    ByteBuffer m_encoded_data;
+    RefPtr<Gfx::ImageDecoder> m_decoder;
+    int m_nonvolatile_count { 0 };
+    unsigned m_last_used { 0 };
+};
+
+// Process-wide cache of decoded images, keyed by serialized URL, so
+// back/forward navigation and repeated references to one image reuse a
+// single download and decode. Entries nobody is displaying are evicted
+// least-recently-used once the decoded bytes exceed the budget.
+class ImageCache {
+public:
+    static ImageCache& the();
+
+    RefPtr<ImageCacheEntry> get(const URL&);
+    NonnullRefPtr<ImageCacheEntry> add(const URL&, ByteBuffer&& encoded_data);
+
+private:
+    ImageCache() {}
+
+    void evict_if_needed();
+
+    HashMap<String, NonnullRefPtr<ImageCacheEntry>> m_entries;
+    unsigned m_use_counter { 0 };
+};
+
+}
@@ -361,6 +361,9 @@ void LayoutBlock::render(RenderingContext& context)
     if (!is_visible())
         return;
 
+    if (has_absolute_subtree_rect() && !context.viewport_rect().intersects(enclosing_int_rect(absolute_subtree_rect())))
+        return;
+
     LayoutBox::render(context);
 
     if (children_are_inline()) {
@@ -379,6 +382,9 @@ HitTestResult LayoutBlock::hit_test(const Gfx::Point& position) const
     if (!children_are_inline())
         return LayoutBox::hit_test(position);
 
+    if (has_absolute_subtree_rect() && !absolute_subtree_rect().contains(position.x(), position.y()))
+        return {};
+
     HitTestResult result;
     for (auto& line_box : m_line_boxes) {
         for (auto& fragment : line_box.fragments()) {
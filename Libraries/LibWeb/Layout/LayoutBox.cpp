@@ -163,6 +163,9 @@ void LayoutBox::render(RenderingContext& context)
     if (!is_visible())
         return;
 
+    if (has_absolute_subtree_rect() && !context.viewport_rect().intersects(enclosing_int_rect(absolute_subtree_rect())))
+        return;
+
 #ifdef DRAW_BOXES_AROUND_LAYOUT_NODES
     context.painter().draw_rect(m_rect, Color::Blue);
 #endif
@@ -211,9 +214,12 @@ void LayoutBox::render(RenderingContext& context)
 
 HitTestResult LayoutBox::hit_test(const Gfx::Point& position) const
 {
-    // FIXME: It would be nice if we could confidently skip over hit testing
-    //        parts of the layout tree, but currently we can't just check
-    //        m_rect.contains() since inline text rects can't be trusted..
+    // NOTE: We can't prune on m_rect alone since inline text rects can't be
+    //       trusted, but the cached subtree bounds include every line box
+    //       fragment below us, so they are safe to skip on.
+    if (has_absolute_subtree_rect() && !absolute_subtree_rect().contains(position.x(), position.y()))
+        return {};
+
     HitTestResult result { m_rect.contains(position.x(), position.y()) ? this : nullptr };
     for_each_child([&](auto& child) {
         auto child_result = child.hit_test(position);
@@ -57,6 +57,10 @@ void LayoutDocument::layout()
             lowest_bottom = child_block.rect().bottom();
     });
     rect().set_bottom(lowest_bottom);
+
+    // Now that every box and line box fragment has its final rect, refresh
+    // the cached per-subtree bounds that hit testing and painting prune on.
+    update_absolute_subtree_rects();
 }
 
 void LayoutDocument::did_set_viewport_rect(Badge<Frame>, const Gfx::Rect& a_viewport_rect)
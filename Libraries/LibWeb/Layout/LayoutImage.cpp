@@ -76,8 +76,16 @@ void LayoutImage::render(RenderingContext& context)
         if (alt.is_empty())
             alt = node().src();
         context.painter().draw_text(enclosing_int_rect(rect()), alt, Gfx::TextAlignment::Center, style().color_or_fallback(CSS::PropertyID::Color, document(), Color::Black), Gfx::TextElision::Right);
-    } else if (node().bitmap())
-        context.painter().draw_scaled_bitmap(enclosing_int_rect(rect()), *node().bitmap(), node().bitmap()->rect());
+    } else if (node().bitmap()) {
+        auto image_rect = enclosing_int_rect(rect());
+        auto& bitmap = *node().bitmap();
+        // Box-sample when shrinking (pages love huge images in small boxes),
+        // bilinear when enlarging.
+        auto scaling_mode = (image_rect.width() < bitmap.width() && image_rect.height() < bitmap.height())
+            ? Gfx::Painter::ScalingMode::BoxSampling
+            : Gfx::Painter::ScalingMode::Bilinear;
+        context.painter().draw_scaled_bitmap(image_rect, bitmap, bitmap.rect(), scaling_mode);
+    }
     LayoutReplaced::render(context);
 }
 
@@ -53,6 +53,59 @@ void LayoutNode::layout()
     });
 }
 
+Gfx::FloatRect LayoutNode::update_absolute_subtree_rects()
+{
+    Gfx::FloatRect bounds;
+    bool have_bounds = false;
+    auto add = [&](const Gfx::FloatRect& rect) {
+        if (rect.is_empty())
+            return;
+        if (!have_bounds) {
+            bounds = rect;
+            have_bounds = true;
+            return;
+        }
+        bounds = bounds.united(rect);
+    };
+
+    if (is_box())
+        add(to<LayoutBox>(*this).rect());
+    if (is<LayoutBlock>(*this)) {
+        for (auto& line_box : to<LayoutBlock>(*this).line_boxes()) {
+            for (auto& fragment : line_box.fragments())
+                add(fragment.rect());
+        }
+    }
+    for_each_child([&](auto& child) {
+        add(child.update_absolute_subtree_rects());
+    });
+
+    m_absolute_subtree_rect = bounds;
+    m_has_absolute_subtree_rect = true;
+    return bounds;
+}
+
+void LayoutNode::set_needs_layout()
+{
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
+        if (ancestor->m_child_needs_layout)
+            break;
+        ancestor->m_child_needs_layout = true;
+    }
+}
+
+void LayoutNode::clear_needs_layout()
+{
+    m_needs_layout = false;
+    m_child_needs_layout = false;
+    for_each_child([](auto& child) {
+        child.clear_needs_layout();
+    });
+}
+
 const LayoutBlock* LayoutNode::containing_block() const
 {
     for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
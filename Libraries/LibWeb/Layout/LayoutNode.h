@@ -100,6 +100,26 @@ public:
     virtual void layout();
     virtual void render(RenderingContext&);
 
+    // Recomputes the cached absolute bounding rect of this node and
+    // everything below it (including line box fragments, which live in
+    // their containing block and can stick out of child rects.)
+    // Returns the bounds so parents can accumulate them on the way up.
+    Gfx::FloatRect update_absolute_subtree_rects();
+
+    // The cached bounds let hit_test() and render() skip entire subtrees
+    // that can't contain the position / intersect the viewport.
+    const Gfx::FloatRect& absolute_subtree_rect() const { return m_absolute_subtree_rect; }
+    bool has_absolute_subtree_rect() const { return m_has_absolute_subtree_rect; }
+
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+
+    // Marks this node as needing layout and flips the child-needs-layout bit
+    // on every ancestor, so Document::update_layout() can find dirty subtrees
+    // without re-laying-out the whole tree.
+    void set_needs_layout();
+    void clear_needs_layout();
+
     const LayoutBlock* containing_block() const;
 
     virtual LayoutNode& inline_wrapper() { return *this; }
@@ -151,10 +171,15 @@ private:
 
     const Node* m_node { nullptr };
 
+    Gfx::FloatRect m_absolute_subtree_rect;
+
     bool m_inline { false };
+    bool m_has_absolute_subtree_rect { false };
     bool m_has_style { false };
     bool m_visible { true };
     bool m_children_are_inline { false };
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
 };
 
 class LayoutNodeWithStyle : public LayoutNode {
@@ -30,6 +30,7 @@
 #include <LibGfx/Font.h>
 #include <LibGUI/Painter.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/FontCache.h>
 #include <LibWeb/Layout/LayoutBlock.h>
 #include <LibWeb/Layout/LayoutText.h>
 #include <ctype.h>
@@ -176,56 +177,54 @@ void LayoutText::split_into_lines(LayoutBlock& container)
         return;
     }
 
-    // Collapse whitespace into single spaces
-    auto utf8_view = Utf8View(node().data());
-    StringBuilder builder(node().data().length());
-    for (auto it = utf8_view.begin(); it != utf8_view.end(); ++it) {
-        if (!isspace(*it)) {
-            builder.append(utf8_view.as_string().characters_without_null_termination() + utf8_view.byte_offset_of(it), it.codepoint_length_in_bytes());
-        } else {
-            builder.append(' ');
-            auto prev = it;
-            while (it != utf8_view.end() && isspace(*it)) {
-                prev = it;
-                ++it;
+    if (m_words_source_text.impl() != node().data().impl() || m_words_font != &font) {
+        // Collapse whitespace into single spaces
+        auto utf8_view = Utf8View(node().data());
+        StringBuilder builder(node().data().length());
+        for (auto it = utf8_view.begin(); it != utf8_view.end(); ++it) {
+            if (!isspace(*it)) {
+                builder.append(utf8_view.as_string().characters_without_null_termination() + utf8_view.byte_offset_of(it), it.codepoint_length_in_bytes());
+            } else {
+                builder.append(' ');
+                auto prev = it;
+                while (it != utf8_view.end() && isspace(*it)) {
+                    prev = it;
+                    ++it;
+                }
+                it = prev;
             }
-            it = prev;
         }
+        m_words_source_text = node().data();
+        m_words_collapsed_text = builder.to_string();
+        m_words_font = &font;
+        m_text_for_rendering = m_words_collapsed_text;
+
+        m_words.clear();
+        for_each_word([&](const Utf8View& view, int start, int length) {
+            bool is_whitespace = isspace(*view.begin());
+            float word_width;
+            if (is_whitespace)
+                word_width = space_width;
+            else
+                word_width = FontCache::the().text_width(font, view.as_string()) + font.glyph_spacing();
+            m_words.append({ start, length, word_width, is_whitespace });
+        });
+    } else {
+        // The preformatted path may have clobbered m_text_for_rendering.
+        m_text_for_rendering = m_words_collapsed_text;
     }
-    m_text_for_rendering = builder.to_string();
-
-    struct Word {
-        Utf8View view;
-        int start;
-        int length;
-    };
-    Vector<Word> words;
-
-    for_each_word([&](const Utf8View& view, int start, int length) {
-        words.append({ Utf8View(view), start, length });
-    });
-
-    for (size_t i = 0; i < words.size(); ++i) {
-        auto& word = words[i];
-
-        float word_width;
-        bool is_whitespace = isspace(*word.view.begin());
-
-        if (is_whitespace)
-            word_width = space_width;
-        else
-            word_width = font.width(word.view) + font.glyph_spacing();
 
-        if (line_boxes.last().width() > 0 && word_width > available_width) {
+    for (auto& word : m_words) {
+        if (line_boxes.last().width() > 0 && word.width > available_width) {
             line_boxes.append(LineBox());
             available_width = container.width();
         }
 
-        if (is_whitespace && line_boxes.last().fragments().is_empty())
+        if (word.is_whitespace && line_boxes.last().fragments().is_empty())
             continue;
 
-        line_boxes.last().add_fragment(*this, word.start, is_whitespace ? 1 : word.length, word_width, font.glyph_height());
-        available_width -= word_width;
+        line_boxes.last().add_fragment(*this, word.start, word.is_whitespace ? 1 : word.length, word.width, font.glyph_height());
+        available_width -= word.width;
 
         if (available_width < 0) {
             line_boxes.append(LineBox());
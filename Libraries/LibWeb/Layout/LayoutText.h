@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <LibGfx/Forward.h>
 #include <LibWeb/DOM/Text.h>
 #include <LibWeb/Layout/LayoutNode.h>
 
@@ -59,6 +60,19 @@ private:
     void for_each_word(Callback) const;
 
     String m_text_for_rendering;
+
+    // Word segmentation (with measured widths) retained between layout
+    // passes; only recomputed when the text or the font changes.
+    struct Word {
+        int start { 0 };
+        int length { 0 };
+        float width { 0 };
+        bool is_whitespace { false };
+    };
+    Vector<Word> m_words;
+    String m_words_source_text;
+    String m_words_collapsed_text;
+    const Gfx::Font* m_words_font { nullptr };
 };
 
 template<>
@@ -61,15 +61,15 @@ static RefPtr<LayoutNode> create_layout_tree(Node& node, const StyleProperties*
         layout_children.append(layout_child.release_nonnull());
     });
 
-    for (auto& layout_child : layout_children) {
-        if (have_block_children && have_inline_children && layout_child.is_inline()) {
-            if (is<LayoutText>(layout_child) && to<LayoutText>(layout_child).text_for_style(*parent_style) == " ")
-                continue;
-            layout_node->inline_wrapper().append_child(layout_child);
+    layout_children.take_all([&](NonnullRefPtr<LayoutNode> layout_child) {
+        if (have_block_children && have_inline_children && layout_child->is_inline()) {
+            if (is<LayoutText>(*layout_child) && to<LayoutText>(*layout_child).text_for_style(*parent_style) == " ")
+                return;
+            layout_node->inline_wrapper().append_child(move(layout_child));
         } else {
-            layout_node->append_child(layout_child);
+            layout_node->append_child(move(layout_child));
         }
-    }
+    });
 
     if (have_inline_children && !have_block_children)
         layout_node->set_children_are_inline(true);
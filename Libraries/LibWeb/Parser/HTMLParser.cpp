@@ -25,18 +25,13 @@
  */
 
 #include <AK/Function.h>
-#include <AK/NonnullRefPtrVector.h>
-#include <AK/StringBuilder.h>
-#include <LibWeb/DOM/Comment.h>
 #include <LibWeb/DOM/DocumentFragment.h>
-#include <LibWeb/DOM/DocumentType.h>
-#include <LibWeb/DOM/Element.h>
-#include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/Event.h>
-#include <LibWeb/DOM/Text.h>
 #include <LibWeb/Parser/HTMLParser.h>
+#include <LibWeb/Parser/HTMLStreamingParser.h>
+#include <LibWeb/ResourceLoader.h>
 #include <ctype.h>
-#include <stdio.h>
+#include <string.h>
 
 namespace Web {
 
@@ -45,349 +40,90 @@ static bool is_valid_in_attribute_name(char ch)
     return isalnum(ch) || ch == '_' || ch == '-';
 }
 
-static bool is_void_element(const StringView& tag_name)
+// Best-effort lookahead scan: a missed URL only loses the head start, and
+// a wrongly guessed one is only ever adopted by a later load() on an
+// exact URL match, so there's no correctness riding on this.
+void prefetch_html_resources(const StringView& html, const URL& base_url)
 {
-    return tag_name == "area"
-        || tag_name == "base"
-        || tag_name == "br"
-        || tag_name == "col"
-        || tag_name == "embed"
-        || tag_name == "hr"
-        || tag_name == "img"
-        || tag_name == "input"
-        || tag_name == "link"
-        || tag_name == "meta"
-        || tag_name == "param"
-        || tag_name == "source"
-        || tag_name == "track"
-        || tag_name == "wbr";
-}
-
-static bool parse_html_document(const StringView& html, Document& document, ParentNode& root)
-{
-    NonnullRefPtrVector<ParentNode> node_stack;
-    node_stack.append(root);
-
-    enum class State {
-        Free = 0,
-        BeforeTagName,
-        InTagName,
-        InDoctype,
-        InComment,
-        InAttributeList,
-        InAttributeName,
-        BeforeAttributeValue,
-        InAttributeValueNoQuote,
-        InAttributeValueSingleQuote,
-        InAttributeValueDoubleQuote,
-    };
-
-    auto state = State::Free;
-
-    StringBuilder text_buffer;
-
-    Vector<char, 32> tag_name_buffer;
-
-    Vector<Attribute> attributes;
-    Vector<char, 256> attribute_name_buffer;
-    Vector<char, 256> attribute_value_buffer;
-
-    bool is_slash_tag = false;
-    bool is_exclamation_tag = false;
-
-    auto commit_text_node = [&] {
-        auto text_node = adopt(*new Text(document, text_buffer.to_string()));
-        node_stack.last().append_child(text_node);
-        text_buffer.clear();
-    };
-
-    auto move_to_state = [&](State new_state) {
-        if (new_state == State::BeforeTagName) {
-            is_slash_tag = false;
-            is_exclamation_tag = false;
-            tag_name_buffer.clear();
-            attributes.clear();
-        }
-        if (new_state == State::InAttributeName)
-            attribute_name_buffer.clear();
-        if (new_state == State::BeforeAttributeValue)
-            attribute_value_buffer.clear();
-        if (state == State::Free && !text_buffer.is_empty()) {
-            commit_text_node();
-        }
-        state = new_state;
-        text_buffer.clear();
-    };
-
-    auto close_tag = [&] {
-        if (node_stack.size() > 1)
-            node_stack.take_last();
-    };
-
-    auto open_tag = [&] {
-        auto new_element = create_element(document, String::copy(tag_name_buffer));
-        tag_name_buffer.clear();
-        new_element->set_attributes(move(attributes));
-        node_stack.append(new_element);
-        if (node_stack.size() != 1) {
-            node_stack[node_stack.size() - 2].append_child(new_element);
+    auto to_lower_matches = [](const StringView& haystack, size_t position, const char* needle) {
+        for (size_t i = 0; needle[i]; ++i) {
+            if (position + i >= haystack.length() || tolower(haystack[position + i]) != needle[i])
+                return false;
         }
-
-        if (is_void_element(new_element->tag_name()))
-            close_tag();
-    };
-
-    auto commit_doctype = [&] {
-        node_stack.last().append_child(adopt(*new DocumentType(document)));
-    };
-
-    auto commit_comment = [&] {
-        node_stack.last().append_child(adopt(*new Comment(document, text_buffer.to_string())));
-    };
-
-    auto commit_tag = [&] {
-        if (is_slash_tag)
-            close_tag();
-        else
-            open_tag();
+        return true;
     };
 
-    auto commit_attribute = [&] {
-        if (!attribute_name_buffer.is_empty()) {
-            auto name = String::copy(attribute_name_buffer);
-            String value;
-            if (attribute_value_buffer.is_empty())
-                value = String::empty();
-            else
-                value = String::copy(attribute_value_buffer);
-            attributes.empend(name, value);
+    auto extract_attribute_value = [&](const StringView& tag, const char* name) -> StringView {
+        size_t name_length = strlen(name);
+        for (size_t i = 0; i + name_length < tag.length(); ++i) {
+            if (!to_lower_matches(tag, i, name))
+                continue;
+            if (i > 0 && is_valid_in_attribute_name(tag[i - 1]))
+                continue;
+            size_t j = i + name_length;
+            while (j < tag.length() && isspace(tag[j]))
+                ++j;
+            if (j >= tag.length() || tag[j] != '=')
+                continue;
+            ++j;
+            while (j < tag.length() && isspace(tag[j]))
+                ++j;
+            if (j >= tag.length())
+                return {};
+            char quote = tag[j];
+            size_t start;
+            if (quote == '"' || quote == '\'') {
+                start = ++j;
+                while (j < tag.length() && tag[j] != quote)
+                    ++j;
+            } else {
+                start = j;
+                while (j < tag.length() && !isspace(tag[j]))
+                    ++j;
+            }
+            return tag.substring_view(start, j - start);
         }
+        return {};
     };
 
     for (size_t i = 0; i < html.length(); ++i) {
-        auto peek = [&](size_t offset) -> char {
-            if (i + offset >= html.length())
-                return '\0';
-            return html[i + offset];
-        };
-        char ch = html[i];
-        switch (state) {
-        case State::Free:
-            if (ch == '<') {
-                bool should_treat_as_text = false;
-                if (node_stack.last().tag_name() == "script") {
-                    bool is_script_close_tag = peek(1) == '/'
-                        && tolower(peek(2)) == 's'
-                        && tolower(peek(3)) == 'c'
-                        && tolower(peek(4)) == 'r'
-                        && tolower(peek(5)) == 'i'
-                        && tolower(peek(6)) == 'p'
-                        && tolower(peek(7)) == 't'
-                        && tolower(peek(8)) == '>';
-                    if (!is_script_close_tag)
-                        should_treat_as_text = true;
-                }
-                if (!should_treat_as_text) {
-                    is_slash_tag = false;
-                    move_to_state(State::BeforeTagName);
-                    break;
-                }
-            }
-
-            if (ch != '&') {
-                text_buffer.append(ch);
-            } else {
-                struct Escape {
-                    const char* code;
-                    const char* value;
-                };
-                static Escape escapes[] = {
-                    { "&lt;", "<" },
-                    { "&gt;", ">" },
-                    { "&amp;", "&" },
-                    { "&mdash;", "-" },
-                };
-                auto rest_of_html = html.substring_view(i, html.length() - i);
-                bool found = false;
-                for (auto& escape : escapes) {
-                    if (rest_of_html.starts_with(escape.code)) {
-                        text_buffer.append(escape.value);
-                        found = true;
-                        i += strlen(escape.code) - 1;
-                        break;
-                    }
-                }
-                if (!found)
-                    dbg() << "Unhandled escape sequence";
-            }
-            break;
-        case State::BeforeTagName:
-            if (ch == '/') {
-                is_slash_tag = true;
-                break;
-            }
-            if (ch == '!') {
-                if (toupper(peek(1)) == 'D'
-                    && toupper(peek(2)) == 'O'
-                    && toupper(peek(3)) == 'C'
-                    && toupper(peek(4)) == 'T'
-                    && toupper(peek(5)) == 'Y'
-                    && toupper(peek(6)) == 'P'
-                    && toupper(peek(7)) == 'E') {
-                    i += 7;
-                    move_to_state(State::InDoctype);
-                    break;
-                }
-                if (peek(1) == '-' && peek(2) == '-') {
-                    i += 2;
-                    move_to_state(State::InComment);
-                    break;
-                }
-                break;
-            }
-            if (ch == '>') {
-                move_to_state(State::Free);
-                break;
-            }
-            if (!isalpha(ch))
-                break;
-            move_to_state(State::InTagName);
-            [[fallthrough]];
-        case State::InTagName:
-            if (isspace(ch)) {
-                move_to_state(State::InAttributeList);
-                break;
-            }
-            if (ch == '/' && peek(1) == '>') {
-                open_tag();
-                close_tag();
-                i += 1;
-                move_to_state(State::Free);
-                break;
-            }
-            if (ch == '>') {
-                commit_tag();
-                move_to_state(State::Free);
-                break;
-            }
-            tag_name_buffer.append(ch);
-            break;
-        case State::InDoctype:
-            if (ch == '>') {
-                commit_doctype();
-                move_to_state(State::Free);
-                break;
-            }
+        if (html[i] != '<')
+            continue;
+        size_t tag_end = i + 1;
+        while (tag_end < html.length() && html[tag_end] != '>')
+            ++tag_end;
+        if (tag_end >= html.length())
             break;
-        case State::InComment:
-            if (ch == '-' && peek(1) == '-' && peek(2) == '>') {
-                commit_comment();
-                i += 2;
-                move_to_state(State::Free);
-                break;
-            }
-            text_buffer.append(ch);
-            break;
-        case State::InAttributeList:
-            if (ch == '>') {
-                commit_tag();
-                move_to_state(State::Free);
-                break;
-            }
-            if (!isalpha(ch))
-                break;
-            move_to_state(State::InAttributeName);
-            [[fallthrough]];
-        case State::InAttributeName:
-            if (is_valid_in_attribute_name(ch)) {
-                attribute_name_buffer.append(ch);
-                break;
-            }
-            if (isspace(ch)) {
-                commit_attribute();
-                break;
-            }
+        auto tag = html.substring_view(i + 1, tag_end - i - 1);
 
-            if (ch == '>') {
-                commit_attribute();
-                commit_tag();
-                move_to_state(State::Free);
-                break;
-            }
+        size_t tag_name_length = 0;
+        while (tag_name_length < tag.length() && isalpha(tag[tag_name_length]))
+            ++tag_name_length;
+        auto tag_name_is = [&](const char* name) {
+            return tag_name_length == strlen(name) && to_lower_matches(tag, 0, name);
+        };
 
-            if (ch == '=') {
-                move_to_state(State::BeforeAttributeValue);
-                break;
-            }
-            break;
-        case State::BeforeAttributeValue:
-            if (ch == '\'') {
-                move_to_state(State::InAttributeValueSingleQuote);
-                break;
-            }
-            if (ch == '"') {
-                move_to_state(State::InAttributeValueDoubleQuote);
-                break;
-            }
-            if (ch == '>') {
-                commit_tag();
-                move_to_state(State::Free);
-                break;
-            }
-            if (isspace(ch)) {
-                commit_attribute();
-                move_to_state(State::InAttributeList);
-                break;
-            }
-            move_to_state(State::InAttributeValueNoQuote);
-            [[fallthrough]];
-        case State::InAttributeValueNoQuote:
-            if (isspace(ch)) {
-                commit_attribute();
-                move_to_state(State::InAttributeList);
-                break;
-            }
-            if (ch == '>') {
-                commit_attribute();
-                commit_tag();
-                move_to_state(State::Free);
-                break;
-            }
-            attribute_value_buffer.append(ch);
-            break;
-        case State::InAttributeValueSingleQuote:
-            if (ch == '\'') {
-                commit_attribute();
-                move_to_state(State::InAttributeList);
-                break;
-            }
-            attribute_value_buffer.append(ch);
-            break;
-        case State::InAttributeValueDoubleQuote:
-            if (ch == '"') {
-                commit_attribute();
-                move_to_state(State::InAttributeList);
-                break;
-            }
-            attribute_value_buffer.append(ch);
-            break;
-        default:
-            fprintf(stderr, "Unhandled state %d\n", (int)state);
-            ASSERT_NOT_REACHED();
+        StringView url_value;
+        if (tag_name_is("img") || tag_name_is("script")) {
+            url_value = extract_attribute_value(tag, "src");
+        } else if (tag_name_is("link")) {
+            auto rel = extract_attribute_value(tag, "rel");
+            if (rel == "stylesheet" || rel == "icon")
+                url_value = extract_attribute_value(tag, "href");
         }
-    }
-
-    if (!text_buffer.is_empty())
-        commit_text_node();
+        if (!url_value.is_empty() && !url_value.starts_with("data:"))
+            ResourceLoader::the().prefetch(base_url.complete_url(String(url_value)));
 
-    return true;
+        i = tag_end;
+    }
 }
 
 RefPtr<DocumentFragment> parse_html_fragment(Document& document, const StringView& html)
 {
     auto fragment = adopt(*new DocumentFragment(document));
-    if (!parse_html_document(html, document, *fragment))
-        return nullptr;
+    HTMLStreamingParser parser(document, *fragment);
+    parser.write(html);
+    parser.finish();
     return fragment;
 }
 
@@ -396,22 +132,12 @@ RefPtr<Document> parse_html_document(const StringView& html, const URL& url)
     auto document = adopt(*new Document(url));
     document->set_source(html);
 
-    if (!parse_html_document(html, *document, *document))
-        return nullptr;
+    HTMLStreamingParser parser(*document, *document);
+    parser.write(html);
+    parser.finish();
 
     document->fixup();
 
-#if 0
-    Function<void(Node&)> fire_insertion_callbacks = [&](Node& node) {
-        for (auto* child = node.first_child(); child; child = child->next_sibling()) {
-            fire_insertion_callbacks(*child);
-        }
-        if (node.parent())
-            node.inserted_into(*node.parent());
-    };
-    fire_insertion_callbacks(document);
-#endif
-
     document->dispatch_event(Event::create("DOMContentLoaded"));
 
     return document;
@@ -36,4 +36,9 @@ class DocumentFragment;
 RefPtr<Document> parse_html_document(const StringView&, const URL& = URL());
 RefPtr<DocumentFragment> parse_html_fragment(Document&, const StringView&);
 
+// Scans raw HTML for subresource URLs (img/script src, stylesheet and
+// icon link href) and asks ResourceLoader to prefetch them, so their
+// downloads overlap with DOM construction.
+void prefetch_html_resources(const StringView&, const URL& base_url);
+
 }
@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) 2018-2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibWeb/DOM/Comment.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/DocumentType.h>
+#include <LibWeb/DOM/ElementFactory.h>
+#include <LibWeb/DOM/Text.h>
+#include <LibWeb/Parser/HTMLStreamingParser.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace Web {
+
+// The longest lookahead the state machine uses: "</script>" after a '<'
+// in State::Free. Bytes this close to the end of a chunk are held back
+// until the next write() (or finish()).
+static const size_t max_lookahead = 9;
+
+static bool is_valid_in_attribute_name(char ch)
+{
+    return isalnum(ch) || ch == '_' || ch == '-';
+}
+
+static bool is_void_element(const StringView& tag_name)
+{
+    return tag_name == "area"
+        || tag_name == "base"
+        || tag_name == "br"
+        || tag_name == "col"
+        || tag_name == "embed"
+        || tag_name == "hr"
+        || tag_name == "img"
+        || tag_name == "input"
+        || tag_name == "link"
+        || tag_name == "meta"
+        || tag_name == "param"
+        || tag_name == "source"
+        || tag_name == "track"
+        || tag_name == "wbr";
+}
+
+HTMLStreamingParser::HTMLStreamingParser(Document& document, ParentNode& root)
+    : m_document(document)
+{
+    m_node_stack.append(root);
+}
+
+HTMLStreamingParser::~HTMLStreamingParser()
+{
+}
+
+void HTMLStreamingParser::commit_text_node()
+{
+    auto text_node = adopt(*new Text(m_document, m_text_buffer.to_string()));
+    m_node_stack.last().append_child(move(text_node));
+    m_text_buffer.clear();
+}
+
+void HTMLStreamingParser::move_to_state(State new_state)
+{
+    if (new_state == State::BeforeTagName) {
+        m_is_slash_tag = false;
+        m_is_exclamation_tag = false;
+        m_tag_name_buffer.clear();
+        m_attributes.clear();
+    }
+    if (new_state == State::InAttributeName)
+        m_attribute_name_buffer.clear();
+    if (new_state == State::BeforeAttributeValue)
+        m_attribute_value_buffer.clear();
+    if (m_state == State::Free && !m_text_buffer.is_empty()) {
+        commit_text_node();
+    }
+    m_state = new_state;
+    m_text_buffer.clear();
+}
+
+void HTMLStreamingParser::close_tag()
+{
+    if (m_node_stack.size() > 1)
+        m_node_stack.take_last();
+}
+
+void HTMLStreamingParser::open_tag()
+{
+    auto new_element = create_element(m_document, String::copy(m_tag_name_buffer));
+    m_tag_name_buffer.clear();
+    new_element->set_attributes(move(m_attributes));
+    m_node_stack.append(new_element);
+    if (m_node_stack.size() != 1) {
+        m_node_stack[m_node_stack.size() - 2].append_child(new_element);
+    }
+
+    if (is_void_element(new_element->tag_name()))
+        close_tag();
+}
+
+void HTMLStreamingParser::commit_doctype()
+{
+    m_node_stack.last().append_child(adopt(*new DocumentType(m_document)));
+}
+
+void HTMLStreamingParser::commit_comment()
+{
+    m_node_stack.last().append_child(adopt(*new Comment(m_document, m_text_buffer.to_string())));
+}
+
+void HTMLStreamingParser::commit_tag()
+{
+    if (m_is_slash_tag)
+        close_tag();
+    else
+        open_tag();
+}
+
+void HTMLStreamingParser::commit_attribute()
+{
+    if (!m_attribute_name_buffer.is_empty()) {
+        auto name = String::copy(m_attribute_name_buffer);
+        String value;
+        if (m_attribute_value_buffer.is_empty())
+            value = String::empty();
+        else
+            value = String::copy(m_attribute_value_buffer);
+        m_attributes.empend(name, value);
+    }
+}
+
+void HTMLStreamingParser::write(const StringView& chunk)
+{
+    ASSERT(!m_finished);
+    if (m_unconsumed_input.is_empty()) {
+        process(chunk, false);
+        return;
+    }
+    Vector<char> input;
+    input.ensure_capacity(m_unconsumed_input.size() + chunk.length());
+    input.append(m_unconsumed_input.data(), m_unconsumed_input.size());
+    input.append(chunk.characters_without_null_termination(), chunk.length());
+    m_unconsumed_input.clear();
+    process(StringView(input.data(), input.size()), false);
+}
+
+void HTMLStreamingParser::finish()
+{
+    ASSERT(!m_finished);
+    m_finished = true;
+    if (!m_unconsumed_input.is_empty()) {
+        Vector<char> input = move(m_unconsumed_input);
+        process(StringView(input.data(), input.size()), true);
+    } else {
+        process({}, true);
+    }
+    if (!m_text_buffer.is_empty())
+        commit_text_node();
+}
+
+void HTMLStreamingParser::process(const StringView& html, bool is_final)
+{
+    // Unless this is the last chunk, stop short of the end so every
+    // peek() below sees real input; the tail is carried over to the
+    // next write().
+    size_t stop_at = html.length();
+    if (!is_final)
+        stop_at = html.length() > max_lookahead ? html.length() - max_lookahead : 0;
+
+    size_t i = 0;
+    for (; i < stop_at; ++i) {
+        auto peek = [&](size_t offset) -> char {
+            if (i + offset >= html.length())
+                return '\0';
+            return html[i + offset];
+        };
+        char ch = html[i];
+        switch (m_state) {
+        case State::Free:
+            if (ch == '<') {
+                bool should_treat_as_text = false;
+                if (m_node_stack.last().tag_name() == "script") {
+                    bool is_script_close_tag = peek(1) == '/'
+                        && tolower(peek(2)) == 's'
+                        && tolower(peek(3)) == 'c'
+                        && tolower(peek(4)) == 'r'
+                        && tolower(peek(5)) == 'i'
+                        && tolower(peek(6)) == 'p'
+                        && tolower(peek(7)) == 't'
+                        && tolower(peek(8)) == '>';
+                    if (!is_script_close_tag)
+                        should_treat_as_text = true;
+                }
+                if (!should_treat_as_text) {
+                    m_is_slash_tag = false;
+                    move_to_state(State::BeforeTagName);
+                    break;
+                }
+            }
+
+            if (ch != '&') {
+                m_text_buffer.append(ch);
+            } else {
+                struct Escape {
+                    const char* code;
+                    const char* value;
+                };
+                static Escape escapes[] = {
+                    { "&lt;", "<" },
+                    { "&gt;", ">" },
+                    { "&amp;", "&" },
+                    { "&mdash;", "-" },
+                };
+                auto rest_of_html = html.substring_view(i, html.length() - i);
+                bool found = false;
+                for (auto& escape : escapes) {
+                    if (rest_of_html.starts_with(escape.code)) {
+                        m_text_buffer.append(escape.value);
+                        found = true;
+                        i += strlen(escape.code) - 1;
+                        break;
+                    }
+                }
+                if (!found)
+                    dbg() << "Unhandled escape sequence";
+            }
+            break;
+        case State::BeforeTagName:
+            if (ch == '/') {
+                m_is_slash_tag = true;
+                break;
+            }
+            if (ch == '!') {
+                if (toupper(peek(1)) == 'D'
+                    && toupper(peek(2)) == 'O'
+                    && toupper(peek(3)) == 'C'
+                    && toupper(peek(4)) == 'T'
+                    && toupper(peek(5)) == 'Y'
+                    && toupper(peek(6)) == 'P'
+                    && toupper(peek(7)) == 'E') {
+                    i += 7;
+                    move_to_state(State::InDoctype);
+                    break;
+                }
+                if (peek(1) == '-' && peek(2) == '-') {
+                    i += 2;
+                    move_to_state(State::InComment);
+                    break;
+                }
+                break;
+            }
+            if (ch == '>') {
+                move_to_state(State::Free);
+                break;
+            }
+            if (!isalpha(ch))
+                break;
+            move_to_state(State::InTagName);
+            [[fallthrough]];
+        case State::InTagName:
+            if (isspace(ch)) {
+                move_to_state(State::InAttributeList);
+                break;
+            }
+            if (ch == '/' && peek(1) == '>') {
+                open_tag();
+                close_tag();
+                i += 1;
+                move_to_state(State::Free);
+                break;
+            }
+            if (ch == '>') {
+                commit_tag();
+                move_to_state(State::Free);
+                break;
+            }
+            m_tag_name_buffer.append(ch);
+            break;
+        case State::InDoctype:
+            if (ch == '>') {
+                commit_doctype();
+                move_to_state(State::Free);
+                break;
+            }
+            break;
+        case State::InComment:
+            if (ch == '-' && peek(1) == '-' && peek(2) == '>') {
+                commit_comment();
+                i += 2;
+                move_to_state(State::Free);
+                break;
+            }
+            m_text_buffer.append(ch);
+            break;
+        case State::InAttributeList:
+            if (ch == '>') {
+                commit_tag();
+                move_to_state(State::Free);
+                break;
+            }
+            if (!isalpha(ch))
+                break;
+            move_to_state(State::InAttributeName);
+            [[fallthrough]];
+        case State::InAttributeName:
+            if (is_valid_in_attribute_name(ch)) {
+                m_attribute_name_buffer.append(ch);
+                break;
+            }
+            if (isspace(ch)) {
+                commit_attribute();
+                break;
+            }
+
+            if (ch == '>') {
+                commit_attribute();
+                commit_tag();
+                move_to_state(State::Free);
+                break;
+            }
+
+            if (ch == '=') {
+                move_to_state(State::BeforeAttributeValue);
+                break;
+            }
+            break;
+        case State::BeforeAttributeValue:
+            if (ch == '\'') {
+                move_to_state(State::InAttributeValueSingleQuote);
+                break;
+            }
+            if (ch == '"') {
+                move_to_state(State::InAttributeValueDoubleQuote);
+                break;
+            }
+            if (ch == '>') {
+                commit_tag();
+                move_to_state(State::Free);
+                break;
+            }
+            if (isspace(ch)) {
+                commit_attribute();
+                move_to_state(State::InAttributeList);
+                break;
+            }
+            move_to_state(State::InAttributeValueNoQuote);
+            [[fallthrough]];
+        case State::InAttributeValueNoQuote:
+            if (isspace(ch)) {
+                commit_attribute();
+                move_to_state(State::InAttributeList);
+                break;
+            }
+            if (ch == '>') {
+                commit_attribute();
+                commit_tag();
+                move_to_state(State::Free);
+                break;
+            }
+            m_attribute_value_buffer.append(ch);
+            break;
+        case State::InAttributeValueSingleQuote:
+            if (ch == '\'') {
+                commit_attribute();
+                move_to_state(State::InAttributeList);
+                break;
+            }
+            m_attribute_value_buffer.append(ch);
+            break;
+        case State::InAttributeValueDoubleQuote:
+            if (ch == '"') {
+                commit_attribute();
+                move_to_state(State::InAttributeList);
+                break;
+            }
+            m_attribute_value_buffer.append(ch);
+            break;
+        default:
+            fprintf(stderr, "Unhandled state %d\n", (int)m_state);
+            ASSERT_NOT_REACHED();
+        }
+    }
+
+    if (i < html.length())
+        m_unconsumed_input.append(html.characters_without_null_termination() + i, html.length() - i);
+}
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018-2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibWeb/DOM/Element.h>
+
+namespace Web {
+
+class Document;
+class ParentNode;
+
+// A restartable HTML tokenizer. Input arrives in chunks via write();
+// the tokenizer suspends at chunk boundaries and carries over the few
+// bytes of unconsumed lookahead, so a caller can feed it data as the
+// network delivers it instead of buffering the whole document first.
+// Call finish() when there is no more input.
+class HTMLStreamingParser {
+public:
+    HTMLStreamingParser(Document&, ParentNode& root);
+    ~HTMLStreamingParser();
+
+    void write(const StringView&);
+    void finish();
+
+private:
+    enum class State {
+        Free = 0,
+        BeforeTagName,
+        InTagName,
+        InDoctype,
+        InComment,
+        InAttributeList,
+        InAttributeName,
+        BeforeAttributeValue,
+        InAttributeValueNoQuote,
+        InAttributeValueSingleQuote,
+        InAttributeValueDoubleQuote,
+    };
+
+    void process(const StringView&, bool is_final);
+    void move_to_state(State);
+    void commit_text_node();
+    void open_tag();
+    void close_tag();
+    void commit_tag();
+    void commit_doctype();
+    void commit_comment();
+    void commit_attribute();
+
+    Document& m_document;
+    NonnullRefPtrVector<ParentNode> m_node_stack;
+
+    State m_state { State::Free };
+    bool m_is_slash_tag { false };
+    bool m_is_exclamation_tag { false };
+
+    StringBuilder m_text_buffer;
+    Vector<char, 32> m_tag_name_buffer;
+    Vector<Attribute> m_attributes;
+    Vector<char, 256> m_attribute_name_buffer;
+    Vector<char, 256> m_attribute_value_buffer;
+
+    // Lookahead bytes held back at a chunk boundary, re-fed with the
+    // next chunk.
+    Vector<char> m_unconsumed_input;
+    bool m_finished { false };
+};
+
+}
@@ -66,7 +66,7 @@ void ResourceLoader::load_sync(const URL& url, Function<void(const ByteBuffer&)>
     loop.exec();
 }
 
-void ResourceLoader::load(const URL& url, Function<void(const ByteBuffer&)> success_callback, Function<void(const String&)> error_callback)
+void ResourceLoader::load(const URL& url, Function<void(const ByteBuffer&)> success_callback, Function<void(const String&)> error_callback, Function<void(const ByteBuffer&)> chunk_callback)
 {
     if (is_port_blocked(url.port())) {
         dbg() << "ResourceLoader::load: Error: blocked port " << url.port() << " for URL: " << url;
@@ -106,12 +106,44 @@ void ResourceLoader::load(const URL& url, Function<void(const ByteBuffer&)> succ
     }
 
     if (url.protocol() == "http" || url.protocol() == "https") {
+        // A speculative prefetch may already have this URL in flight (or
+        // finished); adopt it instead of downloading the same thing twice.
+        auto prefetch_it = m_prefetches.find(url.to_string());
+        if (prefetch_it != m_prefetches.end()) {
+            auto& prefetch = *prefetch_it->value;
+            if (prefetch.finished) {
+                bool success = prefetch.success;
+                auto payload = move(prefetch.payload);
+                m_prefetches.remove(prefetch_it);
+                deferred_invoke([success, payload = move(payload), success_callback = move(success_callback), error_callback = move(error_callback)](auto&) {
+                    if (!success) {
+                        if (error_callback)
+                            error_callback("HTTP load failed");
+                        return;
+                    }
+                    success_callback(payload);
+                });
+            } else {
+                prefetch.callbacks.append([success_callback = move(success_callback), error_callback = move(error_callback)](bool success, const ByteBuffer& payload) {
+                    if (!success) {
+                        if (error_callback)
+                            error_callback("HTTP load failed");
+                        return;
+                    }
+                    success_callback(payload);
+                });
+            }
+            return;
+        }
+
         auto download = protocol_client().start_download(url.to_string());
         if (!download) {
             if (error_callback)
                 error_callback("Failed to initiate load");
             return;
         }
+        if (chunk_callback)
+            download->on_chunk = move(chunk_callback);
         download->on_finish = [this, success_callback = move(success_callback), error_callback = move(error_callback)](bool success, const ByteBuffer& payload, auto) {
             --m_pending_loads;
             if (on_load_counter_change)
@@ -133,6 +165,46 @@ void ResourceLoader::load(const URL& url, Function<void(const ByteBuffer&)> succ
         error_callback(String::format("Protocol not implemented: %s", url.protocol().characters()));
 }
 
+void ResourceLoader::prefetch(const URL& url)
+{
+    if (url.protocol() != "http" && url.protocol() != "https")
+        return;
+    if (is_port_blocked(url.port()))
+        return;
+
+    auto key = url.to_string();
+    if (m_prefetches.contains(key))
+        return;
+
+    auto download = protocol_client().start_download(key);
+    if (!download)
+        return;
+    download->on_finish = [this, key](bool success, const ByteBuffer& payload, auto) {
+        --m_pending_loads;
+        if (on_load_counter_change)
+            on_load_counter_change();
+        auto it = m_prefetches.find(key);
+        if (it == m_prefetches.end())
+            return;
+        auto& prefetch = *it->value;
+        prefetch.finished = true;
+        prefetch.success = success;
+        prefetch.payload = ByteBuffer::copy(payload.data(), payload.size());
+        if (prefetch.callbacks.is_empty())
+            return;
+        // Someone load()ed this URL while it was still in flight.
+        auto callbacks = move(prefetch.callbacks);
+        auto adopted_payload = move(prefetch.payload);
+        m_prefetches.remove(it);
+        for (auto& callback : callbacks)
+            callback(success, adopted_payload);
+    };
+    ++m_pending_loads;
+    if (on_load_counter_change)
+        on_load_counter_change();
+    m_prefetches.set(key, make<PendingPrefetch>());
+}
+
 bool ResourceLoader::is_port_blocked(int port)
 {
     int ports[] { 1, 7, 9, 11, 13, 15, 17, 19, 20, 21, 22, 23, 25, 37, 42,
@@ -27,6 +27,8 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/URL.h>
 #include <LibCore/Object.h>
 
@@ -41,9 +43,18 @@ class ResourceLoader : public Core::Object {
 public:
     static ResourceLoader& the();
 
-    void load(const URL&, Function<void(const ByteBuffer&)> success_callback, Function<void(const String&)> error_callback = nullptr);
+    // chunk_callback (if provided) fires for each piece of the body as it
+    // arrives, for protocols the server delivers incrementally (http/https).
+    // data:, file: and adopted prefetches deliver everything via
+    // success_callback, which always receives the complete payload.
+    void load(const URL&, Function<void(const ByteBuffer&)> success_callback, Function<void(const String&)> error_callback = nullptr, Function<void(const ByteBuffer&)> chunk_callback = nullptr);
     void load_sync(const URL&, Function<void(const ByteBuffer&)> success_callback, Function<void(const String&)> error_callback = nullptr);
 
+    // Starts a speculative download for a URL the parser is likely to ask
+    // for soon. A later load() of the same URL adopts the in-flight (or
+    // already finished) download instead of starting a second one.
+    void prefetch(const URL&);
+
     Function<void()> on_load_counter_change;
 
     int pending_loads() const { return m_pending_loads; }
@@ -53,6 +64,14 @@ private:
 
     int m_pending_loads { 0 };
 
+    struct PendingPrefetch {
+        bool finished { false };
+        bool success { false };
+        ByteBuffer payload;
+        Vector<Function<void(bool, const ByteBuffer&)>> callbacks;
+    };
+    HashMap<String, NonnullOwnPtr<PendingPrefetch>> m_prefetches;
+
     Protocol::Client& protocol_client() { return *m_protocol_client; }
     RefPtr<Protocol::Client> m_protocol_client;
     bool is_port_blocked(int port);
@@ -28,6 +28,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
 #include <AK/Weakable.h>
 
 namespace Web {
@@ -82,23 +83,14 @@ public:
     const T* first_child() const { return m_first_child; }
     const T* last_child() const { return m_last_child; }
 
-    int child_count() const
-    {
-        int count = 0;
-        for (auto* child = first_child(); child; child = child->next_sibling())
-            ++count;
-        return count;
-    }
+    int child_count() const { return m_child_count; }
 
     T* child_at_index(int index)
     {
-        int count = 0;
-        for (auto* child = first_child(); child; child = child->next_sibling()) {
-            if (count == index)
-                return child;
-            ++count;
-        }
-        return nullptr;
+        if (index < 0 || index >= m_child_count)
+            return nullptr;
+        ensure_indexed_children();
+        return m_indexed_children[index];
     }
 
     const T* child_at_index(int index) const
@@ -192,11 +184,28 @@ protected:
 
 private:
     int m_ref_count { 1 };
+    // Child access by index is common enough (models, nth-child style
+    // walks) that we keep a lazily built array of child pointers; any
+    // mutation just flips the dirty bit.
+    void ensure_indexed_children() const
+    {
+        if (!m_indexed_children_dirty)
+            return;
+        m_indexed_children.clear_with_capacity();
+        m_indexed_children.ensure_capacity(m_child_count);
+        for (auto* child = m_first_child; child; child = child->m_next_sibling)
+            m_indexed_children.unchecked_append(child);
+        m_indexed_children_dirty = false;
+    }
+
     T* m_parent { nullptr };
     T* m_first_child { nullptr };
     T* m_last_child { nullptr };
     T* m_next_sibling { nullptr };
     T* m_previous_sibling { nullptr };
+    int m_child_count { 0 };
+    mutable Vector<T*> m_indexed_children;
+    mutable bool m_indexed_children_dirty { true };
 };
 
 template<typename T>
@@ -220,6 +229,9 @@ inline NonnullRefPtr<T> TreeNode<T>::remove_child(NonnullRefPtr<T> node)
     node->m_previous_sibling = nullptr;
     node->m_parent = nullptr;
 
+    --m_child_count;
+    m_indexed_children_dirty = true;
+
     node->removed_from(static_cast<T&>(*this));
 
     node->unref();
@@ -244,6 +256,8 @@ inline void TreeNode<T>::append_child(NonnullRefPtr<T> node)
     m_last_child = node.ptr();
     if (!m_first_child)
         m_first_child = m_last_child;
+    ++m_child_count;
+    m_indexed_children_dirty = true;
     node->inserted_into(static_cast<T&>(*this));
     (void)node.leak_ref();
 
@@ -265,6 +279,8 @@ inline void TreeNode<T>::prepend_child(NonnullRefPtr<T> node)
     m_first_child = node.ptr();
     if (!m_last_child)
         m_last_child = m_first_child;
+    ++m_child_count;
+    m_indexed_children_dirty = true;
     node->inserted_into(static_cast<T&>(*this));
     (void)node.leak_ref();
 
@@ -287,6 +303,8 @@ inline void TreeNode<T>::donate_all_children_to(T& node)
 
     m_first_child = nullptr;
     m_last_child = nullptr;
+    m_child_count = 0;
+    m_indexed_children_dirty = true;
 }
 
 template<typename T>
@@ -148,16 +148,20 @@ struct InstructionDescriptor {
     bool has_rm { false };
     unsigned imm1_bytes { 0 };
     unsigned imm2_bytes { 0 };
-    InstructionDescriptor* slashes { nullptr };
+    // MultibyteWithSlash descriptors refer to their /0../7 sub-table by
+    // index into OpcodeTables::slash_groups (a pointer would dangle when
+    // the constexpr builder result is copied into the static tables.)
+    bool has_slash_group { false };
+    unsigned slash_group_index { 0 };
 
-    unsigned imm1_bytes_for_address_size(bool a32)
+    unsigned imm1_bytes_for_address_size(bool a32) const
     {
         if (imm1_bytes == CurrentAddressSize)
             return a32 ? 4 : 2;
         return imm1_bytes;
     }
 
-    unsigned imm2_bytes_for_address_size(bool a32)
+    unsigned imm2_bytes_for_address_size(bool a32) const
     {
         if (imm2_bytes == CurrentAddressSize)
             return a32 ? 4 : 2;
@@ -167,12 +171,21 @@ struct InstructionDescriptor {
     IsLockPrefixAllowed lock_prefix_allowed { LockPrefixNotAllowed };
 };
 
-static InstructionDescriptor s_table16[256];
-static InstructionDescriptor s_table32[256];
-static InstructionDescriptor s_0F_table16[256];
-static InstructionDescriptor s_0F_table32[256];
+// All four decode tables plus the /slash sub-tables, built once at compile
+// time so instruction decoding never pays for (or checks for) runtime
+// table initialization.
+struct OpcodeTables {
+    InstructionDescriptor table16[256];
+    InstructionDescriptor table32[256];
+    InstructionDescriptor table0F_16[256];
+    InstructionDescriptor table0F_32[256];
+    // Sub-tables for MultibyteWithSlash opcodes, indexed by
+    // InstructionDescriptor::slash_group_index, then by /0../7.
+    InstructionDescriptor slash_groups[40][8];
+    unsigned slash_group_count { 0 };
+};
 
-static bool opcode_has_register_index(u8 op)
+static constexpr bool opcode_has_register_index(u8 op)
 {
     if (op >= 0x40 && op <= 0x5F)
         return true;
@@ -183,7 +196,28 @@ static bool opcode_has_register_index(u8 op)
     return false;
 }
 
-static void build(InstructionDescriptor* table, u8 op, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed)
+// Builds the tables; helper names and the opcode list below are unchanged
+// from the old runtime initialization, they just run in a constexpr context
+// now (see make_opcode_tables().)
+struct TableBuilder {
+    OpcodeTables tables;
+
+    constexpr void build(InstructionDescriptor* table, u8 op, const char* mnemonic, InstructionFormat, IsLockPrefixAllowed);
+    constexpr void buildSlash(InstructionDescriptor* table, u8 op, u8 slash, const char* mnemonic, InstructionFormat, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build(u8 op, const char* mnemonic, InstructionFormat, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build(u8 op, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build(u8 op, const char* mnemonic16, InstructionFormat format16, const char* mnemonic32, InstructionFormat format32, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build0F(u8 op, const char* mnemonic, InstructionFormat, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build0F(u8 op, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build0F(u8 op, const char* mnemonic16, InstructionFormat format16, const char* mnemonic32, InstructionFormat format32, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void buildSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void buildSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build0FSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build0FSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed = LockPrefixNotAllowed);
+    constexpr void build_all();
+};
+
+constexpr void TableBuilder::build(InstructionDescriptor* table, u8 op, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed)
 {
     InstructionDescriptor& d = table[op];
 
@@ -316,83 +350,81 @@ static void build(InstructionDescriptor* table, u8 op, const char* mnemonic, Ins
     }
 }
 
-static void buildSlash(InstructionDescriptor* table, u8 op, u8 slash, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::buildSlash(InstructionDescriptor* table, u8 op, u8 slash, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed)
 {
     InstructionDescriptor& d = table[op];
     d.format = MultibyteWithSlash;
     d.has_rm = true;
-    if (!d.slashes)
-        d.slashes = new InstructionDescriptor[8];
+    if (!d.has_slash_group) {
+        d.has_slash_group = true;
+        d.slash_group_index = tables.slash_group_count++;
+    }
 
-    build(d.slashes, slash, mnemonic, format, lock_prefix_allowed);
+    build(tables.slash_groups[d.slash_group_index], slash, mnemonic, format, lock_prefix_allowed);
 }
 
-static void build0F(u8 op, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build0F(u8 op, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    build(s_0F_table16, op, mnemonic, format, lock_prefix_allowed);
-    build(s_0F_table32, op, mnemonic, format, lock_prefix_allowed);
+    build(tables.table0F_16, op, mnemonic, format, lock_prefix_allowed);
+    build(tables.table0F_32, op, mnemonic, format, lock_prefix_allowed);
 }
 
-static void build(u8 op, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build(u8 op, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    build(s_table16, op, mnemonic, format, lock_prefix_allowed);
-    build(s_table32, op, mnemonic, format, lock_prefix_allowed);
+    build(tables.table16, op, mnemonic, format, lock_prefix_allowed);
+    build(tables.table32, op, mnemonic, format, lock_prefix_allowed);
 }
 
-static void build(u8 op, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build(u8 op, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    build(s_table16, op, mnemonic, format16, lock_prefix_allowed);
-    build(s_table32, op, mnemonic, format32, lock_prefix_allowed);
+    build(tables.table16, op, mnemonic, format16, lock_prefix_allowed);
+    build(tables.table32, op, mnemonic, format32, lock_prefix_allowed);
 }
 
-static void build0F(u8 op, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build0F(u8 op, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    build(s_0F_table16, op, mnemonic, format16, lock_prefix_allowed);
-    build(s_0F_table32, op, mnemonic, format32, lock_prefix_allowed);
+    build(tables.table0F_16, op, mnemonic, format16, lock_prefix_allowed);
+    build(tables.table0F_32, op, mnemonic, format32, lock_prefix_allowed);
 }
 
-static void build(u8 op, const char* mnemonic16, InstructionFormat format16, const char* mnemonic32, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build(u8 op, const char* mnemonic16, InstructionFormat format16, const char* mnemonic32, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    build(s_table16, op, mnemonic16, format16, lock_prefix_allowed);
-    build(s_table32, op, mnemonic32, format32, lock_prefix_allowed);
+    build(tables.table16, op, mnemonic16, format16, lock_prefix_allowed);
+    build(tables.table32, op, mnemonic32, format32, lock_prefix_allowed);
 }
 
-static void build0F(u8 op, const char* mnemonic16, InstructionFormat format16, const char* mnemonic32, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build0F(u8 op, const char* mnemonic16, InstructionFormat format16, const char* mnemonic32, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    build(s_0F_table16, op, mnemonic16, format16, lock_prefix_allowed);
-    build(s_0F_table32, op, mnemonic32, format32, lock_prefix_allowed);
+    build(tables.table0F_16, op, mnemonic16, format16, lock_prefix_allowed);
+    build(tables.table0F_32, op, mnemonic32, format32, lock_prefix_allowed);
 }
 
-static void buildSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::buildSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    buildSlash(s_table16, op, slash, mnemonic, format, lock_prefix_allowed);
-    buildSlash(s_table32, op, slash, mnemonic, format, lock_prefix_allowed);
+    buildSlash(tables.table16, op, slash, mnemonic, format, lock_prefix_allowed);
+    buildSlash(tables.table32, op, slash, mnemonic, format, lock_prefix_allowed);
 }
 
-static void buildSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::buildSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    buildSlash(s_table16, op, slash, mnemonic, format16, lock_prefix_allowed);
-    buildSlash(s_table32, op, slash, mnemonic, format32, lock_prefix_allowed);
+    buildSlash(tables.table16, op, slash, mnemonic, format16, lock_prefix_allowed);
+    buildSlash(tables.table32, op, slash, mnemonic, format32, lock_prefix_allowed);
 }
 
-static void build0FSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build0FSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionFormat format32, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    buildSlash(s_0F_table16, op, slash, mnemonic, format16, lock_prefix_allowed);
-    buildSlash(s_0F_table32, op, slash, mnemonic, format32, lock_prefix_allowed);
+    buildSlash(tables.table0F_16, op, slash, mnemonic, format16, lock_prefix_allowed);
+    buildSlash(tables.table0F_32, op, slash, mnemonic, format32, lock_prefix_allowed);
 }
 
-static void build0FSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+constexpr void TableBuilder::build0FSlash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, IsLockPrefixAllowed lock_prefix_allowed)
 {
-    buildSlash(s_0F_table16, op, slash, mnemonic, format, lock_prefix_allowed);
-    buildSlash(s_0F_table32, op, slash, mnemonic, format, lock_prefix_allowed);
+    buildSlash(tables.table0F_16, op, slash, mnemonic, format, lock_prefix_allowed);
+    buildSlash(tables.table0F_32, op, slash, mnemonic, format, lock_prefix_allowed);
 }
 
-void build_opcode_tables_if_needed()
+constexpr void TableBuilder::build_all()
 {
-    static bool has_built_tables = false;
-    if (has_built_tables)
-        return;
-
     build(0x00, "ADD", OP_RM8_reg8, LockPrefixAllowed);
     build(0x01, "ADD", OP_RM16_reg16, OP_RM32_reg32, LockPrefixAllowed);
     build(0x02, "ADD", OP_reg8_RM8, LockPrefixAllowed);
@@ -838,13 +870,47 @@ void build_opcode_tables_if_needed()
     build0F(0xFD, "PADDW", OP_mm1_mm2m64);
     build0F(0xFE, "PADDD", OP_mm1_mm2m64);
     build0F(0xFF, "UD0", OP);
+}
 
-    has_built_tables = true;
+static constexpr OpcodeTables make_opcode_tables()
+{
+    TableBuilder builder;
+    builder.build_all();
+    return builder.tables;
 }
 
+static constexpr OpcodeTables s_opcode_tables = make_opcode_tables();
+static constexpr const InstructionDescriptor* s_table16 = s_opcode_tables.table16;
+static constexpr const InstructionDescriptor* s_table32 = s_opcode_tables.table32;
+static constexpr const InstructionDescriptor* s_0F_table16 = s_opcode_tables.table0F_16;
+static constexpr const InstructionDescriptor* s_0F_table32 = s_opcode_tables.table0F_32;
+
+// One entry per byte value: is it an instruction prefix byte?
+struct PrefixFlags {
+    bool is_prefix[256] {};
+};
+
+static constexpr PrefixFlags make_prefix_flags()
+{
+    PrefixFlags flags;
+    flags.is_prefix[Prefix::OperandSizeOverride] = true;
+    flags.is_prefix[Prefix::AddressSizeOverride] = true;
+    flags.is_prefix[Prefix::REPZ] = true;
+    flags.is_prefix[Prefix::REPNZ] = true;
+    flags.is_prefix[Prefix::LOCK] = true;
+    flags.is_prefix[0x26] = true; // ES
+    flags.is_prefix[0x2e] = true; // CS
+    flags.is_prefix[0x36] = true; // SS
+    flags.is_prefix[0x3e] = true; // DS
+    flags.is_prefix[0x64] = true; // FS
+    flags.is_prefix[0x65] = true; // GS
+    return flags;
+}
+
+static constexpr PrefixFlags s_prefix_flags = make_prefix_flags();
+
 Instruction Instruction::from_stream(InstructionStream& stream, bool o32, bool a32)
 {
-    build_opcode_tables_if_needed();
     return Instruction(stream, o32, a32);
 }
 
@@ -889,34 +955,28 @@ Instruction::Instruction(InstructionStream& stream, bool o32, bool a32)
     : m_a32(a32)
     , m_o32(o32)
 {
-    for (;; ++m_prefix_bytes) {
-        u8 opbyte = stream.read8();
+    // Fast path: the vast majority of instructions start with the opcode
+    // itself, so rule out all eleven prefix bytes with one table load
+    // instead of comparing against each in turn.
+    u8 opbyte = stream.read8();
+    while (s_prefix_flags.is_prefix[opbyte]) {
         if (opbyte == Prefix::OperandSizeOverride) {
             m_o32 = !o32;
             m_has_operand_size_override_prefix = true;
-            continue;
-        }
-        if (opbyte == Prefix::AddressSizeOverride) {
+        } else if (opbyte == Prefix::AddressSizeOverride) {
             m_a32 = !a32;
             m_has_address_size_override_prefix = true;
-            continue;
-        }
-        if (opbyte == Prefix::REPZ || opbyte == Prefix::REPNZ) {
+        } else if (opbyte == Prefix::REPZ || opbyte == Prefix::REPNZ) {
             m_rep_prefix = opbyte;
-            continue;
-        }
-        if (opbyte == Prefix::LOCK) {
+        } else if (opbyte == Prefix::LOCK) {
             m_has_lock_prefix = true;
-            continue;
-        }
-        auto segment_prefix = to_segment_prefix(opbyte);
-        if (segment_prefix != SegmentRegister::None) {
-            m_segment_prefix = segment_prefix;
-            continue;
+        } else {
+            m_segment_prefix = to_segment_prefix(opbyte);
         }
-        m_op = opbyte;
-        break;
+        ++m_prefix_bytes;
+        opbyte = stream.read8();
     }
+    m_op = opbyte;
 
     if (m_op == 0x0F) {
         m_has_sub_op = true;
@@ -941,7 +1001,7 @@ Instruction::Instruction(InstructionStream& stream, bool o32, bool a32)
     bool hasSlash = m_descriptor->format == MultibyteWithSlash;
 
     if (hasSlash) {
-        m_descriptor = &m_descriptor->slashes[slash()];
+        m_descriptor = &s_opcode_tables.slash_groups[m_descriptor->slash_group_index][slash()];
     }
 
     if (!m_descriptor->mnemonic) {
@@ -352,7 +352,7 @@ private:
 
     MemoryOrRegisterReference m_modrm;
 
-    InstructionDescriptor* m_descriptor { nullptr };
+    const InstructionDescriptor* m_descriptor { nullptr };
 };
 
 }
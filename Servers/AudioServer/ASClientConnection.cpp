@@ -149,6 +149,14 @@ OwnPtr<Messages::AudioServer::GetPlayingBufferResponse> ASClientConnection::hand
     return make<Messages::AudioServer::GetPlayingBufferResponse>(id);
 }
 
+OwnPtr<Messages::AudioServer::GetEnqueuedBuffersResponse> ASClientConnection::handle(const Messages::AudioServer::GetEnqueuedBuffers&)
+{
+    int count = 0;
+    if (m_queue)
+        count = m_queue->enqueued_buffer_count();
+    return make<Messages::AudioServer::GetEnqueuedBuffersResponse>(count);
+}
+
 OwnPtr<Messages::AudioServer::GetMutedResponse> ASClientConnection::handle(const Messages::AudioServer::GetMuted&)
 {
     return make<Messages::AudioServer::GetMutedResponse>(m_mixer.is_muted());
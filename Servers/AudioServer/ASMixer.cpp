@@ -24,7 +24,6 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <AK/BufferStream.h>
 #include <AK/NumericLimits.h>
 #include <AudioServer/ASClientConnection.h>
 #include <AudioServer/ASMixer.h>
@@ -90,13 +89,7 @@ void ASMixer::mix()
                 continue;
             }
 
-            for (int i = 0; i < mixed_buffer_length; ++i) {
-                auto& mixed_sample = mixed_buffer[i];
-                Audio::Sample sample;
-                if (!queue->get_next_sample(sample))
-                    break;
-                mixed_sample += sample;
-            }
+            queue->mix_in(mixed_buffer, mixed_buffer_length);
         }
 
         bool muted = m_muted;
@@ -105,27 +98,19 @@ void ASMixer::mix()
         u8 raw_buffer[4096];
         auto buffer = ByteBuffer::wrap(muted ? m_zero_filled_buffer : raw_buffer, sizeof(raw_buffer));
 
-        BufferStream stream(buffer);
         if (!muted) {
+            auto* out_samples = (i16*)raw_buffer;
             for (int i = 0; i < mixed_buffer_length; ++i) {
                 auto& mixed_sample = mixed_buffer[i];
 
                 mixed_sample.scale(m_main_volume);
                 mixed_sample.clip();
 
-                i16 out_sample;
-                out_sample = mixed_sample.left * NumericLimits<i16>::max();
-                stream << out_sample;
-
-                ASSERT(!stream.at_end()); // we should have enough space for both channels in one buffer!
-                out_sample = mixed_sample.right * NumericLimits<i16>::max();
-                stream << out_sample;
+                out_samples[i * 2] = mixed_sample.left * NumericLimits<i16>::max();
+                out_samples[i * 2 + 1] = mixed_sample.right * NumericLimits<i16>::max();
             }
         }
 
-        if (stream.offset() != 0) {
-            buffer.trim(stream.offset());
-        }
         m_device->write(buffer);
     }
 }
@@ -147,6 +132,13 @@ ASBufferQueue::ASBufferQueue(ASClientConnection& client)
 
 void ASBufferQueue::enqueue(NonnullRefPtr<Audio::Buffer>&& buffer)
 {
+    auto head = m_head.load(AK::memory_order_acquire);
+    auto tail = m_tail.load(AK::memory_order_relaxed);
+    if (tail - head >= QueueCapacity) {
+        // The client is supposed to check is_full() before enqueueing.
+        return;
+    }
     m_remaining_samples += buffer->sample_count();
-    m_queue.enqueue(move(buffer));
+    m_queue[tail % QueueCapacity] = move(buffer);
+    m_tail.store(tail + 1, AK::memory_order_release);
 }
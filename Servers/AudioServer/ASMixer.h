@@ -27,10 +27,10 @@
 #pragma once
 
 #include "ASClientConnection.h"
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
 #include <AK/NonnullRefPtrVector.h>
-#include <AK/Queue.h>
 #include <AK/RefCounted.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Buffer.h>
@@ -45,37 +45,58 @@ public:
     explicit ASBufferQueue(ASClientConnection&);
     ~ASBufferQueue() {}
 
-    bool is_full() const { return m_queue.size() >= 3; }
+    bool is_full() const { return enqueued_buffer_count() >= 3; }
     void enqueue(NonnullRefPtr<Audio::Buffer>&&);
 
-    bool get_next_sample(Audio::Sample& sample)
+    // How many buffers are queued up but not yet being played.
+    int enqueued_buffer_count() const
     {
-        if (m_paused)
-            return false;
-
-        while (!m_current && !m_queue.is_empty())
-            m_current = m_queue.dequeue();
-
-        if (!m_current)
-            return false;
-
-        sample = m_current->samples()[m_position++];
-        --m_remaining_samples;
-        ++m_played_samples;
+        return (int)(m_tail.load(AK::memory_order_relaxed) - m_head.load(AK::memory_order_relaxed));
+    }
 
-        if (m_position >= m_current->sample_count()) {
-            m_client->did_finish_playing_buffer({}, m_current->shbuf_id());
-            m_current = nullptr;
-            m_position = 0;
+    // Mixes up to `count' samples into `mix_buffer'. Runs on the mixer
+    // thread; does whole-buffer runs instead of a dequeue check per sample.
+    void mix_in(Audio::Sample* mix_buffer, int count)
+    {
+        if (m_paused)
+            return;
+
+        int mixed = 0;
+        while (mixed < count) {
+            if (!m_current) {
+                auto head = m_head.load(AK::memory_order_relaxed);
+                if (head == m_tail.load(AK::memory_order_acquire))
+                    return;
+                m_current = move(m_queue[head % QueueCapacity]);
+                m_head.store(head + 1, AK::memory_order_release);
+                m_position = 0;
+            }
+
+            int run = min(count - mixed, m_current->sample_count() - m_position);
+            const auto* samples = m_current->samples();
+            for (int i = 0; i < run; ++i)
+                mix_buffer[mixed + i] += samples[m_position + i];
+            m_position += run;
+            mixed += run;
+            m_remaining_samples -= run;
+            m_played_samples += run;
+
+            if (m_position >= m_current->sample_count()) {
+                m_client->did_finish_playing_buffer({}, m_current->shbuf_id());
+                m_current = nullptr;
+                m_position = 0;
+            }
         }
-        return true;
     }
 
     ASClientConnection* client() { return m_client.ptr(); }
 
     void clear(bool paused = false)
     {
-        m_queue.clear();
+        // Note: the parked buffer refs stay in their ring slots until the
+        // producer reuses them; nulling them out here would race the mixer
+        // thread if it is dequeueing concurrently.
+        m_head.store(m_tail.load(AK::memory_order_relaxed), AK::memory_order_release);
         m_position = 0;
         m_remaining_samples = 0;
         m_played_samples = 0;
@@ -98,8 +119,14 @@ public:
     }
 
 private:
+    // Single-producer (IPC thread) / single-consumer (mixer thread) ring of
+    // queued buffers; the atomic indices make the handoff safe without the
+    // mixing thread ever taking a lock.
+    static constexpr size_t QueueCapacity = 8;
     RefPtr<Audio::Buffer> m_current;
-    Queue<NonnullRefPtr<Audio::Buffer>> m_queue;
+    RefPtr<Audio::Buffer> m_queue[QueueCapacity];
+    AK::Atomic<u32> m_head { 0 };
+    AK::Atomic<u32> m_tail { 0 };
     int m_position { 0 };
     int m_remaining_samples { 0 };
     int m_played_samples { 0 };
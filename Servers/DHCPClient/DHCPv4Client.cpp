@@ -30,6 +30,7 @@
 #include <LibCore/SocketAddress.h>
 #include <LibCore/Timer.h>
 #include <stdio.h>
+#include <time.h>
 
 //#define DHCPV4CLIENT_DEBUG
 
@@ -104,6 +105,7 @@ static void set_params(const InterfaceDescriptor& iface, const IPv4Address& ipv4
 DHCPv4Client::DHCPv4Client(Vector<InterfaceDescriptor> ifnames)
     : m_ifnames(ifnames)
 {
+    m_leases = Core::ConfigFile::open("/etc/DHCPClient.leases");
     m_server = Core::UDPServer::construct(this);
     m_server->on_ready_to_receive = [this] {
         auto buffer = m_server->receive(sizeof(DHCPv4Packet));
@@ -121,8 +123,47 @@ DHCPv4Client::DHCPv4Client(Vector<InterfaceDescriptor> ifnames)
         ASSERT_NOT_REACHED();
     }
 
-    for (auto& iface : m_ifnames)
-        dhcp_discover(iface);
+    for (auto& iface : m_ifnames) {
+        // If we still have an unexpired lease from last boot, try to get the
+        // server to confirm it instead of going through full discovery.
+        auto cached_address = cached_lease_for(iface);
+        if (cached_address.has_value())
+            dhcp_init_reboot(iface, cached_address.value());
+        else
+            dhcp_discover(iface);
+    }
+}
+
+Optional<IPv4Address> DHCPv4Client::cached_lease_for(const InterfaceDescriptor& iface) const
+{
+    auto group = iface.m_mac_address.to_string();
+    if (!m_leases->has_group(group))
+        return {};
+    // Leave some headroom; a lease that's about to expire isn't worth asking for.
+    time_t expires = m_leases->read_num_entry(group, "Expires", 0);
+    if (expires <= time(nullptr) + 10)
+        return {};
+    return IPv4Address::from_string(m_leases->read_entry(group, "IPv4Address"));
+}
+
+void DHCPv4Client::save_lease(const InterfaceDescriptor& iface, const IPv4Address& ip, const IPv4Address& netmask, const IPv4Address& gateway, u32 lease_time)
+{
+    auto group = iface.m_mac_address.to_string();
+    m_leases->write_entry(group, "IPv4Address", ip.to_string());
+    m_leases->write_entry(group, "Netmask", netmask.to_string());
+    m_leases->write_entry(group, "Gateway", gateway.to_string());
+    m_leases->write_num_entry(group, "Expires", time(nullptr) + lease_time);
+    if (!m_leases->sync())
+        dbg() << "Failed to write the lease file, leases won't survive a reboot";
+}
+
+void DHCPv4Client::forget_lease(const InterfaceDescriptor& iface)
+{
+    auto group = iface.m_mac_address.to_string();
+    if (!m_leases->has_group(group))
+        return;
+    m_leases->remove_group(group);
+    m_leases->sync();
 }
 
 DHCPv4Client::~DHCPv4Client()
@@ -173,7 +214,19 @@ void DHCPv4Client::handle_ack(const DHCPv4Packet& packet, const ParsedDHCPv4Opti
             dhcp_discover(interface, new_ip);
         },
         this);
-    set_params(transaction->interface, new_ip, options.get<IPv4Address>(DHCPOption::SubnetMask).value(), options.get_many<IPv4Address>(DHCPOption::Router, 1).first());
+    // An ACK to an INIT-REBOOT request doesn't have to carry these options,
+    // so fall back to what we remembered about the lease.
+    auto lease_group = interface.m_mac_address.to_string();
+    auto netmask_option = options.get<IPv4Address>(DHCPOption::SubnetMask);
+    auto netmask = netmask_option.has_value()
+        ? netmask_option.value()
+        : IPv4Address::from_string(m_leases->read_entry(lease_group, "Netmask")).value_or({});
+    auto routers = options.get_many<IPv4Address>(DHCPOption::Router, 1);
+    auto gateway = !routers.is_empty()
+        ? routers.first()
+        : IPv4Address::from_string(m_leases->read_entry(lease_group, "Gateway")).value_or({});
+    save_lease(interface, new_ip, netmask, gateway, lease_time);
+    set_params(transaction->interface, new_ip, netmask, gateway);
 }
 
 void DHCPv4Client::handle_nak(const DHCPv4Packet& packet, const ParsedDHCPv4Options& options)
@@ -189,6 +242,14 @@ void DHCPv4Client::handle_nak(const DHCPv4Packet& packet, const ParsedDHCPv4Opti
     transaction->accepted_offer = false;
     transaction->has_ip = false;
     auto& iface = transaction->interface;
+    if (transaction->is_init_reboot) {
+        // Our cached lease is no good anymore; forget it and go through full
+        // discovery right away.
+        transaction->is_init_reboot = false;
+        forget_lease(iface);
+        dhcp_discover(iface);
+        return;
+    }
     Core::Timer::create_single_shot(
         10000,
         [this, iface = InterfaceDescriptor { iface }] {
@@ -281,3 +342,45 @@ void DHCPv4Client::dhcp_request(DHCPv4Transaction& transaction, const DHCPv4Pack
     send(iface, dhcp_packet, this);
     transaction.accepted_offer = true;
 }
+
+void DHCPv4Client::dhcp_init_reboot(const InterfaceDescriptor& iface, const IPv4Address& previous)
+{
+    auto transaction_id = rand();
+    dbg() << "Asking the server to confirm our cached lease of " << previous.to_string() << " for adapter " << iface.m_ifname;
+    DHCPv4PacketBuilder builder;
+
+    DHCPv4Packet& packet = builder.peek();
+    packet.set_op(DHCPv4Op::BootRequest);
+    packet.set_htype(1); // 10mb ethernet
+    packet.set_hlen(sizeof(MACAddress));
+    packet.set_xid(transaction_id);
+    packet.set_flags(DHCPv4Flags::Broadcast);
+    // INIT-REBOOT: ciaddr stays zero, the address we want goes in the
+    // requested-IP option (RFC 2131, section 3.2).
+    packet.set_chaddr(iface.m_mac_address);
+    packet.set_secs(65535); // we lie
+
+    // set packet options
+    builder.set_message_type(DHCPMessageType::DHCPRequest);
+    builder.add_option(DHCPOption::RequestedIPAddress, sizeof(IPv4Address), &previous);
+    auto& dhcp_packet = builder.build();
+
+    // broadcast the "am I still good?" request
+    send(iface, dhcp_packet, this);
+    auto transaction = make<DHCPv4Transaction>(iface);
+    transaction->accepted_offer = true;
+    transaction->is_init_reboot = true;
+    auto* transaction_ptr = transaction.ptr();
+    m_ongoing_transactions.set(transaction_id, move(transaction));
+
+    // If nobody answers in a little while, fall back to full discovery.
+    Core::Timer::create_single_shot(
+        3000,
+        [this, transaction_ptr, iface = InterfaceDescriptor { iface }] {
+            if (transaction_ptr->has_ip)
+                return;
+            dbg() << "No answer to our INIT-REBOOT request on " << iface.m_ifname << ", doing full discovery";
+            dhcp_discover(iface);
+        },
+        this);
+}
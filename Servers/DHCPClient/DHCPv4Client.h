@@ -29,8 +29,10 @@
 #include "DHCPv4.h"
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
+#include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/Vector.h>
+#include <LibCore/ConfigFile.h>
 #include <LibCore/UDPServer.h>
 #include <LibCore/UDPSocket.h>
 #include <net/if.h>
@@ -52,6 +54,7 @@ struct DHCPv4Transaction {
     InterfaceDescriptor interface;
     bool accepted_offer { false };
     bool has_ip { false };
+    bool is_init_reboot { false };
     u32 offered_lease_time { 0 };
 };
 
@@ -64,6 +67,7 @@ public:
 
     void dhcp_discover(const InterfaceDescriptor& ifname, IPv4Address previous = IPv4Address { 0, 0, 0, 0 });
     void dhcp_request(DHCPv4Transaction& transaction, const DHCPv4Packet& packet);
+    void dhcp_init_reboot(const InterfaceDescriptor& ifname, const IPv4Address& previous);
 
     void process_incoming(const DHCPv4Packet& packet);
 
@@ -73,8 +77,13 @@ private:
     HashMap<u32, OwnPtr<DHCPv4Transaction>> m_ongoing_transactions;
     Vector<InterfaceDescriptor> m_ifnames;
     RefPtr<Core::UDPServer> m_server;
+    RefPtr<Core::ConfigFile> m_leases;
 
     void handle_offer(const DHCPv4Packet&, const ParsedDHCPv4Options&);
     void handle_ack(const DHCPv4Packet&, const ParsedDHCPv4Options&);
     void handle_nak(const DHCPv4Packet&, const ParsedDHCPv4Options&);
+
+    Optional<IPv4Address> cached_lease_for(const InterfaceDescriptor&) const;
+    void save_lease(const InterfaceDescriptor&, const IPv4Address& ip, const IPv4Address& netmask, const IPv4Address& gateway, u32 lease_time);
+    void forget_lease(const InterfaceDescriptor&);
 };
@@ -56,7 +56,7 @@ int main(int argc, char** argv)
     (void)argc;
     (void)argv;
 
-    if (pledge("stdio unix inet cpath rpath fattr", nullptr) < 0) {
+    if (pledge("stdio unix inet cpath rpath wpath fattr", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -68,6 +68,18 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // The lease file (and ConfigFile's compiled cache of it) is how leases
+    // survive a reboot.
+    if (unveil("/etc/DHCPClient.leases", "rwc") < 0) {
+        perror("unveil");
+        return 1;
+    }
+
+    if (unveil("/etc/DHCPClient.leases.cache", "rwc") < 0) {
+        perror("unveil");
+        return 1;
+    }
+
     unveil(nullptr, nullptr);
 
     auto file = Core::File::construct("/proc/net/adapters");
@@ -92,7 +104,7 @@ int main(int argc, char** argv)
 
     auto client = DHCPv4Client::construct(move(ifnames));
 
-    if (pledge("stdio inet", nullptr) < 0) {
+    if (pledge("stdio inet cpath rpath wpath", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
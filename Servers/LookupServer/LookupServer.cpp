@@ -35,10 +35,20 @@
 #include <LibCore/File.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/LocalSocket.h>
+#include <LibCore/Timer.h>
 #include <LibCore/UDPSocket.h>
 #include <stdio.h>
+#include <time.h>
 #include <unistd.h>
 
+// How long a "no such host" result stays in the cache.
+static const time_t negative_cache_ttl = 60;
+
+// If a cache entry with at least this many hits is served while its answers
+// are about to expire, we refresh it in the background.
+static const u32 prefetch_hit_threshold = 3;
+static const time_t prefetch_expiry_window = 10;
+
 LookupServer::LookupServer()
 {
     auto config = Core::ConfigFile::get_for_system("LookupServer");
@@ -96,6 +106,29 @@ void LookupServer::load_etc_hosts()
     }
 }
 
+String LookupServer::lookup_key(const String& hostname, u16 record_type)
+{
+    return String::format("%s/%u", hostname.characters(), record_type);
+}
+
+void LookupServer::respond(Core::LocalSocket& socket, const Vector<String>& responses)
+{
+    if (responses.is_empty()) {
+        int nsent = socket.write("Not found.\n");
+        if (nsent < 0)
+            perror("write");
+        return;
+    }
+    for (auto& response : responses) {
+        auto line = String::format("%s\n", response.characters());
+        int nsent = socket.write(line);
+        if (nsent < 0) {
+            perror("write");
+            break;
+        }
+    }
+}
+
 void LookupServer::service_client(RefPtr<Core::LocalSocket> socket)
 {
     u8 client_buffer[1024];
@@ -115,113 +148,158 @@ void LookupServer::service_client(RefPtr<Core::LocalSocket> socket)
     auto hostname = String((const char*)client_buffer + 1, nrecv - 1, Chomp);
     dbg() << "Got request for '" << hostname << "' (using IP " << m_nameserver << ")";
 
-    Vector<String> responses;
-
     if (auto known_host = m_etc_hosts.get(hostname); known_host.has_value()) {
+        Vector<String> responses;
         responses.append(known_host.value());
-    } else if (!hostname.is_empty()) {
-        bool did_timeout;
-        int retries = 3;
-        do {
-            did_timeout = false;
-            if (lookup_type == 'L')
-                responses = lookup(hostname, did_timeout, T_A);
-            else if (lookup_type == 'R')
-                responses = lookup(hostname, did_timeout, T_PTR);
-            if (!did_timeout)
-                break;
-        } while (--retries);
-        if (did_timeout) {
-            fprintf(stderr, "LookupServer: Out of retries :(\n");
-            return;
-        }
+        respond(*socket, responses);
+        return;
     }
 
-    if (responses.is_empty()) {
-        int nsent = socket->write("Not found.\n");
-        if (nsent < 0)
-            perror("write");
+    if (hostname.is_empty()) {
+        respond(*socket, {});
         return;
     }
-    for (auto& response : responses) {
-        auto line = String::format("%s\n", response.characters());
-        int nsent = socket->write(line);
-        if (nsent < 0) {
-            perror("write");
-            break;
-        }
-    }
-}
 
-Vector<String> LookupServer::lookup(const String& hostname, bool& did_timeout, unsigned short record_type, ShouldRandomizeCase should_randomize_case)
-{
-    if (auto it = m_lookup_cache.find(hostname); it != m_lookup_cache.end()) {
+    u16 record_type = lookup_type == 'L' ? T_A : T_PTR;
+    auto key = lookup_key(hostname, record_type);
+
+    if (auto it = m_lookup_cache.find(key); it != m_lookup_cache.end()) {
         auto& cached_lookup = it->value;
-        if (cached_lookup.question.record_type() == record_type) {
+        auto now = time(nullptr);
+        if (cached_lookup.answers.is_empty()) {
+            // Negative entry.
+            if (now < cached_lookup.negative_expiration_time) {
+                dbg() << "Negative cache hit: " << hostname;
+                respond(*socket, {});
+                return;
+            }
+        } else {
             Vector<String> responses;
+            time_t soonest_expiration = 0;
             for (auto& cached_answer : cached_lookup.answers) {
                 dbg() << "Cache hit: " << hostname << " -> " << cached_answer.record_data() << ", expired: " << cached_answer.has_expired();
                 if (!cached_answer.has_expired()) {
                     responses.append(cached_answer.record_data());
+                    if (!soonest_expiration || cached_answer.expiration_time() < soonest_expiration)
+                        soonest_expiration = cached_answer.expiration_time();
                 }
             }
-            if (!responses.is_empty())
-                return responses;
+            if (!responses.is_empty()) {
+                ++cached_lookup.hits;
+                respond(*socket, responses);
+                // Hot name about to expire? Refresh it in the background so
+                // the next request stays a cache hit.
+                if (cached_lookup.hits >= prefetch_hit_threshold && soonest_expiration - now < prefetch_expiry_window)
+                    start_lookup(hostname, record_type, nullptr);
+                return;
+            }
         }
         m_lookup_cache.remove(it);
     }
 
-    DNSRequest request;
-    request.add_question(hostname, record_type, should_randomize_case);
+    start_lookup(hostname, record_type, move(socket));
+}
 
-    auto buffer = request.to_byte_buffer();
+void LookupServer::start_lookup(const String& hostname, u16 record_type, RefPtr<Core::LocalSocket> client)
+{
+    auto key = lookup_key(hostname, record_type);
+
+    if (auto it = m_pending_lookups.find(key); it != m_pending_lookups.end()) {
+        // There's already an upstream query in flight for this name; just
+        // wait for its answer instead of asking again.
+        if (client)
+            it->value->waiting_clients.append(move(client));
+        return;
+    }
 
-    auto udp_socket = Core::UDPSocket::construct();
-    udp_socket->set_blocking(true);
+    auto lookup = make<PendingLookup>();
+    lookup->hostname = hostname;
+    lookup->record_type = record_type;
+    if (client)
+        lookup->waiting_clients.append(move(client));
 
-    struct timeval timeout {
-        1, 0
-    };
+    auto& lookup_ref = *lookup;
+    m_pending_lookups.set(key, move(lookup));
+    send_upstream_query(lookup_ref);
+}
 
-    int rc = setsockopt(udp_socket->fd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-    if (rc < 0) {
-        perror("setsockopt(SOL_SOCKET, SO_RCVTIMEO)");
-        return {};
-    }
+void LookupServer::send_upstream_query(PendingLookup& lookup)
+{
+    auto key = lookup_key(lookup.hostname, lookup.record_type);
 
-    if (!udp_socket->connect(m_nameserver, 53))
-        return {};
+    lookup.request = DNSRequest();
+    lookup.request.add_question(lookup.hostname, lookup.record_type, lookup.should_randomize_case);
+    auto buffer = lookup.request.to_byte_buffer();
 
-    if (!udp_socket->write(buffer))
-        return {};
+    lookup.upstream_socket = Core::UDPSocket::construct(this);
+    if (!lookup.upstream_socket->connect(m_nameserver, 53)) {
+        finish_lookup(lookup, {});
+        return;
+    }
+    lookup.upstream_socket->on_ready_to_read = [this, key] {
+        if (auto it = m_pending_lookups.find(key); it != m_pending_lookups.end()) {
+            // Keep the socket (and this very callback) alive until we're done,
+            // since a finished lookup destroys both.
+            RefPtr<Core::UDPSocket> keeper = it->value->upstream_socket;
+            handle_upstream_response(*it->value);
+        }
+    };
+    if (!lookup.upstream_socket->write(buffer)) {
+        finish_lookup(lookup, {});
+        return;
+    }
+
+    lookup.timeout_timer = Core::Timer::create_single_shot(1000, [this, key] {
+        auto it = m_pending_lookups.find(key);
+        if (it == m_pending_lookups.end())
+            return;
+        auto& lookup = *it->value;
+        RefPtr<Core::Timer> keeper = lookup.timeout_timer;
+        if (--lookup.retries_left > 0) {
+            send_upstream_query(lookup);
+            return;
+        }
+        fprintf(stderr, "LookupServer: Out of retries :(\n");
+        finish_lookup(lookup, {});
+    },
+        this);
+    lookup.timeout_timer->start();
+}
 
+void LookupServer::handle_upstream_response(PendingLookup& lookup)
+{
     u8 response_buffer[4096];
-    int nrecv = udp_socket->read(response_buffer, sizeof(response_buffer));
+    int nrecv = lookup.upstream_socket->read(response_buffer, sizeof(response_buffer));
     if (nrecv == 0)
-        return {};
+        return;
 
     auto o_response = DNSResponse::from_raw_response(response_buffer, nrecv);
     if (!o_response.has_value())
-        return {};
+        return;
 
     auto& response = o_response.value();
+    auto& request = lookup.request;
 
     if (response.id() != request.id()) {
         dbgprintf("LookupServer: ID mismatch (%u vs %u) :(\n", response.id(), request.id());
-        return {};
+        return;
     }
 
     if (response.code() == DNSResponse::Code::REFUSED) {
-        if (should_randomize_case == ShouldRandomizeCase::Yes) {
+        if (lookup.should_randomize_case == ShouldRandomizeCase::Yes) {
             // Retry with 0x20 case randomization turned off.
-            return lookup(hostname, did_timeout, record_type, ShouldRandomizeCase::No);
+            lookup.should_randomize_case = ShouldRandomizeCase::No;
+            send_upstream_query(lookup);
+            return;
         }
-        return {};
+        finish_lookup(lookup, {});
+        return;
     }
 
     if (response.question_count() != request.question_count()) {
         dbgprintf("LookupServer: Question count (%u vs %u) :(\n", response.question_count(), request.question_count());
-        return {};
+        finish_lookup(lookup, {});
+        return;
     }
 
     for (size_t i = 0; i < request.question_count(); ++i) {
@@ -231,27 +309,43 @@ Vector<String> LookupServer::lookup(const String& hostname, bool& did_timeout, u
             dbg() << "Request and response questions do not match";
             dbg() << "   Request: {_" << request_question.name() << "_, " << request_question.record_type() << ", " << request_question.class_code() << "}";
             dbg() << "  Response: {_" << response_question.name() << "_, " << response_question.record_type() << ", " << response_question.class_code() << "}";
-            return {};
+            finish_lookup(lookup, {});
+            return;
         }
     }
 
-    if (response.answer_count() < 1) {
-        dbgprintf("LookupServer: Not enough answers (%u) :(\n", response.answer_count());
-        return {};
+    if (m_lookup_cache.size() >= 256)
+        m_lookup_cache.remove(m_lookup_cache.begin());
+
+    auto key = lookup_key(lookup.hostname, lookup.record_type);
+
+    if (response.code() == DNSResponse::Code::NXDOMAIN || response.answer_count() < 1) {
+        dbgprintf("LookupServer: No answers for %s, caching negatively\n", lookup.hostname.characters());
+        m_lookup_cache.set(key, { request.questions()[0], {}, time(nullptr) + negative_cache_ttl, 0 });
+        finish_lookup(lookup, {});
+        return;
     }
 
-    Vector<String, 8> responses;
-    Vector<DNSAnswer, 8> cacheable_answers;
+    Vector<String> responses;
+    Vector<DNSAnswer> cacheable_answers;
     for (auto& answer : response.answers()) {
         responses.append(answer.record_data());
         if (!answer.has_expired())
             cacheable_answers.append(answer);
     }
 
-    if (!cacheable_answers.is_empty()) {
-        if (m_lookup_cache.size() >= 256)
-            m_lookup_cache.remove(m_lookup_cache.begin());
-        m_lookup_cache.set(hostname, { request.questions()[0], move(cacheable_answers) });
-    }
-    return responses;
+    if (!cacheable_answers.is_empty())
+        m_lookup_cache.set(key, { request.questions()[0], move(cacheable_answers), 0, 0 });
+
+    finish_lookup(lookup, responses);
+}
+
+void LookupServer::finish_lookup(PendingLookup& lookup, const Vector<String>& responses)
+{
+    if (lookup.timeout_timer)
+        lookup.timeout_timer->stop();
+    for (auto& client : lookup.waiting_clients)
+        respond(*client, responses);
+    // NOTE: This destroys `lookup'.
+    m_pending_lookups.remove(lookup_key(lookup.hostname, lookup.record_type));
 }
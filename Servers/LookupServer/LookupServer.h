@@ -29,10 +29,16 @@
 #include "DNSRequest.h"
 #include "DNSResponse.h"
 #include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
 #include <LibCore/Object.h>
 
 class DNSAnswer;
 
+namespace Core {
+class Timer;
+class UDPSocket;
+}
+
 class LookupServer final : public Core::Object {
     C_OBJECT(LookupServer)
 
@@ -40,17 +46,41 @@ public:
     LookupServer();
 
 private:
-    void load_etc_hosts();
-    void service_client(RefPtr<Core::LocalSocket>);
-    Vector<String> lookup(const String& hostname, bool& did_timeout, unsigned short record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
+    // An upstream query in flight. All clients asking for the same name
+    // while it's pending get coalesced onto the one query; a lookup with no
+    // waiting clients is a background prefetch.
+    struct PendingLookup {
+        String hostname;
+        u16 record_type { 0 };
+        ShouldRandomizeCase should_randomize_case { ShouldRandomizeCase::Yes };
+        DNSRequest request;
+        RefPtr<Core::UDPSocket> upstream_socket;
+        RefPtr<Core::Timer> timeout_timer;
+        int retries_left { 3 };
+        Vector<RefPtr<Core::LocalSocket>> waiting_clients;
+    };
 
     struct CachedLookup {
         DNSQuestion question;
+        // No answers means this is a negative entry ("Not found", cached
+        // until negative_expiration_time).
         Vector<DNSAnswer> answers;
+        time_t negative_expiration_time { 0 };
+        u32 hits { 0 };
     };
 
+    void load_etc_hosts();
+    void service_client(RefPtr<Core::LocalSocket>);
+    void start_lookup(const String& hostname, u16 record_type, RefPtr<Core::LocalSocket> client);
+    void send_upstream_query(PendingLookup&);
+    void handle_upstream_response(PendingLookup&);
+    void finish_lookup(PendingLookup&, const Vector<String>& responses);
+    static void respond(Core::LocalSocket&, const Vector<String>& responses);
+    static String lookup_key(const String& hostname, u16 record_type);
+
     RefPtr<Core::LocalServer> m_local_server;
     String m_nameserver;
     HashMap<String, String> m_etc_hosts;
     HashMap<String, CachedLookup> m_lookup_cache;
+    HashMap<String, NonnullOwnPtr<PendingLookup>> m_pending_lookups;
 };
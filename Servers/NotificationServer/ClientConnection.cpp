@@ -55,8 +55,7 @@ OwnPtr<Messages::NotificationServer::GreetResponse> ClientConnection::handle(con
 
 OwnPtr<Messages::NotificationServer::ShowNotificationResponse> ClientConnection::handle(const Messages::NotificationServer::ShowNotification& message)
 {
-    auto window = NotificationWindow::construct(message.text(), message.title(), message.icon());
-    window->show();
+    NotificationWindow::show_notification(message.text(), message.title(), message.icon());
     return make<Messages::NotificationServer::ShowNotificationResponse>();
 }
 
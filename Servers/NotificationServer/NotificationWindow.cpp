@@ -39,6 +39,26 @@ namespace NotificationServer {
 
 static Vector<RefPtr<NotificationWindow>> s_windows;
 
+// Closed windows are kept around for reuse: rebuilding the whole widget tree
+// (and re-registering a window with the WindowServer) per notification is
+// most of the cost of showing one.
+static Vector<RefPtr<NotificationWindow>> s_window_pool;
+static const size_t max_pooled_windows = 4;
+
+// Notifications beyond this many visible windows are queued (or merged into
+// the queue) and shown as older ones are dismissed, so a burst of
+// notifications costs us proportionally to what's on screen, not to what
+// was sent.
+static const size_t max_visible_notifications = 6;
+
+struct PendingNotification {
+    String text;
+    String title;
+    Gfx::ShareableBitmap icon;
+};
+static Vector<PendingNotification> s_pending_notifications;
+static const size_t max_pending_notifications = 32;
+
 void update_notification_window_locations()
 {
     Gfx::Rect last_window_rect;
@@ -56,32 +76,12 @@ void update_notification_window_locations()
     }
 }
 
-NotificationWindow::NotificationWindow(const String& text, const String& title, const Gfx::ShareableBitmap& icon)
+NotificationWindow::NotificationWindow()
 {
-    s_windows.append(this);
-
     set_window_type(GUI::WindowType::Notification);
     set_resizable(false);
     set_minimizable(false);
 
-    Gfx::Rect lowest_notification_rect_on_screen;
-    for (auto& window : s_windows) {
-        if (window->m_original_rect.y() > lowest_notification_rect_on_screen.y())
-            lowest_notification_rect_on_screen = window->m_original_rect;
-    }
-
-    Gfx::Rect rect;
-    rect.set_width(220);
-    rect.set_height(40);
-    rect.set_location(GUI::Desktop::the().rect().top_right().translated(-rect.width() - 24, 26));
-
-    if (!lowest_notification_rect_on_screen.is_null())
-        rect.set_location(lowest_notification_rect_on_screen.bottom_left().translated(0, 10));
-
-    set_rect(rect);
-
-    m_original_rect = rect;
-
     auto& widget = set_main_widget<GUI::Widget>();
     widget.set_fill_with_background_color(true);
 
@@ -89,21 +89,21 @@ NotificationWindow::NotificationWindow(const String& text, const String& title,
     widget.layout()->set_margins({ 8, 8, 8, 8 });
     widget.layout()->set_spacing(6);
 
-    if (icon.is_valid()) {
-        auto& icon_label = widget.add<GUI::Label>();
-        icon_label.set_size_policy(GUI::SizePolicy::Fixed, GUI::SizePolicy::Fixed);
-        icon_label.set_preferred_size(32, 32);
-        icon_label.set_icon(icon.bitmap());
-    }
+    auto& icon_label = widget.add<GUI::Label>();
+    icon_label.set_size_policy(GUI::SizePolicy::Fixed, GUI::SizePolicy::Fixed);
+    icon_label.set_preferred_size(32, 32);
+    m_icon_label = icon_label;
 
     auto& left_container = widget.add<GUI::Widget>();
     left_container.set_layout<GUI::VerticalBoxLayout>();
 
-    auto& title_label = left_container.add<GUI::Label>(title);
+    auto& title_label = left_container.add<GUI::Label>();
     title_label.set_font(Gfx::Font::default_bold_font());
     title_label.set_text_alignment(Gfx::TextAlignment::CenterLeft);
-    auto& text_label = left_container.add<GUI::Label>(text);
+    m_title_label = title_label;
+    auto& text_label = left_container.add<GUI::Label>();
     text_label.set_text_alignment(Gfx::TextAlignment::CenterLeft);
+    m_text_label = text_label;
 
     auto& right_container = widget.add<GUI::Widget>();
     right_container.set_size_policy(GUI::SizePolicy::Fixed, GUI::SizePolicy::Fill);
@@ -113,6 +113,14 @@ NotificationWindow::NotificationWindow(const String& text, const String& title,
     on_close_request = [this] {
         s_windows.remove_first_matching([this](auto& entry) { return entry == this; });
         update_notification_window_locations();
+        // Show a queued notification first, so it can't be handed this very
+        // window before we're done closing it.
+        if (!s_pending_notifications.is_empty()) {
+            auto next = s_pending_notifications.take_first();
+            show_notification(next.text, next.title, next.icon);
+        }
+        if (s_window_pool.size() < max_pooled_windows)
+            s_window_pool.append(*this);
         return CloseRequestDecision::Close;
     };
 }
@@ -121,4 +129,86 @@ NotificationWindow::~NotificationWindow()
 {
 }
 
+void NotificationWindow::set_contents(const String& text, const String& title, const Gfx::ShareableBitmap& icon)
+{
+    m_title_text = title;
+    m_text = text;
+    m_repeat_count = 1;
+    m_title_label->set_text(title);
+    m_text_label->set_text(text);
+    if (icon.is_valid()) {
+        m_icon_label->set_icon(icon.bitmap());
+        m_icon_label->set_preferred_size(32, 32);
+    } else {
+        m_icon_label->set_icon(nullptr);
+        m_icon_label->set_preferred_size(0, 32);
+    }
+}
+
+void NotificationWindow::merge(const String& text)
+{
+    ++m_repeat_count;
+    m_title_label->set_text(String::format("%s (x%d)", m_title_text.characters(), m_repeat_count));
+    if (m_text != text) {
+        m_text = text;
+        m_text_label->set_text(text);
+    }
+}
+
+void NotificationWindow::reposition()
+{
+    Gfx::Rect lowest_notification_rect_on_screen;
+    for (auto& window : s_windows) {
+        if (window.ptr() == this)
+            continue;
+        if (window->m_original_rect.y() > lowest_notification_rect_on_screen.y())
+            lowest_notification_rect_on_screen = window->m_original_rect;
+    }
+
+    Gfx::Rect rect;
+    rect.set_width(220);
+    rect.set_height(40);
+    rect.set_location(GUI::Desktop::the().rect().top_right().translated(-rect.width() - 24, 26));
+
+    if (!lowest_notification_rect_on_screen.is_null())
+        rect.set_location(lowest_notification_rect_on_screen.bottom_left().translated(0, 10));
+
+    set_rect(rect);
+    m_original_rect = rect;
+}
+
+void NotificationWindow::show_notification(const String& text, const String& title, const Gfx::ShareableBitmap& icon)
+{
+    // A repeat of something already on screen just bumps its counter.
+    for (auto& window : s_windows) {
+        if (window->m_title_text == title) {
+            window->merge(text);
+            return;
+        }
+    }
+
+    if (s_windows.size() >= max_visible_notifications) {
+        for (auto& pending : s_pending_notifications) {
+            if (pending.title == title) {
+                pending.text = text;
+                return;
+            }
+        }
+        if (s_pending_notifications.size() >= max_pending_notifications)
+            return;
+        s_pending_notifications.append({ text, title, icon });
+        return;
+    }
+
+    RefPtr<NotificationWindow> window;
+    if (!s_window_pool.is_empty())
+        window = s_window_pool.take_last();
+    else
+        window = NotificationWindow::construct();
+    window->set_contents(text, title, icon);
+    s_windows.append(window);
+    window->reposition();
+    window->show();
+}
+
 }
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <LibGUI/Forward.h>
 #include <LibGUI/Window.h>
 
 namespace NotificationServer {
@@ -34,13 +35,25 @@ class NotificationWindow final : public GUI::Window {
     C_OBJECT(NotificationWindow);
 
 public:
+    static void show_notification(const String& text, const String& title, const Gfx::ShareableBitmap&);
+
     virtual ~NotificationWindow() override;
     void set_original_rect(Gfx::Rect original_rect) { m_original_rect = original_rect; };
 
 private:
-    NotificationWindow(const String& text, const String& title, const Gfx::ShareableBitmap&);
+    NotificationWindow();
+
+    void set_contents(const String& text, const String& title, const Gfx::ShareableBitmap&);
+    void merge(const String& text);
+    void reposition();
 
     Gfx::Rect m_original_rect;
+    String m_title_text;
+    String m_text;
+    int m_repeat_count { 1 };
+    RefPtr<GUI::Label> m_icon_label;
+    RefPtr<GUI::Label> m_title_label;
+    RefPtr<GUI::Label> m_text_label;
 };
 
 }
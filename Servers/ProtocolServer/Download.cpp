@@ -74,6 +74,16 @@ void Download::did_finish(bool success)
     all_downloads().remove(m_id);
 }
 
+void Download::did_receive_chunk(const ByteBuffer& chunk)
+{
+    if (!m_client) {
+        dbg() << "Download::did_receive_chunk() after the client already disconnected.";
+        return;
+    }
+    m_streamed_chunks = true;
+    m_client->did_receive_chunk_download({}, *this, chunk);
+}
+
 void Download::did_progress(size_t total_size, size_t downloaded_size)
 {
     if (!m_client) {
@@ -46,6 +46,8 @@ public:
     size_t downloaded_size() const { return m_downloaded_size; }
     const ByteBuffer& payload() const { return m_payload; }
 
+    bool streamed_chunks() const { return m_streamed_chunks; }
+
     void stop();
 
 protected:
@@ -53,6 +55,7 @@ protected:
 
     void did_finish(bool success);
     void did_progress(size_t total_size, size_t downloaded_size);
+    void did_receive_chunk(const ByteBuffer&);
     void set_payload(const ByteBuffer&);
 
 private:
@@ -61,5 +64,6 @@ private:
     size_t m_total_size { 0 };
     size_t m_downloaded_size { 0 };
     ByteBuffer m_payload;
+    bool m_streamed_chunks { false };
     WeakPtr<PSClientConnection> m_client;
 };
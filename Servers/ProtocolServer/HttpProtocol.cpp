@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <LibCore/TCPSocket.h>
 #include <LibHTTP/HttpJob.h>
 #include <LibHTTP/HttpRequest.h>
 #include <ProtocolServer/HttpDownload.h>
@@ -38,13 +39,77 @@ HttpProtocol::~HttpProtocol()
 {
 }
 
+static String origin_key(const URL& url)
+{
+    return String::format("%s:%d", url.host().characters(), (int)url.port());
+}
+
 RefPtr<Download> HttpProtocol::start_download(PSClientConnection& client, const URL& url)
 {
     HTTP::HttpRequest request;
     request.set_method(HTTP::HttpRequest::Method::GET);
     request.set_url(url);
-    auto job = request.schedule();
-    if (!job)
-        return nullptr;
-    return HttpDownload::create_with_job({}, client, (HTTP::HttpJob&)*job);
+    request.set_keep_alive(true);
+    auto job = HTTP::HttpJob::construct(request);
+    auto download = HttpDownload::create_with_job({}, client, *job);
+
+    auto origin = origin_key(url);
+    auto& connections = m_origin_connections.ensure(origin);
+
+    // The download just installed its completion handler; wrap it so we get
+    // the connection back (or start a queued request) when the job is done.
+    auto inner_on_finish = move(job->on_finish);
+    job->on_finish = [this, origin, job = job.ptr(), inner_on_finish = move(inner_on_finish)](bool success) {
+        if (inner_on_finish)
+            inner_on_finish(success);
+        did_finish_job(origin, *job);
+    };
+
+    if (connections.active_jobs >= max_jobs_per_origin) {
+        connections.queued_jobs.append(*job);
+        return download;
+    }
+    ++connections.active_jobs;
+    start_job(connections, *job);
+    return download;
+}
+
+void HttpProtocol::start_job(OriginConnections& connections, HTTP::HttpJob& job)
+{
+    while (!connections.idle_sockets.is_empty()) {
+        auto socket = connections.idle_sockets.take_last();
+        // A readable idle socket means the server has closed it (or sent
+        // something unsolicited); either way it's no good to us.
+        if (socket->can_read())
+            continue;
+        job.start(socket.release_nonnull());
+        return;
+    }
+    job.start();
+}
+
+void HttpProtocol::did_finish_job(const String& origin, HTTP::HttpJob& job)
+{
+    auto it = m_origin_connections.find(origin);
+    if (it == m_origin_connections.end())
+        return;
+    auto& connections = it->value;
+    --connections.active_jobs;
+
+    RefPtr<Core::Socket> socket;
+    if (job.socket_can_be_reused())
+        socket = job.release_socket();
+
+    if (!connections.queued_jobs.is_empty()) {
+        auto next_job = connections.queued_jobs.take_first();
+        ++connections.active_jobs;
+        if (socket)
+            next_job->start(socket.release_nonnull());
+        else
+            start_job(connections, *next_job);
+        return;
+    }
+
+    if (socket && connections.idle_sockets.size() < max_idle_sockets_per_origin)
+        connections.idle_sockets.append(move(socket));
 }
@@ -26,6 +26,12 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibCore/Forward.h>
+#include <LibHTTP/Forward.h>
 #include <ProtocolServer/Protocol.h>
 
 class HttpProtocol final : public Protocol {
@@ -34,4 +40,20 @@ public:
     virtual ~HttpProtocol() override;
 
     virtual RefPtr<Download> start_download(PSClientConnection&, const URL&) override;
+
+private:
+    // Keep-alive connections and queued requests for one host:port.
+    struct OriginConnections {
+        Vector<RefPtr<Core::Socket>> idle_sockets;
+        Vector<NonnullRefPtr<HTTP::HttpJob>> queued_jobs;
+        int active_jobs { 0 };
+    };
+
+    void start_job(OriginConnections&, HTTP::HttpJob&);
+    void did_finish_job(const String& origin, HTTP::HttpJob&);
+
+    HashMap<String, OriginConnections> m_origin_connections;
+
+    static const int max_jobs_per_origin = 4;
+    static const size_t max_idle_sockets_per_origin = 4;
 };
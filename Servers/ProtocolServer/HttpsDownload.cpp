@@ -32,6 +32,9 @@ HttpsDownload::HttpsDownload(PSClientConnection& client, NonnullRefPtr<HTTP::Htt
     : Download(client)
     , m_job(job)
 {
+    m_job->on_body_chunk = [this](const ByteBuffer& chunk) {
+        did_receive_chunk(chunk);
+    };
     m_job->on_finish = [this](bool success) {
         if (m_job->response())
             set_payload(m_job->response()->payload());
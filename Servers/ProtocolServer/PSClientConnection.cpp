@@ -78,6 +78,12 @@ OwnPtr<Messages::ProtocolServer::StopDownloadResponse> PSClientConnection::handl
 
 void PSClientConnection::did_finish_download(Badge<Download>, Download& download, bool success)
 {
+    if (download.streamed_chunks()) {
+        // The client has already received the entire payload incrementally.
+        post_message(Messages::ProtocolClient::DownloadFinished(download.id(), success, download.total_size(), -1));
+        return;
+    }
+
     RefPtr<SharedBuffer> buffer;
     if (success && download.payload().size() > 0 && !download.payload().is_null()) {
         buffer = SharedBuffer::create_with_size(download.payload().size());
@@ -89,6 +95,18 @@ void PSClientConnection::did_finish_download(Badge<Download>, Download& download
     post_message(Messages::ProtocolClient::DownloadFinished(download.id(), success, download.total_size(), buffer ? buffer->shbuf_id() : -1));
 }
 
+void PSClientConnection::did_receive_chunk_download(Badge<Download>, Download& download, const ByteBuffer& chunk)
+{
+    if (chunk.is_empty())
+        return;
+    auto buffer = SharedBuffer::create_with_size(chunk.size());
+    memcpy(buffer->data(), chunk.data(), chunk.size());
+    buffer->seal();
+    buffer->share_with(client_pid());
+    m_shared_buffers.set(buffer->shbuf_id(), buffer);
+    post_message(Messages::ProtocolClient::DownloadChunk(download.id(), buffer->shbuf_id(), chunk.size()));
+}
+
 void PSClientConnection::did_progress_download(Badge<Download>, Download& download)
 {
     post_message(Messages::ProtocolClient::DownloadProgress(download.id(), download.total_size(), download.downloaded_size()));
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
 #include <LibIPC/ClientConnection.h>
 #include <ProtocolServer/ProtocolServerEndpoint.h>
@@ -43,6 +44,7 @@ public:
 
     void did_finish_download(Badge<Download>, Download&, bool success);
     void did_progress_download(Badge<Download>, Download&);
+    void did_receive_chunk_download(Badge<Download>, Download&, const ByteBuffer& chunk);
 
 private:
     virtual OwnPtr<Messages::ProtocolServer::GreetResponse> handle(const Messages::ProtocolServer::Greet&) override;
@@ -329,6 +329,8 @@ Service::Service(const Core::ConfigFile& config, const StringView& name)
     }
 
     m_working_directory = config.read_entry(name, "WorkingDirectory");
+
+    m_dependencies = config.read_entry(name, "DependsOn", "").split(',');
 }
 
 void Service::save_to(JsonObject& json)
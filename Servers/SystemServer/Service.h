@@ -39,6 +39,9 @@ public:
     void activate();
     void did_exit(int exit_code);
 
+    // Names of services that should be activated before this one.
+    const Vector<String>& dependencies() const { return m_dependencies; }
+
     static Service* find_by_pid(pid_t);
 
     void save_to(AK::JsonObject&) override;
@@ -84,6 +87,9 @@ private:
     // The working directory in which to spawn the service
     String m_working_directory;
 
+    // Names of services we declare a dependency on.
+    Vector<String> m_dependencies;
+
     void resolve_user();
     void setup_socket();
     void setup_notifier();
@@ -27,6 +27,8 @@
 #include "Service.h"
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
@@ -128,9 +130,44 @@ int main(int, char**)
     for (auto name : config->groups())
         services.append(Service::construct(*config, name));
 
-    // After we've set them all up, activate them!
+    HashMap<String, RefPtr<Service>> services_by_name;
     for (auto& service : services)
-        service->activate();
+        services_by_name.set(service->name(), service);
+
+    // After we've set them all up, activate them in dependency order.
+    // Activation is just fork()+exec() (or arming a socket notifier), so
+    // independent services all start concurrently; a service with a DependsOn
+    // list is only activated once everything it depends on has been. Since
+    // every socket is bound before anything is spawned, dependents can
+    // connect right away and block until the dependency comes up.
+    enum ActivationState {
+        NotActivated = 0,
+        Activating,
+        Activated,
+    };
+    HashMap<String, int> activation_states;
+    Function<void(Service&)> activate_with_dependencies = [&](Service& service) {
+        auto state = activation_states.get(service.name()).value_or(NotActivated);
+        if (state == Activated)
+            return;
+        if (state == Activating) {
+            dbg() << "Dependency cycle involving " << service.name() << ", activating anyway";
+            return;
+        }
+        activation_states.set(service.name(), Activating);
+        for (auto& dependency : service.dependencies()) {
+            RefPtr<Service> dependent_service = services_by_name.get(dependency).value_or(nullptr);
+            if (!dependent_service) {
+                dbg() << "Service " << service.name() << " depends on unknown service " << dependency;
+                continue;
+            }
+            activate_with_dependencies(*dependent_service);
+        }
+        service.activate();
+        activation_states.set(service.name(), Activated);
+    };
+    for (auto& service : services)
+        activate_with_dependencies(*service);
 
     // This won't return if we're in test mode.
     check_for_test_mode();
@@ -25,7 +25,6 @@
  */
 
 #include "Client.h"
-#include <AK/BufferStream.h>
 #include <AK/ByteBuffer.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
@@ -33,17 +32,39 @@
 #include <AK/Types.h>
 #include <LibCore/Notifier.h>
 #include <LibCore/TCPSocket.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
+// Read in large chunks, and buffer whatever a peer can't take right away.
+// If one side's backlog climbs past the high-water mark, stop reading from
+// the other side until it drains below the low-water mark again.
+static const size_t relay_chunk_size = 16 * KB;
+static const size_t buffer_high_water_mark = 64 * KB;
+static const size_t buffer_low_water_mark = 16 * KB;
+
 Client::Client(int id, RefPtr<Core::TCPSocket> socket, int ptm_fd)
     : m_id(id)
     , m_socket(move(socket))
     , m_ptm_fd(ptm_fd)
     , m_ptm_notifier(Core::Notifier::construct(ptm_fd, Core::Notifier::Read))
 {
+    fcntl(m_ptm_fd, F_SETFL, fcntl(m_ptm_fd, F_GETFL) | O_NONBLOCK);
+    m_socket->set_blocking(false);
+
     m_socket->on_ready_to_read = [this] { drain_socket(); };
     m_ptm_notifier->on_ready_to_read = [this] { drain_pty(); };
+
+    m_socket_write_notifier = Core::Notifier::construct(m_socket->fd(), Core::Notifier::Write);
+    m_socket_write_notifier->set_enabled(false);
+    m_socket_write_notifier->on_ready_to_write = [this] { flush_socket(); };
+
+    m_ptm_write_notifier = Core::Notifier::construct(m_ptm_fd, Core::Notifier::Write);
+    m_ptm_write_notifier->set_enabled(false);
+    m_ptm_write_notifier->on_ready_to_write = [this] { flush_pty(); };
+
     m_parser.on_command = [this](const Command& command) { handle_command(command); };
     m_parser.on_data = [this](const StringView& data) { handle_data(data); };
     m_parser.on_error = [this]() { handle_error(); };
@@ -72,23 +93,56 @@ void Client::drain_socket()
 
 void Client::drain_pty()
 {
-    u8 buffer[BUFSIZ];
-    ssize_t nread = read(m_ptm_fd, buffer, sizeof(buffer));
-    if (nread < 0) {
-        perror("read(ptm)");
-        quit();
-        return;
-    }
-    if (nread == 0) {
-        quit();
-        return;
+    u8 buffer[relay_chunk_size];
+    for (;;) {
+        ssize_t nread = read(m_ptm_fd, buffer, sizeof(buffer));
+        if (nread < 0) {
+            if (errno == EAGAIN)
+                break;
+            perror("read(ptm)");
+            quit();
+            return;
+        }
+        if (nread == 0) {
+            quit();
+            return;
+        }
+        send_data(StringView(buffer, (size_t)nread));
+        if ((size_t)nread < sizeof(buffer))
+            break;
     }
-    send_data(StringView(buffer, (size_t)nread));
 }
 
 void Client::handle_data(const StringView& data)
 {
-    write(m_ptm_fd, data.characters_without_null_termination(), data.length());
+    m_pty_outgoing.append((const u8*)data.characters_without_null_termination(), data.length());
+    flush_pty();
+}
+
+void Client::flush_pty()
+{
+    while (!m_pty_outgoing.is_empty()) {
+        ssize_t nwritten = write(m_ptm_fd, m_pty_outgoing.data(), m_pty_outgoing.size());
+        if (nwritten < 0) {
+            if (errno == EAGAIN)
+                break;
+            perror("write(ptm)");
+            quit();
+            return;
+        }
+        if ((size_t)nwritten == m_pty_outgoing.size()) {
+            m_pty_outgoing.clear_with_capacity();
+            break;
+        }
+        memmove(m_pty_outgoing.data(), m_pty_outgoing.data() + nwritten, m_pty_outgoing.size() - nwritten);
+        m_pty_outgoing.resize(m_pty_outgoing.size() - nwritten);
+    }
+
+    m_ptm_write_notifier->set_enabled(!m_pty_outgoing.is_empty());
+    if (m_pty_outgoing.size() >= buffer_high_water_mark)
+        m_socket->set_read_notifications_enabled(false);
+    else if (m_pty_outgoing.size() <= buffer_low_water_mark)
+        m_socket->set_read_notifications_enabled(true);
 }
 
 void Client::handle_command(const Command& command)
@@ -139,28 +193,54 @@ void Client::send_data(StringView data)
     }
 
     if (fast) {
-        m_socket->write(data);
-        return;
+        m_socket_outgoing.append((const u8*)data.characters_without_null_termination(), data.length());
+    } else {
+        for (size_t i = 0; i < data.length(); i++) {
+            u8 c = data[i];
+
+            switch (c) {
+            case '\n':
+                m_socket_outgoing.append('\r');
+                m_socket_outgoing.append('\n');
+                break;
+            case IAC:
+                m_socket_outgoing.append(0xff);
+                m_socket_outgoing.append(0xff);
+                break;
+            default:
+                m_socket_outgoing.append(c);
+                break;
+            }
+        }
     }
 
-    StringBuilder builder;
-    for (size_t i = 0; i < data.length(); i++) {
-        u8 c = data[i];
+    flush_socket();
+}
 
-        switch (c) {
-        case '\n':
-            builder.append("\r\n");
-            break;
-        case IAC:
-            builder.append("\xff\xff");
-            break;
-        default:
-            builder.append(c);
+void Client::flush_socket()
+{
+    while (!m_socket_outgoing.is_empty()) {
+        ssize_t nwritten = write(m_socket->fd(), m_socket_outgoing.data(), m_socket_outgoing.size());
+        if (nwritten < 0) {
+            if (errno == EAGAIN)
+                break;
+            perror("write(socket)");
+            quit();
+            return;
+        }
+        if ((size_t)nwritten == m_socket_outgoing.size()) {
+            m_socket_outgoing.clear_with_capacity();
             break;
         }
+        memmove(m_socket_outgoing.data(), m_socket_outgoing.data() + nwritten, m_socket_outgoing.size() - nwritten);
+        m_socket_outgoing.resize(m_socket_outgoing.size() - nwritten);
     }
 
-    m_socket->write(builder.to_string());
+    m_socket_write_notifier->set_enabled(!m_socket_outgoing.is_empty());
+    if (m_socket_outgoing.size() >= buffer_high_water_mark)
+        m_ptm_notifier->set_enabled(false);
+    else if (m_socket_outgoing.size() <= buffer_low_water_mark)
+        m_ptm_notifier->set_enabled(true);
 }
 
 void Client::send_command(Command command)
@@ -170,17 +250,21 @@ void Client::send_command(Command command)
 
 void Client::send_commands(Vector<Command> commands)
 {
-    auto buffer = ByteBuffer::create_uninitialized(commands.size() * 3);
-    BufferStream stream(buffer);
-    for (auto& command : commands)
-        stream << (u8)IAC << command.command << command.subcommand;
-    stream.snip();
-    m_socket->write(buffer.data(), buffer.size());
+    // Through the same queue as regular data, so bytes can't be reordered
+    // around a partially flushed backlog.
+    for (auto& command : commands) {
+        m_socket_outgoing.append((u8)IAC);
+        m_socket_outgoing.append(command.command);
+        m_socket_outgoing.append(command.subcommand);
+    }
+    flush_socket();
 }
 
 void Client::quit()
 {
     m_ptm_notifier->set_enabled(false);
+    m_ptm_write_notifier->set_enabled(false);
+    m_socket_write_notifier->set_enabled(false);
     close(m_ptm_fd);
     m_socket->close();
     if (on_exit)
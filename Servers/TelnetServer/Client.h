@@ -29,6 +29,7 @@
 #include <AK/String.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <AK/Vector.h>
 #include <LibCore/Notifier.h>
 #include <LibCore/TCPSocket.h>
 
@@ -55,6 +56,8 @@ protected:
     void send_data(StringView str);
     void send_command(Command command);
     void send_commands(Vector<Command> commands);
+    void flush_socket();
+    void flush_pty();
     void quit();
 
 private:
@@ -66,4 +69,9 @@ private:
     // pty resources
     int m_ptm_fd { -1 };
     RefPtr<Core::Notifier> m_ptm_notifier;
+    RefPtr<Core::Notifier> m_ptm_write_notifier;
+    RefPtr<Core::Notifier> m_socket_write_notifier;
+    // bytes waiting for a peer that couldn't take them all at once
+    Vector<u8> m_socket_outgoing;
+    Vector<u8> m_pty_outgoing;
 };
@@ -26,6 +26,7 @@
 
 #include "Client.h"
 #include <AK/FileSystemPath.h>
+#include <AK/HashMap.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/DirIterator.h>
@@ -38,6 +39,16 @@
 
 namespace WebServer {
 
+// In-memory cache for small static files, validated against the file's
+// mtime on every hit. Each worker process has its own copy.
+struct CachedFile {
+    time_t mtime { 0 };
+    ByteBuffer contents;
+};
+static HashMap<String, CachedFile> s_file_cache;
+static const size_t max_cacheable_file_size = 16 * KB;
+static const size_t max_cache_entries = 64;
+
 Client::Client(NonnullRefPtr<Core::TCPSocket> socket, Core::Object* parent)
     : Core::Object(parent)
     , m_socket(socket)
@@ -113,13 +124,63 @@ void Client::handle_request(ByteBuffer raw_request)
         real_path = index_html_path;
     }
 
+    struct stat st;
+    if (stat(real_path.characters(), &st) == 0 && S_ISREG(st.st_mode) && (size_t)st.st_size <= max_cacheable_file_size) {
+        if (auto it = s_file_cache.find(real_path); it != s_file_cache.end()) {
+            if (it->value.mtime == st.st_mtime) {
+                send_response(StringView(it->value.contents.data(), it->value.contents.size()), request);
+                return;
+            }
+            s_file_cache.remove(it);
+        }
+
+        auto file = Core::File::construct(real_path);
+        if (!file->open(Core::File::ReadOnly)) {
+            send_error_response(404, "Not found, bro!", request);
+            return;
+        }
+        auto contents = file->read_all();
+        send_response(StringView(contents.data(), contents.size()), request);
+
+        if (s_file_cache.size() >= max_cache_entries)
+            s_file_cache.remove(s_file_cache.begin());
+        s_file_cache.set(real_path, { st.st_mtime, move(contents) });
+        return;
+    }
+
     auto file = Core::File::construct(real_path);
     if (!file->open(Core::File::ReadOnly)) {
         send_error_response(404, "Not found, bro!", request);
         return;
     }
 
-    send_response(file->read_all(), request);
+    send_file_response(*file, request);
+}
+
+void Client::send_file_response(Core::File& file, const HTTP::HttpRequest& request)
+{
+    StringBuilder builder;
+    builder.append("HTTP/1.0 200 OK\r\n");
+    builder.append("Server: WebServer (SerenityOS)\r\n");
+    builder.append("Content-Type: text/html\r\n");
+    builder.append("\r\n");
+
+    m_socket->write(builder.to_string());
+
+    // Stream the file into the socket with sendfile() instead of copying
+    // the whole thing through our heap and back into the kernel.
+    off_t offset = 0;
+    for (;;) {
+        ssize_t rc = sendfile(m_socket->fd(), file.fd(), &offset, 64 * KB);
+        if (rc < 0) {
+            perror("sendfile");
+            break;
+        }
+        if (rc == 0)
+            break;
+    }
+
+    log_response(200, request);
 }
 
 void Client::send_response(StringView response, const HTTP::HttpRequest& request)
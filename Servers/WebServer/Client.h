@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <LibCore/Forward.h>
 #include <LibCore/Object.h>
 #include <LibCore/TCPSocket.h>
 #include <LibHTTP/Forward.h>
@@ -42,6 +43,7 @@ private:
 
     void handle_request(ByteBuffer);
     void send_response(StringView, const HTTP::HttpRequest&);
+    void send_file_response(Core::File&, const HTTP::HttpRequest&);
     void send_redirect(StringView redirect, const HTTP::HttpRequest& request);
     void send_error_response(unsigned code, const StringView& message, const HTTP::HttpRequest&);
     void die();
@@ -36,8 +36,10 @@ int main(int argc, char** argv)
     u16 default_port = 8000;
 
     int port = default_port;
+    int worker_count = 4;
 
     Core::ArgsParser args_parser;
+    args_parser.add_option(worker_count, "Number of worker processes (default: 4)", "workers", 'w', "count");
     args_parser.add_positional_argument(port, "Port to listen on", "port", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
@@ -46,7 +48,12 @@ int main(int argc, char** argv)
         port = default_port;
     }
 
-    if (pledge("stdio accept rpath inet unix cpath fattr", nullptr) < 0) {
+    if (worker_count < 1 || worker_count > 64) {
+        printf("Warning: invalid worker count: %d\n", worker_count);
+        worker_count = 4;
+    }
+
+    if (pledge("stdio proc accept rpath inet unix cpath fattr", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -57,7 +64,11 @@ int main(int argc, char** argv)
 
     server->on_ready_to_accept = [&] {
         auto client_socket = server->accept();
-        ASSERT(client_socket);
+        if (!client_socket) {
+            // With multiple workers racing on the same listening socket,
+            // losing the accept() race is perfectly normal.
+            return;
+        }
         auto client = WebServer::Client::construct(client_socket.release_nonnull(), server);
         client->start();
     };
@@ -72,6 +83,20 @@ int main(int argc, char** argv)
 
     unveil(nullptr, nullptr);
 
+    // Pre-fork the worker pool. Every worker (and the original process)
+    // inherits the listening socket and runs its own event loop; the kernel
+    // hands each incoming connection to whichever worker wins the accept()
+    // race, so one slow client no longer stalls everybody else.
+    for (int i = 1; i < worker_count; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return 1;
+        }
+        if (pid == 0)
+            break;
+    }
+
     if (pledge("stdio accept rpath", nullptr) < 0) {
         perror("pledge");
         return 1;
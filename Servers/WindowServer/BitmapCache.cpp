@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2018-2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/SharedBuffer.h>
+#include <WindowServer/BitmapCache.h>
+
+namespace WindowServer {
+
+BitmapCache& BitmapCache::the()
+{
+    static BitmapCache* s_the;
+    if (!s_the)
+        s_the = new BitmapCache;
+    return *s_the;
+}
+
+BitmapCache::BitmapCache()
+{
+}
+
+const Gfx::Bitmap* BitmapCache::get(const String& path)
+{
+    auto it = m_bitmaps.find(path);
+    if (it != m_bitmaps.end())
+        return it->value.ptr();
+
+    auto bitmap = Gfx::Bitmap::load_from_file(path);
+    if (!bitmap)
+        return nullptr;
+
+    auto shared_bitmap = bitmap->to_bitmap_backed_by_shared_buffer();
+    if (!shared_bitmap)
+        return nullptr;
+
+    // Seal the buffer so no client can scribble on what everyone else sees.
+    shared_bitmap->shared_buffer()->seal();
+
+    m_bitmaps.set(path, shared_bitmap);
+    return shared_bitmap.ptr();
+}
+
+}
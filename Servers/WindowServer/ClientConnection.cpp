@@ -29,6 +29,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/SystemTheme.h>
 #include <WindowServer/AppletManager.h>
+#include <WindowServer/BitmapCache.h>
 #include <WindowServer/ClientConnection.h>
 #include <WindowServer/Clipboard.h>
 #include <WindowServer/Compositor.h>
@@ -419,12 +420,12 @@ OwnPtr<Messages::WindowServer::GetWindowRectResponse> ClientConnection::handle(c
 
 OwnPtr<Messages::WindowServer::SetClipboardContentsResponse> ClientConnection::handle(const Messages::WindowServer::SetClipboardContents& message)
 {
-    auto shared_buffer = SharedBuffer::create_from_shbuf_id(message.shbuf_id());
-    if (!shared_buffer) {
-        did_misbehave("SetClipboardContents: Bad shared buffer ID");
+    auto& contents = message.contents();
+    if (!contents.is_valid()) {
+        did_misbehave("SetClipboardContents: Bad shared buffer");
         return nullptr;
     }
-    Clipboard::the().set_data(*shared_buffer, message.content_size(), message.content_type());
+    Clipboard::the().set_data(*contents.shared_buffer(), contents.size(), message.content_type());
     return make<Messages::WindowServer::SetClipboardContentsResponse>();
 }
 
@@ -432,23 +433,36 @@ OwnPtr<Messages::WindowServer::GetClipboardContentsResponse> ClientConnection::h
 {
     auto& clipboard = Clipboard::the();
 
-    i32 shbuf_id = -1;
+    IPC::SharedByteBuffer contents;
     if (clipboard.size()) {
-        // FIXME: Optimize case where an app is copy/pasting within itself.
-        //        We can just reuse the SharedBuffer then, since it will have the same peer PID.
-        //        It would be even nicer if a SharedBuffer could have an arbitrary number of clients..
-        RefPtr<SharedBuffer> shared_buffer = SharedBuffer::create_with_size(clipboard.size());
-        ASSERT(shared_buffer);
-        memcpy(shared_buffer->data(), clipboard.data(), clipboard.size());
-        shared_buffer->seal();
-        shared_buffer->share_with(client_pid());
-        shbuf_id = shared_buffer->shbuf_id();
+        // A shared buffer can have any number of peers, so just hand out
+        // the buffer the copier gave us instead of copying the contents
+        // into a fresh one. The copier sealed it before sending, so the
+        // paster can't be affected by later writes. This also makes
+        // copy/pasting within a single app free: the buffer is already
+        // shared with that process.
+        contents = IPC::SharedByteBuffer::create_from_buffer(*clipboard.shared_buffer(), clipboard.size());
+        contents.share_with(client_pid());
 
         // FIXME: This is a workaround for the fact that SharedBuffers will go away if neither side is retaining them.
         //        After we respond to GetClipboardContents, we have to wait for the client to ref the buffer on his side.
-        m_last_sent_clipboard_content = move(shared_buffer);
+        m_last_sent_clipboard_content = contents.shared_buffer();
     }
-    return make<Messages::WindowServer::GetClipboardContentsResponse>(shbuf_id, clipboard.size(), clipboard.data_type());
+    return make<Messages::WindowServer::GetClipboardContentsResponse>(contents, clipboard.data_type());
+}
+
+OwnPtr<Messages::WindowServer::GetSharedBitmapResponse> ClientConnection::handle(const Messages::WindowServer::GetSharedBitmap& message)
+{
+    // Only serve system assets: we may be able to read files the client can't,
+    // so don't let this become a generic file oracle.
+    if (!message.path().starts_with("/res/"))
+        return make<Messages::WindowServer::GetSharedBitmapResponse>(Gfx::ShareableBitmap());
+
+    auto* bitmap = BitmapCache::the().get(message.path());
+    if (!bitmap)
+        return make<Messages::WindowServer::GetSharedBitmapResponse>(Gfx::ShareableBitmap());
+
+    return make<Messages::WindowServer::GetSharedBitmapResponse>(bitmap->to_shareable_bitmap(client_pid()));
 }
 
 Window* ClientConnection::window_from_id(i32 window_id)
@@ -576,7 +590,11 @@ OwnPtr<Messages::WindowServer::SetWindowBackingStoreResponse> ClientConnection::
         return nullptr;
     }
     auto& window = *(*it).value;
-    if (window.last_backing_store() && window.last_backing_store()->shbuf_id() == message.shbuf_id()) {
+    window.acknowledge_resize();
+    // NOTE: The size check matters: a client may re-wrap the same shared
+    //       buffer at a different size during a resize, and our cached
+    //       wrapper for that shbuf would still have the old geometry.
+    if (window.last_backing_store() && window.last_backing_store()->shbuf_id() == message.shbuf_id() && window.last_backing_store()->size() == message.size()) {
         window.swap_backing_stores();
     } else {
         auto shared_buffer = SharedBuffer::create_from_shbuf_id(message.shbuf_id());
@@ -627,6 +645,9 @@ OwnPtr<Messages::WindowServer::SetWindowHasAlphaChannelResponse> ClientConnectio
         return nullptr;
     }
     it->value->set_has_alpha_channel(message.has_alpha_channel());
+    // Toggling between opaque and translucent changes what the window
+    // occludes, so the cached visible regions must be rebuilt right away.
+    WindowManager::the().recompute_occlusions();
     return make<Messages::WindowServer::SetWindowHasAlphaChannelResponse>();
 }
 
@@ -46,6 +46,8 @@ public:
     const u8* data() const;
     int size() const;
 
+    RefPtr<SharedBuffer> shared_buffer() const { return m_shared_buffer; }
+
     void clear();
     void set_data(NonnullRefPtr<SharedBuffer>&&, int contents_size, const String& data_type);
 
@@ -101,6 +101,9 @@ void Compositor::init_bitmaps()
 
     m_buffers_are_flipped = false;
 
+    // Anything saved from under the cursor refers to the old buffers now.
+    m_cursor_back_rect = {};
+
     invalidate();
 }
 
@@ -140,7 +143,7 @@ void Compositor::compose()
 
     // Paint the wallpaper.
     for (auto& dirty_rect : dirty_rects.rects()) {
-        if (wm.any_opaque_window_contains_rect(dirty_rect))
+        if (!wm.background_visible_region().intersects(dirty_rect))
             continue;
         // FIXME: If the wallpaper is opaque, no need to fill with color!
         m_back_painter->fill_rect(dirty_rect, background_color);
@@ -172,7 +175,9 @@ void Compositor::compose()
         m_back_painter->add_clip_rect(window.frame().rect());
         RefPtr<Gfx::Bitmap> backing_store = window.backing_store();
         for (auto& dirty_rect : dirty_rects.rects()) {
-            if (wm.any_opaque_window_above_this_one_contains_rect(window, dirty_rect))
+            // The cached visible region already accounts for every opaque
+            // window above this one in the stack.
+            if (!window.is_fullscreen() && !window.visible_region().intersects(dirty_rect))
                 continue;
             Gfx::PainterStateSaver saver(*m_back_painter);
             m_back_painter->add_clip_rect(dirty_rect);
@@ -294,6 +299,30 @@ void Compositor::flush(const Gfx::Rect& a_rect)
     }
 }
 
+void Compositor::flush_to_display(const Gfx::Rect& a_rect)
+{
+    // Push back buffer contents to whatever buffer the screen is currently
+    // presenting, without flipping. This is for the cursor fast path, which
+    // can't go through flush(): in flipping mode, flush() copies in the
+    // other direction (front to back, after a flip.)
+    auto rect = Gfx::Rect::intersection(a_rect, Screen::the().rect());
+    if (rect.is_empty())
+        return;
+
+    if (!m_screen_can_set_buffer)
+        return flush(rect);
+
+    Gfx::RGBA32* to_ptr = m_front_bitmap->scanline(rect.y()) + rect.x();
+    const Gfx::RGBA32* from_ptr = m_back_bitmap->scanline(rect.y()) + rect.x();
+    size_t pitch = m_back_bitmap->pitch();
+
+    for (int y = 0; y < rect.height(); ++y) {
+        fast_u32_copy(to_ptr, from_ptr, rect.width());
+        from_ptr = (const Gfx::RGBA32*)((const u8*)from_ptr + pitch);
+        to_ptr = (Gfx::RGBA32*)((u8*)to_ptr + pitch);
+    }
+}
+
 void Compositor::invalidate()
 {
     m_dirty_rects.clear_with_capacity();
@@ -430,6 +459,20 @@ Gfx::Rect Compositor::current_cursor_rect() const
 void Compositor::invalidate_cursor()
 {
     auto& wm = WindowManager::the();
+
+    // Fast path: when nothing else is dirty and no drag is in progress,
+    // don't schedule a compose pass just because the cursor moved. Instead,
+    // restore the pixels the cursor was covering, repaint it at the new
+    // location, and push only those two small rects to the display.
+    if (m_dirty_rects.is_empty() && !wm.dnd_client() && m_last_dnd_rect.is_empty() && !m_cursor_back_rect.is_empty()) {
+        auto old_cursor_rect = m_last_cursor_rect;
+        restore_cursor_back();
+        draw_cursor();
+        flush_to_display(old_cursor_rect);
+        flush_to_display(m_last_cursor_rect);
+        return;
+    }
+
     if (wm.dnd_client())
         invalidate(wm.dnd_rect());
     invalidate(current_cursor_rect());
@@ -461,6 +504,17 @@ void Compositor::draw_cursor()
 {
     auto& wm = WindowManager::the();
     Gfx::Rect cursor_rect = current_cursor_rect();
+
+    // Stash the pixels we're about to paint over, so invalidate_cursor()
+    // can put them back without recomposing when the cursor simply moves.
+    auto sample_rect = Gfx::Rect::intersection(cursor_rect, Screen::the().rect());
+    if (!m_cursor_back_bitmap || m_cursor_back_bitmap->size() != cursor_rect.size()) {
+        m_cursor_back_bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::RGB32, cursor_rect.size());
+        m_cursor_back_painter = make<Gfx::Painter>(*m_cursor_back_bitmap);
+    }
+    m_cursor_back_painter->blit({ 0, 0 }, *m_back_bitmap, sample_rect);
+    m_cursor_back_rect = sample_rect;
+
     m_back_painter->blit(cursor_rect.location(), wm.active_cursor().bitmap(), wm.active_cursor().rect());
 
     if (wm.dnd_client()) {
@@ -482,6 +536,13 @@ void Compositor::draw_cursor()
     m_last_cursor_rect = cursor_rect;
 }
 
+void Compositor::restore_cursor_back()
+{
+    if (!m_cursor_back_bitmap || m_cursor_back_rect.is_empty())
+        return;
+    m_back_painter->blit(m_cursor_back_rect.location(), *m_cursor_back_bitmap, { { 0, 0 }, m_cursor_back_rect.size() });
+}
+
 void Compositor::notify_display_links()
 {
     ClientConnection::for_each_client([](auto& client) {
@@ -74,7 +74,9 @@ private:
     void init_bitmaps();
     void flip_buffers();
     void flush(const Gfx::Rect&);
+    void flush_to_display(const Gfx::Rect&);
     void draw_cursor();
+    void restore_cursor_back();
     void draw_geometry_label();
     void draw_menubar();
     void run_animations();
@@ -93,6 +95,12 @@ private:
 
     Gfx::DisjointRectSet m_dirty_rects;
 
+    // Copy of the back buffer pixels underneath the cursor, so that plain
+    // mouse movement can restore-and-redraw the cursor without composing.
+    RefPtr<Gfx::Bitmap> m_cursor_back_bitmap;
+    OwnPtr<Gfx::Painter> m_cursor_back_painter;
+    Gfx::Rect m_cursor_back_rect;
+
     Gfx::Rect m_last_cursor_rect;
     Gfx::Rect m_last_dnd_rect;
     Gfx::Rect m_last_geometry_label_rect;
@@ -320,18 +320,43 @@ void Window::event(Core::Event& event)
     case Event::WindowCloseRequest:
         m_client->post_message(Messages::WindowClient::WindowCloseRequest(m_window_id));
         break;
-    case Event::WindowResized:
+    case Event::WindowResized: {
+        auto& resize_event = static_cast<const ResizeEvent&>(event);
+        if (m_resize_ack_pending) {
+            // The client hasn't attached a backing store for the last resize
+            // we told it about. Don't flood it with intermediate steps; just
+            // remember the latest rect and send it once the client catches up.
+            m_pending_resize_rect = resize_event.rect();
+            break;
+        }
+        // Only demand an acknowledgment for size changes. The client repaints
+        // (and attaches a backing store) in response to those, but it may not
+        // paint anything for a move-only notification.
+        if (resize_event.rect().size() != resize_event.old_rect().size())
+            m_resize_ack_pending = true;
         m_client->post_message(
             Messages::WindowClient::WindowResized(
                 m_window_id,
-                static_cast<const ResizeEvent&>(event).old_rect(),
-                static_cast<const ResizeEvent&>(event).rect()));
+                resize_event.old_rect(),
+                resize_event.rect()));
         break;
+    }
     default:
         break;
     }
 }
 
+void Window::acknowledge_resize()
+{
+    m_resize_ack_pending = false;
+    if (m_pending_resize_rect.is_empty() || !m_client)
+        return;
+    auto pending_rect = m_pending_resize_rect;
+    m_pending_resize_rect = {};
+    m_resize_ack_pending = true;
+    m_client->post_message(Messages::WindowClient::WindowResized(m_window_id, pending_rect, pending_rect));
+}
+
 void Window::set_global_cursor_tracking_enabled(bool enabled)
 {
     m_global_cursor_tracking_enabled = enabled;
@@ -342,6 +367,7 @@ void Window::set_visible(bool b)
     if (m_visible == b)
         return;
     m_visible = b;
+    WindowManager::the().recompute_occlusions();
     invalidate();
 }
 
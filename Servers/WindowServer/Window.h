@@ -180,6 +180,11 @@ public:
 
     Gfx::Bitmap* last_backing_store() { return m_last_backing_store.ptr(); }
 
+    // Called when the client attaches a backing store, i.e. it has caught up
+    // with whatever we last told it. If a newer rect accumulated while a
+    // resize was in flight, this is where it finally gets delivered.
+    void acknowledge_resize();
+
     void set_global_cursor_tracking_enabled(bool);
     void set_automatic_cursor_tracking_enabled(bool enabled) { m_automatic_cursor_tracking_enabled = enabled; }
     bool global_cursor_tracking() const { return m_global_cursor_tracking_enabled || m_automatic_cursor_tracking_enabled; }
@@ -204,6 +209,12 @@ public:
     void request_update(const Gfx::Rect&, bool ignore_occlusion = false);
     Gfx::DisjointRectSet take_pending_paint_rects() { return move(m_pending_paint_rects); }
 
+    // The part of this window's frame not covered by opaque windows above
+    // it in the stack. Maintained by WindowManager::recompute_occlusions()
+    // so the Compositor doesn't have to re-derive occlusion per frame.
+    Gfx::DisjointRectSet& visible_region() { return m_visible_region; }
+    const Gfx::DisjointRectSet& visible_region() const { return m_visible_region; }
+
     bool in_minimize_animation() const { return m_minimize_animation_step != -1; }
 
     int minimize_animation_index() const { return m_minimize_animation_step; }
@@ -263,8 +274,11 @@ private:
     WindowTileType m_tiled { WindowTileType::None };
     Gfx::Rect m_untiled_rect;
     bool m_occluded { false };
+    Gfx::DisjointRectSet m_visible_region;
     RefPtr<Gfx::Bitmap> m_backing_store;
     RefPtr<Gfx::Bitmap> m_last_backing_store;
+    bool m_resize_ack_pending { false };
+    Gfx::Rect m_pending_resize_rect;
     int m_window_id { -1 };
     i32 m_client_id { -1 };
     float m_opacity { 1 };
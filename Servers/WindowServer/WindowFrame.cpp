@@ -25,6 +25,7 @@
  */
 
 #include <AK/Badge.h>
+#include <LibGfx/Bitmap.h>
 #include <LibGfx/CharacterBitmap.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/Painter.h>
@@ -255,21 +256,63 @@ void WindowFrame::paint_normal_frame(Gfx::Painter& painter)
     painter.blit(titlebar_icon_rect.location(), window.icon(), window.icon().rect());
 }
 
+void WindowFrame::render_cached_frame_if_needed()
+{
+    auto frame_size = rect().size();
+    auto frame_colors = compute_frame_colors();
+    if (m_cached_frame
+        && m_cached_frame->size() == frame_size
+        && m_cached_frame_title == m_window.title()
+        && m_cached_frame_icon == &m_window.icon()
+        && m_cached_frame_colors.title_color == frame_colors.title_color
+        && m_cached_frame_colors.border_color == frame_colors.border_color
+        && m_cached_frame_colors.border_color2 == frame_colors.border_color2)
+        return;
+
+    m_cached_frame = Gfx::Bitmap::create(Gfx::BitmapFormat::RGB32, frame_size);
+    if (!m_cached_frame)
+        return;
+
+    Gfx::Painter painter(*m_cached_frame);
+    if (m_window.type() == WindowType::Notification)
+        paint_notification_frame(painter);
+    else
+        paint_normal_frame(painter);
+
+    m_cached_frame_title = m_window.title();
+    m_cached_frame_icon = &m_window.icon();
+    m_cached_frame_colors = frame_colors;
+}
+
 void WindowFrame::paint(Gfx::Painter& painter)
 {
     if (m_window.is_frameless())
         return;
 
+    if (m_window.type() != WindowType::Notification && m_window.type() != WindowType::Normal)
+        return;
+
+    render_cached_frame_if_needed();
+
     Gfx::PainterStateSaver saver(painter);
     painter.translate(rect().location());
 
-    if (m_window.type() == WindowType::Notification)
+    if (m_cached_frame) {
+        // Blit the cached frame in strips around the window's content area.
+        // The interior of the cached bitmap is never painted, and blitting it
+        // would stomp whatever is beneath a translucent window.
+        auto frame_local_rect = Gfx::Rect { {}, m_cached_frame->size() };
+        auto interior_rect = m_window.rect().translated(-rect().location());
+        for (auto& strip : frame_local_rect.shatter(interior_rect))
+            painter.blit(strip.location(), *m_cached_frame, strip);
+    } else if (m_window.type() == WindowType::Notification) {
         paint_notification_frame(painter);
-    else if (m_window.type() == WindowType::Normal)
+    } else {
         paint_normal_frame(painter);
-    else
-        return;
+    }
 
+    // Buttons have hover and pressed states of their own and are cheap to
+    // draw, so they're always painted live on top of the cached frame.
     for (auto& button : m_buttons) {
         button.paint(painter);
     }
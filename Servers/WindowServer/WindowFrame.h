@@ -28,6 +28,8 @@
 
 #include <AK/Forward.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
 #include <LibGfx/Forward.h>
 
 namespace WindowServer {
@@ -53,9 +55,14 @@ public:
 
     void did_set_maximized(Badge<Window>, bool);
 
+    // Drops the cached frame bitmap. Needed when something the cache key
+    // can't see changes, e.g. the system theme.
+    void invalidate_cached_frame() { m_cached_frame = nullptr; }
+
 private:
     void paint_notification_frame(Gfx::Painter&);
     void paint_normal_frame(Gfx::Painter&);
+    void render_cached_frame_if_needed();
 
     struct FrameColors {
         Color title_color;
@@ -69,6 +76,14 @@ private:
     NonnullOwnPtrVector<Button> m_buttons;
     Button* m_maximize_button { nullptr };
     Button* m_minimize_button { nullptr };
+
+    // The fully rendered frame (minus buttons), so that composes that merely
+    // move a window blit this instead of re-running the style painting code.
+    // The key members below describe what the cached bitmap was rendered with.
+    RefPtr<Gfx::Bitmap> m_cached_frame;
+    String m_cached_frame_title;
+    const Gfx::Bitmap* m_cached_frame_icon { nullptr };
+    FrameColors m_cached_frame_colors;
 };
 
 }
@@ -74,6 +74,8 @@ WindowManager::WindowManager(const Gfx::PaletteImpl& palette)
 
     reload_config(false);
 
+    recompute_occlusions();
+
     invalidate();
     Compositor::the().compose();
 }
@@ -145,6 +147,7 @@ bool WindowManager::set_resolution(int width, int height)
             window.recalculate_rect();
             return IterationDecision::Continue;
         });
+        recompute_occlusions();
     }
     if (m_wm_config) {
         if (success) {
@@ -337,17 +340,58 @@ void WindowManager::notify_rect_changed(Window& window, const Gfx::Rect& old_rec
 
 void WindowManager::recompute_occlusions()
 {
-    for_each_visible_window_from_back_to_front([&](Window& window) {
-        if (m_switcher.is_visible()) {
+    // Walk the stack front to back, shattering each window's frame rect
+    // against the opaque frames already seen above it; what survives is the
+    // window's visible region. The wallpaper gets whatever the opaque
+    // windows leave of the screen. This runs on stacking, geometry,
+    // minimization and opacity changes, so the Compositor can consult the
+    // cached regions on every compose pass instead of re-deriving
+    // occlusion per window per dirty rect.
+    auto screen_rect = Screen::the().rect();
+    bool switcher_visible = m_switcher.is_visible();
+
+    Vector<Gfx::Rect, 32> opaque_rects_above;
+    auto shatter_against_rects_above = [&](const Gfx::Rect& rect, Gfx::DisjointRectSet& target) {
+        Vector<Gfx::Rect, 8> pieces;
+        if (!rect.is_empty())
+            pieces.append(rect);
+        for (auto& opaque_rect : opaque_rects_above) {
+            if (pieces.is_empty())
+                break;
+            Vector<Gfx::Rect, 8> leftovers;
+            for (auto& piece : pieces) {
+                if (opaque_rect.contains(piece))
+                    continue;
+                for (auto& shard : piece.shatter(opaque_rect))
+                    leftovers.append(shard);
+            }
+            pieces = move(leftovers);
+        }
+        for (auto& piece : pieces)
+            target.add(piece);
+    };
+
+    for_each_visible_window_from_front_to_back([&](Window& window) {
+        auto& visible_region = window.visible_region();
+        visible_region.clear_with_capacity();
+        auto frame_rect = window.frame().rect().intersected(screen_rect);
+        if (switcher_visible) {
+            visible_region.add(frame_rect);
             window.set_occluded(false);
-        } else {
-            if (any_opaque_window_above_this_one_contains_rect(window, window.frame().rect()))
-                window.set_occluded(true);
-            else
-                window.set_occluded(false);
+            return IterationDecision::Continue;
         }
+        shatter_against_rects_above(frame_rect, visible_region);
+        window.set_occluded(visible_region.is_empty());
+        if (window.opacity() >= 1.0f && !window.has_alpha_channel())
+            opaque_rects_above.append(frame_rect);
         return IterationDecision::Continue;
     });
+
+    m_background_visible_region.clear_with_capacity();
+    if (switcher_visible)
+        m_background_visible_region.add(screen_rect);
+    else
+        shatter_against_rects_above(screen_rect, m_background_visible_region);
 }
 
 void WindowManager::notify_opacity_changed(Window&)
@@ -357,6 +401,8 @@ void WindowManager::notify_opacity_changed(Window&)
 
 void WindowManager::notify_minimization_state_changed(Window& window)
 {
+    recompute_occlusions();
+
     tell_wm_listeners_window_state_changed(window);
 
     if (window.client())
@@ -1292,6 +1338,7 @@ bool WindowManager::update_theme(String theme_path, String theme_name)
     Compositor::the().set_background_color(palette().desktop_background().to_string());
     HashTable<ClientConnection*> notified_clients;
     for_each_window([&](Window& window) {
+        window.frame().invalidate_cached_frame();
         if (window.client()) {
             if (!notified_clients.contains(window.client())) {
                 window.client()->post_message(Messages::WindowClient::UpdateSystemTheme(Gfx::current_system_theme_buffer_id()));
@@ -158,6 +158,12 @@ public:
     bool any_opaque_window_contains_rect(const Gfx::Rect&);
     bool any_opaque_window_above_this_one_contains_rect(const Window&, const Gfx::Rect&);
 
+    // The part of the screen no opaque window covers; maintained by
+    // recompute_occlusions() alongside each Window's visible_region().
+    const Gfx::DisjointRectSet& background_visible_region() const { return m_background_visible_region; }
+
+    void recompute_occlusions();
+
     void tell_wm_listeners_window_state_changed(Window&);
     void tell_wm_listeners_window_icon_changed(Window&);
     void tell_wm_listeners_window_rect_changed(Window&);
@@ -205,8 +211,6 @@ private:
     void tell_wm_listener_about_window_rect(Window& listener, Window&);
     void pick_new_active_window();
 
-    void recompute_occlusions();
-
     RefPtr<Cursor> m_arrow_cursor;
     RefPtr<Cursor> m_hand_cursor;
     RefPtr<Cursor> m_resize_horizontally_cursor;
@@ -268,6 +272,8 @@ private:
 
     WindowSwitcher m_switcher;
 
+    Gfx::DisjointRectSet m_background_visible_region;
+
     WeakPtr<Button> m_cursor_tracking_button;
     WeakPtr<Button> m_hovered_button;
 
@@ -1060,10 +1060,18 @@ String unescape_token(const String& token)
 }
 
 Vector<String, 256> cached_path;
+
+struct CachedPathDirectory {
+    String path;
+    time_t mtime { 0 };
+};
+Vector<CachedPathDirectory> cached_path_directories;
+
 void cache_path()
 {
     if (!cached_path.is_empty())
         cached_path.clear_with_capacity();
+    cached_path_directories.clear();
 
     String path = getenv("PATH");
     if (path.is_empty())
@@ -1071,6 +1079,12 @@ void cache_path()
 
     auto directories = path.split(':');
     for (const auto& directory : directories) {
+        struct stat st;
+        time_t mtime = 0;
+        if (stat(directory.characters(), &st) == 0)
+            mtime = st.st_mtime;
+        cached_path_directories.append({ directory, mtime });
+
         Core::DirIterator programs(directory.characters(), Core::DirIterator::SkipDots);
         while (programs.has_next()) {
             auto program = programs.next_path();
@@ -1083,6 +1097,23 @@ void cache_path()
     quick_sort(cached_path);
 }
 
+// Re-enumerate $PATH only if a directory in it has actually changed since we
+// last looked. One stat() per directory is much cheaper than re-reading them
+// all on every completion.
+void ensure_path_cache_current()
+{
+    for (auto& directory : cached_path_directories) {
+        struct stat st;
+        time_t mtime = 0;
+        if (stat(directory.path.characters(), &st) == 0)
+            mtime = st.st_mtime;
+        if (mtime != directory.mtime) {
+            cache_path();
+            return;
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     if (pledge("stdio rpath wpath cpath proc exec tty", nullptr) < 0) {
@@ -1098,6 +1129,7 @@ int main(int argc, char** argv)
     g.default_termios = editor.default_termios();
 
     editor.on_tab_complete_first_token = [&](const String& token_to_complete) -> Vector<Line::CompletionSuggestion> {
+        ensure_path_cache_current();
         auto token = unescape_token(token_to_complete);
 
         auto match = binary_search(cached_path.data(), cached_path.size(), token, [](const String& token, const String& program) -> int {
@@ -38,19 +38,24 @@ int main(int argc, char** argv)
     const char* cmd_argument = nullptr;
     bool enable = false;
     bool disable = false;
+    bool all_processes = false;
 
     args_parser.add_option(pid_argument, "Target PID", nullptr, 'p', "PID");
+    args_parser.add_option(all_processes, "Profile all processes (super-user only)", nullptr, 'a');
     args_parser.add_option(enable, "Enable", nullptr, 'e');
     args_parser.add_option(disable, "Disable", nullptr, 'd');
     args_parser.add_option(cmd_argument, "Command", nullptr, 'c', "command");
 
     args_parser.parse(argc, argv);
 
-    if (!pid_argument && !cmd_argument) {
+    if (!pid_argument && !cmd_argument && !all_processes) {
         args_parser.print_usage(stdout, argv[0]);
         return 0;
     }
 
+    if (all_processes)
+        pid_argument = "-1";
+
     if (pid_argument) {
         if (!(enable ^ disable)) {
             fprintf(stderr, "-p <PID> requires -e xor -d.\n");